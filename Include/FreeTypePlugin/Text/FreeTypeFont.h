@@ -21,14 +21,25 @@ namespace Nuclex { namespace Text {
 //  //
 /// FreeType Font
 /** A font using the FreeType library
+
+    The glyphs of the ascii characters are rendered when the font is created, all
+    other glyphs are rendered when they're first used. To avoid rendering them in
+    the middle of a frame, prewarm() can render a whole character set on the worker
+    threads of a JobScheduler. Each worker opens its own FreeType library and face
+    for this, which requires the font to have been created from a memory buffer.
+    The font can be destroyed before its prewarm jobs have run.
 */
 class FreeTypeFont :
   public Font {
   public:
     /// Constructor
     NUCLEXFREETYPE_API FreeTypeFont(FT_Face FTFace, size_t Size);
+    /// Constructor taking over the memory the font face was opened from
+    NUCLEXFREETYPE_API FreeTypeFont(
+      FT_Face FTFace, size_t Size, std::vector<unsigned char> &Memory
+    );
     /// Destructor
-    NUCLEXFREETYPE_API virtual ~FreeTypeFont() {}
+    NUCLEXFREETYPE_API virtual ~FreeTypeFont();
 
   //
   // Font implementation
@@ -38,6 +49,11 @@ class FreeTypeFont :
     NUCLEXFREETYPE_API Metrics getMetrics(wchar_t Char) {
       return getGlyph(Char).Metrics;
     }
+
+    /// Render glyphs in the background
+    NUCLEXFREETYPE_API Support::JobScheduler::JobHandle prewarm(
+      const wstring &sCharacters, Support::JobScheduler &Scheduler
+    );
     
     /// Measure text region
     NUCLEXFREETYPE_API Box2<long> measureRegion(const wstring &sText);
@@ -72,6 +88,8 @@ class FreeTypeFont :
       public:
         /// Set up and render the glyph
         void create(FT_Face FTFace, wchar_t Glyph);
+        /// Render the glyph using a face no other thread is using
+        void render(FT_Face FTFace, wchar_t Glyph);
         /// Blit the glyph, including its alpha-channel, onto a surface
         void blit(
           const Video::Surface::LockInfo &LockInfo,
@@ -94,8 +112,14 @@ class FreeTypeFont :
     /// Map for extended characters, built when needed
     typedef std::map<wchar_t, Glyph> GlyphMap;
 
+    struct PrewarmState;
+    class PrewarmJob;
+    friend class PrewarmJob;
+
     /// Access a glyph by its UTF-16 character code  
     Glyph &getGlyph(wchar_t Char);
+    /// Set the font size and render the ascii characters
+    void initialize();
 
     /// The FreeType font face handle
     FT_Face m_FTFace;
@@ -103,10 +127,16 @@ class FreeTypeFont :
     Glyph m_Glyphs[128];
     /// Map of extended characters (any unicode characters and such), filled on-demand
     GlyphMap m_WGlyphs;
+    /// Guards the extended characters against concurrent prewarming
+    Mutex m_WGlyphsMutex;
+    /// Font file the face was opened from, empty if unknown
+    std::vector<unsigned char> m_Memory;
     /// Maximum character size this font will have
     Point2<size_t> m_MaxCharSize;
     /// The font's default line height
     size_t m_Height;
+    /// Lets the prewarm jobs find out whether the font still exists
+    shared_ptr<PrewarmState> m_spPrewarmState;
 };
 
 }} // namespace Nuclex::Text
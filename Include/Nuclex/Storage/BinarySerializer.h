@@ -0,0 +1,99 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## BinarySerializer.h - Binary object serializer                             //
+// ### # #      ###                                                                            //
+// # ### #      ###  A serializer which stores serialized objects in a compact                 //
+// #  ## #   # ## ## tagged binary format that can be read without parsing                     //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#ifndef NUCLEX_STORAGE_BINARYSERIALIZER_H
+#define NUCLEX_STORAGE_BINARYSERIALIZER_H
+
+#include "Nuclex/Nuclex.h"
+#include "Nuclex/Storage/Serializer.h"
+
+namespace Nuclex { namespace Storage {
+
+//  //
+//  Nuclex::Storage::BinarySerializer                                                          //
+//  //
+/// Binary serializer
+/** Stores serialized data in a compact binary format. All attribute and
+    scope names are interned into a single name table, values keep their
+    native Variant type and every scope records its size so a reader can
+    step over whole scopes without looking at their contents.
+
+    A BinarySerializer created from existing data works directly on that
+    data and is read-only, a BinarySerializer created without data builds
+    a new document which can be retrieved through getData().
+
+    Existing XML descriptions can be converted with fromXML(). The binary
+    document will contain the same values and scopes as the XML document,
+    so anything reading from an XMLSerializer can read from the converted
+    BinarySerializer as well.
+*/
+class BinarySerializer :
+  public Serializer {
+  public:
+    /// Check whether data is in the binary serializer format
+    NUCLEX_API static bool isBinary(const string &sData);
+    /// Convert an XML document into the binary serializer format
+    NUCLEX_API static string fromXML(const string &sXML);
+
+    /// Constructor
+    NUCLEX_API BinarySerializer(const string &sData = "");
+
+    /// Destructor
+    /** Destroys an instance of BinarySerializer
+    */
+    NUCLEX_API virtual ~BinarySerializer() {}
+
+  //
+  // BinarySerializer implementation
+  //
+  public:
+    /// Get the binary data serialized so far
+    NUCLEX_API string getData() const;
+
+  //
+  // Serializer implementation
+  //
+  public:
+    /// Enumerate nested scopes
+    NUCLEX_API shared_ptr<ScopeEnumerator> enumScopes(const string &sName = "");
+
+    /// Enter nested scope
+    /** Enters an existing block of nested data.
+
+        @param  sName      Name of the block to enter
+        @param  bOptional  Whether to throw an exception if scope not found
+        @return True if the block was entered
+    */
+    NUCLEX_API shared_ptr<Serializer> openScope(const string &sName, bool bOptional = false);
+
+    /// Begin nested scope
+    /** Begins a new block of nested data. Always creates a new block,
+        even if a block with the same name already exists.
+    */
+    NUCLEX_API shared_ptr<Serializer> createScope(const string &sName);
+
+  private:
+    class Document;
+    class ReadNode;
+    class WriteNode;
+
+    /// Retrieve a value from the root scope
+    Variant retrieveValue(const string &sName);
+    /// Retrieve a value from the root scope or return a default value
+    Variant retrieveValue(const string &sName, const Variant &Default);
+    /// Store a value in the root scope
+    void storeValue(const string &sName, const Variant &Value);
+
+    shared_ptr<Document>   m_spDocument;              ///< Document data and name table
+    shared_ptr<Serializer> m_spRootNode;              ///< Root scope
+    shared_ptr<WriteNode>  m_spRootWriteNode;         ///< Root scope when writing
+};
+
+}} // namespace Nuclex::Storage
+
+#endif // NUCLEX_STORAGE_BINARYSERIALIZER_H
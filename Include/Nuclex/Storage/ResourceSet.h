@@ -11,10 +11,12 @@
 
 #include "Nuclex/Nuclex.h"
 #include "Nuclex/Storage/Persistable.h"
+#include "Nuclex/Support/JobScheduler.h"
 #include <deque>
+#include <vector>
 
 namespace Nuclex {
-  namespace Storage { class StorageServer; class Archive; }
+  namespace Storage { class StorageServer; class Archive; class Stream; }
   namespace Video { class VideoServer; class Image; }
   namespace Text { class TextServer; class Font; }
 }
@@ -30,6 +32,8 @@ namespace Nuclex { namespace Storage {
 class ResourceSet :
   public Persistable {
   public:
+    class LoadOperation;
+
     /// Constructor
     NUCLEX_API ResourceSet(
       const string &sName,
@@ -76,6 +80,11 @@ class ResourceSet :
     NUCLEX_API void load(const shared_ptr<Serializer> &spSerializer);
     /// Save object to serializer
     NUCLEX_API void save(const shared_ptr<Serializer> &spSerializer) const;
+
+    /// Load object from serializer, decoding the resources in the background
+    NUCLEX_API shared_ptr<LoadOperation> loadAsync(
+      const shared_ptr<Serializer> &spSerializer, Support::JobScheduler &Scheduler
+    );
     
   private:
     typedef std::deque<std::pair<string, string> > StringPairDeque;
@@ -94,6 +103,90 @@ class ResourceSet :
     shared_ptr<Text::TextServer> m_spTextServer; ///< The text server
 };
 
+//  //
+//  Nuclex::Storage::ResourceSet::LoadOperation                                                //
+//  //
+/// Asynchronous resource set load
+/** Returned by ResourceSet::loadAsync(). Archives are mounted before
+    loadAsync() returns because everything else is loaded from them, the
+    images and fonts are then decoded by the JobScheduler's workers.
+
+    Decoded resources are only added to the video and text servers when
+    update() is called, so the servers are never modified from outside
+    the thread that owns them. A loading screen would call update() once
+    per frame and display getProgress() until update() returns true.
+*/
+class ResourceSet::LoadOperation {
+  friend class ResourceSet;
+
+  public:
+    /// Destructor
+    /** Waits for all outstanding decoding jobs
+    */
+    NUCLEX_API ~LoadOperation();
+
+  //
+  // LoadOperation implementation
+  //
+  public:
+    /// Get the number of images and fonts being loaded
+    NUCLEX_API size_t getResourceCount() const { return m_Resources.size(); }
+    /// Get the number of images and fonts that have been decoded
+    NUCLEX_API size_t getDecodedCount() const;
+    /// Get the fraction of the resources that have been decoded
+    NUCLEX_API float getProgress() const;
+
+    /// Check whether all resources have been added to their servers
+    NUCLEX_API bool isFinished() const { return m_nAddedCount == m_Resources.size(); }
+    /// Add the resources decoded so far to their servers
+    NUCLEX_API bool update();
+    /// Wait until all resources are decoded and add them to their servers
+    NUCLEX_API void wait();
+
+  private:
+    class DispatchJob;
+    class DecodeJob;
+
+    /// An image or font being loaded
+    struct Resource {
+      /// Constructor
+      Resource() : bFont(false), nFontSize(0) {}
+
+      string                      sName;              ///< Name to add the resource under
+      bool                        bFont;              ///< Whether the resource is a font
+      size_t                      nFontSize;          ///< Desired size of the font
+      shared_ptr<Storage::Stream> spStream;           ///< Stream to decode the resource from
+      shared_ptr<Video::Image>    spImage;            ///< The decoded image
+      shared_ptr<Text::Font>      spFont;             ///< The decoded font
+      string                      sError;             ///< Error that occured while decoding
+    };
+
+    typedef std::vector<Resource> ResourceVector;
+    typedef std::vector<size_t> IndexVector;
+
+    /// Constructor
+    LoadOperation(
+      Support::JobScheduler &Scheduler,
+      const shared_ptr<Video::VideoServer> &spVideoServer,
+      const shared_ptr<Text::TextServer> &spTextServer
+    );
+
+    /// Start decoding the resources
+    void start();
+    /// Called by a decoding job when it has finished its resource
+    void decoded(size_t nIndex);
+
+    Support::JobScheduler              &m_Scheduler;  ///< Scheduler running the jobs
+    Support::JobScheduler::JobHandle    m_Dispatch;   ///< Parent of all decoding jobs
+    shared_ptr<Video::VideoServer>      m_spVideoServer; ///< Server receiving the images
+    shared_ptr<Text::TextServer>        m_spTextServer; ///< Server receiving the fonts
+    ResourceVector                      m_Resources;  ///< Resources being loaded
+    mutable Mutex                       m_DecodedMutex; ///< Guards the decoded resources
+    IndexVector                         m_Decoded;    ///< Decoded but not yet added
+    size_t                              m_nDecodedCount; ///< Number of decoded resources
+    size_t                              m_nAddedCount; ///< Number of resources added
+};
+
 }} // namespace Nuclex::Storage
 
 #endif // NUCLEX_STORAGE_RESOURCESET_H
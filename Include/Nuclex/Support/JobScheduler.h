@@ -0,0 +1,287 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## JobScheduler.h - Work-stealing job scheduler        //
+// ### # #      ###                                                      //
+// # ### #      ###  Distributes small jobs over worker threads which    //
+// #  ## #   # ## ## steal from each other when running out of work      //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#ifndef NUCLEX_SUPPORT_JOBSCHEDULER_H
+#define NUCLEX_SUPPORT_JOBSCHEDULER_H
+
+#include "Nuclex/Nuclex.h"
+#include "Nuclex/Support/Thread.h"
+#include "Nuclex/Support/Synchronization.h"
+#include <vector>
+#include <deque>
+
+namespace Nuclex { namespace Support {
+
+//  //
+//  Nuclex::Support::JobScheduler                                        //
+//  //
+/// Work-stealing job scheduler
+/** Executes jobs on a fixed set of worker threads. Each worker owns a
+    Chase-Lev deque into which it pushes the jobs it spawns itself and
+    from which it pops in LIFO order, keeping the working set hot in the
+    cache. Workers that run out of jobs steal the oldest job from another
+    worker's deque, which only costs a single interlocked operation and
+    never blocks the owner.
+
+    Jobs scheduled from threads that are not workers of this scheduler
+    (typically the main thread) go into a shared injection queue.
+
+    A job can be given a parent. The parent is not considered finished
+    before all of its children have finished, so a whole tree of jobs can
+    be waited upon through its root. wait() does not block the calling
+    thread but lets it execute jobs until the awaited job is finished.
+
+    @code
+    JobScheduler::JobHandle Root = Scheduler.schedule(spLoadArchive);
+    Scheduler.schedule(spDecodeImage, Root);
+    Scheduler.wait(Root);
+    @endcode
+*/
+class JobScheduler {
+  struct Job;
+  struct Worker;
+  friend struct Worker;
+
+  public:
+    class JobHandle;
+    friend class JobHandle;
+
+    /// Reference to a scheduled job
+    /** Keeps the job's bookkeeping alive so it can be waited upon or used
+        as parent for other jobs even when it has already finished.
+    */
+    class JobHandle {
+      friend class JobScheduler;
+
+      public:
+        /// Constructor
+        NUCLEX_API JobHandle() : m_pJob(NULL) {}
+        /// Copy constructor
+        NUCLEX_API JobHandle(const JobHandle &Other);
+        /// Destructor
+        NUCLEX_API ~JobHandle();
+
+      //
+      // JobHandle implementation
+      //
+      public:
+        /// Assign another job handle
+        NUCLEX_API JobHandle &operator =(const JobHandle &Other);
+        /// Check whether the job and all its children have finished
+        NUCLEX_API bool isFinished() const;
+        /// Check whether the handle refers to a job
+        NUCLEX_API bool isValid() const { return m_pJob != NULL; }
+
+      private:
+        /// Takes over a reference to the job
+        JobHandle(Job *pJob) : m_pJob(pJob) {}
+
+        Job *m_pJob;                                  ///< Referenced job
+    };
+
+    /// Constructor
+    NUCLEX_API JobScheduler(size_t NumThreads);
+    /// Destructor
+    NUCLEX_API ~JobScheduler();
+
+  //
+  // JobScheduler implementation
+  //
+  public:
+    /// Schedule a job for execution
+    NUCLEX_API JobHandle schedule(
+      std::auto_ptr<Thread::Function> spJob, const JobHandle &Parent = JobHandle()
+    );
+    /// Execute jobs until the specified job has finished
+    NUCLEX_API void wait(const JobHandle &Handle);
+    /// Get the job being executed by the calling thread
+    NUCLEX_API JobHandle getCurrentJob() const;
+    /// Get the number of worker threads
+    NUCLEX_API size_t getThreadCount() const { return m_Workers.size(); }
+
+    /// Process a range of indices in parallel
+    template<typename RangeFunction>
+    inline void parallelFor(
+      size_t Begin, size_t End, RangeFunction &Function, size_t Grain = 0
+    );
+
+  private:
+    /// Scheduled job
+    struct Job {
+      /// Constructor
+      Job(Thread::Function *pFunction, Job *pParent) :
+        pFunction(pFunction),
+        pParent(pParent),
+        nUnfinished(1),
+        nRefCount(1) {}
+
+      Thread::Function *pFunction;                    ///< Function to execute
+      Job              *pParent;                      ///< Parent job, can be NULL
+      volatile long     nUnfinished;                  ///< Self plus unfinished children
+      volatile long     nRefCount;                    ///< Number of references
+    };
+
+    /// Job deque with lock-free stealing
+    /** Chase-Lev deque of fixed capacity. Only the owning worker may
+        push() and pop() at the bottom, any thread may steal() at the top.
+    */
+    class JobDeque {
+      public:
+        /// Maximum number of jobs in a deque
+        enum { Capacity = 4096 };
+
+        /// Constructor
+        JobDeque() : m_nTop(0), m_nBottom(0) {}
+
+        /// Push a job to the bottom of the deque (owner only)
+        bool push(Job *pJob);
+        /// Pop the newest job from the bottom of the deque (owner only)
+        Job *pop();
+        /// Steal the oldest job from the top of the deque
+        Job *steal();
+
+      private:
+        volatile long  m_nTop;                        ///< Index of oldest job
+        volatile long  m_nBottom;                     ///< Index after newest job
+        Job * volatile m_Jobs[Capacity];              ///< Ring buffer of jobs
+    };
+
+    /// A worker thread
+    struct Worker :
+      public Thread::Function {
+      /// Constructor
+      Worker(JobScheduler &Owner, size_t Index) :
+        m_Owner(Owner),
+        m_Index(Index),
+        m_nRandom(static_cast<unsigned long>(Index) * 2654435761UL + 1) {}
+
+      /// The threaded method
+      void operator()();
+
+      /// Generate a pseudo-random number for picking steal victims
+      unsigned long random() {
+        m_nRandom ^= m_nRandom << 13;
+        m_nRandom ^= m_nRandom >> 17;
+        m_nRandom ^= m_nRandom << 5;
+        return m_nRandom;
+      }
+
+      JobScheduler &m_Owner;                          ///< The worker thread's owner
+      size_t        m_Index;                          ///< Index in the owner's workers
+      unsigned long m_nRandom;                        ///< Steal victim randomizer
+      JobDeque      m_Jobs;                           ///< Jobs spawned by this worker
+    };
+
+    /// Splits an index range until it reaches the grain size
+    template<typename RangeFunction>
+    class RangeJob :
+      public Thread::Function {
+      public:
+        /// Constructor
+        RangeJob(JobScheduler &Scheduler, RangeFunction &Function,
+                 size_t Begin, size_t End, size_t Grain) :
+          m_Scheduler(Scheduler),
+          m_Function(Function),
+          m_Begin(Begin),
+          m_End(End),
+          m_Grain(Grain) {}
+
+        /// Hand off the upper halves of the range, then process the rest
+        void operator()() {
+          JobHandle Self = m_Scheduler.getCurrentJob();
+
+          while((m_End - m_Begin) > m_Grain) {
+            size_t Middle = m_Begin + (m_End - m_Begin) / 2;
+            m_Scheduler.schedule(
+              std::auto_ptr<Thread::Function>(
+                new RangeJob(m_Scheduler, m_Function, Middle, m_End, m_Grain)
+              ),
+              Self
+            );
+            m_End = Middle;
+          }
+
+          m_Function(m_Begin, m_End);
+        }
+
+      private:
+        JobScheduler  &m_Scheduler;                   ///< Scheduler running the job
+        RangeFunction &m_Function;                    ///< Function processing ranges
+        size_t         m_Begin;                       ///< First index of the range
+        size_t         m_End;                         ///< One past the last index
+        size_t         m_Grain;                       ///< Largest range not to split
+    };
+
+    typedef std::vector<std::pair<shared_ptr<Thread>, Worker *> > WorkerVector;
+    typedef std::deque<Job *> JobQueue;
+
+    /// Add a reference to a job
+    static void addRef(Job *pJob);
+    /// Release a reference to a job, destroying it if it was the last
+    static void release(Job *pJob);
+    /// Mark one outstanding unit of a job as finished
+    static void finish(Job *pJob);
+
+    /// Execute a job on the calling thread
+    void execute(Job *pJob);
+    /// Look for a job the calling thread can execute
+    Job *findJob(Worker *pWorker);
+    /// Wake up one sleeping worker, if there is any
+    void wakeWorker();
+    /// Get the worker for the calling thread, NULL if not a worker
+    Worker *getCurrentWorker() const;
+
+    WorkerVector   m_Workers;                         ///< Worker threads
+    Mutex          m_InjectedJobsMutex;               ///< Guards the injected jobs
+    JobQueue       m_InjectedJobs;                    ///< Jobs from foreign threads
+    volatile long  m_nInjectedJobCount;               ///< Size of the injected jobs
+    volatile long  m_nSleepingWorkers;                ///< Workers about to sleep
+    volatile bool  m_bStopRequested;                  ///< Whether to shut down
+    unsigned long  m_nWorkerTlsIndex;                 ///< TLS slot for current worker
+    unsigned long  m_nJobTlsIndex;                    ///< TLS slot for current job
+#ifdef NUCLEX_WIN32
+    HANDLE         m_hWakeUp;                         ///< Semaphore for sleeping workers
+#endif
+};
+
+// ####################################################################### //
+// # Nuclex::Support::JobScheduler::parallelFor()                        # //
+// ####################################################################### //
+/** Calls Function(Begin, End) on subranges of the specified index range,
+    distributed over all worker threads. The range is split recursively,
+    so idle workers can steal large chunks instead of single indices.
+    Returns when the whole range has been processed, helping with
+    the work in the meantime.
+
+    @param  Begin     First index to process
+    @param  End       One past the last index to process
+    @param  Function  Functor taking a (size_t Begin, size_t End) range
+    @param  Grain     Largest range not to split further. 0 chooses a
+                      grain that gives each worker about 8 chunks
+*/
+template<typename RangeFunction>
+inline void JobScheduler::parallelFor(
+  size_t Begin, size_t End, RangeFunction &Function, size_t Grain
+) {
+  if(End <= Begin)
+    return;
+
+  if(Grain == 0) {
+    Grain = (End - Begin) / ((m_Workers.size() + 1) * 8);
+    if(Grain == 0)
+      Grain = 1;
+  }
+
+  wait(schedule(std::auto_ptr<Thread::Function>(
+    new RangeJob<RangeFunction>(*this, Function, Begin, End, Grain)
+  )));
+}
+
+}} // namespace Nuclex::Support
+
+#endif // NUCLEX_SUPPORT_JOBSCHEDULER_H
@@ -12,10 +12,7 @@
 #include "Nuclex/Nuclex.h"
 #include "Nuclex/Support/String.h"
 #include "Nuclex/Support/Thread.h"
-#include "Nuclex/Support/Synchronization.h"
-#include "Nuclex/Support/Invocation.h"
-#include <vector>
-#include <deque>
+#include "Nuclex/Support/JobScheduler.h"
 
 namespace Nuclex { namespace Support {
 
@@ -23,6 +20,10 @@ namespace Nuclex { namespace Support {
 //  Nuclex::Support::ThreadPool                                          //
 //  //
 /// Thread pool
+/** Simple fire-and-forget interface to a JobScheduler. Code which needs
+    dependencies between tasks or wants to wait for their completion
+    should use the scheduler returned by getScheduler() directly.
+*/
 class ThreadPool {
   public:
     NUCLEX_API ThreadPool(size_t NumThreads);
@@ -34,40 +35,11 @@ class ThreadPool {
   public:
     /// Enqueue a task to be executed
     NUCLEX_API void enqueue(std::auto_ptr<Thread::Function> spTask);
+    /// Access the scheduler executing the tasks
+    NUCLEX_API JobScheduler &getScheduler() { return m_Scheduler; }
     
   private:
-    /// A worker thread
-    struct WorkerThread :
-      public Thread::Function {
-      /// Constructor
-      WorkerThread(ThreadPool &Owner) :
-        m_Owner(Owner),
-        m_Signal(false),
-        m_bStopRequested(false),
-        m_bWorking(false) {}
-      
-      /// The threaded method
-      void operator()();
-      /// Request the thread to stop
-      void requestStop() { m_bStopRequested = true; }
-      /// Access signal for suspending idle threads
-      Signal &getSignal() { return m_Signal; }
-      /// Check whether the thread is currently working
-      bool isWorking() const { return m_bWorking; }
-      
-      private:
-        ThreadPool &m_Owner;                          ///< The worker thread's owner
-        Signal      m_Signal;                         ///< Signal to suspend thread
-        bool        m_bStopRequested;                 ///< Whether a stop was requested
-        bool        m_bWorking;                       ///< Whether the thread is working
-    };
-
-    typedef std::vector<std::pair<shared_ptr<Thread>, WorkerThread *> > WorkerThreadVector;
-    typedef std::deque<shared_ptr<Thread::Function> > TaskDeque;
-    
-    WorkerThreadVector m_WorkerThreads;
-    Mutex              m_TasksMutex;
-    TaskDeque          m_Tasks;
+    JobScheduler m_Scheduler;                         ///< Executes the tasks
 };
 
 }} // namespace Nuclex::Support
@@ -13,6 +13,7 @@
 #include "Nuclex/Video/Surface.h"
 #include "Nuclex/Support/String.h"
 #include "Nuclex/Support/Cacheable.h"
+#include "Nuclex/Support/JobScheduler.h"
 
 namespace Nuclex { namespace Text {
 
@@ -86,6 +87,21 @@ class Font :
     */
     NUCLEX_API virtual Metrics getMetrics(wchar_t nChar) = 0;
 
+    /// Prepare glyphs in the background
+    /** Prepares the glyphs of the specified characters on the scheduler's worker
+        threads, so they don't have to be prepared when they're first drawn. Fonts
+        which don't need any preparation return an invalid job handle.
+
+        @param  sCharacters  Character set or sample text whose glyphs to prepare
+        @param  Scheduler    Scheduler on which to prepare the glyphs
+        @return A handle to the job preparing the glyphs
+    */
+    NUCLEX_API virtual Support::JobScheduler::JobHandle prewarm(
+      const wstring &sCharacters, Support::JobScheduler &Scheduler
+    ) {
+      return Support::JobScheduler::JobHandle();
+    }
+
     /// Render text to surface
     NUCLEX_API virtual void drawText(const shared_ptr<Video::Surface> &spSurface, const wstring &sText,
                                      const Point2<long> &Position,
@@ -10,6 +10,7 @@
 #define NUCLEX_VIDEO_BLIT_H
 
 #include "Nuclex/Video/PixelFormat.h"
+#include "Nuclex/Video/BlitKernels.h"
 #include "Nuclex/Math/Point2.h"
 
 namespace Nuclex { namespace Video {
@@ -21,6 +22,9 @@ namespace Nuclex { namespace Video {
 /** Performs a blit, optionally including color conversion, alpha blending from
     alpha value and/or alpha channel. The best blitting solution is statically
     chosen by a compile-time solvable call graph of template method.
+
+    Pixel format combinations for which a BlitKernel exists are handed to that
+    kernel first and only use the generic implementation if the kernel can't run.
 */
 template<
   typename DestinationPixelFormatDescription,
@@ -35,6 +39,20 @@ struct Blit {
   inline void operator ()(void *pDestination, long nDestinationPitch,
                           const void *pSource, long nSourcePitch,
                           const Point2<unsigned long> &Size) {
+    if(BlitKernel<
+      DestinationPixelFormatDescription, SourcePixelFormatDescription, bAlphaBlend
+    >()(pDestination, nDestinationPitch, pSource, nSourcePitch, Size))
+      return;
+
+    generic(pDestination, nDestinationPitch, pSource, nSourcePitch, Size);
+  }
+  /// Blit source to destination without handing it to a BlitKernel
+  /** The output of the generic implementation, which the BlitKernels have
+      to match bit for bit
+  */
+  inline void generic(void *pDestination, long nDestinationPitch,
+                      const void *pSource, long nSourcePitch,
+                      const Point2<unsigned long> &Size) {
     blit<bAlphaBlend>(
       reinterpret_cast<unsigned char *>(pDestination), nDestinationPitch,
       reinterpret_cast<const unsigned char *>(pSource), nSourcePitch,
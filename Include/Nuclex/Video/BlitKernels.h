@@ -0,0 +1,84 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## BlitKernels.h - Accelerated blitting routines                             //
+// ### # #      ###                                                                            //
+// # ### #      ###  Vectorized blitting routines for frequently used                          //
+// #  ## #   # ## ## pixel format combinations                                                 //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#ifndef NUCLEX_VIDEO_BLITKERNELS_H
+#define NUCLEX_VIDEO_BLITKERNELS_H
+
+#include "Nuclex/Video/PixelFormat.h"
+#include "Nuclex/Math/Point2.h"
+
+namespace Nuclex { namespace Video {
+
+//  //
+//  Nuclex::Video::BlitKernel                                                                  //
+//  //
+/// Accelerated blit
+/** Replaces the generic per-pixel loops of the Blit template for a pixel format
+    combination. The default implementation does nothing and returns false, the
+    specializations below use SSE2 when the cpu supports it and return false otherwise,
+    in which case Blit falls back to its generic implementation.
+
+    The specializations produce exactly the same pixels as the generic implementation
+    would, so whether a kernel is used or not never changes the output.
+
+    @param  DestinationPixelFormatDescription  The destination pixel format
+    @param  SourcePixelFormatDescription       The source pixel format
+    @param  bAlphaBlend                        Whether to blend by source alpha
+*/
+template<
+  typename DestinationPixelFormatDescription,
+  typename SourcePixelFormatDescription,
+  bool bAlphaBlend
+>
+struct BlitKernel {
+  /// Blit source to destination
+  /** @return True if the blit was performed
+  */
+  inline bool operator ()(void *, long, const void *, long, const Point2<unsigned long> &) {
+    return false;
+  }
+};
+
+/// Alpha blend argb-8-8-8-8 onto argb-8-8-8-8
+template<> struct BlitKernel<ARGB_8_8_8_8, ARGB_8_8_8_8, true> {
+  NUCLEX_API bool operator ()(void *pDestination, long nDestinationPitch,
+                              const void *pSource, long nSourcePitch,
+                              const Point2<unsigned long> &Size);
+};
+
+/// Convert argb-8-8-8-8 to rgb-5-6-5
+template<> struct BlitKernel<RGB_5_6_5, ARGB_8_8_8_8, false> {
+  NUCLEX_API bool operator ()(void *pDestination, long nDestinationPitch,
+                              const void *pSource, long nSourcePitch,
+                              const Point2<unsigned long> &Size);
+};
+
+/// Convert xrgb-8-8-8-8 to rgb-5-6-5
+template<> struct BlitKernel<RGB_5_6_5, XRGB_8_8_8_8, false> {
+  NUCLEX_API bool operator ()(void *pDestination, long nDestinationPitch,
+                              const void *pSource, long nSourcePitch,
+                              const Point2<unsigned long> &Size);
+};
+
+/// Convert rgb-5-6-5 to argb-8-8-8-8
+template<> struct BlitKernel<ARGB_8_8_8_8, RGB_5_6_5, false> {
+  NUCLEX_API bool operator ()(void *pDestination, long nDestinationPitch,
+                              const void *pSource, long nSourcePitch,
+                              const Point2<unsigned long> &Size);
+};
+
+/// Convert rgb-5-6-5 to xrgb-8-8-8-8
+template<> struct BlitKernel<XRGB_8_8_8_8, RGB_5_6_5, false> {
+  NUCLEX_API bool operator ()(void *pDestination, long nDestinationPitch,
+                              const void *pSource, long nSourcePitch,
+                              const Point2<unsigned long> &Size);
+};
+
+}} // namespace Nuclex::Video
+
+#endif // NUCLEX_VIDEO_BLITKERNELS_H
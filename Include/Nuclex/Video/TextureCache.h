@@ -16,6 +16,9 @@
 #include "Nuclex/Video/Image.h"
 #include "SigC++/sigc++.h"
 #include <map>
+#include <list>
+#include <vector>
+#include <algorithm>
 
 namespace Nuclex { namespace Video {
 
@@ -25,6 +28,13 @@ namespace Nuclex { namespace Video {
 /// Dynamic texture cache
 /** Caches multiple smaller textures on large cache textures to reduce the number of
     required texture switches and drawPrimitive() calls for frame.
+
+    Each cached object remembers the frame in which it was last used. When the cache
+    textures are full and no more cache textures may be created, the least recently used
+    objects are evicted to make room, but never objects used in the current frame.
+    Space freed on a cache texture is reused for new objects, and when a cache texture
+    becomes sparsely populated, its objects are moved to other cache textures a few at
+    a time in beginFrame() until the texture can be released.
     
     @todo If a new font is used, the frame rate may crash down temporarily due to locking the
           cache texture up to 50 times in a row. Maybe the lock could be kept active until
@@ -37,6 +47,32 @@ class TextureCache {
     typedef std::pair<shared_ptr<Texture>, Box2<float> > CacheSlot;
     typedef sigc::slot<void, const Surface::LockInfo &> UpdateCacheSlot;
 
+    /// Cache usage statistics
+    struct Statistics {
+      /// Constructor
+      Statistics() :
+        nTextureCount(0), nEntryCount(0), nUsedArea(0), nTotalArea(0),
+        nHits(0), nMisses(0), nEvictions(0), nRelocations(0) {}
+
+      /// Fraction of the cache textures' area occupied by cached objects
+      float getOccupancy() const {
+        return nTotalArea ? static_cast<float>(nUsedArea) / nTotalArea : 0.0f;
+      }
+      /// Fraction of lookups which found the object in the cache
+      float getHitRate() const {
+        return (nHits + nMisses) ? static_cast<float>(nHits) / (nHits + nMisses) : 0.0f;
+      }
+
+      size_t nTextureCount;                           ///< Number of cache textures
+      size_t nEntryCount;                             ///< Number of cached objects
+      size_t nUsedArea;                               ///< Pixels occupied by cached objects
+      size_t nTotalArea;                              ///< Pixels on all cache textures
+      size_t nHits;                                   ///< Lookups of cached objects
+      size_t nMisses;                                 ///< Lookups which had to cache the object
+      size_t nEvictions;                              ///< Objects evicted to make room
+      size_t nRelocations;                            ///< Objects moved by defragmentation
+    };
+
     /// Constructor
     NUCLEX_API TextureCache(const shared_ptr<VideoDevice> &spVideoDevice);
 
@@ -54,6 +90,13 @@ class TextureCache {
       return m_CacheTextures.at(Index)->spTexture;
     }
 
+    /// Get the number of cache textures after which objects are evicted
+    NUCLEX_API size_t getMaxTextureCount() const { return m_nMaxTextureCount; }
+    /// Set the number of cache textures after which objects are evicted
+    NUCLEX_API void setMaxTextureCount(size_t nMaxTextureCount) {
+      m_nMaxTextureCount = std::max<size_t>(nMaxTextureCount, 1);
+    }
+
     /// Cache a texture
     NUCLEX_API CacheSlot cache(const shared_ptr<Texture> &spTexture);
     /// Cache an arbitrary size image
@@ -63,45 +106,97 @@ class TextureCache {
       Cacheable::CacheID ID, const Point2<size_t> Size, UpdateCacheSlot UpdateCallback
     );
 
+    /// Remove an object from the cache
+    NUCLEX_API void release(Cacheable::CacheID ID);
+    /// Mark an object as used in the current frame
+    NUCLEX_API void touch(Cacheable::CacheID ID);
+
+    /// Get a number which changes whenever cached objects are moved or removed
+    /** Cache slots obtained from the cache stay valid for as long as the generation
+        remains the same, so users may keep them around instead of looking up the
+        same objects over and over again.
+
+        @return The current generation of the cache
+    */
+    NUCLEX_API size_t getGeneration() const { return m_nGeneration; }
+
+    /// Begin a new frame
+    NUCLEX_API void beginFrame();
+
     /// Try to clean the cache
     NUCLEX_API void flush();
+
+    /// Get cache usage statistics
+    NUCLEX_API Statistics getStatistics() const;
     
   private:
     /// Surface with cached images
     struct SharedTexture {
-      /// Optimized rectangle allocator
+      /// Rectangle allocator with reusable free space
       struct RectanglePacker {
         /// Constructor
         RectanglePacker(const Point2<size_t> &Size);
         /// Allocate space for a rectangle
         Point2<size_t> placeRectangle(const Point2<size_t> &Size);
+        /// Give the space of a rectangle back to the packer
+        void releaseRectangle(const Point2<size_t> &Location, const Point2<size_t> &Size);
+        /// Release all rectangles
+        void clear();
+        /// Get the area occupied by rectangles
+        size_t getUsedArea() const { return m_nUsedArea; }
 
         private:
-          Point2<size_t> m_Size;                      ///< Total packing area size
-          size_t         m_lCurrentLine;              ///< Current packing line
-          size_t         m_lMaxHeight;                ///< Largest rectangle in current line
-          size_t         m_lXPosition;                ///< Offset within current line
+          /// Unoccupied area
+          struct FreeRectangle {
+            /// Constructor
+            FreeRectangle(const Point2<size_t> &Location, const Point2<size_t> &Size) :
+              Location(Location), Size(Size) {}
+
+            Point2<size_t> Location;                  ///< Upper left corner
+            Point2<size_t> Size;                      ///< Width and height
+          };
+          /// Vector of free rectangles
+          typedef std::vector<FreeRectangle> FreeRectangleVector;
+
+          /// Merges free rectangles sharing a complete edge
+          void mergeFreeRectangles();
+
+          Point2<size_t>      m_Size;                 ///< Total packing area size
+          FreeRectangleVector m_FreeRectangles;       ///< Unoccupied areas
+          size_t              m_nUsedArea;            ///< Area occupied by rectangles
       };
 
       /// Constructor
       SharedTexture(const shared_ptr<Texture> &spTexture) :
         Packer(spTexture->getSize()),
-        spTexture(spTexture) {}
+        spTexture(spTexture),
+        nEntryCount(0) {}
 
       RectanglePacker     Packer;                     ///< Rectangle allocator
       shared_ptr<Texture> spTexture;                  ///< Texture with cached images
+      size_t              nEntryCount;                ///< Number of objects on the texture
     };
 
+    /// List of cache entry ids, most recently used first
+    typedef std::list<Cacheable::CacheID> CacheIDList;
+
     /// An entry in the texture cache
     struct CacheEntry {
       /// Initializes a texture cache entry
-      CacheEntry(const weak_ptr<void> &wpSurface, const shared_ptr<Texture> &spCacheTexture,
-                 Box2<float> Location) :
-        wpSurface(wpSurface), spCacheTexture(spCacheTexture), Location(Location) {}
-
-      weak_ptr<void>      wpSurface;                  ///< The object itself
-      shared_ptr<Texture> spCacheTexture;             ///< Used cache texture
-      Box2<float>         Location;                   ///< Location of the cached object
+      CacheEntry(const weak_ptr<void> &wpSurface, bool bHasSurface,
+                 const shared_ptr<SharedTexture> &spSharedTexture,
+                 const Point2<size_t> &Position, const Point2<size_t> &Size) :
+        wpSurface(wpSurface), bHasSurface(bHasSurface), spSharedTexture(spSharedTexture),
+        Position(Position), Size(Size), nLastUsedFrame(0) {}
+
+      weak_ptr<void>            wpSurface;            ///< The object itself
+      bool                      bHasSurface;          ///< Whether wpSurface was provided
+      shared_ptr<SharedTexture> spSharedTexture;      ///< Used cache texture
+      Point2<size_t>            Position;             ///< Position on the cache texture
+      Point2<size_t>            Size;                 ///< Size of the cached object
+      Box2<float>               Location;             ///< Location of the cached object
+      size_t                    nLastUsedFrame;       ///< Frame of the last lookup
+      CacheIDList::iterator     UsageIt;              ///< Position in the usage list
     };
     
     /// Vector of shared textures
@@ -111,14 +206,32 @@ class TextureCache {
 
     /// Appends a new shared cache texture to the cache
     void appendSharedTexture();
+    /// Finds room for an object, evicting other objects if neccessary
+    shared_ptr<SharedTexture> allocate(const Point2<size_t> &Size, Point2<size_t> &Position);
+    /// Adds an entry for an object which has been placed on a cache texture
+    CacheEntryMap::iterator addEntry(
+      Cacheable::CacheID ID, const weak_ptr<void> &wpSurface, bool bHasSurface,
+      const shared_ptr<SharedTexture> &spSharedTexture,
+      const Point2<size_t> &Position, const Point2<size_t> &Size
+    );
+    /// Removes an entry and frees its space on the cache texture
+    void removeEntry(CacheEntryMap::iterator EntryIt);
+    /// Marks an entry as used in the current frame
+    void touchEntry(CacheEntryMap::iterator EntryIt);
     /// Caches an arbitrary size surface
     CacheEntryMap::iterator addToCache(const shared_ptr<Surface> &spSurface);
+    /// Moves some objects off the most sparsely populated cache texture
+    void defragment();
 
     shared_ptr<VideoDevice>   m_spVideoDevice;        ///< Owner of the VertexDrawer
     SharedTextureVector       m_CacheTextures;        ///< The cache's textures
-    shared_ptr<SharedTexture> m_spCurrentTexture;     ///< Current cache texture
     Point2<size_t>            m_Resolution;           ///< Cache texture resolution
+    size_t                    m_nMaxTextureCount;     ///< Texture count before evicting
     CacheEntryMap             m_CacheEntries;         ///< Texture cache entries
+    CacheIDList               m_UsageList;            ///< Entry ids by last use
+    size_t                    m_nFrame;               ///< Current frame number
+    size_t                    m_nGeneration;          ///< Changes when slots move or vanish
+    Statistics                m_Statistics;           ///< Lookup and eviction counters
 };
 
 }} // namespace Nuclex::Video
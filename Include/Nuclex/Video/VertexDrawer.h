@@ -17,7 +17,10 @@
 #include "Nuclex/Text/Font.h"
 #include "Nuclex/Math/Point2.h"
 #include "Nuclex/Math/Box2.h"
+#include "Nuclex/Support/JobScheduler.h"
+#include "Nuclex/Support/TimeSpan.h"
 #include <vector>
+#include <deque>
 #include <map>
 #include <stack>
 #include <list>
@@ -34,6 +37,14 @@ namespace Nuclex { namespace Video {
 /// Vertex buffer drawer
 /** Uses a VertexBuffer to draw simple shapes and text
 
+    Text strings are laid out only once. The resulting quads are kept together with
+    the texture cache slots of their glyphs, so drawing the same string again only
+    copies its vertices into the vertex cache.
+
+    The glyphs of a whole character set can be uploaded ahead of time with
+    prewarmText(). The upload is spread over several frames, each frame only spending
+    the upload budget on it.
+
     @todo Renames ScreenSize to something better
 */
 class VertexDrawer {
@@ -124,6 +135,19 @@ class VertexDrawer {
       Text::Font::Alignment eAlignment = Text::Font::A_NORMAL
     );
 
+    /// Upload the glyphs of a character set to the texture cache
+    NUCLEX_API void prewarmText(
+      const shared_ptr<Text::Font> &spFont, const wstring &sCharacters,
+      const Support::JobScheduler::JobHandle &Ready = Support::JobScheduler::JobHandle()
+    );
+
+    /// Get the time per frame that may be spent uploading prewarmed glyphs
+    NUCLEX_API const Support::TimeSpan &getUploadBudget() const { return m_UploadBudget; }
+    /// Set the time per frame that may be spent uploading prewarmed glyphs
+    NUCLEX_API void setUploadBudget(const Support::TimeSpan &UploadBudget) {
+      m_UploadBudget = UploadBudget;
+    }
+
   private:
     /// Stack of float points for storing drawing offsets
     typedef std::stack<Box2<float> > BoxStack;
@@ -132,7 +156,7 @@ class VertexDrawer {
     struct RealizedFont {
       /// Constructor
       RealizedFont() :
-        Characters(128) {}
+        Characters(256) {}
 
       /// Realized font character
       struct Character {
@@ -149,18 +173,141 @@ class VertexDrawer {
         Text::Font::Metrics Metrics;
       };
 
+      /// Look up a character
+      /** Characters in the latin-1 range are kept in a flat array, all others
+          are looked up in a map. The character's metrics are obtained from
+          the font when it is first looked up.
+
+          @param  pFont  Font the character belongs to
+          @param  Code   UTF-16 code of the character to look up
+          @return The realized character
+      */
+      Character &getCharacter(Text::Font *pFont, wchar_t Code) {
+        Character &Char = (static_cast<size_t>(Code) < Characters.size()) ?
+          Characters[Code] : WCharacters[Code];
+
+        if(!Char.bCached) {
+          Char.Code = Code;
+          Char.CacheID = Cacheable().getUniqueID();
+          Char.Metrics = pFont->getMetrics(Code);
+          Char.bCached = true;
+        }
+
+        return Char;
+      }
+
       typedef std::vector<Character> CharacterVector;
       CharacterVector Characters;
       typedef std::map<wchar_t, Character> CharacterMap;
       CharacterMap WCharacters;
     };
     typedef std::map<Cacheable::CacheID, RealizedFont> RealizedFontMap;
+
+    /// Laid out text string
+    struct TextRun {
+      /// Constructor
+      TextRun() :
+        nGeneration(static_cast<size_t>(-1)),
+        nLastUsedFrame(0) {}
+
+      /// Consecutive quads of a text run using the same texture
+      struct Batch {
+        /// Constructor
+        Batch(const shared_ptr<Texture> &spTexture, size_t nStart) :
+          spTexture(spTexture),
+          nStart(nStart),
+          nCount(0) {}
+
+        shared_ptr<Texture> spTexture;                ///< Texture holding the glyphs
+        size_t              nStart;                   ///< First vertex of the batch
+        size_t              nCount;                   ///< Number of vertices in the batch
+      };
+
+      typedef std::vector<VideoDevice::PretransformedVertex> VertexVector;
+      typedef std::vector<Batch> BatchVector;
+      typedef std::vector<Cacheable::CacheID> CacheIDVector;
+
+      Point2<long>  Origin;                           ///< Aligned start of the base line
+      VertexVector  Vertices;                         ///< Glyph quads relative to position
+      BatchVector   Batches;                          ///< Vertices grouped by texture
+      CacheIDVector CacheIDs;                         ///< Glyphs used by the text run
+      size_t        nGeneration;                      ///< Texture cache generation of slots
+      size_t        nLastUsedFrame;                   ///< Frame the run was last drawn in
+    };
+
+    /// Identifies a laid out text string
+    /** A key created from a text string only refers to the string, so looking
+        up a text run doesn't copy the text. Copies of a key, like the one stored
+        in the text run map, keep their own copy of the text.
+    */
+    struct TextRunKey {
+      /// Constructor
+      TextRunKey(Cacheable::CacheID FontID, const wstring &sText,
+                 Text::Font::Alignment eAlignment) :
+        FontID(FontID),
+        psText(&sText),
+        eAlignment(eAlignment) {}
+
+      /// Copy constructor
+      TextRunKey(const TextRunKey &Other) :
+        FontID(Other.FontID),
+        sOwnText(*Other.psText),
+        psText(&sOwnText),
+        eAlignment(Other.eAlignment) {}
+
+      /// Sorting order for the text run map
+      bool operator <(const TextRunKey &Other) const {
+        if(FontID != Other.FontID)
+          return FontID < Other.FontID;
+        if(eAlignment != Other.eAlignment)
+          return eAlignment < Other.eAlignment;
+        return *psText < *Other.psText;
+      }
+
+      Cacheable::CacheID    FontID;                   ///< Font the text is drawn with
+      wstring               sOwnText;                 ///< Text string owned by copies
+      const wstring        *psText;                   ///< Text string
+      Text::Font::Alignment eAlignment;               ///< Alignment of the text
+
+      private:
+        TextRunKey &operator =(const TextRunKey &);
+    };
+    typedef std::map<TextRunKey, TextRun> TextRunMap;
+
+    /// Characters whose glyphs are waiting to be uploaded
+    struct PendingGlyphs {
+      /// Constructor
+      PendingGlyphs(const shared_ptr<Text::Font> &spFont, const wstring &sCharacters,
+                    const Support::JobScheduler::JobHandle &Ready) :
+        spFont(spFont),
+        sCharacters(sCharacters),
+        Ready(Ready),
+        nNext(0) {}
+
+      shared_ptr<Text::Font>           spFont;        ///< Font to upload glyphs of
+      wstring                          sCharacters;   ///< Characters to upload
+      Support::JobScheduler::JobHandle Ready;         ///< Job preparing the glyphs
+      size_t                           nNext;         ///< Next character to upload
+    };
+    typedef std::deque<PendingGlyphs> PendingGlyphsDeque;
     
     static void updateCachedCharacter(
       const Surface::LockInfo &LockedSurface,
       Text::Font *pFont, RealizedFont::Character *pChar
     );
 
+    /// Look up the realized version of a font, creating it if needed
+    RealizedFont &getRealizedFont(const shared_ptr<Text::Font> &spFont);
+    /// Place a character's glyph in the texture cache
+    TextureCache::CacheSlot cacheCharacter(Text::Font *pFont, RealizedFont::Character &Char);
+    /// Upload prewarmed glyphs until the upload budget is used up
+    void uploadPendingGlyphs();
+
+    /// Build the glyph quads of a text run
+    void layoutText(
+      TextRun &Run, const shared_ptr<Text::Font> &spFont, const wstring &sText
+    );
+
     /// The video device
     shared_ptr<VideoDevice> m_spVideoDevice;
     /// Drawing position offsets
@@ -179,6 +326,16 @@ class VertexDrawer {
     VideoDevice::PretransformedVertex m_Primitive[6];
     /// 
     RealizedFontMap m_RealizedFonts;
+    /// Text strings that have already been laid out
+    TextRunMap m_TextRuns;
+    /// Vertices of the text run being drawn
+    TextRun::VertexVector m_TextVertices;
+    /// Number of the current frame
+    size_t m_nFrame;
+    /// Glyphs waiting to be uploaded to the texture cache
+    PendingGlyphsDeque m_PendingGlyphs;
+    /// Time per frame that may be spent uploading glyphs
+    Support::TimeSpan m_UploadBudget;
 };
 
 }} // namespace Nuclex::Video
@@ -11,6 +11,8 @@
 
 #include "ZipPlugin/ZipPlugin.h"
 #include "Nuclex/Storage/StorageServer.h"
+#include "ZipPlugin/Storage/ZipInflater.h"
+#include "ZipPlugin/Storage/ZipIndex.h"
 #include "Zipex/Zipex.h"
 
 namespace Nuclex { namespace Storage {
@@ -23,12 +25,18 @@ namespace Nuclex { namespace Storage {
     store multiple files in a single compressed file. NuclexZip is able
     to directly read from and write to these these files without
     requiring to extract them.
+
+    The archive's files are looked up through a flat hashed ZipIndex.
+    If an index cache directory is specified, the index is saved there
+    and reused as long as the archive's size and modification time stay
+    the same. Zipex is only consulted for files the ZipInflater can't
+    read, like encrypted ones.
 */
 class ZipArchive :
   public Archive {
   public:
     /// Constructor
-    NUCLEXZIP_API ZipArchive(const string &sZIPFile);
+    NUCLEXZIP_API ZipArchive(const string &sZIPFile, const string &sIndexCacheDirectory = "");
     /// Destructor
     NUCLEXZIP_API virtual ~ZipArchive();
 
@@ -60,9 +68,24 @@ class ZipArchive :
     /// Zip sub stoage
     class SubZipArchive;
     friend SubZipArchive;
-    
-    Zipex::ZipArchive m_ZipArchive;                   ///< Zipex archive
+
+    /// Archive file with atomic seek and read
+    class ArchiveStream;
+
+    /// Checkpoint indices of the zipped files
+    typedef std::vector<shared_ptr<ZipInflater::CheckpointIndex> > CheckpointIndexVector;
+
+    /// Load the index from the cache or build it from the archive
+    void loadIndex(const string &sArchive, const string &sIndexCacheDirectory);
+    /// Open a zipped file as stream
+    shared_ptr<Stream> openZippedStream(const string &sPath, Stream::AccessMode eMode) const;
+
+    std::auto_ptr<ArchiveStream> m_spArchiveStream;   ///< Archive file
+    mutable std::auto_ptr<Zipex::ZipArchive> m_spZipArchive; ///< Zipex archive, opened on demand
+    mutable Mutex m_ZipArchiveMutex;                  ///< Guards opening of the zipex archive
     std::auto_ptr<ZipDirectory> m_spDirectory;        ///< Zip directory
+    ZipIndex m_Index;                                 ///< Locations of the zipped files
+    CheckpointIndexVector m_CheckpointIndices;        ///< Checkpoints of large files by index
 };  
 
 //  //
@@ -75,6 +98,16 @@ class ZipArchive :
 class ZipArchiveFactory :
   public StorageServer::ArchiveFactory {
   public:
+    /// Constructor
+    /** Initializes an instance of ZipArchiveFactory
+
+        @param  sIndexCacheDirectory  Directory in which to cache the
+                                      indices of opened archives. Empty
+                                      to disable the cache
+    */
+    NUCLEXZIP_API ZipArchiveFactory(const string &sIndexCacheDirectory = "") :
+      m_sIndexCacheDirectory(sIndexCacheDirectory) {}
+
     /// Destuctor
     /** Destroys an instance of ZipStorageFactory
     */
@@ -89,6 +122,9 @@ class ZipArchiveFactory :
 
     /// Create a storage from the specified source
     NUCLEXZIP_API shared_ptr<Archive> createArchive(const string &sSource);
+
+  private:
+    string m_sIndexCacheDirectory;                    ///< Directory for cached indices
 };
 
 }} // namespace Nuclex::Storage
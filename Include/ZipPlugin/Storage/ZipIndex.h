@@ -0,0 +1,111 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## ZipIndex.h - Zip central directory index                                  //
+// ### # #      ###                                                                            //
+// # ### #      ###  Flat hashed index of the files in a zip archive                           //
+// #  ## #   # ## ## which can be cached on disk between sessions                              //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#ifndef NUCLEX_STORAGE_ZIPINDEX_H
+#define NUCLEX_STORAGE_ZIPINDEX_H
+
+#include "ZipPlugin/ZipPlugin.h"
+#include "Nuclex/Storage/Stream.h"
+#include "Zipex/Stream.h"
+#include <vector>
+
+namespace Nuclex { namespace Storage {
+
+//  //
+//  Nuclex::Storage::ZipIndex                                                                  //
+//  //
+/// Zip archive index
+/** Holds the location and size of every file in a zip archive in a
+    single contiguous array, with all file names packed into one string
+    pool. Files are looked up through an open addressing hash table over
+    the precomputed hashes of their paths, so a lookup costs one hash
+    and usually a single string comparison.
+
+    The index can be saved to and loaded from a stream. Together with
+    a Stamp identifying the state of the archive this allows remounting
+    an unchanged archive without parsing its central directory again.
+*/
+class ZipIndex {
+  public:
+    /// An indexed file
+    struct Entry {
+      unsigned_32    nHash;                           ///< Hash of the file's path
+      size_t         nNameOffset;                     ///< Offset of the path in the name pool
+      size_t         nNameLength;                     ///< Length of the path
+      size_t         nHeaderOffset;                   ///< Offset of the local file header
+      size_t         nCompressedSize;                 ///< Size of the compressed data
+      size_t         nSize;                           ///< Size of the decompressed data
+      unsigned short nMethod;                         ///< Compression method
+      unsigned short nFlags;                          ///< General purpose flags
+    };
+
+    /// Identifies a version of an archive file
+    struct Stamp {
+      /// Constructor
+      Stamp() : nSizeLow(0), nSizeHigh(0), nTimeLow(0), nTimeHigh(0) {}
+
+      /// Check whether two stamps are equal
+      bool operator ==(const Stamp &Other) const {
+        return (nSizeLow == Other.nSizeLow) && (nSizeHigh == Other.nSizeHigh) &&
+               (nTimeLow == Other.nTimeLow) && (nTimeHigh == Other.nTimeHigh);
+      }
+
+      unsigned_32 nSizeLow;                           ///< Low 32 bits of the file size
+      unsigned_32 nSizeHigh;                          ///< High 32 bits of the file size
+      unsigned_32 nTimeLow;                           ///< Low 32 bits of the modification time
+      unsigned_32 nTimeHigh;                          ///< High 32 bits of the modification time
+    };
+
+    /// Returned by find() if a path is not in the index
+    static const size_t NotFound = static_cast<size_t>(-1);
+
+    /// Constructor
+    NUCLEXZIP_API ZipIndex() {}
+
+  //
+  // ZipIndex implementation
+  //
+  public:
+    /// Build the index from an archive's central directory
+    NUCLEXZIP_API void build(Zipex::Stream &ArchiveStream);
+    /// Load the index from a stream if it was saved for the same archive
+    NUCLEXZIP_API bool load(Stream &Source, const string &sArchive, const Stamp &ArchiveStamp);
+    /// Save the index to a stream
+    NUCLEXZIP_API void save(Stream &Target, const string &sArchive, const Stamp &ArchiveStamp) const;
+
+    /// Look up a file by its path
+    NUCLEXZIP_API size_t find(const string &sPath) const;
+
+    /// Get the number of files in the index
+    NUCLEXZIP_API size_t getEntryCount() const { return m_Entries.size(); }
+    /// Get an indexed file
+    NUCLEXZIP_API const Entry &getEntry(size_t nIndex) const { return m_Entries[nIndex]; }
+    /// Get the path of an indexed file
+    NUCLEXZIP_API string getPath(size_t nIndex) const {
+      return string(&m_Names[0] + m_Entries[nIndex].nNameOffset, m_Entries[nIndex].nNameLength);
+    }
+
+    /// Calculate the hash of a path
+    NUCLEXZIP_API static unsigned_32 hash(const char *pszPath, size_t nLength);
+
+  private:
+    typedef std::vector<Entry> EntryVector;
+    typedef std::vector<char> CharVector;
+    typedef std::vector<size_t> SlotVector;
+
+    /// Rebuild the hash table from the entries
+    void buildSlots();
+
+    EntryVector m_Entries;                            ///< All indexed files
+    CharVector  m_Names;                              ///< Pool of file paths
+    SlotVector  m_Slots;                              ///< Hash table of entry index + 1
+};
+
+}} // namespace Nuclex::Storage
+
+#endif // NUCLEX_STORAGE_ZIPINDEX_H
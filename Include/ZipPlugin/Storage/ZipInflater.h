@@ -0,0 +1,141 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## ZipInflater.h - Random access into zipped files                           //
+// ### # #      ###                                                                            //
+// # ### #      ###  Decompresses zipped files in chunks, resuming from                        //
+// #  ## #   # ## ## checkpoints instead of inflating from the beginning                       //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#ifndef NUCLEX_STORAGE_ZIPINFLATER_H
+#define NUCLEX_STORAGE_ZIPINFLATER_H
+
+#include "ZipPlugin/ZipPlugin.h"
+#include "Zipex/Stream.h"
+#include <vector>
+
+namespace Nuclex { namespace Storage {
+
+//  //
+//  Nuclex::Storage::ZipInflater                                                               //
+//  //
+/// Zipped file reader
+/** Reads the contents of a zipped file directly out of the archive
+    without holding the whole file in memory. Only one chunk of
+    decompressed data is kept resident, reads outside of that chunk
+    decompress the chunk they fall into.
+
+    To avoid inflating from the beginning of the file on every backward
+    seek, the inflater records a checkpoint at the first deflate block
+    boundary after every CheckpointSpacing bytes of output. A checkpoint
+    holds the positions in the compressed and decompressed data and the
+    last 32 KB of decompressed data, which is everything zlib needs to
+    resume at that point. Reading anywhere in the file then costs at
+    most CheckpointSpacing bytes of decompression.
+
+    Checkpoints are collected in a CheckpointIndex which can be shared
+    by all inflaters of the same zipped file, so the index is built
+    lazily while the file is being read and survives the stream.
+
+    Stored (uncompressed) files are read straight from the archive.
+
+    All access to the archive goes through readDataAt(), so the archive
+    stream has to make seeking and reading a single atomic operation if
+    inflaters are used from multiple threads.
+*/
+class ZipInflater {
+  public:
+    enum {
+      WindowSize = 32768,                             ///< Size of the deflate window
+      ChunkSize = 65536,                              ///< Decompressed bytes kept resident
+      CheckpointSpacing = 1048576                     ///< Decompressed bytes between checkpoints
+    };
+
+    /// Point at which decompression can be resumed
+    struct Checkpoint {
+      size_t        nOutput;                          ///< Position in decompressed data
+      size_t        nInput;                           ///< Position in compressed data
+      int           nBits;                            ///< Bits of the previous byte to use
+      unsigned char Window[WindowSize];               ///< Decompressed data before nOutput
+    };
+
+    /// Checkpoints of a zipped file
+    /** Checkpoints are appended in order of their output position by
+        whichever inflater first decompresses past the last checkpoint.
+    */
+    struct CheckpointIndex {
+      typedef std::vector<shared_ptr<Checkpoint> > CheckpointVector;
+
+      Mutex            Lock;                          ///< Guards the checkpoints
+      CheckpointVector Checkpoints;                   ///< Checkpoints by output position
+    };
+
+    /// Constructor
+    NUCLEXZIP_API ZipInflater(Zipex::Stream &ArchiveStream, size_t nHeaderOffset,
+                              bool bDeflated, size_t nCompressedSize, size_t nSize,
+                              const shared_ptr<CheckpointIndex> &spIndex);
+    /// Destructor
+    NUCLEXZIP_API ~ZipInflater();
+
+  //
+  // ZipInflater implementation
+  //
+  public:
+    /// Get the size of the decompressed file
+    NUCLEXZIP_API size_t getSize() const { return m_nSize; }
+
+    /// Read decompressed data from the specified location
+    NUCLEXZIP_API size_t readDataAt(size_t nPosition, void *pDest, size_t nBytes);
+
+    /// Release the resident chunk and the decompressor
+    NUCLEXZIP_API void flush();
+
+    /// Get the number of times decompression was restarted
+    /** Counts every (re)initialization of the decompressor, at the
+        beginning of the file or at a checkpoint. Reading a file
+        sequentially should only cost a single restart.
+    */
+    NUCLEXZIP_API size_t getRestartCount() const { return m_nRestarts; }
+
+  private:
+    /// Private copy constructor
+    ZipInflater(const ZipInflater &);
+    /// Private assignment operator
+    ZipInflater &operator =(const ZipInflater &);
+
+    typedef std::vector<unsigned char> ByteVector;
+
+    /// Read raw data of the zipped file from the archive
+    size_t readCompressed(size_t nOffset, void *pDest, size_t nBytes);
+    /// Decompress the chunk starting at the specified position
+    void fillChunk(size_t nChunkStart);
+    /// Restart decompression at a checkpoint or at the beginning
+    void restart(const Checkpoint *pCheckpoint);
+    /// Record a checkpoint at the current decompressor position
+    void addCheckpoint();
+    /// Find the last checkpoint at or before the specified position
+    shared_ptr<Checkpoint> findCheckpoint(size_t nPosition);
+
+    Zipex::Stream               &m_ArchiveStream;     ///< Stream of the zip archive
+    size_t                       m_nDataOffset;       ///< Offset of the file's data in the archive
+    bool                         m_bDeflated;         ///< Whether the file is deflated
+    size_t                       m_nCompressedSize;   ///< Size of the compressed data
+    size_t                       m_nSize;             ///< Size of the decompressed data
+    shared_ptr<CheckpointIndex>  m_spIndex;           ///< Checkpoints, can be empty
+
+    ByteVector                   m_Chunk;             ///< Resident decompressed chunk
+    size_t                       m_nChunkStart;       ///< Position of the chunk
+    size_t                       m_nChunkLength;      ///< Valid bytes in the chunk
+
+    bool                         m_bInflating;        ///< Whether m_ZLibStream is initialized
+    z_stream                     m_ZLibStream;        ///< ZLib decompressor state
+    size_t                       m_nInput;            ///< Compressed bytes fed to zlib
+    size_t                       m_nOutput;           ///< Decompressed bytes produced by zlib
+    ByteVector                   m_InputBuffer;       ///< Compressed data buffer
+    ByteVector                   m_Window;            ///< Circular buffer of recent output
+    size_t                       m_nWindowPosition;   ///< Next write position in the window
+    size_t                       m_nRestarts;         ///< Decompressor (re)initializations
+};
+
+}} // namespace Nuclex::Storage
+
+#endif // NUCLEX_STORAGE_ZIPINFLATER_H
@@ -12,6 +12,7 @@
 #include "ZipPlugin/ZipPlugin.h"
 #include "Nuclex/Support/Exception.h"
 #include "Nuclex/Storage/Stream.h"
+#include "ZipPlugin/Storage/ZipInflater.h"
 #include "Zipex/Zipex.h"
 
 namespace Nuclex { namespace Storage {
@@ -27,6 +28,8 @@ class ZipStream :
   public:
     /// Constructor
     NUCLEXZIP_API ZipStream(Zipex::ZippedFile &ZipexFile, AccessMode eMode);
+    /// Constructor
+    NUCLEXZIP_API ZipStream(std::auto_ptr<ZipInflater> spInflater, AccessMode eMode);
 
     /// Destructor
     NUCLEXZIP_API virtual ~ZipStream() {}
@@ -56,9 +59,10 @@ class ZipStream :
     NUCLEXZIP_API void flush();
   
   private:
-    Zipex::ZippedFile  &m_ZipexFile;
-    size_t              m_Location;
-    AccessMode          m_eAccessMode;                ///< Stream access mode
+    Zipex::ZippedFile          *m_pZipexFile;         ///< Zipex file, if not using the inflater
+    std::auto_ptr<ZipInflater>  m_spInflater;         ///< Random access reader, can be empty
+    size_t                      m_Location;
+    AccessMode                  m_eAccessMode;        ///< Stream access mode
 };
 
 }} // namespace Nuclex::Storage
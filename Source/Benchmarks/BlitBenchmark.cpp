@@ -0,0 +1,342 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## BlitBenchmark.cpp - Blit kernel speed               //
+// ### # #      ###                                                      //
+// # ### #      ###  Checks the BlitKernels against the generic Blit     //
+// #  ## #   # ## ## template and measures both                          //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+//
+// Checks the SSE2 BlitKernels against the generic Blit template and
+// measures both, in Mpixel/s for each pixel format pair with a kernel:
+//
+//   blend         argb-8-8-8-8 alpha blended onto argb-8-8-8-8
+//   argb to 565   argb-8-8-8-8 converted to rgb-5-6-5
+//   xrgb to 565   xrgb-8-8-8-8 converted to rgb-5-6-5
+//   565 to argb   rgb-5-6-5 converted to argb-8-8-8-8
+//   565 to xrgb   rgb-5-6-5 converted to xrgb-8-8-8-8
+//
+// The kernels have to produce exactly the bytes the generic template does,
+// so each kernel is run on a copy of the destination and compared against
+// Blit::generic() before anything is timed. The inputs cover:
+//
+//   blend         every source alpha with every pair of channel values
+//   to 565        every 8-8-8 color, with varying bytes in the top byte
+//   from 565      every 5-6-5 color
+//   all pairs     random surfaces of 1 to 33 pixels wide with padded
+//                 pitches, for the row tails and writes past a row
+//
+// The program fails on the first difference, so rerun it whenever the
+// kernels change. On a cpu without SSE2 the kernels decline every blit,
+// which is reported and leaves nothing to compare.
+//
+// Build from this directory with:
+// cl /O2 /EHsc /I..\..\Include BlitBenchmark.cpp
+//    ..\..\Lib\Nuclex\Nuclex-i.lib /Fe..\..\Bin\BlitBenchmark.exe
+//
+#include "Nuclex/Video/Blit.h"
+#include <windows.h>
+#include <vector>
+#include <cstdio>
+
+using namespace Nuclex;
+using namespace Nuclex::Video;
+
+namespace {
+
+/// Width and height of the surface the measurements use
+const unsigned long MeasureSize = 1024;
+/// Minimum time a measurement runs, in seconds
+const double MinimumDuration = 0.5;
+/// Number of bytes added to every row as padding the blits must not touch
+const long PitchPadding = 12;
+
+// ####################################################################### //
+// # getSeconds()                                                        # //
+// ####################################################################### //
+/** Returns the value of a high resolution timer in seconds */
+double getSeconds() {
+  LARGE_INTEGER Frequency, Counter;
+  ::QueryPerformanceFrequency(&Frequency);
+  ::QueryPerformanceCounter(&Counter);
+  return static_cast<double>(Counter.QuadPart) / static_cast<double>(Frequency.QuadPart);
+}
+
+// ####################################################################### //
+// # getRandom()                                                         # //
+// ####################################################################### //
+/** Returns the next value of a xorshift random number generator */
+unsigned long getRandom() {
+  static unsigned long nState = 0x2545F491;
+  nState ^= nState << 13;
+  nState ^= nState >> 17;
+  nState ^= nState << 5;
+  return nState & 0xFFFFFFFF;
+}
+
+//  //
+//  Surface                                                              //
+//  //
+/// Pixels of a test surface
+/** Rows are padded by PitchPadding bytes, so blits writing past the end
+    of a row change bytes that are compared as well
+*/
+template<typename PixelFormatDescription>
+class Surface {
+  public:
+    typedef typename PixelFormatDescription::PixelType PixelType;
+
+    /// Constructor
+    Surface(const Point2<unsigned long> &Size) :
+      m_Size(Size),
+      m_nPitch(Size.X * PixelFormatDescription::BytesPerPixel + PitchPadding),
+      m_Data(m_nPitch * Size.Y) {
+      for(size_t Index = 0; Index < m_Data.size(); ++Index)
+        m_Data[Index] = static_cast<unsigned char>(getRandom());
+    }
+
+    /// Get the surface's size in pixels
+    const Point2<unsigned long> &getSize() const { return m_Size; }
+    /// Get the number of bytes from one row to the next
+    long getPitch() const { return m_nPitch; }
+    /// Get the address of the first pixel
+    unsigned char *getData() { return &m_Data[0]; }
+    const unsigned char *getData() const { return &m_Data[0]; }
+
+    /// Set a pixel
+    void setPixel(unsigned long nX, unsigned long nY, PixelType Pixel) {
+      *reinterpret_cast<PixelType *>(
+        &m_Data[nY * m_nPitch + nX * PixelFormatDescription::BytesPerPixel]
+      ) = Pixel;
+    }
+
+    /// Get the offset of the first byte which differs from another surface
+    /** @return The byte offset or -1 if both surfaces are identical
+    */
+    long findDifference(const Surface &Other) const {
+      for(size_t Index = 0; Index < m_Data.size(); ++Index)
+        if(m_Data[Index] != Other.m_Data[Index])
+          return static_cast<long>(Index);
+
+      return -1;
+    }
+
+  private:
+    Point2<unsigned long>      m_Size;                ///< Size in pixels
+    long                       m_nPitch;              ///< Bytes per row
+    std::vector<unsigned char> m_Data;                ///< Pixels and padding
+};
+
+// ####################################################################### //
+// # compare()                                                           # //
+// ####################################################################### //
+/** Blits a surface through the kernel and through the generic template
+    and compares the results
+
+    @param  pszName      Name of the format pair for error messages
+    @param  Destination  Destination surface, left unchanged
+    @param  Source       Source surface
+    @param  bAvailable   Set to false if the kernel declined the blit
+    @return True if both produced the same bytes
+*/
+template<typename DestinationFormat, typename SourceFormat, bool bAlphaBlend>
+bool compare(const char *pszName, const Surface<DestinationFormat> &Destination,
+             const Surface<SourceFormat> &Source, bool &bAvailable) {
+  Surface<DestinationFormat> KernelResult(Destination);
+  bAvailable = BlitKernel<DestinationFormat, SourceFormat, bAlphaBlend>()(
+    KernelResult.getData(), KernelResult.getPitch(),
+    Source.getData(), Source.getPitch(), Source.getSize()
+  );
+  if(!bAvailable)
+    return true;
+
+  Surface<DestinationFormat> GenericResult(Destination);
+  Blit<DestinationFormat, SourceFormat, bAlphaBlend>().generic(
+    GenericResult.getData(), GenericResult.getPitch(),
+    Source.getData(), Source.getPitch(), Source.getSize()
+  );
+
+  long nOffset = KernelResult.findDifference(GenericResult);
+  if(nOffset == -1)
+    return true;
+
+  std::printf(
+    "%s: kernel differs from the generic blit on a %lux%lu surface\n"
+    "  row %ld, byte %ld of the row: kernel 0x%02X, generic 0x%02X\n",
+    pszName, Source.getSize().X, Source.getSize().Y,
+    nOffset / Destination.getPitch(), nOffset % Destination.getPitch(),
+    KernelResult.getData()[nOffset], GenericResult.getData()[nOffset]
+  );
+  return false;
+}
+
+// ####################################################################### //
+// # compareRandom()                                                     # //
+// ####################################################################### //
+/** Compares the kernel against the generic template on random surfaces
+    of all widths from 1 to 33 pixels
+*/
+template<typename DestinationFormat, typename SourceFormat, bool bAlphaBlend>
+bool compareRandom(const char *pszName, bool &bAvailable) {
+  for(unsigned long nWidth = 1; nWidth <= 33; ++nWidth) {
+    Point2<unsigned long> Size(nWidth, 3);
+    if(!compare<DestinationFormat, SourceFormat, bAlphaBlend>(
+      pszName, Surface<DestinationFormat>(Size), Surface<SourceFormat>(Size), bAvailable
+    ))
+      return false;
+  }
+
+  return true;
+}
+
+// ####################################################################### //
+// # checkBlend()                                                        # //
+// ####################################################################### //
+/** Checks the argb-8-8-8-8 blend kernel. Each surface holds all 65536
+    combinations of a source and a destination channel value, each color
+    channel getting them in a different order, and there is one surface
+    for each source alpha value.
+*/
+bool checkBlend(bool &bAvailable) {
+  const char *pszName = "blend";
+  Point2<unsigned long> Size(256, 256);
+  Surface<ARGB_8_8_8_8> Destination(Size);
+  Surface<ARGB_8_8_8_8> Source(Size);
+
+  for(unsigned long nAlpha = 0; nAlpha < 256; ++nAlpha) {
+    for(unsigned long nY = 0; nY < 256; ++nY) {
+      for(unsigned long nX = 0; nX < 256; ++nX) {
+        Source.setPixel(nX, nY, (nAlpha << 24) | (nY << 16) | ((nY ^ 0x5A) << 8) | (255 - nY));
+        Destination.setPixel(nX, nY, (nX << 24) | (nX << 16) | ((nX ^ 0xA5) << 8) | nX);
+      }
+    }
+
+    if(!compare<ARGB_8_8_8_8, ARGB_8_8_8_8, true>(pszName, Destination, Source, bAvailable))
+      return false;
+    if(!bAvailable)
+      return true;
+  }
+
+  return compareRandom<ARGB_8_8_8_8, ARGB_8_8_8_8, true>(pszName, bAvailable);
+}
+
+// ####################################################################### //
+// # checkTo565()                                                        # //
+// ####################################################################### //
+/** Checks a kernel converting to rgb-5-6-5 with every 8-8-8 color, in
+    blocks of 256 rows of 4096 pixels
+*/
+template<typename SourceFormat>
+bool checkTo565(const char *pszName, bool &bAvailable) {
+  Point2<unsigned long> Size(4096, 256);
+  Surface<RGB_5_6_5> Destination(Size);
+  Surface<SourceFormat> Source(Size);
+
+  for(unsigned long nBlock = 0; nBlock < 16; ++nBlock) {
+    for(unsigned long nY = 0; nY < 256; ++nY)
+      for(unsigned long nX = 0; nX < 4096; ++nX)
+        Source.setPixel(
+          nX, nY, (getRandom() & 0xFF000000) | (((nBlock * 256) + nY) << 12) | nX
+        );
+
+    if(!compare<RGB_5_6_5, SourceFormat, false>(pszName, Destination, Source, bAvailable))
+      return false;
+    if(!bAvailable)
+      return true;
+  }
+
+  return compareRandom<RGB_5_6_5, SourceFormat, false>(pszName, bAvailable);
+}
+
+// ####################################################################### //
+// # checkFrom565()                                                      # //
+// ####################################################################### //
+/** Checks a kernel converting from rgb-5-6-5 with every 5-6-5 color */
+template<typename DestinationFormat>
+bool checkFrom565(const char *pszName, bool &bAvailable) {
+  Point2<unsigned long> Size(256, 256);
+  Surface<DestinationFormat> Destination(Size);
+  Surface<RGB_5_6_5> Source(Size);
+
+  for(unsigned long nY = 0; nY < 256; ++nY)
+    for(unsigned long nX = 0; nX < 256; ++nX)
+      Source.setPixel(nX, nY, static_cast<unsigned_16>((nY << 8) | nX));
+
+  if(!compare<DestinationFormat, RGB_5_6_5, false>(pszName, Destination, Source, bAvailable))
+    return false;
+  if(!bAvailable)
+    return true;
+
+  return compareRandom<DestinationFormat, RGB_5_6_5, false>(pszName, bAvailable);
+}
+
+// ####################################################################### //
+// # measure()                                                           # //
+// ####################################################################### //
+/** Measures the generic template and the kernel for a format pair and
+    prints the results in Mpixel/s
+*/
+template<typename DestinationFormat, typename SourceFormat, bool bAlphaBlend>
+void measure(const char *pszName) {
+  Point2<unsigned long> Size(MeasureSize, MeasureSize);
+  Surface<DestinationFormat> Destination(Size);
+  Surface<SourceFormat> Source(Size);
+  Blit<DestinationFormat, SourceFormat, bAlphaBlend> Blitter;
+
+  double Results[2];
+  for(size_t Variant = 0; Variant < 2; ++Variant) {
+    size_t Count = 0;
+    double Start = getSeconds();
+    double Elapsed;
+    do {
+      if(Variant == 0)
+        Blitter.generic(
+          Destination.getData(), Destination.getPitch(), Source.getData(), Source.getPitch(), Size
+        );
+      else
+        Blitter(
+          Destination.getData(), Destination.getPitch(), Source.getData(), Source.getPitch(), Size
+        );
+
+      ++Count;
+      Elapsed = getSeconds() - Start;
+    } while(Elapsed < MinimumDuration);
+
+    Results[Variant] = static_cast<double>(MeasureSize * MeasureSize) * Count / Elapsed / 1000000.0;
+  }
+
+  std::printf("%-14s %10.1f %10.1f %7.1fx\n",
+              pszName, Results[0], Results[1], Results[1] / Results[0]);
+}
+
+} // namespace
+
+// ####################################################################### //
+// # main()                                                              # //
+// ####################################################################### //
+int main() {
+  bool bExact = true;
+  bool bAvailable = true;
+
+  bExact = bExact && checkBlend(bAvailable);
+  bExact = bExact && checkTo565<ARGB_8_8_8_8>("argb to 565", bAvailable);
+  bExact = bExact && checkTo565<XRGB_8_8_8_8>("xrgb to 565", bAvailable);
+  bExact = bExact && checkFrom565<ARGB_8_8_8_8>("565 to argb", bAvailable);
+  bExact = bExact && checkFrom565<XRGB_8_8_8_8>("565 to xrgb", bAvailable);
+  if(!bExact)
+    return 1;
+
+  if(bAvailable)
+    std::printf("All kernels match the generic blit\n\n");
+  else
+    std::printf("The kernels are not available on this cpu\n\n");
+
+  std::printf("%-14s %10s %10s %8s\n", "Mpixel/s", "generic", "Blit", "speedup");
+  measure<ARGB_8_8_8_8, ARGB_8_8_8_8, true>("blend");
+  measure<RGB_5_6_5, ARGB_8_8_8_8, false>("argb to 565");
+  measure<RGB_5_6_5, XRGB_8_8_8_8, false>("xrgb to 565");
+  measure<ARGB_8_8_8_8, RGB_5_6_5, false>("565 to argb");
+  measure<XRGB_8_8_8_8, RGB_5_6_5, false>("565 to xrgb");
+
+  return 0;
+}
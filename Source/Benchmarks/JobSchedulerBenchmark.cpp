@@ -0,0 +1,428 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## JobSchedulerBenchmark.cpp - Scheduler throughput    //
+// ### # #      ###                                                      //
+// # ### #      ###  Compares the JobScheduler against the locked task   //
+// #  ## #   # ## ## deque the ThreadPool used before                    //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+//
+// Throughput benchmark for the work-stealing JobScheduler. The former
+// ThreadPool kept all tasks in one std::deque behind a mutex; a copy of it
+// is kept here as LockedQueuePool so both can be measured on the same
+// workloads for 1, 2, 4 and 8 worker threads:
+//
+//   jobs         100000 small independent jobs
+//   nested       a binary tree of jobs, each job spawning its two children
+//   parallelFor  a sum over 4M integers in chunks of 1024 indices
+//
+// The only change to the old pool is that a worker is marked as working
+// when it gets woken up. The original never set the flag and reset the
+// wake up signal after checking the queue, so it could lose wake ups and
+// leave this benchmark waiting forever.
+//
+// Build from this directory with:
+// cl /O2 /EHsc /I..\..\Include JobSchedulerBenchmark.cpp
+//    ..\..\Lib\Nuclex\Nuclex-i.lib /Fe..\..\Bin\JobSchedulerBenchmark.exe
+//
+#include "Nuclex/Support/JobScheduler.h"
+#include "Nuclex/Support/Synchronization.h"
+#include <vector>
+#include <deque>
+#include <cstdio>
+
+using namespace Nuclex;
+using namespace Nuclex::Support;
+
+namespace {
+
+/// Number of jobs in the independent jobs workload
+const size_t JobCount = 100000;
+/// Depth of the job tree in the nested workload
+const size_t TreeDepth = 16;
+/// Number of integers summed up in the parallelFor workload
+const size_t ElementCount = 4 * 1024 * 1024;
+/// Number of indices processed by one chunk of the parallelFor workload
+const size_t ChunkSize = 1024;
+/// Largest number of worker threads measured
+const size_t MaxThreadCount = 8;
+
+/// Keeps the compiler from optimizing the simulated work away
+volatile unsigned long g_nSink = 0;
+
+// ####################################################################### //
+// # doWork()                                                            # //
+// ####################################################################### //
+/** Simulates the work of a small job, about the cost of decoding a few
+    hundred bytes
+*/
+void doWork(unsigned long nSeed) {
+  unsigned long nValue = nSeed + 1;
+  for(size_t Index = 0; Index < 256; ++Index) {
+    nValue ^= nValue << 13;
+    nValue ^= nValue >> 17;
+    nValue ^= nValue << 5;
+  }
+  g_nSink += nValue;
+}
+
+// ####################################################################### //
+// # getSeconds()                                                        # //
+// ####################################################################### //
+/** Returns the value of a high resolution timer in seconds */
+double getSeconds() {
+  LARGE_INTEGER Frequency, Counter;
+  ::QueryPerformanceFrequency(&Frequency);
+  ::QueryPerformanceCounter(&Counter);
+  return static_cast<double>(Counter.QuadPart) / static_cast<double>(Frequency.QuadPart);
+}
+
+//  //
+//  LockedQueuePool                                                      //
+//  //
+/// The former ThreadPool
+/** All tasks go through a single deque guarded by one mutex and every
+    worker sleeps on its own signal.
+*/
+class LockedQueuePool {
+  public:
+    /// Constructor
+    LockedQueuePool(size_t NumThreads) :
+      m_WorkerThreads(NumThreads) {
+
+      for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
+          It != m_WorkerThreads.end();
+          ++It) {
+        It->second = new WorkerThread(*this);
+        It->first = shared_ptr<Thread>(new Thread(std::auto_ptr<Thread::Function>(It->second)));
+      }
+    }
+
+    /// Destructor
+    ~LockedQueuePool() {
+      for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
+          It != m_WorkerThreads.end();
+          ++It) {
+        It->first->requestStop();
+        It->second->getSignal().set();
+      }
+
+      for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
+          It != m_WorkerThreads.end();
+          ++It)
+        It->first->join();
+    }
+
+    /// Enqueue a task to be executed
+    void enqueue(std::auto_ptr<Thread::Function> spTask) {
+      Mutex::ScopedLock TaskLock(m_TasksMutex);
+      m_Tasks.push_back(shared_ptr<Thread::Function>(spTask.release()));
+
+      for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
+          It != m_WorkerThreads.end();
+          ++It) {
+        if(!It->second->isWorking()) {
+          It->second->setWorking();
+          It->second->getSignal().set();
+          break;
+        }
+      }
+    }
+
+  private:
+    /// A worker thread
+    struct WorkerThread :
+      public Thread::Function {
+      /// Constructor
+      WorkerThread(LockedQueuePool &Owner) :
+        m_Owner(Owner),
+        m_bStopRequested(false),
+        m_bWorking(true) {}
+
+      /// The threaded method
+      void operator()() {
+        while(!m_bStopRequested) {
+          shared_ptr<Thread::Function> spTask;
+
+          { Mutex::ScopedLock TaskLock(m_Owner.m_TasksMutex);
+
+            if(m_Owner.m_Tasks.size() > 0) {
+              spTask = m_Owner.m_Tasks.front();
+              m_Owner.m_Tasks.pop_front();
+            } else {
+              m_bWorking = false;
+            }
+          }
+
+          if(spTask)
+            spTask->operator()();
+          else
+            m_Signal.wait();
+        }
+      }
+
+      /// Request the thread to stop
+      void requestStop() { m_bStopRequested = true; }
+      /// Access signal for suspending idle threads
+      Signal &getSignal() { return m_Signal; }
+      /// Check whether the thread is currently working
+      bool isWorking() const { return m_bWorking; }
+      /// Mark the thread as working, the tasks mutex must be held
+      void setWorking() { m_bWorking = true; }
+
+      private:
+        LockedQueuePool &m_Owner;                     ///< The worker thread's owner
+        Signal           m_Signal;                    ///< Signal to suspend thread
+        volatile bool    m_bStopRequested;            ///< Whether a stop was requested
+        volatile bool    m_bWorking;                  ///< Whether the thread is working
+    };
+
+    typedef std::vector<std::pair<shared_ptr<Thread>, WorkerThread *> > WorkerThreadVector;
+    typedef std::deque<shared_ptr<Thread::Function> > TaskDeque;
+
+    WorkerThreadVector m_WorkerThreads;
+    Mutex              m_TasksMutex;
+    TaskDeque          m_Tasks;
+};
+
+//  //
+//  Completion                                                           //
+//  //
+/// Counts down finished tasks of the locked queue pool
+class Completion {
+  public:
+    /// Constructor
+    Completion(long nCount) :
+      m_nRemaining(nCount),
+      m_Signal(true) {}
+
+    /// Mark one task as finished
+    void finish() {
+      if(::InterlockedDecrement(&m_nRemaining) == 0)
+        m_Signal.set();
+    }
+
+    /// Wait until all tasks have finished
+    void wait() {
+      m_Signal.wait();
+    }
+
+  private:
+    volatile long m_nRemaining;                       ///< Unfinished tasks
+    Signal        m_Signal;                           ///< Set when all are done
+};
+
+//  //
+//  Jobs of the workloads                                                //
+//  //
+/// A small job for the locked queue pool
+class PoolJob :
+  public Thread::Function {
+  public:
+    PoolJob(Completion &Done, unsigned long nSeed) : m_Done(Done), m_nSeed(nSeed) {}
+    void operator()() { doWork(m_nSeed); m_Done.finish(); }
+
+  private:
+    Completion    &m_Done;
+    unsigned long  m_nSeed;
+};
+
+/// A small job for the scheduler
+class SchedulerJob :
+  public Thread::Function {
+  public:
+    SchedulerJob(unsigned long nSeed) : m_nSeed(nSeed) {}
+    void operator()() { doWork(m_nSeed); }
+
+  private:
+    unsigned long m_nSeed;
+};
+
+/// Spawns the independent jobs as children of itself
+class SpawnJob :
+  public Thread::Function {
+  public:
+    SpawnJob(JobScheduler &Scheduler) : m_Scheduler(Scheduler) {}
+    void operator()() {
+      JobScheduler::JobHandle Self = m_Scheduler.getCurrentJob();
+      for(size_t Index = 0; Index < JobCount; ++Index)
+        m_Scheduler.schedule(std::auto_ptr<Thread::Function>(new SchedulerJob(Index)), Self);
+    }
+
+  private:
+    JobScheduler &m_Scheduler;
+};
+
+/// A node of the job tree for the locked queue pool
+class PoolTreeJob :
+  public Thread::Function {
+  public:
+    PoolTreeJob(LockedQueuePool &Pool, Completion &Done, size_t Depth) :
+      m_Pool(Pool), m_Done(Done), m_Depth(Depth) {}
+    void operator()() {
+      if(m_Depth > 1) {
+        m_Pool.enqueue(std::auto_ptr<Thread::Function>(new PoolTreeJob(m_Pool, m_Done, m_Depth - 1)));
+        m_Pool.enqueue(std::auto_ptr<Thread::Function>(new PoolTreeJob(m_Pool, m_Done, m_Depth - 1)));
+      }
+      doWork(static_cast<unsigned long>(m_Depth));
+      m_Done.finish();
+    }
+
+  private:
+    LockedQueuePool &m_Pool;
+    Completion      &m_Done;
+    size_t           m_Depth;
+};
+
+/// A node of the job tree for the scheduler
+class SchedulerTreeJob :
+  public Thread::Function {
+  public:
+    SchedulerTreeJob(JobScheduler &Scheduler, size_t Depth) :
+      m_Scheduler(Scheduler), m_Depth(Depth) {}
+    void operator()() {
+      if(m_Depth > 1) {
+        JobScheduler::JobHandle Self = m_Scheduler.getCurrentJob();
+        m_Scheduler.schedule(std::auto_ptr<Thread::Function>(new SchedulerTreeJob(m_Scheduler, m_Depth - 1)), Self);
+        m_Scheduler.schedule(std::auto_ptr<Thread::Function>(new SchedulerTreeJob(m_Scheduler, m_Depth - 1)), Self);
+      }
+      doWork(static_cast<unsigned long>(m_Depth));
+    }
+
+  private:
+    JobScheduler &m_Scheduler;
+    size_t        m_Depth;
+};
+
+/// Sums up a range of the elements, used by both parallelFor variants
+class SumRange {
+  public:
+    SumRange(const std::vector<unsigned long> &Elements) : m_Elements(Elements) {}
+    void operator()(size_t Begin, size_t End) {
+      unsigned long nSum = 0;
+      for(size_t Index = Begin; Index < End; ++Index)
+        nSum += m_Elements[Index];
+      ::InterlockedExchangeAdd(&m_nSum, static_cast<long>(nSum));
+    }
+
+    static volatile long m_nSum;
+
+  private:
+    const std::vector<unsigned long> &m_Elements;
+};
+
+volatile long SumRange::m_nSum = 0;
+
+/// A chunk of the parallelFor workload for the locked queue pool
+class PoolChunkJob :
+  public Thread::Function {
+  public:
+    PoolChunkJob(SumRange &Sum, Completion &Done, size_t Begin, size_t End) :
+      m_Sum(Sum), m_Done(Done), m_Begin(Begin), m_End(End) {}
+    void operator()() { m_Sum(m_Begin, m_End); m_Done.finish(); }
+
+  private:
+    SumRange   &m_Sum;
+    Completion &m_Done;
+    size_t      m_Begin;
+    size_t      m_End;
+};
+
+//  //
+//  Workloads                                                            //
+//  //
+/// Measures the independent jobs, returns jobs per second
+double runJobs(LockedQueuePool &Pool) {
+  Completion Done(static_cast<long>(JobCount));
+  double Start = getSeconds();
+  for(size_t Index = 0; Index < JobCount; ++Index)
+    Pool.enqueue(std::auto_ptr<Thread::Function>(new PoolJob(Done, Index)));
+  Done.wait();
+  return JobCount / (getSeconds() - Start);
+}
+
+double runJobs(JobScheduler &Scheduler) {
+  double Start = getSeconds();
+  Scheduler.wait(Scheduler.schedule(std::auto_ptr<Thread::Function>(new SpawnJob(Scheduler))));
+  return JobCount / (getSeconds() - Start);
+}
+
+/// Measures the job tree, returns jobs per second
+double runNested(LockedQueuePool &Pool) {
+  const long NodeCount = (1L << TreeDepth) - 1;
+  Completion Done(NodeCount);
+  double Start = getSeconds();
+  Pool.enqueue(std::auto_ptr<Thread::Function>(new PoolTreeJob(Pool, Done, TreeDepth)));
+  Done.wait();
+  return NodeCount / (getSeconds() - Start);
+}
+
+double runNested(JobScheduler &Scheduler) {
+  const long NodeCount = (1L << TreeDepth) - 1;
+  double Start = getSeconds();
+  Scheduler.wait(Scheduler.schedule(
+    std::auto_ptr<Thread::Function>(new SchedulerTreeJob(Scheduler, TreeDepth))
+  ));
+  return NodeCount / (getSeconds() - Start);
+}
+
+/// Measures the parallel sum, returns chunks per second
+double runParallelFor(LockedQueuePool &Pool, SumRange &Sum) {
+  const size_t ChunkCount = ElementCount / ChunkSize;
+  Completion Done(static_cast<long>(ChunkCount));
+  double Start = getSeconds();
+  for(size_t Index = 0; Index < ElementCount; Index += ChunkSize)
+    Pool.enqueue(std::auto_ptr<Thread::Function>(new PoolChunkJob(Sum, Done, Index, Index + ChunkSize)));
+  Done.wait();
+  return ChunkCount / (getSeconds() - Start);
+}
+
+double runParallelFor(JobScheduler &Scheduler, SumRange &Sum) {
+  const size_t ChunkCount = ElementCount / ChunkSize;
+  double Start = getSeconds();
+  Scheduler.parallelFor(0, ElementCount, Sum, ChunkSize);
+  return ChunkCount / (getSeconds() - Start);
+}
+
+} // namespace
+
+// ####################################################################### //
+// # main()                                                              # //
+// ####################################################################### //
+int main() {
+  std::vector<unsigned long> Elements(ElementCount);
+  for(size_t Index = 0; Index < ElementCount; ++Index)
+    Elements[Index] = static_cast<unsigned long>(Index & 0xFF);
+  SumRange Sum(Elements);
+
+  const char *Names[] = { "jobs", "nested", "parallelFor" };
+  double Results[3][2][4];
+
+  size_t Column = 0;
+  for(size_t ThreadCount = 1; ThreadCount <= MaxThreadCount; ThreadCount *= 2, ++Column) {
+    { LockedQueuePool Pool(ThreadCount);
+      Results[0][0][Column] = runJobs(Pool);
+      Results[1][0][Column] = runNested(Pool);
+      Results[2][0][Column] = runParallelFor(Pool, Sum);
+    }
+    { JobScheduler Scheduler(ThreadCount);
+      Results[0][1][Column] = runJobs(Scheduler);
+      Results[1][1][Column] = runNested(Scheduler);
+      Results[2][1][Column] = runParallelFor(Scheduler, Sum);
+    }
+  }
+
+  std::printf("%-28s %8s %8s %8s %8s\n", "threads", "1", "2", "4", "8");
+  for(size_t Workload = 0; Workload < 3; ++Workload) {
+    for(size_t Variant = 0; Variant < 2; ++Variant) {
+      std::printf(
+        "%-11s %-16s", Names[Workload], Variant ? "JobScheduler" : "LockedQueuePool"
+      );
+      for(size_t Column = 0; Column < 4; ++Column)
+        std::printf(" %8.3f", Results[Workload][Variant][Column] / 1000000.0);
+      std::printf("  M jobs per second\n");
+    }
+  }
+
+  return 0;
+}
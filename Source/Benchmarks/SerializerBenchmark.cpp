@@ -0,0 +1,319 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## SerializerBenchmark.cpp - Serializer load time      //
+// ### # #      ###                                                      //
+// # ### #      ###  Compares loading descriptions through the XML       //
+// #  ## #   # ## ## and the binary serializer                           //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+//
+// Load time benchmark for the BinarySerializer. Each description named on
+// the command line is converted with BinarySerializer::fromXML() and then
+// read through the Serializer interface in both formats:
+//
+//   xml     constructing an XMLSerializer on the XML text and reading
+//           every value and every scope of the description
+//   binary  the same on a BinarySerializer over the converted data
+//
+// Without arguments the themes and the Toxid settings in Bin are used.
+// The settings are small, but they are the only file in the tree with
+// elements that contain just text. There is no terrain description in the
+// tree. Pass the terrain descriptions of a game to include them.
+//
+// Before anything is timed, both formats are read back and compared. This
+// covers every attribute, every child element value, every openScope()
+// and every enumScopes() of the XML document. If the converted data reads
+// back differently, the program prints the first difference and fails, so
+// it also serves as the round trip check for fromXML().
+//
+// Build from this directory with:
+// cl /O2 /EHsc /I..\..\Include SerializerBenchmark.cpp
+//    ..\..\Lib\Nuclex\Nuclex-i.lib ..\..\Lib\TinyXML\tinyxml.msvc8sp1.lib
+//    /Fe..\..\Bin\SerializerBenchmark.exe
+//
+#include "Nuclex/Storage/XMLSerializer.h"
+#include "Nuclex/Storage/BinarySerializer.h"
+#include <windows.h>
+#include <vector>
+#include <set>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+
+using namespace Nuclex;
+using namespace Nuclex::Storage;
+
+namespace {
+
+/// Minimum time a measurement runs, in seconds
+const double MinimumDuration = 0.5;
+
+/// Keeps the compiler from optimizing the loads away
+volatile unsigned long g_nSink = 0;
+
+/// Names of the descriptions measured when none are given
+const char *DefaultFiles[] = {
+  "aqua.theme.xml", "xp.theme.xml", "Toxid.theme.xml", "toxid.settings.xml"
+};
+
+// ####################################################################### //
+// # getSeconds()                                                        # //
+// ####################################################################### //
+/** Returns the value of a high resolution timer in seconds */
+double getSeconds() {
+  LARGE_INTEGER Frequency, Counter;
+  ::QueryPerformanceFrequency(&Frequency);
+  ::QueryPerformanceCounter(&Counter);
+  return static_cast<double>(Counter.QuadPart) / static_cast<double>(Frequency.QuadPart);
+}
+
+//  //
+//  ScopeLayout                                                          //
+//  //
+/// Names a loader would look up in a scope
+/** Taken from the XML document so both serializers can be read without
+    looking at the XML while the time is running. Child elements appear
+    both as values and as scopes because the XMLSerializer allows both.
+*/
+struct ScopeLayout {
+  /// A value and the type a loader would read it as
+  typedef std::pair<string, Variant::Type> ValueEntry;
+  /// Nested scopes of one name, in document order
+  typedef std::pair<string, std::vector<ScopeLayout> > ScopeGroup;
+
+  /// Collects the layout of an XML node
+  void build(TiXmlNode &XMLNode) {
+    TiXmlElement *pElement = XMLNode.ToElement();
+    if(pElement)
+      for(TiXmlAttribute *pAttribute = pElement->FirstAttribute();
+          pAttribute;
+          pAttribute = pAttribute->Next())
+        Values.push_back(ValueEntry(string("_") + pAttribute->Name(), Variant::T_STRING));
+
+    std::set<string> SeenNames;
+    for(TiXmlElement *pChild = XMLNode.FirstChildElement();
+        pChild;
+        pChild = pChild->NextSiblingElement()) {
+      if(SeenNames.insert(pChild->Value()).second) {
+        TiXmlNode *pFirstChild = pChild->FirstChild();
+        if(pFirstChild && pFirstChild->ToText())
+          Values.push_back(ValueEntry(pChild->Value(), Variant::T_STRING));
+        else
+          MissingNames.push_back(pChild->Value());
+
+        Scopes.push_back(ScopeGroup(pChild->Value(), std::vector<ScopeLayout>()));
+      }
+
+      for(std::vector<ScopeGroup>::iterator GroupIt = Scopes.begin();
+          GroupIt != Scopes.end();
+          ++GroupIt)
+        if(GroupIt->first == pChild->Value()) {
+          GroupIt->second.push_back(ScopeLayout());
+          GroupIt->second.back().build(*pChild);
+        }
+    }
+  }
+
+  /// Takes the types of the values from the converted data
+  void assignTypes(Serializer &Scope) {
+    for(std::vector<ValueEntry>::iterator ValueIt = Values.begin();
+        ValueIt != Values.end();
+        ++ValueIt)
+      ValueIt->second = Scope.get<Variant>(ValueIt->first).getType();
+
+    for(std::vector<ScopeGroup>::iterator GroupIt = Scopes.begin();
+        GroupIt != Scopes.end();
+        ++GroupIt) {
+      size_t Count = 0;
+      shared_ptr<Serializer::ScopeEnumerator> spEnum = Scope.enumScopes(GroupIt->first);
+      while(spEnum->next() && (Count < GroupIt->second.size()))
+        GroupIt->second[Count++].assignTypes(*spEnum->get().second);
+    }
+  }
+
+  std::vector<ValueEntry> Values;                     ///< Values to look up
+  std::vector<string>     MissingNames;               ///< Elements which aren't values
+  std::vector<ScopeGroup> Scopes;                     ///< Nested scopes by name
+};
+
+// ####################################################################### //
+// # readValues()                                                        # //
+// ####################################################################### //
+/** Reads all values of a scope as the types they have in the converted
+    data, like a loader asking for ints and doubles would. When a trace
+    is given, the values are read as strings instead and the child
+    elements which are no values are checked to be missing.
+*/
+void readValues(Serializer &Scope, const ScopeLayout &Layout, std::vector<string> *pTrace) {
+  for(std::vector<ScopeLayout::ValueEntry>::const_iterator ValueIt = Layout.Values.begin();
+      ValueIt != Layout.Values.end();
+      ++ValueIt) {
+    if(pTrace) {
+      pTrace->push_back(ValueIt->first + " = '" + Scope.get<string>(ValueIt->first) + "'");
+      continue;
+    }
+
+    switch(ValueIt->second) {
+      case Variant::T_INT: g_nSink += Scope.get<int>(ValueIt->first); break;
+      case Variant::T_DOUBLE: g_nSink += static_cast<int>(Scope.get<double>(ValueIt->first)); break;
+      default: g_nSink += Scope.get<string>(ValueIt->first).length(); break;
+    }
+  }
+
+  if(pTrace)
+    for(std::vector<string>::const_iterator NameIt = Layout.MissingNames.begin();
+        NameIt != Layout.MissingNames.end();
+        ++NameIt) {
+      try {
+        pTrace->push_back(*NameIt + " = '" + Scope.get<string>(*NameIt) + "'");
+      }
+      catch(const ResourceException &) {
+        pTrace->push_back(*NameIt + " missing");
+      }
+    }
+}
+
+// ####################################################################### //
+// # readScope()                                                         # //
+// ####################################################################### //
+/** Reads a scope the way the loaders do: all values, the first scope of
+    each name through openScope() and all scopes through enumScopes()
+*/
+void readScope(Serializer &Scope, const ScopeLayout &Layout, std::vector<string> *pTrace) {
+  readValues(Scope, Layout, pTrace);
+
+  for(std::vector<ScopeLayout::ScopeGroup>::const_iterator GroupIt = Layout.Scopes.begin();
+      GroupIt != Layout.Scopes.end();
+      ++GroupIt) {
+    shared_ptr<Serializer> spFirst = Scope.openScope(GroupIt->first, true);
+    if(pTrace)
+      pTrace->push_back(GroupIt->first + (spFirst ? " opened" : " not opened"));
+    if(spFirst)
+      readValues(*spFirst, GroupIt->second.front(), pTrace);
+
+    size_t Count = 0;
+    shared_ptr<Serializer::ScopeEnumerator> spEnum = Scope.enumScopes(GroupIt->first);
+    while(spEnum->next()) {
+      if(Count < GroupIt->second.size())
+        readScope(*spEnum->get().second, GroupIt->second[Count], pTrace);
+      ++Count;
+    }
+    if(pTrace)
+      pTrace->push_back(GroupIt->first + " enumerated " + lexical_cast<string>(Count) + " times");
+  }
+}
+
+// ####################################################################### //
+// # loadXML()                                                           # //
+// ####################################################################### //
+/** Loads a description from XML */
+void loadXML(const string &sXML, const ScopeLayout &Layout, std::vector<string> *pTrace) {
+  XMLSerializer Serializer(sXML);
+  readScope(Serializer, Layout, pTrace);
+}
+
+// ####################################################################### //
+// # loadBinary()                                                        # //
+// ####################################################################### //
+/** Loads a description from binary serializer data */
+void loadBinary(const string &sData, const ScopeLayout &Layout, std::vector<string> *pTrace) {
+  BinarySerializer Serializer(sData);
+  readScope(Serializer, Layout, pTrace);
+}
+
+// ####################################################################### //
+// # measure()                                                           # //
+// ####################################################################### //
+/** Repeats a load until MinimumDuration has passed
+
+    @return Microseconds per load
+*/
+double measure(
+  void (*pLoad)(const string &, const ScopeLayout &, std::vector<string> *),
+  const string &sData, const ScopeLayout &Layout
+) {
+  size_t Count = 0;
+  double Start = getSeconds();
+  double Elapsed;
+  do {
+    for(size_t Index = 0; Index < 16; ++Index)
+      pLoad(sData, Layout, NULL);
+    Count += 16;
+    Elapsed = getSeconds() - Start;
+  } while(Elapsed < MinimumDuration);
+
+  return Elapsed * 1000000.0 / Count;
+}
+
+// ####################################################################### //
+// # readFile()                                                          # //
+// ####################################################################### //
+/** Reads a whole file into a string */
+string readFile(const char *pszPath) {
+  std::ifstream File(pszPath, std::ios::in | std::ios::binary);
+  if(!File)
+    throw CantOpenResourceException("readFile()", string("Could not open '") + pszPath + "'");
+
+  return string(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+// ####################################################################### //
+// # main()                                                              # //
+// ####################################################################### //
+int main(int argc, char *argv[]) {
+  std::vector<const char *> Files(argv + 1, argv + argc);
+  if(Files.empty())
+    Files.assign(DefaultFiles, DefaultFiles + sizeof(DefaultFiles) / sizeof(*DefaultFiles));
+
+  std::printf("%-24s %8s %8s %10s %10s %8s\n",
+              "description", "xml B", "binary B", "xml us", "binary us", "speedup");
+
+  bool bFailed = false;
+  try {
+    for(size_t Index = 0; Index < Files.size(); ++Index) {
+      string sXML = readFile(Files[Index]);
+      string sBinary = BinarySerializer::fromXML(sXML);
+
+      TiXmlDocument XMLDocument;
+      XMLDocument.Parse(sXML.c_str());
+      ScopeLayout Layout;
+      Layout.build(XMLDocument);
+      { BinarySerializer Binary(sBinary);
+        Layout.assignTypes(Binary);
+      }
+
+      std::vector<string> XMLTrace, BinaryTrace;
+      loadXML(sXML, Layout, &XMLTrace);
+      loadBinary(sBinary, Layout, &BinaryTrace);
+
+      if(XMLTrace != BinaryTrace) {
+        size_t Line = 0;
+        while((Line < XMLTrace.size()) && (Line < BinaryTrace.size()) &&
+              (XMLTrace[Line] == BinaryTrace[Line]))
+          ++Line;
+
+        std::printf("%s: converted data reads back differently\n", Files[Index]);
+        std::printf("  xml:    %s\n", (Line < XMLTrace.size()) ? XMLTrace[Line].c_str() : "<end>");
+        std::printf("  binary: %s\n", (Line < BinaryTrace.size()) ? BinaryTrace[Line].c_str() : "<end>");
+        bFailed = true;
+        continue;
+      }
+
+      double XMLTime = measure(&loadXML, sXML, Layout);
+      double BinaryTime = measure(&loadBinary, sBinary, Layout);
+      std::printf("%-24s %8lu %8lu %10.1f %10.1f %7.1fx\n",
+                  Files[Index],
+                  static_cast<unsigned long>(sXML.length()),
+                  static_cast<unsigned long>(sBinary.length()),
+                  XMLTime, BinaryTime, XMLTime / BinaryTime);
+    }
+  }
+  catch(const std::exception &Exception) {
+    std::printf("%s\n", Exception.what());
+    return 1;
+  }
+
+  return bFailed ? 1 : 0;
+}
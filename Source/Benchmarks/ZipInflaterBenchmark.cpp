@@ -0,0 +1,369 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## ZipInflaterBenchmark.cpp - Zip inflater reads       //
+// ### # #      ###                                                      //
+// # ### #      ###  Checks that reading zipped files sequentially       //
+// #  ## #   # ## ## doesn't restart the decompressor and measures it    //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+//
+// Checks the ZipInflater on a deflated file built in memory and measures
+// the throughput of sequential reads. The file is a mix of random and
+// repeating bytes, so the deflate stream consists of many blocks and the
+// inflater records checkpoints while reading it.
+//
+//   sequential  the file read front to back in pieces of various sizes,
+//               each with a new inflater, from the start with and without
+//               a checkpoint index and from the middle through the index
+//   random      reads at random positions through one inflater
+//   backwards   reads of the last bytes of every chunk, last chunk first
+//
+// Every read is compared against the original data. A sequential read has
+// to get by with the single restart that starts the decompressor, any
+// more means the inflater decompressed past a chunk's end and had to go
+// back for the next one. Random and backward reads may restart, but never
+// more often than they read.
+//
+// The program fails on the first difference. Afterwards the sequential
+// reads are timed, in MB/s of decompressed data.
+//
+// Build from this directory with:
+// cl /O2 /EHsc /I..\..\Include ZipInflaterBenchmark.cpp
+//    ..\..\Lib\ZipPlugin\Zip-i.Plugin.lib ..\..\Lib\ZLib\zlib.msvc8sp1.lib
+//    /Fe..\..\Bin\ZipInflaterBenchmark.exe
+//
+#include "ZipPlugin/Storage/ZipInflater.h"
+#include <windows.h>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+
+using namespace Nuclex;
+using namespace Nuclex::Storage;
+
+namespace {
+
+/// Size of the decompressed test file, not a multiple of the chunk size
+const size_t FileSize = 5 * 1048576 + 12345;
+/// Size of a zip local file header without file name and extra field
+const size_t LocalHeaderSize = 30;
+/// Minimum time a measurement runs, in seconds
+const double MinimumDuration = 0.5;
+
+/// Keeps the compiler from optimizing the reads away
+volatile unsigned long g_nSink = 0;
+
+// ####################################################################### //
+// # getSeconds()                                                        # //
+// ####################################################################### //
+/** Returns the value of a high resolution timer in seconds */
+double getSeconds() {
+  LARGE_INTEGER Frequency, Counter;
+  ::QueryPerformanceFrequency(&Frequency);
+  ::QueryPerformanceCounter(&Counter);
+  return static_cast<double>(Counter.QuadPart) / static_cast<double>(Frequency.QuadPart);
+}
+
+// ####################################################################### //
+// # getRandom()                                                         # //
+// ####################################################################### //
+/** Returns the next value of a xorshift random number generator */
+unsigned long getRandom() {
+  static unsigned long nState = 0x2545F491;
+  nState ^= nState << 13;
+  nState ^= nState >> 17;
+  nState ^= nState << 5;
+  return nState & 0xFFFFFFFF;
+}
+
+//  //
+//  MemoryArchive                                                        //
+//  //
+/// Zip archive holding a single deflated file in memory
+/** Only readDataAt() is used by the ZipInflater, so that is the only
+    method which does real work
+*/
+class MemoryArchive : public Zipex::Stream {
+  public:
+    /// Constructor
+    MemoryArchive(const std::vector<unsigned char> &Contents) :
+      m_Data(LocalHeaderSize, 0),
+      m_nLocation(0) {
+
+      // A local header with an empty name and no extra field
+      m_Data[0] = 0x50;
+      m_Data[1] = 0x4B;
+      m_Data[2] = 0x03;
+      m_Data[3] = 0x04;
+
+      z_stream ZLibStream;
+      std::memset(&ZLibStream, 0, sizeof(ZLibStream));
+      if(::deflateInit2(&ZLibStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                        -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        throw std::runtime_error("Could not initialize the zlib compressor");
+
+      uLong nBound = ::deflateBound(&ZLibStream, static_cast<uLong>(Contents.size()));
+      m_Data.resize(LocalHeaderSize + nBound);
+      ZLibStream.next_in = const_cast<Bytef *>(&Contents[0]);
+      ZLibStream.avail_in = static_cast<uInt>(Contents.size());
+      ZLibStream.next_out = &m_Data[LocalHeaderSize];
+      ZLibStream.avail_out = static_cast<uInt>(m_Data.size() - LocalHeaderSize);
+      int nResult = ::deflate(&ZLibStream, Z_FINISH);
+      m_Data.resize(LocalHeaderSize + ZLibStream.total_out);
+      ::deflateEnd(&ZLibStream);
+
+      if(nResult != Z_STREAM_END)
+        throw std::runtime_error("Could not compress the test file");
+    }
+
+    /// Get the size of the file's compressed data
+    size_t getCompressedSize() const { return m_Data.size() - LocalHeaderSize; }
+
+  //
+  // Zipex::Stream implementation
+  //
+  public:
+    size_t getSize() const { return m_Data.size(); }
+    void seekTo(size_t nPosition) { m_nLocation = nPosition; }
+    size_t getLocation() const { return m_nLocation; }
+    size_t readData(void *pBuffer, size_t nLength) {
+      size_t nCount = readDataAt(m_nLocation, pBuffer, nLength);
+      m_nLocation += nCount;
+      return nCount;
+    }
+    void writeData(const void *, size_t) {
+      throw std::runtime_error("The archive is read only");
+    }
+    size_t readDataAt(size_t nPosition, void *pBuffer, size_t nLength) {
+      if(nPosition >= m_Data.size())
+        return 0;
+
+      nLength = std::min(nLength, m_Data.size() - nPosition);
+      std::memcpy(pBuffer, &m_Data[nPosition], nLength);
+      return nLength;
+    }
+
+  private:
+    std::vector<unsigned char> m_Data;                ///< Header and compressed data
+    size_t                     m_nLocation;           ///< Position of readData()
+};
+
+// ####################################################################### //
+// # createContents()                                                    # //
+// ####################################################################### //
+/** Creates the decompressed test file. Random stretches alternate with
+    repeating text, so the compressor has to emit new blocks frequently.
+*/
+std::vector<unsigned char> createContents() {
+  static const char Text[] = "All work and no play makes Jack a dull boy. ";
+
+  std::vector<unsigned char> Contents(FileSize);
+  for(size_t Index = 0; Index < FileSize; ++Index)
+    if((Index / 1000) % 3 == 0)
+      Contents[Index] = static_cast<unsigned char>(getRandom());
+    else
+      Contents[Index] = Text[Index % (sizeof(Text) - 1)];
+
+  return Contents;
+}
+
+// ####################################################################### //
+// # checkRead()                                                         # //
+// ####################################################################### //
+/** Reads from the inflater and compares the result against the original
+
+    @param  pszName    Name of the check for error messages
+    @param  Inflater   Inflater to read from
+    @param  Contents   Decompressed contents of the file
+    @param  nPosition  Position to read at
+    @param  nBytes     Number of bytes to read
+    @return True if the inflater delivered the original bytes
+*/
+bool checkRead(const char *pszName, ZipInflater &Inflater,
+               const std::vector<unsigned char> &Contents, size_t nPosition, size_t nBytes) {
+  std::vector<unsigned char> Buffer(nBytes + 1);
+  size_t nExpected = std::min(nBytes, Contents.size() - nPosition);
+  size_t nRead = Inflater.readDataAt(nPosition, &Buffer[0], nBytes);
+
+  if(nRead != nExpected) {
+    std::printf("%s: read %lu bytes at %lu, got %lu instead of %lu\n",
+                pszName, static_cast<unsigned long>(nBytes), static_cast<unsigned long>(nPosition),
+                static_cast<unsigned long>(nRead), static_cast<unsigned long>(nExpected));
+    return false;
+  }
+
+  if((nRead > 0) && (std::memcmp(&Buffer[0], &Contents[nPosition], nRead) != 0)) {
+    std::printf("%s: read %lu bytes at %lu, data differs from the original\n",
+                pszName, static_cast<unsigned long>(nBytes), static_cast<unsigned long>(nPosition));
+    return false;
+  }
+
+  return true;
+}
+
+// ####################################################################### //
+// # checkSequential()                                                   # //
+// ####################################################################### //
+/** Reads the file front to back from the specified position on and
+    checks that the decompressor was only started once. Starting in the
+    middle of a file with an indexed inflater resumes at a checkpoint,
+    where the deflate window no longer lines up with the chunks.
+
+    @param  Archive     Archive containing the file
+    @param  Contents    Decompressed contents of the file
+    @param  nPieceSize  Number of bytes to read at a time
+    @param  spIndex     Checkpoint index for the inflater, can be empty
+    @param  nStart      Position to start reading at
+    @return True if the check passed
+*/
+bool checkSequential(MemoryArchive &Archive, const std::vector<unsigned char> &Contents,
+                     size_t nPieceSize, const shared_ptr<ZipInflater::CheckpointIndex> &spIndex,
+                     size_t nStart) {
+  ZipInflater Inflater(
+    Archive, 0, true, Archive.getCompressedSize(), Contents.size(), spIndex
+  );
+  for(size_t nPosition = nStart; nPosition < Contents.size(); nPosition += nPieceSize)
+    if(!checkRead("sequential", Inflater, Contents, nPosition, nPieceSize))
+      return false;
+
+  if(!checkRead("sequential", Inflater, Contents, Contents.size() - 1, 2))
+    return false;
+
+  if(Inflater.getRestartCount() != 1) {
+    std::printf("sequential: reading in pieces of %lu bytes from %lu %s an index restarted "
+                "the decompressor %lu times\n",
+                static_cast<unsigned long>(nPieceSize), static_cast<unsigned long>(nStart),
+                spIndex ? "with" : "without",
+                static_cast<unsigned long>(Inflater.getRestartCount()));
+    return false;
+  }
+
+  if(spIndex && spIndex->Checkpoints.empty()) {
+    std::printf("sequential: no checkpoints were recorded\n");
+    return false;
+  }
+
+  return true;
+}
+
+// ####################################################################### //
+// # checkRandom()                                                       # //
+// ####################################################################### //
+/** Reads at random positions and backwards through the file, resuming
+    at the checkpoints a sequential read recorded before
+
+    @param  Archive   Archive containing the file
+    @param  Contents  Decompressed contents of the file
+    @return True if the check passed
+*/
+bool checkRandom(MemoryArchive &Archive, const std::vector<unsigned char> &Contents) {
+  shared_ptr<ZipInflater::CheckpointIndex> spIndex(new ZipInflater::CheckpointIndex());
+  { ZipInflater Inflater(
+      Archive, 0, true, Archive.getCompressedSize(), Contents.size(), spIndex
+    );
+    if(!checkRead("random", Inflater, Contents, Contents.size() - 1, 1))
+      return false;
+  }
+
+  ZipInflater Inflater(
+    Archive, 0, true, Archive.getCompressedSize(), Contents.size(), spIndex
+  );
+
+  size_t nReads = 0;
+  for(size_t Index = 0; Index < 200; ++Index, ++nReads)
+    if(!checkRead("random", Inflater, Contents,
+                  getRandom() % Contents.size(), getRandom() % (3 * ZipInflater::ChunkSize)))
+      return false;
+
+  size_t nChunkEnd = Contents.size();
+  while(nChunkEnd > 0) {
+    if(!checkRead("backwards", Inflater, Contents, nChunkEnd - 100, 100))
+      return false;
+
+    nChunkEnd = (nChunkEnd - 1) - (nChunkEnd - 1) % ZipInflater::ChunkSize;
+    ++nReads;
+  }
+
+  if(Inflater.getRestartCount() > nReads) {
+    std::printf("random: %lu reads restarted the decompressor %lu times\n",
+                static_cast<unsigned long>(nReads),
+                static_cast<unsigned long>(Inflater.getRestartCount()));
+    return false;
+  }
+
+  return true;
+}
+
+// ####################################################################### //
+// # measure()                                                           # //
+// ####################################################################### //
+/** Reads the whole file sequentially until MinimumDuration has passed
+
+    @param  Archive     Archive containing the file
+    @param  nFileSize   Size of the decompressed file
+    @param  nPieceSize  Number of bytes to read at a time
+    @return The throughput in MB/s
+*/
+double measure(MemoryArchive &Archive, size_t nFileSize, size_t nPieceSize) {
+  std::vector<unsigned char> Buffer(nPieceSize);
+
+  size_t Count = 0;
+  double Start = getSeconds();
+  double Elapsed;
+  do {
+    ZipInflater Inflater(
+      Archive, 0, true, Archive.getCompressedSize(), nFileSize,
+      shared_ptr<ZipInflater::CheckpointIndex>()
+    );
+    for(size_t nPosition = 0; nPosition < nFileSize; nPosition += nPieceSize) {
+      Inflater.readDataAt(nPosition, &Buffer[0], nPieceSize);
+      g_nSink += Buffer[0];
+    }
+
+    ++Count;
+    Elapsed = getSeconds() - Start;
+  } while(Elapsed < MinimumDuration);
+
+  return static_cast<double>(nFileSize) * Count / Elapsed / 1048576.0;
+}
+
+} // namespace
+
+// ####################################################################### //
+// # main()                                                              # //
+// ####################################################################### //
+int main() {
+  static const size_t PieceSizes[] = { 1000, 4096, 65536, 100000 };
+  const size_t PieceSizeCount = sizeof(PieceSizes) / sizeof(*PieceSizes);
+  const shared_ptr<ZipInflater::CheckpointIndex> EmptyIndex;
+
+  try {
+    std::vector<unsigned char> Contents = createContents();
+    MemoryArchive Archive(Contents);
+
+    for(size_t Index = 0; Index < PieceSizeCount; ++Index) {
+      shared_ptr<ZipInflater::CheckpointIndex> spIndex(new ZipInflater::CheckpointIndex());
+      if(!checkSequential(Archive, Contents, PieceSizes[Index], spIndex, 0) ||
+         !checkSequential(Archive, Contents, PieceSizes[Index], spIndex, FileSize / 3) ||
+         !checkSequential(Archive, Contents, PieceSizes[Index], spIndex, FileSize / 2 + 7) ||
+         !checkSequential(Archive, Contents, PieceSizes[Index], EmptyIndex, 0))
+        return 1;
+    }
+
+    if(!checkRandom(Archive, Contents))
+      return 1;
+
+    std::printf("%10s %10s\n", "piece B", "MB/s");
+    for(size_t Index = 0; Index < PieceSizeCount; ++Index)
+      std::printf("%10lu %10.1f\n", static_cast<unsigned long>(PieceSizes[Index]),
+                  measure(Archive, Contents.size(), PieceSizes[Index]));
+  }
+  catch(const std::exception &Exception) {
+    std::printf("%s\n", Exception.what());
+    return 1;
+  }
+
+  return 0;
+}
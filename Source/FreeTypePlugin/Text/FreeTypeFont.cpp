@@ -11,13 +11,19 @@
 #include "Nuclex/Video/Blit.h"
 #include "Nuclex/Video/AlphaBlend.h"
 #include "Nuclex/Support/Exception.h"
+#include "ScopeGuard/ScopeGuard.h"
+#include <algorithm>
 
 using namespace Nuclex;
 using namespace Nuclex::Video;
 using namespace Nuclex::Text;
+using namespace Nuclex::Support;
 
 namespace {
 
+/// Smallest number of glyphs a worker renders with its own face
+const size_t MinGlyphsPerFace = 16;
+
 //  //
 //  BlendAlphamap                                                                              //
 //  //
@@ -168,6 +174,160 @@ struct BlendAlphaMap {
 
 } // namespace
 
+//  //
+//  Nuclex::Text::FreeTypeFont::PrewarmState                                                   //
+//  //
+/// Shared between a font and its prewarm jobs
+/** The font detaches itself from the state when it is destroyed, so jobs which
+    haven't started yet leave the font alone, and then waits for the running jobs.
+*/
+struct FreeTypeFont::PrewarmState {
+  /// Constructor
+  PrewarmState(FreeTypeFont &Font) :
+    pFont(&Font),
+    nRunning(0),
+    Idle(false) {
+    Idle.set();
+  }
+
+  Mutex         StateMutex;                           ///< Guards the other members
+  FreeTypeFont *pFont;                                ///< Font, NULL once destroyed
+  size_t        nRunning;                             ///< Number of running jobs
+  Signal        Idle;                                 ///< Set while no job is running
+};
+
+//  //
+//  Nuclex::Text::FreeTypeFont::PrewarmJob                                                     //
+//  //
+/// Renders glyphs in the background
+/** Collects the characters whose glyphs haven't been rendered yet, renders them on
+    the scheduler's workers and adds the glyphs to the font when all are done. Each
+    range of characters is rendered with a FreeType library and face of its own
+    because FreeType shares one rasterizer between all faces of a library.
+*/
+class FreeTypeFont::PrewarmJob :
+  public Thread::Function {
+  public:
+    /// Constructor
+    PrewarmJob(
+      const shared_ptr<PrewarmState> &spState, JobScheduler &Scheduler,
+      const wstring &sCharacters
+    ) :
+      m_spState(spState),
+      m_pFont(NULL),
+      m_Scheduler(Scheduler),
+      m_sCharacters(sCharacters) {}
+
+    /// Render the glyphs unless the font has been destroyed in the meantime
+    void operator()() {
+      { Mutex::ScopedLock StateLock(m_spState->StateMutex);
+        m_pFont = m_spState->pFont;
+        if(!m_pFont)
+          return;
+
+        ++m_spState->nRunning;
+        m_spState->Idle.set(false);
+      }
+      ScopeGuard Leave_Font = ::MakeObjGuard(*this, &PrewarmJob::leaveFont);
+
+      prewarm();
+    }
+
+    /// Render a range of the collected characters with a library of its own
+    void operator()(size_t Begin, size_t End) {
+      FT_Library FTLibrary;
+      if(::FT_Init_FreeType(&FTLibrary))
+        return;
+      ScopeGuard Done_FreeType = ::MakeGuard(::FT_Done_FreeType, FTLibrary);
+
+      // Glyphs which can't be rendered here will be rendered on demand instead.
+      // The face is closed together with the library.
+      FT_Face FTFace;
+      if(::FT_New_Memory_Face(
+        FTLibrary, &m_pFont->m_Memory[0],
+        static_cast<FT_Long>(m_pFont->m_Memory.size()), 0, &FTFace
+      ))
+        return;
+
+      if(::FT_Set_Pixel_Sizes(FTFace, 0, static_cast<FT_UInt>(m_pFont->m_Height)))
+        return;
+
+      for(size_t Index = Begin; Index < End; ++Index)
+        renderGlyph(FTFace, Index, false);
+    }
+
+  private:
+    /// Render the glyphs and add them to the font
+    void prewarm() {
+
+      // Collect the characters which don't have a glyph yet
+      { Mutex::ScopedLock GlyphsLock(m_pFont->m_WGlyphsMutex);
+        for(wstring::size_type Pos = 0; Pos < m_sCharacters.length(); ++Pos)
+          if((m_sCharacters[Pos] >= 128) &&
+             (m_pFont->m_WGlyphs.find(m_sCharacters[Pos]) == m_pFont->m_WGlyphs.end()))
+            m_Characters.push_back(m_sCharacters[Pos]);
+      }
+
+      std::sort(m_Characters.begin(), m_Characters.end());
+      m_Characters.erase(std::unique(m_Characters.begin(), m_Characters.end()), m_Characters.end());
+      if(m_Characters.empty())
+        return;
+
+      m_Glyphs.resize(m_Characters.size());
+      m_Rendered.resize(m_Characters.size(), 0);
+
+      // Without the font file, there's only the font's own face to render with
+      if(m_pFont->m_Memory.empty()) {
+        for(size_t Index = 0; Index < m_Characters.size(); ++Index)
+          renderGlyph(m_pFont->m_FTFace, Index, true);
+
+      } else {
+        size_t nGrain = std::max<size_t>(
+          MinGlyphsPerFace, m_Characters.size() / (m_Scheduler.getThreadCount() + 1) + 1
+        );
+        m_Scheduler.parallelFor(0, m_Characters.size(), *this, nGrain);
+      }
+
+      // Add the glyphs to the font. Glyphs which have been rendered on demand
+      // in the meantime are kept.
+      { Mutex::ScopedLock GlyphsLock(m_pFont->m_WGlyphsMutex);
+        for(size_t Index = 0; Index < m_Characters.size(); ++Index)
+          if(m_Rendered[Index])
+            m_pFont->m_WGlyphs.insert(GlyphMap::value_type(m_Characters[Index], m_Glyphs[Index]));
+      }
+    }
+
+    /// Let the font know that the job has finished
+    void leaveFont() {
+      Mutex::ScopedLock StateLock(m_spState->StateMutex);
+      if(--m_spState->nRunning == 0)
+        m_spState->Idle.set();
+    }
+
+    /// Render one of the collected characters
+    void renderGlyph(FT_Face FTFace, size_t Index, bool bSharedFace) {
+      try {
+        if(bSharedFace)
+          m_Glyphs[Index].create(FTFace, m_Characters[Index]);
+        else
+          m_Glyphs[Index].render(FTFace, m_Characters[Index]);
+
+        m_Rendered[Index] = 1;
+      }
+      catch(const std::exception &) {
+        // The glyph will be rendered on demand and report the error there
+      }
+    }
+
+    shared_ptr<PrewarmState>   m_spState;             ///< State shared with the font
+    FreeTypeFont              *m_pFont;               ///< Font to render glyphs for
+    JobScheduler              &m_Scheduler;           ///< Scheduler running the job
+    wstring                    m_sCharacters;         ///< Characters to prewarm
+    std::vector<wchar_t>       m_Characters;          ///< Characters without a glyph
+    std::vector<Glyph>         m_Glyphs;              ///< Rendered glyphs
+    std::vector<unsigned char> m_Rendered;            ///< Whether a glyph was rendered
+};
+
 // ############################################################################################# //
 // # Nuclex::Text::FreeTypeFont::FreeTypeFont()                                    Constructor # //
 // ############################################################################################# //
@@ -175,18 +335,81 @@ struct BlendAlphaMap {
 
     @param  FTFace  Freetype font face
     @param  nSize   Desired font size
-    @check Is the mutex really required around the FT_Set_Pixel_Sizes() call ?
 */
 FreeTypeFont::FreeTypeFont(FT_Face FTFace, size_t nSize) :
   m_FTFace(FTFace),
   m_MaxCharSize(nSize, nSize),
-  m_Height(nSize) {
+  m_Height(nSize),
+  m_spPrewarmState(new PrewarmState(*this)) {
+  initialize();
+}
+
+// ############################################################################################# //
+// # Nuclex::Text::FreeTypeFont::FreeTypeFont()                                    Constructor # //
+// ############################################################################################# //
+/** Initializes an instance of FreeTypeFont and takes over the memory the font
+    face was opened from. Only fonts created this way can render their glyphs
+    on multiple threads in prewarm().
+
+    @param  FTFace  Freetype font face
+    @param  nSize   Desired font size
+    @param  Memory  Font file the face was opened from. Will be emptied.
+*/
+FreeTypeFont::FreeTypeFont(FT_Face FTFace, size_t nSize, std::vector<unsigned char> &Memory) :
+  m_FTFace(FTFace),
+  m_MaxCharSize(nSize, nSize),
+  m_Height(nSize),
+  m_spPrewarmState(new PrewarmState(*this)) {
+  m_Memory.swap(Memory);
+  initialize();
+}
+
+// ############################################################################################# //
+// # Nuclex::Text::FreeTypeFont::~FreeTypeFont()                                    Destructor # //
+// ############################################################################################# //
+/** Destroys an instance of FreeTypeFont. Prewarm jobs which are running are
+    waited for, the ones which haven't started yet will do nothing.
+*/
+FreeTypeFont::~FreeTypeFont() {
+  { Mutex::ScopedLock StateLock(m_spPrewarmState->StateMutex);
+    m_spPrewarmState->pFont = NULL;
+  }
+
+  m_spPrewarmState->Idle.wait();
+}
+
+// ############################################################################################# //
+// # Nuclex::Text::FreeTypeFont::prewarm()                                                     # //
+// ############################################################################################# //
+/** Renders the glyphs of the specified characters on the scheduler's workers.
+    The font must not be used from other threads than the one that called
+    prewarm(), but it can be used while the job is running.
+
+    @param  sCharacters  Character set or sample text whose glyphs to render
+    @param  Scheduler    Scheduler on which to render the glyphs
+    @return A handle to the job rendering the glyphs
+*/
+JobScheduler::JobHandle FreeTypeFont::prewarm(
+  const wstring &sCharacters, JobScheduler &Scheduler
+) {
+  return Scheduler.schedule(
+    std::auto_ptr<Thread::Function>(new PrewarmJob(m_spPrewarmState, Scheduler, sCharacters))
+  );
+}
+
+// ############################################################################################# //
+// # Nuclex::Text::FreeTypeFont::initialize()                                                  # //
+// ############################################################################################# //
+/** Sets up the font size and renders the standard ascii characters
 
+    @check Is the mutex really required around the FT_Set_Pixel_Sizes() call ?
+*/
+void FreeTypeFont::initialize() {
   { Mutex::ScopedLock FreeTypeUser(getFreeTypeMutex());
   
     // Set up the character sizes for this font. This magically scales the TrueType font
     // to the exact size in which we want it to be rendered
-    FT_Error Error = FT_Set_Pixel_Sizes(FTFace, 0, nSize);
+    FT_Error Error = FT_Set_Pixel_Sizes(m_FTFace, 0, m_Height);
     if(Error)
       throw UnexpectedException(
         "Nuclex::Text::FreeTypeFont::FreeTypeFont()",
@@ -306,34 +529,47 @@ void FreeTypeFont::Glyph::create(FT_Face FTFace, wchar_t Glyph) {
   // This mutex reflects the remote possibility that multiple glyphs might have their
   // create() method called at the same time
   { Mutex::ScopedLock Lock(getFreeTypeMutex());
+    render(FTFace, Glyph);
+  }
+}
 
-    // Try to render the selected chara
-    FT_Error Error = ::FT_Load_Char(FTFace, Glyph, FT_LOAD_RENDER);
-    if(Error)
-      throw UnexpectedException(
-        "Nuclex::FreeTypeFont::Glyph::create()",
-        string("FreeType reported an error while rendering the glyph") +
-          getFreeTypeErrorDescription(Error)
-      );
+// ############################################################################################# //
+// # Nuclex::Text::FreeTypeFont::Glyph::render()                                               # //
+// ############################################################################################# //
+/** Realizes the glyph without locking the FreeType mutex. Only to be used
+    with a face whose FreeType library is not used by any other thread.
 
-    // Obtain the glyph's metadata
-    Metrics.Advance.set(FTFace->glyph->advance.x, FTFace->glyph->advance.y);
-    Metrics.Advance /= 64;
-    Metrics.Hotspot.set(-FTFace->glyph->bitmap_left, FTFace->glyph->bitmap_top);
-    Metrics.Size.set(FTFace->glyph->bitmap.width, FTFace->glyph->bitmap.rows);
-
-    // Copy the glyph's pixels to our internal pixel buffer
-    size_t PixelCount = Metrics.Size.X * Metrics.Size.Y;
-    if(PixelCount > 0) {
-      Bitmap.resize(PixelCount);
-
-      unsigned char *pSource = FTFace->glyph->bitmap.buffer;
-      unsigned char *pDestination = &Bitmap[0];
-      for(size_t Line = 0; Line < Metrics.Size.Y; ++Line) {
-        ::memcpy(pDestination, pSource, Metrics.Size.X);
-        pSource += FTFace->glyph->bitmap.pitch;
-        pDestination += Metrics.Size.X;
-      }
+    @param  FTFace  Freetype font face
+    @param  nGlyph  Index of the glyph to realize
+*/
+void FreeTypeFont::Glyph::render(FT_Face FTFace, wchar_t Glyph) {
+
+  // Try to render the selected chara
+  FT_Error Error = ::FT_Load_Char(FTFace, Glyph, FT_LOAD_RENDER);
+  if(Error)
+    throw UnexpectedException(
+      "Nuclex::FreeTypeFont::Glyph::create()",
+      string("FreeType reported an error while rendering the glyph") +
+        getFreeTypeErrorDescription(Error)
+    );
+
+  // Obtain the glyph's metadata
+  Metrics.Advance.set(FTFace->glyph->advance.x, FTFace->glyph->advance.y);
+  Metrics.Advance /= 64;
+  Metrics.Hotspot.set(-FTFace->glyph->bitmap_left, FTFace->glyph->bitmap_top);
+  Metrics.Size.set(FTFace->glyph->bitmap.width, FTFace->glyph->bitmap.rows);
+
+  // Copy the glyph's pixels to our internal pixel buffer
+  size_t PixelCount = Metrics.Size.X * Metrics.Size.Y;
+  if(PixelCount > 0) {
+    Bitmap.resize(PixelCount);
+
+    unsigned char *pSource = FTFace->glyph->bitmap.buffer;
+    unsigned char *pDestination = &Bitmap[0];
+    for(size_t Line = 0; Line < Metrics.Size.Y; ++Line) {
+      ::memcpy(pDestination, pSource, Metrics.Size.X);
+      pSource += FTFace->glyph->bitmap.pitch;
+      pDestination += Metrics.Size.X;
     }
   }
 }
@@ -485,7 +721,9 @@ FreeTypeFont::Glyph &FreeTypeFont::getGlyph(wchar_t Char) {
   if(Char < 128)
     return m_Glyphs[Char];
 
-  // Other glyphs, especially unicode ones, might need to be realized first
+  // Other glyphs, especially unicode ones, might need to be realized first. Existing
+  // glyphs are never modified, so they can be used after the lock is released.
+  Mutex::ScopedLock GlyphsLock(m_WGlyphsMutex);
   GlyphMap::iterator GlyphIt = m_WGlyphs.find(Char);
   if(GlyphIt == m_WGlyphs.end()) {
     GlyphIt = m_WGlyphs.insert(GlyphMap::value_type(Char, Glyph())).first;
@@ -14,30 +14,6 @@
 using namespace Nuclex;
 using namespace Nuclex::Text;
 
-//  //
-//  FreeTypeFontWithMemory                                                                     //
-//  //
-/// Helper class for FreeType fonts
-/** This helper class keeps the memory from which the font file was loaded alive until
-    the font has been destroyed.
-*/
-class FreeTypeFontWithMemory : public FreeTypeFont {
-  public:  
-    /// Create a new FreeTypeFont
-    FreeTypeFontWithMemory(
-      FT_Face FTFace, unsigned long nSize, std::vector<unsigned char> &Memory
-    ) :
-      FreeTypeFont(FTFace, nSize) {
-
-      // Overtake ownership of the font file's memory buffer
-      m_Memory.swap(Memory);
-    }
-
-  private:
-    /// Memory buffer used to store the font file
-    std::vector<unsigned char> m_Memory;
-};
-
 // ############################################################################################# //
 // # Nuclex::Text::FreeTypeFontCodec::canLoadFont()                                            # //
 // ############################################################################################# //
@@ -79,8 +55,13 @@ shared_ptr<Font> FreeTypeFontCodec::loadFont(
   OpenArgs.memory_base = &Memory[0];
   OpenArgs.memory_size = spStream->getSize();
 
+  // The FreeType library may not be used by multiple threads at once, which
+  // happens when fonts are loaded by ResourceSet::loadAsync()
   FT_Face Face;
-  FT_Error Error = ::FT_Open_Face(getFreeTypeLibrary(), &OpenArgs, 0, &Face);
+  FT_Error Error;
+  { Mutex::ScopedLock FreeTypeUser(getFreeTypeMutex());
+    Error = ::FT_Open_Face(getFreeTypeLibrary(), &OpenArgs, 0, &Face);
+  }
   if(Error)
     throw UnexpectedException(
       "Nuclex::Text::FreeTypeFontCodec::loadFont()",
@@ -88,7 +69,7 @@ shared_ptr<Font> FreeTypeFontCodec::loadFont(
         getFreeTypeErrorDescription(Error)
     );
 
-  return shared_ptr<Font>(new FreeTypeFontWithMemory(Face, nSize, Memory));
+  return shared_ptr<Font>(new FreeTypeFont(Face, nSize, Memory));
 }
 
 // ############################################################################################# //
@@ -0,0 +1,1003 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## BinarySerializer.cpp - Binary object serializer                           //
+// ### # #      ###                                                                            //
+// # ### #      ###  A serializer which stores serialized objects in a compact                 //
+// #  ## #   # ## ## tagged binary format that can be read without parsing                     //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#include "Nuclex/Storage/BinarySerializer.h"
+#include <map>
+#include <set>
+#include <vector>
+#include <cstring>
+
+#define TIXML_USE_STL
+#include "TinyXML/tinyxml.h"
+
+using namespace Nuclex;
+using namespace Nuclex::Storage;
+
+namespace {
+
+/// Signature of binary serializer data ('NXBS')
+const unsigned_32 Signature = 0x5342584E;
+/// Version of the binary serializer format
+const unsigned_32 Version = 1;
+/// Name id that doesn't belong to any name in the name table
+const unsigned_32 UnknownName = 0xFFFFFFFF;
+
+// ############################################################################################# //
+// # DataReader                                                                                # //
+// ############################################################################################# //
+/// Bounds checked reader for binary serializer data
+/** Reads the fields of a binary serializer document between two offsets
+    and throws if the data ends before a field does
+*/
+class DataReader {
+  public:
+    /// Constructor
+    DataReader(const string &sData, size_t nPosition, size_t nEnd) :
+      m_pData(reinterpret_cast<const unsigned char *>(sData.data())),
+      m_nPosition(nPosition),
+      m_nEnd(nEnd) {}
+
+  //
+  // DataReader implementation
+  //
+  public:
+    /// Get the current read position
+    size_t getPosition() const { return m_nPosition; }
+
+    /// Skip the specified number of bytes
+    void skip(size_t nBytes) {
+      require(nBytes);
+      m_nPosition += nBytes;
+    }
+
+    /// Read a byte
+    unsigned char readByte() {
+      require(1);
+      return m_pData[m_nPosition++];
+    }
+
+    /// Read a little endian 32 bit integer
+    unsigned_32 readULong() {
+      require(4);
+      const unsigned char *pBytes = m_pData + m_nPosition;
+      m_nPosition += 4;
+
+      return static_cast<unsigned_32>(pBytes[0]) |
+             (static_cast<unsigned_32>(pBytes[1]) << 8) |
+             (static_cast<unsigned_32>(pBytes[2]) << 16) |
+             (static_cast<unsigned_32>(pBytes[3]) << 24);
+    }
+
+    /// Read a double
+    double readDouble() {
+      require(sizeof(double));
+      double dValue;
+      std::memcpy(&dValue, m_pData + m_nPosition, sizeof(double));
+      m_nPosition += sizeof(double);
+
+      return dValue;
+    }
+
+    /// Read a string
+    string readString() {
+      size_t nLength = readULong();
+      require(nLength);
+      string sValue(reinterpret_cast<const char *>(m_pData + m_nPosition), nLength);
+      m_nPosition += nLength;
+
+      return sValue;
+    }
+
+    /// Read an unicode string
+    wstring readWString() {
+      size_t nLength = readULong();
+      require(nLength * 2);
+      wstring sValue(nLength, L'\0');
+      for(size_t Index = 0; Index < nLength; ++Index)
+        sValue[Index] = static_cast<wchar_t>(
+          m_pData[m_nPosition + Index * 2] | (m_pData[m_nPosition + Index * 2 + 1] << 8)
+        );
+      m_nPosition += nLength * 2;
+
+      return sValue;
+    }
+
+    /// Read a value of the specified type
+    Variant readValue(unsigned char nType) {
+      switch(nType) {
+        case Variant::T_NONE: return Variant();
+        case Variant::T_BOOL: return Variant(readByte() != 0);
+        case Variant::T_INT: return Variant(static_cast<int>(readULong()));
+        case Variant::T_SIZE: return Variant(static_cast<size_t>(readULong()));
+        case Variant::T_DOUBLE: return Variant(readDouble());
+        case Variant::T_STRING: return Variant(readString());
+        case Variant::T_WSTRING: return Variant(readWString());
+        default:
+          throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer",
+                                           "Binary serializer data contains an unknown value type");
+      }
+    }
+
+    /// Skip a value of the specified type
+    void skipValue(unsigned char nType) {
+      switch(nType) {
+        case Variant::T_NONE: break;
+        case Variant::T_BOOL: skip(1); break;
+        case Variant::T_INT: skip(4); break;
+        case Variant::T_SIZE: skip(4); break;
+        case Variant::T_DOUBLE: skip(sizeof(double)); break;
+        case Variant::T_STRING: skip(readULong()); break;
+        case Variant::T_WSTRING: skip(static_cast<size_t>(readULong()) * 2); break;
+        default:
+          throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer",
+                                           "Binary serializer data contains an unknown value type");
+      }
+    }
+
+  private:
+    /// Make sure the specified number of bytes can be read
+    void require(size_t nBytes) const {
+      if(nBytes > m_nEnd - m_nPosition)
+        throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer",
+                                         "Binary serializer data is truncated or corrupt");
+    }
+
+    const unsigned char *m_pData;                     ///< Serialized data
+    size_t               m_nPosition;                 ///< Current read position
+    size_t               m_nEnd;                      ///< End of the readable range
+};
+
+// ############################################################################################# //
+// # writeULong()                                                                              # //
+// ############################################################################################# //
+/// Append a little endian 32 bit integer to binary serializer data
+void writeULong(string &sData, unsigned_32 nValue) {
+  sData += static_cast<char>(nValue & 0xFF);
+  sData += static_cast<char>((nValue >> 8) & 0xFF);
+  sData += static_cast<char>((nValue >> 16) & 0xFF);
+  sData += static_cast<char>((nValue >> 24) & 0xFF);
+}
+
+// ############################################################################################# //
+// # patchULong()                                                                              # //
+// ############################################################################################# //
+/// Overwrite a little endian 32 bit integer in binary serializer data
+void patchULong(string &sData, size_t nPosition, unsigned_32 nValue) {
+  sData[nPosition + 0] = static_cast<char>(nValue & 0xFF);
+  sData[nPosition + 1] = static_cast<char>((nValue >> 8) & 0xFF);
+  sData[nPosition + 2] = static_cast<char>((nValue >> 16) & 0xFF);
+  sData[nPosition + 3] = static_cast<char>((nValue >> 24) & 0xFF);
+}
+
+// ############################################################################################# //
+// # writeValue()                                                                              # //
+// ############################################################################################# //
+/// Append a variant's type and value to binary serializer data
+void writeValue(string &sData, const Variant &Value) {
+  sData += static_cast<char>(Value.getType());
+
+  switch(Value.getType()) {
+    case Variant::T_NONE: {
+      break;
+    }
+    case Variant::T_BOOL: {
+      sData += static_cast<char>(Value.to<bool>() ? 1 : 0);
+      break;
+    }
+    case Variant::T_INT: {
+      writeULong(sData, static_cast<unsigned_32>(Value.to<int>()));
+      break;
+    }
+    case Variant::T_SIZE: {
+      writeULong(sData, static_cast<unsigned_32>(Value.to<size_t>()));
+      break;
+    }
+    case Variant::T_DOUBLE: {
+      double dValue = Value.to<double>();
+      sData.append(reinterpret_cast<const char *>(&dValue), sizeof(double));
+      break;
+    }
+    case Variant::T_STRING: {
+      string sValue = Value.to<string>();
+      writeULong(sData, static_cast<unsigned_32>(sValue.length()));
+      sData += sValue;
+      break;
+    }
+    case Variant::T_WSTRING: {
+      wstring sValue = Value.to<wstring>();
+      writeULong(sData, static_cast<unsigned_32>(sValue.length()));
+      for(size_t Index = 0; Index < sValue.length(); ++Index) {
+        sData += static_cast<char>(sValue[Index] & 0xFF);
+        sData += static_cast<char>((sValue[Index] >> 8) & 0xFF);
+      }
+      break;
+    }
+  }
+}
+
+// ############################################################################################# //
+// # valueFromXML()                                                                            # //
+// ############################################################################################# //
+/// Convert an XML text into a natively typed value
+/** Turns texts which are integers or decimal numbers into ints and doubles.
+    This is only done when converting the number back yields the original
+    text, so the value behaves exactly like the string it replaces.
+
+    @param  sText  Text to convert
+    @return The natively typed value
+*/
+Variant valueFromXML(const string &sText) {
+  if((sText.find_first_of("0123456789") == string::npos) ||
+     (sText.find_first_not_of("+-0123456789.eE") != string::npos))
+    return Variant(sText);
+
+  if(sText.find_first_of(".eE") == string::npos) {
+    int nValue = lexical_cast<int>(sText);
+    if(lexical_cast<string>(nValue) == sText)
+      return Variant(nValue);
+  } else {
+    double dValue = lexical_cast<double>(sText);
+    if(lexical_cast<string>(dValue) == sText)
+      return Variant(dValue);
+  }
+
+  return Variant(sText);
+}
+
+// ############################################################################################# //
+// # convertXMLNode()                                                                          # //
+// ############################################################################################# //
+/// Copy the contents of an XML node into a serializer scope
+/** Stores the node's attributes and the text of its child elements as
+    values and every child element as a nested scope. This is the same
+    layout through which the XMLSerializer exposes an XML document:
+    openScope() and enumScopes() see all child elements, including those
+    which only contain text, while retrieveValue() only looks at the first
+    child element of a name and fails if that one doesn't start with text.
+
+    @param  XMLNode  XML node to convert
+    @param  Target   Scope to store the node's contents in
+*/
+void convertXMLNode(TiXmlNode &XMLNode, Serializer &Target) {
+  TiXmlElement *pElement = XMLNode.ToElement();
+  if(pElement)
+    for(TiXmlAttribute *pAttribute = pElement->FirstAttribute();
+        pAttribute;
+        pAttribute = pAttribute->Next())
+      Target.set<Variant>(string("_") + pAttribute->Name(), valueFromXML(pAttribute->Value()));
+
+  std::set<string> ValueNames;
+  for(TiXmlElement *pChild = XMLNode.FirstChildElement();
+      pChild;
+      pChild = pChild->NextSiblingElement()) {
+    if(ValueNames.insert(pChild->Value()).second) {
+      TiXmlNode *pFirstChild = pChild->FirstChild();
+      if(pFirstChild && pFirstChild->ToText())
+        Target.set<Variant>(pChild->Value(), valueFromXML(pFirstChild->Value()));
+    }
+
+    convertXMLNode(*pChild, *Target.createScope(pChild->Value()));
+  }
+}
+
+} // namespace
+
+//  //
+//  Nuclex::Storage::BinarySerializer::Document                                                //
+//  //
+/// Binary serializer document
+/** Holds the serialized data and the name table shared by all scopes
+    of a document. Scopes refer to their names by index into the table.
+*/
+class BinarySerializer::Document {
+  public:
+    /// Constructor for a new document
+    Document() :
+      m_nRootBegin(0),
+      m_nRootEnd(0) {}
+
+    /// Constructor for existing data
+    Document(const string &sData) :
+      m_sData(sData) {
+      DataReader Reader(m_sData, 0, m_sData.length());
+      if(Reader.readULong() != Signature)
+        throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer::Document::Document()",
+                                         "Data is not in the binary serializer format");
+      if(Reader.readULong() != Version)
+        throw WrongVersionException("Nuclex::Storage::BinarySerializer::Document::Document()",
+                                    "Binary serializer data has an unsupported version");
+
+      size_t nNameCount = Reader.readULong();
+      for(size_t Index = 0; Index < nNameCount; ++Index)
+        internName(Reader.readString());
+
+      size_t nRootSize = Reader.readULong();
+      m_nRootBegin = Reader.getPosition();
+      Reader.skip(nRootSize);
+      m_nRootEnd = Reader.getPosition();
+    }
+
+  //
+  // Document implementation
+  //
+  public:
+    /// Get the serialized data
+    const string &getData() const { return m_sData; }
+    /// Get the offset of the root scope's contents
+    size_t getRootBegin() const { return m_nRootBegin; }
+    /// Get the end of the root scope's contents
+    size_t getRootEnd() const { return m_nRootEnd; }
+
+    /// Look up the id of a name, returns UnknownName if not in the table
+    unsigned_32 findName(const string &sName) const {
+      NameMap::const_iterator NameIt = m_NameIds.find(sName);
+      if(NameIt == m_NameIds.end())
+        return UnknownName;
+      else
+        return NameIt->second;
+    }
+
+    /// Add a name to the name table
+    unsigned_32 internName(const string &sName) {
+      NameMap::iterator NameIt = m_NameIds.find(sName);
+      if(NameIt != m_NameIds.end())
+        return NameIt->second;
+
+      unsigned_32 nId = static_cast<unsigned_32>(m_Names.size());
+      m_Names.push_back(sName);
+      m_NameIds.insert(NameMap::value_type(sName, nId));
+
+      return nId;
+    }
+
+    /// Get the name with the specified id
+    const string &getName(unsigned_32 nId) const {
+      if(nId >= m_Names.size())
+        throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer::Document::getName()",
+                                         "Binary serializer data refers to an unknown name");
+
+      return m_Names[nId];
+    }
+
+    /// Append the name table to binary serializer data
+    void writeNames(string &sData) const {
+      writeULong(sData, static_cast<unsigned_32>(m_Names.size()));
+      for(NameVector::const_iterator NameIt = m_Names.begin(); NameIt != m_Names.end(); ++NameIt) {
+        writeULong(sData, static_cast<unsigned_32>(NameIt->length()));
+        sData += *NameIt;
+      }
+    }
+
+  private:
+    typedef std::vector<string> NameVector;
+    typedef std::map<string, unsigned_32> NameMap;
+
+    string     m_sData;                               ///< Serialized data
+    NameVector m_Names;                               ///< Names by id
+    NameMap    m_NameIds;                             ///< Ids by name
+    size_t     m_nRootBegin;                          ///< Start of the root scope's contents
+    size_t     m_nRootEnd;                            ///< End of the root scope's contents
+};
+
+//  //
+//  Nuclex::Storage::BinarySerializer::ReadNode                                                //
+//  //
+/// Scope of existing binary serializer data
+/** Reads a scope directly out of the serialized data. The contents of
+    a scope are laid out as
+
+      value count, size of all values,
+      values (name id, type, value),
+      scope count,
+      scopes (name id, size of contents, contents)
+
+    so looking up a nested scope can jump over the values and over any
+    nested scopes which have a different name.
+*/
+class BinarySerializer::ReadNode :
+  public Serializer {
+    /// Enumerates the nested scopes of a ReadNode
+    class ReadScopeEnumerator :
+      public Serializer::ScopeEnumerator {
+      public:
+        /// Constructor
+        ReadScopeEnumerator(const shared_ptr<Document> &spDocument, size_t nPosition,
+                            size_t nEnd, bool bAllNames, unsigned_32 nNameId) :
+          m_spDocument(spDocument),
+          m_Reader(spDocument->getData(), nPosition, nEnd),
+          m_nRemaining(m_Reader.readULong()),
+          m_bAllNames(bAllNames),
+          m_nNameId(nNameId) {}
+
+      //
+      // Enumerator implementation
+      //
+      public:
+        /// Advance to next entry
+        bool next() {
+          while(m_nRemaining > 0) {
+            --m_nRemaining;
+
+            unsigned_32 nNameId = m_Reader.readULong();
+            size_t nSize = m_Reader.readULong();
+            size_t nBegin = m_Reader.getPosition();
+            m_Reader.skip(nSize);
+
+            if(m_bAllNames || (nNameId == m_nNameId)) {
+              m_CurrentScope.first = m_spDocument->getName(nNameId);
+              m_CurrentScope.second = shared_ptr<Serializer>(
+                new ReadNode(m_spDocument, nNameId, nBegin, nBegin + nSize)
+              );
+              return true;
+            }
+          }
+
+          m_CurrentScope.second = shared_ptr<Serializer>();
+          return false;
+        }
+
+        /// Get current scope
+        const std::pair<string, shared_ptr<Serializer> > &get() const {
+          return m_CurrentScope;
+        }
+
+      private:
+        shared_ptr<Document>                        m_spDocument; ///< Document being read
+        DataReader                                  m_Reader; ///< Reader for the scope list
+        size_t                                      m_nRemaining; ///< Scopes not visited yet
+        bool                                        m_bAllNames; ///< Whether to visit all scopes
+        unsigned_32                                 m_nNameId; ///< Name of scopes to visit
+        std::pair<string, shared_ptr<Serializer> >  m_CurrentScope; ///< Current scope
+    };
+
+  public:
+    /// Constructor
+    ReadNode(const shared_ptr<Document> &spDocument, unsigned_32 nNameId,
+             size_t nBegin, size_t nEnd) :
+      m_spDocument(spDocument),
+      m_nNameId(nNameId),
+      m_nBegin(nBegin),
+      m_nEnd(nEnd) {}
+
+    /// Destructor
+    virtual ~ReadNode() {}
+
+  //
+  // Serializer implementation
+  //
+  public:
+    /// Enumerate nested scopes
+    shared_ptr<ScopeEnumerator> enumScopes(const string &sName = "") {
+      return shared_ptr<ScopeEnumerator>(new ReadScopeEnumerator(
+        m_spDocument, getScopesBegin(), m_nEnd, sName.empty(), m_spDocument->findName(sName)
+      ));
+    }
+
+    /// Enter nested scope
+    shared_ptr<Serializer> openScope(const string &sName, bool bOptional = false);
+
+    /// Begin nested scope
+    shared_ptr<Serializer> createScope(const string &sName) {
+      throw NotSupportedException("Nuclex::Storage::BinarySerializer::ReadNode::createScope()",
+                                  "Existing binary serializer data is read-only");
+    }
+
+    /// Retrieve a value from the scope or return a default value
+    Variant retrieveValue(const string &sName, const Variant &Default) {
+      Variant Value;
+      if(findValue(sName, Value))
+        return Value;
+      else
+        return Default;
+    }
+
+    /// Retrieve a value from the scope
+    Variant retrieveValue(const string &sName) {
+      Variant Value;
+      if(!findValue(sName, Value))
+        throw ResourceException(
+          "Nuclex::Storage::BinarySerializer::ReadNode::retrieveValue()",
+          string("Value '") + sName + "' not found in scope '" + getName() + "'"
+        );
+
+      return Value;
+    }
+
+    /// Store a value in the scope
+    void storeValue(const string &sName, const Variant &Value) {
+      throw NotSupportedException("Nuclex::Storage::BinarySerializer::ReadNode::storeValue()",
+                                  "Existing binary serializer data is read-only");
+    }
+
+  private:
+    /// Look up a value in the scope
+    bool findValue(const string &sName, Variant &Value) const;
+    /// Get the offset of the list of nested scopes
+    size_t getScopesBegin() const;
+
+    /// Get the name of the scope for error messages
+    string getName() const {
+      if(m_nNameId == UnknownName)
+        return "document";
+      else
+        return m_spDocument->getName(m_nNameId);
+    }
+
+    shared_ptr<Document> m_spDocument;                ///< Document being read
+    unsigned_32          m_nNameId;                   ///< Name of the scope
+    size_t               m_nBegin;                    ///< Start of the scope's contents
+    size_t               m_nEnd;                      ///< End of the scope's contents
+};
+
+//  //
+//  Nuclex::Storage::BinarySerializer::WriteNode                                               //
+//  //
+/// Scope of a new binary serializer document
+/** Collects the values and nested scopes of a scope in memory until
+    the document is written out
+*/
+class BinarySerializer::WriteNode :
+  public Serializer {
+    typedef std::pair<unsigned_32, Variant> ValueEntry;
+    typedef std::vector<ValueEntry> ValueVector;
+    typedef std::pair<unsigned_32, shared_ptr<WriteNode> > ScopeEntry;
+    typedef std::vector<ScopeEntry> ScopeVector;
+    typedef std::pair<string, shared_ptr<Serializer> > NamedScope;
+    typedef std::vector<NamedScope> NamedScopeVector;
+
+    /// Enumerates the nested scopes of a WriteNode
+    class WriteScopeEnumerator :
+      public Serializer::ScopeEnumerator {
+      public:
+        /// Constructor
+        WriteScopeEnumerator(const NamedScopeVector &Scopes) :
+          m_Scopes(Scopes),
+          m_nNext(0) {}
+
+      //
+      // Enumerator implementation
+      //
+      public:
+        /// Advance to next entry
+        bool next() {
+          if(m_nNext >= m_Scopes.size()) {
+            m_CurrentScope = NamedScope();
+            return false;
+          }
+
+          m_CurrentScope = m_Scopes[m_nNext++];
+          return true;
+        }
+
+        /// Get current scope
+        const std::pair<string, shared_ptr<Serializer> > &get() const {
+          return m_CurrentScope;
+        }
+
+      private:
+        NamedScopeVector m_Scopes;                    ///< Scopes to enumerate
+        size_t           m_nNext;                     ///< Index of the next scope
+        NamedScope       m_CurrentScope;              ///< Current scope
+    };
+
+  public:
+    /// Constructor
+    WriteNode(const shared_ptr<Document> &spDocument) :
+      m_spDocument(spDocument) {}
+
+    /// Destructor
+    virtual ~WriteNode() {}
+
+  //
+  // WriteNode implementation
+  //
+  public:
+    /// Append the scope's size and contents to binary serializer data
+    void write(string &sData) const;
+
+  //
+  // Serializer implementation
+  //
+  public:
+    /// Enumerate nested scopes
+    shared_ptr<ScopeEnumerator> enumScopes(const string &sName = "");
+
+    /// Enter nested scope
+    shared_ptr<Serializer> openScope(const string &sName, bool bOptional = false);
+
+    /// Begin nested scope
+    shared_ptr<Serializer> createScope(const string &sName) {
+      shared_ptr<WriteNode> spScope(new WriteNode(m_spDocument));
+      m_Scopes.push_back(ScopeEntry(m_spDocument->internName(sName), spScope));
+
+      return spScope;
+    }
+
+    /// Retrieve a value from the scope or return a default value
+    Variant retrieveValue(const string &sName, const Variant &Default) {
+      const Variant *pValue = findValue(sName);
+      if(pValue)
+        return *pValue;
+      else
+        return Default;
+    }
+
+    /// Retrieve a value from the scope
+    Variant retrieveValue(const string &sName) {
+      const Variant *pValue = findValue(sName);
+      if(!pValue)
+        throw ResourceException("Nuclex::Storage::BinarySerializer::WriteNode::retrieveValue()",
+                                string("Value '") + sName + "' not found");
+
+      return *pValue;
+    }
+
+    /// Store a value in the scope
+    void storeValue(const string &sName, const Variant &Value);
+
+  private:
+    /// Look up a value in the scope
+    const Variant *findValue(const string &sName) const;
+
+    shared_ptr<Document> m_spDocument;                ///< Document being written
+    ValueVector          m_Values;                    ///< Values in order of storage
+    ScopeVector          m_Scopes;                    ///< Nested scopes in order of creation
+};
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::isBinary()                                             # //
+// ############################################################################################# //
+/** Checks whether the data starts with the signature of the binary
+    serializer format. Useful to pick the right serializer for a file
+    that can either be in XML or in binary format.
+
+    @param  sData  Data to check
+    @return True if the data is in the binary serializer format
+*/
+bool BinarySerializer::isBinary(const string &sData) {
+  if(sData.length() < 4)
+    return false;
+
+  return DataReader(sData, 0, 4).readULong() == Signature;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::fromXML()                                              # //
+// ############################################################################################# //
+/** Converts an XML document into the binary serializer format.
+    Attributes and elements containing text become values and every
+    element becomes a scope. Numbers are stored as ints or doubles when
+    they convert back to exactly the same text.
+
+    @param  sXML  XML document to convert
+    @return The document in the binary serializer format
+*/
+string BinarySerializer::fromXML(const string &sXML) {
+  TiXmlDocument XMLDocument;
+  XMLDocument.Parse(sXML.c_str());
+  if(XMLDocument.Error())
+    throw UnsupportedFormatException("Nuclex::Storage::BinarySerializer::fromXML()",
+                                     string("Error while parsing XML string: ") + XMLDocument.ErrorDesc());
+
+  BinarySerializer Binary;
+  convertXMLNode(XMLDocument, Binary);
+
+  return Binary.getData();
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::BinarySerializer()                         Constructor # //
+// ############################################################################################# //
+/** Initializes an instance of BinarySerializer
+
+    @param  sData  Existing binary serializer data, empty to create a new document
+*/
+BinarySerializer::BinarySerializer(const string &sData) {
+  if(sData.empty()) {
+    m_spDocument = shared_ptr<Document>(new Document());
+    m_spRootWriteNode = shared_ptr<WriteNode>(new WriteNode(m_spDocument));
+    m_spRootNode = m_spRootWriteNode;
+  } else {
+    m_spDocument = shared_ptr<Document>(new Document(sData));
+    m_spRootNode = shared_ptr<Serializer>(new ReadNode(
+      m_spDocument, UnknownName, m_spDocument->getRootBegin(), m_spDocument->getRootEnd()
+    ));
+  }
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::getData()                                              # //
+// ############################################################################################# //
+/** Returns the binary data of the document
+
+    @return The document in the binary serializer format
+*/
+string BinarySerializer::getData() const {
+  if(!m_spRootWriteNode)
+    return m_spDocument->getData();
+
+  string sData;
+  writeULong(sData, Signature);
+  writeULong(sData, Version);
+  m_spDocument->writeNames(sData);
+  m_spRootWriteNode->write(sData);
+
+  return sData;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::enumScopes()                                           # //
+// ############################################################################################# //
+/** Returns an enumerator over all subscopes of the root scope
+
+    @param  sName  Name of the subscopes over which to enumerate, empty for all
+    @return The new enumerator
+*/
+shared_ptr<Serializer::ScopeEnumerator> BinarySerializer::enumScopes(const string &sName) {
+  return m_spRootNode->enumScopes(sName);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::openScope()                                            # //
+// ############################################################################################# //
+/** Opens the scope with the specified name
+
+    @param  sName      Name of the scope to open
+    @param  bOptional  Whether to return an empty scope when the scope doesn't exist
+*/
+shared_ptr<Serializer> BinarySerializer::openScope(const string &sName, bool bOptional) {
+  return m_spRootNode->openScope(sName, bOptional);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::createScope()                                          # //
+// ############################################################################################# //
+/** Creates a new scope under the root scope
+
+    @param  sName  Name of the scope to create
+    @return The created scope
+*/
+shared_ptr<Serializer> BinarySerializer::createScope(const string &sName) {
+  return m_spRootNode->createScope(sName);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::retrieveValue()                                        # //
+// ############################################################################################# //
+/** Returns the stored value with the specified name from the root scope
+
+    @param  sName  Name of the value to return
+    @return The value stored under the specified name
+*/
+Variant BinarySerializer::retrieveValue(const string &sName) {
+  return m_spRootNode->get<Variant>(sName);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::retrieveValue()                                        # //
+// ############################################################################################# //
+/** Returns the stored value with the specified name from the root scope or
+    a default value, if the specified name could not be found.
+
+    @param  sName    Name of the value to return
+    @param  Default  Default value to return when the named value could not be found
+    @return The value stored under the specified name or the default value
+*/
+Variant BinarySerializer::retrieveValue(const string &sName, const Variant &Default) {
+  return m_spRootNode->get<Variant>(sName, Default);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::storeValue()                                           # //
+// ############################################################################################# //
+/** Stores a value under the specified name into the root scope
+
+    @param  sName  Name under which to store the value
+    @param  Value  Value to store
+*/
+void BinarySerializer::storeValue(const string &sName, const Variant &Value) {
+  m_spRootNode->set<Variant>(sName, Value);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::ReadNode::openScope()                                  # //
+// ############################################################################################# //
+/** Opens the first nested scope with the specified name. Nested scopes
+    with other names are skipped without reading their contents.
+
+    @param  sName      Name of the scope to open
+    @param  bOptional  Whether to return an empty scope if the scope cannot be found
+*/
+shared_ptr<Serializer> BinarySerializer::ReadNode::openScope(const string &sName, bool bOptional) {
+  unsigned_32 nNameId = m_spDocument->findName(sName);
+
+  if(nNameId != UnknownName) {
+    DataReader Reader(m_spDocument->getData(), getScopesBegin(), m_nEnd);
+    size_t nScopeCount = Reader.readULong();
+    for(size_t Index = 0; Index < nScopeCount; ++Index) {
+      unsigned_32 nScopeNameId = Reader.readULong();
+      size_t nSize = Reader.readULong();
+      size_t nBegin = Reader.getPosition();
+      Reader.skip(nSize);
+
+      if(nScopeNameId == nNameId)
+        return shared_ptr<Serializer>(new ReadNode(m_spDocument, nNameId, nBegin, nBegin + nSize));
+    }
+  }
+
+  if(bOptional)
+    return shared_ptr<Serializer>();
+  else
+    throw ResourceException("Nuclex::Storage::BinarySerializer::ReadNode::openScope()",
+                            string("The scope '") + getName() + "' does not have a child named '" + sName + "'");
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::ReadNode::findValue()                                  # //
+// ############################################################################################# //
+/** Looks up the first value with the specified name in the scope. Names
+    which are not in the document's name table are rejected without
+    looking at the scope at all.
+
+    @param  sName  Name of the value to look up
+    @param  Value  Receives the value if it was found
+    @return True if the value was found
+*/
+bool BinarySerializer::ReadNode::findValue(const string &sName, Variant &Value) const {
+  unsigned_32 nNameId = m_spDocument->findName(sName);
+  if(nNameId == UnknownName)
+    return false;
+
+  DataReader Reader(m_spDocument->getData(), m_nBegin, m_nEnd);
+  size_t nValueCount = Reader.readULong();
+  Reader.readULong();
+
+  for(size_t Index = 0; Index < nValueCount; ++Index) {
+    unsigned_32 nValueNameId = Reader.readULong();
+    unsigned char nType = Reader.readByte();
+
+    if(nValueNameId == nNameId) {
+      Value = Reader.readValue(nType);
+      return true;
+    }
+
+    Reader.skipValue(nType);
+  }
+
+  return false;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::ReadNode::getScopesBegin()                             # //
+// ############################################################################################# //
+/** Returns the offset at which the list of nested scopes begins
+
+    @return The offset of the nested scopes
+*/
+size_t BinarySerializer::ReadNode::getScopesBegin() const {
+  DataReader Reader(m_spDocument->getData(), m_nBegin, m_nEnd);
+  Reader.readULong();
+  Reader.skip(Reader.readULong());
+
+  return Reader.getPosition();
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::WriteNode::write()                                     # //
+// ############################################################################################# //
+/** Appends the size and the contents of the scope and all its nested
+    scopes to binary serializer data
+
+    @param  sData  Data to append the scope to
+*/
+void BinarySerializer::WriteNode::write(string &sData) const {
+  size_t nSizePosition = sData.length();
+  writeULong(sData, 0);
+  size_t nBegin = sData.length();
+
+  writeULong(sData, static_cast<unsigned_32>(m_Values.size()));
+  size_t nValuesSizePosition = sData.length();
+  writeULong(sData, 0);
+  size_t nValuesBegin = sData.length();
+
+  for(ValueVector::const_iterator ValueIt = m_Values.begin(); ValueIt != m_Values.end(); ++ValueIt) {
+    writeULong(sData, ValueIt->first);
+    writeValue(sData, ValueIt->second);
+  }
+  patchULong(sData, nValuesSizePosition, static_cast<unsigned_32>(sData.length() - nValuesBegin));
+
+  writeULong(sData, static_cast<unsigned_32>(m_Scopes.size()));
+  for(ScopeVector::const_iterator ScopeIt = m_Scopes.begin(); ScopeIt != m_Scopes.end(); ++ScopeIt) {
+    writeULong(sData, ScopeIt->first);
+    ScopeIt->second->write(sData);
+  }
+
+  patchULong(sData, nSizePosition, static_cast<unsigned_32>(sData.length() - nBegin));
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::WriteNode::enumScopes()                                # //
+// ############################################################################################# //
+/** Returns an enumerator over the nested scopes with the specified name
+
+    @param  sName  Name of the scopes to enumerate, empty for all
+    @return The new enumerator
+*/
+shared_ptr<Serializer::ScopeEnumerator> BinarySerializer::WriteNode::enumScopes(
+  const string &sName
+) {
+  NamedScopeVector Scopes;
+  for(ScopeVector::const_iterator ScopeIt = m_Scopes.begin(); ScopeIt != m_Scopes.end(); ++ScopeIt) {
+    const string &sScopeName = m_spDocument->getName(ScopeIt->first);
+    if(sName.empty() || (sScopeName == sName))
+      Scopes.push_back(NamedScope(sScopeName, ScopeIt->second));
+  }
+
+  return shared_ptr<ScopeEnumerator>(new WriteScopeEnumerator(Scopes));
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::WriteNode::openScope()                                 # //
+// ############################################################################################# //
+/** Opens the first nested scope with the specified name
+
+    @param  sName      Name of the scope to open
+    @param  bOptional  Whether to return an empty scope if the scope cannot be found
+*/
+shared_ptr<Serializer> BinarySerializer::WriteNode::openScope(const string &sName, bool bOptional) {
+  unsigned_32 nNameId = m_spDocument->findName(sName);
+  for(ScopeVector::const_iterator ScopeIt = m_Scopes.begin(); ScopeIt != m_Scopes.end(); ++ScopeIt)
+    if(ScopeIt->first == nNameId)
+      return ScopeIt->second;
+
+  if(bOptional)
+    return shared_ptr<Serializer>();
+  else
+    throw ResourceException("Nuclex::Storage::BinarySerializer::WriteNode::openScope()",
+                            string("The scope does not have a child named '") + sName + "'");
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::WriteNode::storeValue()                                # //
+// ############################################################################################# //
+/** Stores the value under the specified name in the scope. Like XML
+    attributes, values whose name starts with an underscore replace
+    an existing value of the same name.
+
+    @param  sName  Name under which to store the value
+    @param  Value  Value to store
+*/
+void BinarySerializer::WriteNode::storeValue(const string &sName, const Variant &Value) {
+  unsigned_32 nNameId = m_spDocument->internName(sName);
+
+  if(sName.length() && sName[0] == '_')
+    for(ValueVector::iterator ValueIt = m_Values.begin(); ValueIt != m_Values.end(); ++ValueIt)
+      if(ValueIt->first == nNameId) {
+        ValueIt->second = Value;
+        return;
+      }
+
+  m_Values.push_back(ValueEntry(nNameId, Value));
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::BinarySerializer::WriteNode::findValue()                                 # //
+// ############################################################################################# //
+/** Looks up the first value with the specified name in the scope
+
+    @param  sName  Name of the value to look up
+    @return The value or NULL if the scope doesn't contain the value
+*/
+const Variant *BinarySerializer::WriteNode::findValue(const string &sName) const {
+  unsigned_32 nNameId = m_spDocument->findName(sName);
+  for(ValueVector::const_iterator ValueIt = m_Values.begin(); ValueIt != m_Values.end(); ++ValueIt)
+    if(ValueIt->first == nNameId)
+      return &ValueIt->second;
+
+  return NULL;
+}
@@ -15,6 +15,80 @@
 using namespace Nuclex;
 using namespace Nuclex::Storage;
 
+//  //
+//  Nuclex::Storage::ResourceSet::LoadOperation::DecodeJob                                     //
+//  //
+/// Decodes a single resource
+/** Loads an image or font from its stream. Errors are recorded in the
+    resource and reported by LoadOperation::update() on the main thread.
+*/
+class ResourceSet::LoadOperation::DecodeJob :
+  public Thread::Function {
+  public:
+    /// Constructor
+    DecodeJob(LoadOperation &Operation, size_t nIndex) :
+      m_Operation(Operation),
+      m_nIndex(nIndex) {}
+
+    /// Decode the resource
+    void operator()() {
+      Resource &LoadedResource = m_Operation.m_Resources[m_nIndex];
+
+      try {
+        if(LoadedResource.bFont)
+          LoadedResource.spFont = m_Operation.m_spTextServer->loadFont(
+            LoadedResource.spStream, "", LoadedResource.nFontSize
+          );
+        else
+          LoadedResource.spImage = m_Operation.m_spVideoServer->loadImage(LoadedResource.spStream);
+      }
+      catch(const std::exception &Error) {
+        LoadedResource.sError = Error.what();
+      }
+      catch(...) {
+        LoadedResource.sError = "Unknown error";
+      }
+
+      // Release the stream here, the decoder has no use for it anymore
+      LoadedResource.spStream.reset();
+
+      m_Operation.decoded(m_nIndex);
+    }
+
+  private:
+    LoadOperation &m_Operation;                       ///< Operation the resource belongs to
+    size_t         m_nIndex;                          ///< Index of the resource to decode
+};
+
+//  //
+//  Nuclex::Storage::ResourceSet::LoadOperation::DispatchJob                                   //
+//  //
+/// Schedules the decoding jobs
+/** Runs on a worker thread and schedules one decoding job per resource
+    as its own children, so the dispatch job's handle only reports being
+    finished once every resource has been decoded.
+*/
+class ResourceSet::LoadOperation::DispatchJob :
+  public Thread::Function {
+  public:
+    /// Constructor
+    DispatchJob(LoadOperation &Operation) :
+      m_Operation(Operation) {}
+
+    /// Schedule a decoding job for every resource
+    void operator()() {
+      JobScheduler::JobHandle Self = m_Operation.m_Scheduler.getCurrentJob();
+
+      for(size_t Index = 0; Index < m_Operation.m_Resources.size(); ++Index)
+        m_Operation.m_Scheduler.schedule(
+          std::auto_ptr<Thread::Function>(new DecodeJob(m_Operation, Index)), Self
+        );
+    }
+
+  private:
+    LoadOperation &m_Operation;                       ///< Operation being dispatched
+};
+
 // ############################################################################################# //
 // # Nuclex::Storage::ResourceSet::ResourceSet()                                   Constructor # //
 // ############################################################################################# //
@@ -110,6 +184,70 @@ void ResourceSet::save(const shared_ptr<Serializer> &spSerializer) const {
   }
 }
 
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::loadAsync()                                                 # //
+// ############################################################################################# //
+/** Loads the resource set like load(), but only mounts the archives on
+    the calling thread. Images and fonts are decoded by the scheduler's
+    worker threads, the returned operation adds them to the servers.
+
+    @param  spSerializer  Serializer to load the resource set from
+    @param  Scheduler     Scheduler to run the decoding jobs on
+    @return The operation tracking the decoding of the resources
+*/
+shared_ptr<ResourceSet::LoadOperation> ResourceSet::loadAsync(
+  const shared_ptr<Serializer> &spSerializer, Support::JobScheduler &Scheduler
+) {
+  shared_ptr<LoadOperation> spOperation(
+    new LoadOperation(Scheduler, m_spVideoServer, m_spTextServer)
+  );
+
+  // Mount archives. Everything else can be loaded from them, so this has
+  // to be finished before the images and fonts can be opened.
+  shared_ptr<Storage::Serializer::ScopeEnumerator> spArchiveEnum =
+    spSerializer->enumScopes("archive");
+
+  while(spArchiveEnum->next()) {
+    m_spStorageServer->addArchive(
+      spArchiveEnum->get().second->get<string>("_name"),
+      m_spStorageServer->openArchive(
+        spArchiveEnum->get().second->get<string>("_source")
+      )
+    );
+  }
+
+  // Open the streams of all bitmaps and fonts. This only looks up the files
+  // and leaves the reading and decoding to the jobs.
+  shared_ptr<Storage::Serializer::ScopeEnumerator> spImageEnum =
+    spSerializer->enumScopes("bitmap");
+
+  while(spImageEnum->next()) {
+    LoadOperation::Resource Image;
+    Image.sName = spImageEnum->get().second->get<string>("_name");
+    Image.spStream = m_spStorageServer->openStream(
+      spImageEnum->get().second->get<string>("_stream")
+    );
+    spOperation->m_Resources.push_back(Image);
+  }
+
+  shared_ptr<Storage::Serializer::ScopeEnumerator> spFontEnum =
+    spSerializer->enumScopes("font");
+
+  while(spFontEnum->next()) {
+    LoadOperation::Resource Font;
+    Font.sName = spFontEnum->get().second->get<string>("_name");
+    Font.bFont = true;
+    Font.nFontSize = spFontEnum->get().second->get<size_t>("_size");
+    Font.spStream = m_spStorageServer->openStream(
+      spFontEnum->get().second->get<string>("_stream")
+    );
+    spOperation->m_Resources.push_back(Font);
+  }
+
+  spOperation->start();
+  return spOperation;
+}
+
 // ############################################################################################# //
 // # Nuclex::Storage::ResourceSet::addArchive()                                                # //
 // ############################################################################################# //
@@ -180,3 +318,144 @@ const shared_ptr<Video::Image> &ResourceSet::getImage(const string &sName) const
 const shared_ptr<Text::Font> &ResourceSet::getFont(const string &sName) const {
   return m_spTextServer->getFont(sName);
 }
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::LoadOperation()                  Constructor # //
+// ############################################################################################# //
+/** Initializes an instance of LoadOperation
+
+    @param  Scheduler      Scheduler to run the decoding jobs on
+    @param  spVideoServer  Video server to add the images to
+    @param  spTextServer   Text server to add the fonts to
+*/
+ResourceSet::LoadOperation::LoadOperation(
+  Support::JobScheduler &Scheduler,
+  const shared_ptr<Video::VideoServer> &spVideoServer,
+  const shared_ptr<Text::TextServer> &spTextServer
+) :
+  m_Scheduler(Scheduler),
+  m_spVideoServer(spVideoServer),
+  m_spTextServer(spTextServer),
+  m_nDecodedCount(0),
+  m_nAddedCount(0) {}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::~LoadOperation()                  Destructor # //
+// ############################################################################################# //
+/** Destroys an instance of LoadOperation
+*/
+ResourceSet::LoadOperation::~LoadOperation() {
+  if(m_Dispatch.isValid())
+    m_Scheduler.wait(m_Dispatch);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::getDecodedCount()                            # //
+// ############################################################################################# //
+/** Returns the number of resources that have been decoded so far,
+    including resources which failed to load
+
+    @return The number of decoded resources
+*/
+size_t ResourceSet::LoadOperation::getDecodedCount() const {
+  Mutex::ScopedLock Lock(m_DecodedMutex);
+  return m_nDecodedCount;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::getProgress()                                # //
+// ############################################################################################# //
+/** Returns the fraction of the resources that have been decoded
+
+    @return The progress of the operation between 0.0 and 1.0
+*/
+float ResourceSet::LoadOperation::getProgress() const {
+  if(m_Resources.empty())
+    return 1.0f;
+
+  return static_cast<float>(getDecodedCount()) / static_cast<float>(m_Resources.size());
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::update()                                     # //
+// ############################################################################################# //
+/** Adds all resources which have been decoded since the last call to
+    their servers. Has to be called from the thread owning the servers.
+    If a resource failed to load, an exception is thrown after the other
+    decoded resources have been added. Calling update() again continues
+    with the remaining resources.
+
+    @return True if all resources have been added
+*/
+bool ResourceSet::LoadOperation::update() {
+  IndexVector Decoded;
+  { Mutex::ScopedLock Lock(m_DecodedMutex);
+    Decoded.swap(m_Decoded);
+  }
+
+  string sErrors;
+  for(IndexVector::const_iterator IndexIt = Decoded.begin(); IndexIt != Decoded.end(); ++IndexIt) {
+    Resource &LoadedResource = m_Resources[*IndexIt];
+
+    try {
+      if(!LoadedResource.sError.empty())
+        sErrors += "\n'" + LoadedResource.sName + "': " + LoadedResource.sError;
+      else if(LoadedResource.bFont)
+        m_spTextServer->addFont(LoadedResource.sName, LoadedResource.spFont);
+      else
+        m_spVideoServer->addImage(LoadedResource.sName, LoadedResource.spImage);
+    }
+    catch(const std::exception &Error) {
+      sErrors += "\n'" + LoadedResource.sName + "': " + Error.what();
+    }
+
+    // The servers hold the resources now
+    LoadedResource.spFont.reset();
+    LoadedResource.spImage.reset();
+    ++m_nAddedCount;
+  }
+
+  if(!sErrors.empty())
+    throw FailedException("Nuclex::Storage::ResourceSet::LoadOperation::update()",
+                          string("Resources could not be loaded:") + sErrors);
+
+  return isFinished();
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::wait()                                       # //
+// ############################################################################################# //
+/** Waits until all resources have been decoded, helping the workers
+    with decoding in the meantime, and adds them to their servers
+*/
+void ResourceSet::LoadOperation::wait() {
+  if(m_Dispatch.isValid())
+    m_Scheduler.wait(m_Dispatch);
+
+  update();
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::start()                                      # //
+// ############################################################################################# //
+/** Schedules the job which dispatches the decoding jobs
+*/
+void ResourceSet::LoadOperation::start() {
+  if(!m_Resources.empty())
+    m_Dispatch = m_Scheduler.schedule(
+      std::auto_ptr<Thread::Function>(new DispatchJob(*this))
+    );
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ResourceSet::LoadOperation::decoded()                                    # //
+// ############################################################################################# //
+/** Marks a resource as decoded so the next update() adds it to its server
+
+    @param  nIndex  Index of the decoded resource
+*/
+void ResourceSet::LoadOperation::decoded(size_t nIndex) {
+  Mutex::ScopedLock Lock(m_DecodedMutex);
+  m_Decoded.push_back(nIndex);
+  ++m_nDecodedCount;
+}
@@ -0,0 +1,476 @@
+//  //
+// #   #  ###  #   #              -= Nuclex Library =-                   //
+// ##  # #   # ## ## JobScheduler.cpp - Work-stealing job scheduler      //
+// ### # #      ###                                                      //
+// # ### #      ###  Distributes small jobs over worker threads which    //
+// #  ## #   # ## ## steal from each other when running out of work      //
+// #   #  ###  #   # R1        (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#include "Nuclex/Support/JobScheduler.h"
+#include "Nuclex/Support/Exception.h"
+
+#ifdef NUCLEX_WIN32
+#include <intrin.h>
+#pragma intrinsic(_ReadWriteBarrier)
+#endif
+
+using namespace Nuclex;
+using namespace Nuclex::Support;
+
+namespace {
+
+/// Number of times an idle worker looks for jobs before going to sleep
+const size_t IdleSpinCount = 64;
+
+} // namespace
+
+#ifdef NUCLEX_WIN32
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobDeque::push()                              # //
+// ####################################################################### //
+/** Pushes a job to the bottom of the deque. Must only be called by the
+    worker owning the deque.
+
+    @param  pJob  Job to push
+    @return True if the job was pushed, false if the deque was full
+*/
+bool JobScheduler::JobDeque::push(Job *pJob) {
+  long Bottom = m_nBottom;
+  if((Bottom - m_nTop) >= Capacity)
+    return false;
+
+  m_Jobs[Bottom & (Capacity - 1)] = pJob;
+
+  // The job must be visible before thieves see the new bottom. x86 does
+  // not reorder stores with other stores, so keeping the compiler in check
+  // is all that's required here
+  _ReadWriteBarrier();
+  m_nBottom = Bottom + 1;
+  return true;
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobDeque::pop()                               # //
+// ####################################################################### //
+/** Pops the most recently pushed job from the bottom of the deque. Must
+    only be called by the worker owning the deque.
+
+    @return The popped job or NULL if the deque was empty
+*/
+JobScheduler::Job *JobScheduler::JobDeque::pop() {
+  long Bottom = m_nBottom - 1;
+
+  // Publishing the reservation and reading the top must not be reordered,
+  // otherwise a thief and the owner could both take the last job
+  ::InterlockedExchange(&m_nBottom, Bottom);
+  long Top = m_nTop;
+
+  if(Top > Bottom) {
+    m_nBottom = Top;
+    return NULL;
+  }
+
+  Job *pJob = m_Jobs[Bottom & (Capacity - 1)];
+  if(Top != Bottom)
+    return pJob;
+
+  // This is the last job in the deque, race the thieves for it
+  if(::InterlockedCompareExchange(&m_nTop, Top + 1, Top) != Top)
+    pJob = NULL;
+
+  m_nBottom = Top + 1;
+  return pJob;
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobDeque::steal()                             # //
+// ####################################################################### //
+/** Takes the oldest job from the top of the deque. Can be called by
+    any thread.
+
+    @return The stolen job or NULL if the deque was empty or another
+            thread won the race for the job
+*/
+JobScheduler::Job *JobScheduler::JobDeque::steal() {
+  long Top = m_nTop;
+  _ReadWriteBarrier();
+  long Bottom = m_nBottom;
+
+  if(Top >= Bottom)
+    return NULL;
+
+  Job *pJob = m_Jobs[Top & (Capacity - 1)];
+  if(::InterlockedCompareExchange(&m_nTop, Top + 1, Top) != Top)
+    return NULL;
+
+  return pJob;
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobHandle::JobHandle()       Copy constructor # //
+// ####################################################################### //
+JobScheduler::JobHandle::JobHandle(const JobHandle &Other) :
+  m_pJob(Other.m_pJob) {
+  if(m_pJob)
+    addRef(m_pJob);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobHandle::~JobHandle()            Destructor # //
+// ####################################################################### //
+JobScheduler::JobHandle::~JobHandle() {
+  if(m_pJob)
+    release(m_pJob);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobHandle::operator =()                       # //
+// ####################################################################### //
+JobScheduler::JobHandle &JobScheduler::JobHandle::operator =(const JobHandle &Other) {
+  if(Other.m_pJob)
+    addRef(Other.m_pJob);
+  if(m_pJob)
+    release(m_pJob);
+
+  m_pJob = Other.m_pJob;
+  return *this;
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobHandle::isFinished()                       # //
+// ####################################################################### //
+/** Checks whether the job and all of its children have finished
+
+    @return True if the job has finished
+*/
+bool JobScheduler::JobHandle::isFinished() const {
+  return !m_pJob || (m_pJob->nUnfinished == 0);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::JobScheduler()                    Constructor # //
+// ####################################################################### //
+/** Initializes a job scheduler and starts the worker threads
+
+    @param  NumThreads  Number of worker threads to use
+*/
+JobScheduler::JobScheduler(size_t NumThreads) :
+  m_Workers(NumThreads),
+  m_nInjectedJobCount(0),
+  m_nSleepingWorkers(0),
+  m_bStopRequested(false),
+  m_nWorkerTlsIndex(::TlsAlloc()),
+  m_nJobTlsIndex(::TlsAlloc()),
+  m_hWakeUp(::CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL)) {
+
+  if((m_nWorkerTlsIndex == TLS_OUT_OF_INDEXES) ||
+     (m_nJobTlsIndex == TLS_OUT_OF_INDEXES) ||
+     !m_hWakeUp)
+    throw UnexpectedException("Nuclex::Support::JobScheduler::JobScheduler()",
+                              "Could not allocate synchronization resources");
+
+  // The workers must all exist before the first thread starts stealing
+  for(size_t Index = 0; Index < m_Workers.size(); ++Index)
+    m_Workers[Index].second = new Worker(*this, Index);
+
+  for(WorkerVector::iterator It = m_Workers.begin();
+      It != m_Workers.end();
+      ++It)
+    It->first = shared_ptr<Thread>(new Thread(std::auto_ptr<Thread::Function>(It->second)));
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::~JobScheduler()                    Destructor # //
+// ####################################################################### //
+/** Destroys the job scheduler. Jobs which have not been started yet
+    are discarded without being executed.
+*/
+JobScheduler::~JobScheduler() {
+  m_bStopRequested = true;
+  ::ReleaseSemaphore(m_hWakeUp, static_cast<LONG>(m_Workers.size()), NULL);
+
+  for(WorkerVector::iterator It = m_Workers.begin();
+      It != m_Workers.end();
+      ++It)
+    It->first->join();
+
+  // Drop whatever remained in the queues. The workers' deques have no
+  // owner anymore, so stealing is the only safe way to drain them
+  for(WorkerVector::iterator It = m_Workers.begin();
+      It != m_Workers.end();
+      ++It)
+    while(Job *pJob = It->second->m_Jobs.steal())
+      release(pJob);
+
+  for(JobQueue::iterator It = m_InjectedJobs.begin();
+      It != m_InjectedJobs.end();
+      ++It)
+    release(*It);
+
+  m_Workers.clear();
+
+  ::CloseHandle(m_hWakeUp);
+  ::TlsFree(m_nJobTlsIndex);
+  ::TlsFree(m_nWorkerTlsIndex);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::schedule()                                    # //
+// ####################################################################### //
+/** Schedules a job for execution. If a parent is specified, the parent
+    will not be considered finished until this job has finished. The parent
+    must not have finished when its children are scheduled, so children
+    are normally scheduled from within the parent job itself.
+
+    @param  spJob   Job to execute
+    @param  Parent  Optional parent of the job
+    @return A handle through which the job can be waited upon
+*/
+JobScheduler::JobHandle JobScheduler::schedule(
+  std::auto_ptr<Thread::Function> spJob, const JobHandle &Parent
+) {
+  Job *pParent = Parent.m_pJob;
+  if(pParent) {
+    addRef(pParent);
+    ::InterlockedIncrement(&pParent->nUnfinished);
+  }
+
+  // One reference is owned by the queue, one by the returned handle
+  Job *pJob = new Job(spJob.release(), pParent);
+  addRef(pJob);
+
+  Worker *pWorker = getCurrentWorker();
+  if(pWorker) {
+    // Deque overflow means the job tree is far wider than the thread
+    // count, so running the job right away costs no parallelism
+    if(!pWorker->m_Jobs.push(pJob)) {
+      execute(pJob);
+      return JobHandle(pJob);
+    }
+  } else {
+    Mutex::ScopedLock InjectedJobsLock(m_InjectedJobsMutex);
+    m_InjectedJobs.push_back(pJob);
+    ::InterlockedIncrement(&m_nInjectedJobCount);
+  }
+
+  wakeWorker();
+  return JobHandle(pJob);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::wait()                                        # //
+// ####################################################################### //
+/** Executes scheduled jobs on the calling thread until the specified job
+    and all of its children have finished. Can be called from worker
+    threads and from foreign threads alike.
+
+    @param  Handle  Job to wait for
+*/
+void JobScheduler::wait(const JobHandle &Handle) {
+  Worker *pWorker = getCurrentWorker();
+
+  while(!Handle.isFinished()) {
+    if(Job *pJob = findJob(pWorker))
+      execute(pJob);
+    else
+      ::SwitchToThread();
+  }
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::getCurrentJob()                               # //
+// ####################################################################### //
+/** Returns the job the calling thread is currently executing. This can be
+    used by jobs to schedule children of themselves.
+
+    @return The current job or an invalid handle outside of any job
+*/
+JobScheduler::JobHandle JobScheduler::getCurrentJob() const {
+  Job *pJob = reinterpret_cast<Job *>(::TlsGetValue(m_nJobTlsIndex));
+  if(pJob)
+    addRef(pJob);
+
+  return JobHandle(pJob);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::addRef()                                      # //
+// ####################################################################### //
+void JobScheduler::addRef(Job *pJob) {
+  ::InterlockedIncrement(&pJob->nRefCount);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::release()                                     # //
+// ####################################################################### //
+void JobScheduler::release(Job *pJob) {
+  if(::InterlockedDecrement(&pJob->nRefCount) == 0) {
+    delete pJob->pFunction;
+    delete pJob;
+  }
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::finish()                                      # //
+// ####################################################################### //
+/** Marks one outstanding unit of the job as finished. When the job itself
+    and all of its children are done, the parent gets notified in turn.
+
+    @param  pJob  Job of which a unit was finished
+*/
+void JobScheduler::finish(Job *pJob) {
+  if(::InterlockedDecrement(&pJob->nUnfinished) == 0) {
+    if(pJob->pParent) {
+      finish(pJob->pParent);
+      release(pJob->pParent);
+    }
+  }
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::execute()                                     # //
+// ####################################################################### //
+/** Runs a job on the calling thread and releases the queue's reference
+    to it afterwards
+
+    @param  pJob  Job to run
+*/
+void JobScheduler::execute(Job *pJob) {
+  void *pPreviousJob = ::TlsGetValue(m_nJobTlsIndex);
+  ::TlsSetValue(m_nJobTlsIndex, pJob);
+
+  pJob->pFunction->operator()();
+
+  ::TlsSetValue(m_nJobTlsIndex, pPreviousJob);
+
+  finish(pJob);
+  release(pJob);
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::findJob()                                     # //
+// ####################################################################### //
+/** Looks for a job to execute. Workers try their own deque first, then
+    the injected jobs and finally try to steal from other workers,
+    starting at a random victim to spread contention.
+
+    @param  pWorker  Worker looking for a job, NULL for foreign threads
+    @return The job to execute or NULL if none could be found
+*/
+JobScheduler::Job *JobScheduler::findJob(Worker *pWorker) {
+  if(pWorker)
+    if(Job *pJob = pWorker->m_Jobs.pop())
+      return pJob;
+
+  if(m_nInjectedJobCount > 0) {
+    Mutex::ScopedLock InjectedJobsLock(m_InjectedJobsMutex);
+
+    if(!m_InjectedJobs.empty()) {
+      Job *pJob = m_InjectedJobs.front();
+      m_InjectedJobs.pop_front();
+      ::InterlockedDecrement(&m_nInjectedJobCount);
+      return pJob;
+    }
+  }
+
+  size_t WorkerCount = m_Workers.size();
+  if(WorkerCount == 0)
+    return NULL;
+
+  size_t Victim = pWorker ? (pWorker->random() % WorkerCount) : 0;
+  for(size_t Attempt = 0; Attempt < WorkerCount; ++Attempt) {
+    Worker *pVictim = m_Workers[(Victim + Attempt) % WorkerCount].second;
+    if(pVictim != pWorker)
+      if(Job *pJob = pVictim->m_Jobs.steal())
+        return pJob;
+  }
+
+  return NULL;
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::wakeWorker()                                  # //
+// ####################################################################### //
+/** Wakes up one sleeping worker. A worker is taken off the sleeper count
+    before the semaphore is released, so each sleeper receives exactly one
+    wake up and none can get lost between checking for work and sleeping.
+*/
+void JobScheduler::wakeWorker() {
+  for(;;) {
+    long SleepingWorkers = m_nSleepingWorkers;
+    if(SleepingWorkers <= 0)
+      return;
+
+    if(::InterlockedCompareExchange(
+      &m_nSleepingWorkers, SleepingWorkers - 1, SleepingWorkers
+    ) == SleepingWorkers) {
+      ::ReleaseSemaphore(m_hWakeUp, 1, NULL);
+      return;
+    }
+  }
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::getCurrentWorker()                            # //
+// ####################################################################### //
+JobScheduler::Worker *JobScheduler::getCurrentWorker() const {
+  return reinterpret_cast<Worker *>(::TlsGetValue(m_nWorkerTlsIndex));
+}
+
+// ####################################################################### //
+// # Nuclex::JobScheduler::Worker::operator()                            # //
+// ####################################################################### //
+/** The worker's main method. Executes jobs as long as there are any and
+    spins for a while when it runs out of work before going to sleep.
+*/
+void JobScheduler::Worker::operator()() {
+  ::TlsSetValue(m_Owner.m_nWorkerTlsIndex, this);
+
+  while(!m_Owner.m_bStopRequested) {
+    Job *pJob = NULL;
+
+    for(size_t Spin = 0; !pJob && (Spin < IdleSpinCount); ++Spin) {
+      pJob = m_Owner.findJob(this);
+      if(!pJob)
+        ::SwitchToThread();
+    }
+
+    if(!pJob) {
+      // Announce the intent to sleep, then look once more so a job that
+      // was scheduled right before the announcement cannot be missed
+      ::InterlockedIncrement(&m_Owner.m_nSleepingWorkers);
+      pJob = m_Owner.findJob(this);
+
+      if(pJob) {
+        // Withdraw the announcement. If a scheduler took it already,
+        // its wake up is meant for us and has to be consumed
+        bool bWithdrawn = false;
+        for(;;) {
+          long SleepingWorkers = m_Owner.m_nSleepingWorkers;
+          if(SleepingWorkers <= 0)
+            break;
+
+          if(::InterlockedCompareExchange(
+            &m_Owner.m_nSleepingWorkers, SleepingWorkers - 1, SleepingWorkers
+          ) == SleepingWorkers) {
+            bWithdrawn = true;
+            break;
+          }
+        }
+
+        if(!bWithdrawn)
+          ::WaitForSingleObject(m_Owner.m_hWakeUp, INFINITE);
+      } else {
+        ::WaitForSingleObject(m_Owner.m_hWakeUp, INFINITE);
+        continue;
+      }
+    }
+
+    m_Owner.execute(pJob);
+  }
+}
+
+#else
+#error Not implemented yet
+#endif // NUCLEX_WIN32
@@ -12,8 +12,6 @@
 using namespace Nuclex;
 using namespace Nuclex::Support;
 
-namespace { void doNothing() {} }
-
 // ####################################################################### //
 // # Nuclex::ThreadPool::ThreadPool()                        Constructor # // 
 // ####################################################################### //
@@ -22,17 +20,7 @@ namespace { void doNothing() {} }
     @param  NumThreads  Number of worker threads to use
 */
 ThreadPool::ThreadPool(size_t NumThreads) :
-  m_WorkerThreads(NumThreads) {
-  
-  // Create the threads and put them in sleep mode
-  for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
-      It != m_WorkerThreads.end();
-      ++It) {
-    It->second = new WorkerThread(*this);
-    It->second->getSignal().set(false);
-    It->first = shared_ptr<Thread>(new Thread(std::auto_ptr<Thread::Function>(It->second)));
-  }
-}
+  m_Scheduler(NumThreads) {}
 
 // ####################################################################### //
 // # Nuclex::ThreadPool::~ThreadPool()                        Destructor # // 
@@ -40,21 +28,7 @@ ThreadPool::ThreadPool(size_t NumThreads) :
 /** Destroy the thread pool, stopping and joining all threads
     currently belonging to the pool.
 */    
-ThreadPool::~ThreadPool() {
-  // Request stop and wake up on all threads
-  for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
-      It != m_WorkerThreads.end();
-      ++It) {
-    It->first->requestStop();
-    It->second->getSignal().set();
-  }
-
-  // Wait for the threads to finish
-  for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
-      It != m_WorkerThreads.end();
-      ++It)
-    It->first->join();
-}
+ThreadPool::~ThreadPool() {}
 
 // ####################################################################### //
 // # Nuclex::ThreadPool::enqueue()                                       # // 
@@ -64,58 +38,7 @@ ThreadPool::~ThreadPool() {
     @param  spTask  Function to be queued for execution on a thread
 */
 void ThreadPool::enqueue(std::auto_ptr<Thread::Function> spTask) {
-  // Put the task in the queue
-  { Mutex::ScopedLock TaskLock(m_TasksMutex);
-
-    // Grab away the auto_ptr's object. It was only used to make it
-    // clear to the user that the object will be deleted after completion
-    m_Tasks.push_back(shared_ptr<Thread::Function>(spTask.release()));
-  }
-  
-  // Look for a free thread to perform this task
-  for(WorkerThreadVector::iterator It = m_WorkerThreads.begin();
-      It != m_WorkerThreads.end();
-      ++It) {
-    // If the thread is free, wake it up and end the search
-    if(!It->second->isWorking()) {
-      It->second->getSignal().set();
-      break;
-    }
-  }  
-}
-
-// ####################################################################### //
-// # Nuclex::ThreadPool::WorkerThread::operator()                        # // 
-// ####################################################################### //
-/** The thread's main method. Takes an open task from the queue and
-    executes it, if available, or goes to sleep.
-*/
-void ThreadPool::WorkerThread::operator()() {
-  while(!m_bStopRequested) {
-    shared_ptr<Thread::Function> spTask;
-    bool                         bSleep;
-    
-    // Look for a new taks in the task queue
-    { Mutex::ScopedLock TaskLock(m_Owner.m_TasksMutex);
-      
-      if(m_Owner.m_Tasks.size() > 0) {
-        spTask = m_Owner.m_Tasks.front();
-        m_Owner.m_Tasks.pop_front();
-        bSleep = false;
-      } else {
-        bSleep = true;
-      }
-    }
-    
-    // Go to sleep if no tasks are available
-    if(bSleep) {
-      m_bWorking = false;
-      m_Signal.set(false);
-      m_Signal.wait();
-    } else {
-      spTask->operator()();
-    }
-  }
+  m_Scheduler.schedule(spTask);
 }
 
 // ne kw hm, bt he ws ster tn te wd
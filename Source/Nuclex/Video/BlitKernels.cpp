@@ -0,0 +1,362 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## BlitKernels.cpp - Accelerated blitting routines                           //
+// ### # #      ###                                                                            //
+// # ### #      ###  Vectorized blitting routines for frequently used                          //
+// #  ## #   # ## ## pixel format combinations                                                 //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#include "Nuclex/Video/BlitKernels.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define NUCLEX_VIDEO_SSE2
+#include <emmintrin.h>
+#include <intrin.h>
+#endif
+
+using namespace Nuclex;
+using namespace Nuclex::Video;
+
+namespace {
+
+/// Check whether the cpu supports SSE2 instructions
+bool detectSSE2() {
+#if defined(_M_X64)
+  return true; // Part of the x64 base instruction set
+#elif defined(_M_IX86)
+  int CpuInfo[4];
+  __cpuid(CpuInfo, 1);
+  return (CpuInfo[3] & (1 << 26)) != 0;
+#else
+  return false;
+#endif
+}
+
+/// Whether the SSE2 kernels can be used on this cpu
+const bool CpuHasSSE2 = detectSSE2();
+
+// The scalar versions below are used for the pixels left over at the end of a row.
+// They are written to produce exactly the same results as the generic Blit template:
+// AlphaBlend computes d + ((s - d) * a >> 8) with a wrapping subtraction and keeps only
+// the channel's bits, so the low 8 bits of an unsigned calculation match it.
+
+/// Alpha blends an argb-8-8-8-8 pixel onto another by the source pixel's alpha
+inline unsigned_32 blendPixel(unsigned_32 nDestination, unsigned_32 nSource) {
+  unsigned_32 nAlpha = nSource >> 24;
+  unsigned_32 nResult = 0;
+  for(unsigned long nShift = 0; nShift < 32; nShift += 8) {
+    unsigned_32 nDestinationChannel = (nDestination >> nShift) & 0xFF;
+    unsigned_32 nSourceChannel = (nSource >> nShift) & 0xFF;
+    nResult |= (
+      (nDestinationChannel + (((nSourceChannel - nDestinationChannel) * nAlpha) >> 8)) & 0xFF
+    ) << nShift;
+  }
+
+  return nResult;
+}
+
+/// Converts an 8-8-8 pixel to rgb-5-6-5 by cutting off the lower bits
+inline unsigned_16 pixelTo565(unsigned_32 nPixel) {
+  return static_cast<unsigned_16>(
+    ((nPixel >> 8) & 0xF800) | ((nPixel >> 5) & 0x07E0) | ((nPixel >> 3) & 0x001F)
+  );
+}
+
+/// Converts an rgb-5-6-5 pixel to 8-8-8 with the lower bits left empty
+inline unsigned_32 pixelFrom565(unsigned_16 nPixel) {
+  return ((nPixel & 0xF800) << 8) | ((nPixel & 0x07E0) << 5) | ((nPixel & 0x001F) << 3);
+}
+
+#ifdef NUCLEX_VIDEO_SSE2
+
+/// Alpha blends two unpacked argb-8-8-8-8 pixels with 16 bits per channel
+inline __m128i blendChannels(__m128i Destination, __m128i Source) {
+  // Spread each pixel's alpha value over all of its channels
+  __m128i Alpha = _mm_shufflehi_epi16(
+    _mm_shufflelo_epi16(Source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)
+  );
+
+  // Only bits 8 to 15 of the product are needed, so the 16 bit multiplication
+  // can overflow without changing the result
+  return _mm_and_si128(
+    _mm_add_epi16(
+      Destination,
+      _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(Source, Destination), Alpha), 8)
+    ),
+    _mm_set1_epi16(0x00FF)
+  );
+}
+
+/// Converts four 8-8-8 pixels to rgb-5-6-5 in the low halves of 32 bit values
+inline __m128i convertTo565(__m128i Pixels) {
+  __m128i Converted = _mm_or_si128(
+    _mm_or_si128(
+      _mm_and_si128(_mm_srli_epi32(Pixels, 8), _mm_set1_epi32(0xF800)),
+      _mm_and_si128(_mm_srli_epi32(Pixels, 5), _mm_set1_epi32(0x07E0))
+    ),
+    _mm_and_si128(_mm_srli_epi32(Pixels, 3), _mm_set1_epi32(0x001F))
+  );
+
+  // Sign extend so the saturating pack keeps the bits unchanged
+  return _mm_srai_epi32(_mm_slli_epi32(Converted, 16), 16);
+}
+
+/// Alpha blends a row of argb-8-8-8-8 pixels, four at a time
+void blendRow(unsigned_32 *pDestination, const unsigned_32 *pSource, unsigned long nCount) {
+  const __m128i Zero = _mm_setzero_si128();
+
+  for(; nCount >= 4; nCount -= 4) {
+    __m128i Source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource));
+    __m128i Destination = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pDestination));
+
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(pDestination),
+      _mm_packus_epi16(
+        blendChannels(_mm_unpacklo_epi8(Destination, Zero), _mm_unpacklo_epi8(Source, Zero)),
+        blendChannels(_mm_unpackhi_epi8(Destination, Zero), _mm_unpackhi_epi8(Source, Zero))
+      )
+    );
+
+    pSource += 4;
+    pDestination += 4;
+  }
+
+  for(; nCount > 0; --nCount, ++pSource, ++pDestination)
+    *pDestination = blendPixel(*pDestination, *pSource);
+}
+
+/// Converts a row of 8-8-8 pixels to rgb-5-6-5, eight at a time
+void convertRowTo565(unsigned_16 *pDestination, const unsigned_32 *pSource,
+                     unsigned long nCount) {
+  for(; nCount >= 8; nCount -= 8) {
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(pDestination),
+      _mm_packs_epi32(
+        convertTo565(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource))),
+        convertTo565(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource + 4)))
+      )
+    );
+
+    pSource += 8;
+    pDestination += 8;
+  }
+
+  for(; nCount > 0; --nCount, ++pSource, ++pDestination)
+    *pDestination = pixelTo565(*pSource);
+}
+
+/// Converts a row of rgb-5-6-5 pixels to 8-8-8 plus the given alpha bits, eight at a time
+void convertRowFrom565(unsigned_32 *pDestination, const unsigned_16 *pSource,
+                       unsigned long nCount, unsigned_32 nAlpha) {
+  const __m128i Alpha = _mm_set1_epi16(static_cast<short>(nAlpha >> 16));
+
+  for(; nCount >= 8; nCount -= 8) {
+    __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource));
+
+    __m128i BlueGreen = _mm_or_si128(
+      _mm_and_si128(_mm_slli_epi16(Pixels, 3), _mm_set1_epi16(0x00F8)),
+      _mm_and_si128(_mm_slli_epi16(Pixels, 5), _mm_set1_epi16(static_cast<short>(0xFC00)))
+    );
+    __m128i RedAlpha = _mm_or_si128(
+      _mm_and_si128(_mm_srli_epi16(Pixels, 8), _mm_set1_epi16(0x00F8)), Alpha
+    );
+
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(pDestination), _mm_unpacklo_epi16(BlueGreen, RedAlpha)
+    );
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(pDestination + 4), _mm_unpackhi_epi16(BlueGreen, RedAlpha)
+    );
+
+    pSource += 8;
+    pDestination += 8;
+  }
+
+  for(; nCount > 0; --nCount, ++pSource, ++pDestination)
+    *pDestination = pixelFrom565(*pSource) | nAlpha;
+}
+
+#endif // NUCLEX_VIDEO_SSE2
+
+/// Converts a surface to rgb-5-6-5 row by row
+bool blitTo565(void *pDestination, long nDestinationPitch,
+               const void *pSource, long nSourcePitch,
+               const Point2<unsigned long> &Size) {
+#ifdef NUCLEX_VIDEO_SSE2
+  if(!CpuHasSSE2)
+    return false;
+
+  unsigned char *pDestinationRow = static_cast<unsigned char *>(pDestination);
+  const unsigned char *pSourceRow = static_cast<const unsigned char *>(pSource);
+  for(unsigned long nY = 0; nY < Size.Y; ++nY) {
+    convertRowTo565(
+      reinterpret_cast<unsigned_16 *>(pDestinationRow),
+      reinterpret_cast<const unsigned_32 *>(pSourceRow),
+      Size.X
+    );
+
+    pDestinationRow += nDestinationPitch;
+    pSourceRow += nSourcePitch;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// Converts a surface from rgb-5-6-5 row by row
+bool blitFrom565(void *pDestination, long nDestinationPitch,
+                 const void *pSource, long nSourcePitch,
+                 const Point2<unsigned long> &Size, unsigned_32 nAlpha) {
+#ifdef NUCLEX_VIDEO_SSE2
+  if(!CpuHasSSE2)
+    return false;
+
+  unsigned char *pDestinationRow = static_cast<unsigned char *>(pDestination);
+  const unsigned char *pSourceRow = static_cast<const unsigned char *>(pSource);
+  for(unsigned long nY = 0; nY < Size.Y; ++nY) {
+    convertRowFrom565(
+      reinterpret_cast<unsigned_32 *>(pDestinationRow),
+      reinterpret_cast<const unsigned_16 *>(pSourceRow),
+      Size.X, nAlpha
+    );
+
+    pDestinationRow += nDestinationPitch;
+    pSourceRow += nSourcePitch;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+// ############################################################################################# //
+// # Nuclex::Video::BlitKernel<ARGB_8_8_8_8, ARGB_8_8_8_8, true>::operator()                   # //
+// ############################################################################################# //
+/** Alpha blends the source surface onto the destination surface by the alpha
+    channel of the source surface
+
+    @param  pDestination       Address of the first destination pixel
+    @param  nDestinationPitch  Number of bytes between two destination rows
+    @param  pSource            Address of the first source pixel
+    @param  nSourcePitch       Number of bytes between two source rows
+    @param  Size               Number of pixels to blend
+    @return True if the blit was performed
+*/
+bool BlitKernel<ARGB_8_8_8_8, ARGB_8_8_8_8, true>::operator ()(
+  void *pDestination, long nDestinationPitch,
+  const void *pSource, long nSourcePitch,
+  const Point2<unsigned long> &Size
+) {
+#ifdef NUCLEX_VIDEO_SSE2
+  if(!CpuHasSSE2)
+    return false;
+
+  unsigned char *pDestinationRow = static_cast<unsigned char *>(pDestination);
+  const unsigned char *pSourceRow = static_cast<const unsigned char *>(pSource);
+  for(unsigned long nY = 0; nY < Size.Y; ++nY) {
+    blendRow(
+      reinterpret_cast<unsigned_32 *>(pDestinationRow),
+      reinterpret_cast<const unsigned_32 *>(pSourceRow),
+      Size.X
+    );
+
+    pDestinationRow += nDestinationPitch;
+    pSourceRow += nSourcePitch;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::BlitKernel<RGB_5_6_5, ARGB_8_8_8_8, false>::operator()                     # //
+// ############################################################################################# //
+/** Converts the source surface to rgb-5-6-5, dropping its alpha channel
+
+    @param  pDestination       Address of the first destination pixel
+    @param  nDestinationPitch  Number of bytes between two destination rows
+    @param  pSource            Address of the first source pixel
+    @param  nSourcePitch       Number of bytes between two source rows
+    @param  Size               Number of pixels to convert
+    @return True if the blit was performed
+*/
+bool BlitKernel<RGB_5_6_5, ARGB_8_8_8_8, false>::operator ()(
+  void *pDestination, long nDestinationPitch,
+  const void *pSource, long nSourcePitch,
+  const Point2<unsigned long> &Size
+) {
+  return blitTo565(pDestination, nDestinationPitch, pSource, nSourcePitch, Size);
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::BlitKernel<RGB_5_6_5, XRGB_8_8_8_8, false>::operator()                     # //
+// ############################################################################################# //
+/** Converts the source surface to rgb-5-6-5
+
+    @param  pDestination       Address of the first destination pixel
+    @param  nDestinationPitch  Number of bytes between two destination rows
+    @param  pSource            Address of the first source pixel
+    @param  nSourcePitch       Number of bytes between two source rows
+    @param  Size               Number of pixels to convert
+    @return True if the blit was performed
+*/
+bool BlitKernel<RGB_5_6_5, XRGB_8_8_8_8, false>::operator ()(
+  void *pDestination, long nDestinationPitch,
+  const void *pSource, long nSourcePitch,
+  const Point2<unsigned long> &Size
+) {
+  return blitTo565(pDestination, nDestinationPitch, pSource, nSourcePitch, Size);
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::BlitKernel<ARGB_8_8_8_8, RGB_5_6_5, false>::operator()                     # //
+// ############################################################################################# //
+/** Converts the source surface to argb-8-8-8-8. Like the generic conversion,
+    the lower bits of each color channel are left empty and the alpha channel,
+    which doesn't exist in the source, is set to opaque.
+
+    @param  pDestination       Address of the first destination pixel
+    @param  nDestinationPitch  Number of bytes between two destination rows
+    @param  pSource            Address of the first source pixel
+    @param  nSourcePitch       Number of bytes between two source rows
+    @param  Size               Number of pixels to convert
+    @return True if the blit was performed
+*/
+bool BlitKernel<ARGB_8_8_8_8, RGB_5_6_5, false>::operator ()(
+  void *pDestination, long nDestinationPitch,
+  const void *pSource, long nSourcePitch,
+  const Point2<unsigned long> &Size
+) {
+  return blitFrom565(
+    pDestination, nDestinationPitch, pSource, nSourcePitch, Size, 0xFF000000
+  );
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::BlitKernel<XRGB_8_8_8_8, RGB_5_6_5, false>::operator()                     # //
+// ############################################################################################# //
+/** Converts the source surface to xrgb-8-8-8-8. Like the generic conversion,
+    the lower bits of each color channel and the unused upper byte are left empty.
+
+    @param  pDestination       Address of the first destination pixel
+    @param  nDestinationPitch  Number of bytes between two destination rows
+    @param  pSource            Address of the first source pixel
+    @param  nSourcePitch       Number of bytes between two source rows
+    @param  Size               Number of pixels to convert
+    @return True if the blit was performed
+*/
+bool BlitKernel<XRGB_8_8_8_8, RGB_5_6_5, false>::operator ()(
+  void *pDestination, long nDestinationPitch,
+  const void *pSource, long nSourcePitch,
+  const Point2<unsigned long> &Size
+) {
+  return blitFrom565(pDestination, nDestinationPitch, pSource, nSourcePitch, Size, 0);
+}
+
@@ -12,6 +12,27 @@
 using namespace Nuclex;
 using namespace Nuclex::Video;
 
+namespace {
+
+/// Number of cache textures which are created before objects get evicted
+const size_t DefaultMaxTextureCount = 4;
+/// Occupancy below which the objects on a cache texture are moved to other textures
+const float DefragmentationThreshold = 0.25f;
+/// Maximum number of objects moved to other cache textures per frame
+const size_t MaxRelocationsPerFrame = 16;
+
+/// Calculates the texture coordinates of a cached object
+inline Box2<float> locationFromPosition(const Point2<size_t> &Position,
+                                        const Point2<size_t> &Size,
+                                        const Point2<size_t> &Resolution) {
+  return Box2<float>(
+    Point2<float>(Position, StaticCastTag()) / Point2<float>(Resolution, StaticCastTag()),
+    Point2<float>(Position + Size, StaticCastTag()) / Point2<float>(Resolution, StaticCastTag())
+  );
+}
+
+} // namespace
+
 // ############################################################################################# //
 // # Nuclex::Video::TextureCache::TextureCache()                                   Constructor # //
 // ############################################################################################# //
@@ -22,7 +43,10 @@ using namespace Nuclex::Video;
 */
 TextureCache::TextureCache(const shared_ptr<VideoDevice> &spVideoDevice) :
   m_spVideoDevice(spVideoDevice),
-  m_Resolution(spVideoDevice->getMaxTextureSize()) {
+  m_Resolution(spVideoDevice->getMaxTextureSize()),
+  m_nMaxTextureCount(DefaultMaxTextureCount),
+  m_nFrame(1),
+  m_nGeneration(0) {
 
   // Calculate the optimal cache texture size for the chosen device
   if(spVideoDevice->getVideoMemorySize() < 64) 
@@ -68,10 +92,16 @@ TextureCache::CacheSlot TextureCache::cache(const shared_ptr<Texture> &spTexture
     // Everything else gets placed in the cache
     else
       CacheEntryIt = addToCache(spTexture);
+
+  } else {
+    ++m_Statistics.nHits;
   }
 
   // Return a valid cache slot
-  return CacheSlot(CacheEntryIt->second.spCacheTexture, CacheEntryIt->second.Location);
+  touchEntry(CacheEntryIt);
+  return CacheSlot(
+    CacheEntryIt->second.spSharedTexture->spTexture, CacheEntryIt->second.Location
+  );
 }
 
 // ############################################################################################# //
@@ -99,43 +129,37 @@ TextureCache::CacheSlot TextureCache::cache(
       
     // Everything else gets placed in the cache
     } else {
-      // Find a free location for the surface within the current cache texture
-      Point2<size_t> Location = m_spCurrentTexture->Packer.placeRectangle(Size);
-      if(Location == m_Resolution) {
-        // If it doesn't fit anymore, try using a new cache texture
-        appendSharedTexture();
-        Location = m_spCurrentTexture->Packer.placeRectangle(Size);
-      }
+      // Find a free location for the object on one of the cache textures
+      Point2<size_t> Position;
+      shared_ptr<SharedTexture> spSharedTexture = allocate(Size, Position);
+      ScopeGuard Release_Rectangle = ::MakeObjGuard(
+        spSharedTexture->Packer, &SharedTexture::RectanglePacker::releaseRectangle,
+        Position, Size
+      );
 
-      { Surface::LockInfo LockedSurface = m_spCurrentTexture->spTexture->lock(
-          Surface::LM_WRITE, Box2<long>(Location, Location + Size)
+      { Surface::LockInfo LockedSurface = spSharedTexture->spTexture->lock(
+          Surface::LM_WRITE, Box2<long>(Position, Position + Size)
         );
       
         ScopeGuard Unlock_Dest = ::MakeObjGuard(
-          *m_spCurrentTexture->spTexture.get(), &Surface::unlock
+          *spSharedTexture->spTexture.get(), &Surface::unlock
         );
         UpdateCallback(LockedSurface);
       }
 
-      // Add the cache entry into the internet list and return its the iterator
-      CacheEntryIt = m_CacheEntries.insert(CacheEntryMap::value_type(
-        ID,
-        CacheEntry(
-          shared_ptr<Surface>(),
-          m_spCurrentTexture->spTexture,
-          Box2<float>(
-            Point2<float>(Location, StaticCastTag()) /
-              Point2<float>(m_Resolution, StaticCastTag()),
-            Point2<float>(Location + Size, StaticCastTag()) /
-              Point2<float>(m_Resolution, StaticCastTag())
-          )
-        )
-      )).first;
+      Release_Rectangle.Dismiss();
+      CacheEntryIt = addEntry(ID, weak_ptr<void>(), false, spSharedTexture, Position, Size);
     }
+
+  } else {
+    ++m_Statistics.nHits;
   }
 
   // Return a valid cache slot
-  return CacheSlot(CacheEntryIt->second.spCacheTexture, CacheEntryIt->second.Location);
+  touchEntry(CacheEntryIt);
+  return CacheSlot(
+    CacheEntryIt->second.spSharedTexture->spTexture, CacheEntryIt->second.Location
+  );
 }
 
 // ############################################################################################# //
@@ -162,26 +186,94 @@ TextureCache::CacheSlot TextureCache::cache(const shared_ptr<Surface> &spSurface
     // If it fits, place it in the cache
     else
       CacheEntryIt = addToCache(spSurface);
+
+  } else {
+    ++m_Statistics.nHits;
   }
 
   // Return a valid cache slot
-  return CacheSlot(CacheEntryIt->second.spCacheTexture, CacheEntryIt->second.Location);
+  touchEntry(CacheEntryIt);
+  return CacheSlot(
+    CacheEntryIt->second.spSharedTexture->spTexture, CacheEntryIt->second.Location
+  );
 }
 
 // ############################################################################################# //
-// # Nuclex::Video::TextureCache::flush()                                                      # //
+// # Nuclex::Video::TextureCache::release()                                                    # //
+// ############################################################################################# //
+/** Removes an object from the cache. Its space on the cache texture is available
+    for other objects right away, so an object should not be released while vertices
+    using its cache slot are still waiting to be drawn.
+
+    @param  ID  Cache id of the object to remove
+*/
+void TextureCache::release(Cacheable::CacheID ID) {
+  CacheEntryMap::iterator CacheEntryIt = m_CacheEntries.find(ID);
+  if(CacheEntryIt != m_CacheEntries.end())
+    removeEntry(CacheEntryIt);
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::touch()                                                      # //
 // ############################################################################################# //
-/** Cleans the cache, throwing out any objects not needed anymore
+/** Marks an object as being used in the current frame, which protects it from eviction
+    just like looking it up through cache() would. Meant for users which keep their
+    cache slots around as long as the cache's generation doesn't change.
+
+    @param  ID  Cache id of the object that is being used
+*/
+void TextureCache::touch(Cacheable::CacheID ID) {
+  CacheEntryMap::iterator CacheEntryIt = m_CacheEntries.find(ID);
+  if(CacheEntryIt != m_CacheEntries.end())
+    touchEntry(CacheEntryIt);
+}
 
-    @todo Cache textures with a use_count of 1 after cleaning should be destroyed
-    @todo Maybe even the textures should be removed and the cache list be cleared ?
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::beginFrame()                                                 # //
+// ############################################################################################# //
+/** Advances the cache to the next frame. Objects looked up since the last call are
+    considered in use and will neither be evicted nor moved until the next frame.
+    Also moves a few objects off sparsely populated cache textures so the textures
+    can eventually be released.
+*/
+void TextureCache::beginFrame() {
+  ++m_nFrame;
+  defragment();
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::flush()                                                      # //
+// ############################################################################################# //
+/** Cleans the cache, throwing out all cached objects and releasing all but one
+    of the cache textures
 */
 void TextureCache::flush() {
+  ++m_nGeneration;
   m_CacheEntries.clear();
+  m_UsageList.clear();
   m_CacheTextures.clear();
   appendSharedTexture();
 }
 
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::getStatistics()                                              # //
+// ############################################################################################# //
+/** Retrieves the current usage statistics of the cache
+
+    @return The cache's usage statistics
+*/
+TextureCache::Statistics TextureCache::getStatistics() const {
+  Statistics CurrentStatistics(m_Statistics);
+  CurrentStatistics.nTextureCount = m_CacheTextures.size();
+  CurrentStatistics.nEntryCount = m_CacheEntries.size();
+  CurrentStatistics.nTotalArea = m_CacheTextures.size() * m_Resolution.X * m_Resolution.Y;
+  CurrentStatistics.nUsedArea = 0;
+  for(size_t Index = 0; Index < m_CacheTextures.size(); ++Index)
+    CurrentStatistics.nUsedArea += m_CacheTextures[Index]->Packer.getUsedArea();
+
+  return CurrentStatistics;
+}
+
 // ############################################################################################# //
 // # Nuclex::Video::TextureCache::addToCache()                                                 # //
 // ############################################################################################# //
@@ -194,36 +286,242 @@ void TextureCache::flush() {
 TextureCache::CacheEntryMap::iterator TextureCache::addToCache(
   const shared_ptr<Surface> &spSurface
 ) {
-  // Find a free location for the surface within the current cache texture
-  Point2<size_t> Location = m_spCurrentTexture->Packer.placeRectangle(spSurface->getSize());
-  if(Location == m_Resolution) {
-    // If it doesn't fit anymore, try using a new cache texture
-    appendSharedTexture();
-    Location = m_spCurrentTexture->Packer.placeRectangle(spSurface->getSize());
-  }
+  // Find a free location for the surface on one of the cache textures
+  Point2<size_t> Position;
+  shared_ptr<SharedTexture> spSharedTexture = allocate(spSurface->getSize(), Position);
+  ScopeGuard Release_Rectangle = ::MakeObjGuard(
+    spSharedTexture->Packer, &SharedTexture::RectanglePacker::releaseRectangle,
+    Position, spSurface->getSize()
+  );
   
   // Copy the surface pixels onto the cache texture
-  spSurface->blitTo(m_spCurrentTexture->spTexture, Location);
+  spSurface->blitTo(spSharedTexture->spTexture, Position);
+
+  Release_Rectangle.Dismiss();
+  return addEntry(
+    spSurface->getUniqueID(), spSurface, true, spSharedTexture, Position, spSurface->getSize()
+  );
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::allocate()                                                   # //
+// ############################################################################################# //
+/** Finds a free location for an object on the cache textures. If all cache textures
+    are full and no more textures may be created, the least recently used objects are
+    evicted until the object fits. Only if all objects are in use by the current frame,
+    the cache is allowed to create more textures than its limit.
+
+    @param  Size      Size of the object to find room for
+    @param  Position  Receives the position of the object on the cache texture
+    @return The cache texture on which the object was placed
+*/
+shared_ptr<TextureCache::SharedTexture> TextureCache::allocate(
+  const Point2<size_t> &Size, Point2<size_t> &Position
+) {
+  // Try to fit the object into the free space of the existing cache textures
+  for(SharedTextureVector::iterator TextureIt = m_CacheTextures.begin();
+      TextureIt != m_CacheTextures.end();
+      ++TextureIt) {
+    Position = (*TextureIt)->Packer.placeRectangle(Size);
+    if(Position != m_Resolution)
+      return *TextureIt;
+  }
+
+  // Create another cache texture as long as the limit hasn't been reached
+  if(m_CacheTextures.size() < m_nMaxTextureCount) {
+    appendSharedTexture();
+    Position = m_CacheTextures.back()->Packer.placeRectangle(Size);
+    return m_CacheTextures.back();
+  }
 
+  // Evict the least recently used objects until there is enough room. Objects used in
+  // the current frame may still be referenced by vertices waiting to be drawn.
+  while(!m_UsageList.empty()) {
+    CacheEntryMap::iterator CacheEntryIt = m_CacheEntries.find(m_UsageList.back());
+    if(CacheEntryIt->second.nLastUsedFrame == m_nFrame)
+      break;
+
+    shared_ptr<SharedTexture> spSharedTexture = CacheEntryIt->second.spSharedTexture;
+    removeEntry(CacheEntryIt);
+    ++m_Statistics.nEvictions;
+
+    Position = spSharedTexture->Packer.placeRectangle(Size);
+    if(Position != m_Resolution)
+      return spSharedTexture;
+  }
+
+  // Everything is in use, so the cache has to grow beyond its limit
+  appendSharedTexture();
+  Position = m_CacheTextures.back()->Packer.placeRectangle(Size);
+  return m_CacheTextures.back();
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::addEntry()                                                   # //
+// ############################################################################################# //
+/** Creates the cache entry for an object that has been placed on a cache texture
+
+    @param  ID               Cache id of the object
+    @param  wpSurface        Surface the object was copied from, if any
+    @param  bHasSurface      Whether the object was copied from a surface
+    @param  spSharedTexture  Cache texture holding the object
+    @param  Position         Position of the object on the cache texture
+    @param  Size             Size of the object
+    @return An iterator to the new cache entry
+*/
+TextureCache::CacheEntryMap::iterator TextureCache::addEntry(
+  Cacheable::CacheID ID, const weak_ptr<void> &wpSurface, bool bHasSurface,
+  const shared_ptr<SharedTexture> &spSharedTexture,
+  const Point2<size_t> &Position, const Point2<size_t> &Size
+) {
   // Add the cache entry into the internet list and return its the iterator
-  return m_CacheEntries.insert(CacheEntryMap::value_type(
-    spSurface->getUniqueID(),
-    CacheEntry(
-      spSurface,
-      m_spCurrentTexture->spTexture,
-      Box2<float>(
-        Point2<float>(Location, StaticCastTag()) / Point2<float>(m_Resolution, StaticCastTag()),
-        Point2<float>(Location + spSurface->getSize(), StaticCastTag()) /
-          Point2<float>(m_Resolution, StaticCastTag())
-      )
-    )
+  CacheEntryMap::iterator CacheEntryIt = m_CacheEntries.insert(CacheEntryMap::value_type(
+    ID, CacheEntry(wpSurface, bHasSurface, spSharedTexture, Position, Size)
   )).first;
+
+  CacheEntryIt->second.Location = locationFromPosition(Position, Size, m_Resolution);
+  CacheEntryIt->second.UsageIt = m_UsageList.insert(m_UsageList.begin(), ID);
+  ++spSharedTexture->nEntryCount;
+  ++m_Statistics.nMisses;
+
+  return CacheEntryIt;
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::removeEntry()                                                # //
+// ############################################################################################# //
+/** Removes a cache entry and returns its space to the cache texture
+
+    @param  CacheEntryIt  Cache entry to remove
+*/
+void TextureCache::removeEntry(CacheEntryMap::iterator CacheEntryIt) {
+  CacheEntry &Entry = CacheEntryIt->second;
+
+  Entry.spSharedTexture->Packer.releaseRectangle(Entry.Position, Entry.Size);
+  --Entry.spSharedTexture->nEntryCount;
+
+  m_UsageList.erase(Entry.UsageIt);
+  m_CacheEntries.erase(CacheEntryIt);
+  ++m_nGeneration;
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::touchEntry()                                                 # //
+// ############################################################################################# //
+/** Stamps a cache entry with the current frame and moves it to the front of
+    the usage list
+
+    @param  CacheEntryIt  Cache entry that has been used
+*/
+void TextureCache::touchEntry(CacheEntryMap::iterator CacheEntryIt) {
+  CacheEntryIt->second.nLastUsedFrame = m_nFrame;
+  m_UsageList.splice(m_UsageList.begin(), m_UsageList, CacheEntryIt->second.UsageIt);
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::defragment()                                                 # //
+// ############################################################################################# //
+/** Moves objects from the most sparsely populated cache texture to the free space on
+    the other cache textures. Only a few objects are moved per call, so the work is
+    spread over several frames. Once a cache texture is empty, it will be released.
+*/
+void TextureCache::defragment() {
+  if(m_CacheTextures.size() < 2)
+    return;
+
+  // Find the cache texture with the fewest used pixels
+  size_t nSparsest = 0;
+  for(size_t Index = 1; Index < m_CacheTextures.size(); ++Index)
+    if(m_CacheTextures[Index]->Packer.getUsedArea() <
+       m_CacheTextures[nSparsest]->Packer.getUsedArea())
+      nSparsest = Index;
+
+  shared_ptr<SharedTexture> spSparsest = m_CacheTextures[nSparsest];
+  size_t nThresholdArea = static_cast<size_t>(
+    m_Resolution.X * m_Resolution.Y * DefragmentationThreshold
+  );
+  if(spSparsest->Packer.getUsedArea() > nThresholdArea)
+    return;
+
+  size_t nRelocations = 0;
+  CacheIDList::iterator UsageIt = m_UsageList.end();
+  while((spSparsest->nEntryCount > 0) && (UsageIt != m_UsageList.begin())) {
+    CacheEntryMap::iterator CacheEntryIt = m_CacheEntries.find(*--UsageIt);
+    CacheEntry &Entry = CacheEntryIt->second;
+    if(Entry.spSharedTexture != spSparsest)
+      continue;
+
+    // Surfaces which no longer exist can't be looked up again, so just drop them
+    if(Entry.bHasSurface && Entry.wpSurface.expired()) {
+      ++UsageIt;
+      removeEntry(CacheEntryIt);
+      continue;
+    }
+
+    if(nRelocations == MaxRelocationsPerFrame)
+      break;
+
+    // Look for room on one of the other cache textures
+    Point2<size_t> Position;
+    shared_ptr<SharedTexture> spTarget;
+    for(size_t Index = 0; Index < m_CacheTextures.size(); ++Index) {
+      if(Index != nSparsest) {
+        Position = m_CacheTextures[Index]->Packer.placeRectangle(Entry.Size);
+        if(Position != m_Resolution) {
+          spTarget = m_CacheTextures[Index];
+          break;
+        }
+      }
+    }
+
+    // If the other textures are full, try again in the next frame
+    if(!spTarget)
+      break;
+
+    { ScopeGuard Release_Rectangle = ::MakeObjGuard(
+        spTarget->Packer, &SharedTexture::RectanglePacker::releaseRectangle,
+        Position, Entry.Size
+      );
+
+      Surface::LockInfo Source = spSparsest->spTexture->lock(
+        Surface::LM_READ, Box2<long>(Entry.Position, Entry.Position + Entry.Size)
+      );
+      ScopeGuard Unlock_Source = ::MakeObjGuard(
+        *spSparsest->spTexture.get(), &Surface::unlock
+      );
+
+      Surface::LockInfo Destination = spTarget->spTexture->lock(
+        Surface::LM_WRITE, Box2<long>(Position, Position + Entry.Size)
+      );
+      ScopeGuard Unlock_Destination = ::MakeObjGuard(
+        *spTarget->spTexture.get(), &Surface::unlock
+      );
+
+      Surface::blit(Destination, Source);
+      Release_Rectangle.Dismiss();
+    }
+
+    spSparsest->Packer.releaseRectangle(Entry.Position, Entry.Size);
+    --spSparsest->nEntryCount;
+    ++spTarget->nEntryCount;
+
+    Entry.spSharedTexture = spTarget;
+    Entry.Position = Position;
+    Entry.Location = locationFromPosition(Position, Entry.Size, m_Resolution);
+
+    ++m_Statistics.nRelocations;
+    ++m_nGeneration;
+    ++nRelocations;
+  }
+
+  if(spSparsest->nEntryCount == 0)
+    m_CacheTextures.erase(m_CacheTextures.begin() + nSparsest);
 }
 
 // ############################################################################################# //
 // # Nuclex::Video::TextureCache::appendSharedTexture()                                        # //
 // ############################################################################################# //
-/** Appends a new shared texture to the cache. Called when the current cache texture is
+/** Appends a new shared texture to the cache. Called when the cache textures are
     full and another texture is required to place a new object on
 */
 void TextureCache::appendSharedTexture() {
@@ -232,8 +530,6 @@ void TextureCache::appendSharedTexture() {
       m_spVideoDevice->createTexture(m_Resolution, VideoDevice::AC_BLEND)
     ))
   );
-
-  m_spCurrentTexture = m_CacheTextures.back();
 }
 
 // ############################################################################################# //
@@ -245,16 +541,16 @@ void TextureCache::appendSharedTexture() {
 */
 TextureCache::SharedTexture::RectanglePacker::RectanglePacker(const Point2<size_t> &Size) :
   m_Size(Size),
-  m_lCurrentLine(0),
-  m_lMaxHeight(0),
-  m_lXPosition(0) {}
+  m_nUsedArea(0) {
+  m_FreeRectangles.push_back(FreeRectangle(Point2<size_t>(0, 0), m_Size));
+}
 
 // ############################################################################################# //
 // # Nuclex::Video::TextureCache::SharedTexture::RectanglePacker::placeRectangle()             # //
 // ############################################################################################# //
 /** Places a rectangle in the packing area. If the packing area is too full to place the
-    rectangle, the size of the packing area will be returned to indicate that a new
-    shared texture should be created by the cache
+    rectangle, the size of the packing area will be returned to indicate that the
+    rectangle has to go onto another shared texture
     
     @param  Size  Size of the rectangle to put in the packing area
     @return The location at which the rectangle was placed
@@ -265,25 +561,131 @@ Point2<size_t> TextureCache::SharedTexture::RectanglePacker::placeRectangle(
   // Filtering out rectangles that are too large should be handled by our owner
   assert((Size.X <= m_Size.X) && (Size.Y <= m_Size.Y));
 
-  // Do we have to start a new line ?
-  if((m_lXPosition + Size.X) > m_Size.X) {
-    size_t NewLine = m_lCurrentLine + m_lMaxHeight;
+  // Look for the free rectangle which leaves the least space along its shorter side
+  size_t nBest = m_FreeRectangles.size();
+  size_t nBestFit = static_cast<size_t>(-1);
+  for(size_t Index = 0; Index < m_FreeRectangles.size(); ++Index) {
+    const FreeRectangle &Free = m_FreeRectangles[Index];
+    if((Free.Size.X >= Size.X) && (Free.Size.Y >= Size.Y)) {
+      size_t nFit = std::min(Free.Size.X - Size.X, Free.Size.Y - Size.Y);
+      if(nFit < nBestFit) {
+        nBest = Index;
+        nBestFit = nFit;
+      }
+    }
+  }
+
+  if(nBest == m_FreeRectangles.size())
+    return m_Size;
 
-    // Check if it will fit then
-    if((NewLine + Size.Y) > m_Size.Y)
-      return m_Size;
+  FreeRectangle Free = m_FreeRectangles[nBest];
+  m_FreeRectangles[nBest] = m_FreeRectangles.back();
+  m_FreeRectangles.pop_back();
 
-    // If it fits in the new line, make the advancement to the next line
-    m_lCurrentLine = NewLine;
-    m_lMaxHeight = 0;
-    m_lXPosition = 0;
+  // Split the remaining space along the shorter leftover side, which keeps the
+  // larger of the two new free rectangles as large as possible
+  Point2<size_t> Leftover = Free.Size - Size;
+  Point2<size_t> RightSize, BottomSize;
+  if(Leftover.X < Leftover.Y) {
+    RightSize = Point2<size_t>(Leftover.X, Size.Y);
+    BottomSize = Point2<size_t>(Free.Size.X, Leftover.Y);
+  } else {
+    RightSize = Point2<size_t>(Leftover.X, Free.Size.Y);
+    BottomSize = Point2<size_t>(Size.X, Leftover.Y);
+  }
+
+  if((RightSize.X > 0) && (RightSize.Y > 0))
+    m_FreeRectangles.push_back(FreeRectangle(
+      Point2<size_t>(Free.Location.X + Size.X, Free.Location.Y), RightSize
+    ));
+  if((BottomSize.X > 0) && (BottomSize.Y > 0))
+    m_FreeRectangles.push_back(FreeRectangle(
+      Point2<size_t>(Free.Location.X, Free.Location.Y + Size.Y), BottomSize
+    ));
+
+  m_nUsedArea += Size.X * Size.Y;
+  return Free.Location;
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::SharedTexture::RectanglePacker::releaseRectangle()           # //
+// ############################################################################################# //
+/** Returns the space of a previously placed rectangle to the packing area
+
+    @param  Location  Location at which the rectangle was placed
+    @param  Size      Size of the rectangle
+*/
+void TextureCache::SharedTexture::RectanglePacker::releaseRectangle(
+  const Point2<size_t> &Location, const Point2<size_t> &Size
+) {
+  m_nUsedArea -= Size.X * Size.Y;
+  if(m_nUsedArea == 0) {
+    clear();
+    return;
   }
-  
-  // Save the placement of the rectangle and advance to the right
-  Point2<long> Position(static_cast<long>(m_lXPosition), static_cast<long>(m_lCurrentLine));
-  m_lXPosition += Size.X;
-  if(Size.Y > m_lMaxHeight)
-    m_lMaxHeight = Size.Y;
 
-  return Position;
+  if((Size.X > 0) && (Size.Y > 0)) {
+    m_FreeRectangles.push_back(FreeRectangle(Location, Size));
+    mergeFreeRectangles();
+  }
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::SharedTexture::RectanglePacker::clear()                      # //
+// ############################################################################################# //
+/** Releases all rectangles, making the whole packing area available again
+*/
+void TextureCache::SharedTexture::RectanglePacker::clear() {
+  m_FreeRectangles.clear();
+  m_FreeRectangles.push_back(FreeRectangle(Point2<size_t>(0, 0), m_Size));
+  m_nUsedArea = 0;
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::TextureCache::SharedTexture::RectanglePacker::mergeFreeRectangles()        # //
+// ############################################################################################# //
+/** Combines free rectangles which share a complete edge into larger ones, so space
+    released by neighboring rectangles can hold larger rectangles again
+*/
+void TextureCache::SharedTexture::RectanglePacker::mergeFreeRectangles() {
+  bool bMerged = true;
+  while(bMerged) {
+    bMerged = false;
+
+    for(size_t First = 0; (First < m_FreeRectangles.size()) && !bMerged; ++First) {
+      for(size_t Second = First + 1; Second < m_FreeRectangles.size(); ++Second) {
+        FreeRectangle &A = m_FreeRectangles[First];
+        const FreeRectangle &B = m_FreeRectangles[Second];
+
+        // Side by side with the same height
+        if((A.Location.Y == B.Location.Y) && (A.Size.Y == B.Size.Y)) {
+          if(A.Location.X + A.Size.X == B.Location.X) {
+            A.Size.X += B.Size.X;
+            bMerged = true;
+          } else if(B.Location.X + B.Size.X == A.Location.X) {
+            A.Location.X = B.Location.X;
+            A.Size.X += B.Size.X;
+            bMerged = true;
+          }
+
+        // On top of each other with the same width
+        } else if((A.Location.X == B.Location.X) && (A.Size.X == B.Size.X)) {
+          if(A.Location.Y + A.Size.Y == B.Location.Y) {
+            A.Size.Y += B.Size.Y;
+            bMerged = true;
+          } else if(B.Location.Y + B.Size.Y == A.Location.Y) {
+            A.Location.Y = B.Location.Y;
+            A.Size.Y += B.Size.Y;
+            bMerged = true;
+          }
+        }
+
+        if(bMerged) {
+          m_FreeRectangles[Second] = m_FreeRectangles.back();
+          m_FreeRectangles.pop_back();
+          break;
+        }
+      }
+    }
+  }
 }
@@ -13,13 +13,20 @@
 #include "Nuclex/Video/PixelFormat.h"
 
 #include "ScopeGuard/ScopeGuard.h"
+#include <algorithm>
 
 using namespace Nuclex;
 using namespace Nuclex::Video;
 using namespace Nuclex::Text;
+using namespace Nuclex::Support;
 
 namespace {
 
+/// Number of laid out text strings above which unused ones are discarded
+const size_t MaxTextRunCount = 512;
+/// Default time per frame that may be spent uploading prewarmed glyphs (microseconds)
+const size_t DefaultUploadBudget = 2000;
+
 // ############################################################################################# //
 // # getVerticesPerPrimitive()                                                                 # //
 // ############################################################################################# //
@@ -55,7 +62,9 @@ VertexDrawer::VertexDrawer(const shared_ptr<VideoDevice> &spVideoDevice) :
   m_spVideoDevice(spVideoDevice),
   m_TextureCache(spVideoDevice),
   m_VertexCache(spVideoDevice),
-  m_spRenderStates(spVideoDevice->createRenderStates()) {
+  m_spRenderStates(spVideoDevice->createRenderStates()),
+  m_nFrame(0),
+  m_UploadBudget(DefaultUploadBudget) {
   
   for(size_t PrimitiveIndex = 0; PrimitiveIndex < 6; ++PrimitiveIndex) {
     m_Primitive[PrimitiveIndex].Position.Z = 1.0f;
@@ -77,6 +86,21 @@ VertexDrawer::VertexDrawer(const shared_ptr<VideoDevice> &spVideoDevice) :
 // ############################################################################################# //
 void VertexDrawer::begin(const shared_ptr<VideoDevice::RenderingContext> &spRC) {
   m_ScreenSize = Point2<float>(m_spVideoDevice->getDisplayMode().Resolution, StaticCastTag());
+  m_TextureCache.beginFrame();
+  ++m_nFrame;
+  uploadPendingGlyphs();
+
+  // Once too many text strings have accumulated, discard the ones which were not
+  // drawn in the previous frame, otherwise changing text would pile up forever
+  if(m_TextRuns.size() > MaxTextRunCount) {
+    TextRunMap::iterator RunIt = m_TextRuns.begin();
+    while(RunIt != m_TextRuns.end()) {
+      if(RunIt->second.nLastUsedFrame + 1 < m_nFrame)
+        m_TextRuns.erase(RunIt++);
+      else
+        ++RunIt;
+    }
+  }
 
   while(m_Offsets.size())
     m_Offsets.pop();
@@ -234,68 +258,234 @@ void VertexDrawer::drawText(const shared_ptr<Text::Font> &spFont,
                             const Point2<float> &Position,
                             const Color &TextColor,
                             Text::Font::Alignment eAlignment) {
+  // The key only refers to sText, the text is copied when a new run is inserted
+  TextRunKey Key(spFont->getUniqueID(), sText, eAlignment);
+  TextRunMap::iterator RunIt = m_TextRuns.find(Key);
+  if(RunIt == m_TextRuns.end()) {
+    RunIt = m_TextRuns.insert(TextRunMap::value_type(Key, TextRun())).first;
+    TextRun &Run = RunIt->second;
+
+    Box2<long> Region = spFont->measureRegion(sText);
+
+    if((eAlignment & Font::A_HCENTER) == Font::A_HCENTER)
+      Run.Origin.X = -((Region.getWidth() / 2) + Region.TL.X);
+    else if(eAlignment & Font::A_LEFT)
+      Run.Origin.X = -Region.TL.X;
+    else if(eAlignment & Font::A_RIGHT)
+      Run.Origin.X = -Region.BR.X;
+
+    if((eAlignment & Font::A_VCENTER) == Font::A_VCENTER)
+      Run.Origin.Y = -((Region.getHeight() / 2) + Region.TL.Y);
+    else if(eAlignment & Font::A_TOP)
+      Run.Origin.Y = -Region.TL.Y;
+    else if(eAlignment & Font::A_BOTTOM)
+      Run.Origin.Y = -Region.BR.Y;
+
+    layoutText(Run, spFont, sText);
+
+  // If glyphs have been moved or evicted, the cache slots need to be looked up again
+  } else if(RunIt->second.nGeneration != m_TextureCache.getGeneration()) {
+    layoutText(RunIt->second, spFont, sText);
+
+  // Otherwise, keep the glyphs from being evicted while their quads are queued
+  } else if(RunIt->second.nLastUsedFrame != m_nFrame) {
+    const TextRun::CacheIDVector &CacheIDs = RunIt->second.CacheIDs;
+    for(size_t Index = 0; Index < CacheIDs.size(); ++Index)
+      m_TextureCache.touch(CacheIDs[Index]);
+  }
+
+  TextRun &Run = RunIt->second;
+  Run.nLastUsedFrame = m_nFrame;
+  if(Run.Vertices.empty())
+    return;
+
+  // Move the text run's quads to the drawing position
+  float fX = static_cast<float>(Math::round<long>(Position.X)) + m_Offsets.top().TL.X;
+  float fY = static_cast<float>(Math::round<long>(Position.Y)) + m_Offsets.top().TL.Y;
+  unsigned long nColor = ARGB_8_8_8_8::pixelFromColor(TextColor);
+
+  m_TextVertices.assign(Run.Vertices.begin(), Run.Vertices.end());
+  for(size_t Index = 0; Index < m_TextVertices.size(); ++Index) {
+    m_TextVertices[Index].Position.X += fX;
+    m_TextVertices[Index].Position.Y += fY;
+    m_TextVertices[Index].Color = nColor;
+  }
+
+  for(size_t Index = 0; Index < Run.Batches.size(); ++Index)
+    m_VertexCache.addPrimitives(
+      &m_TextVertices[Run.Batches[Index].nStart], Run.Batches[Index].nCount,
+      VideoDevice::RenderingContext::PT_TRIANGLELIST,
+      Run.Batches[Index].spTexture
+    );
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::VertexDrawer::layoutText()                                                 # //
+// ############################################################################################# //
+/** Places the glyphs of a text string in the texture cache and builds the quads for
+    drawing them. The quads are relative to the drawing position.
+
+    @param  Run     Text run which will receive the quads
+    @param  spFont  Font to use for the text
+    @param  sText   Text string to lay out
+*/
+void VertexDrawer::layoutText(
+  TextRun &Run, const shared_ptr<Text::Font> &spFont, const wstring &sText
+) {
+  RealizedFont &Font = getRealizedFont(spFont);
+
+  Run.Vertices.clear();
+  Run.Batches.clear();
+  Run.CacheIDs.clear();
+
+  VideoDevice::PretransformedVertex Vertex;
+  Vertex.Position.Z = 1.0f;
+  Vertex.RHW = 1;
+  Vertex.Color = 0xFFFFFFFF;
+  Vertex.Specular = 0;
+
+  // Build a quad for each character
+  Point2<long> Pen = Run.Origin;
+  for(string::size_type Pos = 0; Pos < sText.length(); ++Pos) {
+    RealizedFont::Character &Char = Font.getCharacter(spFont.get(), sText[Pos]);
+
+    if(Char.Metrics.Size.X > 0 || Char.Metrics.Size.Y > 0) {
+      TextureCache::CacheSlot CachedCharacter = cacheCharacter(spFont.get(), Char);
+      Run.CacheIDs.push_back(Char.CacheID);
+
+      if(Run.Batches.empty() || (Run.Batches.back().spTexture != CachedCharacter.first))
+        Run.Batches.push_back(TextRun::Batch(CachedCharacter.first, Run.Vertices.size()));
+
+      Box2<float> Region(
+        static_cast<float>(Pen.X - Char.Metrics.Hotspot.X),
+        static_cast<float>(Pen.Y - Char.Metrics.Hotspot.Y),
+        static_cast<float>(Pen.X - Char.Metrics.Hotspot.X + Char.Metrics.Size.X),
+        static_cast<float>(Pen.Y - Char.Metrics.Hotspot.Y + Char.Metrics.Size.Y)
+      );
+      const Box2<float> &Tex = CachedCharacter.second;
+
+      // Same vertex order as drawBox() uses
+      const float pCorners[6][4] = {
+        { Region.TL.X, Region.TL.Y, Tex.TL.X, Tex.TL.Y },
+        { Region.TL.X, Region.BR.Y, Tex.TL.X, Tex.BR.Y },
+        { Region.BR.X, Region.BR.Y, Tex.BR.X, Tex.BR.Y },
+        { Region.BR.X, Region.BR.Y, Tex.BR.X, Tex.BR.Y },
+        { Region.BR.X, Region.TL.Y, Tex.BR.X, Tex.TL.Y },
+        { Region.TL.X, Region.TL.Y, Tex.TL.X, Tex.TL.Y }
+      };
+      for(size_t Corner = 0; Corner < 6; ++Corner) {
+        Vertex.Position.X = pCorners[Corner][0];
+        Vertex.Position.Y = pCorners[Corner][1];
+        Vertex.TexCoord.X = pCorners[Corner][2];
+        Vertex.TexCoord.Y = pCorners[Corner][3];
+        Run.Vertices.push_back(Vertex);
+      }
+      Run.Batches.back().nCount += 6;
+    }
+
+    // Advance to the next character's position
+    Pen += Char.Metrics.Advance;
+  }
+
+  // Each glyph only needs to be touched once per frame
+  std::sort(Run.CacheIDs.begin(), Run.CacheIDs.end());
+  Run.CacheIDs.erase(std::unique(Run.CacheIDs.begin(), Run.CacheIDs.end()), Run.CacheIDs.end());
+
+  Run.nGeneration = m_TextureCache.getGeneration();
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::VertexDrawer::prewarmText()                                                # //
+// ############################################################################################# //
+/** Uploads the glyphs of the specified characters to the texture cache, so text using
+    them can be drawn without stalling. The upload is spread over the next frames.
+    If the glyphs are being prepared by Font::prewarm(), passing its job handle
+    delays the upload until the glyphs are ready.
+
+    @param  spFont       Font whose glyphs to upload
+    @param  sCharacters  Character set or sample text whose glyphs to upload
+    @param  Ready        Job that needs to finish before the glyphs are uploaded
+*/
+void VertexDrawer::prewarmText(
+  const shared_ptr<Text::Font> &spFont, const wstring &sCharacters,
+  const JobScheduler::JobHandle &Ready
+) {
+  m_PendingGlyphs.push_back(PendingGlyphs(spFont, sCharacters, Ready));
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::VertexDrawer::getRealizedFont()                                            # //
+// ############################################################################################# //
+/** Looks up the realized version of a font
+
+    @param  spFont  Font whose realized version to look up
+    @return The realized font
+*/
+VertexDrawer::RealizedFont &VertexDrawer::getRealizedFont(const shared_ptr<Text::Font> &spFont) {
   RealizedFontMap::iterator FontIt = m_RealizedFonts.find(spFont->getUniqueID());
   if(FontIt == m_RealizedFonts.end()) {
     FontIt = m_RealizedFonts.insert(RealizedFontMap::value_type(
       spFont->getUniqueID(), RealizedFont()
     )).first;
   }
-  
-  Point2<long> AlignedPosition(Math::round<long>(Position.X), Math::round<long>(Position.Y));
-  Box2<long> Region = spFont->measureRegion(sText);
-
-  if((eAlignment & Font::A_HCENTER) == Font::A_HCENTER)
-    AlignedPosition.X -= (Region.getWidth() / 2) + Region.TL.X;
-  else if(eAlignment & Font::A_LEFT)
-    AlignedPosition.X -= Region.TL.X;
-  else if(eAlignment & Font::A_RIGHT)
-    AlignedPosition.X -= Region.BR.X;
-
-  if((eAlignment & Font::A_VCENTER) == Font::A_VCENTER)
-    AlignedPosition.Y -= (Region.getHeight() / 2) + Region.TL.Y;
-  else if(eAlignment & Font::A_TOP)
-    AlignedPosition.Y -= Region.TL.Y;
-  else if(eAlignment & Font::A_BOTTOM)
-    AlignedPosition.Y -= Region.BR.Y;
-
-  // Place each character in the vertex buffer
-  for(string::size_type Pos = 0; Pos < sText.length(); ++Pos) {
-    RealizedFont::Character &Char = FontIt->second.WCharacters[sText[Pos]];
-    
-    // Look up the character
-    if(!Char.bCached) {
-      Char.Code = sText[Pos];
-      Char.CacheID = Cacheable().getUniqueID();
-      Char.Metrics = spFont->getMetrics(sText[Pos]);
-      Char.bCached = true;
-    }
 
-    if(Char.Metrics.Size.X > 0 || Char.Metrics.Size.Y > 0) {
-      TextureCache::CacheSlot CachedCharacter = m_TextureCache.cache(
-        Char.CacheID,
-        Char.Metrics.Size,
-        sigc::bind(
-          &VertexDrawer::updateCachedCharacter,
-          spFont.get(), &Char
-        )
-      );
-      
-      // Draw the character
-      drawBox(
-        Box2<float>(
-          static_cast<float>(AlignedPosition.X - Char.Metrics.Hotspot.X),
-          static_cast<float>(AlignedPosition.Y - Char.Metrics.Hotspot.Y),
-          static_cast<float>(AlignedPosition.X - Char.Metrics.Hotspot.X + Char.Metrics.Size.X),
-          static_cast<float>(AlignedPosition.Y - Char.Metrics.Hotspot.Y + Char.Metrics.Size.Y)
-        ),
-        CachedCharacter.first,
-        CachedCharacter.second.TL,
-        CachedCharacter.second.BR,
-        TextColor
+  return FontIt->second;
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::VertexDrawer::cacheCharacter()                                             # //
+// ############################################################################################# //
+/** Places the glyph of a character in the texture cache
+
+    @param  pFont  Font the character belongs to
+    @param  Char   Character whose glyph to cache
+    @return The cache slot holding the glyph
+*/
+TextureCache::CacheSlot VertexDrawer::cacheCharacter(
+  Text::Font *pFont, RealizedFont::Character &Char
+) {
+  return m_TextureCache.cache(
+    Char.CacheID,
+    Char.Metrics.Size,
+    sigc::bind(
+      &VertexDrawer::updateCachedCharacter,
+      pFont, &Char
+    )
+  );
+}
+
+// ############################################################################################# //
+// # Nuclex::Video::VertexDrawer::uploadPendingGlyphs()                                        # //
+// ############################################################################################# //
+/** Uploads the glyphs queued by prewarmText() until the upload budget for this
+    frame has been used up
+*/
+void VertexDrawer::uploadPendingGlyphs() {
+  if(m_PendingGlyphs.empty())
+    return;
+
+  TimeSpan Deadline = TimeSpan::getRunningTime() + m_UploadBudget;
+  while(!m_PendingGlyphs.empty()) {
+    PendingGlyphs &Pending = m_PendingGlyphs.front();
+
+    // Glyphs that are still being prepared would have to be rendered right here
+    if(Pending.Ready.isValid() && !Pending.Ready.isFinished())
+      return;
+
+    RealizedFont &Font = getRealizedFont(Pending.spFont);
+    while(Pending.nNext < Pending.sCharacters.length()) {
+      if(TimeSpan::getRunningTime() > Deadline)
+        return;
+
+      RealizedFont::Character &Char = Font.getCharacter(
+        Pending.spFont.get(), Pending.sCharacters[Pending.nNext]
       );
+      if(Char.Metrics.Size.X > 0 || Char.Metrics.Size.Y > 0)
+        cacheCharacter(Pending.spFont.get(), Char);
+
+      ++Pending.nNext;
     }
 
-    // Advance to the next character's position
-    AlignedPosition += Char.Metrics.Advance;
+    m_PendingGlyphs.pop_front();
   }
 }
@@ -9,6 +9,7 @@
 #include "TerrainPlugin/Scene/TerrainModel.h"
 #include "Direct3D9Plugin/Video/Direct3D9VideoDevice.h"
 #include "Nuclex/Storage/XMLSerializer.h"
+#include "Nuclex/Storage/BinarySerializer.h"
 #include "Nuclex/Storage/ResourceSet.h"
 #include "Nuclex/Video/VideoServer.h"
 #include "Nuclex/Video/Image.h"
@@ -31,9 +32,13 @@ TerrainModel::TerrainModel(const string &sTerrainDescription) :
     Kernel::getInstance().getTextServer()
   ) {
 
-  XMLSerializer TerrainDescription(sTerrainDescription);
+  shared_ptr<Serializer> spTerrainDescription;
+  if(BinarySerializer::isBinary(sTerrainDescription))
+    spTerrainDescription = shared_ptr<Serializer>(new BinarySerializer(sTerrainDescription));
+  else
+    spTerrainDescription = shared_ptr<Serializer>(new XMLSerializer(sTerrainDescription));
 
-  shared_ptr<Serializer> spTerrain = TerrainDescription.openScope("terrain");
+  shared_ptr<Serializer> spTerrain = spTerrainDescription->openScope("terrain");
   
   { shared_ptr<Serializer> spResources = spTerrain->openScope("resources", true);
     if(spResources)
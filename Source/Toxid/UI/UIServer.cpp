@@ -12,6 +12,7 @@
 #include "Nuclex/Input/InputServer.h"
 #include "Nuclex/GUI/GUIServer.h"
 #include "Nuclex/Storage/XMLSerializer.h"
+#include "Nuclex/Storage/BinarySerializer.h"
 #include "Nuclex/Storage/StorageServer.h"
 #include "Nuclex/Video/Image.h"
 #include "Nuclex/Video/VertexCache.h"
@@ -53,12 +54,20 @@ UIServer::UIServer(const string &sThemeFile) :
   ),
   m_VertexDrawer(Main::getInstance().getVideoDevice()) {
 
-  Storage::XMLSerializer Theme(stringFromStream(
+  string sTheme = stringFromStream(
     Kernel::getInstance().getStorageServer()->openStream(
       sThemeFile, Storage::Stream::AM_READ
     )
-  ));
-  m_Theme.load(Theme.openScope("theme"));
+  );
+
+  // Themes can be either XML or converted to the binary serializer format
+  shared_ptr<Storage::Serializer> spTheme;
+  if(Storage::BinarySerializer::isBinary(sTheme))
+    spTheme = shared_ptr<Storage::Serializer>(new Storage::BinarySerializer(sTheme));
+  else
+    spTheme = shared_ptr<Storage::Serializer>(new Storage::XMLSerializer(sTheme));
+
+  m_Theme.load(spTheme->openScope("theme"));
 
   // Assign a cursor to be used 
   shared_ptr<Video::Image> spCursorImage = Kernel::getInstance().getVideoServer()->loadImage(
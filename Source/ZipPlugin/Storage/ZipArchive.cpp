@@ -8,6 +8,7 @@
 //  //
 #include "ZipPlugin/Storage/ZipArchive.h"
 #include "ZipPlugin/Storage/ZipStream.h"
+#include "Nuclex/Storage/FileStream.h"
 #include "Nuclex/Platform.h"
 
 #ifdef NUCLEX_WIN32
@@ -16,10 +17,36 @@
 #endif // NUCLEX_WIN32
 
 #include <map>
+#include <vector>
+#include <cstdio>
 
 using namespace Nuclex;
 using namespace Nuclex::Storage;
 
+namespace {
+
+/// General purpose flag indicating an encrypted file
+const unsigned short EncryptedFlag = 0x0001;
+
+/// Retrieve the stamp identifying the current version of a file
+bool getFileStamp(const string &sFile, ZipIndex::Stamp &FileStamp) {
+#ifdef NUCLEX_WIN32
+  WIN32_FILE_ATTRIBUTE_DATA FileData;
+  if(!::GetFileAttributesEx(sFile.c_str(), GetFileExInfoStandard, &FileData))
+    return false;
+
+  FileStamp.nSizeLow = FileData.nFileSizeLow;
+  FileStamp.nSizeHigh = FileData.nFileSizeHigh;
+  FileStamp.nTimeLow = FileData.ftLastWriteTime.dwLowDateTime;
+  FileStamp.nTimeHigh = FileData.ftLastWriteTime.dwHighDateTime;
+  return true;
+#else
+  #error Not implemented yet
+#endif
+}
+
+} // namespace
+
 //  //
 //  Nuclex::Storage::ZipArchive::ZipDirectory                                                  //
 //  //
@@ -161,8 +188,8 @@ class ZipArchive::SubZipArchive :
   public Archive {
   public:
     /// Constructor
-    SubZipArchive(const ZipArchive &ZipArchive, Zipex::ZipArchive &ZipexArchive,
-                  const ZipDirectory &Directory, const string &sPath);
+    SubZipArchive(const ZipArchive &ZipArchive, const ZipDirectory &Directory,
+                  const string &sPath);
     /// Destructor
     virtual ~SubZipArchive();
 
@@ -196,28 +223,96 @@ class ZipArchive::SubZipArchive :
 
   private:
     const ZipArchive   &m_ZipArchive;                 ///< Zip storage
-    Zipex::ZipArchive  &m_ZipexArchive;               ///< Zip archive
     const ZipDirectory &m_Directory;                  ///< Zip directory
     string              m_sPath;                      ///< Storage path
 };  
 
+// ############################################################################################# //
+// # Nuclex::Storage::ZipArchive::ArchiveStream                                                # //
+// ############################################################################################# //
+/// Zip archive file
+/** Provides zipex and the ZipInflaters with access to the archive file.
+    Both share a single file handle, so every read seeks and reads as one
+    operation guarded by a mutex. The location used by readData() is kept
+    separately, thus readDataAt() calls from other threads don't disturb
+    sequential reads.
+*/
+class ZipArchive::ArchiveStream :
+  public Zipex::Stream {
+  public:
+    /// Constructor
+    ArchiveStream(const string &sFilename) :
+      m_File(sFilename, Nuclex::Storage::Stream::AM_READ),
+      m_nLocation(0) {}
+
+    /// Destructor
+    virtual ~ArchiveStream() {}
+
+  //
+  // Stream implementation
+  //
+  public:
+    /// Get stream size
+    size_t getSize() const { return m_File.getSize(); }
+
+    /// Seek to position
+    void seekTo(size_t nPosition) { m_nLocation = nPosition; }
+
+    /// Get current location
+    size_t getLocation() const { return m_nLocation; }
+
+    /// Read data into buffer
+    size_t readData(void *pBuffer, size_t nLength) {
+      size_t nRead = readDataAt(m_nLocation, pBuffer, nLength);
+      m_nLocation += nRead;
+      return nRead;
+    }
+
+    /// Write data from buffer
+    void writeData(const void *, size_t) {
+      throw NotSupportedException("Nuclex::Storage::ZipArchive::ArchiveStream::writeData()",
+                                  "Writing to Zip files not supported");
+    }
+
+    /// Read from specified location
+    size_t readDataAt(size_t nPosition, void *pBuffer, size_t nLength) {
+      Mutex::ScopedLock Lock(m_Mutex);
+      m_File.seekTo(nPosition);
+      return m_File.readData(pBuffer, nLength);
+    }
+
+  private:
+    FileStream m_File;                                ///< The archive file
+    Mutex      m_Mutex;                               ///< Makes seek and read atomic
+    size_t     m_nLocation;                           ///< Location for sequential reads
+};
+
 // ############################################################################################# //
 // # Nuclex::Storage::ZipArchive::ZipArchive()                                     Constructor # //
 // ############################################################################################# //
 /** Creates a new instance of ZipArchive
+
+    @param  sZIPFile              Zip archive to open
+    @param  sIndexCacheDirectory  Directory in which to cache the archive's
+                                  index. Empty to disable the cache
 */
-ZipArchive::ZipArchive(const string &sZIPFile) :
-  m_ZipArchive(convertPath(sZIPFile, PT_NATIVE)),
+ZipArchive::ZipArchive(const string &sZIPFile, const string &sIndexCacheDirectory) :
+  m_spArchiveStream(new ArchiveStream(convertPath(sZIPFile, PT_NATIVE))),
   m_spDirectory(new ZipDirectory()) {
 
-  Zipex::ZipArchive::FileEnumerator FileEnum = m_ZipArchive.enumFiles();
-  while(FileEnum.next()) {
-    const Zipex::ZippedFile &File = FileEnum.get();
+  loadIndex(convertPath(sZIPFile, PT_NATIVE), sIndexCacheDirectory);
+
+  // Only large files get checkpoints, small ones are decompressed in a single chunk
+  m_CheckpointIndices.resize(m_Index.getEntryCount());
+  for(size_t Index = 0; Index < m_Index.getEntryCount(); ++Index)
+    if(m_Index.getEntry(Index).nSize > ZipInflater::CheckpointSpacing)
+      m_CheckpointIndices[Index].reset(new ZipInflater::CheckpointIndex());
 
+  for(size_t Index = 0; Index < m_Index.getEntryCount(); ++Index) {
     // Put the file into the directory structure 
     ZipDirectory *pDirectory = m_spDirectory.get();
 
-    string sFilename = File.getFilename();
+    string sFilename = m_Index.getPath(Index);
 
     for(;;) {
       string::size_type Pos = sFilename.find_first_of('/');
@@ -243,7 +338,7 @@ ZipArchive::ZipArchive(const string &sZIPFile) :
     // Add the file to the current directory
     if(sFilename.length())
       pDirectory->Files.insert(
-        ZipDirectory::ZipFileMap::value_type(sFilename, File.getSize())
+        ZipDirectory::ZipFileMap::value_type(sFilename, m_Index.getEntry(Index).nSize)
       );
   }
 }
@@ -302,7 +397,7 @@ shared_ptr<Archive> ZipArchive::openArchive(const string &sName, bool bAllowCrea
   }
 
   return shared_ptr<Archive>(
-    new SubZipArchive(*this, m_ZipArchive, DirectoryIt->second, sName)
+    new SubZipArchive(*this, DirectoryIt->second, sName)
   );
 }
 
@@ -341,12 +436,7 @@ shared_ptr<Archive::StreamEnumerator> ZipArchive::enumStreams() const {
     @return The opened stream
 */
 shared_ptr<Stream> ZipArchive::openStream(const string &sName, Stream::AccessMode eMode) {
-  ZipDirectory::ZipFileMap::iterator FileIt = m_spDirectory->Files.find(sName);
-  if(FileIt == m_spDirectory->Files.end())
-    throw CantOpenResourceException("Nuclex::Storage::ZipArchive::openStream()",
-                                    string("The file '") + sName + "' could not be found");
-
-  return shared_ptr<Stream>(new ZipStream(m_ZipArchive.getFile(sName), eMode));
+  return openZippedStream(sName, eMode);
 }
 
 // ############################################################################################# //
@@ -361,6 +451,88 @@ void ZipArchive::deleteStream(const string &sName) {
                               "Deleting files in zip files not supported");
 }
 
+// ############################################################################################# //
+// # Nuclex::Storage::ZipArchive::loadIndex()                                                  # //
+// ############################################################################################# //
+/** Loads the archive's index from the index cache directory. If there
+    is no cached index or the archive has changed since it was cached,
+    the index is built from the archive's central directory and then
+    stored in the cache. Problems with the cache are not fatal, the
+    archive will simply be indexed again the next time.
+
+    @param  sArchive              Native path of the archive
+    @param  sIndexCacheDirectory  Directory holding cached indices, can be empty
+*/
+void ZipArchive::loadIndex(const string &sArchive, const string &sIndexCacheDirectory) {
+  ZipIndex::Stamp ArchiveStamp;
+  if(sIndexCacheDirectory.empty() || !getFileStamp(sArchive, ArchiveStamp)) {
+    m_Index.build(*m_spArchiveStream);
+    return;
+  }
+
+  // Cached indices are named after the CRC of the archive's path
+  char pszCacheName[16];
+  std::sprintf(
+    pszCacheName, "%08lx.zix",
+    static_cast<unsigned long>(getCRC32(sArchive.c_str(), sArchive.length()))
+  );
+  string sCacheFile = convertPath(sIndexCacheDirectory, PT_NATIVE) + "\\" + pszCacheName;
+
+  try {
+    FileStream CacheFile(sCacheFile, Stream::AM_READ);
+    if(m_Index.load(CacheFile, sArchive, ArchiveStamp))
+      return;
+  }
+  catch(const Exception &) {
+    // No usable cached index, fall through and build one
+  }
+
+  m_Index.build(*m_spArchiveStream);
+
+  try {
+    FileStream CacheFile(sCacheFile, Stream::AM_WRITE);
+    m_Index.save(CacheFile, sArchive, ArchiveStamp);
+  }
+  catch(const Exception &) {
+    // Caching the index is optional
+  }
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipArchive::openZippedStream()                                           # //
+// ############################################################################################# //
+/** Opens a zipped file for reading. Stored and deflated files are read
+    through a ZipInflater, anything else is left to zipex, which is only
+    opened when it's needed for the first time.
+
+    @param  sPath  Path of the zipped file within the archive
+    @param  eMode  Access mode for the stream
+    @return The opened stream
+*/
+shared_ptr<Stream> ZipArchive::openZippedStream(const string &sPath, Stream::AccessMode eMode) const {
+  size_t nEntry = m_Index.find(sPath);
+  if(nEntry == ZipIndex::NotFound)
+    throw CantOpenResourceException("Nuclex::Storage::ZipArchive::openZippedStream()",
+                                    string("The file '") + sPath + "' could not be found");
+
+  const ZipIndex::Entry &Entry = m_Index.getEntry(nEntry);
+  bool bDeflated = (Entry.nMethod == Zipex::ZippedFile::CM_DEFLATE);
+  bool bStored = (Entry.nMethod == Zipex::ZippedFile::CM_STORE);
+  if(!(Entry.nFlags & EncryptedFlag) && (bDeflated || bStored)) {
+    std::auto_ptr<ZipInflater> spInflater(new ZipInflater(
+      *m_spArchiveStream, Entry.nHeaderOffset, bDeflated,
+      Entry.nCompressedSize, Entry.nSize, m_CheckpointIndices[nEntry]
+    ));
+    return shared_ptr<Stream>(new ZipStream(spInflater, eMode));
+  }
+
+  Mutex::ScopedLock Lock(m_ZipArchiveMutex);
+  if(!m_spZipArchive.get())
+    m_spZipArchive.reset(new Zipex::ZipArchive(m_spArchiveStream.get()));
+
+  return shared_ptr<Stream>(new ZipStream(m_spZipArchive->getFile(sPath), eMode));
+}
+
 // ############################################################################################# //
 // # Nuclex::Storage::ZipArchive::ZipDirectory::getType()                                      # //
 // ############################################################################################# //
@@ -388,14 +560,12 @@ Archive::ItemType ZipArchive::ZipDirectory::getType(const string &sName) const {
 /** Initializes an instance of SubZipArchive
 
     @param  ZipArchive  ZipArchive this SubZipArchive belongs to
-    @param  UnzipFile   Unzip file handle
     @param  Directory   The directory of this sub storage
     @param  sPath       Path to the sub storage
 */
-ZipArchive::SubZipArchive::SubZipArchive(const ZipArchive &ZipArchive, Zipex::ZipArchive &ZipexArchive,
-                                         const ZipDirectory &Directory, const string &sPath) :
+ZipArchive::SubZipArchive::SubZipArchive(const ZipArchive &ZipArchive, const ZipDirectory &Directory,
+                                         const string &sPath) :
   m_ZipArchive(ZipArchive),
-  m_ZipexArchive(ZipexArchive),
   m_Directory(Directory),
   m_sPath(convertPath(sPath)) {
 
@@ -457,7 +627,7 @@ shared_ptr<Archive> ZipArchive::SubZipArchive::openArchive(const string &sName,
   }
 
   return shared_ptr<Archive>(
-    new SubZipArchive(m_ZipArchive, m_ZipexArchive, DirectoryIt->second, m_sPath + sName)
+    new SubZipArchive(m_ZipArchive, DirectoryIt->second, m_sPath + sName)
   );
 }
 
@@ -496,14 +666,7 @@ shared_ptr<Archive::StreamEnumerator> ZipArchive::SubZipArchive::enumStreams() c
     @return The opened stream
 */
 shared_ptr<Stream> ZipArchive::SubZipArchive::openStream(const string &sName, Stream::AccessMode eMode) {
-  ZipDirectory::ZipFileMap::const_iterator FileIt = m_Directory.Files.find(sName);
-  if(FileIt == m_Directory.Files.end())
-    throw CantOpenResourceException("Nuclex::Storage::ZipArchive::SubZipArchive::openStream()",
-                                    string("The file '") + sName + "' could not be found");
-
-  return shared_ptr<Stream>(
-    new ZipStream(m_ZipexArchive.getFile(m_sPath + sName), eMode)
-  );
+  return m_ZipArchive.openZippedStream(m_sPath + sName, eMode);
 }
 
 // ############################################################################################# //
@@ -559,5 +722,5 @@ shared_ptr<Archive> ZipArchiveFactory::createArchive(const string &sSource) {
     throw CantCreateArchiveException("Nuclex::Storage::ZipArchiveFactory::createArchive()",
                                      string("Can't create Zip storage: '") + sSource + "' is not a Zip");
 
-  return shared_ptr<Archive>(new ZipArchive(sSource));
+  return shared_ptr<Archive>(new ZipArchive(sSource, m_sIndexCacheDirectory));
 }
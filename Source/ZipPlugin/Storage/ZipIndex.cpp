@@ -0,0 +1,285 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## ZipIndex.cpp - Zip central directory index                                //
+// ### # #      ###                                                                            //
+// # ### #      ###  Flat hashed index of the files in a zip archive                           //
+// #  ## #   # ## ## which can be cached on disk between sessions                              //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#include "ZipPlugin/Storage/ZipIndex.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Nuclex;
+using namespace Nuclex::Storage;
+
+namespace {
+
+/// Size of the end of central directory record without the comment
+const size_t EndRecordSize = 22;
+/// Maximum length of the archive comment
+const size_t MaxCommentSize = 65535;
+/// Size of a central directory file header without its variable fields
+const size_t DirectoryHeaderSize = 46;
+/// Signature of the end of central directory record
+const unsigned long EndRecordSignature = 0x06054B50;
+/// Signature of a central directory file header
+const unsigned long DirectoryHeaderSignature = 0x02014B50;
+
+/// Signature of a saved index ('NZIX')
+const unsigned_32 CacheSignature = 0x58495A4E;
+/// Version of the saved index format
+const unsigned_32 CacheVersion = 1;
+
+/// Read a little endian 16 bit integer
+inline unsigned short readUShort(const unsigned char *pBytes) {
+  return static_cast<unsigned short>(pBytes[0] | (pBytes[1] << 8));
+}
+
+/// Read a little endian 32 bit integer
+inline unsigned long readULong(const unsigned char *pBytes) {
+  return static_cast<unsigned long>(pBytes[0]) |
+         (static_cast<unsigned long>(pBytes[1]) << 8) |
+         (static_cast<unsigned long>(pBytes[2]) << 16) |
+         (static_cast<unsigned long>(pBytes[3]) << 24);
+}
+
+} // namespace
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::build()                                                        # //
+// ############################################################################################# //
+/** Builds the index from the central directory of a zip archive. The
+    whole central directory is fetched with a single read and parsed in
+    one pass, no per-file seeking is involved.
+
+    @param  ArchiveStream  Stream of the zip archive
+*/
+void ZipIndex::build(Zipex::Stream &ArchiveStream) {
+  m_Entries.clear();
+  m_Names.clear();
+
+  size_t nArchiveSize = ArchiveStream.getSize();
+  size_t nTailSize = std::min(nArchiveSize, EndRecordSize + MaxCommentSize);
+  if(nTailSize < EndRecordSize)
+    throw UnsupportedFormatException("Nuclex::Storage::ZipIndex::build()",
+                                     "File is too small to be a zip archive");
+
+  std::vector<unsigned char> Tail(nTailSize);
+  if(ArchiveStream.readDataAt(nArchiveSize - nTailSize, &Tail[0], nTailSize) != nTailSize)
+    throw UnsupportedFormatException("Nuclex::Storage::ZipIndex::build()",
+                                     "Could not read the end of the zip archive");
+
+  // The end of central directory record is only followed by the archive comment,
+  // so search for its signature backwards from the end of the archive
+  size_t nEndRecord = nTailSize - EndRecordSize;
+  while((nEndRecord > 0) && (readULong(&Tail[nEndRecord]) != EndRecordSignature))
+    --nEndRecord;
+
+  if(readULong(&Tail[nEndRecord]) != EndRecordSignature)
+    throw UnsupportedFormatException("Nuclex::Storage::ZipIndex::build()",
+                                     "Zip archive has no central directory");
+
+  size_t nFileCount = readUShort(&Tail[nEndRecord + 10]);
+  size_t nDirectorySize = readULong(&Tail[nEndRecord + 12]);
+  size_t nDirectoryOffset = readULong(&Tail[nEndRecord + 16]);
+
+  std::vector<unsigned char> Directory(nDirectorySize);
+  if(nDirectorySize > 0)
+    if(ArchiveStream.readDataAt(nDirectoryOffset, &Directory[0], nDirectorySize) != nDirectorySize)
+      throw UnsupportedFormatException("Nuclex::Storage::ZipIndex::build()",
+                                       "Could not read the zip archive's central directory");
+
+  // Names take up most of the central directory, so its size is a good upper
+  // bound for the name pool and avoids reallocations while filling it
+  m_Entries.reserve(nFileCount);
+  m_Names.reserve(nDirectorySize);
+
+  size_t nPosition = 0;
+  while(nPosition + DirectoryHeaderSize <= nDirectorySize) {
+    const unsigned char *pHeader = &Directory[nPosition];
+    if(readULong(pHeader) != DirectoryHeaderSignature)
+      break;
+
+    size_t nNameLength = readUShort(pHeader + 28);
+    size_t nExtraLength = readUShort(pHeader + 30);
+    size_t nCommentLength = readUShort(pHeader + 32);
+    if(nPosition + DirectoryHeaderSize + nNameLength > nDirectorySize)
+      break;
+
+    const char *pszName = reinterpret_cast<const char *>(pHeader + DirectoryHeaderSize);
+
+    if(nNameLength > 0) {
+      Entry NewEntry;
+      NewEntry.nHash = hash(pszName, nNameLength);
+      NewEntry.nNameOffset = m_Names.size();
+      NewEntry.nNameLength = nNameLength;
+      NewEntry.nHeaderOffset = readULong(pHeader + 42);
+      NewEntry.nCompressedSize = readULong(pHeader + 20);
+      NewEntry.nSize = readULong(pHeader + 24);
+      NewEntry.nMethod = readUShort(pHeader + 10);
+      NewEntry.nFlags = readUShort(pHeader + 8);
+
+      m_Names.insert(m_Names.end(), pszName, pszName + nNameLength);
+      m_Entries.push_back(NewEntry);
+    }
+
+    nPosition += DirectoryHeaderSize + nNameLength + nExtraLength + nCommentLength;
+  }
+
+  buildSlots();
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::load()                                                         # //
+// ############################################################################################# //
+/** Loads an index that was previously saved with save(). Fails if the
+    index was saved for a different archive or the archive has changed
+    since, in which case the index is left as it was.
+
+    @param  Source        Stream to load the index from
+    @param  sArchive      Path of the archive the index belongs to
+    @param  ArchiveStamp  Current stamp of the archive
+    @return True if the index was loaded
+*/
+bool ZipIndex::load(Stream &Source, const string &sArchive, const Stamp &ArchiveStamp) {
+  if((Source.read<unsigned_32>() != CacheSignature) ||
+     (Source.read<unsigned_32>() != CacheVersion) ||
+     (Source.read<unsigned_32>() != sizeof(Entry)))
+    return false;
+
+  Stamp SavedStamp;
+  if(Source.readData(&SavedStamp, sizeof(SavedStamp)) != sizeof(SavedStamp))
+    return false;
+  if(!(SavedStamp == ArchiveStamp))
+    return false;
+
+  // The cache file name is only a hash of the path, so make sure it's the same archive
+  size_t nPathLength = Source.read<unsigned_32>();
+  if(nPathLength != sArchive.length())
+    return false;
+
+  string sSavedArchive(nPathLength, '\0');
+  if(nPathLength > 0)
+    if(Source.readData(&sSavedArchive[0], nPathLength) != nPathLength)
+      return false;
+  if(sSavedArchive != sArchive)
+    return false;
+
+  size_t nEntryCount = Source.read<unsigned_32>();
+  size_t nNameCount = Source.read<unsigned_32>();
+
+  EntryVector Entries(nEntryCount);
+  CharVector Names(nNameCount);
+  if(nEntryCount > 0)
+    if(Source.readData(&Entries[0], nEntryCount * sizeof(Entry)) != nEntryCount * sizeof(Entry))
+      return false;
+  if(nNameCount > 0)
+    if(Source.readData(&Names[0], nNameCount) != nNameCount)
+      return false;
+
+  for(size_t Index = 0; Index < nEntryCount; ++Index)
+    if(Entries[Index].nNameOffset + Entries[Index].nNameLength > nNameCount)
+      return false;
+
+  m_Entries.swap(Entries);
+  m_Names.swap(Names);
+  buildSlots();
+
+  return true;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::save()                                                         # //
+// ############################################################################################# //
+/** Saves the index to a stream. The saved index is specific to the
+    machine it was written on and is meant as a local cache only.
+
+    @param  Target        Stream to save the index to
+    @param  sArchive      Path of the archive the index belongs to
+    @param  ArchiveStamp  Current stamp of the archive
+*/
+void ZipIndex::save(Stream &Target, const string &sArchive, const Stamp &ArchiveStamp) const {
+  Target.write<unsigned_32>(CacheSignature);
+  Target.write<unsigned_32>(CacheVersion);
+  Target.write<unsigned_32>(sizeof(Entry));
+  Target.writeData(&ArchiveStamp, sizeof(ArchiveStamp));
+
+  Target.write<unsigned_32>(static_cast<unsigned_32>(sArchive.length()));
+  Target.writeData(sArchive.c_str(), sArchive.length());
+
+  Target.write<unsigned_32>(static_cast<unsigned_32>(m_Entries.size()));
+  Target.write<unsigned_32>(static_cast<unsigned_32>(m_Names.size()));
+  if(!m_Entries.empty())
+    Target.writeData(&m_Entries[0], m_Entries.size() * sizeof(Entry));
+  if(!m_Names.empty())
+    Target.writeData(&m_Names[0], m_Names.size());
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::find()                                                         # //
+// ############################################################################################# //
+/** Looks up a file by its path within the archive
+
+    @param  sPath  Path of the file to look up
+    @return The file's index or NotFound if it isn't in the archive
+*/
+size_t ZipIndex::find(const string &sPath) const {
+  if(m_Slots.empty())
+    return NotFound;
+
+  unsigned_32 nHash = hash(sPath.c_str(), sPath.length());
+  size_t nMask = m_Slots.size() - 1;
+
+  // The table is never more than half full, so an empty slot is always reached
+  for(size_t nSlot = nHash & nMask; m_Slots[nSlot] != 0; nSlot = (nSlot + 1) & nMask) {
+    const Entry &Candidate = m_Entries[m_Slots[nSlot] - 1];
+    if((Candidate.nHash == nHash) &&
+       (Candidate.nNameLength == sPath.length()) &&
+       (std::memcmp(&m_Names[Candidate.nNameOffset], sPath.c_str(), sPath.length()) == 0))
+      return m_Slots[nSlot] - 1;
+  }
+
+  return NotFound;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::hash()                                                         # //
+// ############################################################################################# //
+/** Calculates the hash of a path (32 bit FNV-1a)
+
+    @param  pszPath  Path to hash
+    @param  nLength  Length of the path
+    @return The path's hash value
+*/
+unsigned_32 ZipIndex::hash(const char *pszPath, size_t nLength) {
+  unsigned_32 nHash = 2166136261U;
+  for(size_t Index = 0; Index < nLength; ++Index) {
+    nHash ^= static_cast<unsigned char>(pszPath[Index]);
+    nHash *= 16777619U;
+  }
+
+  return nHash;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipIndex::buildSlots()                                                   # //
+// ############################################################################################# //
+/** Rebuilds the hash table from the precomputed hashes of the entries
+*/
+void ZipIndex::buildSlots() {
+  size_t nSlotCount = 16;
+  while(nSlotCount < m_Entries.size() * 2)
+    nSlotCount *= 2;
+
+  SlotVector(nSlotCount, 0).swap(m_Slots);
+
+  size_t nMask = nSlotCount - 1;
+  for(size_t Index = 0; Index < m_Entries.size(); ++Index) {
+    size_t nSlot = m_Entries[Index].nHash & nMask;
+    while(m_Slots[nSlot] != 0)
+      nSlot = (nSlot + 1) & nMask;
+
+    m_Slots[nSlot] = Index + 1;
+  }
+}
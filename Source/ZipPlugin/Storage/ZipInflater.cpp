@@ -0,0 +1,352 @@
+//  //
+// #   #  ###  #   #                           -= Nuclex Library =-                            //
+// ##  # #   # ## ## ZipInflater.cpp - Random access into zipped files                         //
+// ### # #      ###                                                                            //
+// # ### #      ###  Decompresses zipped files in chunks, resuming from                        //
+// #  ## #   # ## ## checkpoints instead of inflating from the beginning                       //
+// #   #  ###  #   # R1                              (C)2002-2004 Markus Ewald -> License.txt  //
+//  //
+#include "ZipPlugin/Storage/ZipInflater.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Nuclex;
+using namespace Nuclex::Storage;
+
+namespace {
+
+/// Size of the buffer for compressed data
+const size_t InputBufferSize = 16384;
+/// Size of a zip local file header without file name and extra field
+const size_t LocalHeaderSize = 30;
+/// Signature of a zip local file header
+const unsigned long LocalHeaderSignature = 0x04034B50;
+
+/// Read a little endian 16 bit integer
+inline unsigned short readUShort(const unsigned char *pBytes) {
+  return static_cast<unsigned short>(pBytes[0] | (pBytes[1] << 8));
+}
+
+/// Read a little endian 32 bit integer
+inline unsigned long readULong(const unsigned char *pBytes) {
+  return static_cast<unsigned long>(pBytes[0]) |
+         (static_cast<unsigned long>(pBytes[1]) << 8) |
+         (static_cast<unsigned long>(pBytes[2]) << 16) |
+         (static_cast<unsigned long>(pBytes[3]) << 24);
+}
+
+} // namespace
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::ZipInflater()                                   Constructor # //
+// ############################################################################################# //
+/** Initializes an instance of ZipInflater
+
+    @param  ArchiveStream    Stream of the zip archive containing the file
+    @param  nHeaderOffset    Offset of the file's local header in the archive
+    @param  bDeflated        Whether the file is deflated or stored
+    @param  nCompressedSize  Size of the file's compressed data
+    @param  nSize            Size of the file's decompressed data
+    @param  spIndex          Checkpoint index to use and extend. Can be empty
+                             for small files where checkpoints don't pay off
+*/
+ZipInflater::ZipInflater(Zipex::Stream &ArchiveStream, size_t nHeaderOffset,
+                         bool bDeflated, size_t nCompressedSize, size_t nSize,
+                         const shared_ptr<CheckpointIndex> &spIndex) :
+  m_ArchiveStream(ArchiveStream),
+  m_nDataOffset(0),
+  m_bDeflated(bDeflated),
+  m_nCompressedSize(nCompressedSize),
+  m_nSize(nSize),
+  m_spIndex(spIndex),
+  m_nChunkStart(0),
+  m_nChunkLength(0),
+  m_bInflating(false),
+  m_nInput(0),
+  m_nOutput(0),
+  m_nWindowPosition(0),
+  m_nRestarts(0) {
+
+  // The local header can carry a different extra field than the
+  // central directory, so the data offset has to be taken from it
+  unsigned char pHeader[LocalHeaderSize];
+  size_t nHeaderSize = m_ArchiveStream.readDataAt(nHeaderOffset, pHeader, LocalHeaderSize);
+
+  if((nHeaderSize != LocalHeaderSize) || (readULong(pHeader) != LocalHeaderSignature))
+    throw UnsupportedFormatException("Nuclex::Storage::ZipInflater::ZipInflater()",
+                                     "Invalid local file header in zip archive");
+
+  m_nDataOffset = nHeaderOffset + LocalHeaderSize +
+                  readUShort(pHeader + 26) + readUShort(pHeader + 28);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::~ZipInflater()                                   Destructor # //
+// ############################################################################################# //
+/** Destroys an instance of ZipInflater
+*/
+ZipInflater::~ZipInflater() {
+  if(m_bInflating)
+    ::inflateEnd(&m_ZLibStream);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::readDataAt()                                                # //
+// ############################################################################################# //
+/** Reads decompressed data from the specified location. Only the chunk
+    containing the read position is decompressed, starting from the
+    closest checkpoint or from where the previous read stopped.
+
+    @param  nPosition  Position in the decompressed data to read from
+    @param  pDest      Destination address
+    @param  nBytes     Number of bytes to read
+    @return The number of bytes actually read
+*/
+size_t ZipInflater::readDataAt(size_t nPosition, void *pDest, size_t nBytes) {
+  if(nPosition >= m_nSize)
+    return 0;
+
+  nBytes = std::min(nBytes, m_nSize - nPosition);
+
+  // Stored files need no decompression at all
+  if(!m_bDeflated)
+    return readCompressed(nPosition, pDest, nBytes);
+
+  unsigned char *pBytes = static_cast<unsigned char *>(pDest);
+  size_t         nRemaining = nBytes;
+  while(nRemaining > 0) {
+    if((nPosition < m_nChunkStart) || (nPosition >= m_nChunkStart + m_nChunkLength)) {
+      fillChunk(nPosition - (nPosition % ChunkSize));
+
+      // The deflate stream may end before the size from the directory
+      if(nPosition >= m_nChunkStart + m_nChunkLength)
+        break;
+    }
+
+    size_t nOffset = nPosition - m_nChunkStart;
+    size_t nCount = std::min(nRemaining, m_nChunkLength - nOffset);
+    std::memcpy(pBytes, &m_Chunk[nOffset], nCount);
+
+    pBytes += nCount;
+    nPosition += nCount;
+    nRemaining -= nCount;
+  }
+
+  return nBytes - nRemaining;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::flush()                                                     # //
+// ############################################################################################# //
+/** Releases the resident chunk and the decompressor state. The
+    checkpoints stay in the index, so the next read doesn't have to
+    start over at the beginning of the file.
+*/
+void ZipInflater::flush() {
+  if(m_bInflating) {
+    ::inflateEnd(&m_ZLibStream);
+    m_bInflating = false;
+  }
+
+  ByteVector().swap(m_Chunk);
+  ByteVector().swap(m_InputBuffer);
+  ByteVector().swap(m_Window);
+  m_nChunkStart = 0;
+  m_nChunkLength = 0;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::readCompressed()                                            # //
+// ############################################################################################# //
+/** Reads raw data of the zipped file from the archive
+
+    @param  nOffset  Offset relative to the beginning of the file's data
+    @param  pDest    Destination address
+    @param  nBytes   Number of bytes to read
+    @return The number of bytes actually read
+*/
+size_t ZipInflater::readCompressed(size_t nOffset, void *pDest, size_t nBytes) {
+  return m_ArchiveStream.readDataAt(m_nDataOffset + nOffset, pDest, nBytes);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::fillChunk()                                                 # //
+// ############################################################################################# //
+/** Decompresses the chunk starting at the specified position into the
+    resident chunk buffer. The running decompressor is reused if it has
+    not passed the chunk yet and no checkpoint lies between it and the
+    chunk, otherwise decompression restarts at the closest checkpoint.
+
+    @param  nChunkStart  Position of the chunk in the decompressed data
+*/
+void ZipInflater::fillChunk(size_t nChunkStart) {
+  if(m_Window.empty()) {
+    m_Chunk.resize(ChunkSize);
+    m_InputBuffer.resize(InputBufferSize);
+    m_Window.resize(WindowSize);
+  }
+
+  shared_ptr<Checkpoint> spCheckpoint = findCheckpoint(nChunkStart);
+  size_t nCheckpointOutput = spCheckpoint ? spCheckpoint->nOutput : 0;
+  if(!m_bInflating || (m_nOutput > nChunkStart) || (m_nOutput < nCheckpointOutput))
+    restart(spCheckpoint.get());
+
+  size_t nChunkEnd = std::min<size_t>(nChunkStart + ChunkSize, m_nSize);
+  m_nChunkStart = nChunkStart;
+  m_nChunkLength = 0;
+
+  while(m_nOutput < nChunkEnd) {
+    if(m_ZLibStream.avail_in == 0) {
+      size_t nCount = std::min<size_t>(InputBufferSize, m_nCompressedSize - m_nInput);
+      if((nCount == 0) || (readCompressed(m_nInput, &m_InputBuffer[0], nCount) != nCount))
+        throw UnsupportedFormatException("Nuclex::Storage::ZipInflater::fillChunk()",
+                                         "Compressed data in zip archive is truncated");
+
+      m_nInput += nCount;
+      m_ZLibStream.next_in = &m_InputBuffer[0];
+      m_ZLibStream.avail_in = static_cast<uInt>(nCount);
+    }
+
+    // Decompress into the circular window, wrapping around at its end.
+    // Z_BLOCK makes zlib return at every deflate block boundary, which
+    // are the only places where decompression can be resumed later.
+    // Output is capped at the chunk's end so the decompressor stops right
+    // where the next sequential chunk begins and can simply continue there.
+    unsigned char *pWindow = &m_Window[m_nWindowPosition];
+    size_t nWindowSpace = std::min<size_t>(WindowSize - m_nWindowPosition, nChunkEnd - m_nOutput);
+    m_ZLibStream.next_out = pWindow;
+    m_ZLibStream.avail_out = static_cast<uInt>(nWindowSpace);
+
+    int nResult = ::inflate(&m_ZLibStream, Z_BLOCK);
+    if((nResult != Z_OK) && (nResult != Z_STREAM_END) && (nResult != Z_BUF_ERROR))
+      throw UnsupportedFormatException("Nuclex::Storage::ZipInflater::fillChunk()",
+                                       "Corrupt deflate stream in zip archive");
+
+    // Copy whatever part of the new output falls into the chunk
+    size_t nProduced = nWindowSpace - m_ZLibStream.avail_out;
+    size_t nBegin = std::max(m_nOutput, nChunkStart);
+    size_t nEnd = std::min(m_nOutput + nProduced, nChunkEnd);
+    if(nBegin < nEnd)
+      std::memcpy(&m_Chunk[nBegin - nChunkStart], pWindow + (nBegin - m_nOutput), nEnd - nBegin);
+
+    m_nOutput += nProduced;
+    m_nWindowPosition = (m_nWindowPosition + nProduced) % WindowSize;
+
+    if(nResult == Z_STREAM_END) {
+      ::inflateEnd(&m_ZLibStream);
+      m_bInflating = false;
+      break;
+    }
+
+    // Bit 7 of data_type marks a block boundary, bit 6 the final block
+    if((m_ZLibStream.data_type & 128) && !(m_ZLibStream.data_type & 64))
+      addCheckpoint();
+  }
+
+  m_nChunkLength = std::min(m_nOutput, nChunkEnd) - nChunkStart;
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::restart()                                                   # //
+// ############################################################################################# //
+/** Reinitializes the decompressor at a checkpoint
+
+    @param  pCheckpoint  Checkpoint to resume at. NULL to start at
+                         the beginning of the file
+*/
+void ZipInflater::restart(const Checkpoint *pCheckpoint) {
+  if(m_bInflating) {
+    ::inflateEnd(&m_ZLibStream);
+    m_bInflating = false;
+  }
+
+  std::memset(&m_ZLibStream, 0, sizeof(m_ZLibStream));
+  if(::inflateInit2(&m_ZLibStream, -MAX_WBITS) != Z_OK)
+    throw FailedException("Nuclex::Storage::ZipInflater::restart()",
+                          "Could not initialize the zlib decompressor");
+
+  m_bInflating = true;
+  m_nWindowPosition = 0;
+  ++m_nRestarts;
+
+  if(pCheckpoint) {
+    m_nInput = pCheckpoint->nInput;
+    m_nOutput = pCheckpoint->nOutput;
+
+    // The checkpoint's block may start in the middle of a byte
+    if(pCheckpoint->nBits) {
+      unsigned char nByte;
+      readCompressed(m_nInput - 1, &nByte, 1);
+      ::inflatePrime(&m_ZLibStream, pCheckpoint->nBits, nByte >> (8 - pCheckpoint->nBits));
+    }
+
+    std::memcpy(&m_Window[0], pCheckpoint->Window, WindowSize);
+    ::inflateSetDictionary(&m_ZLibStream, pCheckpoint->Window, WindowSize);
+  } else {
+    m_nInput = 0;
+    m_nOutput = 0;
+  }
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::addCheckpoint()                                             # //
+// ############################################################################################# //
+/** Records a checkpoint at the current decompressor position if it
+    lies CheckpointSpacing bytes or more beyond the last checkpoint.
+    Must only be called when zlib stopped at a deflate block boundary.
+*/
+void ZipInflater::addCheckpoint() {
+  if(!m_spIndex)
+    return;
+
+  Mutex::ScopedLock Lock(m_spIndex->Lock);
+
+  CheckpointIndex::CheckpointVector &Checkpoints = m_spIndex->Checkpoints;
+  size_t nLastOutput = Checkpoints.empty() ? 0 : Checkpoints.back()->nOutput;
+  if(m_nOutput < nLastOutput + CheckpointSpacing)
+    return;
+
+  shared_ptr<Checkpoint> spCheckpoint(new Checkpoint());
+  spCheckpoint->nOutput = m_nOutput;
+  spCheckpoint->nInput = m_nInput - m_ZLibStream.avail_in;
+  spCheckpoint->nBits = m_ZLibStream.data_type & 7;
+
+  // The oldest byte in the circular window is the next one to be overwritten
+  std::memcpy(
+    spCheckpoint->Window, &m_Window[m_nWindowPosition], WindowSize - m_nWindowPosition
+  );
+  std::memcpy(
+    spCheckpoint->Window + (WindowSize - m_nWindowPosition), &m_Window[0], m_nWindowPosition
+  );
+
+  Checkpoints.push_back(spCheckpoint);
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipInflater::findCheckpoint()                                            # //
+// ############################################################################################# //
+/** Looks up the last checkpoint at or before the specified position
+
+    @param  nPosition  Position in the decompressed data
+    @return The checkpoint or an empty pointer if there is none
+*/
+shared_ptr<ZipInflater::Checkpoint> ZipInflater::findCheckpoint(size_t nPosition) {
+  if(!m_spIndex)
+    return shared_ptr<Checkpoint>();
+
+  Mutex::ScopedLock Lock(m_spIndex->Lock);
+
+  // Binary search for the first checkpoint beyond the position
+  const CheckpointIndex::CheckpointVector &Checkpoints = m_spIndex->Checkpoints;
+  size_t nLow = 0;
+  size_t nHigh = Checkpoints.size();
+  while(nLow < nHigh) {
+    size_t nMiddle = (nLow + nHigh) / 2;
+    if(Checkpoints[nMiddle]->nOutput <= nPosition)
+      nLow = nMiddle + 1;
+    else
+      nHigh = nMiddle;
+  }
+
+  return (nLow > 0) ? Checkpoints[nLow - 1] : shared_ptr<Checkpoint>();
+}
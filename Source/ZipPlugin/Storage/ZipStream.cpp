@@ -17,9 +17,29 @@ using namespace Nuclex::Storage;
 /** Initializes an instance CZipStream
 */
 ZipStream::ZipStream(Zipex::ZippedFile &ZipexFile, AccessMode eMode) :
-  m_ZipexFile(ZipexFile),
-  m_eAccessMode(eMode),
-  m_Location(0) {
+  m_pZipexFile(&ZipexFile),
+  m_Location(0),
+  m_eAccessMode(eMode) {
+
+  if(eMode != AM_READ)
+    throw NotSupportedException("Nuclex::Storage::ZipStream::ZipStream()",
+                                "Writing to Zip files not supported");
+}
+
+// ############################################################################################# //
+// # Nuclex::Storage::ZipStream::ZipStream()                                       Constructor # //
+// ############################################################################################# //
+/** Initializes an instance ZipStream which reads through a ZipInflater
+    instead of letting zipex decompress the whole file into memory
+
+    @param  spInflater  Inflater for reading the file's contents
+    @param  eMode       Access mode for the stream
+*/
+ZipStream::ZipStream(std::auto_ptr<ZipInflater> spInflater, AccessMode eMode) :
+  m_pZipexFile(NULL),
+  m_spInflater(spInflater),
+  m_Location(0),
+  m_eAccessMode(eMode) {
 
   if(eMode != AM_READ)
     throw NotSupportedException("Nuclex::Storage::ZipStream::ZipStream()",
@@ -34,7 +54,10 @@ ZipStream::ZipStream(Zipex::ZippedFile &ZipexFile, AccessMode eMode) :
     @return The stream's size
 */
 size_t ZipStream::getSize() const {
-  return m_ZipexFile.getSize();
+  if(m_spInflater.get())
+    return m_spInflater->getSize();
+  else
+    return m_pZipexFile->getSize();
 }
 
 // ############################################################################################# //
@@ -80,7 +103,12 @@ size_t ZipStream::getLocation() const {
     @return The number of bytes actually read
 */
 size_t ZipStream::readData(void *pDest, size_t nBytes) {
-  size_t AmountRead = m_ZipexFile.readDataAt(m_Location, pDest, nBytes);
+  size_t AmountRead;
+  if(m_spInflater.get())
+    AmountRead = m_spInflater->readDataAt(m_Location, pDest, nBytes);
+  else
+    AmountRead = m_pZipexFile->readDataAt(m_Location, pDest, nBytes);
+
   m_Location += AmountRead;
 
   return AmountRead;
@@ -118,5 +146,8 @@ Stream::AccessMode ZipStream::getAccessMode() const {
     to disk)
 */
 void ZipStream::flush() {
-  m_ZipexFile.flush();
+  if(m_spInflater.get())
+    m_spInflater->flush();
+  else
+    m_pZipexFile->flush();
 }
@@ -30,6 +30,14 @@
 // enable/disable mini dumps
 #define STELLAR_ENABLE_MINIDUMPS (1)
 
+// enable/disable the s_profile() markers, recording is switched on at runtime
+// with Debug::Profiler::SetEnabled()
+#define STELLAR_ENABLE_PROFILING (1)
+
+// enable/disable the sampling allocation tracker (see Memory::AllocTracker),
+// cheap enough to be left on in staging builds
+#define STELLAR_MEMORY_TRACKING (1)
+
 
 //------------------------------------------------------------------------------
 /**
@@ -42,6 +50,17 @@
 #define __WIN32__ (1)
 #endif
 
+//------------------------------------------------------------------------------
+/**
+    Posix specifics.
+*/
+#ifdef __POSIX__
+#undef __POSIX__
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+#define __POSIX__ (1)
+#endif
+
 //------------------------------------------------------------------------------
 /**
     GCC specifics.
@@ -138,7 +138,11 @@ s_dbgout(const char *msg, ...)
 void 
 s_sleep(double sec)
 {
+  #if __WIN32__
   DWORD dwSec = (DWORD)(sec * 1000.0f);
   ::Sleep(dwSec);
+  #else
+  usleep((useconds_t)(sec * 1000000.0));
+  #endif
 }
 
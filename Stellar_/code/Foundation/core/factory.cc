@@ -214,4 +214,27 @@ Factory::Create(const FourCC classFourCC) const
     return newObject;
 }
 
+//------------------------------------------------------------------------------
+/**
+    This is called from the Rtti constructor of classes declared with
+    DeclarePooledClass, so the live and peak object counts of their 
+    pools can be queried from a central place.
+*/
+void
+Factory::RegisterPooledClass(const Rtti* rtti)
+{
+    s_assert(0 != rtti);
+    s_assert(0 != rtti->GetObjectPool());
+    this->pooledClasses.Append(rtti);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+const Array<const Rtti*>&
+Factory::GetPooledClasses() const
+{
+    return this->pooledClasses;
+}
+
 } // namespace Core
\ No newline at end of file
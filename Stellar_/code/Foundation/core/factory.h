@@ -16,6 +16,7 @@
 #include "utility/string.h"
 #include "utility/fourcc.h"
 #include "utility/hashtable.h"
+#include "utility/array.h"
 #include "core/ptr.h"
 #include <map>
 
@@ -48,6 +49,10 @@ public:
     RefCounted* Create(const Util::String& className) const;
     /// create an object by FourCC code
     RefCounted* Create(const Util::FourCC classFourCC) const;
+    /// register the RTTI object of a pooled class
+    void RegisterPooledClass(const Rtti* rtti);
+    /// get the RTTI objects of all pooled classes, for the pool statistics
+    const Util::Array<const Rtti*>& GetPooledClasses() const;
 
 private:
     /// constructor is private
@@ -57,11 +62,12 @@ private:
 
     typedef std::map<Util::FourCC, const Rtti*> CCMap;
     typedef CCMap::const_iterator CCConstIterator;
-    typedef Util::HashTable<const Util::String, const Rtti*> HashTableMap;
+    typedef Util::HashTable<Util::String, const Rtti*> HashTableMap;
 
     static Factory* Singleton;
     HashTableMap nameTable;// for fast lookup by class name
     CCMap fourccTable;  // for fast lookup by fourcc code
+    Util::Array<const Rtti*> pooledClasses;
 };
 
 }; // namespace Foundation
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef CORE_POSIX_PRECOMPILED_H
+#define CORE_POSIX_PRECOMPILED_H
+//------------------------------------------------------------------------------
+/**
+    @file core/posix/precompiled.h
+    
+    Contains precompiled headers on Posix platforms.
+    
+    (C) 2007 by Ctuo
+*/
+
+// posix headers
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <strings.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+// crt headers
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <algorithm>
+
+// stl
+#include <string>
+#include <vector>
+#include <map>
+//------------------------------------------------------------------------------
+#endif
@@ -13,10 +13,11 @@ using namespace Util;
 //------------------------------------------------------------------------------
 /**
 */
-Rtti::Rtti(const char* className, FourCC fcc, Creator creatorFunc, const Rtti* parentClass) :
+Rtti::Rtti(const char* className, FourCC fcc, Creator creatorFunc, const Rtti* parentClass, Memory::ObjectPool* objectPool) :
     fourCC(fcc),
     parent(parentClass),
-    creator(creatorFunc)
+    creator(creatorFunc),
+    pool(objectPool)
 {
     s_assert(0 != className);
     s_assert(fourCC.IsValid() != 0);
@@ -29,6 +30,10 @@ Rtti::Rtti(const char* className, FourCC fcc, Creator creatorFunc, const Rtti* p
     {
         Factory::Instance()->Register(this, this->name, fcc);
     }
+    if (0 != this->pool)
+    {
+        Factory::Instance()->RegisterPooledClass(this);
+    }
 }
 
 //------------------------------------------------------------------------------
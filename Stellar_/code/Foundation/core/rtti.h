@@ -11,6 +11,10 @@
     will also automatically register the class with the Core::Factory object
     to implement object construction from class name string or fourcc code.
 
+    Classes which are created and destroyed very often can use the macros
+    DeclarePooledClass and ImplementPooledClass instead. Their objects are
+    allocated from a per-class Memory::ObjectPool.
+
     by ctuo  2007
 */
 #include "core/types.h"
@@ -18,6 +22,7 @@
 #include "utility/string.h"
 #include "utility/fourcc.h"
 #include "memory/heap.h"
+#include "memory/objectpool.h"
 
 //------------------------------------------------------------------------------
 namespace Core
@@ -30,7 +35,7 @@ public:
     typedef RefCounted* (*Creator)();
 
     /// constructor
-    Rtti(const char* className, Util::FourCC fcc, Creator creatorFunc, const Core::Rtti* parentClass);
+    Rtti(const char* className, Util::FourCC fcc, Creator creatorFunc, const Core::Rtti* parentClass, Memory::ObjectPool* objectPool = 0);
     /// equality operator
     bool operator==(const Rtti& rhs) const;
     /// inequality operator
@@ -41,6 +46,8 @@ public:
     Util::FourCC GetFourCC() const;
     /// get pointer to parent class
     const Core::Rtti* GetParent() const;
+    /// get the object pool of a pooled class, 0 if the class isn't pooled
+    const Memory::ObjectPool* GetObjectPool() const;
     /// create an object of this class
     RefCounted* Create() const;
     /// return true if this rtti is equal or derived from to other rtti
@@ -55,6 +62,7 @@ private:
     const Core::Rtti* parent;
     const Util::FourCC fourCC;
     const Creator creator;
+    const Memory::ObjectPool* pool;
 };
 
 //------------------------------------------------------------------------------
@@ -102,6 +110,15 @@ Rtti::GetParent() const
     return parent;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Memory::ObjectPool*
+Rtti::GetObjectPool() const
+{
+    return pool;
+}
+
 };  // namespace Core
 
 //------------------------------------------------------------------------------
@@ -125,6 +142,30 @@ public: \
     virtual Core::Rtti* GetRtti() const; \
 private:
 
+//------------------------------------------------------------------------------
+/**
+    Declaration macro for pooled classes. Put this into the class declaration
+    instead of DeclareClass. Derived classes must use their own DeclareClass
+    or DeclarePooledClass, since the pool only fits objects of this class.
+*/
+#define DeclarePooledClass(type) \
+public: \
+    void* operator new(size_t size) \
+    { \
+        return type::Pool.Alloc(size); \
+    }; \
+    void operator delete(void* p) \
+    { \
+        type::Pool.Free(p); \
+    }; \
+    static Memory::ObjectPool Pool; \
+    static Core::Rtti RTTI; \
+    static Core::RefCounted* FactoryCreator(); \
+    static type* Create(); \
+    static bool RegisterWithFactory(); \
+    virtual Core::Rtti* GetRtti() const; \
+private:
+
 #define DeclareAbstractClass(class_name) \
 public: \
     static Core::Rtti RTTI; \
@@ -146,7 +187,6 @@ private:
 /**
     Implementation macro. Put this into the source file.
 */
-#if STELLAR_DEBUG
 //#define ImplementClass(type, fourcc, baseType) \
 //    Core::Rtti type::RTTI(#type, fourcc, type::FactoryCreator, &baseType::RTTI); \
 //    Core::Rtti* type::GetRtti() const { return &this->RTTI; } \
@@ -185,7 +225,30 @@ private:
         } \
         return true; \
     }
-#endif
+
+//------------------------------------------------------------------------------
+/**
+    Implementation macro for pooled classes. Put this into the source file.
+    The pool must be defined before the RTTI object, which registers the
+    pool with the factory.
+*/
+#define ImplementPooledClass(type, fourcc, baseType) \
+    Memory::ObjectPool type::Pool(#type, sizeof(type)); \
+    Core::Rtti type::RTTI(#type, fourcc, type::FactoryCreator, &baseType::RTTI, &type::Pool); \
+    Core::Rtti* type::GetRtti() const { return &this->RTTI; } \
+    Core::RefCounted* type::FactoryCreator() { return type::Create(); } \
+    type* type::Create() \
+    { \
+        return s_new(type); \
+    }\
+    bool type::RegisterWithFactory() \
+    { \
+        if (!Core::Factory::Instance()->ClassExists(#type)) \
+        { \
+            Core::Factory::Instance()->Register(&type::RTTI, #type, fourcc); \
+        } \
+        return true; \
+    }
 
 #define ImplementAbstractClass(type, fourcc, baseType) \
     Core::Rtti type::RTTI(#type, fourcc, 0, &baseType::RTTI); \
@@ -195,7 +258,6 @@ private:
 /**
     Type implementation of topmost type in inheritance hierarchy (source file).
 */
-#if STELLAR_DEBUG
 //#define ImplementRootClass(type, fourcc) \
 //    Core::Rtti type::RTTI(#type, fourcc, type::FactoryCreator, 0); \
 //    Core::Rtti* type::GetRtti() const { return &this->RTTI; } \
@@ -234,6 +296,5 @@ private:
         } \
         return true; \
     }
-#endif
 //------------------------------------------------------------------------------
 #endif
\ No newline at end of file
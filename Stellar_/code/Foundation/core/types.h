@@ -49,12 +49,17 @@ static const unsigned int InvalidIndex = 0xffffffff;
 #if __WIN32__
 #define s_stricmp stricmp
 #define s_snprintf StringCchPrintf
+#elif __POSIX__
+#define s_stricmp strcasecmp
+#define s_snprintf snprintf
 #else
 #error "Unsupported platform!"
 #endif
 
 #if __WIN32__
 #define ThreadLocal __declspec(thread)
+#elif __POSIX__
+#define ThreadLocal __thread
 #else
 #error "Unsupported platform!"
 #endif
@@ -63,6 +68,8 @@ static const unsigned int InvalidIndex = 0xffffffff;
 #if __WIN32__
 #define s_align(X)
 //#define s_align(X) __declspec(align(X))
+#elif __POSIX__
+#define s_align(X)
 #else
 #error "Unsupported platform!"
 #endif
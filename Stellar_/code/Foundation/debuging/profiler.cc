@@ -0,0 +1,423 @@
+//------------------------------------------------------------------------------
+//  profiler.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "debuging/profiler.h"
+#include "thread/thread.h"
+#include "thread/criticalsection.h"
+#include "thread/interlocked.h"
+#include "utility/flathashmap.h"
+
+namespace Debug
+{
+using namespace Util;
+using namespace Threading;
+
+namespace
+{
+/// a finished scope
+struct Record
+{
+    const char* name;
+    Profiler::Ticks start;
+    Profiler::Ticks end;
+    int depth;
+};
+
+/// a captured scope with the thread it ran on
+struct CaptureRecord
+{
+    Record record;
+    IndexT threadIndex;
+};
+
+/// the ring buffer of one thread, only the owning thread writes records
+/// and only the thread in CollectRecords() reads them
+struct ThreadBuffer
+{
+    String threadName;
+    int volatile writePos;
+    int volatile readPos;
+    int depth;
+    Record records[Profiler::RingBufferSize];
+};
+
+CriticalSection CollectLock;
+Array<ThreadBuffer*> ThreadBuffers;
+Array<Profiler::MarkerStats> MarkerStatsArray;
+FlatHashMap<const char*, IndexT> MarkerIndices;
+Array<CaptureRecord> CaptureRecords;
+Profiler::Ticks CaptureStart = 0;
+bool Capturing = false;
+int volatile NumDroppedRecords = 0;
+ThreadLocal ThreadBuffer* MyThreadBuffer = 0;
+
+/// frees the ring buffers when the application exits
+struct ThreadBufferCleanup
+{
+    ~ThreadBufferCleanup()
+    {
+        IndexT i;
+        for (i = 0; i < ThreadBuffers.Size(); i++)
+        {
+            s_delete(ThreadBuffers[i]);
+        }
+        ThreadBuffers.Clear();
+    }
+} Cleanup;
+
+//------------------------------------------------------------------------------
+/**
+    Buffers are only freed when the application exits, threads in the
+    engine live until the application shuts down.
+*/
+ThreadBuffer*
+GetMyThreadBuffer()
+{
+    if (0 == MyThreadBuffer)
+    {
+        ThreadBuffer* buffer = s_new(ThreadBuffer);
+        const char* threadName = Thread::GetMyThreadName();
+        buffer->threadName = (0 != threadName) ? threadName : "Main";
+        buffer->writePos = 0;
+        buffer->readPos = 0;
+        buffer->depth = 0;
+
+        CollectLock.Enter();
+        ThreadBuffers.Append(buffer);
+        CollectLock.Leave();
+        MyThreadBuffer = buffer;
+    }
+    return MyThreadBuffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+AppendJsonString(String& str, const char* s)
+{
+    str.append(1, '"');
+    for (; 0 != *s; s++)
+    {
+        char c = *s;
+        if (('"' == c) || ('\\' == c))
+        {
+            str.append(1, '\\');
+            str.append(1, c);
+        }
+        else if ((unsigned char)c >= 0x20)
+        {
+            str.append(1, c);
+        }
+    }
+    str.append(1, '"');
+}
+
+} // namespace
+
+bool volatile Profiler::Enabled = false;
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Profiler::SetEnabled(bool b)
+{
+    Enabled = b;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Profiler::Ticks
+Profiler::GetTicksPerSecond()
+{
+    #if __WIN32__
+    static Ticks ticksPerSecond = 0;
+    if (0 == ticksPerSecond)
+    {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        ticksPerSecond = freq.QuadPart;
+    }
+    return ticksPerSecond;
+    #else
+    return 1000000000;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+Profiler::EnterScope()
+{
+    return GetMyThreadBuffer()->depth++;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The record is written before the write position is advanced, the
+    interlocked exchange makes sure the collecting thread sees it in
+    this order.
+*/
+void
+Profiler::LeaveScope(const char* name, Ticks start, int depth)
+{
+    ThreadBuffer* buffer = GetMyThreadBuffer();
+    buffer->depth = depth;
+    int pos = buffer->writePos;
+    if ((unsigned int)(pos - buffer->readPos) >= RingBufferSize)
+    {
+        Interlocked::Increment(NumDroppedRecords);
+        return;
+    }
+    Record& record = buffer->records[pos & (RingBufferSize - 1)];
+    record.name = name;
+    record.start = start;
+    record.end = GetTicks();
+    record.depth = depth;
+    Interlocked::Exchange(buffer->writePos, pos + 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Markers are looked up by the address of their name. The same name
+    may have different addresses in different modules, so a new address
+    is checked against the existing names before a new marker is added.
+*/
+IndexT
+Profiler::FindMarkerStats(const char* name, int depth)
+{
+    IndexT* index = MarkerIndices.Find(name);
+    if (0 != index)
+    {
+        return *index;
+    }
+    IndexT i;
+    for (i = 0; i < MarkerStatsArray.Size(); i++)
+    {
+        if (0 == strcmp(MarkerStatsArray[i].name, name))
+        {
+            MarkerIndices.Add(name, i);
+            return i;
+        }
+    }
+    MarkerStats stats;
+    stats.name = name;
+    stats.depth = depth;
+    stats.numFrames = 0;
+    stats.lastFrameCalls = 0;
+    stats.lastFrameTime = 0.0;
+    stats.minTime = 0.0;
+    stats.maxTime = 0.0;
+    stats.totalTime = 0.0;
+    stats.frameCalls = 0;
+    stats.frameTime = 0.0;
+    MarkerStatsArray.Append(stats);
+    MarkerIndices.Add(name, i);
+    return i;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Must be called with the collect lock taken.
+*/
+void
+Profiler::CollectRecords()
+{
+    double secondsPerTick = 1.0 / GetTicksPerSecond();
+    IndexT threadIndex;
+    for (threadIndex = 0; threadIndex < ThreadBuffers.Size(); threadIndex++)
+    {
+        ThreadBuffer* buffer = ThreadBuffers[threadIndex];
+        int writePos = buffer->writePos;
+        int pos;
+        for (pos = buffer->readPos; pos != writePos; pos++)
+        {
+            const Record& record = buffer->records[pos & (RingBufferSize - 1)];
+            MarkerStats& stats = MarkerStatsArray[FindMarkerStats(record.name, record.depth)];
+            stats.frameCalls++;
+            stats.frameTime += (record.end - record.start) * secondsPerTick;
+
+            if (Capturing && (CaptureRecords.Size() < MaxNumCaptureRecords))
+            {
+                CaptureRecord captureRecord;
+                captureRecord.record = record;
+                captureRecord.threadIndex = threadIndex;
+                CaptureRecords.Append(captureRecord);
+            }
+        }
+        Interlocked::Exchange(buffer->readPos, writePos);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Markers which weren't hit in the frame don't count towards their
+    average, so the stats of markers which are only hit now and then,
+    e.g. while loading, aren't watered down.
+*/
+void
+Profiler::NextFrame()
+{
+    CollectLock.Enter();
+    CollectRecords();
+    IndexT i;
+    for (i = 0; i < MarkerStatsArray.Size(); i++)
+    {
+        MarkerStats& stats = MarkerStatsArray[i];
+        if (stats.frameCalls > 0)
+        {
+            if ((0 == stats.numFrames) || (stats.frameTime < stats.minTime))
+            {
+                stats.minTime = stats.frameTime;
+            }
+            if ((0 == stats.numFrames) || (stats.frameTime > stats.maxTime))
+            {
+                stats.maxTime = stats.frameTime;
+            }
+            stats.numFrames++;
+            stats.totalTime += stats.frameTime;
+            stats.lastFrameCalls = stats.frameCalls;
+            stats.lastFrameTime = stats.frameTime;
+            stats.frameCalls = 0;
+            stats.frameTime = 0.0;
+        }
+    }
+    CollectLock.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Only call this from the thread which calls NextFrame().
+*/
+const Array<Profiler::MarkerStats>&
+Profiler::GetMarkerStats()
+{
+    return MarkerStatsArray;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Profiler::ResetStats()
+{
+    CollectLock.Enter();
+    MarkerStatsArray.Clear();
+    MarkerIndices.Clear();
+    CollectLock.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+SizeT
+Profiler::GetNumDroppedRecords()
+{
+    return NumDroppedRecords;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Records which are still in the ring buffers belong to the time before
+    the capture and are only counted in the stats.
+*/
+void
+Profiler::BeginCapture()
+{
+    CollectLock.Enter();
+    CollectRecords();
+    CaptureRecords.Clear();
+    CaptureStart = GetTicks();
+    Capturing = true;
+    CollectLock.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Profiler::EndCapture()
+{
+    CollectLock.Enter();
+    CollectRecords();
+    Capturing = false;
+    CollectLock.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+Profiler::IsCapturing()
+{
+    return Capturing;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+SizeT
+Profiler::GetNumCapturedRecords()
+{
+    return CaptureRecords.Size();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Every record becomes a complete ("X") event with its time stamp and
+    duration in microseconds. chrome://tracing nests the events of a
+    thread by their times, so no explicit hierarchy is needed. The thread
+    names are added as metadata events.
+*/
+String
+Profiler::BuildChromeTrace()
+{
+    CollectLock.Enter();
+    double microSecsPerTick = 1000000.0 / GetTicksPerSecond();
+    String str;
+    str.reserve(64 + CaptureRecords.Size() * 96);
+    str.append("{\"traceEvents\":[\n");
+    char buf[128];
+    IndexT i;
+    for (i = 0; i < ThreadBuffers.Size(); i++)
+    {
+        s_snprintf(buf, sizeof(buf), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", i);
+        str.append(buf);
+        AppendJsonString(str, ThreadBuffers[i]->threadName.c_str());
+        str.append("}},\n");
+    }
+    for (i = 0; i < CaptureRecords.Size(); i++)
+    {
+        const CaptureRecord& captureRecord = CaptureRecords[i];
+        const Record& record = captureRecord.record;
+        str.append("{\"name\":");
+        AppendJsonString(str, record.name);
+        s_snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+            captureRecord.threadIndex,
+            (record.start - CaptureStart) * microSecsPerTick,
+            (record.end - record.start) * microSecsPerTick);
+        str.append(buf);
+    }
+    // close with an empty object, JSON doesn't allow a trailing comma
+    str.append("{}\n]}\n");
+    CollectLock.Leave();
+    return str;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Profiler::WriteChromeTrace(const Ptr<IO::Stream>& stream)
+{
+    s_assert(stream->IsOpen());
+    String str = BuildChromeTrace();
+    stream->Write(str.c_str(), (IO::Stream::Size) str.size());
+}
+
+} // namespace Debug
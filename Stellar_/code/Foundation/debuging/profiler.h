@@ -0,0 +1,217 @@
+#pragma once
+#ifndef DEBUG_PROFILER_H
+#define DEBUG_PROFILER_H
+//------------------------------------------------------------------------------
+/**
+    @class Debug::Profiler
+
+    Hierarchical cpu profiler. Put s_profile("name") at the beginning of a
+    scope to measure it, the name must be a string literal (or any other
+    string which lives until the end of the application):
+
+    @code
+    void FrameBatch::Render()
+    {
+        s_profile("FrameBatch::Render");
+        ...
+    }
+    @endcode
+
+    Every thread writes the begin and end time stamps of its scopes into
+    its own ring buffer without any locking, so markers may be used from
+    any thread. The buffer of a thread is created when it enters its first
+    marker and is labeled with Threading::Thread::GetMyThreadName().
+    While the profiler is disabled (the default) a marker costs a single
+    test of a global flag, without STELLAR_ENABLE_PROFILING it compiles to
+    nothing at all.
+
+    Call NextFrame() once per frame from the main thread. It collects the
+    records of all threads and updates the min/avg/max time per frame of
+    every marker. Between BeginCapture() and EndCapture() the records are
+    kept as well, and can then be written as a Chrome trace_event JSON
+    file which can be loaded into chrome://tracing for offline analysis.
+
+    If a ring buffer overflows because NextFrame() isn't called often
+    enough, new records are dropped and counted.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "core/ptr.h"
+#include "utility/array.h"
+#include "utility/string.h"
+#include "io/stream.h"
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class Profiler
+{
+public:
+    /// a high resolution time stamp
+    typedef long long Ticks;
+    /// number of records in the ring buffer of a thread (power of 2)
+    static const SizeT RingBufferSize = 8192;
+    /// maximum number of records kept by a capture
+    static const SizeT MaxNumCaptureRecords = 1 << 20;
+
+    /// timing statistics of a marker, times are in seconds
+    struct MarkerStats
+    {
+        /// get average time per frame
+        double GetAvgTime() const;
+
+        const char* name;
+        SizeT depth;            // nesting depth where the marker was first hit
+        SizeT numFrames;        // number of frames in which the marker was hit
+        SizeT lastFrameCalls;   // number of calls in the last frame it was hit
+        double lastFrameTime;   // time in the last frame it was hit
+        double minTime;
+        double maxTime;
+        double totalTime;
+
+        // accumulated in the current frame
+        SizeT frameCalls;
+        double frameTime;
+    };
+
+    /// enable or disable recording
+    static void SetEnabled(bool b);
+    /// return true if recording is enabled
+    static bool IsEnabled();
+    /// collect the records of all threads and finish the frame's statistics
+    static void NextFrame();
+    /// get the statistics of all markers
+    static const Util::Array<MarkerStats>& GetMarkerStats();
+    /// reset the statistics of all markers
+    static void ResetStats();
+    /// get number of records dropped because a ring buffer was full
+    static SizeT GetNumDroppedRecords();
+
+    /// start keeping records for a Chrome trace
+    static void BeginCapture();
+    /// stop keeping records
+    static void EndCapture();
+    /// return true if a capture is running
+    static bool IsCapturing();
+    /// get the number of captured records
+    static SizeT GetNumCapturedRecords();
+    /// build a Chrome trace_event JSON document from the captured records
+    static Util::String BuildChromeTrace();
+    /// write the Chrome trace_event JSON document to an open stream
+    static void WriteChromeTrace(const Ptr<IO::Stream>& stream);
+
+    /// get the current time stamp
+    static Ticks GetTicks();
+    /// get the number of ticks per second
+    static Ticks GetTicksPerSecond();
+
+private:
+    friend class ProfileScope;
+
+    /// called when a scope is entered, returns its nesting depth
+    static int EnterScope();
+    /// called when a scope is left, writes the record
+    static void LeaveScope(const char* name, Ticks start, int depth);
+    /// move the records from the ring buffers into the stats and the capture
+    static void CollectRecords();
+    /// find or add the stats of a marker
+    static IndexT FindMarkerStats(const char* name, int depth);
+
+    static bool volatile Enabled;
+};
+
+//------------------------------------------------------------------------------
+/**
+    Measures the time between its construction and destruction, see
+    s_profile().
+*/
+class ProfileScope
+{
+public:
+    /// constructor, enters the scope
+    ProfileScope(const char* name);
+    /// destructor, leaves the scope
+    ~ProfileScope();
+
+private:
+    const char* name;
+    Profiler::Ticks start;
+    int depth;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+Profiler::IsEnabled()
+{
+    return Enabled;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline double
+Profiler::MarkerStats::GetAvgTime() const
+{
+    return (this->numFrames > 0) ? (this->totalTime / this->numFrames) : 0.0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline Profiler::Ticks
+Profiler::GetTicks()
+{
+    #if __WIN32__
+    LARGE_INTEGER ticks;
+    QueryPerformanceCounter(&ticks);
+    return ticks.QuadPart;
+    #else
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (Ticks)t.tv_sec * 1000000000 + t.tv_nsec;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+    A depth of -1 marks a scope entered while the profiler was disabled.
+*/
+inline
+ProfileScope::ProfileScope(const char* n) :
+    name(n),
+    start(0),
+    depth(-1)
+{
+    if (Profiler::Enabled)
+    {
+        this->depth = Profiler::EnterScope();
+        this->start = Profiler::GetTicks();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+ProfileScope::~ProfileScope()
+{
+    if (this->depth >= 0)
+    {
+        Profiler::LeaveScope(this->name, this->start, this->depth);
+    }
+}
+
+} // namespace Debug
+
+#if STELLAR_ENABLE_PROFILING
+#define s_profile_concat2(a, b) a##b
+#define s_profile_concat(a, b) s_profile_concat2(a, b)
+#define s_profile(name) Debug::ProfileScope s_profile_concat(profileScope, __LINE__)(name)
+#else
+#define s_profile(name)
+#endif
+//------------------------------------------------------------------------------
+#endif
@@ -17,7 +17,9 @@ using namespace Core;
 */
 FileStream::FileStream() :
     handle(0),
-    mappedContent(0)
+    mappedContent(0),
+    mappedSize(0),
+    mappedByCopy(false)
 {
     // empty
 }
@@ -200,6 +202,10 @@ FileStream::Eof() const
 
 //------------------------------------------------------------------------------
 /**
+    Maps the file read-only into memory. The file is mapped directly by
+    the operating system, so no data is read until it is accessed. Only
+    if the filesystem wrapper can't map the file (e.g. because it has
+    been opened for writing only) the content is copied into a buffer.
 */
 void*
 FileStream::Map()
@@ -208,10 +214,16 @@ FileStream::Map()
     
     Size size = this->GetSize();
     s_assert(size > 0);
-    this->mappedContent = Memory::Alloc(size);
-    this->Seek(0, Begin);
-    Size readSize = this->Read(this->mappedContent, size);
-    s_assert(readSize == size);
+    this->mappedSize = size;
+    this->mappedContent = Internal::FSWrapper::Map(this->handle, size, this->accessPattern);
+    this->mappedByCopy = (0 == this->mappedContent);
+    if (this->mappedByCopy)
+    {
+        this->mappedContent = Memory::Alloc(size);
+        this->Seek(0, Begin);
+        Size readSize = this->Read(this->mappedContent, size);
+        s_assert(readSize == size);
+    }
     Stream::Map();
     return this->mappedContent;
 }
@@ -224,8 +236,17 @@ FileStream::Unmap()
 {
     s_assert(0 != this->mappedContent);
     Stream::Unmap();
-    Memory::Free(this->mappedContent);
+    if (this->mappedByCopy)
+    {
+        Memory::Free(this->mappedContent);
+    }
+    else
+    {
+        Internal::FSWrapper::Unmap(this->handle, this->mappedContent, this->mappedSize);
+    }
     this->mappedContent = 0;
+    this->mappedSize = 0;
+    this->mappedByCopy = false;
 }
 
 } // namespace IO
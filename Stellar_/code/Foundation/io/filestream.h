@@ -59,6 +59,8 @@ public:
 private:
     Internal::FSWrapper::Handle handle;
     void* mappedContent;
+    Size mappedSize;
+    bool mappedByCopy;
 };
 
 } // namespace IO
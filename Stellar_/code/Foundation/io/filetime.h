@@ -17,6 +17,13 @@ namespace IO
 class FileTime : public Win32::Win32FileTime
 { };
 }
+#elif __POSIX__
+#include "io/posix/posixfiletime.h"
+namespace IO
+{
+class FileTime : public Posix::PosixFileTime
+{ };
+}
 #else
 #error "FileTime class not implemented on this platform!"
 #endif
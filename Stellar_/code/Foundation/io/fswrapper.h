@@ -19,6 +19,13 @@ namespace Internal
 class FSWrapper : public Win32::Win32FSWrapper
 { };
 }
+#elif __POSIX__
+#include "io/posix/posixfswrapper.h"
+namespace Internal
+{
+class FSWrapper : public Posix::PosixFSWrapper
+{ };
+}
 #else
 #error "FSWrapper class not implemented on this platform!"
 #endif
@@ -0,0 +1,85 @@
+#pragma once
+#ifndef POSIX_POSIXFILETIME_H
+#define POSIX_POSIXFILETIME_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixFileTime
+    
+    Implements a Posix-specific file-access time stamp.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixFileTime
+{
+public:
+    /// constructor
+    PosixFileTime();
+    /// operator ==
+    friend bool operator==(const PosixFileTime& a, const PosixFileTime& b);
+    /// operator !=
+    friend bool operator!=(const PosixFileTime& a, const PosixFileTime& b);
+    /// operator >
+    friend bool operator>(const PosixFileTime& a, const PosixFileTime& b);
+    /// operator <
+    friend bool operator<(const PosixFileTime& a, const PosixFileTime& b);
+
+private:
+    friend class PosixFSWrapper;
+
+    time_t time;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+PosixFileTime::PosixFileTime() :
+    time(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool 
+operator==(const PosixFileTime& a, const PosixFileTime& b)
+{
+    return a.time == b.time;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool 
+operator!=(const PosixFileTime& a, const PosixFileTime& b)
+{
+    return a.time != b.time;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+operator>(const PosixFileTime& a, const PosixFileTime& b)
+{
+    return a.time > b.time;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+operator <(const PosixFileTime& a, const PosixFileTime& b)
+{
+    return a.time < b.time;
+}
+
+}; // namespace Posix
+//------------------------------------------------------------------------------
+#endif
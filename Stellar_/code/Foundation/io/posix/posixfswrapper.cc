@@ -0,0 +1,418 @@
+//------------------------------------------------------------------------------
+//  posixfswrapper.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "io/posix/posixfswrapper.h"
+
+namespace Posix
+{
+
+using namespace Util;
+using namespace Core;
+using namespace IO;
+
+//------------------------------------------------------------------------------
+/**
+    Open a file using fopen(). Returns a handle to the file which must be
+    passed to the other PosixFSWrapper file methods. If opening the file
+    fails, the function will return 0. The filename must be a native
+    Posix path (no assigns, etc...). The access pattern is passed on to
+    the kernel's read-ahead through posix_fadvise() where available.
+*/
+PosixFSWrapper::Handle
+PosixFSWrapper::OpenFile(const String& path, Stream::AccessMode accessMode, Stream::AccessPattern accessPattern)
+{
+    Handle handle = 0;
+    switch (accessMode)
+    {
+        case Stream::ReadAccess:
+            handle = fopen(path.c_str(), "rb");
+            break;
+
+        case Stream::WriteAccess:
+            handle = fopen(path.c_str(), "wb");
+            break;
+
+        case Stream::ReadWriteAccess:
+        case Stream::AppendAccess:
+            // same as Win32's OPEN_ALWAYS: open existing or create new
+            handle = fopen(path.c_str(), "r+b");
+            if (0 == handle)
+            {
+                handle = fopen(path.c_str(), "w+b");
+            }
+            break;
+    }
+    if (0 != handle)
+    {
+        #if defined(POSIX_FADV_RANDOM)
+        int advice = (Stream::Random == accessPattern) ? POSIX_FADV_RANDOM : POSIX_FADV_SEQUENTIAL;
+        posix_fadvise(fileno(handle), 0, 0, advice);
+        #endif
+
+        // in append mode, we need to seek to the end of the file
+        if (Stream::AppendAccess == accessMode)
+        {
+            fseek(handle, 0, SEEK_END);
+        }
+    }
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Closes a file opened by PosixFSWrapper::OpenFile().
+*/
+void
+PosixFSWrapper::CloseFile(Handle handle)
+{
+    s_assert(0 != handle);
+    fclose(handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Write data to a file.
+*/
+void
+PosixFSWrapper::Write(Handle handle, const void* buf, Stream::Size numBytes)
+{
+    s_assert(0 != handle);
+    s_assert(buf != 0);
+    s_assert(numBytes > 0);
+    size_t bytesWritten = fwrite(buf, 1, numBytes, handle);
+    if ((size_t)numBytes != bytesWritten)
+    {
+        s_error("PosixFSWrapper: fwrite() failed with '%s'", strerror(errno));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Read data from a file, returns number of bytes read.
+*/
+Stream::Size
+PosixFSWrapper::Read(Handle handle, void* buf, Stream::Size numBytes)
+{
+    s_assert(0 != handle);
+    s_assert(buf != 0);
+    s_assert(numBytes > 0);
+    size_t bytesRead = fread(buf, 1, numBytes, handle);
+    if (ferror(handle))
+    {
+        s_error("PosixFSWrapper: fread() failed with '%s'", strerror(errno));
+    }
+    return (Stream::Size) bytesRead;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Seek in a file.
+*/
+void
+PosixFSWrapper::Seek(Handle handle, Stream::Offset offset, Stream::SeekOrigin orig)
+{
+    s_assert(0 != handle);
+    int whence;
+    switch (orig)
+    {
+        case Stream::Begin:
+            whence = SEEK_SET;
+            break;
+        case Stream::Current:
+            whence = SEEK_CUR;
+            break;
+        case Stream::End:
+            whence = SEEK_END;
+            break;
+        default:
+            // can't happen
+            whence = SEEK_SET;
+            break;
+    }
+    fseek(handle, offset, whence);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get current position in file.
+*/
+Stream::Position
+PosixFSWrapper::Tell(Handle handle)
+{
+    s_assert(0 != handle);
+    return (Stream::Position) ftell(handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Flush unwritten data to file.
+*/
+void
+PosixFSWrapper::Flush(Handle handle)
+{
+    s_assert(0 != handle);
+    fflush(handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns true if current position is at end of file. Like the Win32
+    version this compares against the file size instead of using feof(),
+    which only turns true after a read went past the end.
+*/
+bool
+PosixFSWrapper::Eof(Handle handle)
+{
+    s_assert(0 != handle);
+    long fpos = ftell(handle);
+    long size = PosixFSWrapper::GetFileSize(handle);
+
+    // NOTE: THE '>=' IS NOT A BUG!!!
+    return fpos >= size;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns the size of a file in bytes.
+*/
+Stream::Size
+PosixFSWrapper::GetFileSize(Handle handle)
+{
+    s_assert(0 != handle);
+    fflush(handle);
+    struct stat fileStat;
+    if (0 != fstat(fileno(handle), &fileStat))
+    {
+        return 0;
+    }
+    return (Stream::Size) fileStat.st_size;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Map the whole file read-only into the address space. Pages are only
+    read from disk when touched, and the kernel is told through madvise()
+    whether to read ahead aggressively (Sequential) or not at all (Random).
+    Returns 0 if the file can't be mapped (for instance because it was
+    opened without read access), the caller is expected to fall back to
+    reading the file.
+*/
+void*
+PosixFSWrapper::Map(Handle handle, Stream::Size size, Stream::AccessPattern accessPattern)
+{
+    s_assert(0 != handle);
+    s_assert(size > 0);
+
+    // make sure buffered writes are visible through the mapping
+    fflush(handle);
+    void* ptr = mmap(0, size, PROT_READ, MAP_PRIVATE, fileno(handle), 0);
+    if (MAP_FAILED == ptr)
+    {
+        return 0;
+    }
+    if (Stream::Random == accessPattern)
+    {
+        madvise(ptr, size, MADV_RANDOM);
+    }
+    else
+    {
+        madvise(ptr, size, MADV_SEQUENTIAL);
+        madvise(ptr, size, MADV_WILLNEED);
+    }
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Unmap a file mapped by PosixFSWrapper::Map().
+*/
+void
+PosixFSWrapper::Unmap(Handle handle, void* ptr, Stream::Size size)
+{
+    s_assert(0 != handle);
+    s_assert(0 != ptr);
+    s_assert(size > 0);
+    munmap(ptr, size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Set the read-only status of a file. This clears or restores the write
+    permission bits of user, group and others.
+*/
+void
+PosixFSWrapper::SetReadOnly(const String& path, bool readOnly)
+{
+    s_assert(!path.empty());
+    struct stat fileStat;
+    if (0 == stat(path.c_str(), &fileStat))
+    {
+        mode_t mode = fileStat.st_mode;
+        if (readOnly)
+        {
+            mode &= ~(S_IWUSR | S_IWGRP | S_IWOTH);
+        }
+        else
+        {
+            mode |= S_IWUSR;
+        }
+        chmod(path.c_str(), mode);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the read-only status of a file.
+*/
+bool
+PosixFSWrapper::IsReadOnly(const String& path)
+{
+    s_assert(!path.empty());
+    return (0 != access(path.c_str(), F_OK)) ? false : (0 != access(path.c_str(), W_OK));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Deletes a file. Returns true if the operation was successful. The delete
+    will fail if the fail doesn't exist or the file is read-only.
+*/
+bool
+PosixFSWrapper::DeleteFile(const String& path)
+{
+    s_assert(!path.empty());
+    if (PosixFSWrapper::IsReadOnly(path))
+    {
+        return false;
+    }
+    return (0 == unlink(path.c_str()));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Delete an empty directory. Returns true if the operation was successful.
+*/
+bool
+PosixFSWrapper::DeleteDirectory(const String& path)
+{
+    s_assert(!path.empty());
+    return (0 == rmdir(path.c_str()));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return true if a file exists.
+*/
+bool
+PosixFSWrapper::FileExists(const String& path)
+{
+    s_assert(!path.empty());
+    struct stat fileStat;
+    return (0 == stat(path.c_str(), &fileStat)) && S_ISREG(fileStat.st_mode);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return true if a directory exists.
+*/
+bool
+PosixFSWrapper::DirectoryExists(const String& path)
+{
+    s_assert(!path.empty());
+    struct stat fileStat;
+    return (0 == stat(path.c_str(), &fileStat)) && S_ISDIR(fileStat.st_mode);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return the last write-access time to a file.
+*/
+FileTime
+PosixFSWrapper::GetFileWriteTime(const String& path)
+{
+    s_assert(!path.empty());
+    FileTime fileTime;
+    struct stat fileStat;
+    if (0 == stat(path.c_str(), &fileStat))
+    {
+        fileTime.time = fileStat.st_mtime;
+    }
+    else
+    {
+        s_error("PosixFSWrapper::GetFileWriteTime(): failed to stat file '%s'!", path.c_str());
+    }
+    return fileTime;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Creates a new directory.
+*/
+bool
+PosixFSWrapper::CreateDirectory(const String& path)
+{
+    s_assert(!path.empty());
+    return (0 == mkdir(path.c_str(), 0777));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Lists all files in a directory, filtered by a pattern.
+*/
+Array<String>
+PosixFSWrapper::ListFiles(const String& dirPath, const String& pattern)
+{
+    return PosixFSWrapper::ListEntries(dirPath, pattern, false);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Lists all subdirectories in a directory, filtered by a pattern. This will
+    not return the special directories ".." and ".".
+*/
+Array<String>
+PosixFSWrapper::ListDirectories(const String& dirPath, const String& pattern)
+{
+    return PosixFSWrapper::ListEntries(dirPath, pattern, true);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Common implementation of ListFiles() and ListDirectories(). The pattern
+    is matched with fnmatch(), which understands the same wildcards as
+    Win32's FindFirstFile().
+*/
+Array<String>
+PosixFSWrapper::ListEntries(const String& dirPath, const String& pattern, bool directories)
+{
+    s_assert(!dirPath.empty());
+    s_assert(!pattern.empty());
+
+    Array<String> result;
+    DIR* dir = opendir(dirPath.c_str());
+    if (0 != dir)
+    {
+        struct dirent* entry;
+        while (0 != (entry = readdir(dir)))
+        {
+            if ((0 == strcmp(entry->d_name, "..")) ||
+                (0 == strcmp(entry->d_name, ".")) ||
+                (0 != fnmatch(pattern.c_str(), entry->d_name, 0)))
+            {
+                continue;
+            }
+            String entryPath = dirPath + "/" + entry->d_name;
+            struct stat entryStat;
+            if ((0 == stat(entryPath.c_str(), &entryStat)) &&
+                (directories == S_ISDIR(entryStat.st_mode)))
+            {
+                result.push_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+    return result;
+}
+
+} // namespace Posix
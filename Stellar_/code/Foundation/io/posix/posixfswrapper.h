@@ -0,0 +1,78 @@
+#pragma once
+#ifndef POSIX_POSIXFSWRAPPER_H
+#define POSIX_POSIXFSWRAPPER_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixFSWrapper
+
+    Internal filesystem wrapper for Posix platforms. All paths must be
+    native Posix paths. Files are accessed through stdio, mapping goes
+    through mmap() on the underlying file descriptor.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "utility/string.h"
+#include "utility/array.h"
+#include "io/stream.h"
+#include "io/filetime.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixFSWrapper
+{
+public:
+    typedef FILE* Handle;
+
+    /// open a file
+    static Handle OpenFile(const Util::String& path, IO::Stream::AccessMode accessMode, IO::Stream::AccessPattern accessPattern);
+    /// close a file
+    static void CloseFile(Handle h);
+    /// write to a file
+    static void Write(Handle h, const void* buf, IO::Stream::Size numBytes);
+    /// read from a file
+    static IO::Stream::Size Read(Handle h, void* buf, IO::Stream::Size numBytes);
+    /// seek in a file
+    static void Seek(Handle h, IO::Stream::Offset offset, IO::Stream::SeekOrigin orig);
+    /// get position in file
+    static IO::Stream::Position Tell(Handle h);
+    /// flush a file
+    static void Flush(Handle h);
+    /// return true if at end-of-file
+    static bool Eof(Handle h);
+    /// get size of a file in bytes
+    static IO::Stream::Size GetFileSize(Handle h);
+    /// map a file read-only into memory, returns 0 if the file can't be mapped
+    static void* Map(Handle h, IO::Stream::Size size, IO::Stream::AccessPattern accessPattern);
+    /// unmap a file mapped by Map()
+    static void Unmap(Handle h, void* ptr, IO::Stream::Size size);
+    /// set read-only status of a file
+    static void SetReadOnly(const Util::String& path, bool readOnly);
+    /// get read-only status of a file
+    static bool IsReadOnly(const Util::String& path);
+    /// delete a file
+    static bool DeleteFile(const Util::String& path);
+    /// delete an empty directory
+    static bool DeleteDirectory(const Util::String& path);
+    /// return true if a file exists
+    static bool FileExists(const Util::String& path);
+    /// return true if a directory exists
+    static bool DirectoryExists(const Util::String& path);
+    /// get the last write-access time stamp of a file
+    static IO::FileTime GetFileWriteTime(const Util::String& path);
+    /// create a directory
+    static bool CreateDirectory(const Util::String& path);
+    /// list all files in a directory
+    static Util::Array<Util::String> ListFiles(const Util::String& dirPath, const Util::String& pattern);
+    /// list all subdirectories in a directory
+    static Util::Array<Util::String> ListDirectories(const Util::String& dirPath, const Util::String& pattern);
+
+private:
+    /// list directory entries of the given kind matching a pattern
+    static Util::Array<Util::String> ListEntries(const Util::String& dirPath, const Util::String& pattern, bool directories);
+};
+
+}; // namespace Posix
+//------------------------------------------------------------------------------
+#endif
@@ -18,7 +18,7 @@
 //#include "io/uri.h"
 #include "thread/criticalsection.h"
 //#include "io/mediatype.h"
-#include "Utility/string.h"
+#include "utility/string.h"
 
 //------------------------------------------------------------------------------
 namespace IO
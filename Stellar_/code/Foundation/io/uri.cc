@@ -224,6 +224,8 @@ URI::ParseQuery() const
 {
     Dictionary<String,String> result;
     Array<String> keyValuePairs = Tokenize(query, "&");
+    result.Reserve(keyValuePairs.Size());
+    result.BeginBulkAdd();
     IndexT i;
     for (i = 0; i < keyValuePairs.Size(); i++)
     {
@@ -233,6 +235,7 @@ URI::ParseQuery() const
             result.Add(keyValueTokens[0], keyValueTokens[1]);
         }
     }
+    result.EndBulkAdd();
     return result;
 }
 
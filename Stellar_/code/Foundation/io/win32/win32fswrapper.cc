@@ -206,6 +206,42 @@ Win32FSWrapper::GetFileSize(Handle handle)
     return ::GetFileSize(handle, NULL);
 }
 
+//------------------------------------------------------------------------------
+/**
+    Map the whole file read-only into the address space. The mapping object
+    can be closed right away, the view keeps it alive until it is unmapped.
+    The access pattern has already been passed to CreateFile() as a cache
+    hint, so it is not needed here. Returns 0 if the file can't be mapped
+    (for instance because it was opened without read access), the
+    caller is expected to fall back to reading the file.
+*/
+void*
+Win32FSWrapper::Map(Handle handle, Stream::Size size, Stream::AccessPattern accessPattern)
+{
+    s_assert(0 != handle);
+    s_assert(size > 0);
+    HANDLE mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == mapping)
+    {
+        return 0;
+    }
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Unmap a file mapped by Win32FSWrapper::Map().
+*/
+void
+Win32FSWrapper::Unmap(Handle handle, void* ptr, Stream::Size size)
+{
+    s_assert(0 != handle);
+    s_assert(0 != ptr);
+    UnmapViewOfFile(ptr);
+}
+
 //------------------------------------------------------------------------------
 /**
     Set the read-only status of a file.
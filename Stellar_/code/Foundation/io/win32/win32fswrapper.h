@@ -42,6 +42,10 @@ public:
     static bool Eof(Handle h);
     /// get size of a file in bytes
     static IO::Stream::Size GetFileSize(Handle h);
+    /// map a file read-only into memory, returns 0 if the file can't be mapped
+    static void* Map(Handle h, IO::Stream::Size size, IO::Stream::AccessPattern accessPattern);
+    /// unmap a file mapped by Map()
+    static void Unmap(Handle h, void* ptr, IO::Stream::Size size);
     /// set read-only status of a file
     static void SetReadOnly(const Util::String& path, bool readOnly);
     /// get read-only status of a file
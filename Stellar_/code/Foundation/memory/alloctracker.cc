@@ -0,0 +1,381 @@
+//------------------------------------------------------------------------------
+//  alloctracker.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/alloctracker.h"
+#include "thread/interlocked.h"
+#include <math.h>
+
+namespace Memory
+{
+using namespace Threading;
+
+namespace
+{
+/// a sampled block
+struct Block
+{
+    void* ptr;              // 0 marks an unused slot
+    unsigned int siteIndex;
+    double weight;          // number of blocks the sample stands in for
+    double bytes;           // number of bytes the sample stands in for
+};
+
+/// the sampled blocks of a shard, an open addressing hash table
+struct BlockShard
+{
+    int volatile lock;
+    unsigned int numBlocks;
+    Block blocks[AllocTracker::MaxNumBlocksPerShard];
+};
+
+/// the sites of a shard, an open addressing hash table, sites are never removed
+struct SiteShard
+{
+    int volatile lock;
+    unsigned int numSites;
+    AllocTracker::Site sites[AllocTracker::MaxNumSitesPerShard];
+};
+
+// all tables are zero initialized static data, so allocations can
+// be tracked before any constructor has run
+BlockShard BlockShards[AllocTracker::NumShards];
+SiteShard SiteShards[AllocTracker::NumShards];
+int volatile SampleInterval = AllocTracker::DefaultSampleInterval;
+int volatile NumDroppedSamples = 0;
+
+#if __WIN32__
+__declspec(thread) unsigned int RandomState = 0;
+#else
+__thread unsigned int RandomState = 0;
+#endif
+
+/// the countdown while tracking is switched off, so a new interval is picked up eventually
+const int DisabledCountdown = 1 << 20;
+
+//------------------------------------------------------------------------------
+/**
+    Sampling is rare, so a simple spin lock is good enough.
+*/
+void
+Lock(int volatile& lock)
+{
+    while (0 != Interlocked::CompareExchange(lock, 1, 0))
+    {
+        #if __WIN32__
+        SwitchToThread();
+        #else
+        sched_yield();
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Unlock(int volatile& lock)
+{
+    Interlocked::Exchange(lock, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns a random number in (0, 1]. Every thread has its own xorshift
+    generator, seeded from the address of its state.
+*/
+double
+Random()
+{
+    unsigned int x = RandomState;
+    if (0 == x)
+    {
+        x = (unsigned int) ((size_t) &RandomState >> 4) * 0x9e3779b1u | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    RandomState = x;
+    return (double(x >> 8) + 1.0) / double(1 << 24);
+}
+
+//------------------------------------------------------------------------------
+/**
+    The distance between two samples is exponentially distributed, so
+    the samples form a Poisson process over the allocated bytes and the
+    probability that a block is sampled only depends on its size.
+*/
+int
+NextCountdown(int interval)
+{
+    double countdown = -log(Random()) * interval;
+    return (countdown < double(1 << 30)) ? int(countdown) : (1 << 30);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+unsigned int
+HashSite(const void* callsite, const char* tag, const char* heapName)
+{
+    size_t h = (size_t) callsite;
+    h = h * 31 + (size_t) tag;
+    h = h * 31 + (size_t) heapName;
+    return (unsigned int) ((h >> 2) ^ (h >> 18)) * 0x9e3779b1u;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Finds or adds a site and adds a sample to its stats. Returns
+    InvalidSite if the site table of the shard is full.
+*/
+const unsigned int InvalidSite = 0xffffffff;
+
+unsigned int
+AddToSite(const void* callsite, const char* tag, const char* heapName, double weight, double bytes)
+{
+    unsigned int hash = HashSite(callsite, tag, heapName);
+    unsigned int shardIndex = (hash >> 16) & (AllocTracker::NumShards - 1);
+    SiteShard& shard = SiteShards[shardIndex];
+    const unsigned int mask = AllocTracker::MaxNumSitesPerShard - 1;
+
+    Lock(shard.lock);
+    unsigned int slot = hash & mask;
+    for (;;)
+    {
+        AllocTracker::Site& site = shard.sites[slot];
+        if (0 == site.heapName)
+        {
+            // keep a free slot so the probing always terminates
+            if (shard.numSites >= mask)
+            {
+                Unlock(shard.lock);
+                return InvalidSite;
+            }
+            site.callsite = callsite;
+            site.tag = tag;
+            site.heapName = heapName;
+            shard.numSites++;
+        }
+        if ((site.callsite == callsite) && (site.tag == tag) && (site.heapName == heapName))
+        {
+            site.liveBytes += bytes;
+            site.liveCount += weight;
+            site.totalBytes += bytes;
+            site.totalCount += weight;
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    Unlock(shard.lock);
+    return shardIndex * AllocTracker::MaxNumSitesPerShard + slot;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+RemoveFromSite(unsigned int siteIndex, double weight, double bytes)
+{
+    SiteShard& shard = SiteShards[siteIndex / AllocTracker::MaxNumSitesPerShard];
+    Lock(shard.lock);
+    AllocTracker::Site& site = shard.sites[siteIndex & (AllocTracker::MaxNumSitesPerShard - 1)];
+    site.liveBytes -= bytes;
+    site.liveCount -= weight;
+    Unlock(shard.lock);
+}
+
+} // namespace
+
+#if __WIN32__
+__declspec(thread) int AllocTracker::BytesUntilSample = 0;
+__declspec(thread) const char* AllocTracker::Tag = 0;
+#else
+__thread int AllocTracker::BytesUntilSample = 0;
+__thread const char* AllocTracker::Tag = 0;
+#endif
+unsigned short volatile AllocTracker::FreeFilter[AllocTracker::FilterSize];
+
+//------------------------------------------------------------------------------
+/**
+    The calling thread starts over with the new interval, other threads
+    pick it up with their next sample.
+*/
+void
+AllocTracker::SetSampleInterval(unsigned int bytes)
+{
+    s_assert(bytes < (1 << 30));
+    Interlocked::Exchange(SampleInterval, int(bytes));
+    BytesUntilSample = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+unsigned int
+AllocTracker::GetSampleInterval()
+{
+    return SampleInterval;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+unsigned int
+AllocTracker::GetNumDroppedSamples()
+{
+    return NumDroppedSamples;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Called when the countdown of the thread has run out. The countdown
+    of a new thread starts at 0, so its first allocation starts a new
+    countdown, and is only sampled if that countdown runs out as well.
+*/
+void
+AllocTracker::SampleAlloc(void* ptr, size_t size, const char* heapName, const void* callsite)
+{
+    int interval = SampleInterval;
+    if (0 == interval)
+    {
+        BytesUntilSample = DisabledCountdown;
+        return;
+    }
+    if (BytesUntilSample + int(size) <= 0)
+    {
+        // the first allocation of a new thread or after SetSampleInterval()
+        BytesUntilSample = NextCountdown(interval) - int(size);
+        if (BytesUntilSample >= 0)
+        {
+            return;
+        }
+    }
+    BytesUntilSample = NextCountdown(interval);
+    if (0 == ptr)
+    {
+        return;
+    }
+
+    // the probability that a block of this size has been sampled
+    double p = 1.0 - exp(-double(size) / interval);
+    double weight = (p > 0.0) ? (1.0 / p) : 1.0;
+    double bytes = weight * size;
+
+    unsigned int siteIndex = AddToSite(callsite, Tag, heapName, weight, bytes);
+    if (InvalidSite == siteIndex)
+    {
+        Interlocked::Increment(NumDroppedSamples);
+        return;
+    }
+
+    unsigned int hash = HashPointer(ptr);
+    unsigned int filterIndex = hash >> 16;
+    BlockShard& shard = BlockShards[filterIndex & (NumShards - 1)];
+    const unsigned int mask = MaxNumBlocksPerShard - 1;
+
+    Lock(shard.lock);
+    if (shard.numBlocks >= (MaxNumBlocksPerShard / 4) * 3)
+    {
+        Unlock(shard.lock);
+        RemoveFromSite(siteIndex, weight, bytes);
+        Interlocked::Increment(NumDroppedSamples);
+        return;
+    }
+    unsigned int slot = hash & mask;
+    while (0 != shard.blocks[slot].ptr)
+    {
+        slot = (slot + 1) & mask;
+    }
+    Block& block = shard.blocks[slot];
+    block.ptr = ptr;
+    block.siteIndex = siteIndex;
+    block.weight = weight;
+    block.bytes = bytes;
+    shard.numBlocks++;
+    FreeFilter[filterIndex]++;
+    Unlock(shard.lock);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Called when the free filter says the block may have been sampled.
+    The slot of the removed block is filled by moving later blocks of the
+    same probe sequence back, so no tombstones are needed.
+*/
+void
+AllocTracker::SampleFree(void* ptr)
+{
+    unsigned int hash = HashPointer(ptr);
+    unsigned int filterIndex = hash >> 16;
+    BlockShard& shard = BlockShards[filterIndex & (NumShards - 1)];
+    const unsigned int mask = MaxNumBlocksPerShard - 1;
+
+    Lock(shard.lock);
+    unsigned int slot = hash & mask;
+    while ((0 != shard.blocks[slot].ptr) && (ptr != shard.blocks[slot].ptr))
+    {
+        slot = (slot + 1) & mask;
+    }
+    if (0 == shard.blocks[slot].ptr)
+    {
+        // another block with the same filter counter has been sampled
+        Unlock(shard.lock);
+        return;
+    }
+    Block removed = shard.blocks[slot];
+    unsigned int hole = slot;
+    for (;;)
+    {
+        slot = (slot + 1) & mask;
+        void* p = shard.blocks[slot].ptr;
+        if (0 == p)
+        {
+            break;
+        }
+        // move the block into the hole if the hole lies between its home slot and its slot
+        unsigned int home = HashPointer(p) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            shard.blocks[hole] = shard.blocks[slot];
+            hole = slot;
+        }
+    }
+    shard.blocks[hole].ptr = 0;
+    shard.numBlocks--;
+    FreeFilter[filterIndex]--;
+    Unlock(shard.lock);
+
+    RemoveFromSite(removed.siteIndex, removed.weight, removed.bytes);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Copies the sites one shard at a time, the buffer must not be
+    allocated from a tracked heap while the locks are held, so it is
+    provided by the caller.
+*/
+unsigned int
+AllocTracker::CopySites(Site* buffer, unsigned int maxNumSites)
+{
+    unsigned int num = 0;
+    unsigned int shardIndex;
+    for (shardIndex = 0; shardIndex < NumShards; shardIndex++)
+    {
+        SiteShard& shard = SiteShards[shardIndex];
+        Lock(shard.lock);
+        unsigned int i;
+        for (i = 0; (i < MaxNumSitesPerShard) && (num < maxNumSites); i++)
+        {
+            if (0 != shard.sites[i].heapName)
+            {
+                buffer[num++] = shard.sites[i];
+            }
+        }
+        Unlock(shard.lock);
+    }
+    return num;
+}
+
+} // namespace Memory
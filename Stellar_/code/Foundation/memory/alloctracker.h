@@ -0,0 +1,225 @@
+#pragma once
+#ifndef MEMORY_ALLOCTRACKER_H
+#define MEMORY_ALLOCTRACKER_H
+//------------------------------------------------------------------------------
+/**
+    @class Memory::AllocTracker
+
+    Sampling allocation tracker which records where the memory is
+    allocated. Memory::Alloc() and Memory::Heap call OnAlloc() and
+    OnFree(), which are cheap enough to leave the tracker on in staging
+    builds. A reallocation is an OnFree() of the old block before the
+    block is given back and an OnAlloc() of the new block, so another
+    thread which gets the old address in the meantime can't lose its
+    sample.
+
+    Every thread counts down the bytes it allocates, when the counter runs
+    out the allocation is sampled and the counter is reset to a random
+    number of bytes with an average of the sample interval. Large blocks
+    are therefore (almost) always sampled, small ones only now and then.
+    A sampled block stands in for 1/p blocks of its size, where p is the
+    probability that a block of this size is sampled, so the live and total
+    bytes per site are unbiased estimates. A sample interval of 1 samples
+    every allocation, 0 switches the tracker off.
+
+    A site is the combination of the allocating call site, the current
+    allocation tag of the thread (see s_alloc_tag()) and the heap. The call
+    site is the return address of the function the allocation function was
+    inlined into, i.e. usually the caller of operator new or the caller of
+    the container method which grows its buffer.
+
+    Sampled blocks and sites are kept in static hash tables which are split
+    into shards with a lock of their own, so threads rarely wait for each
+    other. OnFree() first looks into a small counting filter, so freeing a
+    block which wasn't sampled doesn't take any lock. The tracker never
+    allocates memory itself.
+
+    See Debug::MemoryReport for snapshots and reports of the sites.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/config.h"
+#include <stddef.h>
+#if __WIN32__
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define s_return_address() _ReturnAddress()
+#else
+#define s_return_address() __builtin_return_address(0)
+#endif
+
+//------------------------------------------------------------------------------
+namespace Memory
+{
+class AllocTracker
+{
+public:
+    /// default average number of bytes between two samples
+    static const unsigned int DefaultSampleInterval = 512 * 1024;
+    /// number of lock shards of the hash tables (power of 2)
+    static const unsigned int NumShards = 16;
+    /// maximum number of sampled blocks alive at the same time, per shard (power of 2)
+    static const unsigned int MaxNumBlocksPerShard = 2048;
+    /// maximum number of sites, per shard (power of 2)
+    static const unsigned int MaxNumSitesPerShard = 256;
+    /// maximum number of sites
+    static const unsigned int MaxNumSites = NumShards * MaxNumSitesPerShard;
+
+    /// the estimated allocations of a site
+    struct Site
+    {
+        const void* callsite;   // return address, see class description
+        const char* tag;        // allocation tag or 0
+        const char* heapName;   // name of the heap, 0 marks an unused site
+        double liveBytes;       // estimated bytes currently allocated
+        double liveCount;       // estimated number of blocks currently allocated
+        double totalBytes;      // estimated bytes allocated since the start
+        double totalCount;      // estimated number of blocks allocated since the start
+    };
+
+    /// set the average number of bytes between two samples, 0 switches tracking off
+    static void SetSampleInterval(unsigned int bytes);
+    /// get the sample interval
+    static unsigned int GetSampleInterval();
+    /// copy the used sites into a buffer, returns the number of copied sites
+    static unsigned int CopySites(Site* buffer, unsigned int maxNumSites);
+    /// get number of samples dropped because the tables were full
+    static unsigned int GetNumDroppedSamples();
+
+    /// set the allocation tag of the current thread (must be a static string)
+    static void SetTag(const char* tag);
+    /// get the allocation tag of the current thread
+    static const char* GetTag();
+
+    /// called after a block has been allocated
+    static void OnAlloc(void* ptr, size_t size, const char* heapName, const void* callsite);
+    /// called before a block is freed
+    static void OnFree(void* ptr);
+
+private:
+    /// number of counters in the free filter, a multiple of NumShards
+    static const unsigned int FilterSize = 65536;
+
+    /// sample an allocation when the countdown has run out
+    static void SampleAlloc(void* ptr, size_t size, const char* heapName, const void* callsite);
+    /// remove a block which may have been sampled
+    static void SampleFree(void* ptr);
+    /// hash a block address
+    static unsigned int HashPointer(const void* ptr);
+
+    #if __WIN32__
+    static __declspec(thread) int BytesUntilSample;
+    static __declspec(thread) const char* Tag;
+    #else
+    static __thread int BytesUntilSample;
+    static __thread const char* Tag;
+    #endif
+    static unsigned short volatile FreeFilter[FilterSize];
+};
+
+//------------------------------------------------------------------------------
+/**
+    Sets an allocation tag for the current thread until the end of the
+    scope, see s_alloc_tag().
+*/
+class AllocTagScope
+{
+public:
+    /// constructor, sets the tag
+    AllocTagScope(const char* tag);
+    /// destructor, restores the previous tag
+    ~AllocTagScope();
+
+private:
+    const char* prevTag;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline unsigned int
+AllocTracker::HashPointer(const void* ptr)
+{
+    size_t p = (size_t) ptr;
+    return (unsigned int) ((p >> 4) ^ (p >> 20)) * 0x9e3779b1u;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+AllocTracker::OnAlloc(void* ptr, size_t size, const char* heapName, const void* callsite)
+{
+    #if STELLAR_MEMORY_TRACKING
+    if ((BytesUntilSample -= int(size)) < 0)
+    {
+        SampleAlloc(ptr, size, heapName, callsite);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+    The top bits of the hash select the filter counter, their low bits
+    select the shard, so every counter belongs to exactly one shard and
+    is only changed under its lock.
+*/
+inline void
+AllocTracker::OnFree(void* ptr)
+{
+    #if STELLAR_MEMORY_TRACKING
+    if (0 != FreeFilter[HashPointer(ptr) >> 16])
+    {
+        SampleFree(ptr);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+AllocTracker::SetTag(const char* t)
+{
+    Tag = t;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const char*
+AllocTracker::GetTag()
+{
+    return Tag;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+AllocTagScope::AllocTagScope(const char* tag) :
+    prevTag(AllocTracker::GetTag())
+{
+    AllocTracker::SetTag(tag);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+AllocTagScope::~AllocTagScope()
+{
+    AllocTracker::SetTag(this->prevTag);
+}
+
+} // namespace Memory
+
+#if STELLAR_MEMORY_TRACKING
+#define s_alloc_tag_concat2(a, b) a##b
+#define s_alloc_tag_concat(a, b) s_alloc_tag_concat2(a, b)
+#define s_alloc_tag(tag) Memory::AllocTagScope s_alloc_tag_concat(allocTagScope, __LINE__)(tag)
+#else
+#define s_alloc_tag(tag)
+#endif
+//------------------------------------------------------------------------------
+#endif
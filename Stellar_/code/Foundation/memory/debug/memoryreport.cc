@@ -0,0 +1,438 @@
+//------------------------------------------------------------------------------
+//  memoryreport.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/debug/memoryreport.h"
+#include "memory/heap.h"
+#include "io/filestream.h"
+#include "thread/criticalsection.h"
+#if __WIN32__
+#pragma comment(lib, "dbghelp.lib")
+#else
+#include <dlfcn.h>
+#include <cxxabi.h>
+#endif
+
+namespace Debug
+{
+using namespace Util;
+using namespace Memory;
+
+namespace
+{
+//------------------------------------------------------------------------------
+/**
+    Orders sites by heap, symbol and tag.
+*/
+int
+CompareSites(const MemoryReport::SiteStats& a, const MemoryReport::SiteStats& b)
+{
+    int res = a.heapName.compare(b.heapName);
+    if (0 == res)
+    {
+        res = a.symbol.compare(b.symbol);
+        if (0 == res)
+        {
+            res = a.tag.compare(b.tag);
+        }
+    }
+    return res;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+SiteLess(const MemoryReport::SiteStats& a, const MemoryReport::SiteStats& b)
+{
+    return CompareSites(a, b) < 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+AppendLine(String& str, const char* fmt, ...)
+{
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    #if __WIN32__
+    StringCchVPrintf(buf, sizeof(buf), fmt, args);
+    #else
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    #endif
+    va_end(args);
+    str.append(buf);
+    str.append(1, '\n');
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+AppendSite(String& str, const char* numbers, const MemoryReport::SiteStats& site)
+{
+    str.append(numbers);
+    str.append("  ");
+    str.append(site.heapName);
+    str.append(1, ' ');
+    str.append(site.symbol);
+    if (!site.tag.empty())
+    {
+        str.append(" [");
+        str.append(site.tag);
+        str.append("]");
+    }
+    str.append(1, '\n');
+}
+
+//------------------------------------------------------------------------------
+/**
+    Live estimates of sites whose blocks have all been freed may end up
+    slightly below zero because of rounding errors.
+*/
+double
+Live(double value)
+{
+    return (value < 0.5) ? 0.0 : value;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+MemoryReport::MemoryReport() :
+    numSnapshots(0),
+    period(0),
+    numUpdates(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+    The raw sites are copied into a buffer allocated beforehand, since
+    the tracker holds its locks while copying. Sites with the same symbol
+    are merged afterwards, so the result doesn't depend on the code
+    addresses of a build.
+*/
+void
+MemoryReport::TakeSnapshot()
+{
+    AllocTracker::Site* rawSites = s_new_array(AllocTracker::Site, AllocTracker::MaxNumSites);
+    SizeT numRawSites = AllocTracker::CopySites(rawSites, AllocTracker::MaxNumSites);
+
+    Array<SiteStats> newSites;
+    newSites.reserve(numRawSites);
+    IndexT i;
+    for (i = 0; i < numRawSites; i++)
+    {
+        const AllocTracker::Site& rawSite = rawSites[i];
+        SiteStats site;
+        site.heapName = rawSite.heapName;
+        site.symbol = (0 != rawSite.callsite) ? GetSymbolName(rawSite.callsite) : String("-");
+        if (0 != rawSite.tag)
+        {
+            site.tag = rawSite.tag;
+        }
+        site.liveBytes = rawSite.liveBytes;
+        site.liveCount = rawSite.liveCount;
+        site.totalBytes = rawSite.totalBytes;
+        site.totalCount = rawSite.totalCount;
+        newSites.Append(site);
+    }
+    s_delete_array(rawSites);
+    std::sort(newSites.begin(), newSites.end(), SiteLess);
+
+    this->prevSites.swap(this->sites);
+    this->sites.Clear();
+    this->sites.reserve(newSites.Size());
+    for (i = 0; i < newSites.Size(); i++)
+    {
+        const SiteStats& site = newSites[i];
+        if (!this->sites.IsEmpty() && (0 == CompareSites(this->sites.back(), site)))
+        {
+            SiteStats& merged = this->sites.back();
+            merged.liveBytes += site.liveBytes;
+            merged.liveCount += site.liveCount;
+            merged.totalBytes += site.totalBytes;
+            merged.totalCount += site.totalCount;
+        }
+        else
+        {
+            this->sites.Append(site);
+        }
+    }
+    this->numSnapshots++;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+SizeT
+MemoryReport::GetNumSnapshots() const
+{
+    return this->numSnapshots;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+const Array<MemoryReport::SiteStats>&
+MemoryReport::GetSites() const
+{
+    return this->sites;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+const Array<MemoryReport::SiteStats>&
+MemoryReport::GetPreviousSites() const
+{
+    return this->prevSites;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The heap numbers of the tracker are estimates, the exact numbers of
+    the heaps are only available with STELLAR_MEMORY_STATS.
+*/
+void
+MemoryReport::WriteReport(const Ptr<IO::Stream>& stream) const
+{
+    s_assert(stream->IsOpen());
+    String str;
+    str.reserve(256 + this->sites.Size() * 96);
+    AppendLine(str, "memory report");
+    AppendLine(str, "sample interval: %u bytes", AllocTracker::GetSampleInterval());
+    AppendLine(str, "dropped samples: %u", AllocTracker::GetNumDroppedSamples());
+
+    const unsigned int mega = 1024 * 1024;
+    MemoryStatus status = GetMemoryStatus();
+    AppendLine(str, "");
+    AppendLine(str, "system");
+    AppendLine(str, "%12u MB  total physical", status.totalPhysical / mega);
+    AppendLine(str, "%12u MB  available physical", status.availPhysical / mega);
+    AppendLine(str, "%12u MB  total virtual", status.totalVirtual / mega);
+    AppendLine(str, "%12u MB  available virtual", status.availVirtual / mega);
+
+    IndexT i;
+    #if STELLAR_MEMORY_STATS
+    AppendLine(str, "");
+    AppendLine(str, "heaps (exact)");
+    AppendLine(str, "%12s %12s  %s", "live bytes", "live blocks", "heap");
+    AppendLine(str, "%12d %12d  %s", Memory::GetAllocSize(), Memory::GetAllocCount(), "Process");
+    Array<Heap::Stats> heapStats = Heap::GetAllHeapStats();
+    for (i = 0; i < heapStats.Size(); i++)
+    {
+        AppendLine(str, "%12d %12d  %s", heapStats[i].allocSize, heapStats[i].allocCount, heapStats[i].name);
+    }
+    AppendLine(str, "heaps valid: %s", Memory::Validate() ? "yes" : "no");
+    #endif
+
+    // the sites are sorted by heap, so the totals of a heap are adjacent
+    AppendLine(str, "");
+    AppendLine(str, "heaps (estimated)");
+    AppendLine(str, "%12s %12s %14s %12s  %s", "live bytes", "live blocks", "total bytes", "total blocks", "heap");
+    IndexT first = 0;
+    while (first < this->sites.Size())
+    {
+        SiteStats heap = this->sites[first];
+        IndexT next;
+        for (next = first + 1; (next < this->sites.Size()) && (this->sites[next].heapName == heap.heapName); next++)
+        {
+            heap.liveBytes += this->sites[next].liveBytes;
+            heap.liveCount += this->sites[next].liveCount;
+            heap.totalBytes += this->sites[next].totalBytes;
+            heap.totalCount += this->sites[next].totalCount;
+        }
+        AppendLine(str, "%12.0f %12.0f %14.0f %12.0f  %s",
+            Live(heap.liveBytes), Live(heap.liveCount), heap.totalBytes, heap.totalCount, heap.heapName.c_str());
+        first = next;
+    }
+
+    AppendLine(str, "");
+    AppendLine(str, "sites");
+    AppendLine(str, "%12s %12s %14s %12s  %s", "live bytes", "live blocks", "total bytes", "total blocks", "heap symbol [tag]");
+    char numbers[128];
+    for (i = 0; i < this->sites.Size(); i++)
+    {
+        const SiteStats& site = this->sites[i];
+        s_snprintf(numbers, sizeof(numbers), "%12.0f %12.0f %14.0f %12.0f",
+            Live(site.liveBytes), Live(site.liveCount), site.totalBytes, site.totalCount);
+        AppendSite(str, numbers, site);
+    }
+    stream->Write(str.c_str(), (IO::Stream::Size) str.size());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Both snapshots are sorted, so they are merged like two sorted lists.
+    Sites whose live memory changed by less than a byte are skipped.
+*/
+void
+MemoryReport::WriteDiff(const Ptr<IO::Stream>& stream) const
+{
+    s_assert(stream->IsOpen());
+    String str;
+    AppendLine(str, "memory diff of snapshots %u and %u", this->numSnapshots - 1, this->numSnapshots);
+    AppendLine(str, "%12s %12s  %s", "live bytes", "live blocks", "heap symbol [tag]");
+    double totalBytes = 0.0;
+    double totalCount = 0.0;
+    char numbers[128];
+    IndexT prevIndex = 0;
+    IndexT index = 0;
+    while ((prevIndex < this->prevSites.Size()) || (index < this->sites.Size()))
+    {
+        int res;
+        if (prevIndex >= this->prevSites.Size())
+        {
+            res = 1;
+        }
+        else if (index >= this->sites.Size())
+        {
+            res = -1;
+        }
+        else
+        {
+            res = CompareSites(this->prevSites[prevIndex], this->sites[index]);
+        }
+
+        const SiteStats* site;
+        double bytes = 0.0;
+        double count = 0.0;
+        if (res <= 0)
+        {
+            site = &this->prevSites[prevIndex++];
+            bytes -= site->liveBytes;
+            count -= site->liveCount;
+        }
+        if (res >= 0)
+        {
+            site = &this->sites[index++];
+            bytes += site->liveBytes;
+            count += site->liveCount;
+        }
+        if ((bytes >= 1.0) || (bytes <= -1.0))
+        {
+            s_snprintf(numbers, sizeof(numbers), "%+12.0f %+12.0f", bytes, count);
+            AppendSite(str, numbers, *site);
+            totalBytes += bytes;
+            totalCount += count;
+        }
+    }
+    AppendLine(str, "%+12.0f %+12.0f  total", totalBytes, totalCount);
+    AppendLine(str, "");
+    stream->Write(str.c_str(), (IO::Stream::Size) str.size());
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+MemoryReport::WriteReportFile(const String& path)
+{
+    Ptr<IO::Stream> stream = IO::FileStream::Create();
+    stream->SetPath(path);
+    stream->SetAccessMode(IO::Stream::WriteAccess);
+    if (stream->Open())
+    {
+        this->TakeSnapshot();
+        this->WriteReport(stream);
+        stream->Close();
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+MemoryReport::SetPeriod(SizeT num)
+{
+    this->period = num;
+    this->numUpdates = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+MemoryReport::SetDiffStream(const Ptr<IO::Stream>& stream)
+{
+    this->diffStream = stream;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The first snapshot only serves as the base of the first diff.
+*/
+void
+MemoryReport::Update()
+{
+    if ((0 == this->period) || (++this->numUpdates < this->period))
+    {
+        return;
+    }
+    this->numUpdates = 0;
+    this->TakeSnapshot();
+    if ((this->numSnapshots > 1) && this->diffStream.isvalid() && this->diffStream->IsOpen())
+    {
+        this->WriteDiff(this->diffStream);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns the undecorated name of the function without offset, or the
+    address if the function can't be found, e.g. because there are no
+    debug symbols (Win32) or the function isn't exported (Posix).
+*/
+String
+MemoryReport::GetSymbolName(const void* address)
+{
+    #if __WIN32__
+    static Threading::CriticalSection symLock;
+    static bool symInitialized = false;
+    symLock.Enter();
+    HANDLE process = GetCurrentProcess();
+    if (!symInitialized)
+    {
+        SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+        SymInitialize(process, NULL, TRUE);
+        symInitialized = true;
+    }
+    char buf[sizeof(SYMBOL_INFO) + 256];
+    SYMBOL_INFO* info = (SYMBOL_INFO*) buf;
+    info->SizeOfStruct = sizeof(SYMBOL_INFO);
+    info->MaxNameLen = 255;
+    DWORD64 displacement = 0;
+    BOOL found = SymFromAddr(process, (DWORD64)(size_t) address, &displacement, info);
+    String name = found ? String(info->Name) : String();
+    symLock.Leave();
+    if (found)
+    {
+        return name;
+    }
+    #else
+    Dl_info info;
+    if ((0 != dladdr(address, &info)) && (0 != info.dli_sname))
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, 0, 0, &status);
+        String name = (0 == status) ? String(demangled) : String(info.dli_sname);
+        free(demangled);
+        return name;
+    }
+    #endif
+    char buf[32];
+    s_snprintf(buf, sizeof(buf), "%p", address);
+    return buf;
+}
+
+} // namespace Debug
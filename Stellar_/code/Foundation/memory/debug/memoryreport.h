@@ -0,0 +1,99 @@
+#pragma once
+#ifndef DEBUG_MEMORYREPORT_H
+#define DEBUG_MEMORYREPORT_H
+//------------------------------------------------------------------------------
+/**
+    @class Debug::MemoryReport
+
+    Writes the allocation sites recorded by Memory::AllocTracker as plain
+    text to a stream or a file. Replaces the old http memory page.
+
+    The report starts with the overall and per-heap numbers, followed by
+    one line per site with its estimated live and total bytes and blocks.
+    Call sites are written as symbol names without addresses or offsets,
+    sites which resolve to the same symbol, tag and heap are merged, and
+    the lines are sorted by heap, symbol and tag, so the reports of two
+    builds can be compared with any diff tool.
+
+    TakeSnapshot() copies the current sites, WriteDiff() writes the sites
+    whose live memory changed between the last two snapshots, e.g. to find
+    leaks between two levels. Update() does this periodically and appends
+    the diffs to a stream:
+
+    @code
+    Debug::MemoryReport memoryReport;
+    memoryReport.SetPeriod(600);
+    memoryReport.SetDiffStream(stream);
+    ...
+    // once per frame
+    memoryReport.Update();
+    @endcode
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "core/ptr.h"
+#include "memory/alloctracker.h"
+#include "utility/array.h"
+#include "utility/string.h"
+#include "io/stream.h"
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class MemoryReport
+{
+public:
+    /// the estimated allocations of a symbol, tag and heap
+    struct SiteStats
+    {
+        Util::String heapName;
+        Util::String symbol;
+        Util::String tag;
+        double liveBytes;
+        double liveCount;
+        double totalBytes;
+        double totalCount;
+    };
+
+    /// constructor
+    MemoryReport();
+
+    /// copy the current sites of the tracker, the previous snapshot is kept
+    void TakeSnapshot();
+    /// get the number of snapshots taken so far
+    SizeT GetNumSnapshots() const;
+    /// get the sites of the last snapshot, sorted by heap, symbol and tag
+    const Util::Array<SiteStats>& GetSites() const;
+    /// get the sites of the snapshot before the last one
+    const Util::Array<SiteStats>& GetPreviousSites() const;
+
+    /// write a report of the last snapshot to an open stream
+    void WriteReport(const Ptr<IO::Stream>& stream) const;
+    /// write the sites whose live memory changed between the last two snapshots
+    void WriteDiff(const Ptr<IO::Stream>& stream) const;
+    /// take a snapshot and write the report into a file
+    bool WriteReportFile(const Util::String& path);
+
+    /// set the number of Update() calls between two snapshots, 0 switches periodic snapshots off
+    void SetPeriod(SizeT numUpdates);
+    /// set the open stream the periodic diffs are appended to
+    void SetDiffStream(const Ptr<IO::Stream>& stream);
+    /// call once per frame, takes a snapshot and writes the diff when the period is over
+    void Update();
+
+    /// get the name of the function containing a code address
+    static Util::String GetSymbolName(const void* address);
+
+private:
+    Util::Array<SiteStats> sites;
+    Util::Array<SiteStats> prevSites;
+    SizeT numSnapshots;
+    SizeT period;
+    SizeT numUpdates;
+    Ptr<IO::Stream> diffStream;
+};
+
+} // namespace Debug
+//------------------------------------------------------------------------------
+#endif
@@ -16,7 +16,36 @@ namespace Memory
 {
 typedef Win32::Win32Heap Heap;
 }
+#elif __POSIX__
+#include "memory/posix/posixheap.h"
+namespace Memory
+{
+typedef Posix::PosixHeap Heap;
+}
 #else
 #error "IMPLEMENT ME!"
 #endif
+#include <new>
+
+namespace Memory
+{
+//------------------------------------------------------------------------------
+/**
+    Destroy an object created with s_new_heap() and give its memory back
+    to the heap. Works with any heap class, e.g. Heap, LinearHeap or PoolHeap.
+*/
+template<class HEAP, class TYPE> inline void
+DeleteFromHeap(HEAP& heap, TYPE* ptr)
+{
+    if (0 != ptr)
+    {
+        ptr->~TYPE();
+        heap.Free(ptr);
+    }
+}
+} // namespace Memory
+
+#define s_new_heap(heap,type) new ((heap).Alloc(sizeof(type))) type
+#define s_delete_heap(heap,ptr) Memory::DeleteFromHeap(heap, ptr)
+//------------------------------------------------------------------------------
 #endif
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+//  linearheap.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/linearheap.h"
+
+namespace Memory
+{
+
+//------------------------------------------------------------------------------
+/**
+*/
+LinearHeap::LinearHeap(const char* heapName, SizeT size, SizeT num) :
+    name(heapName),
+    chunkSize(size),
+    numFrames(num),
+    frameIndex(0),
+    lastAlloc(0)
+{
+    s_assert(0 != heapName);
+    s_assert(size > 0);
+    s_assert((num > 0) && (num <= MaxNumFrames));
+    Memory::Clear(this->frames, sizeof(this->frames));
+    #if STELLAR_MEMORY_STATS
+    this->allocCount = 0;
+    this->allocSize = 0;
+    this->peakSize = 0;
+    this->capacity = 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+LinearHeap::~LinearHeap()
+{
+    IndexT i;
+    for (i = 0; i < this->numFrames; i++)
+    {
+        Chunk* chunk = this->frames[i].first;
+        while (0 != chunk)
+        {
+            Chunk* next = chunk->next;
+            Memory::Free(chunk);
+            chunk = next;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    The underlying allocator only guarantees pointer alignment, so the 
+    chunk's memory starts at the first aligned address after the header.
+*/
+char*
+LinearHeap::GetChunkData(Chunk* chunk)
+{
+    size_t data = (size_t) (chunk + 1);
+    return (char*) ((data + Alignment - 1) & ~(Alignment - 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+char*
+LinearHeap::GetChunkEnd(Chunk* chunk)
+{
+    return (char*) chunk + chunk->size;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Moves on to the next chunk of the frame if it is large enough, 
+    otherwise a new chunk is inserted after the current one. Chunks 
+    which were too small for a request stay in the frame and are used
+    again after the next reset.
+*/
+void*
+LinearHeap::AllocSlow(size_t size)
+{
+    Frame& frame = this->frames[this->frameIndex];
+    size_t alignedSize = Align(size);
+
+    Chunk* chunk = (0 != frame.current) ? frame.current->next : 0;
+    if ((0 == chunk) || ((size_t) (GetChunkEnd(chunk) - GetChunkData(chunk)) < alignedSize))
+    {
+        size_t newSize = sizeof(Chunk) + Alignment + alignedSize;
+        if (newSize < size_t(this->chunkSize))
+        {
+            newSize = this->chunkSize;
+        }
+        Chunk* newChunk = (Chunk*) Memory::Alloc(newSize);
+        newChunk->size = newSize;
+        newChunk->next = chunk;
+        if (0 != frame.current)
+        {
+            frame.current->next = newChunk;
+        }
+        else
+        {
+            frame.first = newChunk;
+        }
+        chunk = newChunk;
+        #if STELLAR_MEMORY_STATS
+        this->capacity += int(newSize);
+        #endif
+    }
+
+    frame.current = chunk;
+    frame.cursor = GetChunkData(chunk);
+    frame.end = GetChunkEnd(chunk);
+    return this->Alloc(size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Blocks can be extended in place if they are the most recent 
+    allocation. Otherwise the contents are copied to a new block, since 
+    the old size isn't stored the copy may include some bytes following
+    the old block, which is harmless.
+*/
+void*
+LinearHeap::Realloc(void* ptr, size_t newSize)
+{
+    if (0 == ptr)
+    {
+        return this->Alloc(newSize);
+    }
+
+    Frame& frame = this->frames[this->frameIndex];
+    char* end = frame.cursor;
+    if (ptr == this->lastAlloc)
+    {
+        size_t alignedSize = Align(newSize);
+        if ((size_t) (frame.end - this->lastAlloc) >= alignedSize)
+        {
+            #if STELLAR_MEMORY_STATS
+            this->allocSize += int(alignedSize) - int(frame.cursor - this->lastAlloc);
+            if (this->allocSize > this->peakSize)
+            {
+                this->peakSize = this->allocSize;
+            }
+            #endif
+            frame.cursor = this->lastAlloc + alignedSize;
+            return ptr;
+        }
+    }
+    else if ((0 == frame.current) || (ptr < GetChunkData(frame.current)) || (ptr >= frame.cursor))
+    {
+        // find the chunk of the old block, it may be in any frame
+        end = 0;
+        IndexT i;
+        for (i = 0; (i < this->numFrames) && (0 == end); i++)
+        {
+            Chunk* chunk;
+            for (chunk = this->frames[i].first; 0 != chunk; chunk = chunk->next)
+            {
+                if ((ptr >= GetChunkData(chunk)) && (ptr < GetChunkEnd(chunk)))
+                {
+                    end = GetChunkEnd(chunk);
+                    break;
+                }
+            }
+        }
+        s_assert(0 != end);
+    }
+
+    size_t oldSize = end - (char*) ptr;
+    void* newPtr = this->Alloc(newSize);
+    Memory::Copy(ptr, newPtr, (newSize < oldSize) ? newSize : oldSize);
+    return newPtr;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+LinearHeap::ResetFrame(Frame& frame)
+{
+    frame.current = frame.first;
+    if (0 != frame.first)
+    {
+        frame.cursor = GetChunkData(frame.first);
+        frame.end = GetChunkEnd(frame.first);
+    }
+    else
+    {
+        frame.cursor = 0;
+        frame.end = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Switches to the next frame and releases all memory allocated in it.
+    Call once per frame before anything is allocated.
+*/
+void
+LinearHeap::BeginFrame()
+{
+    this->frameIndex = (this->frameIndex + 1) % this->numFrames;
+    this->ResetFrame(this->frames[this->frameIndex]);
+    this->lastAlloc = 0;
+    #if STELLAR_MEMORY_STATS
+    this->allocCount = 0;
+    this->allocSize = 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+LinearHeap::Reset()
+{
+    IndexT i;
+    for (i = 0; i < this->numFrames; i++)
+    {
+        this->ResetFrame(this->frames[i]);
+    }
+    this->lastAlloc = 0;
+    #if STELLAR_MEMORY_STATS
+    this->allocCount = 0;
+    this->allocSize = 0;
+    #endif
+}
+
+} // namespace Memory
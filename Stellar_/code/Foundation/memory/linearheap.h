@@ -0,0 +1,221 @@
+#pragma once
+#ifndef MEMORY_LINEARHEAP_H
+#define MEMORY_LINEARHEAP_H
+//------------------------------------------------------------------------------
+/**
+    @class Memory::LinearHeap
+  
+    A heap for transient data whose lifetime ends with the frame, like
+    sort keys, visibility lists or the shader variable arrays of a frame
+    batch. Alloc() just bumps a pointer, Free() does nothing (except for
+    the most recent allocation) and all memory of a frame is released at
+    once by BeginFrame().
+
+    The heap is buffered across several frames (two by default), so data
+    allocated in one frame stays valid during the next frame. Chunks are 
+    kept when a frame is reset, so after a few frames the heap doesn't 
+    call the underlying allocator anymore.
+
+    Objects are created with s_new_heap() and destroyed with s_delete_heap(),
+    which runs the destructor without releasing any memory. A LinearHeap
+    is not thread-safe, use one heap per thread.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "memory/heap.h"
+
+//------------------------------------------------------------------------------
+namespace Memory
+{
+class LinearHeap
+{
+public:
+    /// maximum number of frames the heap can be buffered across
+    static const SizeT MaxNumFrames = 4;
+    /// alignment of all blocks
+    static const size_t Alignment = 16;
+
+    /// constructor (name must be static string!)
+    LinearHeap(const char* name, SizeT chunkSize = 64 * 1024, SizeT numFrames = 2);
+    /// destructor
+    ~LinearHeap();
+    /// get heap name
+    const char* GetName() const;
+    /// begin a new frame, releases the memory allocated numFrames frames ago
+    void BeginFrame();
+    /// release the memory of all frames
+    void Reset();
+    /// allocate a block of memory from the current frame
+    void* Alloc(size_t size);
+    /// re-allocate a block of memory
+    void* Realloc(void* ptr, size_t newSize);
+    /// free a block of memory, only the most recent block is actually released
+    void Free(void* ptr);
+
+    #if STELLAR_MEMORY_STATS
+    /// get the number of allocations in the current frame
+    int GetAllocCount() const;
+    /// get the number of bytes allocated in the current frame
+    int GetAllocSize() const;
+    /// get the largest number of bytes allocated in a single frame
+    int GetPeakSize() const;
+    /// get the number of bytes reserved by all frames
+    int GetCapacity() const;
+    #endif
+
+private:
+    /// header of a chunk, the chunk's memory follows
+    struct Chunk
+    {
+        Chunk* next;
+        size_t size;
+    };
+    /// chunks and allocation pointer of a frame
+    struct Frame
+    {
+        Chunk* first;
+        Chunk* current;
+        char* cursor;
+        char* end;
+    };
+
+    /// default constructor not allowed
+    LinearHeap();
+    /// copying not allowed
+    LinearHeap(const LinearHeap&);
+    /// round a size up to the alignment
+    static size_t Align(size_t size);
+    /// get the start of a chunk's memory
+    static char* GetChunkData(Chunk* chunk);
+    /// get the end of a chunk's memory
+    static char* GetChunkEnd(Chunk* chunk);
+    /// allocate from the next chunk if the current chunk is full
+    void* AllocSlow(size_t size);
+    /// reset a frame to its first chunk
+    void ResetFrame(Frame& frame);
+
+    const char* name;
+    SizeT chunkSize;
+    SizeT numFrames;
+    IndexT frameIndex;
+    Frame frames[MaxNumFrames];
+    char* lastAlloc;
+
+    #if STELLAR_MEMORY_STATS
+    int allocCount;
+    int allocSize;
+    int peakSize;
+    int capacity;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const char*
+LinearHeap::GetName() const
+{
+    s_assert(0 != this->name);
+    return this->name;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Zero sized blocks still take up space, so every block has its own 
+    address.
+*/
+inline size_t
+LinearHeap::Align(size_t size)
+{
+    return (0 == size) ? Alignment : ((size + Alignment - 1) & ~(Alignment - 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+LinearHeap::Alloc(size_t size)
+{
+    Frame& frame = this->frames[this->frameIndex];
+    size_t alignedSize = Align(size);
+    if ((size_t) (frame.end - frame.cursor) < alignedSize)
+    {
+        return this->AllocSlow(size);
+    }
+    char* ptr = frame.cursor;
+    frame.cursor += alignedSize;
+    this->lastAlloc = ptr;
+    #if STELLAR_MEMORY_STATS
+    this->allocCount++;
+    this->allocSize += int(alignedSize);
+    if (this->allocSize > this->peakSize)
+    {
+        this->peakSize = this->allocSize;
+    }
+    #endif
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Memory is only released if ptr is the most recent allocation, 
+    everything else is released with the frame.
+*/
+inline void
+LinearHeap::Free(void* ptr)
+{
+    s_assert(0 != ptr);
+    if (ptr == this->lastAlloc)
+    {
+        Frame& frame = this->frames[this->frameIndex];
+        #if STELLAR_MEMORY_STATS
+        this->allocCount--;
+        this->allocSize -= int(frame.cursor - this->lastAlloc);
+        #endif
+        frame.cursor = this->lastAlloc;
+        this->lastAlloc = 0;
+    }
+}
+
+#if STELLAR_MEMORY_STATS
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+LinearHeap::GetAllocCount() const
+{
+    return this->allocCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+LinearHeap::GetAllocSize() const
+{
+    return this->allocSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+LinearHeap::GetPeakSize() const
+{
+    return this->peakSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+LinearHeap::GetCapacity() const
+{
+    return this->capacity;
+}
+#endif
+
+} // namespace Memory
+//------------------------------------------------------------------------------
+#endif
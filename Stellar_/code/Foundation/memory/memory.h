@@ -12,6 +12,8 @@
 #include "core/config.h"
 #if __WIN32__
 #include "memory/win32/win32memory.h"
+#elif __POSIX__
+#include "memory/posix/posixmemory.h"
 #else
 #error "IMPLEMENT ME!"
 #endif
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//  objectpool.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/objectpool.h"
+#include "thread/interlocked.h"
+
+namespace Memory
+{
+ThreadLocal ObjectPool::ThreadCache* ObjectPool::threadCaches[ObjectPool::MaxNumPools] = { 0 };
+ObjectPool* ObjectPool::pools[ObjectPool::MaxNumPools] = { 0 };
+int volatile ObjectPool::numPools = 0;
+
+//------------------------------------------------------------------------------
+/**
+    A thread takes and gives back a quarter of a chunk at a time.
+*/
+ObjectPool::ObjectPool(const char* poolName, SizeT size, SizeT num) :
+    heap(0),
+    caches(0),
+    poolIndex(InvalidIndex),
+    name(poolName),
+    objectSize(size),
+    numObjectsPerChunk(num),
+    batchSize((num + 3) / 4),
+    peakNumLiveObjects(0),
+    isDestroyed(false)
+{
+    s_assert(0 != poolName);
+    s_assert(size > 0);
+    s_assert(num > 0);
+    this->poolIndex = Threading::Interlocked::Increment(numPools) - 1;
+    if (this->poolIndex >= MaxNumPools)
+    {
+        s_error("ObjectPool: too many pools for '%s', increase MaxNumPools!\n", poolName);
+    }
+    pools[this->poolIndex] = this;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The heap is only released if no objects are left. Static objects
+    which are destroyed after the pool may still hold pooled objects,
+    their memory must stay valid until the process ends. Freeing them
+    does nothing once the pool has been destroyed.
+*/
+ObjectPool::~ObjectPool()
+{
+    this->critSect.Enter();
+    this->isDestroyed = true;
+    if ((0 != this->heap) && (0 == this->CountLiveObjects()))
+    {
+        while (0 != this->caches)
+        {
+            ThreadCache* next = this->caches->next;
+            s_delete(this->caches);
+            this->caches = next;
+        }
+        s_delete(this->heap);
+        this->heap = 0;
+    }
+    this->critSect.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Caches given back by threads which have ended are reused, together
+    with their counters.
+*/
+ObjectPool::ThreadCache*
+ObjectPool::CreateThreadCache()
+{
+    this->critSect.Enter();
+    ThreadCache* cache = this->caches;
+    while ((0 != cache) && cache->isOwned)
+    {
+        cache = cache->next;
+    }
+    if (0 == cache)
+    {
+        cache = s_new(ThreadCache);
+        cache->freeList = 0;
+        cache->numFree = 0;
+        cache->numAllocs = 0;
+        cache->numFrees = 0;
+        cache->next = this->caches;
+        this->caches = cache;
+    }
+    cache->isOwned = true;
+    this->critSect.Leave();
+
+    threadCaches[this->poolIndex] = cache;
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The heap is created with the first object, so pooled classes which
+    are never instantiated don't reserve any memory.
+*/
+void
+ObjectPool::Refill(ThreadCache* cache)
+{
+    this->critSect.Enter();
+    if (0 == this->heap)
+    {
+        this->heap = s_new(PoolHeap(this->name, this->objectSize, this->numObjectsPerChunk));
+    }
+    IndexT i;
+    for (i = 0; i < this->batchSize; i++)
+    {
+        FreeBlock* block = (FreeBlock*) this->heap->Alloc(this->objectSize);
+        block->next = cache->freeList;
+        cache->freeList = block;
+    }
+    cache->numFree += this->batchSize;
+
+    // the blocks are about to be used, so count them as live for the peak
+    int numLiveObjects = this->CountLiveObjects() + this->batchSize;
+    if (numLiveObjects > this->peakNumLiveObjects)
+    {
+        this->peakNumLiveObjects = numLiveObjects;
+    }
+    this->critSect.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ObjectPool::Flush(ThreadCache* cache, SizeT numKeep)
+{
+    this->critSect.Enter();
+    while (cache->numFree > numKeep)
+    {
+        FreeBlock* block = cache->freeList;
+        cache->freeList = block->next;
+        cache->numFree--;
+        this->heap->Free(block);
+    }
+    this->critSect.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+    The counters of other threads are read while they may be changing,
+    so the result is only exact if no other thread uses the pool.
+*/
+int
+ObjectPool::CountLiveObjects() const
+{
+    int numLiveObjects = 0;
+    const ThreadCache* cache;
+    for (cache = this->caches; 0 != cache; cache = cache->next)
+    {
+        numLiveObjects += cache->numAllocs - cache->numFrees;
+    }
+    return numLiveObjects;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+ObjectPool::GetNumLiveObjects() const
+{
+    this->critSect.Enter();
+    int numLiveObjects = this->CountLiveObjects();
+    this->critSect.Leave();
+    return numLiveObjects;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+ObjectPool::GetPeakNumLiveObjects() const
+{
+    this->critSect.Enter();
+    int numLiveObjects = this->CountLiveObjects();
+    if (numLiveObjects < this->peakNumLiveObjects)
+    {
+        numLiveObjects = this->peakNumLiveObjects;
+    }
+    this->critSect.Leave();
+    return numLiveObjects;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+ObjectPool::GetNumAllocs() const
+{
+    this->critSect.Enter();
+    int numAllocs = 0;
+    const ThreadCache* cache;
+    for (cache = this->caches; 0 != cache; cache = cache->next)
+    {
+        numAllocs += cache->numAllocs;
+    }
+    this->critSect.Leave();
+    return numAllocs;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Moves the free blocks of the calling thread back to the shared heaps
+    and leaves the thread's caches to the next thread which needs one.
+*/
+void
+ObjectPool::ReleaseThreadCaches()
+{
+    SizeT num = (SizeT) numPools;
+    IndexT i;
+    for (i = 0; (i < num) && (i < MaxNumPools); i++)
+    {
+        ThreadCache* cache = threadCaches[i];
+        if (0 != cache)
+        {
+            ObjectPool* pool = pools[i];
+            if (!pool->isDestroyed)
+            {
+                pool->Flush(cache, 0);
+                pool->critSect.Enter();
+                cache->isOwned = false;
+                pool->critSect.Leave();
+            }
+            threadCaches[i] = 0;
+        }
+    }
+}
+
+} // namespace Memory
@@ -0,0 +1,192 @@
+#pragma once
+#ifndef MEMORY_OBJECTPOOL_H
+#define MEMORY_OBJECTPOOL_H
+//------------------------------------------------------------------------------
+/**
+    @class Memory::ObjectPool
+  
+    The allocator behind DeclarePooledClass/ImplementPooledClass. Every 
+    pooled class owns one ObjectPool, which hands out blocks of the size of
+    the class from a PoolHeap, so the objects of a class are packed
+    together in memory.
+
+    Unlike a PoolHeap, an ObjectPool may be used from several threads.
+    Each thread keeps a small free list of its own in front of the shared
+    PoolHeap, so creating and destroying objects only pops or pushes that
+    list. The shared heap is only locked to move a batch of blocks between
+    it and a thread's list. Threading::Thread gives the blocks of a thread
+    back when the thread ends, other threads must call 
+    ReleaseThreadCaches() themselves before they end.
+
+    The pool counts the live objects of the class and remembers the peak
+    count, these counters are available through 
+    Core::Factory::GetPooledClasses(). The peak is sampled whenever blocks 
+    move between a thread and the shared heap, so it can miss up to one
+    batch of objects per thread.
+
+    Pooled objects may outlive their pool during static destruction, 
+    their memory is never released in that case and freeing them does
+    nothing.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "memory/poolheap.h"
+#include "thread/criticalsection.h"
+
+//------------------------------------------------------------------------------
+namespace Memory
+{
+class ObjectPool
+{
+public:
+    /// constructor (name must be static string!)
+    ObjectPool(const char* name, SizeT objectSize, SizeT numObjectsPerChunk = 64);
+    /// destructor
+    ~ObjectPool();
+    /// get pool name, this is the class name
+    const char* GetName() const;
+    /// get the size of the pooled objects
+    SizeT GetObjectSize() const;
+    /// allocate memory for an object
+    void* Alloc(size_t size);
+    /// free the memory of an object
+    void Free(void* ptr);
+
+    /// get the number of live objects
+    int GetNumLiveObjects() const;
+    /// get the highest number of live objects so far
+    int GetPeakNumLiveObjects() const;
+    /// get the number of objects allocated so far
+    int GetNumAllocs() const;
+
+    /// give the blocks kept by the calling thread back to all pools, call before a thread ends
+    static void ReleaseThreadCaches();
+
+private:
+    enum
+    {
+        MaxNumPools = 64,
+    };
+
+    /// a free block, linked into a thread's free list
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    /// the free list of one thread, and what the thread did with the pool
+    struct ThreadCache
+    {
+        FreeBlock* freeList;
+        SizeT numFree;
+        int numAllocs;
+        int numFrees;
+        bool isOwned;
+        ThreadCache* next;
+    };
+
+    /// default constructor not allowed
+    ObjectPool();
+    /// copying not allowed
+    ObjectPool(const ObjectPool&);
+    /// get the calling thread's cache
+    ThreadCache* GetThreadCache();
+    /// assign a cache to the calling thread
+    ThreadCache* CreateThreadCache();
+    /// move a batch of blocks from the heap into a cache
+    void Refill(ThreadCache* cache);
+    /// move blocks from a cache back to the heap until numKeep are left
+    void Flush(ThreadCache* cache, SizeT numKeep);
+    /// count the live objects (critSect must be taken)
+    int CountLiveObjects() const;
+
+    static ThreadLocal ThreadCache* threadCaches[MaxNumPools];
+    static ObjectPool* pools[MaxNumPools];
+    static int volatile numPools;
+
+    mutable Threading::CriticalSection critSect;
+    PoolHeap* heap;
+    ThreadCache* caches;
+    IndexT poolIndex;
+    const char* name;
+    SizeT objectSize;
+    SizeT numObjectsPerChunk;
+    SizeT batchSize;
+    int peakNumLiveObjects;
+    bool volatile isDestroyed;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const char*
+ObjectPool::GetName() const
+{
+    return this->name;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+ObjectPool::GetObjectSize() const
+{
+    return this->objectSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline ObjectPool::ThreadCache*
+ObjectPool::GetThreadCache()
+{
+    ThreadCache* cache = threadCaches[this->poolIndex];
+    return (0 != cache) ? cache : this->CreateThreadCache();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+ObjectPool::Alloc(size_t size)
+{
+    s_assert(size <= size_t(this->objectSize));
+    s_assert(!this->isDestroyed);
+    ThreadCache* cache = this->GetThreadCache();
+    if (0 == cache->freeList)
+    {
+        this->Refill(cache);
+    }
+    FreeBlock* block = cache->freeList;
+    cache->freeList = block->next;
+    cache->numFree--;
+    cache->numAllocs++;
+    return block;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The block goes to the calling thread's free list, no matter which
+    thread allocated it.
+*/
+inline void
+ObjectPool::Free(void* ptr)
+{
+    if ((0 != ptr) && !this->isDestroyed)
+    {
+        ThreadCache* cache = this->GetThreadCache();
+        FreeBlock* block = (FreeBlock*) ptr;
+        block->next = cache->freeList;
+        cache->freeList = block;
+        cache->numFree++;
+        cache->numFrees++;
+        if (cache->numFree > 2 * this->batchSize)
+        {
+            this->Flush(cache, this->batchSize);
+        }
+    }
+}
+
+} // namespace Memory
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//  poolheap.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/poolheap.h"
+
+namespace Memory
+{
+
+//------------------------------------------------------------------------------
+/**
+    The block size is rounded up to a multiple of the pointer size, so 
+    every block can hold the free list link and stays aligned.
+*/
+PoolHeap::PoolHeap(const char* heapName, SizeT size, SizeT num) :
+    name(heapName),
+    blockSize((size + sizeof(FreeBlock) - 1) & ~(sizeof(FreeBlock) - 1)),
+    numBlocksPerChunk(num),
+    freeList(0),
+    chunks(0)
+{
+    s_assert(0 != heapName);
+    s_assert(size > 0);
+    s_assert(num > 0);
+    #if STELLAR_MEMORY_STATS
+    this->allocCount = 0;
+    this->capacity = 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+PoolHeap::~PoolHeap()
+{
+    while (0 != this->chunks)
+    {
+        Chunk* next = this->chunks->next;
+        Memory::Free(this->chunks);
+        this->chunks = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Blocks start at the first address after the chunk header which is 
+    aligned to 16 bytes.
+*/
+char*
+PoolHeap::GetFirstBlock(Chunk* chunk) const
+{
+    size_t first = (size_t) (chunk + 1);
+    return (char*) ((first + 15) & ~size_t(15));
+}
+
+//------------------------------------------------------------------------------
+/**
+    Links the blocks of a chunk in address order in front of the free list.
+*/
+void
+PoolHeap::LinkBlocks(Chunk* chunk)
+{
+    char* block = GetFirstBlock(chunk) + (this->numBlocksPerChunk - 1) * this->blockSize;
+    IndexT i;
+    for (i = 0; i < this->numBlocksPerChunk; i++)
+    {
+        ((FreeBlock*) block)->next = this->freeList;
+        this->freeList = (FreeBlock*) block;
+        block -= this->blockSize;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+PoolHeap::Grow()
+{
+    size_t size = sizeof(Chunk) + 16 + this->numBlocksPerChunk * this->blockSize;
+    Chunk* chunk = (Chunk*) Memory::Alloc(size);
+    chunk->next = this->chunks;
+    this->chunks = chunk;
+    this->LinkBlocks(chunk);
+    #if STELLAR_MEMORY_STATS
+    this->capacity += int(size);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+    Puts all blocks back into the free list. Objects still living in the 
+    heap are not destroyed.
+*/
+void
+PoolHeap::Reset()
+{
+    this->freeList = 0;
+    Chunk* chunk;
+    for (chunk = this->chunks; 0 != chunk; chunk = chunk->next)
+    {
+        this->LinkBlocks(chunk);
+    }
+    #if STELLAR_MEMORY_STATS
+    this->allocCount = 0;
+    #endif
+}
+
+} // namespace Memory
@@ -0,0 +1,183 @@
+#pragma once
+#ifndef MEMORY_POOLHEAP_H
+#define MEMORY_POOLHEAP_H
+//------------------------------------------------------------------------------
+/**
+    @class Memory::PoolHeap
+  
+    A heap for objects of a fixed size. Blocks are carved from chunks
+    holding a fixed number of blocks and are kept in a free list, so 
+    Alloc() and Free() only pop or push a pointer. Reset() releases all
+    blocks at once without giving the chunks back.
+
+    Objects are created with s_new_heap() and destroyed with s_delete_heap(),
+    or the heap is used from a class' operator new and delete. A PoolHeap
+    is not thread-safe, use one heap per thread.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "memory/heap.h"
+
+//------------------------------------------------------------------------------
+namespace Memory
+{
+class PoolHeap
+{
+public:
+    /// constructor (name must be static string!)
+    PoolHeap(const char* name, SizeT blockSize, SizeT numBlocksPerChunk = 256);
+    /// destructor
+    ~PoolHeap();
+    /// get heap name
+    const char* GetName() const;
+    /// get the size of the blocks
+    SizeT GetBlockSize() const;
+    /// allocate a block, size must not be larger than the block size
+    void* Alloc(size_t size);
+    /// re-allocate a block, newSize must not be larger than the block size
+    void* Realloc(void* ptr, size_t newSize);
+    /// free a block of memory which has been allocated from this heap
+    void Free(void* ptr);
+    /// release all blocks at once
+    void Reset();
+
+    #if STELLAR_MEMORY_STATS
+    /// get the current alloc count
+    int GetAllocCount() const;
+    /// get the current alloc size
+    int GetAllocSize() const;
+    /// get the number of bytes reserved by all chunks
+    int GetCapacity() const;
+    #endif
+
+private:
+    /// a free block, linked into the free list
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    /// header of a chunk, the chunk's blocks follow
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    /// default constructor not allowed
+    PoolHeap();
+    /// copying not allowed
+    PoolHeap(const PoolHeap&);
+    /// get the first block of a chunk
+    char* GetFirstBlock(Chunk* chunk) const;
+    /// link the blocks of a chunk into the free list
+    void LinkBlocks(Chunk* chunk);
+    /// allocate a new chunk
+    void Grow();
+
+    const char* name;
+    SizeT blockSize;
+    SizeT numBlocksPerChunk;
+    FreeBlock* freeList;
+    Chunk* chunks;
+
+    #if STELLAR_MEMORY_STATS
+    int allocCount;
+    int capacity;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const char*
+PoolHeap::GetName() const
+{
+    s_assert(0 != this->name);
+    return this->name;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+PoolHeap::GetBlockSize() const
+{
+    return this->blockSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+PoolHeap::Alloc(size_t size)
+{
+    s_assert(size <= size_t(this->blockSize));
+    if (0 == this->freeList)
+    {
+        this->Grow();
+    }
+    FreeBlock* block = this->freeList;
+    this->freeList = block->next;
+    #if STELLAR_MEMORY_STATS
+    this->allocCount++;
+    #endif
+    return block;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+PoolHeap::Realloc(void* ptr, size_t newSize)
+{
+    s_assert(newSize <= size_t(this->blockSize));
+    return (0 != ptr) ? ptr : this->Alloc(newSize);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PoolHeap::Free(void* ptr)
+{
+    s_assert(0 != ptr);
+    FreeBlock* block = (FreeBlock*) ptr;
+    block->next = this->freeList;
+    this->freeList = block;
+    #if STELLAR_MEMORY_STATS
+    this->allocCount--;
+    #endif
+}
+
+#if STELLAR_MEMORY_STATS
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PoolHeap::GetAllocCount() const
+{
+    return this->allocCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PoolHeap::GetAllocSize() const
+{
+    return this->allocCount * this->blockSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PoolHeap::GetCapacity() const
+{
+    return this->capacity;
+}
+#endif
+
+} // namespace Memory
+//------------------------------------------------------------------------------
+#endif
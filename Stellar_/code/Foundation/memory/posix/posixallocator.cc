@@ -0,0 +1,572 @@
+//------------------------------------------------------------------------------
+//  posixallocator.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/posix/posixallocator.h"
+
+namespace Posix
+{
+
+namespace
+{
+
+/// size of the header in front of each block, keeps blocks 16 byte aligned
+const size_t HeaderSize = 16;
+/// number of size classes for small blocks
+const unsigned int NumSizeClasses = 40;
+/// largest block (including its header) served from the size classes
+const size_t MaxSmallSize = 32768;
+/// size class of blocks which have been mapped individually
+const unsigned short LargeClass = 0xffff;
+/// size of the slabs new blocks are carved from
+const size_t SlabSize = 256 * 1024;
+/// marks the header of an allocated block
+const unsigned short BlockMagic = 0x5e11;
+
+/// header in front of each block
+struct BlockHeader
+{
+    size_t size;                    // size requested by the caller
+    unsigned short sizeClass;       // size class or LargeClass
+    unsigned short magic;           // BlockMagic while allocated
+    unsigned int heapIndex;         // heap the block was allocated for
+};
+
+/// compile time check, fails if the header doesn't fit in front of the block
+typedef char HeaderSizeCheck[(sizeof(BlockHeader) <= HeaderSize) ? 1 : -1];
+
+/// a free block, linked into a thread's free list or a depot batch
+struct FreeBlock
+{
+    FreeBlock* next;                // next block in the list
+    FreeBlock* nextBatch;           // next batch, only valid in the first block of a batch
+};
+
+/// free list of a size class in a thread cache
+struct FreeList
+{
+    FreeBlock* head;
+    unsigned int count;
+};
+
+/// per thread cache, the only state touched by Alloc() and Free() in the common case
+struct ThreadCache
+{
+    FreeList lists[NumSizeClasses];
+    #if STELLAR_MEMORY_STATS
+    long allocCount[PosixAllocator::MaxNumHeaps];
+    long allocSize[PosixAllocator::MaxNumHeaps];
+    #endif
+    ThreadCache* prev;
+    ThreadCache* next;
+};
+
+/// central depot of a size class
+struct Depot
+{
+    pthread_mutex_t lock;
+    FreeBlock* batches;             // batches of free blocks, linked by nextBatch
+    char* slabCursor;               // unused part of the current slab
+    char* slabEnd;
+};
+
+Depot Depots[NumSizeClasses];
+pthread_once_t InitOnce = PTHREAD_ONCE_INIT;
+pthread_key_t ThreadCacheKey;
+__thread ThreadCache* CurrentThreadCache = 0;
+
+pthread_mutex_t RegistryLock = PTHREAD_MUTEX_INITIALIZER;
+ThreadCache* ThreadCaches = 0;
+bool HeapInUse[PosixAllocator::MaxNumHeaps] = { true };
+#if STELLAR_MEMORY_STATS
+long RetiredAllocCount[PosixAllocator::MaxNumHeaps] = { 0 };
+long RetiredAllocSize[PosixAllocator::MaxNumHeaps] = { 0 };
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    Map memory directly from the system. Failing to get memory is fatal,
+    just like on Win32 where the heaps are created to generate exceptions.
+*/
+void*
+MapMemory(size_t size)
+{
+    void* ptr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (MAP_FAILED == ptr)
+    {
+        s_error("Posix::PosixAllocator: out of memory (%lu bytes requested)!\n", (unsigned long) size);
+    }
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Round a size up to whole pages.
+*/
+inline size_t
+RoundToPages(size_t size)
+{
+    static const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    return (size + pageSize - 1) & ~(pageSize - 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Size classes are spaced 16 bytes apart up to 128 bytes, then four
+    classes per power of two up to MaxSmallSize. This keeps the waste 
+    below 25% while needing only a handful of classes.
+*/
+inline unsigned int
+SizeToClass(size_t size)
+{
+    if (size <= 128)
+    {
+        return (unsigned int) ((size + 15) >> 4) - 1;
+    }
+    size_t v = size - 1;
+    unsigned int log = (unsigned int) (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(v);
+    return 8 + (log - 7) * 4 + (unsigned int) ((v >> (log - 2)) & 3);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline size_t
+ClassToSize(unsigned int sizeClass)
+{
+    if (sizeClass < 8)
+    {
+        return (sizeClass + 1) << 4;
+    }
+    unsigned int log = 7 + (sizeClass - 8) / 4;
+    return (size_t) (5 + (sizeClass - 8) % 4) << (log - 2);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Number of blocks moved between a thread cache and the depot at once.
+    Small blocks move in larger batches to keep the locking rare.
+*/
+inline unsigned int
+BatchSize(unsigned int sizeClass)
+{
+    size_t count = 8192 / ClassToSize(sizeClass);
+    if (count < 2) return 2;
+    if (count > 64) return 64;
+    return (unsigned int) count;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Detach up to maxCount blocks from the front of a free list.
+*/
+FreeBlock*
+DetachBatch(FreeList& list, unsigned int maxCount)
+{
+    FreeBlock* batch = list.head;
+    FreeBlock* tail = batch;
+    unsigned int count = 1;
+    while ((count < maxCount) && (0 != tail->next))
+    {
+        tail = tail->next;
+        ++count;
+    }
+    list.head = tail->next;
+    list.count -= count;
+    tail->next = 0;
+    return batch;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Hand a batch of blocks back to the depot of a size class.
+*/
+void
+ReleaseBatch(unsigned int sizeClass, FreeBlock* batch)
+{
+    Depot& depot = Depots[sizeClass];
+    pthread_mutex_lock(&depot.lock);
+    batch->nextBatch = depot.batches;
+    depot.batches = batch;
+    pthread_mutex_unlock(&depot.lock);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Refill an empty free list with a batch from the depot, carving a new 
+    batch from the current slab if the depot has none.
+*/
+void
+FetchBatch(unsigned int sizeClass, FreeList& list)
+{
+    Depot& depot = Depots[sizeClass];
+    FreeBlock* batch;
+
+    pthread_mutex_lock(&depot.lock);
+    if (0 != depot.batches)
+    {
+        batch = depot.batches;
+        depot.batches = batch->nextBatch;
+        pthread_mutex_unlock(&depot.lock);
+
+        unsigned int count = 0;
+        for (FreeBlock* block = batch; 0 != block; block = block->next)
+        {
+            ++count;
+        }
+        list.head = batch;
+        list.count = count;
+        return;
+    }
+
+    size_t blockSize = ClassToSize(sizeClass);
+    unsigned int count = BatchSize(sizeClass);
+    if (depot.slabCursor + blockSize * count > depot.slabEnd)
+    {
+        // the remains of the previous slab are smaller than a batch and get lost
+        depot.slabCursor = (char*) MapMemory(SlabSize);
+        depot.slabEnd = depot.slabCursor + SlabSize;
+    }
+    batch = (FreeBlock*) depot.slabCursor;
+    depot.slabCursor += blockSize * count;
+    pthread_mutex_unlock(&depot.lock);
+
+    char* ptr = (char*) batch;
+    for (unsigned int i = 0; i < count - 1; ++i)
+    {
+        ((FreeBlock*) ptr)->next = (FreeBlock*) (ptr + blockSize);
+        ptr += blockSize;
+    }
+    ((FreeBlock*) ptr)->next = 0;
+
+    list.head = batch;
+    list.count = count;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Called by pthreads when a thread exits. Returns the thread's cached 
+    blocks to the depots and keeps its statistics.
+*/
+void
+DestroyThreadCache(void* ptr)
+{
+    ThreadCache* cache = (ThreadCache*) ptr;
+    for (unsigned int sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+        FreeList& list = cache->lists[sizeClass];
+        while (0 != list.head)
+        {
+            ReleaseBatch(sizeClass, DetachBatch(list, BatchSize(sizeClass)));
+        }
+    }
+
+    pthread_mutex_lock(&RegistryLock);
+    #if STELLAR_MEMORY_STATS
+    for (unsigned int heapIndex = 0; heapIndex < PosixAllocator::MaxNumHeaps; ++heapIndex)
+    {
+        RetiredAllocCount[heapIndex] += cache->allocCount[heapIndex];
+        RetiredAllocSize[heapIndex] += cache->allocSize[heapIndex];
+    }
+    #endif
+    if (0 != cache->prev) cache->prev->next = cache->next;
+    else ThreadCaches = cache->next;
+    if (0 != cache->next) cache->next->prev = cache->prev;
+    pthread_mutex_unlock(&RegistryLock);
+
+    CurrentThreadCache = 0;
+    munmap(cache, RoundToPages(sizeof(ThreadCache)));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Initialize()
+{
+    for (unsigned int sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+        pthread_mutex_init(&Depots[sizeClass].lock, 0);
+    }
+    pthread_key_create(&ThreadCacheKey, DestroyThreadCache);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+ThreadCache*
+CreateThreadCache()
+{
+    pthread_once(&InitOnce, Initialize);
+
+    // mapped memory is zeroed, which is a valid empty cache
+    ThreadCache* cache = (ThreadCache*) MapMemory(RoundToPages(sizeof(ThreadCache)));
+
+    pthread_mutex_lock(&RegistryLock);
+    cache->next = ThreadCaches;
+    if (0 != ThreadCaches) ThreadCaches->prev = cache;
+    ThreadCaches = cache;
+    pthread_mutex_unlock(&RegistryLock);
+
+    pthread_setspecific(ThreadCacheKey, cache);
+    CurrentThreadCache = cache;
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline ThreadCache*
+GetThreadCache()
+{
+    ThreadCache* cache = CurrentThreadCache;
+    if (0 == cache)
+    {
+        cache = CreateThreadCache();
+    }
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline BlockHeader*
+HeaderOf(const void* ptr)
+{
+    BlockHeader* header = (BlockHeader*) ((char*) ptr - HeaderSize);
+    s_assert(BlockMagic == header->magic);
+    return header;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+void*
+PosixAllocator::Alloc(size_t size, unsigned int heapIndex)
+{
+    s_assert(heapIndex < MaxNumHeaps);
+    ThreadCache* cache = GetThreadCache();
+    size_t total = size + HeaderSize;
+
+    BlockHeader* header;
+    if ((total <= MaxSmallSize) && (total > size))
+    {
+        unsigned int sizeClass = SizeToClass(total);
+        FreeList& list = cache->lists[sizeClass];
+        if (0 == list.head)
+        {
+            FetchBatch(sizeClass, list);
+        }
+        header = (BlockHeader*) list.head;
+        list.head = list.head->next;
+        --list.count;
+        header->sizeClass = (unsigned short) sizeClass;
+    }
+    else
+    {
+        if (total < size)
+        {
+            s_error("Posix::PosixAllocator: out of memory (%lu bytes requested)!\n", (unsigned long) size);
+        }
+        header = (BlockHeader*) MapMemory(RoundToPages(total));
+        header->sizeClass = LargeClass;
+    }
+    header->size = size;
+    header->magic = BlockMagic;
+    header->heapIndex = heapIndex;
+
+    #if STELLAR_MEMORY_STATS
+    ++cache->allocCount[heapIndex];
+    cache->allocSize[heapIndex] += (long) size;
+    #endif
+    return (char*) header + HeaderSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Blocks stay in place as long as the new size maps to the same size 
+    class. A block keeps the heap it was allocated for, heapIndex is only
+    used if ptr is 0.
+*/
+void*
+PosixAllocator::Realloc(void* ptr, size_t size, unsigned int heapIndex)
+{
+    if (0 == ptr)
+    {
+        return Alloc(size, heapIndex);
+    }
+
+    BlockHeader* header = HeaderOf(ptr);
+    size_t total = size + HeaderSize;
+    if ((LargeClass != header->sizeClass) && (total <= MaxSmallSize) && 
+        (SizeToClass(total) == header->sizeClass))
+    {
+        #if STELLAR_MEMORY_STATS
+        GetThreadCache()->allocSize[header->heapIndex] += (long) size - (long) header->size;
+        #endif
+        header->size = size;
+        return ptr;
+    }
+
+    void* newPtr = Alloc(size, header->heapIndex);
+    memcpy(newPtr, ptr, (size < header->size) ? size : header->size);
+    Free(ptr);
+    return newPtr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Blocks go into the calling thread's cache, no matter which thread 
+    allocated them.
+*/
+void
+PosixAllocator::Free(void* ptr)
+{
+    BlockHeader* header = HeaderOf(ptr);
+    ThreadCache* cache = GetThreadCache();
+
+    #if STELLAR_MEMORY_STATS
+    --cache->allocCount[header->heapIndex];
+    cache->allocSize[header->heapIndex] -= (long) header->size;
+    #endif
+
+    unsigned int sizeClass = header->sizeClass;
+    header->magic = 0;
+    if (LargeClass == sizeClass)
+    {
+        munmap(header, RoundToPages(header->size + HeaderSize));
+        return;
+    }
+
+    FreeList& list = cache->lists[sizeClass];
+    FreeBlock* block = (FreeBlock*) header;
+    block->next = list.head;
+    list.head = block;
+    if (++list.count > 2 * BatchSize(sizeClass))
+    {
+        ReleaseBatch(sizeClass, DetachBatch(list, BatchSize(sizeClass)));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+size_t
+PosixAllocator::GetSize(const void* ptr)
+{
+    return HeaderOf(ptr)->size;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+unsigned int
+PosixAllocator::AcquireHeapIndex()
+{
+    unsigned int result = InvalidHeap;
+    pthread_mutex_lock(&RegistryLock);
+    for (unsigned int heapIndex = 1; heapIndex < MaxNumHeaps; ++heapIndex)
+    {
+        if (!HeapInUse[heapIndex])
+        {
+            HeapInUse[heapIndex] = true;
+            result = heapIndex;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&RegistryLock);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+PosixAllocator::ReleaseHeapIndex(unsigned int heapIndex)
+{
+    s_assert((heapIndex > 0) && (heapIndex < MaxNumHeaps));
+    pthread_mutex_lock(&RegistryLock);
+    HeapInUse[heapIndex] = false;
+    pthread_mutex_unlock(&RegistryLock);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Sums the counters of all threads. The counters of running threads are
+    read without synchronization, so the result is only a snapshot.
+*/
+int
+PosixAllocator::GetAllocCount(unsigned int heapIndex)
+{
+    s_assert(heapIndex < MaxNumHeaps);
+    long result = 0;
+    #if STELLAR_MEMORY_STATS
+    pthread_mutex_lock(&RegistryLock);
+    result = RetiredAllocCount[heapIndex];
+    for (ThreadCache* cache = ThreadCaches; 0 != cache; cache = cache->next)
+    {
+        result += ((volatile long*) cache->allocCount)[heapIndex];
+    }
+    pthread_mutex_unlock(&RegistryLock);
+    #endif
+    return (int) result;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+PosixAllocator::GetAllocSize(unsigned int heapIndex)
+{
+    s_assert(heapIndex < MaxNumHeaps);
+    long result = 0;
+    #if STELLAR_MEMORY_STATS
+    pthread_mutex_lock(&RegistryLock);
+    result = RetiredAllocSize[heapIndex];
+    for (ThreadCache* cache = ThreadCaches; 0 != cache; cache = cache->next)
+    {
+        result += ((volatile long*) cache->allocSize)[heapIndex];
+    }
+    pthread_mutex_unlock(&RegistryLock);
+    #endif
+    return (int) result;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Walks the free lists of the calling thread and all depot batches and 
+    checks that their blocks are properly aligned and counted.
+*/
+bool
+PosixAllocator::Validate()
+{
+    bool result = true;
+    ThreadCache* cache = GetThreadCache();
+    for (unsigned int sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+        unsigned int count = 0;
+        for (FreeBlock* block = cache->lists[sizeClass].head; 0 != block; block = block->next)
+        {
+            result &= (0 == ((size_t) block & (HeaderSize - 1)));
+            ++count;
+        }
+        result &= (count == cache->lists[sizeClass].count);
+
+        Depot& depot = Depots[sizeClass];
+        pthread_mutex_lock(&depot.lock);
+        for (FreeBlock* batch = depot.batches; 0 != batch; batch = batch->nextBatch)
+        {
+            for (FreeBlock* block = batch; 0 != block; block = block->next)
+            {
+                result &= (0 == ((size_t) block & (HeaderSize - 1)));
+            }
+        }
+        pthread_mutex_unlock(&depot.lock);
+    }
+    return result;
+}
+
+} // namespace Posix
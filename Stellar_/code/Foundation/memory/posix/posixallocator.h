@@ -0,0 +1,67 @@
+#pragma once
+#ifndef POSIX_POSIXALLOCATOR_H
+#define POSIX_POSIXALLOCATOR_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixAllocator
+  
+    Thread-caching allocator behind Memory::Alloc() and Posix::PosixHeap 
+    on Posix platforms.
+
+    Small blocks are rounded up to one of a few dozen size classes. Each 
+    thread keeps a free list per size class and allocates from it without
+    any locking. When a thread's free list runs empty it fetches a batch 
+    of blocks from the central depot, when it grows too long it hands a 
+    batch back. The depot carves new batches from slabs obtained with
+    mmap(). Large blocks are mapped individually.
+
+    Every block is preceded by a small header storing its size class and
+    the heap it belongs to, so Free() never has to look anything up.
+    Allocation statistics are counted per thread and heap and are only
+    summed when they are queried.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/config.h"
+#include "core/debug.h"
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixAllocator
+{
+public:
+    /// maximum number of heaps, including the process heap
+    static const unsigned int MaxNumHeaps = 64;
+    /// heap index of the process heap
+    static const unsigned int ProcessHeap = 0;
+
+    /// allocate a block of memory for a heap
+    static void* Alloc(size_t size, unsigned int heapIndex);
+    /// re-allocate a block of memory
+    static void* Realloc(void* ptr, size_t size, unsigned int heapIndex);
+    /// free a block of memory
+    static void Free(void* ptr);
+    /// get the usable size of a block of memory
+    static size_t GetSize(const void* ptr);
+
+    /// reserve a heap index, returns InvalidHeap if all are in use
+    static unsigned int AcquireHeapIndex();
+    /// give a heap index back
+    static void ReleaseHeapIndex(unsigned int heapIndex);
+
+    /// get the number of allocated blocks of a heap, summed over all threads
+    static int GetAllocCount(unsigned int heapIndex);
+    /// get the allocated size of a heap, summed over all threads
+    static int GetAllocSize(unsigned int heapIndex);
+    /// check the central depot and the calling thread's cache
+    static bool Validate();
+
+    /// returned by AcquireHeapIndex() if all heaps are in use
+    static const unsigned int InvalidHeap = 0xffffffff;
+};
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//  posixheap.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/posix/posixheap.h"
+
+namespace Posix
+{
+
+#if STELLAR_MEMORY_STATS
+std::list<PosixHeap*>* PosixHeap::m_pList = 0;
+pthread_mutex_t PosixHeap::m_ListLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    This method must be called at the beginning of the application because
+    any threads are spawned (usually called by Util::Setup().
+*/
+void
+PosixHeap::Setup()
+{
+    #if STELLAR_MEMORY_STATS
+    s_assert(0 == m_pList);
+    m_pList = s_new(std::list<PosixHeap*>);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+PosixHeap::PosixHeap(const char* heapName)
+{
+    s_assert(0 != heapName);
+    this->name = heapName;
+    this->heapIndex = PosixAllocator::AcquireHeapIndex();
+    s_assert(PosixAllocator::InvalidHeap != this->heapIndex);
+
+    // link into Heap list
+    #if STELLAR_MEMORY_STATS
+    s_assert(0 != m_pList);
+    pthread_mutex_lock(&m_ListLock);
+    m_pList->push_back(this);
+    this->listIterator = m_pList->end();
+    --this->listIterator;
+    pthread_mutex_unlock(&m_ListLock);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+PosixHeap::~PosixHeap()
+{
+    // unlink from Heap list
+    #if STELLAR_MEMORY_STATS
+    pthread_mutex_lock(&m_ListLock);
+    m_pList->erase(this->listIterator);
+    pthread_mutex_unlock(&m_ListLock);
+    #endif
+
+    PosixAllocator::ReleaseHeapIndex(this->heapIndex);
+    this->heapIndex = PosixAllocator::InvalidHeap;
+}
+
+#if STELLAR_MEMORY_STATS
+//------------------------------------------------------------------------------
+/**
+    Validate the heap. All heaps share the allocator, so this validates 
+    the allocator's depot and the calling thread's cache.
+*/
+bool
+PosixHeap::ValidateHeap() const
+{
+    return PosixAllocator::Validate();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+PosixHeap::GetAllocCount() const
+{
+    return PosixAllocator::GetAllocCount(this->heapIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+PosixHeap::GetAllocSize() const
+{
+    return PosixAllocator::GetAllocSize(this->heapIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Util::Array<PosixHeap::Stats>
+PosixHeap::GetAllHeapStats()
+{
+    s_assert(0 != m_pList);
+    Util::Array<Stats> result;
+    pthread_mutex_lock(&m_ListLock);
+    std::list<PosixHeap*>::iterator iter;
+    for (iter = m_pList->begin(); iter != m_pList->end(); iter++)
+    {
+        Stats stats;
+        stats.name       = (*iter)->GetName();
+        stats.allocCount = (*iter)->GetAllocCount();
+        stats.allocSize  = (*iter)->GetAllocSize();
+        result.push_back(stats);
+    }
+    pthread_mutex_unlock(&m_ListLock);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+    This static method calls the ValidateHeap() method on all heaps.
+*/
+bool
+PosixHeap::ValidateAllHeaps()
+{
+    s_assert(0 != m_pList);
+    pthread_mutex_lock(&m_ListLock);
+    bool result = true;
+    std::list<PosixHeap*>::iterator iter;
+    for (iter = m_pList->begin(); iter != m_pList->end(); iter++)
+    {
+        result &= (*iter)->ValidateHeap();
+    }
+    pthread_mutex_unlock(&m_ListLock);
+    return result;
+}
+#endif // STELLAR_MEMORY_STATS
+
+} // namespace Posix
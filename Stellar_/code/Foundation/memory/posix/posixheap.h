@@ -0,0 +1,122 @@
+#pragma once
+#ifndef POSIX_POSIXHEAP_H
+#define POSIX_POSIXHEAP_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixHeap
+  
+    Posix implementation of the class Memory::Heap. All heaps share the 
+    thread caches and slabs of Posix::PosixAllocator, a heap only owns an
+    index under which its allocations are counted. Unlike a Win32 heap,
+    destroying a PosixHeap doesn't free the blocks still allocated from it.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "memory/posix/posixallocator.h"
+#include "memory/alloctracker.h"
+#include "utility/array.h"
+#include <list>
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixHeap
+{
+public:
+    /// static setup method (called by Util::Setup)
+    static void Setup();
+    /// constructor (name must be static string!)
+    PosixHeap(const char* name);
+    /// destructor
+    ~PosixHeap();
+    /// get heap name
+    const char* GetName() const;
+    /// allocate a block of memory from the heap
+    void* Alloc(size_t size);
+    /// re-allocate a block of memory
+    void* Realloc(void* ptr, size_t newSize);
+    /// free a block of memory which has been allocated from this heap
+    void Free(void* ptr);
+
+    #if STELLAR_MEMORY_STATS
+    /// heap stats structure
+    struct Stats
+    {
+        const char* name;
+        int allocCount;
+        int allocSize;
+    };
+    /// gather stats from all existing heaps
+    static Util::Array<Stats> GetAllHeapStats();
+    /// validate all heaps
+    static bool ValidateAllHeaps();
+    /// validate the heap (only useful in Debug builds)
+    bool ValidateHeap() const;
+    /// get the current alloc count
+    int GetAllocCount() const;
+    /// get the current alloc size
+    int GetAllocSize() const;
+    #endif
+
+private:
+    /// default constructor not allowed
+    PosixHeap();
+
+    unsigned int heapIndex;
+    const char* name;
+
+    #if STELLAR_MEMORY_STATS
+    static pthread_mutex_t m_ListLock;
+    static std::list<PosixHeap*>* m_pList;
+    std::list<PosixHeap*>::iterator listIterator;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const char*
+PosixHeap::GetName() const
+{
+    s_assert(0 != this->name);
+    return this->name;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+PosixHeap::Alloc(size_t size)
+{
+    void* ptr = PosixAllocator::Alloc(size, this->heapIndex);
+    Memory::AllocTracker::OnAlloc(ptr, size, this->name, s_return_address());
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+PosixHeap::Realloc(void* ptr, size_t size)
+{
+    Memory::AllocTracker::OnFree(ptr);
+    void* newPtr = PosixAllocator::Realloc(ptr, size, this->heapIndex);
+    Memory::AllocTracker::OnAlloc(newPtr, size, this->name, s_return_address());
+    return newPtr;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixHeap::Free(void* ptr)
+{
+    s_assert(0 != ptr);
+    Memory::AllocTracker::OnFree(ptr);
+    PosixAllocator::Free(ptr);
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
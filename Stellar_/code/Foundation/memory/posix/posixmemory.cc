@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//  posixmemory.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "core/types.h"
+#include "memory/heap.h"
+#include <new>
+#include <sys/resource.h>
+
+namespace Memory
+{
+
+//------------------------------------------------------------------------------
+/**
+*/
+MemoryStatus
+GetMemoryStatus()
+{
+    unsigned long long pageSize = (unsigned long long) sysconf(_SC_PAGESIZE);
+    unsigned long long totalPhysical = (unsigned long long) sysconf(_SC_PHYS_PAGES) * pageSize;
+    #ifdef _SC_AVPHYS_PAGES
+    unsigned long long availPhysical = (unsigned long long) sysconf(_SC_AVPHYS_PAGES) * pageSize;
+    #else
+    unsigned long long availPhysical = totalPhysical;
+    #endif
+    unsigned long long totalVirtual = 0xffffffff;
+    struct rlimit limit;
+    if ((0 == getrlimit(RLIMIT_AS, &limit)) && (RLIM_INFINITY != limit.rlim_cur))
+    {
+        totalVirtual = limit.rlim_cur;
+    }
+
+    MemoryStatus result;
+    result.totalPhysical = (unsigned int) ((totalPhysical < 0xffffffff) ? totalPhysical : 0xffffffff);
+    result.availPhysical = (unsigned int) ((availPhysical < 0xffffffff) ? availPhysical : 0xffffffff);
+    result.totalVirtual  = (unsigned int) ((totalVirtual < 0xffffffff) ? totalVirtual : 0xffffffff);
+    result.availVirtual  = result.totalVirtual;
+    return result;
+}
+
+#if STELLAR_MEMORY_STATS
+//------------------------------------------------------------------------------
+/**
+    Debug function which validates the allocator and all local heaps. 
+*/
+bool
+Validate()
+{
+    bool res = Posix::PosixAllocator::Validate();
+    res &= Heap::ValidateAllHeaps();
+    return res;
+}
+#endif
+} // namespace Memory
+
+//------------------------------------------------------------------------------
+/**
+    Replacement global new operator.
+*/
+void*
+operator new(size_t size)
+{
+    return Memory::Alloc(size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement global new[] operator.
+*/
+void*
+operator new[](size_t size)
+{
+    return Memory::Alloc(size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement global delete operator.
+*/
+void
+operator delete(void* p) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement global delete[] operator.
+*/
+void
+operator delete[](void* p) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement sized delete operator. The compiler calls these instead
+    of the unsized ones when sized deallocation is enabled (the default
+    since C++14). The runtime's versions usually forward to the replaced
+    unsized operators, but a sanitizer runtime frees the block itself.
+*/
+#if __cpp_sized_deallocation
+void
+operator delete(void* p, size_t) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement sized delete[] operator.
+*/
+void
+operator delete[](void* p, size_t) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    Replacement nothrow new operator. The nothrow operators have to be
+    replaced as well, or their memory would be freed by the replaced
+    delete operators without coming from Memory::Alloc().
+*/
+void*
+operator new(size_t size, const std::nothrow_t&) throw()
+{
+    return Memory::Alloc(size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement nothrow new[] operator.
+*/
+void*
+operator new[](size_t size, const std::nothrow_t&) throw()
+{
+    return Memory::Alloc(size);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement nothrow delete operator.
+*/
+void
+operator delete(void* p, const std::nothrow_t&) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Replacement nothrow delete[] operator.
+*/
+void
+operator delete[](void* p, const std::nothrow_t&) throw()
+{
+    if (0 != p)
+    {
+        Memory::Free(p);
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+#ifndef MEMORY_POSIXMEMORY_H
+#define MEMORY_POSIXMEMORY_H
+//------------------------------------------------------------------------------
+/**
+    @file memory/posix/posixmemory.h
+
+    Low level memory functions for Posix platforms. Memory comes from 
+    Posix::PosixAllocator, which caches blocks per thread, so the common
+    Alloc() and Free() calls don't need any locking.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/config.h"
+#include "core/debug.h"
+#include "memory/posix/posixallocator.h"
+#include "memory/alloctracker.h"
+#include <string.h>
+
+namespace Memory
+{
+
+//------------------------------------------------------------------------------
+/**
+    Allocate a block of memory from the process heap.
+*/
+inline void*
+Alloc(size_t size)
+{
+    void* ptr = Posix::PosixAllocator::Alloc(size, Posix::PosixAllocator::ProcessHeap);
+    AllocTracker::OnAlloc(ptr, size, "Process", s_return_address());
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Reallocate a block of memory.
+*/
+inline void*
+Realloc(void* ptr, size_t size)
+{
+    AllocTracker::OnFree(ptr);
+    void* newPtr = Posix::PosixAllocator::Realloc(ptr, size, Posix::PosixAllocator::ProcessHeap);
+    AllocTracker::OnAlloc(newPtr, size, "Process", s_return_address());
+    return newPtr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Free a chunk of memory from the process heap.
+*/
+inline void
+Free(void* ptr)
+{
+    s_assert(0 != ptr);
+    AllocTracker::OnFree(ptr);
+    Posix::PosixAllocator::Free(ptr);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Copy a chunk of memory (note the argument order is different 
+    from memcpy()!!!)
+*/
+inline void
+Copy(const void* from, void* to, size_t numBytes)
+{
+    if (numBytes > 0)
+    {
+        s_assert(0 != from);
+        s_assert(0 != to);
+        s_assert(from != to);
+        memmove(to, from, numBytes);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Overwrite a chunk of memory with 0's.
+*/
+inline void
+Clear(void* ptr, size_t numBytes)
+{
+    memset(ptr, 0, numBytes);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Duplicate a 0-terminated string.
+*/
+inline char*
+DuplicateCString(const char* from)
+{
+    s_assert(0 != from);
+    size_t len = (unsigned int) strlen(from) + 1;
+    char* to = (char*) Memory::Alloc(len);
+    Memory::Copy((void*)from, to, len);
+    return to;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the system's total current memory, this does not only include
+    Nebula3's memory allocations but the memory usage of the entire system.
+    The virtual memory is the address space limit of the process, which 
+    is usually unlimited and then reported as 0xffffffff.
+*/
+struct MemoryStatus
+{
+    unsigned int totalPhysical;
+    unsigned int availPhysical;
+    unsigned int totalVirtual;
+    unsigned int availVirtual;
+};
+
+extern MemoryStatus GetMemoryStatus();
+
+#if STELLAR_MEMORY_STATS
+//------------------------------------------------------------------------------
+/**
+    Get the number of blocks allocated from the process heap.
+*/
+inline int
+GetAllocCount()
+{
+    return Posix::PosixAllocator::GetAllocCount(Posix::PosixAllocator::ProcessHeap);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the number of bytes allocated from the process heap.
+*/
+inline int
+GetAllocSize()
+{
+    return Posix::PosixAllocator::GetAllocSize(Posix::PosixAllocator::ProcessHeap);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Debug function which validates the allocator and all local heaps. 
+*/
+extern bool Validate();
+#endif
+} // namespace Memory
+
+#ifdef new
+#undef new
+#endif
+
+#ifdef delete
+#undef delete
+#endif
+
+// the replacement global new and delete operators are defined in posixmemory.cc,
+// gcc doesn't allow them to be inline
+
+#define s_new(type) new type
+#define s_new_array(type,size) new type[size]
+#define s_delete(ptr) delete ptr
+#define s_delete_array(ptr) delete[] ptr
+//------------------------------------------------------------------------------
+#endif
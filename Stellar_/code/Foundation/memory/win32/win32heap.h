@@ -14,6 +14,7 @@
 #include "core/types.h"
 #include "thread/interlocked.h"
 #include "thread/criticalsection.h"
+#include "memory/alloctracker.h"
 #include "utility/array.h"
 //#include "utility/list.h"
 
@@ -94,7 +95,9 @@ Win32Heap::Alloc(size_t size)
     Threading::Interlocked::Increment(this->allocCount);
     Threading::Interlocked::Add(this->allocSize, int(size));
     #endif
-    return HeapAlloc(this->heap, HEAP_GENERATE_EXCEPTIONS, size);
+    void* ptr = HeapAlloc(this->heap, HEAP_GENERATE_EXCEPTIONS, size);
+    Memory::AllocTracker::OnAlloc(ptr, size, this->name, s_return_address());
+    return ptr;
 }
 
 //------------------------------------------------------------------------------
@@ -107,7 +110,10 @@ Win32Heap::Realloc(void* ptr, size_t size)
     size_t curSize = HeapSize(this->heap, 0, ptr);
     Threading::Interlocked::Add(this->allocSize, int(size - curSize));
     #endif
-    return HeapReAlloc(this->heap, HEAP_GENERATE_EXCEPTIONS, ptr, size);
+    Memory::AllocTracker::OnFree(ptr);
+    void* newPtr = HeapReAlloc(this->heap, HEAP_GENERATE_EXCEPTIONS, ptr, size);
+    Memory::AllocTracker::OnAlloc(newPtr, size, this->name, s_return_address());
+    return newPtr;
 }
 
 //------------------------------------------------------------------------------
@@ -122,6 +128,7 @@ Win32Heap::Free(void* ptr)
     Threading::Interlocked::Add(this->allocSize, -int(size));
     Threading::Interlocked::Decrement(this->allocCount);
     #endif
+    Memory::AllocTracker::OnFree(ptr);
     BOOL success = HeapFree(this->heap, 0, ptr);
     s_assert(0 != success);
 }
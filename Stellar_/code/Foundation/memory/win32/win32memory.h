@@ -12,6 +12,7 @@
 #include "core/config.h"
 #include "core/debug.h"
 #include "thread/interlocked.h"
+#include "memory/alloctracker.h"
 
 namespace Memory
 {
@@ -36,7 +37,9 @@ Alloc(size_t size)
     Threading::Interlocked::Increment(AllocCount);
     Threading::Interlocked::Add(AllocSize, int(size));
     #endif
-    return HeapAlloc(Win32ProcessHeap, HEAP_GENERATE_EXCEPTIONS, size);
+    void* ptr = HeapAlloc(Win32ProcessHeap, HEAP_GENERATE_EXCEPTIONS, size);
+    AllocTracker::OnAlloc(ptr, size, "Process", s_return_address());
+    return ptr;
 }
 
 //------------------------------------------------------------------------------
@@ -51,7 +54,10 @@ Realloc(void* ptr, size_t size)
     size_t curSize = HeapSize(Win32ProcessHeap, 0, ptr);
     Threading::Interlocked::Add(AllocSize, int(size - curSize));
     #endif
-    return HeapReAlloc(Win32ProcessHeap, HEAP_GENERATE_EXCEPTIONS, ptr, size);
+    AllocTracker::OnFree(ptr);
+    void* newPtr = HeapReAlloc(Win32ProcessHeap, HEAP_GENERATE_EXCEPTIONS, ptr, size);
+    AllocTracker::OnAlloc(newPtr, size, "Process", s_return_address());
+    return newPtr;
 }
 
 //------------------------------------------------------------------------------
@@ -69,6 +75,7 @@ Free(void* ptr)
     Threading::Interlocked::Add(AllocSize, -int(size));
     Threading::Interlocked::Decrement(AllocCount);
     #endif
+    AllocTracker::OnFree(ptr);
     HeapFree(Win32ProcessHeap, 0, ptr);
 }
 
@@ -147,6 +154,26 @@ GetMemoryStatus()
 */
 #if STELLAR_MEMORY_STATS
 extern bool Validate();
+
+//------------------------------------------------------------------------------
+/**
+    Get the number of blocks allocated from the process heap.
+*/
+inline int
+GetAllocCount()
+{
+    return AllocCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the number of bytes allocated from the process heap.
+*/
+inline int
+GetAllocSize()
+{
+    return AllocSize;
+}
 #endif
 } // namespace Memory
 
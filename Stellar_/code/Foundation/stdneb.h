@@ -13,6 +13,8 @@
 #include "core/config.h"
 #if __WIN32__
 #include "core/win32/precompiled.h"
+#elif __POSIX__
+#include "core/posix/precompiled.h"
 #else
 #error "precompiled.h not implemented on this platform"
 #endif
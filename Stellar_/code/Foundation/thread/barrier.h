@@ -18,6 +18,8 @@
 */    
 #if __WIN32__
 #include "thread/win32/win32barrier.h"
+#elif __POSIX__
+#include "thread/posix/posixbarrier.h"
 #else
 #error "Barrier not implemented on this platform!"
 #endif
@@ -0,0 +1,249 @@
+#pragma once
+#ifndef THREADING_BUCKETPRIORITYQUEUE_H
+#define THREADING_BUCKETPRIORITYQUEUE_H
+//------------------------------------------------------------------------------
+/**
+    @class Threading::BucketPriorityQueue
+
+    A lock-free priority queue with a fixed number of priority levels for
+    any number of producer and consumer threads. Level 0 is the highest
+    priority. Every level is a Threading::MpmcQueue, elements of the same
+    level are dequeued in FIFO order. A bitmask of the levels which may
+    contain elements lets Dequeue() find the highest non-empty level
+    without looking at the empty ones.
+
+    Enqueue() and Dequeue() are O(1), unlike SafePriorityQueue which
+    inserts sorted under a lock. Wait() spins before it parks the thread,
+    like MpmcQueue::Wait().
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "thread/mpmcqueue.h"
+
+//------------------------------------------------------------------------------
+namespace Threading
+{
+template<class TYPE> class BucketPriorityQueue
+{
+public:
+    /// maximum number of priority levels
+    static const SizeT MaxNumLevels = 32;
+    /// number of times Wait() checks the queue before parking the thread
+    static const int SpinCount = 4000;
+
+    /// constructor
+    BucketPriorityQueue(SizeT numLevels = 8, SizeT capacityPerLevel = 1024);
+    /// destructor
+    ~BucketPriorityQueue();
+
+    /// get number of priority levels
+    SizeT GetNumLevels() const;
+    /// return true if the queue is empty (only a snapshot if other threads are active)
+    bool IsEmpty() const;
+
+    /// add an element with a priority level, returns false if the level is full
+    bool Enqueue(IndexT level, const TYPE& e);
+    /// remove the element with the highest priority, returns false if the queue is empty
+    bool Dequeue(TYPE& e);
+    /// wait until the queue contains at least one element
+    void Wait();
+    /// wake up a thread waiting in Wait(), e.g. when it should stop
+    void Signal();
+
+private:
+    /// copying not allowed
+    BucketPriorityQueue(const BucketPriorityQueue<TYPE>&);
+    /// assignment not allowed
+    void operator=(const BucketPriorityQueue<TYPE>&);
+    /// atomically set the bit of a level in the mask
+    void SetLevelBit(IndexT level);
+    /// atomically clear the bit of a level in the mask
+    void ClearLevelBit(IndexT level);
+
+    MpmcQueue<TYPE>* levels[MaxNumLevels];
+    SizeT numLevels;
+    int volatile levelMask;
+    int volatile numWaiters;
+    Event enqueueEvent;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+BucketPriorityQueue<TYPE>::BucketPriorityQueue(SizeT num, SizeT capacityPerLevel) :
+    numLevels(num),
+    levelMask(0),
+    numWaiters(0)
+{
+    s_assert((num > 0) && (num <= MaxNumLevels));
+    IndexT i;
+    for (i = 0; i < this->numLevels; i++)
+    {
+        this->levels[i] = s_new(MpmcQueue<TYPE>(capacityPerLevel));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+BucketPriorityQueue<TYPE>::~BucketPriorityQueue()
+{
+    IndexT i;
+    for (i = 0; i < this->numLevels; i++)
+    {
+        s_delete(this->levels[i]);
+        this->levels[i] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> SizeT
+BucketPriorityQueue<TYPE>::GetNumLevels() const
+{
+    return this->numLevels;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+BucketPriorityQueue<TYPE>::IsEmpty() const
+{
+    return 0 == this->levelMask;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+BucketPriorityQueue<TYPE>::SetLevelBit(IndexT level)
+{
+    unsigned int bit = 1u << level;
+    int mask;
+    while (0 == ((mask = this->levelMask) & bit))
+    {
+        if (mask == Interlocked::CompareExchange(this->levelMask, (int)(mask | bit), mask))
+        {
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+BucketPriorityQueue<TYPE>::ClearLevelBit(IndexT level)
+{
+    unsigned int bit = 1u << level;
+    int mask;
+    while (0 != ((mask = this->levelMask) & bit))
+    {
+        if (mask == Interlocked::CompareExchange(this->levelMask, (int)(mask & ~bit), mask))
+        {
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    The level's bit is set after the element has been added, so a
+    consumer which sees the bit also finds the element.
+*/
+template<class TYPE> bool
+BucketPriorityQueue<TYPE>::Enqueue(IndexT level, const TYPE& e)
+{
+    s_assert(level < this->numLevels);
+    if (!this->levels[level]->Enqueue(e))
+    {
+        return false;
+    }
+    this->SetLevelBit(level);
+
+    // MpmcQueue::Enqueue() ends with a full barrier, so a parked consumer
+    // is seen here or the consumer sees the level's bit before parking
+    if (0 != this->numWaiters)
+    {
+        this->enqueueEvent.Signal();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Tries the levels in the mask from the highest priority on. A level
+    which turns out to be empty has its bit cleared. Since a producer may
+    have added an element between the failed Dequeue() and clearing the
+    bit, the level is checked again and the bit restored if necessary.
+    Like MpmcQueue::Dequeue() this may fail while an element is still
+    being added by another thread.
+*/
+template<class TYPE> bool
+BucketPriorityQueue<TYPE>::Dequeue(TYPE& e)
+{
+    unsigned int mask = (unsigned int)this->levelMask;
+    IndexT level;
+    for (level = 0; 0 != mask; level++, mask >>= 1)
+    {
+        if (0 != (mask & 1))
+        {
+            MpmcQueue<TYPE>* queue = this->levels[level];
+            if (queue->Dequeue(e))
+            {
+                return true;
+            }
+            this->ClearLevelBit(level);
+            if (!queue->IsEmpty())
+            {
+                this->SetLevelBit(level);
+            }
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns when the queue isn't empty, or when Signal() has been called.
+    See MpmcQueue::Wait() for details.
+*/
+template<class TYPE> void
+BucketPriorityQueue<TYPE>::Wait()
+{
+    int i;
+    for (i = 0; i < SpinCount; i++)
+    {
+        if (!this->IsEmpty())
+        {
+            return;
+        }
+    }
+    Interlocked::Increment(this->numWaiters);
+    if (this->IsEmpty())
+    {
+        this->enqueueEvent.Wait();
+    }
+    if ((0 != Interlocked::Decrement(this->numWaiters)) && !this->IsEmpty())
+    {
+        this->enqueueEvent.Signal();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+BucketPriorityQueue<TYPE>::Signal()
+{
+    this->enqueueEvent.Signal();
+}
+
+} // namespace Threading
+//------------------------------------------------------------------------------
+#endif
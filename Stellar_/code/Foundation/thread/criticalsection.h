@@ -19,6 +19,13 @@ namespace Threading
 class CriticalSection : public Win32::Win32CriticalSection
 { };
 };
+#elif __POSIX__
+#include "thread/posix/posixcriticalsection.h"
+namespace Threading
+{
+class CriticalSection : public Posix::PosixCriticalSection
+{ };
+}
 #else
 #error "Threading::CriticalSection not implemented on this platform!"
 #endif
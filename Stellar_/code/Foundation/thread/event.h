@@ -17,6 +17,13 @@ namespace Threading
 class Event : public Win32::Win32Event
 { };
 }
+#elif __POSIX__
+#include "thread/posix/posixevent.h"
+namespace Threading
+{
+class Event : public Posix::PosixEvent
+{ };
+}
 #else
 #error "Threading::Event not implemented on this platform!"
 #endif
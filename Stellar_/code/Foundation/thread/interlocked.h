@@ -17,6 +17,13 @@ namespace Threading
 class Interlocked : public Win32::Win32Interlocked
 { };
 }
+#elif __POSIX__
+#include "thread/posix/posixinterlocked.h"
+namespace Threading
+{
+class Interlocked : public Posix::PosixInterlocked
+{ };
+}
 #else
 #error "Threading::Interlocked not implemented on this platform!"
 #endif
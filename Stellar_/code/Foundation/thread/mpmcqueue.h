@@ -0,0 +1,282 @@
+#pragma once
+#ifndef THREADING_MPMCQUEUE_H
+#define THREADING_MPMCQUEUE_H
+//------------------------------------------------------------------------------
+/**
+    @class Threading::MpmcQueue
+
+    A bounded lock-free queue for any number of producer and consumer
+    threads. The elements live in a ring buffer whose capacity is a power
+    of two. Every slot carries a sequence number which tells whether the
+    slot is ready to be written by the producer of the current lap or to
+    be read by the consumer of the current lap, so Enqueue() and Dequeue()
+    only need one compare-exchange on the shared position. Enqueue() fails
+    when the queue is full, Dequeue() fails when it is empty.
+
+    Wait() blocks until the queue contains at least one element. It spins
+    for a while and only parks the thread on an event if nothing has been
+    added in the meantime, producers only signal the event when a consumer
+    is actually parked.
+
+    The element type needs a default constructor and an assignment operator.
+    Dequeued slots are reset to a default constructed element, so smart
+    pointers don't keep their objects alive inside the queue.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "thread/interlocked.h"
+#include "thread/event.h"
+
+//------------------------------------------------------------------------------
+namespace Threading
+{
+template<class TYPE> class MpmcQueue
+{
+public:
+    /// number of times Wait() checks the queue before parking the thread
+    static const int SpinCount = 4000;
+
+    /// constructor, capacity is rounded up to a power of two
+    MpmcQueue(SizeT capacity = 1024);
+    /// destructor
+    ~MpmcQueue();
+
+    /// get the capacity of the queue
+    SizeT Capacity() const;
+    /// get the number of elements (only a snapshot if other threads are active)
+    SizeT Size() const;
+    /// return true if the queue is empty (only a snapshot if other threads are active)
+    bool IsEmpty() const;
+
+    /// add an element to the back of the queue, returns false if the queue is full
+    bool Enqueue(const TYPE& e);
+    /// remove the element at the front of the queue, returns false if the queue is empty
+    bool Dequeue(TYPE& e);
+    /// wait until the queue contains at least one element
+    void Wait();
+    /// wake up a thread waiting in Wait(), e.g. when it should stop
+    void Signal();
+
+private:
+    /// a slot of the ring buffer
+    struct Cell
+    {
+        int volatile sequence;
+        TYPE data;
+    };
+    /// separates the positions written by producers and consumers into different cache lines
+    struct Padding
+    {
+        char bytes[64];
+    };
+
+    /// copying not allowed
+    MpmcQueue(const MpmcQueue<TYPE>&);
+    /// assignment not allowed
+    void operator=(const MpmcQueue<TYPE>&);
+
+    Cell* cells;
+    SizeT mask;
+    Padding pad0;
+    int volatile enqueuePos;
+    Padding pad1;
+    int volatile dequeuePos;
+    Padding pad2;
+    int volatile numWaiters;
+    Event enqueueEvent;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+MpmcQueue<TYPE>::MpmcQueue(SizeT capacity) :
+    cells(0),
+    mask(0),
+    enqueuePos(0),
+    dequeuePos(0),
+    numWaiters(0)
+{
+    s_assert(capacity > 1);
+    SizeT size = 2;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    this->cells = s_new_array(Cell, size);
+    this->mask = size - 1;
+    IndexT i;
+    for (i = 0; i < size; i++)
+    {
+        this->cells[i].sequence = int(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+MpmcQueue<TYPE>::~MpmcQueue()
+{
+    s_delete_array(this->cells);
+    this->cells = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> SizeT
+MpmcQueue<TYPE>::Capacity() const
+{
+    return this->mask + 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> SizeT
+MpmcQueue<TYPE>::Size() const
+{
+    int size = int((unsigned int)this->enqueuePos - (unsigned int)this->dequeuePos);
+    return (size > 0) ? SizeT(size) : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+MpmcQueue<TYPE>::IsEmpty() const
+{
+    return 0 == this->Size();
+}
+
+//------------------------------------------------------------------------------
+/**
+    A slot is free for the producer at position pos when its sequence
+    equals pos. The producer claims the position, writes the element and
+    publishes it by setting the sequence to pos + 1.
+*/
+template<class TYPE> bool
+MpmcQueue<TYPE>::Enqueue(const TYPE& e)
+{
+    Cell* cell;
+    int pos = this->enqueuePos;
+    for (;;)
+    {
+        cell = &this->cells[pos & this->mask];
+        int diff = int((unsigned int)cell->sequence - (unsigned int)pos);
+        if (0 == diff)
+        {
+            int prevPos = Interlocked::CompareExchange(this->enqueuePos, int((unsigned int)pos + 1), pos);
+            if (prevPos == pos)
+            {
+                break;
+            }
+            pos = prevPos;
+        }
+        else if (diff < 0)
+        {
+            // the slot still holds an element of the previous lap
+            return false;
+        }
+        else
+        {
+            pos = this->enqueuePos;
+        }
+    }
+    cell->data = e;
+    Interlocked::Exchange(cell->sequence, int((unsigned int)pos + 1));
+
+    // the exchange above is a full barrier, so either a parked consumer
+    // is seen here or the consumer sees the element before parking
+    if (0 != this->numWaiters)
+    {
+        this->enqueueEvent.Signal();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    A slot holds an element for the consumer at position pos when its
+    sequence equals pos + 1. The consumer claims the position, reads the
+    element and frees the slot for the next lap by setting the sequence
+    to pos + capacity.
+*/
+template<class TYPE> bool
+MpmcQueue<TYPE>::Dequeue(TYPE& e)
+{
+    Cell* cell;
+    int pos = this->dequeuePos;
+    for (;;)
+    {
+        cell = &this->cells[pos & this->mask];
+        int diff = int((unsigned int)cell->sequence - ((unsigned int)pos + 1));
+        if (0 == diff)
+        {
+            int prevPos = Interlocked::CompareExchange(this->dequeuePos, int((unsigned int)pos + 1), pos);
+            if (prevPos == pos)
+            {
+                break;
+            }
+            pos = prevPos;
+        }
+        else if (diff < 0)
+        {
+            // the producer of this position hasn't published yet
+            return false;
+        }
+        else
+        {
+            pos = this->dequeuePos;
+        }
+    }
+    e = cell->data;
+    cell->data = TYPE();
+    Interlocked::Exchange(cell->sequence, int((unsigned int)pos + this->mask + 1));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns when the queue isn't empty, or when Signal() has been called.
+    Since other consumers may be faster, the caller must still check the
+    result of Dequeue(). The event is an auto-reset event which wakes up
+    only one thread, so a woken thread passes the wakeup on if there are
+    more elements and more parked threads.
+*/
+template<class TYPE> void
+MpmcQueue<TYPE>::Wait()
+{
+    int i;
+    for (i = 0; i < SpinCount; i++)
+    {
+        if (!this->IsEmpty())
+        {
+            return;
+        }
+    }
+    Interlocked::Increment(this->numWaiters);
+    if (this->IsEmpty())
+    {
+        this->enqueueEvent.Wait();
+    }
+    if ((0 != Interlocked::Decrement(this->numWaiters)) && !this->IsEmpty())
+    {
+        this->enqueueEvent.Signal();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+MpmcQueue<TYPE>::Signal()
+{
+    this->enqueueEvent.Signal();
+}
+
+} // namespace Threading
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef POSIX_POSIXBARRIER_H
+#define POSIX_POSIXBARRIER_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixBarrier
+    
+    Implements the 2 macros ReadWriteBarrier and MemoryBarrier.
+    
+    ReadWriteBarrier prevents the compiler from re-ordering memory
+    accesses accross the barrier.
+
+    MemoryBarrier prevents the CPU from reordering memory access across
+    the barrier (all memory access will be finished before the barrier
+    is crossed).
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+
+//------------------------------------------------------------------------------
+#define ReadWriteBarrier() __asm__ __volatile__("" ::: "memory")
+#define MemoryBarrier() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+//  posixcriticalsection.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "thread/posix/posixcriticalsection.h"
+
+namespace Posix
+{
+__thread char PosixCriticalSection::ThreadIdTag = 0;
+
+//------------------------------------------------------------------------------
+/**
+    Spins while the lock is taken, up to twice the number of spins which
+    were recently needed to get it. The estimate is only updated by the
+    thread which got the lock, so it needs no atomic operations. If
+    spinning doesn't help the lock is marked as contended and the thread
+    parks until Leave() wakes it up. A woken thread must mark the lock as
+    contended again, since it can't know whether other threads are still
+    parked. A parked thread moves the estimate towards the spin limit
+    once it owns the lock.
+*/
+void
+PosixCriticalSection::EnterContended()
+{
+    int maxSpins = 0;
+    if (PosixFutex::GetNumCores() > 1)
+    {
+        maxSpins = 2 * this->spinEstimate + 16;
+        if (maxSpins > MaxSpinCount)
+        {
+            maxSpins = MaxSpinCount;
+        }
+        int spins;
+        for (spins = 0; spins < maxSpins; spins++)
+        {
+            PosixFutex::Pause();
+            if ((0 == this->lockState) && (0 == PosixInterlocked::CompareExchange(this->lockState, 1, 0)))
+            {
+                this->spinEstimate += (spins - this->spinEstimate) / 8;
+                return;
+            }
+        }
+    }
+    while (0 != PosixInterlocked::Exchange(this->lockState, 2))
+    {
+        PosixFutex::Wait(this->lockState, 2);
+    }
+    if (maxSpins > 0)
+    {
+        this->spinEstimate += (maxSpins - this->spinEstimate) / 8;
+    }
+}
+
+} // namespace Posix
@@ -0,0 +1,139 @@
+#pragma once
+#ifndef POSIX_POSIXCRITICALSECTION_H
+#define POSIX_POSIXCRITICALSECTION_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixCriticalSection
+  
+    Posix implementation of critical section. Critical section
+    objects are used to protect a portion of code from parallel
+    execution. Define a static critical section object and
+    use its Enter() and Leave() methods to protect critical sections
+    of your code.
+
+    The lock is a single int which is 0 when free, 1 when locked and 2
+    when locked and other threads may be parked on it, so Enter() and
+    Leave() don't enter the kernel unless there is contention. A thread
+    which finds the lock taken spins for a while before it parks on a
+    futex. The number of spins adapts to how long the lock was held
+    recently, on a single core machine it never spins. Like a Win32
+    critical section the lock may be entered recursively by the thread
+    which owns it.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "thread/posix/posixfutex.h"
+#include "thread/posix/posixinterlocked.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixCriticalSection
+{
+public:
+    /// maximum number of spins before parking the thread
+    static const int MaxSpinCount = 1024;
+
+    /// constructor
+    PosixCriticalSection();
+    /// destructor
+    ~PosixCriticalSection();
+    /// enter the critical section
+    void Enter();
+    /// leave the critical section
+    void Leave();
+
+private:
+    /// copying not allowed
+    PosixCriticalSection(const PosixCriticalSection&);
+    /// assignment not allowed
+    void operator=(const PosixCriticalSection&);
+    /// slow path of Enter(), spin and park
+    void EnterContended();
+    /// get a unique id of the calling thread
+    static void* GetThreadId();
+
+    int volatile lockState;
+    int spinEstimate;
+    void* volatile owner;
+    int recursionCount;
+    static __thread char ThreadIdTag;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+PosixCriticalSection::PosixCriticalSection() :
+    lockState(0),
+    spinEstimate(MaxSpinCount / 8),
+    owner(0),
+    recursionCount(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+PosixCriticalSection::~PosixCriticalSection()
+{
+    s_assert(0 == this->lockState);
+}
+
+//------------------------------------------------------------------------------
+/**
+    The address of a thread local variable is different for every thread
+    and cheaper to get than pthread_self().
+*/
+inline void*
+PosixCriticalSection::GetThreadId()
+{
+    return &ThreadIdTag;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The owner is only compared against the calling thread, which can only
+    find its own id there if it has written it itself.
+*/
+inline void
+PosixCriticalSection::Enter()
+{
+    void* self = GetThreadId();
+    if (self == this->owner)
+    {
+        this->recursionCount++;
+        return;
+    }
+    if (0 != PosixInterlocked::CompareExchange(this->lockState, 1, 0))
+    {
+        this->EnterContended();
+    }
+    this->owner = self;
+    this->recursionCount = 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixCriticalSection::Leave()
+{
+    s_assert(GetThreadId() == this->owner);
+    if (0 != --this->recursionCount)
+    {
+        return;
+    }
+    this->owner = 0;
+    if (2 == PosixInterlocked::Exchange(this->lockState, 0))
+    {
+        PosixFutex::Wake(this->lockState, 1);
+    }
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,151 @@
+#pragma once
+#ifndef POSIX_POSIXEVENT_H
+#define POSIX_POSIXEVENT_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixEvent
+
+    Posix implementation of an event synchronization object. Like the
+    Win32 event it is an auto-reset event: a successful Wait(), 
+    WaitTimeout() or Peek() resets the event, and Signal() wakes up only
+    one waiting thread. The signalled state is an int which waiting
+    threads park on with a futex. Signal() only enters the kernel if a 
+    thread is actually waiting.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "thread/posix/posixfutex.h"
+#include "thread/posix/posixinterlocked.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixEvent
+{
+public:
+    /// constructor
+    PosixEvent();
+    /// destructor
+    ~PosixEvent();
+    /// signal the event
+    void Signal();
+    /// wait for the event to become signalled
+    void Wait() const;
+    /// wait for the event with timeout in millisecs
+    bool WaitTimeout(int ms) const;
+    /// check if event is signalled
+    bool Peek() const;
+
+private:
+    /// copying not allowed
+    PosixEvent(const PosixEvent&);
+    /// assignment not allowed
+    void operator=(const PosixEvent&);
+    /// get a monotonic time stamp in millisecs
+    static long long GetMilliSecs();
+
+    mutable int volatile signalled;
+    mutable int volatile numWaiters;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+PosixEvent::PosixEvent() :
+    signalled(0),
+    numWaiters(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+PosixEvent::~PosixEvent()
+{
+    s_assert(0 == this->numWaiters);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Both the exchange here and the increment in Wait() are full barriers,
+    so either the waiter sees the signalled state before parking or the
+    signalling thread sees the waiter.
+*/
+inline void
+PosixEvent::Signal()
+{
+    PosixInterlocked::Exchange(this->signalled, 1);
+    if (0 != this->numWaiters)
+    {
+        PosixFutex::Wake(this->signalled, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixEvent::Wait() const
+{
+    while (!this->Peek())
+    {
+        PosixInterlocked::Increment(this->numWaiters);
+        PosixFutex::Wait(this->signalled, 0);
+        PosixInterlocked::Decrement(this->numWaiters);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Waits for the event to become signaled with a specified timeout
+    in milli seconds. If the method times out it will return false,
+    if the event becomes signalled within the timeout it will return 
+    true.
+*/
+inline bool
+PosixEvent::WaitTimeout(int timeoutInMilliSec) const
+{
+    long long endTime = GetMilliSecs() + timeoutInMilliSec;
+    while (!this->Peek())
+    {
+        long long remaining = endTime - GetMilliSecs();
+        if (remaining <= 0)
+        {
+            return false;
+        }
+        PosixInterlocked::Increment(this->numWaiters);
+        PosixFutex::WaitTimeout(this->signalled, 0, int(remaining));
+        PosixInterlocked::Decrement(this->numWaiters);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    This checks if the event is signalled and returnes immediately. Like
+    a zero timeout wait on a Win32 event this resets the event.
+*/
+inline bool
+PosixEvent::Peek() const
+{
+    return (0 != this->signalled) && (1 == PosixInterlocked::CompareExchange(this->signalled, 0, 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline long long
+PosixEvent::GetMilliSecs()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef POSIX_POSIXFUTEX_H
+#define POSIX_POSIXFUTEX_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixFutex
+
+    Parks and wakes threads on the address of an int, the building block of
+    PosixCriticalSection and PosixEvent. Wait() only blocks if the variable
+    still contains the expected value when the kernel looks at it, so a
+    Wake() between checking the variable and calling Wait() isn't lost.
+    On Linux this is the futex system call. On other Posix platforms
+    Wait() just yields the time slice and callers poll the variable again,
+    which is correct but slower.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#if __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixFutex
+{
+public:
+    /// block while var contains value, returns on Wake(), timeout or spuriously
+    static void Wait(int volatile& var, int value);
+    /// like Wait() with timeout in millisecs
+    static void WaitTimeout(int volatile& var, int value, int ms);
+    /// wake up to num threads blocked on var
+    static void Wake(int volatile& var, int num);
+    /// get the number of online cpu cores, spinning is pointless with only one
+    static int GetNumCores();
+    /// hint to the cpu that the caller is busy waiting
+    static void Pause();
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixFutex::Wait(int volatile& var, int value)
+{
+    #if __linux__
+    syscall(SYS_futex, (int*)&var, FUTEX_WAIT_PRIVATE, value, 0, 0, 0);
+    #else
+    if (var == value)
+    {
+        sched_yield();
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixFutex::WaitTimeout(int volatile& var, int value, int ms)
+{
+    #if __linux__
+    timespec timeout;
+    timeout.tv_sec = ms / 1000;
+    timeout.tv_nsec = (ms % 1000) * 1000000;
+    syscall(SYS_futex, (int*)&var, FUTEX_WAIT_PRIVATE, value, &timeout, 0, 0);
+    #else
+    if (var == value)
+    {
+        usleep(ms < 1 ? 0 : 1000);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixFutex::Wake(int volatile& var, int num)
+{
+    #if __linux__
+    syscall(SYS_futex, (int*)&var, FUTEX_WAKE_PRIVATE, num, 0, 0, 0);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PosixFutex::GetNumCores()
+{
+    static int numCores = 0;
+    if (0 == numCores)
+    {
+        long num = sysconf(_SC_NPROCESSORS_ONLN);
+        numCores = (num > 0) ? int(num) : 1;
+    }
+    return numCores;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixFutex::Pause()
+{
+    #if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("pause" ::: "memory");
+    #else
+    __asm__ __volatile__("" ::: "memory");
+    #endif
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
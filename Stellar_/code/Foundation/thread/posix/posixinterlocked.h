@@ -0,0 +1,93 @@
+#pragma once
+#ifndef POSIX_POSIXINTERLOCKED_H
+#define POSIX_POSIXINTERLOCKED_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixInterlocked
+    
+    Provides simple atomic operations on shared variables. Implemented
+    with the GCC atomic builtins, all operations are full barriers like
+    their Win32 counterparts.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+class PosixInterlocked
+{
+public:
+    /// interlocked increment, returns the new value
+    static int Increment(int volatile& var);
+    /// interlocked decrement, returns the new value
+    static int Decrement(int volatile& var);
+    /// interlocked add
+    static void Add(int volatile& var, int add);
+    /// interlocked exchange, returns the previous value
+    static int Exchange(int volatile& var, int value);
+    /// interlocked compare-exchange, returns the previous value
+    static int CompareExchange(int volatile& var, int exchange, int comparand);
+    /// interlocked pointer exchange, returns the previous pointer
+    static void* ExchangePointer(void* volatile& var, void* value);
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PosixInterlocked::Increment(int volatile& var)
+{
+    return __atomic_add_fetch(&var, 1, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PosixInterlocked::Decrement(int volatile& var)
+{
+    return __atomic_sub_fetch(&var, 1, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixInterlocked::Add(int volatile& var, int add)
+{
+    __atomic_add_fetch(&var, add, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PosixInterlocked::Exchange(int volatile& var, int value)
+{
+    return __atomic_exchange_n(&var, value, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+PosixInterlocked::CompareExchange(int volatile& var, int exchange, int comparand)
+{
+    __atomic_compare_exchange_n(&var, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return comparand;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+PosixInterlocked::ExchangePointer(void* volatile& var, void* value)
+{
+    return __atomic_exchange_n(&var, value, __ATOMIC_SEQ_CST);
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//  posixthread.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "thread/posix/posixthread.h"
+#include "memory/objectpool.h"
+#include <limits.h>
+#include <sys/resource.h>
+#if __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace Posix
+{
+ImplementClass(Posix::PosixThread, 'PTHR', Core::RefCounted);
+
+__thread const char* PosixThread::ThreadName = 0;
+
+//------------------------------------------------------------------------------
+/**
+*/
+PosixThread::PosixThread() :
+    running(false),
+    priority(Normal),
+    stackSize(4096),
+    coreId(Cpu::UndefinedCoreId)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+PosixThread::~PosixThread()
+{
+    if (this->IsRunning())
+    {
+        this->Stop();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Start the thread, this creates a pthread and calls the static
+    ThreadProc, which in turn calls the virtual DoWork() class of this object.
+    The method returns immediately without waiting for the thread to start.
+
+    The stack size is only a lower bound, like on Win32 the thread gets at
+    least the default stack of the platform. The affinity is set before
+    the thread is created, so it never runs on another core. Core ids
+    beyond the number of cores in the machine are ignored.
+*/
+void
+PosixThread::Start()
+{
+    s_assert(!this->IsRunning());
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    size_t defaultStackSize = 0;
+    pthread_attr_getstacksize(&attr, &defaultStackSize);
+    if ((this->stackSize > defaultStackSize) && (this->stackSize >= PTHREAD_STACK_MIN))
+    {
+        pthread_attr_setstacksize(&attr, this->stackSize);
+    }
+    #if __linux__
+    if ((this->coreId < Cpu::MaxNumCores) && (int(this->coreId) < PosixFutex::GetNumCores()))
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(int(this->coreId), &cpuSet);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+    }
+    #endif
+
+    int res = pthread_create(&this->thread, &attr, ThreadProc, (void*) this);
+    pthread_attr_destroy(&attr);
+    if (0 != res)
+    {
+        s_error("PosixThread::Start(): pthread_create() failed with '%s'!\n", strerror(res));
+    }
+    this->running = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    This method is called by Thread::Stop() after setting the 
+    stopRequest event and before waiting for the thread to stop. If your
+    thread runs a loop and waits for jobs it may need an extra wakeup
+    signal to stop waiting and check for the ThreadStopRequested() event. In
+    this case, override this method and signal your event object.
+*/
+void
+PosixThread::EmitWakeupSignal()
+{
+    // empty, override in subclass!
+}
+
+//------------------------------------------------------------------------------
+/**
+    This stops the thread by signalling the stopRequestEvent and waits for the
+    thread to actually quit. If the thread code runs in a loop it should use the 
+    IsStopRequested() method to see if the thread object wants it to shutdown. 
+    If so DoWork() should simply return.
+*/
+void
+PosixThread::Stop()
+{
+    s_assert(this->IsRunning());
+
+    // signal the thread to stop
+    this->stopRequestEvent.Signal();
+
+    // call the wakeup-thread method, may be derived in a subclass
+    // if the threads needs to be woken up, it is important that this
+    // method is called AFTER the stopRequestEvent is signalled!
+    this->EmitWakeupSignal();
+
+    // wait for the thread to terminate
+    pthread_join(this->thread, 0);
+    this->running = false;
+}
+
+//------------------------------------------------------------------------------
+/**
+    This method should be derived in a Thread subclass and contains the
+    actual code which is run in the thread. To terminate the thread, just 
+    return from this function. If DoWork() runs in an infinite loop, call
+    ThreadStopRequested() to check whether the Thread object wants the 
+    thread code to quit.
+*/
+void
+PosixThread::DoWork()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+    Called from within the new thread. Under Linux the nice value is a
+    per thread attribute, which is what the normal scheduling policy
+    looks at. Raising the priority usually needs privileges, if that fails
+    the thread just keeps the normal priority. Thread names are limited
+    to 15 characters by the system.
+*/
+void
+PosixThread::ApplyThreadSettings()
+{
+    #if __linux__
+    int niceValue = 0;
+    switch (this->priority)
+    {
+        case Low:
+            niceValue = 5;
+            break;
+
+        case Normal:
+            niceValue = 0;
+            break;
+
+        case High:
+            niceValue = -5;
+            break;
+    }
+    if (0 != niceValue)
+    {
+        setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), niceValue);
+    }
+    #endif
+
+    if (!this->name.empty())
+    {
+        char shortName[16];
+        strncpy(shortName, this->name.c_str(), sizeof(shortName) - 1);
+        shortName[sizeof(shortName) - 1] = 0;
+        #if __APPLE__
+        pthread_setname_np(shortName);
+        #else
+        pthread_setname_np(pthread_self(), shortName);
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Internal static helper method. This is called by pthread_create() and
+    simply calls the virtual DoWork() method on the thread object.
+*/
+void*
+PosixThread::ThreadProc(void* self)
+{
+    s_assert(0 != self);
+    PosixThread* threadObj = (PosixThread*) self;
+    ThreadName = threadObj->GetName().c_str();
+    threadObj->ApplyThreadSettings();
+    threadObj->DoWork();
+    Memory::ObjectPool::ReleaseThreadCaches();
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Static method to obtain the current thread name from anywhere
+    in the thread's code.
+*/
+const char*
+PosixThread::GetMyThreadName()
+{
+    return ThreadName;
+}
+
+} // namespace Posix
@@ -0,0 +1,210 @@
+#pragma once
+#ifndef POSIX_POSIXTHREAD_H
+#define POSIX_POSIXTHREAD_H
+//------------------------------------------------------------------------------
+/**
+    @class Posix::PosixThread
+    
+    Posix implementation of thread class on top of pthreads. The core id
+    becomes the thread's cpu affinity and the name is passed on to the
+    system, so it shows up in debuggers and profilers.
+    
+    (C) 2007 by Ctuo
+*/
+#include "core/refcounted.h"
+#include "thread/posix/posixevent.h"
+
+//------------------------------------------------------------------------------
+namespace Posix
+{
+
+class Cpu
+{
+public:
+    /// core id's
+    enum CoreId
+    {
+        Core0 = 0,
+        Core1,
+        Core2,
+        Core3,
+        Core4,
+        Core5,
+        Core6,
+        Core7,
+        Core8,
+        
+        MaxNumCores,
+        UndefinedCoreId,
+    };
+};
+
+class PosixThread : public Core::RefCounted
+{
+    DeclareClass(PosixThread);
+public:
+    /// thread priorities
+    enum Priority
+    {
+        Low,
+        Normal,
+        High,
+    };
+    /// constructor
+    PosixThread();
+    /// destructor
+    virtual ~PosixThread();
+    /// set the thread priority
+    void SetPriority(Priority p);
+    /// get the thread priority
+    Priority GetPriority() const;
+    /// set cpu core on which the thread should be running
+    void SetCoreId(Cpu::CoreId coreId);
+    /// get the cpu core on which the thread should be running
+    Cpu::CoreId GetCoreId() const;
+    /// set stack size in bytes (default is 4 KByte)
+    void SetStackSize(unsigned int s);
+    /// get stack size
+    unsigned int GetStackSize() const;
+    /// set thread name
+    void SetName(const Util::String& n);
+    /// get thread name
+    const Util::String& GetName() const;
+    /// start executing the thread code, returns when thread has actually started
+    void Start();
+    /// request threading code to stop, returns when thread has actually finished
+    void Stop();
+    /// return true if thread has been started
+    bool IsRunning() const;
+    /// obtain name of thread from within thread code
+    static const char* GetMyThreadName();
+
+protected:
+    /// override this method if your thread loop needs a wakeup call before stopping
+    virtual void EmitWakeupSignal();
+    /// this method runs in the thread context
+    virtual void DoWork();
+    /// check if stop is requested, call from DoWork() to see if the thread proc should quit
+    bool ThreadStopRequested() const;
+
+private:
+    /// internal thread proc helper function
+    static void* ThreadProc(void* self);
+    /// apply priority and name to the calling thread
+    void ApplyThreadSettings();
+
+    pthread_t thread;
+    PosixEvent stopRequestEvent;
+    bool running;
+    Priority priority;
+    unsigned int stackSize;
+    Util::String name;
+    Cpu::CoreId coreId;
+    static __thread const char* ThreadName;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+PosixThread::IsRunning() const
+{
+    return this->running;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixThread::SetPriority(Priority p)
+{
+    this->priority = p;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline PosixThread::Priority
+PosixThread::GetPriority() const
+{
+    return this->priority;
+}
+
+//------------------------------------------------------------------------------
+/**
+    If the derived DoWork() method is running in a loop it must regularly
+    check if the process wants the thread to terminate by calling
+    ThreadStopRequested() and simply return if the result is true. This
+    will cause the thread to shut down.
+*/
+inline bool
+PosixThread::ThreadStopRequested() const
+{
+    return this->stopRequestEvent.Peek();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Set the thread's name. To obtain the current thread's name from anywhere
+    in the thread's execution context, call the static method
+    Thread::GetMyThreadName().
+*/
+inline void
+PosixThread::SetName(const Util::String& n)
+{
+    s_assert(!n.empty());
+    this->name = n;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the thread's name. This is the vanilla method which
+    returns the name member. To obtain the current thread's name from anywhere
+    in the thread's execution context, call the static method
+    Thread::GetMyThreadName().
+*/
+inline const Util::String&
+PosixThread::GetName() const
+{
+    return this->name;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixThread::SetCoreId(Cpu::CoreId id)
+{
+    this->coreId = id;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline Cpu::CoreId
+PosixThread::GetCoreId() const
+{
+    return this->coreId;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+PosixThread::SetStackSize(unsigned int s)
+{
+    this->stackSize = s;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline unsigned int
+PosixThread::GetStackSize() const
+{
+    return this->stackSize;
+}
+
+} // namespace Posix
+//------------------------------------------------------------------------------
+#endif
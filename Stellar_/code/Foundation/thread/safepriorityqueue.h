@@ -8,17 +8,23 @@
     A thread-safe priority-sorted queue which protects itself with critical 
     sections. Offers a method to wait for new elements to be added. Useful 
     for inter-thread communications.
+
+    Insert() keeps the elements sorted, which is O(n). For queues with a
+    fixed number of priority levels, Threading::BucketPriorityQueue is
+    lock-free and O(1).
     
     (C) 2006 Radon Labs GmbH
 */
-#include "utility/queue.h"
+#include "core/types.h"
 #include "thread/criticalsection.h"
 #include "thread/event.h"
+#include <vector>
+#include <algorithm>
     
 //------------------------------------------------------------------------------
 namespace Threading
 {
-template<class PRITYPE, class TYPE> class SafePriorityQueue : protected std::queue<PRITYPE, TYPE>
+template<class PRITYPE, class TYPE> class SafePriorityQueue
 {
 public:
     /// constructor
@@ -51,10 +57,24 @@ public:
     void Signal();
 
 protected:
-    CriticalSection criticalSection;
+    typedef std::pair<PRITYPE, TYPE> Element;
+    /// compare the priorities of two elements
+    static bool LessPriority(const Element& a, const Element& b);
+
+    mutable CriticalSection criticalSection;
     Event enqueueEvent;
+    std::vector<Element> queueArray;
 };
 
+//------------------------------------------------------------------------------
+/**
+*/
+template<class PRITYPE, class TYPE> bool
+SafePriorityQueue<PRITYPE,TYPE>::LessPriority(const Element& a, const Element& b)
+{
+    return a.first < b.first;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -93,7 +113,7 @@ template<class PRITYPE, class TYPE> void
 SafePriorityQueue<PRITYPE,TYPE>::Clear()
 {
     this->criticalSection.Enter();
-    this->queueArray.Clear();
+    this->queueArray.clear();
     this->criticalSection.Leave();
 }
 
@@ -103,7 +123,7 @@ SafePriorityQueue<PRITYPE,TYPE>::Clear()
 template<class PRITYPE, class TYPE> SizeT
 SafePriorityQueue<PRITYPE,TYPE>::Size() const
 {
-    return this->queueArray.Size();
+    return (SizeT)this->queueArray.size();
 }
 
 //------------------------------------------------------------------------------
@@ -112,7 +132,28 @@ SafePriorityQueue<PRITYPE,TYPE>::Size() const
 template<class PRITYPE, class TYPE> bool
 SafePriorityQueue<PRITYPE,TYPE>::IsEmpty() const
 {
-    return this->queueArray.IsEmpty();
+    return this->queueArray.empty();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class PRITYPE, class TYPE> bool
+SafePriorityQueue<PRITYPE,TYPE>::Contains(const TYPE& e) const
+{
+    this->criticalSection.Enter();
+    bool result = false;
+    typename std::vector<Element>::const_iterator iter;
+    for (iter = this->queueArray.begin(); iter != this->queueArray.end(); iter++)
+    {
+        if ((*iter).second == e)
+        {
+            result = true;
+            break;
+        }
+    }
+    this->criticalSection.Leave();
+    return result;
 }
 
 //------------------------------------------------------------------------------
@@ -121,9 +162,9 @@ SafePriorityQueue<PRITYPE,TYPE>::IsEmpty() const
 template<class PRITYPE, class TYPE> void
 SafePriorityQueue<PRITYPE,TYPE>::Insert(PRITYPE pri, const TYPE& e)
 {
-    Util::KeyValuePair<PRITYPE, TYPE> kvp(pri, e);
+    Element elm(pri, e);
     this->criticalSection.Enter();
-    this->queueArray.InsertSorted(kvp);
+    this->queueArray.insert(std::upper_bound(this->queueArray.begin(), this->queueArray.end(), elm, LessPriority), elm);
     this->criticalSection.Leave();
     this->enqueueEvent.Signal();
 }
@@ -135,12 +176,12 @@ template<class PRITYPE, class TYPE> void
 SafePriorityQueue<PRITYPE,TYPE>::EraseMatchingElements(const TYPE& e)
 {
     this->criticalSection.Enter();
-    Array<Util::KeyValuePair<PRITYPE,TYPE>>::Iterator iter; 
-    for (iter = this->queueArray.Begin(); iter != this->queueArray.End();)
+    typename std::vector<Element>::iterator iter; 
+    for (iter = this->queueArray.begin(); iter != this->queueArray.end();)
     {
-        if ((*iter).Value() == e)
+        if ((*iter).second == e)
         {
-            iter = this->queueArray.Erase(iter);
+            iter = this->queueArray.erase(iter);
         }
         else
         {
@@ -157,8 +198,8 @@ template<class PRITYPE, class TYPE> TYPE
 SafePriorityQueue<PRITYPE,TYPE>::Dequeue()
 {
     this->criticalSection.Enter();
-    TYPE value = this->queueArray.Front().Value();
-    this->queueArray.EraseIndex(0);
+    TYPE value = this->queueArray.front().second;
+    this->queueArray.erase(this->queueArray.begin());
     this->criticalSection.Leave();
     return value;
 }
@@ -170,7 +211,7 @@ template<class PRITYPE, class TYPE> TYPE
 SafePriorityQueue<PRITYPE,TYPE>::Peek() const
 {
     this->criticalSection.Enter();
-    TYPE value = this->queueArray.Front().Value();
+    TYPE value = this->queueArray.front().second;
     this->criticalSection.Leave();
     return value;
 }
@@ -181,7 +222,7 @@ SafePriorityQueue<PRITYPE,TYPE>::Peek() const
 template<class PRITYPE, class TYPE> void
 SafePriorityQueue<PRITYPE,TYPE>::Wait()
 {
-    if (this->queueArray.Size() == 0)
+    if (this->queueArray.empty())
     {
         this->enqueueEvent.Wait();
     }
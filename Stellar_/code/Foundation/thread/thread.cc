@@ -9,6 +9,8 @@ namespace Threading
 {
 #if __WIN32__
 ImplementClass(Threading::Thread, 'TRED', Win32::Win32Thread);
+#elif __POSIX__
+ImplementClass(Threading::Thread, 'TRED', Posix::PosixThread);
 #else
 #error "Thread class not implemented on this platform!"
 #endif
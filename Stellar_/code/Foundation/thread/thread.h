@@ -19,6 +19,15 @@ class Thread : public Win32::Win32Thread
     DeclareClass(Thread);
 };
 }
+#elif __POSIX__
+#include "thread/posix/posixthread.h"
+namespace Threading
+{
+class Thread : public Posix::PosixThread
+{ 
+    DeclareClass(Thread);
+};
+}
 #else
 #error "Threading::Thread not implemented on this platform!"
 #endif
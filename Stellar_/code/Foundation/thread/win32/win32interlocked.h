@@ -0,0 +1,91 @@
+#pragma once
+#ifndef WIN32_WIN32INTERLOCKED_H
+#define WIN32_WIN32INTERLOCKED_H
+//------------------------------------------------------------------------------
+/**
+    @class Win32::Win32Interlocked
+    
+    Provides simple atomic operations on shared variables.
+    
+    (C) 2006 Radon Labs GmbH
+*/
+#include "stdneb.h"
+#include "core/types.h"
+
+//------------------------------------------------------------------------------
+namespace Win32
+{
+class Win32Interlocked
+{
+public:
+    /// interlocked increment, returns the new value
+    static int Increment(int volatile& var);
+    /// interlocked decrement, returns the new value
+    static int Decrement(int volatile& var);
+    /// interlocked add
+    static void Add(int volatile& var, int add);
+    /// interlocked exchange, returns the previous value
+    static int Exchange(int volatile& var, int value);
+    /// interlocked compare-exchange, returns the previous value
+    static int CompareExchange(int volatile& var, int exchange, int comparand);
+    /// interlocked pointer exchange, returns the previous pointer
+    static void* ExchangePointer(void* volatile& var, void* value);
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+Win32Interlocked::Increment(int volatile& var)
+{
+    return InterlockedIncrement((volatile LONG*)&var);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+Win32Interlocked::Decrement(int volatile& var)
+{
+    return InterlockedDecrement((volatile LONG*)&var);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+Win32Interlocked::Add(int volatile& var, int add)
+{
+    InterlockedExchangeAdd((volatile LONG*)&var, add);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+Win32Interlocked::Exchange(int volatile& var, int value)
+{
+    return InterlockedExchange((volatile LONG*)&var, value);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline int
+Win32Interlocked::CompareExchange(int volatile& var, int exchange, int comparand)
+{
+    return InterlockedCompareExchange((volatile LONG*)&var, exchange, comparand);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void*
+Win32Interlocked::ExchangePointer(void* volatile& var, void* value)
+{
+    return InterlockedExchangePointer(&var, value);
+}
+
+} // namespace Win32
+//------------------------------------------------------------------------------
+#endif
\ No newline at end of file
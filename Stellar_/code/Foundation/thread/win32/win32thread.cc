@@ -4,6 +4,7 @@
 //------------------------------------------------------------------------------
 #include "stdneb.h"
 #include "thread/win32/win32thread.h"
+#include "memory/objectpool.h"
 
 namespace Win32
 {
@@ -138,6 +139,7 @@ Win32Thread::ThreadProc(LPVOID self)
     Win32Thread* threadObj = (Win32Thread*) self;
     ThreadName = threadObj->GetName().c_str();
     threadObj->DoWork();
+    Memory::ObjectPool::ReleaseThreadCaches();
     return 0;
 }
 
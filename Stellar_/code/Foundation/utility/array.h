@@ -41,6 +41,10 @@ namespace Util
 template<class TYPE> class Array : public std::vector<TYPE>
 {
 public:
+	/// iterator types of the underlying vector
+	typedef typename std::vector<TYPE>::iterator iterator;
+	typedef typename std::vector<TYPE>::const_iterator const_iterator;
+
 	/// find element
 	const_iterator Find(const TYPE& elm)const;
 	/// find element read/only
@@ -0,0 +1,691 @@
+#pragma once
+#ifndef UTIL_ATOM_H
+#define UTIL_ATOM_H
+//------------------------------------------------------------------------------
+/**
+    @class Util::Atom
+
+    An Atom is a compact, shared reference of a constant object. A unique
+    object is guaranteed to exist only once, no matter how many Atoms are
+    pointing to it. Copying Atoms and comparing against Atoms is very fast,
+    since these are actually pointer operations.
+
+    Note that comparing 2 Atoms against each other will yield a different
+    result then comparing the contents of the same Atoms. This is because
+    comparing 2 Atoms actually compares the addresses of the content without
+    actually invoking the compare operators of the content. So, comparing
+    2 Atom<String>'s will never do a strcmp(), instead the string pointers
+    are compared against each other.
+
+    Atoms are consistent across threads. The atom table is split into
+    shards by the hash of the content, each shard is an open addressing
+    table of pointers to the interned objects. Looking up an existing
+    object doesn't take any lock, only adding a new object locks the
+    shard it goes to. Interned objects never move in memory, tables which
+    have been replaced by a larger one are kept alive until no lookup
+    can see them anymore. Each shard counts the lookups running on it in
+    a cache line of its own, so lookups in different shards never touch
+    the same memory.
+
+    The Atom table will *not* be garbage collected automatically, this
+    means, entries for which no more Atoms exist will not be removed
+    automatically. This is to prevent excessive allocations/deallocations
+    for some usage scenarios. Instead, if you want to remove orphaned
+    entries, call the PerformGarbageCollection() method manually.
+
+    (C) 2007 Radon Labs GmbH
+*/
+#include "core/types.h"
+#include "utility/array.h"
+#include "utility/flathashmap.h"
+#include "thread/criticalsection.h"
+#include "thread/interlocked.h"
+#include "time/time.h"
+
+//------------------------------------------------------------------------------
+namespace Util
+{
+template<class TYPE> class Atom
+{
+public:
+    /// default constructor
+    Atom();
+    /// construct from type
+    Atom(const TYPE& rhs);
+    /// copy constructor
+    Atom(const Atom<TYPE>& rhs);
+    /// destructor
+    ~Atom();
+
+    /// assignment from type
+    void operator=(const TYPE& rhs);
+    /// assignment from other atom
+    void operator=(const Atom<TYPE>& rhs);
+
+    /// equality operator with atom content
+    bool operator==(const TYPE& rhs) const;
+    /// inequality operator with atom content
+    bool operator!=(const TYPE& rhs) const;
+    /// greater-then operator with atom content
+    bool operator>(const TYPE& rhs) const;
+    /// less-then operator with atom content
+    bool operator<(const TYPE& rhs) const;
+    /// greater-or-equal operator with atom content
+    bool operator>=(const TYPE& rhs) const;
+    /// less-or-equal operator with atom content
+    bool operator<=(const TYPE& rhs) const;
+
+    /// equality operator between atoms
+    bool operator==(const Atom<TYPE>& rhs) const;
+    /// inequality operator between atoms
+    bool operator!=(const Atom<TYPE>& rhs) const;
+    /// greater-then operator between atoms
+    bool operator>(const Atom<TYPE>& rhs) const;
+    /// less-then operator between atoms
+    bool operator<(const Atom<TYPE>& rhs) const;
+    /// greater-or-equal operator between atoms
+    bool operator>=(const Atom<TYPE>& rhs) const;
+    /// less-or-equal operator between atoms
+    bool operator<=(const Atom<TYPE>& rhs) const;
+
+    /// clear content
+    void Clear();
+    /// return true if the Atom is valid
+    bool IsValid() const;
+    /// access to referenced object
+    const TYPE& Value() const;
+
+    /// perform garbage collection on atom table
+    static void PerformGarbageCollection();
+    /// get current atom table size (for debugging)
+    static SizeT GetAtomTableSize();
+
+private:
+    enum
+    {
+        NumShards = 16,
+        ShardShift = 28,
+        MinTableCapacity = 16,
+    };
+
+    /// an interned object, refCount is -1 once it has been collected
+    struct Entry
+    {
+        /// constructor
+        Entry(const TYPE& o, unsigned int h) : obj(o), hash(h), refCount(1), nextRetired(0) {}
+
+        TYPE obj;
+        unsigned int hash;
+        int volatile refCount;
+        Entry* nextRetired;
+    };
+
+    /// an open addressing table of entries, at most half full
+    struct Table
+    {
+        SizeT capacity;
+        SizeT size;
+        Table* nextRetired;
+        Entry* volatile slots[1];
+    };
+
+    /// keeps the shards in different cache lines
+    struct Padding
+    {
+        char bytes[64];
+    };
+
+    /// a part of the atom table, with the number of lookups running in each epoch
+    struct Shard
+    {
+        Padding pad;
+        Threading::CriticalSection critSect;
+        Table* volatile table;
+        int volatile numReaders[2];
+    };
+
+    /// find or add an entry for an object, returns the entry with a reference added
+    static Entry* Intern(const TYPE& obj);
+    /// find an entry in a table
+    static Entry* Find(const Table* table, const TYPE& obj, unsigned int hash);
+    /// add a reference to an entry, fails if the entry has been collected
+    static bool TryAddRef(Entry* entry);
+    /// release a reference to an entry
+    static void Release(Entry* entry);
+    /// create a new table with room for a number of entries, copies the entries of another table
+    static Table* CreateTable(SizeT numEntries, const Table* src);
+    /// add an entry to a table which has room for it
+    static void AddToTable(Table* table, Entry* entry);
+    /// publish a new table for a shard and retire the old one
+    static void ReplaceTable(Shard& shard, Table* table);
+    /// announce a lock-free lookup in a shard, returns the epoch to pass to EndRead()
+    static int BeginRead(Shard& shard);
+    /// end a lock-free lookup in a shard
+    static void EndRead(Shard& shard, int readEpoch);
+
+    static Shard shards[NumShards];
+    static Threading::CriticalSection gcCritSect;
+    static Threading::CriticalSection retireCritSect;
+    static Entry* retiredEntries;
+    static Table* retiredTables;
+    static int volatile epoch;
+
+    Entry* entry;
+};
+
+template<class TYPE> typename Atom<TYPE>::Shard Atom<TYPE>::shards[Atom<TYPE>::NumShards];
+template<class TYPE> Threading::CriticalSection Atom<TYPE>::gcCritSect;
+template<class TYPE> Threading::CriticalSection Atom<TYPE>::retireCritSect;
+template<class TYPE> typename Atom<TYPE>::Entry* Atom<TYPE>::retiredEntries = 0;
+template<class TYPE> typename Atom<TYPE>::Table* Atom<TYPE>::retiredTables = 0;
+template<class TYPE> int volatile Atom<TYPE>::epoch = 0;
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+Atom<TYPE>::Atom() :
+    entry(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+Atom<TYPE>::Atom(const TYPE& rhs) :
+    entry(Intern(rhs))
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+Atom<TYPE>::Atom(const Atom<TYPE>& rhs) :
+    entry(rhs.entry)
+{
+    // copy from existing atom, the entry can't be collected while rhs holds it
+    if (0 != this->entry)
+    {
+        Threading::Interlocked::Increment(this->entry->refCount);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+Atom<TYPE>::~Atom()
+{
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+Atom<TYPE>::operator=(const TYPE& rhs)
+{
+    Entry* newEntry = Intern(rhs);
+    this->Clear();
+    this->entry = newEntry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+Atom<TYPE>::operator=(const Atom<TYPE>& rhs)
+{
+    if (this->entry != rhs.entry)
+    {
+        this->Clear();
+        this->entry = rhs.entry;
+        if (0 != this->entry)
+        {
+            Threading::Interlocked::Increment(this->entry->refCount);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator==(const TYPE& rhs) const
+{
+    return this->Value() == rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator!=(const TYPE& rhs) const
+{
+    return this->Value() != rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator>(const TYPE& rhs) const
+{
+    return this->Value() > rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator<(const TYPE& rhs) const
+{
+    return this->Value() < rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator>=(const TYPE& rhs) const
+{
+    return this->Value() >= rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator<=(const TYPE& rhs) const
+{
+    return this->Value() <= rhs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator==(const Atom<TYPE>& rhs) const
+{
+    return this->entry == rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator!=(const Atom<TYPE>& rhs) const
+{
+    return this->entry != rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator>(const Atom<TYPE>& rhs) const
+{
+    return this->entry > rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator<(const Atom<TYPE>& rhs) const
+{
+    return this->entry < rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator>=(const Atom<TYPE>& rhs) const
+{
+    return this->entry >= rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::operator<=(const Atom<TYPE>& rhs) const
+{
+    return this->entry <= rhs.entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+Atom<TYPE>::Clear()
+{
+    if (0 != this->entry)
+    {
+        Release(this->entry);
+        this->entry = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::IsValid() const
+{
+    return 0 != this->entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> const TYPE&
+Atom<TYPE>::Value() const
+{
+    s_assert(0 != this->entry);
+    return this->entry->obj;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Removes all entries for which no more Atoms exist. An entry is marked
+    as collected by swapping its refcount from 0 to -1, so a concurrent
+    lookup which has already found the entry can't revive it anymore.
+    The shards are rebuilt without the collected entries, then the epoch
+    is advanced and the collected entries and old tables are freed as
+    soon as all lookups which started in the previous epoch are done.
+*/
+template<class TYPE> void
+Atom<TYPE>::PerformGarbageCollection()
+{
+    gcCritSect.Enter();
+    IndexT shardIndex;
+    for (shardIndex = 0; shardIndex < NumShards; shardIndex++)
+    {
+        Shard& shard = shards[shardIndex];
+        shard.critSect.Enter();
+        Table* table = shard.table;
+        if (0 != table)
+        {
+            Table* newTable = CreateTable(table->size, 0);
+            IndexT i;
+            for (i = 0; i < table->capacity; i++)
+            {
+                Entry* entry = table->slots[i];
+                if (0 != entry)
+                {
+                    if (0 == Threading::Interlocked::CompareExchange(entry->refCount, -1, 0))
+                    {
+                        retireCritSect.Enter();
+                        entry->nextRetired = retiredEntries;
+                        retiredEntries = entry;
+                        retireCritSect.Leave();
+                    }
+                    else
+                    {
+                        AddToTable(newTable, entry);
+                    }
+                }
+            }
+            ReplaceTable(shard, newTable);
+        }
+        shard.critSect.Leave();
+    }
+
+    // take everything retired so far, anything retired later waits for the next collection
+    retireCritSect.Enter();
+    Entry* entries = retiredEntries;
+    Table* tables = retiredTables;
+    retiredEntries = 0;
+    retiredTables = 0;
+    retireCritSect.Leave();
+
+    // advance the epoch and wait for the lookups of the previous epoch
+    int prevEpoch = epoch;
+    Threading::Interlocked::Increment(epoch);
+    for (shardIndex = 0; shardIndex < NumShards; shardIndex++)
+    {
+        while (0 != shards[shardIndex].numReaders[prevEpoch & 1])
+        {
+            Timing::Sleep(0.0);
+        }
+    }
+
+    while (0 != entries)
+    {
+        Entry* next = entries->nextRetired;
+        delete entries;
+        entries = next;
+    }
+    while (0 != tables)
+    {
+        Table* next = tables->nextRetired;
+        Memory::Free(tables);
+        tables = next;
+    }
+    gcCritSect.Leave();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> SizeT
+Atom<TYPE>::GetAtomTableSize()
+{
+    SizeT size = 0;
+    IndexT shardIndex;
+    for (shardIndex = 0; shardIndex < NumShards; shardIndex++)
+    {
+        Shard& shard = shards[shardIndex];
+        shard.critSect.Enter();
+        if (0 != shard.table)
+        {
+            size += shard.table->size;
+        }
+        shard.critSect.Leave();
+    }
+    return size;
+}
+
+//------------------------------------------------------------------------------
+/**
+    First looks the object up without taking a lock. If it isn't found
+    the shard is locked and the lookup is repeated, since another thread
+    may have added the object in the meantime, before a new entry is
+    added.
+*/
+template<class TYPE> typename Atom<TYPE>::Entry*
+Atom<TYPE>::Intern(const TYPE& obj)
+{
+    unsigned int hash = Hash<TYPE>()(obj);
+    Shard& shard = shards[hash >> ShardShift];
+
+    int readEpoch = BeginRead(shard);
+    Entry* entry = Find(shard.table, obj, hash);
+    bool found = (0 != entry) && TryAddRef(entry);
+    EndRead(shard, readEpoch);
+    if (found)
+    {
+        return entry;
+    }
+
+    shard.critSect.Enter();
+    Table* table = shard.table;
+    entry = Find(table, obj, hash);
+    if ((0 == entry) || !TryAddRef(entry))
+    {
+        // grow the table if it would become more than half full
+        if ((0 == table) || ((table->size + 1) * 2 > table->capacity))
+        {
+            table = CreateTable((0 != table) ? table->size + 1 : 1, table);
+            ReplaceTable(shard, table);
+        }
+        entry = new Entry(obj, hash);
+        AddToTable(table, entry);
+    }
+    shard.critSect.Leave();
+    return entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Compares the precomputed hashes first, so the content is only compared
+    for the entry which most likely is the one searched.
+*/
+template<class TYPE> typename Atom<TYPE>::Entry*
+Atom<TYPE>::Find(const Table* table, const TYPE& obj, unsigned int hash)
+{
+    if (0 != table)
+    {
+        SizeT mask = table->capacity - 1;
+        IndexT i = hash & mask;
+        Entry* entry;
+        while (0 != (entry = table->slots[i]))
+        {
+            if ((entry->hash == hash) && (entry->obj == obj))
+            {
+                return entry;
+            }
+            i = (i + 1) & mask;
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> bool
+Atom<TYPE>::TryAddRef(Entry* entry)
+{
+    int refCount;
+    while ((refCount = entry->refCount) >= 0)
+    {
+        if (refCount == Threading::Interlocked::CompareExchange(entry->refCount, refCount + 1, refCount))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Entries are not freed when the last Atom goes away, this is done
+    by PerformGarbageCollection().
+*/
+template<class TYPE> void
+Atom<TYPE>::Release(Entry* entry)
+{
+    s_assert(entry->refCount > 0);
+    Threading::Interlocked::Decrement(entry->refCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> typename Atom<TYPE>::Table*
+Atom<TYPE>::CreateTable(SizeT numEntries, const Table* src)
+{
+    SizeT capacity = MinTableCapacity;
+    while (capacity < numEntries * 2)
+    {
+        capacity *= 2;
+    }
+    Table* table = (Table*) Memory::Alloc(sizeof(Table) + (capacity - 1) * sizeof(Entry*));
+    table->capacity = capacity;
+    table->size = 0;
+    table->nextRetired = 0;
+    IndexT i;
+    for (i = 0; i < capacity; i++)
+    {
+        table->slots[i] = 0;
+    }
+    if (0 != src)
+    {
+        for (i = 0; i < src->capacity; i++)
+        {
+            if (0 != src->slots[i])
+            {
+                AddToTable(table, src->slots[i]);
+            }
+        }
+    }
+    return table;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The entry is published with an interlocked exchange, so a concurrent
+    lookup either doesn't see it yet or sees it completely constructed.
+*/
+template<class TYPE> void
+Atom<TYPE>::AddToTable(Table* table, Entry* entry)
+{
+    s_assert((table->size + 1) * 2 <= table->capacity);
+    SizeT mask = table->capacity - 1;
+    IndexT i = entry->hash & mask;
+    while (0 != table->slots[i])
+    {
+        i = (i + 1) & mask;
+    }
+    Threading::Interlocked::ExchangePointer((void* volatile&) table->slots[i], entry);
+    table->size++;
+}
+
+//------------------------------------------------------------------------------
+/**
+    NOTE: This method depends on the shard's critical section being taken.
+*/
+template<class TYPE> void
+Atom<TYPE>::ReplaceTable(Shard& shard, Table* table)
+{
+    Table* oldTable = (Table*) Threading::Interlocked::ExchangePointer((void* volatile&) shard.table, table);
+    if (0 != oldTable)
+    {
+        retireCritSect.Enter();
+        oldTable->nextRetired = retiredTables;
+        retiredTables = oldTable;
+        retireCritSect.Leave();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Registers a lookup with the current epoch in the shard's counters. If
+    the epoch has been advanced in the meantime the registration is
+    repeated, so the garbage collector never misses a lookup it has to
+    wait for.
+*/
+template<class TYPE> int
+Atom<TYPE>::BeginRead(Shard& shard)
+{
+    for (;;)
+    {
+        int readEpoch = epoch;
+        Threading::Interlocked::Increment(shard.numReaders[readEpoch & 1]);
+        if (readEpoch == epoch)
+        {
+            return readEpoch;
+        }
+        Threading::Interlocked::Decrement(shard.numReaders[readEpoch & 1]);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+Atom<TYPE>::EndRead(Shard& shard, int readEpoch)
+{
+    Threading::Interlocked::Decrement(shard.numReaders[readEpoch & 1]);
+}
+
+} // namespace Util
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,413 @@
+#pragma once
+#ifndef UTIL_DICTIONARY_H
+#define UTIL_DICTIONARY_H
+//------------------------------------------------------------------------------
+/**
+	@class Util::Dictionary
+
+	A collection of key/value pairs with quick value retrieval
+	by key at roughly O(log n).
+
+	Internally the dictionary is implemented as a contiguous array of
+	key/value pairs sorted by key, so access by index is O(1), a key is
+	found by binary search and iterating by index is cache friendly.
+	Adding or erasing single elements moves the elements behind it.
+
+	When a lot of elements are added at once, put the Add() calls
+	between BeginBulkAdd() and EndBulkAdd(). The elements are then just
+	appended and sorted once in EndBulkAdd(). The dictionary must not
+	be searched or accessed by index while in bulk add mode.
+
+	Adding a key which already exists keeps the existing value.
+*/
+#include "core/types.h"
+#include <vector>
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+namespace Util
+{
+template<class KEYTYPE, class VALUETYPE>
+class Dictionary
+{
+public:
+	/// a key/value pair
+	typedef std::pair<KEYTYPE, VALUETYPE> KeyValuePair;
+
+	/// default constructor
+	Dictionary();
+	/// copy constructor
+	Dictionary(const Dictionary<KEYTYPE, VALUETYPE>& rhs);
+	/// assignment operator
+	void operator=(const Dictionary<KEYTYPE, VALUETYPE>& rhs);
+	/// read/write [] operator
+	VALUETYPE& operator[](const KEYTYPE& key);
+	/// read-only [] operator
+	const VALUETYPE& operator[](const KEYTYPE& key) const;
+	/// return number of key/value pairs in the dictionary
+	SizeT Size() const;
+	/// clear the dictionary
+	void Clear();
+	/// return true if empty
+	bool IsEmpty() const;
+	/// reserve space for a number of key/value pairs
+	void Reserve(SizeT numElements);
+	/// begin a bulk add, Add() only appends until EndBulkAdd()
+	void BeginBulkAdd();
+	/// add a key/value pair
+	void Add(const KeyValuePair& kvp);
+	/// add a key and associated value
+	void Add(const KEYTYPE& key, const VALUETYPE& value);
+	/// end a bulk add, sorts the added key/value pairs
+	void EndBulkAdd();
+	/// erase a key and its associated value
+	void Erase(const KEYTYPE& key);
+	/// erase a key at index
+	void EraseAtIndex(IndexT index);
+	/// find index of key/value pair (InvalidIndex if doesn't exist)
+	IndexT FindIndex(const KEYTYPE& key) const;
+	/// return true if key exists in the array
+	bool Contains(const KEYTYPE& key) const;
+	/// get a key at given index
+	const KEYTYPE& KeyAtIndex(IndexT index) const;
+	/// access to value at given index
+	VALUETYPE& ValueAtIndex(IndexT index);
+	/// get a value at given index
+	const VALUETYPE& ValueAtIndex(IndexT index) const;
+	/// get key/value pair at index
+	const KeyValuePair& KeyValuePairAtIndex(IndexT index) const;
+	/// get all keys as array (slow)
+	Array<KEYTYPE> KeysAsArray() const;
+	/// get all values as array (slow)
+	Array<VALUETYPE> ValuesAsArray() const;
+
+protected:
+	/// orders key/value pairs by key
+	static bool LessKey(const KeyValuePair& a, const KeyValuePair& b);
+	/// get index of the first key/value pair whose key is not less than key
+	IndexT LowerBound(const KEYTYPE& key) const;
+
+	std::vector<KeyValuePair> keyValuePairs;
+	bool inBulkAdd;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE>
+Dictionary<KEYTYPE, VALUETYPE>::Dictionary() :
+	inBulkAdd(false)
+{
+	// empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE>
+Dictionary<KEYTYPE, VALUETYPE>::Dictionary(const Dictionary<KEYTYPE, VALUETYPE>& rhs) :
+	keyValuePairs(rhs.keyValuePairs),
+	inBulkAdd(false)
+{
+	s_assert(!rhs.inBulkAdd);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::operator=(const Dictionary<KEYTYPE, VALUETYPE>& rhs)
+{
+	s_assert(!this->inBulkAdd && !rhs.inBulkAdd);
+	this->keyValuePairs = rhs.keyValuePairs;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::Clear()
+{
+	s_assert(!this->inBulkAdd);
+	this->keyValuePairs.clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> SizeT
+Dictionary<KEYTYPE, VALUETYPE>::Size() const
+{
+	return (SizeT)this->keyValuePairs.size();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> bool
+Dictionary<KEYTYPE, VALUETYPE>::IsEmpty() const
+{
+	return this->keyValuePairs.empty();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::Reserve(SizeT numElements)
+{
+	this->keyValuePairs.reserve(numElements);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> bool
+Dictionary<KEYTYPE, VALUETYPE>::LessKey(const KeyValuePair& a, const KeyValuePair& b)
+{
+	return a.first < b.first;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> IndexT
+Dictionary<KEYTYPE, VALUETYPE>::LowerBound(const KEYTYPE& key) const
+{
+	s_assert(!this->inBulkAdd);
+	IndexT first = 0;
+	SizeT count = (SizeT)this->keyValuePairs.size();
+	while (count > 0)
+	{
+		SizeT half = count / 2;
+		if (this->keyValuePairs[first + half].first < key)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+	return first;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::BeginBulkAdd()
+{
+	s_assert(!this->inBulkAdd);
+	this->inBulkAdd = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+	Sorts the appended key/value pairs. The sort is stable, so of several
+	pairs with the same key the one added first is kept, like Add() does
+	outside of bulk add mode.
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::EndBulkAdd()
+{
+	s_assert(this->inBulkAdd);
+	this->inBulkAdd = false;
+	std::stable_sort(this->keyValuePairs.begin(), this->keyValuePairs.end(), LessKey);
+
+	// remove duplicate keys
+	if (this->keyValuePairs.size() > 1)
+	{
+		IndexT dst = 0;
+		IndexT src;
+		for (src = 1; src < this->keyValuePairs.size(); src++)
+		{
+			if (this->keyValuePairs[dst].first < this->keyValuePairs[src].first)
+			{
+				if (++dst != src)
+				{
+					this->keyValuePairs[dst] = this->keyValuePairs[src];
+				}
+			}
+		}
+		this->keyValuePairs.erase(this->keyValuePairs.begin() + dst + 1, this->keyValuePairs.end());
+	}
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::Add(const KeyValuePair& kvp)
+{
+	if (this->inBulkAdd)
+	{
+		this->keyValuePairs.push_back(kvp);
+	}
+	else
+	{
+		IndexT index = this->LowerBound(kvp.first);
+		if ((index == this->keyValuePairs.size()) || (kvp.first < this->keyValuePairs[index].first))
+		{
+			this->keyValuePairs.insert(this->keyValuePairs.begin() + index, kvp);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::Add(const KEYTYPE& key, const VALUETYPE& value)
+{
+	this->Add(KeyValuePair(key, value));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::Erase(const KEYTYPE& key)
+{
+	IndexT index = this->FindIndex(key);
+	s_assert(InvalidIndex != index);
+	this->keyValuePairs.erase(this->keyValuePairs.begin() + index);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> void
+Dictionary<KEYTYPE, VALUETYPE>::EraseAtIndex(IndexT index)
+{
+	s_assert(!this->inBulkAdd);
+	s_assert(index < this->keyValuePairs.size());
+	this->keyValuePairs.erase(this->keyValuePairs.begin() + index);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> IndexT
+Dictionary<KEYTYPE, VALUETYPE>::FindIndex(const KEYTYPE& key) const
+{
+	IndexT index = this->LowerBound(key);
+	if ((index < this->keyValuePairs.size()) && !(key < this->keyValuePairs[index].first))
+	{
+		return index;
+	}
+	return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> bool
+Dictionary<KEYTYPE, VALUETYPE>::Contains(const KEYTYPE& key) const
+{
+	return (InvalidIndex != this->FindIndex(key));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> const KEYTYPE&
+Dictionary<KEYTYPE, VALUETYPE>::KeyAtIndex(IndexT index) const
+{
+	s_assert(!this->inBulkAdd);
+	s_assert(index < this->keyValuePairs.size());
+	return this->keyValuePairs[index].first;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> VALUETYPE&
+Dictionary<KEYTYPE, VALUETYPE>::ValueAtIndex(IndexT index)
+{
+	s_assert(!this->inBulkAdd);
+	s_assert(index < this->keyValuePairs.size());
+	return this->keyValuePairs[index].second;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> const VALUETYPE&
+Dictionary<KEYTYPE, VALUETYPE>::ValueAtIndex(IndexT index) const
+{
+	s_assert(!this->inBulkAdd);
+	s_assert(index < this->keyValuePairs.size());
+	return this->keyValuePairs[index].second;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> const typename Dictionary<KEYTYPE, VALUETYPE>::KeyValuePair&
+Dictionary<KEYTYPE, VALUETYPE>::KeyValuePairAtIndex(IndexT index) const
+{
+	s_assert(!this->inBulkAdd);
+	s_assert(index < this->keyValuePairs.size());
+	return this->keyValuePairs[index];
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> VALUETYPE&
+Dictionary<KEYTYPE, VALUETYPE>::operator[](const KEYTYPE& key)
+{
+	IndexT index = this->FindIndex(key);
+	s_assert(InvalidIndex != index);
+	return this->keyValuePairs[index].second;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> const VALUETYPE&
+Dictionary<KEYTYPE, VALUETYPE>::operator[](const KEYTYPE& key) const
+{
+	IndexT index = this->FindIndex(key);
+	s_assert(InvalidIndex != index);
+	return this->keyValuePairs[index].second;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> Array<VALUETYPE>
+Dictionary<KEYTYPE, VALUETYPE>::ValuesAsArray() const
+{
+	s_assert(!this->inBulkAdd);
+	Array<VALUETYPE> result;
+	result.reserve(this->keyValuePairs.size());
+	IndexT i;
+	for (i = 0; i < this->keyValuePairs.size(); i++)
+	{
+		result.Append(this->keyValuePairs[i].second);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEYTYPE, class VALUETYPE> Array<KEYTYPE>
+Dictionary<KEYTYPE, VALUETYPE>::KeysAsArray() const
+{
+	s_assert(!this->inBulkAdd);
+	Array<KEYTYPE> result;
+	result.reserve(this->keyValuePairs.size());
+	IndexT i;
+	for (i = 0; i < this->keyValuePairs.size(); i++)
+	{
+		result.Append(this->keyValuePairs[i].first);
+	}
+	return result;
+}
+
+}
+#endif
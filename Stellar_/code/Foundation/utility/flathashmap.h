@@ -0,0 +1,746 @@
+#pragma once
+#ifndef UTIL_FLATHASHMAP_H
+#define UTIL_FLATHASHMAP_H
+//------------------------------------------------------------------------------
+/**
+    @class Util::FlatHashMap
+
+    A hash map with open addressing which keeps all its data in a few
+    flat arrays. Entries are stored in insertion order in one array, the
+    table itself only holds one control byte and one entry index per slot.
+
+    The control byte of a used slot holds 7 bits of the key's hash, so a
+    lookup compares the control bytes of a whole group of slots at once
+    (16 slots with SSE2, 8 slots otherwise) and only looks at the keys of
+    slots whose control byte matches. The table grows automatically
+    when it is 7/8 full.
+
+    Lookup methods are templates, so a map can be searched with any type
+    which the hash functor accepts and which compares equal to the keys,
+    e.g. a String map can be searched with a const char* without
+    constructing a String.
+
+    Iteration visits the entries in insertion order. Erased entries
+    leave a hole which is skipped during iteration and which is only
+    removed when entries are added, so erasing never moves other entries
+    around and entries can be erased while iterating over the map.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "utility/string.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define UTIL_FLATHASH_SSE2 (1)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_BitScanForward)
+#endif
+
+//------------------------------------------------------------------------------
+namespace Util
+{
+
+//------------------------------------------------------------------------------
+/**
+    Scramble the bits of a hash value, the table uses the low bits of a
+    hash to select a slot and the high bits for the control bytes.
+*/
+inline unsigned int
+MixHash(unsigned int h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Hash a block of bytes (32 bit FNV-1a).
+*/
+inline unsigned int
+HashBytes(const char* ptr, size_t numBytes)
+{
+    unsigned int h = 2166136261U;
+    size_t i;
+    for (i = 0; i < numBytes; i++)
+    {
+        h ^= (unsigned char) ptr[i];
+        h *= 16777619U;
+    }
+    return MixHash(h);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Default hash functor of FlatHashMap and FlatHashSet. Keys are hashed
+    through their conversion to unsigned int, like in THashTable.
+*/
+template<class TYPE> struct Hash
+{
+    unsigned int operator()(const TYPE& key) const
+    {
+        return MixHash((unsigned int) key);
+    }
+};
+
+/// hash functor for pointers
+template<class TYPE> struct Hash<TYPE*>
+{
+    unsigned int operator()(const TYPE* key) const
+    {
+        size_t value = (size_t) key;
+        return MixHash((unsigned int) (value ^ ((value >> 16) >> 16)));
+    }
+};
+
+/// hash functor for strings, also accepts C strings
+template<> struct Hash<String>
+{
+    unsigned int operator()(const String& key) const
+    {
+        return HashBytes(key.c_str(), key.length());
+    }
+    unsigned int operator()(const char* key) const
+    {
+        return HashBytes(key, strlen(key));
+    }
+};
+
+//------------------------------------------------------------------------------
+/**
+    Control bytes and group matching. A group is the block of control bytes
+    compared in one go, a match is a bit mask with one bit per matching
+    slot of the group.
+*/
+namespace FlatHash
+{
+/// control byte of an empty slot
+const signed char Empty = -128;
+/// control byte of a slot whose entry was erased
+const signed char Deleted = -2;
+/// smallest table size
+const SizeT MinCapacity = 16;
+
+#if UTIL_FLATHASH_SSE2
+/// number of slots in a group
+const SizeT GroupWidth = 16;
+/// bits per slot in a match
+const unsigned int MatchShift = 0;
+
+typedef unsigned int Match;
+
+struct Group
+{
+    explicit Group(const signed char* ctrl) :
+        bytes(_mm_loadu_si128((const __m128i*) ctrl))
+    {
+        // empty
+    }
+    /// slots holding a hash value
+    Match MatchHash(signed char h2) const
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(this->bytes, _mm_set1_epi8(h2)));
+    }
+    /// empty slots
+    Match MatchEmpty() const
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(this->bytes, _mm_set1_epi8(Empty)));
+    }
+    /// empty or deleted slots (only those have the sign bit set)
+    Match MatchFree() const
+    {
+        return _mm_movemask_epi8(this->bytes);
+    }
+    __m128i bytes;
+};
+#else
+/// number of slots in a group
+const SizeT GroupWidth = 8;
+/// bits per slot in a match
+const unsigned int MatchShift = 3;
+
+typedef unsigned long long Match;
+
+/// portable group operating on 8 control bytes in a 64 bit integer (little endian)
+struct Group
+{
+    static const unsigned long long Lsbs = 0x0101010101010101ULL;
+    static const unsigned long long Msbs = 0x8080808080808080ULL;
+
+    explicit Group(const signed char* ctrl)
+    {
+        memcpy(&this->bytes, ctrl, sizeof(this->bytes));
+    }
+    /// slots holding a hash value, may report false positives which fail the key compare
+    Match MatchHash(signed char h2) const
+    {
+        unsigned long long x = this->bytes ^ (Lsbs * (unsigned char) h2);
+        return (x - Lsbs) & ~x & Msbs;
+    }
+    /// empty slots
+    Match MatchEmpty() const
+    {
+        return (this->bytes & ~(this->bytes << 6)) & Msbs;
+    }
+    /// empty or deleted slots
+    Match MatchFree() const
+    {
+        return (this->bytes & ~(this->bytes << 7)) & Msbs;
+    }
+    unsigned long long bytes;
+};
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    Get the offset of the first slot in a non-empty match.
+*/
+inline SizeT
+FirstSlot(Match match)
+{
+    #if defined(_MSC_VER)
+    unsigned long index;
+    unsigned long low = (unsigned long) match;
+    if (0 != low)
+    {
+        _BitScanForward(&index, low);
+    }
+    else
+    {
+        _BitScanForward(&index, (unsigned long) ((match >> 16) >> 16));
+        index += 32;
+    }
+    return SizeT(index) >> MatchShift;
+    #else
+    return SizeT(__builtin_ctzll(match)) >> MatchShift;
+    #endif
+}
+
+} // namespace FlatHash
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASH = Hash<KEY> >
+class FlatHashMap
+{
+public:
+    /// an entry
+    typedef std::pair<KEY, VALUE> Entry;
+
+    /// iterator over the entries in insertion order
+    template<class MAP, class ENTRY> class IteratorBase
+    {
+    public:
+        /// default constructor
+        IteratorBase() : map(0), index(0) {}
+        /// constructor
+        IteratorBase(MAP* m, IndexT i) : map(m), index(i) { this->Skip(); }
+        /// convert an iterator to a const iterator
+        template<class OTHERMAP, class OTHERENTRY> IteratorBase(const IteratorBase<OTHERMAP, OTHERENTRY>& rhs) : map(rhs.map), index(rhs.index) {}
+        /// get the entry
+        ENTRY& operator*() const { return this->map->entries[this->index]; }
+        /// get the entry
+        ENTRY* operator->() const { return &this->map->entries[this->index]; }
+        /// move to the next entry
+        IteratorBase& operator++() { this->index++; this->Skip(); return *this; }
+        /// equality operator
+        bool operator==(const IteratorBase& rhs) const { return this->index == rhs.index; }
+        /// inequality operator
+        bool operator!=(const IteratorBase& rhs) const { return this->index != rhs.index; }
+
+        MAP* map;
+        IndexT index;
+
+    private:
+        /// skip erased entries
+        void Skip() { while ((this->index < this->map->entries.size()) && (Removed == this->map->hashes[this->index])) this->index++; }
+    };
+    typedef IteratorBase<FlatHashMap, Entry> Iterator;
+    typedef IteratorBase<const FlatHashMap, const Entry> ConstIterator;
+
+    /// constructor
+    FlatHashMap();
+    /// constructor with a hash functor
+    explicit FlatHashMap(const HASH& hash);
+
+    /// get number of entries
+    SizeT Size() const;
+    /// return true if the map is empty
+    bool IsEmpty() const;
+    /// get number of slots in the table
+    SizeT Capacity() const;
+    /// remove all entries, keeps the memory
+    void Clear();
+    /// make room for a number of entries without growing
+    void Reserve(SizeT numEntries);
+
+    /// add a new entry, returns false if the key already exists
+    bool Add(const KEY& key, const VALUE& value);
+    /// get the value of a key, adds a default value if the key doesn't exist
+    VALUE& operator[](const KEY& key);
+    /// find the value of a key, returns 0 if the key doesn't exist
+    template<class LOOKUP> VALUE* Find(const LOOKUP& key);
+    /// find the value of a key, returns 0 if the key doesn't exist
+    template<class LOOKUP> const VALUE* Find(const LOOKUP& key) const;
+    /// find the entry of a key, returns 0 if the key doesn't exist
+    template<class LOOKUP> const Entry* FindEntry(const LOOKUP& key) const;
+    /// return true if a key exists
+    template<class LOOKUP> bool Contains(const LOOKUP& key) const;
+    /// erase a key, returns false if the key doesn't exist
+    template<class LOOKUP> bool Erase(const LOOKUP& key);
+
+    /// get iterator to the first entry
+    Iterator Begin();
+    /// get iterator behind the last entry
+    Iterator End();
+    /// get iterator to the first entry
+    ConstIterator Begin() const;
+    /// get iterator behind the last entry
+    ConstIterator End() const;
+
+    /// get the hash functor
+    const HASH& GetHash() const;
+
+private:
+    template<class MAP, class ENTRY> friend class IteratorBase;
+
+    /// stored hash of an erased entry (hashes are stored without their top bit)
+    static const unsigned int Removed = 0xffffffff;
+
+    /// find the slot of a key, returns InvalidIndex if not found
+    template<class LOOKUP> IndexT FindSlot(const LOOKUP& key, unsigned int hash) const;
+    /// find the first free slot on the probe sequence of a hash
+    IndexT FindFreeSlot(unsigned int hash) const;
+    /// set the control byte of a slot
+    void SetCtrl(IndexT slot, signed char ctrl);
+    /// add an entry for a key which doesn't exist yet
+    IndexT Insert(const KEY& key, const VALUE& value, unsigned int hash);
+    /// rebuild the table with a new capacity, removes erased entries
+    void Rehash(SizeT newCapacity);
+
+    HASH hash;
+    std::vector<Entry> entries;             // entries in insertion order
+    std::vector<unsigned int> hashes;       // hash of each entry, or Removed
+    std::vector<signed char> ctrl;          // control bytes, followed by a copy of the first group
+    std::vector<IndexT> slots;              // entry index of each slot
+    SizeT size;
+    SizeT growthLeft;                       // number of empty slots which may still be used
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+FlatHashMap<KEY, VALUE, HASH>::FlatHashMap() :
+    size(0),
+    growthLeft(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+FlatHashMap<KEY, VALUE, HASH>::FlatHashMap(const HASH& h) :
+    hash(h),
+    size(0),
+    growthLeft(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline SizeT
+FlatHashMap<KEY, VALUE, HASH>::Size() const
+{
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline bool
+FlatHashMap<KEY, VALUE, HASH>::IsEmpty() const
+{
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline SizeT
+FlatHashMap<KEY, VALUE, HASH>::Capacity() const
+{
+    return (SizeT) this->slots.size();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline const HASH&
+FlatHashMap<KEY, VALUE, HASH>::GetHash() const
+{
+    return this->hash;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+void
+FlatHashMap<KEY, VALUE, HASH>::Clear()
+{
+    this->entries.clear();
+    this->hashes.clear();
+    std::fill(this->ctrl.begin(), this->ctrl.end(), FlatHash::Empty);
+    this->size = 0;
+    this->growthLeft = this->Capacity() - this->Capacity() / 8;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+void
+FlatHashMap<KEY, VALUE, HASH>::Reserve(SizeT numEntries)
+{
+    SizeT newCapacity = FlatHash::MinCapacity;
+    while (newCapacity - newCapacity / 8 < numEntries)
+    {
+        newCapacity *= 2;
+    }
+    if (newCapacity > this->Capacity())
+    {
+        this->Rehash(newCapacity);
+    }
+    this->entries.reserve(numEntries);
+    this->hashes.reserve(numEntries);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Probes the table group by group, starting at the group selected by the
+    low bits of the hash. The control byte of a used slot holds the top 7
+    bits of the hash. The search ends at the first group with an empty
+    slot, since an insert would have used that slot.
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+IndexT
+FlatHashMap<KEY, VALUE, HASH>::FindSlot(const LOOKUP& key, unsigned int h) const
+{
+    if (0 == this->size)
+    {
+        return InvalidIndex;
+    }
+    IndexT mask = this->Capacity() - 1;
+    signed char h2 = (signed char) ((h >> 24) & 0x7f);
+    IndexT pos = h & mask;
+    SizeT step = 0;
+    for (;;)
+    {
+        FlatHash::Group group(&this->ctrl[pos]);
+        FlatHash::Match match = group.MatchHash(h2);
+        while (0 != match)
+        {
+            IndexT slot = (pos + FlatHash::FirstSlot(match)) & mask;
+            IndexT entryIndex = this->slots[slot];
+            if ((this->hashes[entryIndex] == h) && (this->entries[entryIndex].first == key))
+            {
+                return slot;
+            }
+            match &= match - 1;
+        }
+        if (0 != group.MatchEmpty())
+        {
+            return InvalidIndex;
+        }
+        step += FlatHash::GroupWidth;
+        pos = (pos + step) & mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+IndexT
+FlatHashMap<KEY, VALUE, HASH>::FindFreeSlot(unsigned int h) const
+{
+    IndexT mask = this->Capacity() - 1;
+    IndexT pos = h & mask;
+    SizeT step = 0;
+    for (;;)
+    {
+        FlatHash::Match match = FlatHash::Group(&this->ctrl[pos]).MatchFree();
+        if (0 != match)
+        {
+            return (pos + FlatHash::FirstSlot(match)) & mask;
+        }
+        step += FlatHash::GroupWidth;
+        pos = (pos + step) & mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    The first group is mirrored behind the end of the table, so groups
+    can be loaded at any slot without wrapping around.
+*/
+template<class KEY, class VALUE, class HASH>
+inline void
+FlatHashMap<KEY, VALUE, HASH>::SetCtrl(IndexT slot, signed char c)
+{
+    this->ctrl[slot] = c;
+    if (slot < FlatHash::GroupWidth)
+    {
+        this->ctrl[this->Capacity() + slot] = c;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns the index of the new entry.
+*/
+template<class KEY, class VALUE, class HASH>
+IndexT
+FlatHashMap<KEY, VALUE, HASH>::Insert(const KEY& key, const VALUE& value, unsigned int h)
+{
+    // squeeze out the holes left by Erase() once they are the majority
+    if (this->size < this->entries.size() / 2)
+    {
+        this->Rehash(this->Capacity());
+    }
+
+    IndexT slot = (0 == this->Capacity()) ? InvalidIndex : this->FindFreeSlot(h);
+    if ((InvalidIndex == slot) || ((0 == this->growthLeft) && (FlatHash::Empty == this->ctrl[slot])))
+    {
+        // the table is full of deleted slots if it is less than half full,
+        // in that case rehashing into the same capacity is enough
+        SizeT newCapacity = (0 == this->Capacity()) ? FlatHash::MinCapacity : this->Capacity();
+        if (this->size >= (newCapacity - newCapacity / 8) / 2)
+        {
+            newCapacity *= 2;
+        }
+        this->Rehash(newCapacity);
+        slot = this->FindFreeSlot(h);
+    }
+    if (FlatHash::Empty == this->ctrl[slot])
+    {
+        this->growthLeft--;
+    }
+
+    IndexT entryIndex = (IndexT) this->entries.size();
+    this->entries.push_back(Entry(key, value));
+    this->hashes.push_back(h);
+    this->SetCtrl(slot, (signed char) ((h >> 24) & 0x7f));
+    this->slots[slot] = entryIndex;
+    this->size++;
+    return entryIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+void
+FlatHashMap<KEY, VALUE, HASH>::Rehash(SizeT newCapacity)
+{
+    s_assert(0 == (newCapacity & (newCapacity - 1)));
+    s_assert(newCapacity >= this->size);
+
+    // squeeze out the holes left by erased entries, keeping the order
+    if (this->entries.size() != this->size)
+    {
+        IndexT to = 0;
+        IndexT from;
+        for (from = 0; from < this->entries.size(); from++)
+        {
+            if (Removed != this->hashes[from])
+            {
+                if (to != from)
+                {
+                    this->entries[to] = this->entries[from];
+                    this->hashes[to] = this->hashes[from];
+                }
+                to++;
+            }
+        }
+        this->entries.erase(this->entries.begin() + to, this->entries.end());
+        this->hashes.erase(this->hashes.begin() + to, this->hashes.end());
+    }
+
+    this->ctrl.assign(newCapacity + FlatHash::GroupWidth, FlatHash::Empty);
+    this->slots.resize(newCapacity);
+    this->growthLeft = newCapacity - newCapacity / 8 - this->size;
+    IndexT i;
+    for (i = 0; i < this->entries.size(); i++)
+    {
+        IndexT slot = this->FindFreeSlot(this->hashes[i]);
+        this->SetCtrl(slot, (signed char) ((this->hashes[i] >> 24) & 0x7f));
+        this->slots[slot] = i;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+bool
+FlatHashMap<KEY, VALUE, HASH>::Add(const KEY& key, const VALUE& value)
+{
+    unsigned int h = this->hash(key) & 0x7fffffff;
+    if (InvalidIndex != this->FindSlot(key, h))
+    {
+        return false;
+    }
+    this->Insert(key, value, h);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+VALUE&
+FlatHashMap<KEY, VALUE, HASH>::operator[](const KEY& key)
+{
+    unsigned int h = this->hash(key) & 0x7fffffff;
+    IndexT slot = this->FindSlot(key, h);
+    if (InvalidIndex != slot)
+    {
+        return this->entries[this->slots[slot]].second;
+    }
+    return this->entries[this->Insert(key, VALUE(), h)].second;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+VALUE*
+FlatHashMap<KEY, VALUE, HASH>::Find(const LOOKUP& key)
+{
+    IndexT slot = this->FindSlot(key, this->hash(key) & 0x7fffffff);
+    return (InvalidIndex != slot) ? &this->entries[this->slots[slot]].second : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+const VALUE*
+FlatHashMap<KEY, VALUE, HASH>::Find(const LOOKUP& key) const
+{
+    IndexT slot = this->FindSlot(key, this->hash(key) & 0x7fffffff);
+    return (InvalidIndex != slot) ? &this->entries[this->slots[slot]].second : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+const typename FlatHashMap<KEY, VALUE, HASH>::Entry*
+FlatHashMap<KEY, VALUE, HASH>::FindEntry(const LOOKUP& key) const
+{
+    IndexT slot = this->FindSlot(key, this->hash(key) & 0x7fffffff);
+    return (InvalidIndex != slot) ? &this->entries[this->slots[slot]] : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+bool
+FlatHashMap<KEY, VALUE, HASH>::Contains(const LOOKUP& key) const
+{
+    return InvalidIndex != this->FindSlot(key, this->hash(key) & 0x7fffffff);
+}
+
+//------------------------------------------------------------------------------
+/**
+    The slot is marked as deleted so probe sequences running through it
+    aren't cut short, the entry is reset to release what it holds and
+    stays behind as a hole until the next rehash. Rehashing is left to
+    the insertions, so the other entries keep their place and a running
+    iteration stays valid.
+*/
+template<class KEY, class VALUE, class HASH>
+template<class LOOKUP>
+bool
+FlatHashMap<KEY, VALUE, HASH>::Erase(const LOOKUP& key)
+{
+    IndexT slot = this->FindSlot(key, this->hash(key) & 0x7fffffff);
+    if (InvalidIndex == slot)
+    {
+        return false;
+    }
+    IndexT entryIndex = this->slots[slot];
+    this->SetCtrl(slot, FlatHash::Deleted);
+    this->hashes[entryIndex] = Removed;
+    this->entries[entryIndex] = Entry();
+    this->size--;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline typename FlatHashMap<KEY, VALUE, HASH>::Iterator
+FlatHashMap<KEY, VALUE, HASH>::Begin()
+{
+    return Iterator(this, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline typename FlatHashMap<KEY, VALUE, HASH>::Iterator
+FlatHashMap<KEY, VALUE, HASH>::End()
+{
+    return Iterator(this, (IndexT) this->entries.size());
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline typename FlatHashMap<KEY, VALUE, HASH>::ConstIterator
+FlatHashMap<KEY, VALUE, HASH>::Begin() const
+{
+    return ConstIterator(this, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class VALUE, class HASH>
+inline typename FlatHashMap<KEY, VALUE, HASH>::ConstIterator
+FlatHashMap<KEY, VALUE, HASH>::End() const
+{
+    return ConstIterator(this, (IndexT) this->entries.size());
+}
+
+} // namespace Util
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,211 @@
+#pragma once
+#ifndef UTIL_FLATHASHSET_H
+#define UTIL_FLATHASHSET_H
+//------------------------------------------------------------------------------
+/**
+    @class Util::FlatHashSet
+
+    A set of unique keys on top of Util::FlatHashMap. Has the same
+    properties as the map: flat storage, group probing, automatic growth,
+    lookup with any type the hash functor accepts and iteration in
+    insertion order.
+
+    (C) 2007 by Ctuo
+*/
+#include "utility/flathashmap.h"
+
+//------------------------------------------------------------------------------
+namespace Util
+{
+template<class KEY, class HASH = Hash<KEY> >
+class FlatHashSet
+{
+private:
+    /// placeholder value of the underlying map
+    struct Nothing {};
+    typedef FlatHashMap<KEY, Nothing, HASH> Map;
+
+public:
+    /// iterator over the keys in insertion order
+    class ConstIterator
+    {
+    public:
+        /// default constructor
+        ConstIterator() {}
+        /// constructor
+        ConstIterator(const typename Map::ConstIterator& i) : iter(i) {}
+        /// get the key
+        const KEY& operator*() const { return this->iter->first; }
+        /// get the key
+        const KEY* operator->() const { return &this->iter->first; }
+        /// move to the next key
+        ConstIterator& operator++() { ++this->iter; return *this; }
+        /// equality operator
+        bool operator==(const ConstIterator& rhs) const { return this->iter == rhs.iter; }
+        /// inequality operator
+        bool operator!=(const ConstIterator& rhs) const { return this->iter != rhs.iter; }
+
+    private:
+        typename Map::ConstIterator iter;
+    };
+
+    /// constructor
+    FlatHashSet();
+    /// constructor with a hash functor
+    explicit FlatHashSet(const HASH& hash);
+
+    /// get number of keys
+    SizeT Size() const;
+    /// return true if the set is empty
+    bool IsEmpty() const;
+    /// remove all keys, keeps the memory
+    void Clear();
+    /// make room for a number of keys without growing
+    void Reserve(SizeT numKeys);
+
+    /// add a key, returns false if the key already exists
+    bool Add(const KEY& key);
+    /// find the stored key equal to a key, returns 0 if the key doesn't exist
+    template<class LOOKUP> const KEY* Find(const LOOKUP& key) const;
+    /// return true if a key exists
+    template<class LOOKUP> bool Contains(const LOOKUP& key) const;
+    /// erase a key, returns false if the key doesn't exist
+    template<class LOOKUP> bool Erase(const LOOKUP& key);
+
+    /// get iterator to the first key
+    ConstIterator Begin() const;
+    /// get iterator behind the last key
+    ConstIterator End() const;
+
+private:
+    Map map;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+FlatHashSet<KEY, HASH>::FlatHashSet()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+FlatHashSet<KEY, HASH>::FlatHashSet(const HASH& hash) :
+    map(hash)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline SizeT
+FlatHashSet<KEY, HASH>::Size() const
+{
+    return this->map.Size();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline bool
+FlatHashSet<KEY, HASH>::IsEmpty() const
+{
+    return this->map.IsEmpty();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline void
+FlatHashSet<KEY, HASH>::Clear()
+{
+    this->map.Clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline void
+FlatHashSet<KEY, HASH>::Reserve(SizeT numKeys)
+{
+    this->map.Reserve(numKeys);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline bool
+FlatHashSet<KEY, HASH>::Add(const KEY& key)
+{
+    return this->map.Add(key, Nothing());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns the stored key, which may differ from the searched key in
+    members that aren't used by the hash and comparison.
+*/
+template<class KEY, class HASH>
+template<class LOOKUP>
+inline const KEY*
+FlatHashSet<KEY, HASH>::Find(const LOOKUP& key) const
+{
+    const typename Map::Entry* entry = this->map.FindEntry(key);
+    return (0 != entry) ? &entry->first : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+template<class LOOKUP>
+inline bool
+FlatHashSet<KEY, HASH>::Contains(const LOOKUP& key) const
+{
+    return this->map.Contains(key);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+template<class LOOKUP>
+inline bool
+FlatHashSet<KEY, HASH>::Erase(const LOOKUP& key)
+{
+    return this->map.Erase(key);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline typename FlatHashSet<KEY, HASH>::ConstIterator
+FlatHashSet<KEY, HASH>::Begin() const
+{
+    return ConstIterator(this->map.Begin());
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class KEY, class HASH>
+inline typename FlatHashSet<KEY, HASH>::ConstIterator
+FlatHashSet<KEY, HASH>::End() const
+{
+    return ConstIterator(this->map.End());
+}
+
+} // namespace Util
+//------------------------------------------------------------------------------
+#endif
@@ -6,15 +6,27 @@
   ʹstdչ⣬м㣬Ժƽ̨ʱ޸ġ
 */
 
+#include "core/config.h"
+#if __WIN32__
 #include <hash_map>
+#else
+#include <unordered_map>
+#endif
 
 namespace Util
 {
 
+#if __WIN32__
 template<class KEYTYPE, class VALUETYPE>
 class HashTable : public stdext::hash_map<KEYTYPE, VALUETYPE>
 {
 };
+#else
+template<class KEYTYPE, class VALUETYPE>
+class HashTable : public std::unordered_map<KEYTYPE, VALUETYPE>
+{
+};
+#endif
 
 }
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define UTIL_SYSTEM_H
 
 #include "core/types.h"
+#include <stdio.h>
 
 
 FILE* s_open (const char* acFilename, const char* acMode);
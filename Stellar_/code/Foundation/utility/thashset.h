@@ -0,0 +1,166 @@
+
+#ifndef UTIL_THASHSET_H
+#define UTIL_THASHSET_H
+
+#include "utility/flathashset.h"
+
+// The class TKEY is either native data or is class data that has the
+// following member functions:
+//   TKEY::TKEY ()
+//   TKEY& TKEY::operator= (const TKEY&)
+//   bool TKEY::operator== (const TKEY&) const
+//   bool TKEY::operator!= (const TKEY&) const
+//   TKEY::operator unsigned int () const
+// The implicit conversion to unsigned int is used as the hash value of the
+// key, unless a UserHashFunction is set.
+//
+// THashSet is a thin wrapper over Util::FlatHashSet.  The set grows as
+// needed, the table size passed to the constructor only reserves room for
+// that many keys.  Traversal visits the keys in insertion order.
+
+namespace Util
+{
+
+template <class TKEY>
+class THashSet
+{
+public:
+    // construction and destruction
+    THashSet (int iTableSize);
+    ~THashSet ();
+
+    // element access
+    int GetQuantity () const;
+
+    // A pointer to the actual storage is returned so that the caller has
+    // direct access to it.  This allows a subset of TKEY members to be used
+    // in key comparison.
+    TKEY* Insert (const TKEY& rtKey);
+
+    // If the input key exists, a pointer to the actual storage is returned.
+    // This allows a subset of TKEY members to be used in key comparison,
+    // but gives the caller a chance to modify other TKEY members.
+    TKEY* Get (const TKEY& rtKey) const;
+
+    bool Remove (const TKEY& rtKey);
+    void RemoveAll ();
+
+    // linear traversal of map
+    TKEY* GetFirst () const;
+    TKEY* GetNext () const;
+
+    // user-specified key-to-hash construction, must be set before the
+    // first insert
+    int (*UserHashFunction)(const TKEY&);
+
+private:
+    // Default key-to-hash construction (override by user-specified when
+    // requested).
+    class HashFunction
+    {
+    public:
+        HashFunction (const THashSet* pkSet) : m_pkSet(pkSet) { /**/ }
+        unsigned int operator() (const TKEY& rtKey) const;
+
+        const THashSet* m_pkSet;
+    };
+    typedef FlatHashSet<TKEY,HashFunction> Set;
+
+    // copying is not allowed
+    THashSet (const THashSet&);
+    THashSet& operator= (const THashSet&);
+
+    // hash set
+    Set m_kSet;
+
+    // iterator for traversal
+    mutable typename Set::ConstIterator m_kIterator;
+};
+
+//----------------------------------------------------------------------------
+template <class TKEY>
+THashSet<TKEY>::THashSet (int iTableSize)
+    :
+    m_kSet(HashFunction(this))
+{
+    s_assert(iTableSize > 0);
+
+    m_kSet.Reserve(iTableSize);
+    UserHashFunction = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class TKEY>
+THashSet<TKEY>::~THashSet ()
+{
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+int THashSet<TKEY>::GetQuantity () const
+{
+    return (int)m_kSet.Size();
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::Insert (const TKEY& rtKey)
+{
+    m_kSet.Add(rtKey);
+    return Get(rtKey);
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::Get (const TKEY& rtKey) const
+{
+    return const_cast<TKEY*>(m_kSet.Find(rtKey));
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+bool THashSet<TKEY>::Remove (const TKEY& rtKey)
+{
+    return m_kSet.Erase(rtKey);
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+void THashSet<TKEY>::RemoveAll ()
+{
+    m_kSet.Clear();
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::GetFirst () const
+{
+    m_kIterator = m_kSet.Begin();
+    return GetNext();
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+TKEY* THashSet<TKEY>::GetNext () const
+{
+    if (m_kIterator == m_kSet.End())
+    {
+        return 0;
+    }
+
+    TKEY* ptKey = const_cast<TKEY*>(&*m_kIterator);
+    ++m_kIterator;
+    return ptKey;
+}
+//----------------------------------------------------------------------------
+template <class TKEY>
+unsigned int THashSet<TKEY>::HashFunction::operator() (
+    const TKEY& rtKey) const
+{
+    if (m_pkSet->UserHashFunction)
+    {
+        return MixHash((unsigned int)(*m_pkSet->UserHashFunction)(rtKey));
+    }
+
+    // default hash function
+    return Hash<TKEY>()(rtKey);
+}
+//----------------------------------------------------------------------------
+
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+
+#ifndef UTIL_THASHTABLE_H
+#define UTIL_THASHTABLE_H
+
+#include "utility/flathashmap.h"
+
+// The class TKEY is either native data or is class data that has the
+// following member functions:
+//   TKEY::TKEY ()
+//   TKEY& TKEY::operator= (const TKEY&)
+//   bool TKEY::operator== (const TKEY&) const
+//   bool TKEY::operator!= (const TKEY&) const
+//   TKEY::operator unsigned int () const
+// The implicit conversion to unsigned int is used as the hash value of the
+// key, unless a UserHashFunction is set.
+//
+// The class TVALUE is either native data or is class data that has the
+// following member functions:
+//   TVALUE::TVALUE ()
+//   TVALUE& TVALUE::operator= (const TVALUE&)
+//
+// THashTable is a thin wrapper over Util::FlatHashMap.  The table grows as
+// needed, the table size passed to the constructor only reserves room for
+// that many items.  Traversal visits the items in insertion order.
+
+namespace Util
+{
+
+template <class TKEY, class TVALUE>
+class THashTable
+{
+public:
+    // construction and destruction
+    THashTable (int iTableSize);
+    ~THashTable ();
+
+    // element access
+    int GetQuantity () const;
+
+    // insert a key-value pair into the hash table
+    bool Insert (const TKEY& rtKey, const TVALUE& rtValue);
+
+    // search for a key and returns it value (null, if key does not exist)
+    TVALUE* Find (const TKEY& rtKey) const;
+
+    // remove key-value pairs from the hash table
+    bool Remove (const TKEY& rtKey);
+    void RemoveAll ();
+
+    // linear traversal of table
+    TVALUE* GetFirst (TKEY* ptKey) const;
+    TVALUE* GetNext (TKEY* ptKey) const;
+
+    // user-specified key-to-hash construction, must be set before the
+    // first insert
+    int (*UserHashFunction)(const TKEY&);
+
+private:
+    // Default key-to-hash construction (override by user-specified when
+    // requested).
+    class HashFunction
+    {
+    public:
+        HashFunction (const THashTable* pkTable) : m_pkTable(pkTable) { /**/ }
+        unsigned int operator() (const TKEY& rtKey) const;
+
+        const THashTable* m_pkTable;
+    };
+    typedef FlatHashMap<TKEY,TVALUE,HashFunction> Map;
+
+    // copying is not allowed
+    THashTable (const THashTable&);
+    THashTable& operator= (const THashTable&);
+
+    // hash table
+    Map m_kMap;
+
+    // iterator for traversal
+    mutable typename Map::ConstIterator m_kIterator;
+};
+
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+THashTable<TKEY,TVALUE>::THashTable (int iTableSize)
+    :
+    m_kMap(HashFunction(this))
+{
+    s_assert(iTableSize > 0);
+
+    m_kMap.Reserve(iTableSize);
+    UserHashFunction = 0;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+THashTable<TKEY,TVALUE>::~THashTable ()
+{
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+int THashTable<TKEY,TVALUE>::GetQuantity () const
+{
+    return (int)m_kMap.Size();
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+bool THashTable<TKEY,TVALUE>::Insert (const TKEY& rtKey,
+    const TVALUE& rtValue)
+{
+    return m_kMap.Add(rtKey,rtValue);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+TVALUE* THashTable<TKEY,TVALUE>::Find (const TKEY& rtKey) const
+{
+    return const_cast<TVALUE*>(m_kMap.Find(rtKey));
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+bool THashTable<TKEY,TVALUE>::Remove (const TKEY& rtKey)
+{
+    return m_kMap.Erase(rtKey);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+void THashTable<TKEY,TVALUE>::RemoveAll ()
+{
+    m_kMap.Clear();
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+TVALUE* THashTable<TKEY,TVALUE>::GetFirst (TKEY* ptKey) const
+{
+    m_kIterator = m_kMap.Begin();
+    return GetNext(ptKey);
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+TVALUE* THashTable<TKEY,TVALUE>::GetNext (TKEY* ptKey) const
+{
+    if (m_kIterator == m_kMap.End())
+    {
+        return 0;
+    }
+
+    *ptKey = m_kIterator->first;
+    TVALUE* ptValue = const_cast<TVALUE*>(&m_kIterator->second);
+    ++m_kIterator;
+    return ptValue;
+}
+//----------------------------------------------------------------------------
+template <class TKEY, class TVALUE>
+unsigned int THashTable<TKEY,TVALUE>::HashFunction::operator() (
+    const TKEY& rtKey) const
+{
+    if (m_pkTable->UserHashFunction)
+    {
+        return MixHash((unsigned int)(*m_pkTable->UserHashFunction)(rtKey));
+    }
+
+    // default hash function
+    return Hash<TKEY>()(rtKey);
+}
+//----------------------------------------------------------------------------
+
+
+}
+
+#endif
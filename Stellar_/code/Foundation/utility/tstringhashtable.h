@@ -0,0 +1,147 @@
+#ifndef UTIL_TSTRINGHASHTABLE_H
+#define UTIL_TSTRINGHASHTABLE_H
+
+#include "utility/string.h"
+#include "utility/flathashmap.h"
+#include "core/types.h"
+
+// The class TVALUE is either native data or is class data that has the
+// following member functions:
+//   TVALUE::TVALUE ()
+//   TVALUE& TVALUE::operator= (const TVALUE&)
+//
+// TStringHashTable is a thin wrapper over Util::FlatHashMap.  The table
+// grows as needed, the table size passed to the constructor only reserves
+// room for that many items.  Items can be found by C strings without
+// constructing a Util::String.  Traversal visits the items in insertion
+// order.
+
+namespace Util
+{
+
+
+template <class TVALUE>
+class TStringHashTable
+{
+public:
+    // construction and destruction
+    TStringHashTable (int iTableSize);
+    ~TStringHashTable ();
+
+    // element access
+    int GetQuantity () const;
+
+    // insert a key-value pair into the hash table
+    bool Insert (const Util::String& rkKey, const TVALUE& rtValue);
+
+    // search for a key and returns it value (null, if key does not exist)
+    TVALUE* Find (const Util::String& rkKey) const;
+    TVALUE* Find (const char* acKey) const;
+
+    // remove key-value pairs from the hash table
+    bool Remove (const Util::String& rkKey);
+    void RemoveAll ();
+
+    // linear traversal of table
+    TVALUE* GetFirst (Util::String* pkKey) const;
+    TVALUE* GetNext (Util::String* pkKey) const;
+
+private:
+    typedef FlatHashMap<Util::String,TVALUE> Map;
+
+    // copying is not allowed
+    TStringHashTable (const TStringHashTable&);
+    TStringHashTable& operator= (const TStringHashTable&);
+
+    // hash table
+    Map m_kMap;
+
+    // iterator for traversal
+    mutable typename Map::ConstIterator m_kIterator;
+};
+
+
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TStringHashTable<TVALUE>::TStringHashTable (int iTableSize)
+{
+    s_assert(iTableSize > 0);
+
+    m_kMap.Reserve(iTableSize);
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TStringHashTable<TVALUE>::~TStringHashTable ()
+{
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+int 
+TStringHashTable<TVALUE>::GetQuantity () const
+{
+    return (int)m_kMap.Size();
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+bool 
+TStringHashTable<TVALUE>::Insert (const Util::String& rkKey,
+    const TVALUE& rtValue)
+{
+    return m_kMap.Add(rkKey,rtValue);
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TVALUE* 
+TStringHashTable<TVALUE>::Find (const Util::String& rkKey) const
+{
+    return const_cast<TVALUE*>(m_kMap.Find(rkKey));
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TVALUE* 
+TStringHashTable<TVALUE>::Find (const char* acKey) const
+{
+    return const_cast<TVALUE*>(m_kMap.Find(acKey));
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+bool 
+TStringHashTable<TVALUE>::Remove (const Util::String& rkKey)
+{
+    return m_kMap.Erase(rkKey);
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+void 
+TStringHashTable<TVALUE>::RemoveAll ()
+{
+    m_kMap.Clear();
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TVALUE* 
+TStringHashTable<TVALUE>::GetFirst (Util::String* pkKey) const
+{
+    m_kIterator = m_kMap.Begin();
+    return GetNext(pkKey);
+}
+//----------------------------------------------------------------------------
+template <class TVALUE>
+TVALUE* 
+TStringHashTable<TVALUE>::GetNext (Util::String* pkKey) const
+{
+    if (m_kIterator == m_kMap.End())
+    {
+        return 0;
+    }
+
+    *pkKey = m_kIterator->first;
+    TVALUE* ptValue = const_cast<TVALUE*>(&m_kIterator->second);
+    ++m_kIterator;
+    return ptValue;
+}
+//----------------------------------------------------------------------------
+
+}
+
+#endif
@@ -16,13 +16,13 @@
 //#include "resources/managedtexture.h"
 //#include "resources/managedmesh.h"
 #include "frame/frameserver.h"
+#include "debuging/profiler.h"
 //#include "coregraphics/debug/displaypagehandler.h"
 //#include "coregraphics/debug/texturepagehandler.h"
 //#include "coregraphics/debug/meshpagehandler.h"
 //#include "coregraphics/debug/shaderpagehandler.h"
 //#include "scripting/debug/scriptingpagehandler.h"
 //#include "io/debug/iopagehandler.h"
-//#include "memory/debug/memorypagehandler.h"
 //#include "core/debug/corepagehandler.h"
 
 namespace App
@@ -110,7 +110,6 @@ RenderApplication::Open()
         //// setup debug http server
         //this->httpServer = HttpServer::Create();
         //this->httpServer->Open();
-        //this->httpServer->AttachRequestHandler(Debug::MemoryPageHandler::Create());
         //this->httpServer->AttachRequestHandler(Debug::CorePageHandler::Create());
         //this->httpServer->AttachRequestHandler(Debug::IoPageHandler::Create());
         //this->httpServer->AttachRequestHandler(Debug::ScriptingPageHandler::Create());
@@ -339,15 +338,23 @@ RenderApplication::Run()
         //this->inputServer->OnFrame();
         this->OnProcessInput();
         this->UpdateTime();
-        this->OnUpdateFrame();
+        {
+            s_profile("RenderApplication::OnUpdateFrame");
+            this->OnUpdateFrame();
+        }
         if (this->renderDevice->BeginFrame())
         {
-            this->OnRenderFrame();
+            {
+                s_profile("RenderApplication::OnRenderFrame");
+                this->OnRenderFrame();
+            }
             this->renderDevice->EndFrame();
+            s_profile("RenderDevice::Present");
             this->renderDevice->Present();
         }
         //this->resourceManager->Update();
         //this->inputServer->EndFrame();
+        Debug::Profiler::NextFrame();
     }
 }
 
@@ -21,6 +21,7 @@ using namespace CoreGraphics;
 /**
 */
 RenderDeviceBase::RenderDeviceBase() :
+    frameHeap("CoreGraphics.FrameHeap"),
     isOpen(false),
     inNotifyEventHandlers(false),
     inBeginFrame(false),
@@ -28,6 +29,10 @@ RenderDeviceBase::RenderDeviceBase() :
     inBeginBatch(false)
 {
     ConstructSingleton;
+    Memory::Clear(this->numIssued, sizeof(this->numIssued));
+    Memory::Clear(this->numFiltered, sizeof(this->numFiltered));
+    Memory::Clear(this->lastNumIssued, sizeof(this->lastNumIssued));
+    Memory::Clear(this->lastNumFiltered, sizeof(this->lastNumFiltered));
 }
 
 //------------------------------------------------------------------------------
@@ -116,6 +121,7 @@ RenderDeviceBase::IsOpen() const
 void
 RenderDeviceBase::SetVertexBuffer(const Ptr<VertexBuffer>& vb)
 {
+    this->CountStateChange(VertexBufferState, this->vertexBuffer != vb);
     this->vertexBuffer = vb;
 }
 
@@ -134,6 +140,7 @@ RenderDeviceBase::GetVertexBuffer() const
 void
 RenderDeviceBase::SetIndexBuffer(const Ptr<IndexBuffer>& ib)
 {
+    this->CountStateChange(IndexBufferState, this->indexBuffer != ib);
     this->indexBuffer = ib;
 }
 
@@ -206,6 +213,13 @@ RenderDeviceBase::BeginFrame()
     s_assert(!this->vertexBuffer.isvalid());
     s_assert(!this->indexBuffer.isvalid());
 
+    // release the transient memory of the frame before the last
+    this->frameHeap.BeginFrame();
+
+    // state changes made outside a frame are not counted
+    Memory::Clear(this->numIssued, sizeof(this->numIssued));
+    Memory::Clear(this->numFiltered, sizeof(this->numFiltered));
+
     this->inBeginFrame = true;
     return true;
 }
@@ -239,6 +253,9 @@ RenderDeviceBase::BeginPass(const Ptr<RenderTarget>& rt, const Ptr<ShaderInstanc
 
 //------------------------------------------------------------------------------
 /**
+    The batch shader stays active after EndBatch(), so consecutive batches
+    with the same shader only commit the changed shader variables. The
+    shader is ended when a batch uses a different shader or by EndPass().
 */
 void
 RenderDeviceBase::BeginBatch(BatchType::Code batchType, const Ptr<ShaderInstance>& shd)
@@ -252,9 +269,19 @@ RenderDeviceBase::BeginBatch(BatchType::Code batchType, const Ptr<ShaderInstance
 
     // apply batch shader
     this->batchShader = shd;
-    SizeT numPasses = this->batchShader->Begin();
-    s_assert(1 == numPasses);
-    this->batchShader->BeginPass(0);
+    if (this->activeBatchShader != shd)
+    {
+        this->EndActiveBatchShader();
+        SizeT numPasses = shd->Begin();
+        s_assert(1 == numPasses);
+        shd->BeginPass(0);
+        this->activeBatchShader = shd;
+        this->CountStateChange(BatchShaderState, true);
+    }
+    else
+    {
+        this->CountStateChange(BatchShaderState, false);
+    }
     this->batchShader->Commit();
 
     // notify render target
@@ -270,15 +297,25 @@ RenderDeviceBase::EndBatch()
     s_assert(this->inBeginBatch);
     this->inBeginBatch = false;
 
-    // notify render target
+    // notify render target, the batch shader stays active for the next batch
     this->passRenderTarget->EndBatch();
-    
-    // finish batch shader
-    this->batchShader->EndPass();
-    this->batchShader->End();
     this->batchShader = 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+void
+RenderDeviceBase::EndActiveBatchShader()
+{
+    if (this->activeBatchShader.isvalid())
+    {
+        this->activeBatchShader->EndPass();
+        this->activeBatchShader->End();
+        this->activeBatchShader = 0;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -286,8 +323,12 @@ void
 RenderDeviceBase::EndPass()
 {
     s_assert(this->inBeginPass);
+    s_assert(!this->inBeginBatch);
     s_assert(this->passRenderTarget.isvalid());
 
+    // finish the last batch shader
+    this->EndActiveBatchShader();
+
     // finish rendering to render target
     this->passRenderTarget->EndPass();
     this->passRenderTarget = 0;
@@ -313,6 +354,13 @@ RenderDeviceBase::EndFrame()
     this->inBeginFrame = false;
     this->vertexBuffer = 0;
     this->indexBuffer = 0;
+
+    IndexT i;
+    for (i = 0; i < NumStateTypes; i++)
+    {
+        this->lastNumIssued[i] = this->numIssued[i];
+        this->lastNumFiltered[i] = this->numFiltered[i];
+    }
 }
 
 //------------------------------------------------------------------------------
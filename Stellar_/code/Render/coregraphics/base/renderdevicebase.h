@@ -9,6 +9,11 @@
     is basically an encapsulation of the Direct3D device. The render device
     will presents its backbuffer to the display managed by the
     CoreGraphics::DisplayDevice singleton.
+
+    The device keeps a shadow copy of the current state, state changes
+    which would set the same state again are filtered out before they
+    reach the backend. The number of issued and filtered state changes
+    of the last frame can be queried per state type to see the savings.
     
     (C) 2006 Radon Labs GmbH
 */    
@@ -19,6 +24,7 @@
 #include "coregraphics/batchtype.h"
 #include "coregraphics/imagefileformat.h"
 #include "io/stream.h"
+#include "memory/linearheap.h"
 
 namespace CoreGraphics
 {
@@ -41,6 +47,19 @@ public:
     RenderDeviceBase();
     /// destructor
     virtual ~RenderDeviceBase();
+    /// the types of state changes which are counted
+    enum StateType
+    {
+        VertexBufferState = 0,
+        VertexLayoutState,
+        IndexBufferState,
+        BatchShaderState,
+        TextureState,
+        ConstantState,
+
+        NumStateTypes,
+    };
+
     /// test if a compatible render device can be created on this machine
     static bool CanCreate();
 
@@ -86,12 +105,24 @@ public:
     void EndFrame();
     /// check if inside BeginFrame
     bool IsInBeginFrame() const;
+    /// get the heap for data which only lives until the next frame
+    Memory::LinearHeap& GetFrameHeap();
     /// present the rendered scene
     void Present();
     /// save a screenshot to the provided stream
     void SaveScreenshot(CoreGraphics::ImageFileFormat::Code fmt, const Ptr<IO::Stream>& outStream);
 
+    /// count a state change, issued is false if it has been filtered as redundant
+    void CountStateChange(StateType type, bool issued);
+    /// get the number of state changes of a type issued to the backend in the last frame
+    SizeT GetNumIssuedStateChanges(StateType type) const;
+    /// get the number of redundant state changes of a type filtered in the last frame
+    SizeT GetNumFilteredStateChanges(StateType type) const;
+
 protected:
+    /// end the batch shader which is kept active between batches
+    void EndActiveBatchShader();
+
     /// notify event handlers about an event
     //bool NotifyEventHandlers(const CoreGraphics::RenderEvent& e);
     
@@ -100,9 +131,15 @@ protected:
     Ptr<CoreGraphics::VertexBuffer> vertexBuffer;
     Ptr<CoreGraphics::IndexBuffer> indexBuffer;
     CoreGraphics::PrimitiveGroup primitiveGroup;
+    Memory::LinearHeap frameHeap;
     Ptr<CoreGraphics::RenderTarget> passRenderTarget;
     Ptr<CoreGraphics::ShaderInstance> passShader;
     Ptr<CoreGraphics::ShaderInstance> batchShader;
+    Ptr<CoreGraphics::ShaderInstance> activeBatchShader;
+    SizeT numIssued[NumStateTypes];
+    SizeT numFiltered[NumStateTypes];
+    SizeT lastNumIssued[NumStateTypes];
+    SizeT lastNumFiltered[NumStateTypes];
     bool isOpen;
     bool inNotifyEventHandlers;
     bool inBeginFrame;
@@ -147,6 +184,54 @@ RenderDeviceBase::IsInBeginFrame() const
     return this->inBeginFrame;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+RenderDeviceBase::CountStateChange(StateType type, bool issued)
+{
+    s_assert(type < NumStateTypes);
+    if (issued)
+    {
+        this->numIssued[type]++;
+    }
+    else
+    {
+        this->numFiltered[type]++;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+RenderDeviceBase::GetNumIssuedStateChanges(StateType type) const
+{
+    s_assert(type < NumStateTypes);
+    return this->lastNumIssued[type];
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+RenderDeviceBase::GetNumFilteredStateChanges(StateType type) const
+{
+    s_assert(type < NumStateTypes);
+    return this->lastNumFiltered[type];
+}
+
+//------------------------------------------------------------------------------
+/**
+    Memory allocated from the frame heap is released automatically two
+    frames later, by the second BeginFrame() after the allocation.
+*/
+inline Memory::LinearHeap&
+RenderDeviceBase::GetFrameHeap()
+{
+    return this->frameHeap;
+}
+
 } // namespace Base
 //------------------------------------------------------------------------------
 #endif
@@ -16,9 +16,12 @@ using namespace CoreGraphics;
 //------------------------------------------------------------------------------
 /**
 */
-ShaderBase::ShaderBase() 
+ShaderBase::ShaderBase() :
+    isVariationRemapValid(false),
+    usedFeatures(0),
+    numUsedFeatureBits(0)
 {
-    // empty
+    Memory::Clear(this->variationIndexRemap, sizeof(this->variationIndexRemap));
 }
 
 //------------------------------------------------------------------------------
@@ -29,6 +32,16 @@ ShaderBase::~ShaderBase()
     s_assert(0 == this->shaderInstances.size());
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ShaderBase::Unload()
+{
+    this->InvalidateVariationRemap();
+    Resource::Unload();
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -55,4 +68,61 @@ ShaderBase::DiscardShaderInstance(const Ptr<ShaderInstance>& inst)
     this->shaderInstances.erase(itr);
 }
 
+//------------------------------------------------------------------------------
+/**
+    Called by the instances when they set up their variation tables. The
+    first call builds the remap table, later calls must pass the same
+    feature bits. The n-th used feature bit becomes bit n of the table
+    index, every value of a mask byte gets the index bits of its used
+    feature bits.
+*/
+void
+ShaderBase::SetupVariationRemap(ShaderFeature::Mask features)
+{
+    if (this->isVariationRemapValid)
+    {
+        s_assert2(features == this->usedFeatures, "all instances of a shader must use the same feature bits");
+        return;
+    }
+
+    this->usedFeatures = features;
+    this->numUsedFeatureBits = 0;
+    Memory::Clear(this->variationIndexRemap, sizeof(this->variationIndexRemap));
+    IndexT bitIndex;
+    for (bitIndex = 0; bitIndex < NumFeatureMaskBytes * 8; bitIndex++)
+    {
+        if (0 == (this->usedFeatures & (ShaderFeature::Mask(1) << bitIndex)))
+        {
+            continue;
+        }
+        if (this->numUsedFeatureBits < MaxVariationTableBits)
+        {
+            unsigned char* remap = this->variationIndexRemap[bitIndex / 8];
+            const unsigned int byteBit = 1 << (bitIndex % 8);
+            unsigned int value;
+            for (value = 0; value < 256; value++)
+            {
+                if (0 != (value & byteBit))
+                {
+                    remap[value] |= (unsigned char) (1 << this->numUsedFeatureBits);
+                }
+            }
+        }
+        this->numUsedFeatureBits++;
+    }
+    this->isVariationRemapValid = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ShaderBase::InvalidateVariationRemap()
+{
+    this->isVariationRemapValid = false;
+    this->usedFeatures = 0;
+    this->numUsedFeatureBits = 0;
+    Memory::Clear(this->variationIndexRemap, sizeof(this->variationIndexRemap));
+}
+
 } // namespace Base
\ No newline at end of file
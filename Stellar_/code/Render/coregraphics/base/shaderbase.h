@@ -9,10 +9,17 @@
     geometry. Shader objects are not used for rendering directly,
     instead ShaderInstances are created from a shader.
 
+    All instances of a shader have the same variations, so the remap
+    table which packs the used feature bits of a feature mask into a
+    variation table index is kept here and shared by the instances. Only
+    the variation tables themselves belong to the instances. The first
+    instance builds the remap table, see ShaderInstanceBase.
+
 	͹ShaderInstance
     (C) 2007 by ctuo
 */    
 #include "resources/resource.h"
+#include "coregraphics/shaderfeature.h"
 
 namespace CoreGraphics
 {
@@ -36,9 +43,34 @@ public:
     void DiscardShaderInstance(const Ptr<CoreGraphics::ShaderInstance>& inst);
     /// get all instances
     const Util::Array<Ptr<CoreGraphics::ShaderInstance>>& GetAllShaderInstances() const;
+    /// unload the resource, forgets the variation remap table
+    virtual void Unload();
+
+    /// get all feature bits used by the variations
+    CoreGraphics::ShaderFeature::Mask GetUsedFeatures() const;
+    /// get number of feature bits used by the variations
+    SizeT GetNumUsedFeatureBits() const;
+    /// get the variation table index of a feature mask
+    IndexT GetVariationTableIndex(CoreGraphics::ShaderFeature::Mask featureMask) const;
+
+    /// max number of feature bits covered by the variation table, the table index fits into a byte
+    static const SizeT MaxVariationTableBits = 8;
+    /// number of bytes of a feature mask
+    static const SizeT NumFeatureMaskBytes = sizeof(CoreGraphics::ShaderFeature::Mask);
 
 protected:
+    friend class ShaderInstanceBase;
+
+    /// build the variation remap table for the feature bits used by the variations
+    void SetupVariationRemap(CoreGraphics::ShaderFeature::Mask usedFeatures);
+    /// forget the variation remap table, the instances must set up their variation tables again
+    void InvalidateVariationRemap();
+
     Util::Array<Ptr<CoreGraphics::ShaderInstance>> shaderInstances;
+    bool isVariationRemapValid;
+    CoreGraphics::ShaderFeature::Mask usedFeatures;                     // all feature bits used by the variations
+    SizeT numUsedFeatureBits;
+    unsigned char variationIndexRemap[NumFeatureMaskBytes][256];        // table index bits of each byte value of a feature mask
 };
 
 //------------------------------------------------------------------------------
@@ -50,6 +82,40 @@ ShaderBase::GetAllShaderInstances() const
     return this->shaderInstances;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline CoreGraphics::ShaderFeature::Mask
+ShaderBase::GetUsedFeatures() const
+{
+    return this->usedFeatures;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+ShaderBase::GetNumUsedFeatureBits() const
+{
+    return this->numUsedFeatureBits;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Packs the used feature bits of the mask into the low bits of the index.
+*/
+inline IndexT
+ShaderBase::GetVariationTableIndex(CoreGraphics::ShaderFeature::Mask featureMask) const
+{
+    IndexT tableIndex = 0;
+    IndexT byteIndex;
+    for (byteIndex = 0; byteIndex < NumFeatureMaskBytes; byteIndex++)
+    {
+        tableIndex |= this->variationIndexRemap[byteIndex][(featureMask >> (byteIndex * 8)) & 0xff];
+    }
+    return tableIndex;
+}
+
 } // namespace Base
 //------------------------------------------------------------------------------
 #endif
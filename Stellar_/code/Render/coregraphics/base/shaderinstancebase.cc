@@ -31,10 +31,10 @@ ShaderInstanceBase::~ShaderInstanceBase()
 {
     // check if Discard() has been called...
     s_assert(!this->IsValid());
-    s_assert(this->variables.size() > 0);
-    s_assert(this->variablesByName.Size() > 0);
-    s_assert(this->variablesBySemantic.Size() > 0);
-    s_assert(this->variations.Size() > 0);    
+    s_assert(this->variables.empty());
+    s_assert(this->variablesByName.IsEmpty());
+    s_assert(this->variablesBySemantic.IsEmpty());
+    s_assert(this->variations.IsEmpty());    
     s_assert(!this->activeVariation.isvalid());
     //s_assert(this->preShaders.IsEmpty());
 }
@@ -87,6 +87,7 @@ ShaderInstanceBase::Cleanup()
     this->variablesByName.Clear();
     this->variablesBySemantic.Clear();
     this->variations.Clear();
+    this->variationTable.Clear();
     this->activeVariation = 0;
     /*IndexT i;
     for (i = 0; i < this->preShaders.Size(); i++)
@@ -96,6 +97,61 @@ ShaderInstanceBase::Cleanup()
     //this->preShaders.clear();
 }
 
+//------------------------------------------------------------------------------
+/**
+    Subclasses call this at the end of Setup(). The table has an entry for
+    every combination of the feature bits used by the variations, entries
+    without a variation are 0. The original shader builds the remap table
+    for these bits when its first instance is set up. Shaders which use
+    more than MaxVariationTableBits feature bits don't get a table and
+    fall back to the variation dictionary.
+*/
+void
+ShaderInstanceBase::SetupVariationTable()
+{
+    s_assert(this->variations.Size() > 0);
+    ShaderFeature::Mask usedFeatures = 0;
+    IndexT i;
+    for (i = 0; i < this->variations.Size(); i++)
+    {
+        usedFeatures |= this->variations.KeyAtIndex(i);
+    }
+    ShaderBase* shader = this->originalShader.get();
+    shader->SetupVariationRemap(usedFeatures);
+
+    this->variationTable.Clear();
+    if (shader->GetNumUsedFeatureBits() <= ShaderBase::MaxVariationTableBits)
+    {
+        this->variationTable.resize(1 << shader->GetNumUsedFeatureBits(), 0);
+        for (i = 0; i < this->variations.Size(); i++)
+        {
+            IndexT tableIndex = shader->GetVariationTableIndex(this->variations.KeyAtIndex(i));
+            this->variationTable[tableIndex] = this->variations.ValueAtIndex(i).get();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Only reads the lookup tables, so it may be called from any thread.
+*/
+ShaderVariation*
+ShaderInstanceBase::LookupVariation(ShaderFeature::Mask featureMask) const
+{
+    const ShaderBase* shader = this->originalShader.get();
+    if (0 != (featureMask & ~shader->GetUsedFeatures()))
+    {
+        // no variation uses these feature bits
+        return 0;
+    }
+    if (this->variationTable.IsEmpty())
+    {
+        IndexT i = this->variations.FindIndex(featureMask);
+        return (InvalidIndex != i) ? this->variations.ValueAtIndex(i).get() : 0;
+    }
+    return this->variationTable[shader->GetVariationTableIndex(featureMask)];
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -184,40 +240,35 @@ ShaderInstanceBase::End()
 bool
 ShaderInstanceBase::SelectActiveVariation(CoreGraphics::ShaderFeature::Mask featureMask)
 {
-	if (this->variations.Contains(featureMask))
-	{
-		const Ptr<ShaderVariation>& shdVar = this->variations[featureMask];
-		if (shdVar != this->activeVariation)
-		{
-			this->activeVariation = shdVar;
-			return true;
-		}
-	}
-	else
-	{
-		s_error("Unknown shader variation '%s' in shader '%s'\n",
-			ShaderServer::Instance()->FeatureMaskToString(featureMask).c_str(),
-			this->originalShader->GetResourceId().Value().c_str());
-	}
-	return false;
-
-    /*IndexT i = this->variations.FindIndex(featureMask);
-    if (InvalidIndex != i)
+    // the same mask as last time?
+    if (this->activeVariation.isvalid() && (featureMask == this->activeVariation->GetFeatureMask()))
     {
-        const Ptr<ShaderVariation>& shdVar = this->variations.ValueAtIndex(i);
-        if (shdVar != this->activeVariation)
-        {
-            this->activeVariation = shdVar;
-            return true;
-        }
+        return false;
     }
-    else
+    ShaderVariation* shdVar = this->LookupVariation(featureMask);
+    if (0 == shdVar)
     {
         s_error("Unknown shader variation '%s' in shader '%s'\n",
             ShaderServer::Instance()->FeatureMaskToString(featureMask).c_str(),
             this->originalShader->GetResourceId().Value().c_str());
+        return false;
+    }
+    return this->SetActiveVariation(shdVar);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+ShaderInstanceBase::SetActiveVariation(ShaderVariation* shdVar)
+{
+    s_assert(0 != shdVar);
+    if (this->activeVariation != shdVar)
+    {
+        this->activeVariation = shdVar;
+        return true;
     }
-    return false;*/
+    return false;
 }
 
 } // namespace Base
\ No newline at end of file
@@ -9,6 +9,15 @@
     of the original shader state which can be modified through ShaderVariable
     objects. Shader instance objects are created directly through the 
     shader server.
+
+    Variations are looked up through a table which is directly indexed
+    by the feature bits the variations of this shader actually use, so
+    selecting a variation by feature mask doesn't search the variation
+    dictionary. The used bits are packed into the table index through a
+    remap table per byte of the feature mask, so building the index
+    costs four table reads, no matter which bits are used. The remap
+    table is shared by all instances and lives in the original shader,
+    only the table of variations belongs to the instance.
     
     (C) 2007 by ctuo
 */
@@ -65,8 +74,12 @@ public:
     const Ptr<CoreGraphics::ShaderVariation>& GetVariationByIndex(IndexT i) const;
     /// get shader variation by feature mask
     const Ptr<CoreGraphics::ShaderVariation>& GetVariationByFeatureMask(CoreGraphics::ShaderFeature::Mask featureMask) const;
+    /// find shader variation by feature mask through the lookup table, returns 0 if not found
+    CoreGraphics::ShaderVariation* LookupVariation(CoreGraphics::ShaderFeature::Mask featureMask) const;
     /// select active variation by feature mask, return true if active variation has been changed
     bool SelectActiveVariation(CoreGraphics::ShaderFeature::Mask featureMask);
+    /// set active variation from LookupVariation(), return true if active variation has been changed
+    bool SetActiveVariation(CoreGraphics::ShaderVariation* variation);
     /// get currently active variation
     const Ptr<CoreGraphics::ShaderVariation>& GetActiveVariation() const;
 
@@ -95,6 +108,8 @@ protected:
     void Setup(const Ptr<CoreGraphics::Shader>& origShader);
     /// cleanup the shader instance
     void Cleanup();
+    /// build the variation lookup table, call after all variations have been added
+    void SetupVariationTable();
 
     bool inBegin;
     bool inBeginPass;
@@ -103,6 +118,7 @@ protected:
     Util::Dictionary<CoreGraphics::ShaderVariable::Name, Ptr<CoreGraphics::ShaderVariable>> variablesByName;
     Util::Dictionary<CoreGraphics::ShaderVariable::Semantic, Ptr<CoreGraphics::ShaderVariable>> variablesBySemantic;
     Util::Dictionary<CoreGraphics::ShaderFeature::Mask, Ptr<CoreGraphics::ShaderVariation>> variations;
+    Util::Array<CoreGraphics::ShaderVariation*> variationTable;         // empty if too many feature bits are used
     //Util::Array<Ptr<CoreGraphics::PreShader> > preShaders;
     Ptr<CoreGraphics::ShaderVariation> activeVariation;
 };
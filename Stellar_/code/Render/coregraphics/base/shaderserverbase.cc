@@ -48,6 +48,8 @@ ShaderServerBase::Open()
 
     // load all shaders from disk
     Array<String> files = IoServer::Instance()->ListFiles("shd:", "*");
+    this->shaders.Reserve(files.Size());
+    this->shaders.BeginBulkAdd();
     IndexT i;
     for (i = 0; i < files.Size(); i++)
     {
@@ -67,6 +69,7 @@ ShaderServerBase::Open()
             s_error("Failed to load shader '%s'!", files[i].c_str());
         }
     }
+    this->shaders.EndBulkAdd();
     this->isOpen = true;
     return true;
 }
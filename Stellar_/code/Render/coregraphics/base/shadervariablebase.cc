@@ -5,6 +5,8 @@
 #include "stdneb.h"
 #include "coregraphics/shadervariable.h"
 #include "coregraphics/shadervariableinstance.h"
+#include "coregraphics/texture.h"
+#include "coregraphics/renderdevice.h"
 
 namespace Base
 {
@@ -19,7 +21,11 @@ using namespace Util;
 */
 ShaderVariableBase::ShaderVariableBase() :
     type(UnknownType),
-    numArrayElements(0)
+    numArrayElements(0),
+    shadowBuffer(0),
+    shadowElementSize(0),
+    numShadowElements(0),
+    isShadowed(true)
 {
     // empty
 }
@@ -29,7 +35,128 @@ ShaderVariableBase::ShaderVariableBase() :
 */
 ShaderVariableBase::~ShaderVariableBase()
 {
-    // empty
+    if (0 != this->shadowBuffer)
+    {
+        Memory::Free(this->shadowBuffer);
+        this->shadowBuffer = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ShaderVariableBase::InvalidateShadow()
+{
+    this->numShadowElements = 0;
+    this->shadowTexture = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Compares the new values with the shadow copy. If some of them
+    differ, the shadow copy is updated and the range from the first to
+    the last changed element is returned, so the backend only needs to
+    upload that range. Elements which have never been set count as
+    changed, and so do all values of a variable which isn't shadowed.
+*/
+bool
+ShaderVariableBase::UpdateShadow(const void* values, SizeT elementSize, SizeT count, IndexT& outFirstDirty, SizeT& outNumDirty)
+{
+    s_assert(0 != values);
+    s_assert(elementSize > 0);
+    outFirstDirty = 0;
+    outNumDirty = count;
+    if (!this->isShadowed)
+    {
+        if (RenderDevice::HasInstance())
+        {
+            RenderDevice::Instance()->CountStateChange(RenderDevice::ConstantState, true);
+        }
+        return true;
+    }
+
+    // the shadow buffer is allocated by the first value
+    SizeT capacity = (this->numArrayElements > 0) ? this->numArrayElements : 1;
+    if (elementSize != this->shadowElementSize)
+    {
+        if (0 != this->shadowBuffer)
+        {
+            Memory::Free(this->shadowBuffer);
+        }
+        this->shadowBuffer = Memory::Alloc(elementSize * capacity);
+        this->shadowElementSize = elementSize;
+        this->numShadowElements = 0;
+    }
+
+    bool issued = true;
+    if (count > capacity)
+    {
+        // can't be shadowed, always pass it through
+        this->numShadowElements = 0;
+    }
+    else
+    {
+        const unsigned char* src = (const unsigned char*) values;
+        unsigned char* dst = (unsigned char*) this->shadowBuffer;
+        SizeT numValid = (count < this->numShadowElements) ? count : this->numShadowElements;
+
+        // find the first and the last changed element
+        IndexT first = 0;
+        while ((first < numValid) && (0 == memcmp(src + first * elementSize, dst + first * elementSize, elementSize)))
+        {
+            first++;
+        }
+        IndexT end = count;
+        if (numValid == count)
+        {
+            while ((end > first) && (0 == memcmp(src + (end - 1) * elementSize, dst + (end - 1) * elementSize, elementSize)))
+            {
+                end--;
+            }
+        }
+
+        if (first == end)
+        {
+            issued = false;
+        }
+        else
+        {
+            Memory::Copy(src + first * elementSize, dst + first * elementSize, (end - first) * elementSize);
+            if (end > this->numShadowElements)
+            {
+                this->numShadowElements = end;
+            }
+            outFirstDirty = first;
+            outNumDirty = end - first;
+        }
+    }
+
+    if (RenderDevice::HasInstance())
+    {
+        RenderDevice::Instance()->CountStateChange(RenderDevice::ConstantState, issued);
+    }
+    return issued;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The shadow texture keeps the texture alive, so a new texture can't
+    get the address of the old one and be filtered by mistake.
+*/
+bool
+ShaderVariableBase::UpdateShadowTexture(const Ptr<Texture>& value)
+{
+    bool issued = (!this->isShadowed) || (this->shadowTexture != value);
+    if (issued && this->isShadowed)
+    {
+        this->shadowTexture = value;
+    }
+    if (RenderDevice::HasInstance())
+    {
+        RenderDevice::Instance()->CountStateChange(RenderDevice::TextureState, issued);
+    }
+    return issued;
 }
 
 //------------------------------------------------------------------------------
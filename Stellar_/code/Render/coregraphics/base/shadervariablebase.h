@@ -9,6 +9,14 @@
     The fastest way to change the value of a shader variable is to
     obtain a pointer to a shader variable once, and use it repeatedly
     to set new values.
+
+    Backends keep a shadow copy of the last value through UpdateShadow()
+    and UpdateShadowTexture(), so setting the value a variable already
+    has doesn't reach the shader, and only the changed range of an array
+    is uploaded. Parameters which can also be changed through the
+    variables of other shader instances (e.g. D3DX parameters shared
+    through the effect pool) must not be shadowed, backends turn the
+    shadow off for them with SetShadowed(false).
     
     (C) 2006 Radon Labs GmbH
 */
@@ -95,7 +103,18 @@ public:
     /// set texture value
     void SetTexture(const Ptr<CoreGraphics::Texture>& value);
 
+    /// forget the shadow copy, the next value is always passed to the shader
+    void InvalidateShadow();
+    /// return true if values are compared with a shadow copy before they are passed to the shader
+    bool IsShadowed() const;
+
 protected:
+    /// enable or disable the shadow copy, enabled by default
+    void SetShadowed(bool b);
+    /// compare values with the shadow copy and update it, returns false if nothing changed
+    bool UpdateShadow(const void* values, SizeT elementSize, SizeT count, IndexT& outFirstDirty, SizeT& outNumDirty);
+    /// compare a texture with the shadow texture and update it, returns false if nothing changed
+    bool UpdateShadowTexture(const Ptr<CoreGraphics::Texture>& value);
     /// set variable type
     void SetType(Type t);
     /// set variable name
@@ -109,6 +128,11 @@ protected:
     Name name;
     Semantic semantic;
     SizeT numArrayElements;
+    void* shadowBuffer;
+    SizeT shadowElementSize;
+    SizeT numShadowElements;        // elements of the shadow buffer which hold a value
+    Ptr<CoreGraphics::Texture> shadowTexture;
+    bool isShadowed;
 };
 
 //------------------------------------------------------------------------------
@@ -192,6 +216,25 @@ ShaderVariableBase::IsArray() const
     return this->numArrayElements > 1;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+ShaderVariableBase::SetShadowed(bool b)
+{
+    this->isShadowed = b;
+    this->InvalidateShadow();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+ShaderVariableBase::IsShadowed() const
+{
+    return this->isShadowed;
+}
+
 } // Base
 //------------------------------------------------------------------------------
 #endif    
\ No newline at end of file
@@ -67,7 +67,7 @@ VertexBufferBase::Unmap()
 //------------------------------------------------------------------------------
 /**
 */
-inline SizeT
+SizeT
 VertexBufferBase::GetNumVertices() const
 {
 	return this->numVertices;
@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------------
+//  commandlist.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/commandlist.h"
+#include "coregraphics/renderdevice.h"
+#include "coregraphics/shaderinstance.h"
+#include "coregraphics/shadervariableinstance.h"
+#include "coregraphics/vertexbuffer.h"
+#include "coregraphics/indexbuffer.h"
+
+namespace CoreGraphics
+{
+
+namespace
+{
+/// command codes
+enum Code
+{
+    ApplyVariableCode,
+    BeginBatchCode,
+    EndBatchCode,
+    BeginShaderCode,
+    EndShaderCode,
+    SetVertexBufferCode,
+    SetIndexBufferCode,
+    DrawCode,
+};
+
+/// the header of every command
+struct Header
+{
+    unsigned short code;
+    unsigned short size;        // size of the command including the header
+};
+
+struct ApplyVariableCmd
+{
+    Header header;
+    ShaderVariableInstance* var;
+};
+
+struct BeginBatchCmd
+{
+    Header header;
+    BatchType::Code batchType;
+    ShaderInstance* shader;
+};
+
+struct EndBatchCmd
+{
+    Header header;
+};
+
+struct BeginShaderCmd
+{
+    Header header;
+    IndexT pass;
+    ShaderInstance* shader;
+    ShaderVariation* variation;
+};
+
+struct EndShaderCmd
+{
+    Header header;
+    ShaderInstance* shader;
+};
+
+struct SetVertexBufferCmd
+{
+    Header header;
+    VertexBuffer* vertexBuffer;
+};
+
+struct SetIndexBufferCmd
+{
+    Header header;
+    IndexBuffer* indexBuffer;
+};
+
+struct DrawCmd
+{
+    Header header;
+    PrimitiveTopology::Code topology;
+    IndexT baseVertex;
+    SizeT numVertices;
+    IndexT baseIndex;
+    SizeT numIndices;
+    ShaderInstance* shader;
+};
+
+/// all commands start at a multiple of this
+const SizeT CommandAlignment = sizeof(void*);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+CommandList::CommandList() :
+    buffer(0),
+    capacity(0),
+    size(0),
+    numCommands(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+CommandList::~CommandList()
+{
+    if (0 != this->buffer)
+    {
+        Memory::Free(this->buffer);
+        this->buffer = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::Reset()
+{
+    this->size = 0;
+    this->numCommands = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The buffer grows by doubling, commands are aligned, so they can be
+    read in place by Execute().
+*/
+void*
+CommandList::Append(unsigned short code, SizeT cmdSize)
+{
+    cmdSize = (cmdSize + CommandAlignment - 1) & ~(CommandAlignment - 1);
+    if (this->size + cmdSize > this->capacity)
+    {
+        SizeT newCapacity = (this->capacity > 0) ? (this->capacity * 2) : 1024;
+        while (newCapacity < this->size + cmdSize)
+        {
+            newCapacity *= 2;
+        }
+        char* newBuffer = (char*) Memory::Alloc(newCapacity);
+        if (0 != this->buffer)
+        {
+            Memory::Copy(this->buffer, newBuffer, this->size);
+            Memory::Free(this->buffer);
+        }
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+    }
+    Header* header = (Header*) (this->buffer + this->size);
+    header->code = code;
+    header->size = (unsigned short) cmdSize;
+    this->size += cmdSize;
+    this->numCommands++;
+    return header;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::ApplyVariable(ShaderVariableInstance* var)
+{
+    s_assert(0 != var);
+    ApplyVariableCmd* cmd = (ApplyVariableCmd*) this->Append(ApplyVariableCode, sizeof(ApplyVariableCmd));
+    cmd->var = var;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::BeginBatch(BatchType::Code batchType, ShaderInstance* shader)
+{
+    s_assert(0 != shader);
+    BeginBatchCmd* cmd = (BeginBatchCmd*) this->Append(BeginBatchCode, sizeof(BeginBatchCmd));
+    cmd->batchType = batchType;
+    cmd->shader = shader;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::EndBatch()
+{
+    this->Append(EndBatchCode, sizeof(EndBatchCmd));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::BeginShader(ShaderInstance* shader, ShaderVariation* variation, IndexT pass)
+{
+    s_assert(0 != shader);
+    s_assert(0 != variation);
+    BeginShaderCmd* cmd = (BeginShaderCmd*) this->Append(BeginShaderCode, sizeof(BeginShaderCmd));
+    cmd->pass = pass;
+    cmd->shader = shader;
+    cmd->variation = variation;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::EndShader(ShaderInstance* shader)
+{
+    s_assert(0 != shader);
+    EndShaderCmd* cmd = (EndShaderCmd*) this->Append(EndShaderCode, sizeof(EndShaderCmd));
+    cmd->shader = shader;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::SetVertexBuffer(VertexBuffer* vb)
+{
+    s_assert(0 != vb);
+    SetVertexBufferCmd* cmd = (SetVertexBufferCmd*) this->Append(SetVertexBufferCode, sizeof(SetVertexBufferCmd));
+    cmd->vertexBuffer = vb;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::SetIndexBuffer(IndexBuffer* ib)
+{
+    s_assert(0 != ib);
+    SetIndexBufferCmd* cmd = (SetIndexBufferCmd*) this->Append(SetIndexBufferCode, sizeof(SetIndexBufferCmd));
+    cmd->indexBuffer = ib;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::Draw(ShaderInstance* shader, const PrimitiveGroup& primGroup)
+{
+    s_assert(0 != shader);
+    DrawCmd* cmd = (DrawCmd*) this->Append(DrawCode, sizeof(DrawCmd));
+    cmd->topology = primGroup.GetPrimitiveTopology();
+    cmd->baseVertex = primGroup.GetBaseVertex();
+    cmd->numVertices = primGroup.GetNumVertices();
+    cmd->baseIndex = primGroup.GetBaseIndex();
+    cmd->numIndices = primGroup.GetNumIndices();
+    cmd->shader = shader;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+CommandList::Execute() const
+{
+    RenderDevice* renderDevice = RenderDevice::Instance();
+    const char* ptr = this->buffer;
+    const char* end = this->buffer + this->size;
+    while (ptr < end)
+    {
+        const Header* header = (const Header*) ptr;
+        switch (header->code)
+        {
+            case ApplyVariableCode:
+                ((const ApplyVariableCmd*) ptr)->var->Apply();
+                break;
+
+            case BeginBatchCode:
+                {
+                    const BeginBatchCmd* cmd = (const BeginBatchCmd*) ptr;
+                    renderDevice->BeginBatch(cmd->batchType, cmd->shader);
+                }
+                break;
+
+            case EndBatchCode:
+                renderDevice->EndBatch();
+                break;
+
+            case BeginShaderCode:
+                {
+                    const BeginShaderCmd* cmd = (const BeginShaderCmd*) ptr;
+                    cmd->shader->SetActiveVariation(cmd->variation);
+                    SizeT numPasses = cmd->shader->Begin();
+                    s_assert(cmd->pass < numPasses);
+                    cmd->shader->BeginPass(cmd->pass);
+                }
+                break;
+
+            case EndShaderCode:
+                {
+                    const EndShaderCmd* cmd = (const EndShaderCmd*) ptr;
+                    cmd->shader->EndPass();
+                    cmd->shader->End();
+                }
+                break;
+
+            case SetVertexBufferCode:
+                renderDevice->SetVertexBuffer(((const SetVertexBufferCmd*) ptr)->vertexBuffer);
+                break;
+
+            case SetIndexBufferCode:
+                renderDevice->SetIndexBuffer(((const SetIndexBufferCmd*) ptr)->indexBuffer);
+                break;
+
+            case DrawCode:
+                {
+                    const DrawCmd* cmd = (const DrawCmd*) ptr;
+                    PrimitiveGroup primGroup;
+                    primGroup.SetPrimitiveTopology(cmd->topology);
+                    primGroup.SetBaseVertex(cmd->baseVertex);
+                    primGroup.SetNumVertices(cmd->numVertices);
+                    primGroup.SetBaseIndex(cmd->baseIndex);
+                    primGroup.SetNumIndices(cmd->numIndices);
+                    renderDevice->SetPrimitiveGroup(primGroup);
+                    cmd->shader->Commit();
+                    renderDevice->Draw();
+                }
+                break;
+
+            default:
+                s_error("CommandList::Execute(): invalid command code %d!", header->code);
+                return;
+        }
+        ptr += header->size;
+    }
+}
+
+} // namespace CoreGraphics
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef COREGRAPHICS_COMMANDLIST_H
+#define COREGRAPHICS_COMMANDLIST_H
+//------------------------------------------------------------------------------
+/**
+    @class CoreGraphics::CommandList
+
+    Records rendering commands into a linear buffer instead of sending
+    them to the RenderDevice, so the CPU work of building them can be
+    done on any thread. Execute() replays the commands on the render
+    device and must be called from the render thread.
+
+    The commands are small POD structs which refer to the objects they
+    use by plain pointers, the objects must stay alive until the list
+    has been executed. Recording doesn't touch the render device or the
+    objects, so several threads can record into different lists at the
+    same time. The buffer is kept by Reset(), so a list which is recorded
+    every frame doesn't allocate memory after a few frames.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "coregraphics/batchtype.h"
+#include "coregraphics/primitivegroup.h"
+
+//------------------------------------------------------------------------------
+namespace CoreGraphics
+{
+class ShaderInstance;
+class ShaderVariableInstance;
+class ShaderVariation;
+class VertexBuffer;
+class IndexBuffer;
+
+class CommandList
+{
+public:
+    /// constructor
+    CommandList();
+    /// destructor
+    ~CommandList();
+
+    /// remove all commands, keeps the buffer
+    void Reset();
+    /// return true if no commands have been recorded
+    bool IsEmpty() const;
+    /// get number of recorded commands
+    SizeT GetNumCommands() const;
+    /// get number of bytes used by the recorded commands
+    SizeT GetByteSize() const;
+
+    /// record applying the value of a shader variable instance
+    void ApplyVariable(ShaderVariableInstance* var);
+    /// record RenderDevice::BeginBatch()
+    void BeginBatch(BatchType::Code batchType, ShaderInstance* shader);
+    /// record RenderDevice::EndBatch()
+    void EndBatch();
+    /// record selecting a shader variation and beginning one of its passes
+    void BeginShader(ShaderInstance* shader, ShaderVariation* variation, IndexT pass);
+    /// record ending the pass begun by BeginShader()
+    void EndShader(ShaderInstance* shader);
+    /// record RenderDevice::SetVertexBuffer()
+    void SetVertexBuffer(VertexBuffer* vb);
+    /// record RenderDevice::SetIndexBuffer()
+    void SetIndexBuffer(IndexBuffer* ib);
+    /// record committing the shader and drawing a primitive group
+    void Draw(ShaderInstance* shader, const PrimitiveGroup& primGroup);
+
+    /// replay the commands on the render device (render thread only)
+    void Execute() const;
+
+private:
+    /// copying not allowed
+    CommandList(const CommandList&);
+    /// assignment not allowed
+    void operator=(const CommandList&);
+    /// reserve room for a command at the end of the buffer
+    void* Append(unsigned short code, SizeT size);
+
+    char* buffer;
+    SizeT capacity;
+    SizeT size;
+    SizeT numCommands;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+CommandList::IsEmpty() const
+{
+    return 0 == this->numCommands;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+CommandList::GetNumCommands() const
+{
+    return this->numCommands;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+CommandList::GetByteSize() const
+{
+    return this->size;
+}
+
+} // namespace CoreGraphics
+//------------------------------------------------------------------------------
+#endif
@@ -12,7 +12,21 @@
 #include "core/types.h"
 
 //------------------------------------------------------------------------------
+/// the null renderer counts the rendering commands instead of executing them,
+/// it is used on platforms without Direct3D, e.g. for headless benchmarks;
+/// define NEBULA3_USENULLRENDERER=1 in the project to select it on Win32
+#ifndef NEBULA3_USENULLRENDERER
+#if __WIN32__
+#define NEBULA3_USENULLRENDERER (0)
+#else
+#define NEBULA3_USENULLRENDERER (1)
+#endif
+#endif
+#if NEBULA3_USENULLRENDERER
+#define NEBULA3_USEDIRECT3D9 (0)
+#else
 #define NEBULA3_USEDIRECT3D9 (1)
+#endif
 #define NEBULA3_USEDIRECT3D10 (0)
 
 #define NEBULA3_DIRECT3D_USENVPERFHUD (0)
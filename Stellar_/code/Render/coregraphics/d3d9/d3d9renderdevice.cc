@@ -28,7 +28,8 @@ D3D9RenderDevice::D3D9RenderDevice() :
     d3d9Device(0),
     adapter(0),
     displayFormat(D3DFMT_X8R8G8B8),
-    deviceBehaviourFlags(0)
+    deviceBehaviourFlags(0),
+    curVertexDecl(0)
 {
     ConstructSingleton;
     Memory::Clear(&this->presentParams, sizeof(this->presentParams));
@@ -319,6 +320,9 @@ D3D9RenderDevice::SetInitialDeviceState()
 {
     s_assert(this->d3d9Device);
 
+    // a new or reset device has no vertex declaration
+    this->curVertexDecl = 0;
+
     this->d3d9Device->SetRenderState(D3DRS_DITHERENABLE, TRUE);
     this->d3d9Device->SetRenderState(D3DRS_LIGHTING, FALSE);
 
@@ -404,6 +408,7 @@ D3D9RenderDevice::CloseDirect3DDevice()
     this->d3d9Device->SetDepthStencilSurface(NULL);
     this->d3d9Device->Release();
     this->d3d9Device = 0;
+    this->curVertexDecl = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -520,7 +525,9 @@ D3D9RenderDevice::Present()
 
 //------------------------------------------------------------------------------
 /**
-    Sets the vertex buffer to use for the next Draw().
+    Sets the vertex buffer to use for the next Draw(). Vertex buffers
+    with the same vertex layout share the vertex declaration, so it is
+    only set when the declaration changes.
 */
 void
 D3D9RenderDevice::SetVertexBuffer(const Ptr<VertexBuffer>& vb)
@@ -541,8 +548,17 @@ D3D9RenderDevice::SetVertexBuffer(const Ptr<VertexBuffer>& vb)
 
         // set vertex declaration
         IDirect3DVertexDeclaration9* d3d9VertexDecl = vertexLayout->GetD3D9VertexDeclaration();
-        hr = this->d3d9Device->SetVertexDeclaration(d3d9VertexDecl);
-        s_assert(SUCCEEDED(hr));
+        if (this->curVertexDecl != d3d9VertexDecl)
+        {
+            hr = this->d3d9Device->SetVertexDeclaration(d3d9VertexDecl);
+            s_assert(SUCCEEDED(hr));
+            this->curVertexDecl = d3d9VertexDecl;
+            this->CountStateChange(VertexLayoutState, true);
+        }
+        else
+        {
+            this->CountStateChange(VertexLayoutState, false);
+        }
     }
     RenderDeviceBase::SetVertexBuffer(vb);
 }
@@ -82,6 +82,7 @@ private:
     UINT adapter;
     D3DFORMAT displayFormat;
     DWORD deviceBehaviourFlags;
+    IDirect3DVertexDeclaration9* curVertexDecl;     // shadow of the current vertex declaration
 };
 
 } // namespace Direct3D9
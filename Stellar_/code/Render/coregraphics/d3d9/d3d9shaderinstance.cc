@@ -80,6 +80,7 @@ D3D9ShaderInstance::Setup(const Ptr<Shader>& origShader)
         this->variations.Add(shaderVariation->GetFeatureMask(), shaderVariation);
     }
     s_assert(this->variations.Size() > 0);
+    this->SetupVariationTable();
 
     // select a proper default active variation
     this->SelectActiveVariation(this->variations.KeyAtIndex(0));
@@ -113,6 +114,22 @@ D3D9ShaderInstance::SelectActiveVariation(ShaderFeature::Mask featureMask)
     return false;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+D3D9ShaderInstance::SetActiveVariation(ShaderVariation* variation)
+{
+    if (ShaderInstanceBase::SetActiveVariation(variation))
+    {
+        D3DXHANDLE d3d9Technique = this->activeVariation->GetD3D9Technique();
+        HRESULT hr = this->d3d9Effect->SetTechnique(d3d9Technique);
+        s_assert(SUCCEEDED(hr));
+        return true;
+    }
+    return false;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -35,6 +35,8 @@ public:
 
     /// select active variation by feature mask
     bool SelectActiveVariation(CoreGraphics::ShaderFeature::Mask featureMask);
+    /// set active variation from LookupVariation()
+    bool SetActiveVariation(CoreGraphics::ShaderVariation* variation);
     /// begin rendering through the currently selected variation, returns no. passes
     SizeT Begin();
     /// begin pass
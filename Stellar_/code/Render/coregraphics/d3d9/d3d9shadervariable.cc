@@ -51,6 +51,11 @@ D3D9ShaderVariable::Setup(ID3DXEffect* effect, D3DXHANDLE handle)
     this->SetSemantic(Semantic(desc.Semantic));
     this->SetNumArrayElements(desc.Elements);
 
+    // shared parameters live in the effect pool and can be set through
+    // the variables of every shader instance, so a shadow copy per
+    // variable would filter values which aren't in the pool any more
+    this->SetShadowed(0 == (desc.Flags & D3DX_PARAMETER_SHARED));
+
     // crack the data type
     switch (desc.Class)
     {
@@ -49,6 +49,9 @@ public:
 
 private:
     friend class D3D9ShaderInstance;
+
+    /// dirty ranges up to this size are set element by element, longer ones with one array call
+    static const SizeT MaxNumElementUploads = 4;
     
     /// setup from D3DX effect and parameter handle
     void Setup(ID3DXEffect* effect, D3DXHANDLE handle);
@@ -63,7 +66,12 @@ private:
 inline void
 D3D9ShaderVariable::SetInt(int value)
 {
-    this->d3d9Effect->SetInt(this->hParam, value);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(&value, sizeof(int), 1, first, num))
+    {
+        this->d3d9Effect->SetInt(this->hParam, value);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -72,7 +80,12 @@ D3D9ShaderVariable::SetInt(int value)
 inline void
 D3D9ShaderVariable::SetIntArray(const int* values, SizeT count)
 {
-    this->d3d9Effect->SetIntArray(this->hParam, values, count);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(values, sizeof(int), count, first, num))
+    {
+        this->d3d9Effect->SetIntArray(this->hParam, values, count);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -81,7 +94,12 @@ D3D9ShaderVariable::SetIntArray(const int* values, SizeT count)
 inline void
 D3D9ShaderVariable::SetFloat(float value)
 {
-    this->d3d9Effect->SetFloat(this->hParam, value);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(&value, sizeof(float), 1, first, num))
+    {
+        this->d3d9Effect->SetFloat(this->hParam, value);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -90,7 +108,12 @@ D3D9ShaderVariable::SetFloat(float value)
 inline void
 D3D9ShaderVariable::SetFloatArray(const float* values, SizeT count)
 {
-    this->d3d9Effect->SetFloatArray(this->hParam, values, count);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(values, sizeof(float), count, first, num))
+    {
+        this->d3d9Effect->SetFloatArray(this->hParam, values, count);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -99,16 +122,44 @@ D3D9ShaderVariable::SetFloatArray(const float* values, SizeT count)
 inline void
 D3D9ShaderVariable::SetVector(const Math::float4& value)
 {
-    this->d3d9Effect->SetVector(this->hParam, (CONST D3DXVECTOR4*) &value);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(&value, sizeof(Math::float4), 1, first, num))
+    {
+        this->d3d9Effect->SetVector(this->hParam, (CONST D3DXVECTOR4*) &value);
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
+    Only the changed range of the array is uploaded. Every element needs
+    its own handle lookup and call, so a range which starts at the first
+    element or is longer than MaxNumElementUploads is uploaded with one
+    array call up to its end instead. D3DX arrays can only be set from
+    their first element, so unchanged elements before the range are
+    uploaded again.
 */
 inline void
 D3D9ShaderVariable::SetVectorArray(const Math::float4* values, SizeT count)
 {
-    this->d3d9Effect->SetVectorArray(this->hParam, (CONST D3DXVECTOR4*) values, count);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(values, sizeof(Math::float4), count, first, num))
+    {
+        if ((0 == first) || (num > MaxNumElementUploads))
+        {
+            this->d3d9Effect->SetVectorArray(this->hParam, (CONST D3DXVECTOR4*) values, first + num);
+        }
+        else
+        {
+            IndexT i;
+            for (i = first; i < first + num; i++)
+            {
+                D3DXHANDLE hElement = this->d3d9Effect->GetParameterElement(this->hParam, i);
+                this->d3d9Effect->SetVector(hElement, (CONST D3DXVECTOR4*) &values[i]);
+            }
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -117,16 +168,41 @@ D3D9ShaderVariable::SetVectorArray(const Math::float4* values, SizeT count)
 inline void
 D3D9ShaderVariable::SetMatrix(const Math::matrix44& value)
 {
-    this->d3d9Effect->SetMatrix(this->hParam, (CONST D3DXMATRIX*) &value);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(&value, sizeof(Math::matrix44), 1, first, num))
+    {
+        this->d3d9Effect->SetMatrix(this->hParam, (CONST D3DXMATRIX*) &value);
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
+    Only the changed range of the array is uploaded, e.g. the joints of
+    a skinned mesh which moved. A longer range is uploaded with one array
+    call up to its end, see SetVectorArray().
 */
 inline void
 D3D9ShaderVariable::SetMatrixArray(const Math::matrix44* values, SizeT count)
 {
-    this->d3d9Effect->SetMatrixArray(this->hParam, (CONST D3DXMATRIX*) values, count);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(values, sizeof(Math::matrix44), count, first, num))
+    {
+        if ((0 == first) || (num > MaxNumElementUploads))
+        {
+            this->d3d9Effect->SetMatrixArray(this->hParam, (CONST D3DXMATRIX*) values, first + num);
+        }
+        else
+        {
+            IndexT i;
+            for (i = first; i < first + num; i++)
+            {
+                D3DXHANDLE hElement = this->d3d9Effect->GetParameterElement(this->hParam, i);
+                this->d3d9Effect->SetMatrix(hElement, (CONST D3DXMATRIX*) &values[i]);
+            }
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -135,7 +211,12 @@ D3D9ShaderVariable::SetMatrixArray(const Math::matrix44* values, SizeT count)
 inline void
 D3D9ShaderVariable::SetBool(bool value)
 {
-    this->d3d9Effect->SetBool(this->hParam, value);
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(&value, sizeof(bool), 1, first, num))
+    {
+        this->d3d9Effect->SetBool(this->hParam, value);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -144,6 +225,13 @@ D3D9ShaderVariable::SetBool(bool value)
 inline void
 D3D9ShaderVariable::SetBoolArray(const bool* values, SizeT count)
 {
+    IndexT first;
+    SizeT num;
+    if (!this->UpdateShadow(values, sizeof(bool), count, first, num))
+    {
+        return;
+    }
+
     // hmm... Win32's BOOL is actually an int
     const int MaxNumBools = 128;
     s_assert(count < MaxNumBools);
@@ -162,7 +250,10 @@ D3D9ShaderVariable::SetBoolArray(const bool* values, SizeT count)
 inline void
 D3D9ShaderVariable::SetTexture(const Ptr<CoreGraphics::Texture>& value)
 {
-    this->d3d9Effect->SetTexture(this->hParam, value->GetD3D9BaseTexture());
+    if (this->UpdateShadowTexture(value))
+    {
+        this->d3d9Effect->SetTexture(this->hParam, value->GetD3D9BaseTexture());
+    }
 }
 
 } // namespace Direct3D9
@@ -7,9 +7,12 @@
 
 namespace CoreGraphics
 {
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 ImplementClass(CoreGraphics::DisplayDevice, 'DDVC', Direct3D9::D3D9DisplayDevice);
 ImplementSingleton(CoreGraphics::DisplayDevice);
+#elif NEBULA3_USENULLRENDERER
+ImplementClass(CoreGraphics::DisplayDevice, 'DDVC', Null::NullDisplayDevice);
+ImplementSingleton(CoreGraphics::DisplayDevice);
 #elif __XBOX360__
 ImplementClass(CoreGraphics::DisplayDevice, 'DDVC', Xbox360::Xbox360DisplayDevice);
 ImplementSingleton(CoreGraphics::DisplayDevice);
@@ -10,7 +10,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9displaydevice.h"
 namespace CoreGraphics
 {
@@ -25,6 +26,21 @@ public:
     virtual ~DisplayDevice();
 };
 } // namespace CoreGraphics
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nulldisplaydevice.h"
+namespace CoreGraphics
+{
+class DisplayDevice : public Null::NullDisplayDevice
+{
+    DeclareClass(DisplayDevice);
+    DeclareSingleton(DisplayDevice);
+public:
+    /// constructor
+    DisplayDevice();
+    /// destructor
+    virtual ~DisplayDevice();
+};
+} // namespace CoreGraphics
 #else
 #error "CoreGraphics::DisplayDevice not implemented on this platform!"
 #endif
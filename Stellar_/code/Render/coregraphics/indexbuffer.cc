@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/indexbuffer.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::IndexBuffer, 'IDXB', Direct3D9::D3D9IndexBuffer);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::IndexBuffer, 'IDXB', Null::NullIndexBuffer);
+}
 #else
 #error "IndexBuffer class not implemented on this platform!"
 #endif
@@ -9,7 +9,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9indexbuffer.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class IndexBuffer : public Direct3D9::D3D9IndexBuffer
     DeclareClass(IndexBuffer);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullindexbuffer.h"
+namespace CoreGraphics
+{
+class IndexBuffer : public Null::NullIndexBuffer
+{
+    DeclareClass(IndexBuffer);
+};
+}
 #else
 #error "IndexBuffer class not implemented on this platform!"
 #endif
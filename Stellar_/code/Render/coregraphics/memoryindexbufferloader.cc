@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/memoryindexbufferloader.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::MemoryIndexBufferLoader, 'MIBL', Direct3D9::D3D9MemoryIndexBufferLoader);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::MemoryIndexBufferLoader, 'MIBL', Null::NullMemoryIndexBufferLoader);
+}
 #else
 #error "MemoryIndexBufferLoader class not implemented on this platform!"
 #endif
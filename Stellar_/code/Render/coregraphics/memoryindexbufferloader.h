@@ -9,7 +9,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9memoryindexbufferloader.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class MemoryIndexBufferLoader : public Direct3D9::D3D9MemoryIndexBufferLoader
     DeclareClass(MemoryIndexBufferLoader);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullmemoryindexbufferloader.h"
+namespace CoreGraphics
+{
+class MemoryIndexBufferLoader : public Null::NullMemoryIndexBufferLoader
+{
+    DeclareClass(MemoryIndexBufferLoader);
+};
+}
 #else
 #error "MemoryIndexBufferLoader class not implemented on this platform!"
 #endif
@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/memoryvertexbufferloader.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::MemoryVertexBufferLoader, 'MVBL', Direct3D9::D3D9MemoryVertexBufferLoader);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::MemoryVertexBufferLoader, 'MVBL', Null::NullMemoryVertexBufferLoader);
+}
 #else
 #error "MemoryVertexBufferLoader class not implemented on this platform!"
 #endif
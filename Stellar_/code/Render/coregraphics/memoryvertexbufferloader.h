@@ -9,7 +9,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9memoryvertexbufferloader.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class MemoryVertexBufferLoader : public Direct3D9::D3D9MemoryVertexBufferLoader
     DeclareClass(MemoryVertexBufferLoader);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullmemoryvertexbufferloader.h"
+namespace CoreGraphics
+{
+class MemoryVertexBufferLoader : public Null::NullMemoryVertexBufferLoader
+{
+    DeclareClass(MemoryVertexBufferLoader);
+};
+}
 #else
 #error "MemoryVertexBufferLoader class not implemented on this platform!"
 #endif
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+//  nulldisplaydevice.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nulldisplaydevice.h"
+
+namespace Null
+{
+ImplementClass(Null::NullDisplayDevice, 'NLDD', Base::DisplayDeviceBase);
+ImplementSingleton(Null::NullDisplayDevice);
+
+using namespace Util;
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullDisplayDevice::NullDisplayDevice()
+{
+    ConstructSingleton;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullDisplayDevice::~NullDisplayDevice()
+{
+    DestructSingleton;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullDisplayDevice::AdapterExists(Adapter::Code adapter)
+{
+    return (Adapter::Primary == adapter);
+}
+
+//------------------------------------------------------------------------------
+/**
+    The only display mode is the current one in the requested pixel format.
+*/
+Array<DisplayMode>
+NullDisplayDevice::GetAvailableDisplayModes(Adapter::Code adapter, PixelFormat::Code pixelFormat)
+{
+    s_assert(this->AdapterExists(adapter));
+    Array<DisplayMode> modes;
+    modes.Append(DisplayMode(this->displayMode.GetWidth(), this->displayMode.GetHeight(), pixelFormat));
+    return modes;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullDisplayDevice::SupportsDisplayMode(Adapter::Code adapter, const DisplayMode& requestedMode)
+{
+    return this->AdapterExists(adapter);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+DisplayMode
+NullDisplayDevice::GetCurrentAdapterDisplayMode(Adapter::Code adapter)
+{
+    s_assert(this->AdapterExists(adapter));
+    return this->displayMode;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+AdapterInfo
+NullDisplayDevice::GetAdapterInfo(Adapter::Code adapter)
+{
+    s_assert(this->AdapterExists(adapter));
+    AdapterInfo info;
+    info.SetDriverName("null");
+    info.SetDescription("Null Render Device");
+    info.SetDeviceName("null");
+    return info;
+}
+
+} // namespace Null
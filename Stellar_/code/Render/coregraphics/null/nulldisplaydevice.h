@@ -0,0 +1,42 @@
+#pragma once
+#ifndef NULL_NULLDISPLAYDEVICE_H
+#define NULL_NULLDISPLAYDEVICE_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullDisplayDevice
+
+    DisplayDevice of the null renderer. There is no window, the device
+    pretends to have a single adapter which supports any display mode.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/displaydevicebase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullDisplayDevice : public Base::DisplayDeviceBase
+{
+    DeclareClass(NullDisplayDevice);
+    DeclareSingleton(NullDisplayDevice);
+public:
+    /// constructor
+    NullDisplayDevice();
+    /// destructor
+    virtual ~NullDisplayDevice();
+
+    /// return true if adapter exists
+    bool AdapterExists(CoreGraphics::Adapter::Code adapter);
+    /// get available display modes on given adapter
+    Util::Array<CoreGraphics::DisplayMode> GetAvailableDisplayModes(CoreGraphics::Adapter::Code adapter, CoreGraphics::PixelFormat::Code pixelFormat);
+    /// return true if a given display mode is supported
+    bool SupportsDisplayMode(CoreGraphics::Adapter::Code adapter, const CoreGraphics::DisplayMode& requestedMode);
+    /// get current adapter display mode (i.e. the desktop display mode)
+    CoreGraphics::DisplayMode GetCurrentAdapterDisplayMode(CoreGraphics::Adapter::Code adapter);
+    /// get general info about display adapter
+    CoreGraphics::AdapterInfo GetAdapterInfo(CoreGraphics::Adapter::Code adapter);
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
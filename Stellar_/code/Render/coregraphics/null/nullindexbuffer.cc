@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//  nullindexbuffer.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullindexbuffer.h"
+
+namespace Null
+{
+ImplementClass(Null::NullIndexBuffer, 'NLIB', Base::IndexBufferBase);
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullIndexBuffer::NullIndexBuffer() :
+    indexData(0),
+    indexDataSize(0),
+    mapCount(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullIndexBuffer::~NullIndexBuffer()
+{
+    s_assert(0 == this->indexData);
+    s_assert(0 == this->mapCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullIndexBuffer::Unload()
+{
+    s_assert(0 == this->mapCount);
+    if (0 != this->indexData)
+    {
+        Memory::Free(this->indexData);
+        this->indexData = 0;
+        this->indexDataSize = 0;
+    }
+    IndexBufferBase::Unload();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullIndexBuffer::SetIndexData(void* ptr, SizeT numBytes)
+{
+    s_assert(0 == this->indexData);
+    s_assert(0 != ptr);
+    this->indexData = ptr;
+    this->indexDataSize = numBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void*
+NullIndexBuffer::Map(MapType mapType)
+{
+    s_assert(0 != this->indexData);
+    this->mapCount++;
+    return this->indexData;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullIndexBuffer::Unmap()
+{
+    s_assert(0 != this->indexData);
+    s_assert(this->mapCount > 0);
+    this->mapCount--;
+}
+
+} // namespace Null
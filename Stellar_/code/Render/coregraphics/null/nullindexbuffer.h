@@ -0,0 +1,47 @@
+#pragma once
+#ifndef NULL_NULLINDEXBUFFER_H
+#define NULL_NULLINDEXBUFFER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullIndexBuffer
+
+    Index buffer of the null renderer, the indices are kept in a
+    CPU-side buffer.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/indexbufferbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullIndexBuffer : public Base::IndexBufferBase
+{
+    DeclareClass(NullIndexBuffer);
+public:
+    /// constructor
+    NullIndexBuffer();
+    /// destructor
+    virtual ~NullIndexBuffer();
+
+    /// unload the resource, or cancel the pending load
+    virtual void Unload();
+    /// map index buffer for CPU access
+    void* Map(MapType mapType);
+    /// unmap the resource
+    void Unmap();
+
+private:
+    friend class NullMemoryIndexBufferLoader;
+
+    /// set the index data, the index buffer takes ownership
+    void SetIndexData(void* ptr, SizeT numBytes);
+
+    void* indexData;
+    SizeT indexDataSize;
+    int mapCount;
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
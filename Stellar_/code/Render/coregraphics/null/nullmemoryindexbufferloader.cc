@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+//  nullmemoryindexbufferloader.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullmemoryindexbufferloader.h"
+#include "coregraphics/null/nullindexbuffer.h"
+
+namespace Null
+{
+ImplementClass(Null::NullMemoryIndexBufferLoader, 'NMIL', Base::MemoryIndexBufferLoaderBase);
+
+using namespace Resources;
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+    Copies the data provided in the Setup() method into a new buffer and
+    hands it to our resource object (which must be a NullIndexBuffer
+    object). The data pointer provided to Setup() will be invalidated
+    inside OnLoadRequested().
+*/
+bool
+NullMemoryIndexBufferLoader::OnLoadRequested()
+{
+    s_assert(this->GetState() == Resource::Initial);
+    s_assert(this->resource.isvalid());
+    s_assert(!this->resource->IsAsyncEnabled());
+    s_assert(0 != this->indexDataPtr);
+    s_assert(this->indexType != IndexType::None);
+    s_assert(this->numIndices > 0);
+    s_assert(this->indexDataSize == (this->numIndices * IndexType::SizeOf(this->indexType)));
+
+    // copy index data to the CPU-side buffer
+    void* indexData = Memory::Alloc(this->indexDataSize);
+    Memory::Copy(this->indexDataPtr, indexData, this->indexDataSize);
+
+    // setup our resource object
+    s_assert(this->resource->IsA(NullIndexBuffer::RTTI));
+    const Ptr<NullIndexBuffer>& res = this->resource.downcast<NullIndexBuffer>();
+    s_assert(!res->IsLoaded());
+    res->SetIndexType(this->indexType);
+    res->SetNumIndices(this->numIndices);
+    res->SetIndexData(indexData, this->indexDataSize);
+
+    // invalidate setup data (because we don't own our data)
+    this->indexDataPtr = 0;
+    this->indexDataSize = 0;
+
+    this->SetState(Resource::Loaded);
+    return true;
+}
+
+} // namespace Null
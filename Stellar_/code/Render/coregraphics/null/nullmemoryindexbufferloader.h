@@ -0,0 +1,28 @@
+#pragma once
+#ifndef NULL_NULLMEMORYINDEXBUFFERLOADER_H
+#define NULL_NULLMEMORYINDEXBUFFERLOADER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullMemoryIndexBufferLoader
+
+    Initialize a NullIndexBuffer from data in memory. The data is
+    copied into the CPU-side buffer of the index buffer.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/memoryindexbufferloaderbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullMemoryIndexBufferLoader : public Base::MemoryIndexBufferLoaderBase
+{
+    DeclareClass(NullMemoryIndexBufferLoader);
+public:
+    /// called by resource when a load is requested
+    virtual bool OnLoadRequested();
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
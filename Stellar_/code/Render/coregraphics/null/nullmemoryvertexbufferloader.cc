@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+//  nullmemoryvertexbufferloader.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullmemoryvertexbufferloader.h"
+#include "coregraphics/null/nullvertexbuffer.h"
+
+namespace Null
+{
+ImplementClass(Null::NullMemoryVertexBufferLoader, 'NMVL', Base::MemoryVertexBufferLoaderBase);
+
+using namespace Resources;
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+    Copies the data provided in the Setup() method into a new buffer and
+    hands it to our resource object (which must be a NullVertexBuffer
+    object). The data pointer provided to Setup() will be invalidated
+    inside OnLoadRequested().
+*/
+bool
+NullMemoryVertexBufferLoader::OnLoadRequested()
+{
+    s_assert(this->GetState() == Resource::Initial);
+    s_assert(this->resource.isvalid());
+    s_assert(!this->resource->IsAsyncEnabled());
+    s_assert(0 != this->vertexDataPtr);
+
+    // copy vertex data to the CPU-side buffer
+    void* vertexData = Memory::Alloc(this->vertexDataSize);
+    Memory::Copy(this->vertexDataPtr, vertexData, this->vertexDataSize);
+
+    // setup our resource object
+    s_assert(this->resource->IsA(NullVertexBuffer::RTTI));
+    const Ptr<NullVertexBuffer>& res = this->resource.downcast<NullVertexBuffer>();
+    s_assert(!res->IsLoaded());
+    res->Setup(this->vertexComponents);
+    res->SetNumVertices(this->numVertices);
+    res->SetVertexData(vertexData, this->vertexDataSize);
+
+    // invalidate setup data (because we don't own our data)
+    this->vertexDataPtr = 0;
+    this->vertexDataSize = 0;
+
+    this->SetState(Resource::Loaded);
+    return true;
+}
+
+} // namespace Null
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef NULL_NULLMEMORYVERTEXBUFFERLOADER_H
+#define NULL_NULLMEMORYVERTEXBUFFERLOADER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullMemoryVertexBufferLoader
+
+    Initialize a NullVertexBuffer from data in memory. The data is
+    copied into the CPU-side buffer of the vertex buffer.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/memoryvertexbufferloaderbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullMemoryVertexBufferLoader : public Base::MemoryVertexBufferLoaderBase
+{
+    DeclareClass(NullMemoryVertexBufferLoader);
+public:
+    /// called by resource when a load is requested
+    virtual bool OnLoadRequested();
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+//  nullrenderdevice.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullrenderdevice.h"
+#include "coregraphics/rendertarget.h"
+#include "coregraphics/vertexbuffer.h"
+#include "coregraphics/indexbuffer.h"
+#include "coregraphics/shaderinstance.h"
+
+namespace Null
+{
+ImplementClass(Null::NullRenderDevice, 'NLRD', Base::RenderDeviceBase);
+ImplementSingleton(Null::NullRenderDevice);
+
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullRenderDevice::NullRenderDevice()
+{
+    ConstructSingleton;
+    this->ResetStats();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullRenderDevice::~NullRenderDevice()
+{
+    DestructSingleton;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The null device doesn't need any hardware.
+*/
+bool
+NullRenderDevice::CanCreate()
+{
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullRenderDevice::Open()
+{
+    this->ResetStats();
+    return RenderDeviceBase::Open();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderDevice::ResetStats()
+{
+    Memory::Clear(&this->frameStats, sizeof(this->frameStats));
+    Memory::Clear(&this->lastFrameStats, sizeof(this->lastFrameStats));
+    Memory::Clear(&this->totalStats, sizeof(this->totalStats));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullRenderDevice::BeginFrame()
+{
+    if (RenderDeviceBase::BeginFrame())
+    {
+        this->frameStats.numFrames++;
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderDevice::BeginPass(const Ptr<RenderTarget>& rt, const Ptr<ShaderInstance>& passShader)
+{
+    RenderDeviceBase::BeginPass(rt, passShader);
+    this->frameStats.numPasses++;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderDevice::BeginBatch(BatchType::Code batchType, const Ptr<ShaderInstance>& batchShader)
+{
+    RenderDeviceBase::BeginBatch(batchType, batchShader);
+    this->frameStats.numBatches++;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderDevice::SetVertexBuffer(const Ptr<VertexBuffer>& vb)
+{
+    s_assert(this->inBeginPass);
+    s_assert(vb.isvalid());
+    RenderDeviceBase::SetVertexBuffer(vb);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderDevice::SetIndexBuffer(const Ptr<IndexBuffer>& ib)
+{
+    s_assert(this->inBeginPass);
+    s_assert(ib.isvalid());
+    RenderDeviceBase::SetIndexBuffer(ib);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Checks the current primitive group against the current buffers like
+    the Direct3D debug runtime would, and counts the draw call.
+*/
+void
+NullRenderDevice::Draw()
+{
+    s_assert(this->inBeginPass);
+    s_assert(this->vertexBuffer.isvalid());
+    s_assert(this->primitiveGroup.GetBaseVertex() + this->primitiveGroup.GetNumVertices() <= this->vertexBuffer->GetNumVertices());
+    if (this->primitiveGroup.GetNumIndices() > 0)
+    {
+        s_assert(this->indexBuffer.isvalid());
+        s_assert(this->primitiveGroup.GetBaseIndex() + this->primitiveGroup.GetNumIndices() <= this->indexBuffer->GetNumIndices());
+    }
+    this->frameStats.numDraws++;
+    this->frameStats.numPrimitives += this->primitiveGroup.GetNumPrimitives();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Finishes the counters of the frame.
+*/
+void
+NullRenderDevice::EndFrame()
+{
+    RenderDeviceBase::EndFrame();
+
+    this->lastFrameStats = this->frameStats;
+    this->totalStats.numFrames += this->frameStats.numFrames;
+    this->totalStats.numPasses += this->frameStats.numPasses;
+    this->totalStats.numBatches += this->frameStats.numBatches;
+    this->totalStats.numDraws += this->frameStats.numDraws;
+    this->totalStats.numPrimitives += this->frameStats.numPrimitives;
+    Memory::Clear(&this->frameStats, sizeof(this->frameStats));
+}
+
+//------------------------------------------------------------------------------
+/**
+    There is no back buffer, so nothing is written to the stream.
+*/
+void
+NullRenderDevice::SaveScreenshot(ImageFileFormat::Code fmt, const Ptr<IO::Stream>& outStream)
+{
+    s_assert(!this->inBeginFrame);
+}
+
+} // namespace Null
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef NULL_NULLRENDERDEVICE_H
+#define NULL_NULLRENDERDEVICE_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullRenderDevice
+
+    Implements a RenderDevice without a GPU. The rendering commands go
+    through the same checks as on a real device, but are only counted,
+    so the CPU cost of the frame pipeline, the number of state changes
+    and the number of draw calls can be measured on machines without
+    Direct3D, e.g. on the Linux build farm.
+
+    The counters of a frame are collected between BeginFrame() and
+    EndFrame(), GetLastFrameStats() returns the counters of the last
+    finished frame, GetStats() the sum over all frames since the device
+    has been opened or ResetStats() has been called. The issued and
+    filtered state changes are counted by RenderDeviceBase.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/renderdevicebase.h"
+#include "coregraphics/imagefileformat.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullRenderDevice : public Base::RenderDeviceBase
+{
+    DeclareClass(NullRenderDevice);
+    DeclareSingleton(NullRenderDevice);
+public:
+    /// the counted rendering commands
+    struct Stats
+    {
+        SizeT numFrames;                // BeginFrame() calls
+        SizeT numPasses;                // BeginPass() calls
+        SizeT numBatches;               // BeginBatch() calls
+        SizeT numDraws;                 // Draw() calls
+        SizeT numPrimitives;            // primitives of all Draw() calls
+    };
+
+    /// constructor
+    NullRenderDevice();
+    /// destructor
+    virtual ~NullRenderDevice();
+
+    /// test if a compatible render device can be created on this machine
+    static bool CanCreate();
+
+    /// open the device
+    bool Open();
+    /// begin complete frame
+    bool BeginFrame();
+    /// begin rendering a frame pass
+    void BeginPass(const Ptr<CoreGraphics::RenderTarget>& rt, const Ptr<CoreGraphics::ShaderInstance>& passShader);
+    /// begin rendering a batch inside
+    void BeginBatch(CoreGraphics::BatchType::Code batchType, const Ptr<CoreGraphics::ShaderInstance>& batchShader);
+    /// set current vertex buffer
+    void SetVertexBuffer(const Ptr<CoreGraphics::VertexBuffer>& vb);
+    /// set current index buffer
+    void SetIndexBuffer(const Ptr<CoreGraphics::IndexBuffer>& ib);
+    /// draw current primitives
+    void Draw();
+    /// end complete frame
+    void EndFrame();
+    /// save a screenshot to the provided stream
+    void SaveScreenshot(CoreGraphics::ImageFileFormat::Code fmt, const Ptr<IO::Stream>& outStream);
+
+    /// get the commands of the last finished frame
+    const Stats& GetLastFrameStats() const;
+    /// get the commands of all finished frames since Open() or ResetStats()
+    const Stats& GetStats() const;
+    /// reset the command counters
+    void ResetStats();
+
+private:
+    Stats frameStats;
+    Stats lastFrameStats;
+    Stats totalStats;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const NullRenderDevice::Stats&
+NullRenderDevice::GetLastFrameStats() const
+{
+    return this->lastFrameStats;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const NullRenderDevice::Stats&
+NullRenderDevice::GetStats() const
+{
+    return this->totalStats;
+}
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
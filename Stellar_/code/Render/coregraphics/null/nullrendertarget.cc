@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//  nullrendertarget.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullrendertarget.h"
+#include "coregraphics/displaydevice.h"
+#include "coregraphics/texture.h"
+#include "resources/sharedresourceserver.h"
+
+namespace Null
+{
+ImplementClass(Null::NullRenderTarget, 'NLRT', Base::RenderTargetBase);
+
+using namespace CoreGraphics;
+using namespace Resources;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullRenderTarget::NullRenderTarget()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullRenderTarget::~NullRenderTarget()
+{
+    s_assert(!this->isValid);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullRenderTarget::Setup()
+{
+    // call parent class
+    RenderTargetBase::Setup();
+
+    // if we're the default render target, query display device
+    // for setup parameters
+    if (this->isDefaultRenderTarget)
+    {
+        DisplayDevice* displayDevice = DisplayDevice::Instance();
+        this->SetWidth(displayDevice->GetDisplayMode().GetWidth());
+        this->SetHeight(displayDevice->GetDisplayMode().GetHeight());
+        this->SetAntiAliasQuality(AntiAliasQuality::None);
+        this->AddColorBuffer(displayDevice->GetDisplayMode().GetPixelFormat());
+    }
+    else if (this->resolveTextureResId.IsValid())
+    {
+        // create the resolve texture as shared resource, so that it is publicly visible
+        SizeT resolveWidth = this->resolveTextureDimensionsValid ? this->resolveTextureWidth : this->width;
+        SizeT resolveHeight = this->resolveTextureDimensionsValid ? this->resolveTextureHeight : this->height;
+        this->resolveTexture = SharedResourceServer::Instance()->CreateSharedResource(this->resolveTextureResId, Texture::RTTI).downcast<Texture>();
+        this->resolveTexture->Setup(Texture::Texture2D, resolveWidth, resolveHeight, 1, 1, this->colorBufferFormats[0]);
+    }
+}
+
+} // namespace Null
@@ -0,0 +1,34 @@
+#pragma once
+#ifndef NULL_NULLRENDERTARGET_H
+#define NULL_NULLRENDERTARGET_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullRenderTarget
+
+    RenderTarget of the null renderer. Nothing is rendered, but the
+    resolve texture is created like on a real device, so that it can be
+    looked up and bound as shader variable.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/rendertargetbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullRenderTarget : public Base::RenderTargetBase
+{
+    DeclareClass(NullRenderTarget);
+public:
+    /// constructor
+    NullRenderTarget();
+    /// destructor
+    virtual ~NullRenderTarget();
+
+    /// setup the render target object
+    void Setup();
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
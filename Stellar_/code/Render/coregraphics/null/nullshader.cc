@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+//  nullshader.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullshader.h"
+
+namespace Null
+{
+ImplementClass(Null::NullShader, 'NLSH', Base::ShaderBase);
+
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShader::NullShader()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShader::~NullShader()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShader::Unload()
+{
+    this->variableDecls.Clear();
+    this->variationDecls.Clear();
+    ShaderBase::Unload();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShader::AddVariable(ShaderVariable::Type type, const ShaderVariable::Name& name, const ShaderVariable::Semantic& semantic, SizeT numArrayElements)
+{
+    VariableDecl decl;
+    decl.type = type;
+    decl.name = name;
+    decl.semantic = semantic;
+    decl.numArrayElements = numArrayElements;
+    this->variableDecls.Append(decl);
+
+    IndexT i;
+    for (i = 0; i < this->shaderInstances.Size(); i++)
+    {
+        this->shaderInstances[i]->AddVariable(type, name, semantic, numArrayElements);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShader::AddVariation(const ShaderVariation::Name& name, ShaderFeature::Mask featureMask, SizeT numPasses)
+{
+    VariationDecl decl;
+    decl.name = name;
+    decl.featureMask = featureMask;
+    decl.numPasses = numPasses;
+    this->variationDecls.Append(decl);
+
+    // the new variation may use new feature bits, so the existing
+    // instances set up their variation tables again
+    this->InvalidateVariationRemap();
+    IndexT i;
+    for (i = 0; i < this->shaderInstances.Size(); i++)
+    {
+        this->shaderInstances[i]->AddVariation(name, featureMask, numPasses);
+        this->shaderInstances[i]->SetupVariationTable();
+    }
+}
+
+} // namespace Null
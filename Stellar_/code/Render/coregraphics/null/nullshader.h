@@ -0,0 +1,84 @@
+#pragma once
+#ifndef NULL_NULLSHADER_H
+#define NULL_NULLSHADER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullShader
+
+    Shader of the null renderer. There is no effect compiler, so the
+    variables and variations of a shader are declared by the application
+    with AddVariable() and AddVariation(), e.g. right after the shader
+    server has been opened. Declarations are added to existing shader
+    instances as well. A shader without declared variations has a single
+    default variation with feature mask 0 and one pass.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/shaderbase.h"
+#include "coregraphics/shaderinstance.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullShader : public Base::ShaderBase
+{
+    DeclareClass(NullShader);
+public:
+    /// a declared shader variable
+    struct VariableDecl
+    {
+        CoreGraphics::ShaderVariable::Type type;
+        CoreGraphics::ShaderVariable::Name name;
+        CoreGraphics::ShaderVariable::Semantic semantic;
+        SizeT numArrayElements;
+    };
+    /// a declared shader variation
+    struct VariationDecl
+    {
+        CoreGraphics::ShaderVariation::Name name;
+        CoreGraphics::ShaderFeature::Mask featureMask;
+        SizeT numPasses;
+    };
+
+    /// constructor
+    NullShader();
+    /// destructor
+    virtual ~NullShader();
+
+    /// unload the resource, or cancel the pending load
+    virtual void Unload();
+    /// declare a variable
+    void AddVariable(CoreGraphics::ShaderVariable::Type type, const CoreGraphics::ShaderVariable::Name& name, const CoreGraphics::ShaderVariable::Semantic& semantic, SizeT numArrayElements = 1);
+    /// declare a variation
+    void AddVariation(const CoreGraphics::ShaderVariation::Name& name, CoreGraphics::ShaderFeature::Mask featureMask, SizeT numPasses = 1);
+    /// get the declared variables
+    const Util::Array<VariableDecl>& GetVariableDecls() const;
+    /// get the declared variations
+    const Util::Array<VariationDecl>& GetVariationDecls() const;
+
+private:
+    Util::Array<VariableDecl> variableDecls;
+    Util::Array<VariationDecl> variationDecls;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Util::Array<NullShader::VariableDecl>&
+NullShader::GetVariableDecls() const
+{
+    return this->variableDecls;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Util::Array<NullShader::VariationDecl>&
+NullShader::GetVariationDecls() const
+{
+    return this->variationDecls;
+}
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
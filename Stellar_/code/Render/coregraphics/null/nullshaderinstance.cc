@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//  nullshaderinstance.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullshaderinstance.h"
+#include "coregraphics/shader.h"
+#include "coregraphics/shadervariable.h"
+#include "coregraphics/shadervariation.h"
+
+namespace Null
+{
+ImplementClass(Null::NullShaderInstance, 'NLSI', Base::ShaderInstanceBase);
+
+using namespace Util;
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderInstance::NullShaderInstance()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderInstance::~NullShaderInstance()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+    This method is called by Shader::CreateInstance() to setup the
+    new shader instance. A shader without declared variations gets a
+    default variation with one pass, so it can be used for passes and
+    batches.
+*/
+void
+NullShaderInstance::Setup(const Ptr<Shader>& origShader)
+{
+    s_assert(origShader.isvalid());
+
+    // call parent class
+    ShaderInstanceBase::Setup(origShader);
+
+    IndexT i;
+    const Array<NullShader::VariableDecl>& variableDecls = origShader->GetVariableDecls();
+    for (i = 0; i < variableDecls.Size(); i++)
+    {
+        const NullShader::VariableDecl& decl = variableDecls[i];
+        this->AddVariable(decl.type, decl.name, decl.semantic, decl.numArrayElements);
+    }
+    const Array<NullShader::VariationDecl>& variationDecls = origShader->GetVariationDecls();
+    for (i = 0; i < variationDecls.Size(); i++)
+    {
+        const NullShader::VariationDecl& decl = variationDecls[i];
+        this->AddVariation(decl.name, decl.featureMask, decl.numPasses);
+    }
+    if (this->variations.IsEmpty())
+    {
+        this->AddVariation(ShaderVariation::Name("Default"), 0, 1);
+    }
+    this->SetupVariationTable();
+
+    // select a proper default active variation
+    this->SelectActiveVariation(this->variations.KeyAtIndex(0));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderInstance::AddVariable(ShaderVariable::Type type, const ShaderVariable::Name& name, const ShaderVariable::Semantic& semantic, SizeT numArrayElements)
+{
+    s_assert(!this->variablesByName.Contains(name));
+    Ptr<ShaderVariable> shaderVariable = ShaderVariable::Create();
+    shaderVariable->Setup(type, name, semantic, numArrayElements);
+    this->variables.Append(shaderVariable);
+    this->variablesByName.Add(name, shaderVariable);
+    if (!this->variablesBySemantic.Contains(semantic))
+    {
+        this->variablesBySemantic.Add(semantic, shaderVariable);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderInstance::AddVariation(const ShaderVariation::Name& name, ShaderFeature::Mask featureMask, SizeT numPasses)
+{
+    s_assert(!this->variations.Contains(featureMask));
+    Ptr<ShaderVariation> shaderVariation = ShaderVariation::Create();
+    shaderVariation->Setup(name, featureMask, numPasses);
+    this->variations.Add(featureMask, shaderVariation);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+SizeT
+NullShaderInstance::Begin()
+{
+    ShaderInstanceBase::Begin();
+    return this->activeVariation->GetNumPasses();
+}
+
+} // namespace Null
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef NULL_NULLSHADERINSTANCE_H
+#define NULL_NULLSHADERINSTANCE_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullShaderInstance
+
+    ShaderInstance of the null renderer. The variables and variations
+    are created from the declarations of the original NullShader, see
+    there for details.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/shaderinstancebase.h"
+#include "coregraphics/shaderfeature.h"
+
+namespace Base
+{
+class ShaderBase;
+};
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullShaderInstance : public Base::ShaderInstanceBase
+{
+    DeclareClass(NullShaderInstance);
+public:
+    /// constructor
+    NullShaderInstance();
+    /// destructor
+    virtual ~NullShaderInstance();
+
+    /// begin rendering through the currently selected variation, returns no. passes
+    SizeT Begin();
+
+protected:
+    friend class Base::ShaderBase;
+    friend class NullShader;
+
+    /// setup the shader instance from its original shader object
+    void Setup(const Ptr<CoreGraphics::Shader>& origShader);
+    /// add a variable declared on the original shader
+    void AddVariable(CoreGraphics::ShaderVariable::Type type, const CoreGraphics::ShaderVariable::Name& name, const CoreGraphics::ShaderVariable::Semantic& semantic, SizeT numArrayElements);
+    /// add a variation declared on the original shader
+    void AddVariation(const CoreGraphics::ShaderVariation::Name& name, CoreGraphics::ShaderFeature::Mask featureMask, SizeT numPasses);
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
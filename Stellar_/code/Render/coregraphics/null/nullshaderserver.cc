@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+//  nullshaderserver.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullshaderserver.h"
+#include "coregraphics/streamshaderloader.h"
+
+namespace Null
+{
+ImplementClass(Null::NullShaderServer, 'NLSS', Base::ShaderServerBase);
+ImplementSingleton(Null::NullShaderServer);
+
+using namespace Resources;
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderServer::NullShaderServer()
+{
+    ConstructSingleton;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderServer::~NullShaderServer()
+{
+    if (this->IsOpen())
+    {
+        this->Close();
+    }
+    DestructSingleton;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullShaderServer::Open()
+{
+    s_assert(!this->IsOpen());
+
+    // let parent class load all shaders
+    ShaderServerBase::Open();
+
+    // setup the shader for the shared variables
+    ResourceId resId("shd:shared");
+    if (this->HasShader(resId))
+    {
+        this->sharedShader = this->GetAllShaders()[resId];
+    }
+    else
+    {
+        this->sharedShader = Shader::Create();
+        this->sharedShader->SetResourceId(resId);
+        this->sharedShader->SetLoader(StreamShaderLoader::Create());
+        this->sharedShader->SetAsyncEnabled(false);
+        this->sharedShader->Load();
+        this->sharedShader->SetLoader(0);
+    }
+    this->sharedVariableShaderInst = this->sharedShader->CreateShaderInstance();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderServer::Close()
+{
+    s_assert(this->IsOpen());
+    this->sharedVariableShaderInst->Discard();
+    this->sharedVariableShaderInst = 0;
+
+    // the parent class unloads the shaders it has loaded
+    if (!this->HasShader(this->sharedShader->GetResourceId()))
+    {
+        this->sharedShader->Unload();
+    }
+    this->sharedShader = 0;
+    ShaderServerBase::Close();
+}
+
+} // namespace Null
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef NULL_NULLSHADERSERVER_H
+#define NULL_NULLSHADERSERVER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullShaderServer
+
+    ShaderServer of the null renderer. The shared variables are the
+    variables of the shader "shd:shared", which is created by the server
+    if there is no such shader file. Use GetSharedShader() to declare the
+    shared variables.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/shaderserverbase.h"
+#include "coregraphics/shader.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullShaderServer : public Base::ShaderServerBase
+{
+    DeclareClass(NullShaderServer);
+    DeclareSingleton(NullShaderServer);
+public:
+    /// constructor
+    NullShaderServer();
+    /// destructor
+    virtual ~NullShaderServer();
+
+    /// open the shader server
+    bool Open();
+    /// close the shader server
+    void Close();
+    /// get the shader which holds the shared variables
+    const Ptr<CoreGraphics::Shader>& GetSharedShader() const;
+    /// return true if a shared variable exists by name
+    bool HasSharedVariableByName(const CoreGraphics::ShaderVariable::Name& name) const;
+    /// return true if a shared variable exists by semantic
+    bool HasSharedVariableBySemantic(const CoreGraphics::ShaderVariable::Semantic& sem) const;
+    /// get number of shared variables
+    SizeT GetNumSharedVariables() const;
+    /// get a shared variable by index
+    const Ptr<CoreGraphics::ShaderVariable>& GetSharedVariableByIndex(IndexT i) const;
+    /// get a shared variable by name
+    const Ptr<CoreGraphics::ShaderVariable>& GetSharedVariableByName(const CoreGraphics::ShaderVariable::Name& name) const;
+    /// get a shared variable by semantic
+    const Ptr<CoreGraphics::ShaderVariable>& GetSharedVariableBySemantic(const CoreGraphics::ShaderVariable::Semantic& sem) const;
+
+private:
+    Ptr<CoreGraphics::Shader> sharedShader;
+    Ptr<CoreGraphics::ShaderInstance> sharedVariableShaderInst;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<CoreGraphics::Shader>&
+NullShaderServer::GetSharedShader() const
+{
+    s_assert(this->sharedShader.isvalid());
+    return this->sharedShader;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+NullShaderServer::HasSharedVariableByName(const CoreGraphics::ShaderVariable::Name& name) const
+{
+    return this->sharedVariableShaderInst->HasVariableByName(name);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+NullShaderServer::HasSharedVariableBySemantic(const CoreGraphics::ShaderVariable::Semantic& sem) const
+{
+    return this->sharedVariableShaderInst->HasVariableBySemantic(sem);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+NullShaderServer::GetNumSharedVariables() const
+{
+    return this->sharedVariableShaderInst->GetNumVariables();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<CoreGraphics::ShaderVariable>&
+NullShaderServer::GetSharedVariableByIndex(IndexT i) const
+{
+    return this->sharedVariableShaderInst->GetVariableByIndex(i);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<CoreGraphics::ShaderVariable>&
+NullShaderServer::GetSharedVariableByName(const CoreGraphics::ShaderVariable::Name& name) const
+{
+    return this->sharedVariableShaderInst->GetVariableByName(name);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<CoreGraphics::ShaderVariable>&
+NullShaderServer::GetSharedVariableBySemantic(const CoreGraphics::ShaderVariable::Semantic& sem) const
+{
+    return this->sharedVariableShaderInst->GetVariableBySemantic(sem);
+}
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
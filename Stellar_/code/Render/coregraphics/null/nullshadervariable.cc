@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//  nullshadervariable.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullshadervariable.h"
+
+namespace Null
+{
+ImplementClass(Null::NullShaderVariable, 'NLSV', Base::ShaderVariableBase);
+
+using namespace CoreGraphics;
+using namespace Math;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderVariable::NullShaderVariable() :
+    valueBuffer(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderVariable::~NullShaderVariable()
+{
+    if (0 != this->valueBuffer)
+    {
+        Memory::Free(this->valueBuffer);
+        this->valueBuffer = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::Setup(Type t, const Name& n, const Semantic& s, SizeT num)
+{
+    s_assert(0 == this->valueBuffer);
+    s_assert(num > 0);
+    this->SetType(t);
+    this->SetName(n);
+    this->SetSemantic(s);
+    this->SetNumArrayElements(num);
+
+    SizeT elementSize = 0;
+    switch (t)
+    {
+        case IntType:       elementSize = sizeof(int); break;
+        case FloatType:     elementSize = sizeof(float); break;
+        case VectorType:    elementSize = sizeof(float4); break;
+        case MatrixType:    elementSize = sizeof(matrix44); break;
+        case BoolType:      elementSize = sizeof(bool); break;
+        default:            break;
+    }
+    if (elementSize > 0)
+    {
+        this->valueBuffer = Memory::Alloc(elementSize * num);
+        Memory::Clear(this->valueBuffer, elementSize * num);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::CopyValues(Type t, const void* values, SizeT elementSize, SizeT count)
+{
+    s_assert(t == this->type);
+    s_assert((count > 0) && (count <= this->numArrayElements));
+    IndexT first;
+    SizeT num;
+    if (this->UpdateShadow(values, elementSize, count, first, num))
+    {
+        Memory::Copy((const char*) values + first * elementSize, (char*) this->valueBuffer + first * elementSize, num * elementSize);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetInt(int value)
+{
+    this->CopyValues(IntType, &value, sizeof(int), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetIntArray(const int* values, SizeT count)
+{
+    this->CopyValues(IntType, values, sizeof(int), count);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetFloat(float value)
+{
+    this->CopyValues(FloatType, &value, sizeof(float), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetFloatArray(const float* values, SizeT count)
+{
+    this->CopyValues(FloatType, values, sizeof(float), count);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetVector(const float4& value)
+{
+    this->CopyValues(VectorType, &value, sizeof(float4), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetVectorArray(const float4* values, SizeT count)
+{
+    this->CopyValues(VectorType, values, sizeof(float4), count);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetMatrix(const matrix44& value)
+{
+    this->CopyValues(MatrixType, &value, sizeof(matrix44), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetMatrixArray(const matrix44* values, SizeT count)
+{
+    this->CopyValues(MatrixType, values, sizeof(matrix44), count);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetBool(bool value)
+{
+    this->CopyValues(BoolType, &value, sizeof(bool), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetBoolArray(const bool* values, SizeT count)
+{
+    this->CopyValues(BoolType, values, sizeof(bool), count);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariable::SetTexture(const Ptr<Texture>& value)
+{
+    s_assert(TextureType == this->type);
+    if (this->UpdateShadowTexture(value))
+    {
+        this->texture = value;
+    }
+}
+
+} // namespace Null
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef NULL_NULLSHADERVARIABLE_H
+#define NULL_NULLSHADERVARIABLE_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullShaderVariable
+
+    ShaderVariable of the null renderer. The values are copied into a
+    CPU-side buffer, so setting a variable costs about as much as on a
+    real device and the last value can be read back.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/shadervariablebase.h"
+#include "coregraphics/texture.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullShaderVariable : public Base::ShaderVariableBase
+{
+    DeclareClass(NullShaderVariable);
+public:
+    /// constructor
+    NullShaderVariable();
+    /// destructor
+    virtual ~NullShaderVariable();
+
+    /// set int value
+    void SetInt(int value);
+    /// set int array values
+    void SetIntArray(const int* values, SizeT count);
+    /// set float value
+    void SetFloat(float value);
+    /// set float array values
+    void SetFloatArray(const float* values, SizeT count);
+    /// set vector value
+    void SetVector(const Math::float4& value);
+    /// set vector array values
+    void SetVectorArray(const Math::float4* values, SizeT count);
+    /// set matrix value
+    void SetMatrix(const Math::matrix44& value);
+    /// set matrix array values
+    void SetMatrixArray(const Math::matrix44* values, SizeT count);
+    /// set bool value
+    void SetBool(bool value);
+    /// set bool array values
+    void SetBoolArray(const bool* values, SizeT count);
+    /// set texture value
+    void SetTexture(const Ptr<CoreGraphics::Texture>& value);
+
+    /// get the CPU-side copy of the value (not for textures)
+    const void* GetValueBuffer() const;
+    /// get the texture value
+    const Ptr<CoreGraphics::Texture>& GetTexture() const;
+
+private:
+    friend class NullShaderInstance;
+
+    /// setup the variable and allocate the value buffer
+    void Setup(Type type, const Name& name, const Semantic& semantic, SizeT numArrayElements);
+    /// copy values into the value buffer
+    void CopyValues(Type type, const void* values, SizeT elementSize, SizeT count);
+
+    void* valueBuffer;
+    Ptr<CoreGraphics::Texture> texture;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const void*
+NullShaderVariable::GetValueBuffer() const
+{
+    return this->valueBuffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<CoreGraphics::Texture>&
+NullShaderVariable::GetTexture() const
+{
+    return this->texture;
+}
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
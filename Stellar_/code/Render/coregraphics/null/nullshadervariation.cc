@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------------
+//  nullshadervariation.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullshadervariation.h"
+
+namespace Null
+{
+ImplementClass(Null::NullShaderVariation, 'NLVR', Base::ShaderVariationBase);
+
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderVariation::NullShaderVariation()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullShaderVariation::~NullShaderVariation()
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullShaderVariation::Setup(const Name& n, ShaderFeature::Mask mask, SizeT passes)
+{
+    s_assert(passes > 0);
+    this->SetName(n);
+    this->SetFeatureMask(mask);
+    this->SetNumPasses(passes);
+}
+
+} // namespace Null
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef NULL_NULLSHADERVARIATION_H
+#define NULL_NULLSHADERVARIATION_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullShaderVariation
+
+    ShaderVariation of the null renderer, set up from the variations
+    declared on a NullShader.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/shadervariationbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullShaderVariation : public Base::ShaderVariationBase
+{
+    DeclareClass(NullShaderVariation);
+public:
+    /// constructor
+    NullShaderVariation();
+    /// destructor
+    virtual ~NullShaderVariation();
+
+private:
+    friend class NullShaderInstance;
+    /// setup the variation
+    void Setup(const Name& name, CoreGraphics::ShaderFeature::Mask featureMask, SizeT numPasses);
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
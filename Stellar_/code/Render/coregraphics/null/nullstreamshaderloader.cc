@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------
+//  nullstreamshaderloader.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullstreamshaderloader.h"
+#include "coregraphics/null/nullshader.h"
+
+namespace Null
+{
+ImplementClass(Null::NullStreamShaderLoader, 'NLSL', Resources::ResourceLoader);
+
+using namespace Resources;
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullStreamShaderLoader::CanLoadAsync() const
+{
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullStreamShaderLoader::OnLoadRequested()
+{
+    s_assert(this->GetState() == Resource::Initial);
+    s_assert(this->resource.isvalid());
+    s_assert(!this->resource->IsAsyncEnabled());
+    s_assert(this->resource->IsA(NullShader::RTTI));
+    this->SetState(Resource::Loaded);
+    return true;
+}
+
+} // namespace Null
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef NULL_NULLSTREAMSHADERLOADER_H
+#define NULL_NULLSTREAMSHADERLOADER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullStreamShaderLoader
+
+    StreamShaderLoader of the null renderer. The compiled effect isn't
+    read since there's nothing to run it on, the shader is set to loaded
+    right away and its variables and variations are declared by the
+    application, see NullShader.
+
+    (C) 2007 by Ctuo
+*/
+#include "resources/resourceloader.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullStreamShaderLoader : public Resources::ResourceLoader
+{
+    DeclareClass(NullStreamShaderLoader);
+public:
+    /// return true if asynchronous loading is supported
+    virtual bool CanLoadAsync() const;
+    /// called by resource when a load is requested
+    virtual bool OnLoadRequested();
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
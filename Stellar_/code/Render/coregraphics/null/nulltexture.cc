@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//  nulltexture.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nulltexture.h"
+
+namespace Null
+{
+ImplementClass(Null::NullTexture, 'NLTX', Base::TextureBase);
+
+using namespace CoreGraphics;
+
+namespace
+{
+//------------------------------------------------------------------------------
+/**
+    Returns the number of bytes of a pixel, or of a 4x4 block for the
+    compressed formats.
+*/
+SizeT
+GetBytesPerElement(PixelFormat::Code pixelFormat)
+{
+    switch (pixelFormat)
+    {
+        case PixelFormat::A8:
+            return 1;
+        case PixelFormat::R5G6B5:
+        case PixelFormat::A1R5G5B5:
+        case PixelFormat::A4R4G4B4:
+        case PixelFormat::R16F:
+            return 2;
+        case PixelFormat::DXT1:
+        case PixelFormat::LINDXT1:
+        case PixelFormat::A16B16G16R16F:
+        case PixelFormat::G32R32F:
+            return 8;
+        case PixelFormat::DXT3:
+        case PixelFormat::DXT5:
+        case PixelFormat::LINDXT3:
+        case PixelFormat::LINDXT5:
+        case PixelFormat::A32B32G32R32F:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+IsBlockCompressed(PixelFormat::Code pixelFormat)
+{
+    switch (pixelFormat)
+    {
+        case PixelFormat::DXT1:
+        case PixelFormat::DXT3:
+        case PixelFormat::DXT5:
+        case PixelFormat::LINDXT1:
+        case PixelFormat::LINDXT3:
+        case PixelFormat::LINDXT5:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullTexture::NullTexture() :
+    pixels(0),
+    byteSize(0),
+    mapCount(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullTexture::~NullTexture()
+{
+    s_assert(0 == this->pixels);
+    s_assert(0 == this->mapCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullTexture::Unload()
+{
+    s_assert(0 == this->mapCount);
+    if (0 != this->pixels)
+    {
+        Memory::Free(this->pixels);
+        this->pixels = 0;
+    }
+    this->byteSize = 0;
+    this->levels.Clear();
+    TextureBase::Unload();
+}
+
+//------------------------------------------------------------------------------
+/**
+    The mip levels of a face follow each other in the pixel buffer,
+    the faces of a cube texture follow each other as well.
+*/
+void
+NullTexture::Setup(Type t, SizeT w, SizeT h, SizeT d, SizeT numMips, PixelFormat::Code fmt)
+{
+    s_assert(0 == this->pixels);
+    s_assert(InvalidType != t);
+    s_assert((w > 0) && (h > 0) && (d > 0) && (numMips > 0));
+    s_assert((Texture3D == t) || (1 == d));
+
+    this->SetType(t);
+    this->SetWidth(w);
+    this->SetHeight(h);
+    this->SetDepth(d);
+    this->SetNumMipLevels(numMips);
+    this->SetPixelFormat(fmt);
+
+    // compute the layout of the mip levels
+    SizeT numFaces = (TextureCube == t) ? 6 : 1;
+    SizeT bytesPerElement = GetBytesPerElement(fmt);
+    bool blockCompressed = IsBlockCompressed(fmt);
+    SizeT offset = 0;
+    IndexT face;
+    for (face = 0; face < numFaces; face++)
+    {
+        IndexT mipLevel;
+        for (mipLevel = 0; mipLevel < numMips; mipLevel++)
+        {
+            SizeT mipWidth = ((w >> mipLevel) > 0) ? (w >> mipLevel) : 1;
+            SizeT mipHeight = ((h >> mipLevel) > 0) ? (h >> mipLevel) : 1;
+            SizeT mipDepth = ((d >> mipLevel) > 0) ? (d >> mipLevel) : 1;
+            SizeT numColumns = blockCompressed ? ((mipWidth + 3) / 4) : mipWidth;
+            SizeT numRows = blockCompressed ? ((mipHeight + 3) / 4) : mipHeight;
+
+            MapInfo level;
+            level.data = (void*) offset;
+            level.rowPitch = numColumns * bytesPerElement;
+            level.depthPitch = (Texture3D == t) ? (level.rowPitch * numRows) : 0;
+            this->levels.Append(level);
+            offset += level.rowPitch * numRows * mipDepth;
+        }
+    }
+
+    // allocate the pixels and turn the offsets into pointers
+    this->byteSize = offset;
+    this->pixels = Memory::Alloc(this->byteSize);
+    Memory::Clear(this->pixels, this->byteSize);
+    IndexT i;
+    for (i = 0; i < this->levels.Size(); i++)
+    {
+        this->levels[i].data = (uchar*) this->pixels + (size_t) this->levels[i].data;
+    }
+    this->SetState(Resource::Loaded);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullTexture::Map(IndexT mipLevel, MapType mapType, MapInfo& outMapInfo)
+{
+    s_assert((this->type == Texture2D) || (this->type == Texture3D));
+    s_assert(MapWriteNoOverwrite != mapType);
+    s_assert((mipLevel >= 0) && (mipLevel < this->numMipLevels));
+    outMapInfo = this->levels[mipLevel];
+    this->mapCount++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullTexture::Unmap(IndexT mipLevel)
+{
+    s_assert((this->type == Texture2D) || (this->type == Texture3D));
+    s_assert(this->mapCount > 0);
+    this->mapCount--;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+NullTexture::MapCubeFace(CubeFace face, IndexT mipLevel, MapType mapType, MapInfo& outMapInfo)
+{
+    s_assert(TextureCube == this->type);
+    s_assert(MapWriteNoOverwrite != mapType);
+    s_assert((mipLevel >= 0) && (mipLevel < this->numMipLevels));
+    outMapInfo = this->levels[face * this->numMipLevels + mipLevel];
+    this->mapCount++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullTexture::UnmapCubeFace(CubeFace face, IndexT mipLevel)
+{
+    s_assert(TextureCube == this->type);
+    s_assert(this->mapCount > 0);
+    this->mapCount--;
+}
+
+} // namespace Null
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef NULL_NULLTEXTURE_H
+#define NULL_NULLTEXTURE_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullTexture
+
+    Texture of the null renderer. The pixels of all faces and mip levels
+    are kept in one CPU-side buffer, so textures can be mapped and filled
+    like on a real device.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/texturebase.h"
+#include "utility/array.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullTexture : public Base::TextureBase
+{
+    DeclareClass(NullTexture);
+public:
+    /// constructor
+    NullTexture();
+    /// destructor
+    virtual ~NullTexture();
+
+    /// unload the resource, or cancel the pending load
+    virtual void Unload();
+    /// map a texture mip level for CPU access
+    bool Map(IndexT mipLevel, MapType mapType, MapInfo& outMapInfo);
+    /// unmap texture after CPU access
+    void Unmap(IndexT mipLevel);
+    /// map a cube map face for CPU access
+    bool MapCubeFace(CubeFace face, IndexT mipLevel, MapType mapType, MapInfo& outMapInfo);
+    /// unmap cube map face after CPU access
+    void UnmapCubeFace(CubeFace face, IndexT mipLevel);
+
+    /// allocate the pixel buffer and set the texture to loaded
+    void Setup(Type type, SizeT width, SizeT height, SizeT depth, SizeT numMipLevels, CoreGraphics::PixelFormat::Code pixelFormat);
+    /// get the size of the pixel buffer in bytes
+    SizeT GetByteSize() const;
+
+private:
+    void* pixels;
+    SizeT byteSize;
+    Util::Array<MapInfo> levels;    // one entry per mip level of each face
+    int mapCount;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+NullTexture::GetByteSize() const
+{
+    return this->byteSize;
+}
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
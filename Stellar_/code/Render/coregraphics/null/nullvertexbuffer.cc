@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//  nullvertexbuffer.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "coregraphics/null/nullvertexbuffer.h"
+
+namespace Null
+{
+ImplementClass(Null::NullVertexBuffer, 'NLVB', Base::VertexBufferBase);
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullVertexBuffer::NullVertexBuffer() :
+    vertexData(0),
+    vertexDataSize(0),
+    mapCount(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+NullVertexBuffer::~NullVertexBuffer()
+{
+    s_assert(0 == this->vertexData);
+    s_assert(0 == this->mapCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullVertexBuffer::Unload()
+{
+    s_assert(0 == this->mapCount);
+    if (0 != this->vertexData)
+    {
+        Memory::Free(this->vertexData);
+        this->vertexData = 0;
+        this->vertexDataSize = 0;
+    }
+    VertexBufferBase::Unload();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullVertexBuffer::SetVertexData(void* ptr, SizeT numBytes)
+{
+    s_assert(0 == this->vertexData);
+    s_assert(0 != ptr);
+    this->vertexData = ptr;
+    this->vertexDataSize = numBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void*
+NullVertexBuffer::Map(MapType mapType)
+{
+    s_assert(0 != this->vertexData);
+    this->mapCount++;
+    return this->vertexData;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+NullVertexBuffer::Unmap()
+{
+    s_assert(0 != this->vertexData);
+    s_assert(this->mapCount > 0);
+    this->mapCount--;
+}
+
+} // namespace Null
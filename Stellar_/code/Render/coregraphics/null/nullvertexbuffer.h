@@ -0,0 +1,47 @@
+#pragma once
+#ifndef NULL_NULLVERTEXBUFFER_H
+#define NULL_NULLVERTEXBUFFER_H
+//------------------------------------------------------------------------------
+/**
+    @class Null::NullVertexBuffer
+
+    Vertex buffer of the null renderer, the vertices are kept in a
+    CPU-side buffer.
+
+    (C) 2007 by Ctuo
+*/
+#include "coregraphics/base/vertexbufferbase.h"
+
+//------------------------------------------------------------------------------
+namespace Null
+{
+class NullVertexBuffer : public Base::VertexBufferBase
+{
+    DeclareClass(NullVertexBuffer);
+public:
+    /// constructor
+    NullVertexBuffer();
+    /// destructor
+    virtual ~NullVertexBuffer();
+
+    /// unload the resource, or cancel the pending load
+    virtual void Unload();
+    /// map the vertices for CPU access
+    void* Map(MapType mapType);
+    /// unmap the resource
+    void Unmap();
+
+private:
+    friend class NullMemoryVertexBufferLoader;
+
+    /// set the vertex data, the vertex buffer takes ownership
+    void SetVertexData(void* ptr, SizeT numBytes);
+
+    void* vertexData;
+    SizeT vertexDataSize;
+    int mapCount;
+};
+
+} // namespace Null
+//------------------------------------------------------------------------------
+#endif
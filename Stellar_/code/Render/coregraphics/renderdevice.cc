@@ -7,9 +7,12 @@
 
 namespace CoreGraphics
 {
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 ImplementClass(CoreGraphics::RenderDevice, 'RDVC', Direct3D9::D3D9RenderDevice);
 ImplementSingleton(CoreGraphics::RenderDevice);
+#elif NEBULA3_USENULLRENDERER
+ImplementClass(CoreGraphics::RenderDevice, 'RDVC', Null::NullRenderDevice);
+ImplementSingleton(CoreGraphics::RenderDevice);
 #else
 #error "RenderDevice class not implemented on this platform!"
 #endif
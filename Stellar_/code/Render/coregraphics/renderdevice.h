@@ -12,7 +12,8 @@
     
     (C) 2006 Radon Labs GmbH
 */    
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9renderdevice.h"
 namespace CoreGraphics
 {
@@ -27,6 +28,21 @@ public:
     virtual ~RenderDevice();
 };
 } // namespace CoreGraphics
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullrenderdevice.h"
+namespace CoreGraphics
+{
+class RenderDevice : public Null::NullRenderDevice
+{
+    DeclareClass(RenderDevice);
+    DeclareSingleton(RenderDevice);
+public:
+    /// constructor
+    RenderDevice();
+    /// destructor
+    virtual ~RenderDevice();
+};
+} // namespace CoreGraphics
 #else
 #error "RenderDevice class not implemented on this platform!"
 #endif
@@ -4,11 +4,16 @@
 //------------------------------------------------------------------------------
 #include "stdneb.h"
 #include "coregraphics/rendertarget.h"
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::RenderTarget, 'RTGT', Direct3D9::D3D9RenderTarget);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::RenderTarget, 'RTGT', Null::NullRenderTarget);
+}
 #else
 #error "RenderTarget class not implemented on this platform!"
 #endif
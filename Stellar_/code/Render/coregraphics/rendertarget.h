@@ -11,7 +11,8 @@
 
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9rendertarget.h"
 namespace CoreGraphics
 {
@@ -20,6 +21,15 @@ class RenderTarget : public Direct3D9::D3D9RenderTarget
     DeclareClass(RenderTarget);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullrendertarget.h"
+namespace CoreGraphics
+{
+class RenderTarget : public Null::NullRenderTarget
+{
+    DeclareClass(RenderTarget);
+};
+}
 #else
 #error "RenderTarget class not implemented on this platform!"
 #endif
@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/shader.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::Shader, 'SHDR', Direct3D9::D3D9Shader);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::Shader, 'SHDR', Null::NullShader);
+}
 #else
 #error "Shader class not implemented on this platform!"
 #endif
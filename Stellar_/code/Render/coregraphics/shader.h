@@ -10,7 +10,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9shader.h"
 namespace CoreGraphics
 {
@@ -19,6 +20,15 @@ class Shader : public Direct3D9::D3D9Shader
     DeclareClass(Shader);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullshader.h"
+namespace CoreGraphics
+{
+class Shader : public Null::NullShader
+{
+    DeclareClass(Shader);
+};
+}
 #else
 #error "Shader class not implemented on this platform!"
 #endif
@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/shaderinstance.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::ShaderInstance, 'SINS', Direct3D9::D3D9ShaderInstance);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::ShaderInstance, 'SINS', Null::NullShaderInstance);
+}
 #else
 #error "ShaderInstance class not implemented on this platform!"
 #endif
@@ -12,7 +12,8 @@
 
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9shaderinstance.h"
 namespace CoreGraphics
 {
@@ -21,6 +22,15 @@ class ShaderInstance : public Direct3D9::D3D9ShaderInstance
     DeclareClass(ShaderInstance);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullshaderinstance.h"
+namespace CoreGraphics
+{
+class ShaderInstance : public Null::NullShaderInstance
+{
+    DeclareClass(ShaderInstance);
+};
+}
 #else
 #error "ShaderInstance class not implemented on this platform!"
 #endif
@@ -7,9 +7,12 @@
 
 namespace CoreGraphics
 {
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 ImplementClass(CoreGraphics::ShaderServer, 'SHSV', Direct3D9::D3D9ShaderServer);
 ImplementSingleton(CoreGraphics::ShaderServer);
+#elif NEBULA3_USENULLRENDERER
+ImplementClass(CoreGraphics::ShaderServer, 'SHSV', Null::NullShaderServer);
+ImplementSingleton(CoreGraphics::ShaderServer);
 #else
 #error "Texture class not implemented on this platform!"
 #endif
@@ -10,7 +10,8 @@
     
     (C) 2007 Radon Labs GmbH
 */    
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9shaderserver.h"
 namespace CoreGraphics
 {
@@ -25,6 +26,21 @@ public:
     virtual ~ShaderServer();
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullshaderserver.h"
+namespace CoreGraphics
+{
+class ShaderServer : public Null::NullShaderServer
+{
+    DeclareClass(ShaderServer);
+    DeclareSingleton(ShaderServer);
+public:
+    /// constructor
+    ShaderServer();
+    /// destructor
+    virtual ~ShaderServer();
+};
+}
 #else
 #error "ShaderServer class not implemented on this platform!"
 #endif
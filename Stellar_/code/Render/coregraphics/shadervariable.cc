@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/shadervariable.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::ShaderVariable, 'SHDV', Direct3D9::D3D9ShaderVariable);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::ShaderVariable, 'SHDV', Null::NullShaderVariable);
+}
 #else
 #error "ShaderVariable class not implemented on this platform!"
 #endif
@@ -12,7 +12,8 @@
 
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9shadervariable.h"
 namespace CoreGraphics
 {
@@ -21,6 +22,15 @@ class ShaderVariable : public Direct3D9::D3D9ShaderVariable
     DeclareClass(ShaderVariable);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullshadervariable.h"
+namespace CoreGraphics
+{
+class ShaderVariable : public Null::NullShaderVariable
+{
+    DeclareClass(ShaderVariable);
+};
+}
 #else
 #error "ShaderVariable class not implemented on this platform!"
 #endif
@@ -5,10 +5,10 @@
 #include "stdneb.h"
 #include "coregraphics/shadervariableinstance.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9 || NEBULA3_USENULLRENDERER
 namespace CoreGraphics
 {
-ImplementClass(CoreGraphics::ShaderVariableInstance, 'SDVI', Base::ShaderVariableInstanceBase);
+ImplementPooledClass(CoreGraphics::ShaderVariableInstance, 'SDVI', Base::ShaderVariableInstanceBase);
 }
 #else
 #error "ShaderVariableInstance class not implemented on this platform!"
@@ -15,13 +15,14 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9 || NEBULA3_USENULLRENDERER
 #include "coregraphics/base/shadervariableinstancebase.h"
 namespace CoreGraphics
 {
 class ShaderVariableInstance : public Base::ShaderVariableInstanceBase
 {
-    DeclareClass(ShaderVariableInstance);
+    DeclarePooledClass(ShaderVariableInstance);
 };
 }
 #else
@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/shadervariation.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::ShaderVariation, 'SHVR', Direct3D9::D3D9ShaderVariation);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::ShaderVariation, 'SHVR', Null::NullShaderVariation);
+}
 #else
 #error "ShaderVariation class not implemented on this platform!"
 #endif
@@ -10,7 +10,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9shadervariation.h"
 namespace CoreGraphics
 {
@@ -19,6 +20,15 @@ class ShaderVariation : public Direct3D9::D3D9ShaderVariation
     DeclareClass(ShaderVariation);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullshadervariation.h"
+namespace CoreGraphics
+{
+class ShaderVariation : public Null::NullShaderVariation
+{
+    DeclareClass(ShaderVariation);
+};
+}
 #else
 #error "ShaderVariation class not implemented on this platform!"
 #endif
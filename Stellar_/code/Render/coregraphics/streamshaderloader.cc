@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/streamshaderloader.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::StreamShaderLoader, 'SSDL', Direct3D9::D3D9StreamShaderLoader);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::StreamShaderLoader, 'SSDL', Null::NullStreamShaderLoader);
+}
 #else
 #error "StreamShaderLoader class not implemented on this platform!"
 #endif
@@ -9,7 +9,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9streamshaderloader.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class StreamShaderLoader : public Direct3D9::D3D9StreamShaderLoader
     DeclareClass(StreamShaderLoader);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullstreamshaderloader.h"
+namespace CoreGraphics
+{
+class StreamShaderLoader : public Null::NullStreamShaderLoader
+{
+    DeclareClass(StreamShaderLoader);
+};
+}
 #else
 #error "StreamShaderLoader class not implemented on this platform!"
 #endif
@@ -5,11 +5,16 @@
 #include "stdneb.h"
 #include "coregraphics/texture.h"
 
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 ImplementClass(CoreGraphics::Texture, 'TEXR', Direct3D9::D3D9Texture);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+ImplementClass(CoreGraphics::Texture, 'TEXR', Null::NullTexture);
+}
 #else
 #error "Texture class not implemented on this platform!"
 #endif
@@ -9,7 +9,8 @@
     
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9texture.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class Texture : public Direct3D9::D3D9Texture
     DeclareClass(Texture);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nulltexture.h"
+namespace CoreGraphics
+{
+class Texture : public Null::NullTexture
+{
+    DeclareClass(Texture);
+};
+}
 #else
 #error "Texture class not implemented on this platform!"
 #endif
@@ -15,7 +15,8 @@
 
     (C) 2007 Radon Labs GmbH
 */
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9 || NEBULA3_USENULLRENDERER
 #include "coregraphics/base/transformdevicebase.h"
 namespace CoreGraphics
 {
@@ -4,11 +4,16 @@
 //------------------------------------------------------------------------------
 #include "stdneb.h"
 #include "coregraphics/vertexbuffer.h"
-#if __WIN32__
+#if NEBULA3_USEDIRECT3D9
 namespace CoreGraphics
 {
 	ImplementClass(CoreGraphics::VertexBuffer, 'VTXB', Direct3D9::D3D9VertexBuffer);
 }
+#elif NEBULA3_USENULLRENDERER
+namespace CoreGraphics
+{
+	ImplementClass(CoreGraphics::VertexBuffer, 'VTXB', Null::NullVertexBuffer);
+}
 #else
 #error "VertexBuffer class not implemented on this platform!"
 #endif
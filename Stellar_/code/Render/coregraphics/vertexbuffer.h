@@ -9,7 +9,8 @@ A resource which holds an array of vertices.
 
 (C) 2007 by ctuo
 */    
-#if __WIN32__
+#include "coregraphics/config.h"
+#if NEBULA3_USEDIRECT3D9
 #include "coregraphics/d3d9/d3d9vertexbuffer.h"
 namespace CoreGraphics
 {
@@ -18,6 +19,15 @@ class VertexBuffer : public Direct3D9::D3D9VertexBuffer
 	DeclareClass(VertexBuffer);
 };
 }
+#elif NEBULA3_USENULLRENDERER
+#include "coregraphics/null/nullvertexbuffer.h"
+namespace CoreGraphics
+{
+class VertexBuffer : public Null::NullVertexBuffer
+{
+	DeclareClass(VertexBuffer);
+};
+}
 #else
 #error "VertexBuffer class not implemented on this platform!"
 #endif
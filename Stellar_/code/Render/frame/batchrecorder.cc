@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//  batchrecorder.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "frame/batchrecorder.h"
+#include "frame/framebatch.h"
+#include "thread/interlocked.h"
+
+namespace Frame
+{
+ImplementClass(Frame::BatchRecorder, 'FBRC', Core::RefCounted);
+
+using namespace Util;
+using namespace Threading;
+
+namespace
+{
+/// next batch index while the batches are being replaced
+const int NoBatch = 0x7fffffff;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+BatchRecorder::BatchRecorder() :
+    batches(0),
+    numBatches(0),
+    nextBatch(0),
+    numPending(0),
+    isOpen(false)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+BatchRecorder::~BatchRecorder()
+{
+    if (this->IsOpen())
+    {
+        this->Close();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+BatchRecorder::Open(SizeT numThreads)
+{
+    s_assert(!this->IsOpen());
+    IndexT i;
+    for (i = 0; i < numThreads; i++)
+    {
+        Ptr<BatchRecordThread> thread = BatchRecordThread::Create();
+        thread->SetRecorder(this);
+        thread->SetName("BatchRecordThread");
+        thread->Start();
+        this->threads.Append(thread);
+    }
+    this->isOpen = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+BatchRecorder::Close()
+{
+    s_assert(this->IsOpen());
+    s_assert(0 == this->numPending);
+    IndexT i;
+    for (i = 0; i < this->threads.Size(); i++)
+    {
+        this->threads[i]->Stop();
+    }
+    this->threads.Clear();
+    this->isOpen = false;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The next batch index is parked at NoBatch while the batches are
+    replaced, so a record thread which is still looking at the index of
+    the last Record() can't claim a batch before everything is set up.
+*/
+void
+BatchRecorder::Record(const Array<FrameBatch*>& batchArray)
+{
+    s_assert(0 == this->numPending);
+    if (batchArray.IsEmpty())
+    {
+        return;
+    }
+    Interlocked::Exchange(this->nextBatch, NoBatch);
+    this->batches = &batchArray[0];
+    this->numBatches = batchArray.Size();
+    this->numPending = batchArray.Size();
+    Interlocked::Exchange(this->nextBatch, 0);
+
+    // wake up as many threads as there are batches left for them
+    SizeT numWakeups = batchArray.Size() - 1;
+    if (numWakeups > this->threads.Size())
+    {
+        numWakeups = this->threads.Size();
+    }
+    IndexT i;
+    for (i = 0; i < numWakeups; i++)
+    {
+        this->threads[i]->Wakeup();
+    }
+
+    // help recording, then wait for the batches of the other threads, the
+    // pending count is read with an interlocked operation, so everything
+    // the record threads wrote into the batches is visible afterwards
+    this->RecordPendingBatches();
+    while (0 != Interlocked::CompareExchange(this->numPending, 0, 0))
+    {
+        this->doneEvent.Wait();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Batches are claimed one at a time, so a thread which gets a batch
+    with many draw items doesn't hold up the others.
+*/
+void
+BatchRecorder::RecordPendingBatches()
+{
+    for (;;)
+    {
+        int index = this->nextBatch;
+        if (index >= this->numBatches)
+        {
+            break;
+        }
+        if (index != Interlocked::CompareExchange(this->nextBatch, index + 1, index))
+        {
+            continue;
+        }
+        this->batches[index]->Record();
+        if (0 == Interlocked::Decrement(this->numPending))
+        {
+            this->doneEvent.Signal();
+        }
+    }
+}
+
+} // namespace Frame
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef FRAME_BATCHRECORDER_H
+#define FRAME_BATCHRECORDER_H
+//------------------------------------------------------------------------------
+/**
+    @class Frame::BatchRecorder
+
+    Records the command lists of frame batches in parallel. Record()
+    hands the batches out to the record threads one at a time, the
+    calling thread records batches as well and returns when all batches
+    have been recorded. The recorded batches are then rendered in their
+    usual order on the render thread, see FrameShader::Render().
+
+    Without record threads, Record() records all batches on the calling
+    thread.
+
+    (C) 2007 by Ctuo
+*/
+#include "core/refcounted.h"
+#include "utility/array.h"
+#include "thread/event.h"
+#include "frame/batchrecordthread.h"
+
+//------------------------------------------------------------------------------
+namespace Frame
+{
+class FrameBatch;
+
+class BatchRecorder : public Core::RefCounted
+{
+    DeclareClass(BatchRecorder);
+public:
+    /// constructor
+    BatchRecorder();
+    /// destructor
+    virtual ~BatchRecorder();
+
+    /// start the record threads
+    void Open(SizeT numThreads);
+    /// stop the record threads
+    void Close();
+    /// return true if open
+    bool IsOpen() const;
+    /// get number of record threads
+    SizeT GetNumThreads() const;
+
+    /// record the batches, returns when all have been recorded
+    void Record(const Util::Array<FrameBatch*>& batches);
+    /// record batches until none are left, called by the record threads
+    void RecordPendingBatches();
+
+private:
+    Util::Array<Ptr<BatchRecordThread>> threads;
+    FrameBatch* const* batches;
+    int volatile numBatches;
+    int volatile nextBatch;
+    int volatile numPending;
+    Threading::Event doneEvent;
+    bool isOpen;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+BatchRecorder::IsOpen() const
+{
+    return this->isOpen;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+BatchRecorder::GetNumThreads() const
+{
+    return this->threads.Size();
+}
+
+} // namespace Frame
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//  batchrecordthread.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "frame/batchrecordthread.h"
+#include "frame/batchrecorder.h"
+
+namespace Frame
+{
+ImplementClass(Frame::BatchRecordThread, 'FBRT', Threading::Thread);
+
+//------------------------------------------------------------------------------
+/**
+*/
+BatchRecordThread::BatchRecordThread() :
+    recorder(0)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+BatchRecordThread::EmitWakeupSignal()
+{
+    this->wakeupEvent.Signal();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+BatchRecordThread::DoWork()
+{
+    s_assert(0 != this->recorder);
+    while (!this->ThreadStopRequested())
+    {
+        this->wakeupEvent.Wait();
+        this->recorder->RecordPendingBatches();
+    }
+}
+
+} // namespace Frame
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef FRAME_BATCHRECORDTHREAD_H
+#define FRAME_BATCHRECORDTHREAD_H
+//------------------------------------------------------------------------------
+/**
+    @class Frame::BatchRecordThread
+
+    A worker thread of the BatchRecorder. Sleeps until it is woken up,
+    then records pending frame batches until none are left.
+
+    (C) 2007 by Ctuo
+*/
+#include "thread/thread.h"
+#include "thread/event.h"
+
+//------------------------------------------------------------------------------
+namespace Frame
+{
+class BatchRecorder;
+
+class BatchRecordThread : public Threading::Thread
+{
+    DeclareClass(BatchRecordThread);
+public:
+    /// constructor
+    BatchRecordThread();
+    /// set the recorder which provides the batches
+    void SetRecorder(BatchRecorder* recorder);
+    /// wake the thread up to record pending batches
+    void Wakeup();
+
+protected:
+    /// wake the thread up so it sees the stop request
+    virtual void EmitWakeupSignal();
+    /// the thread loop
+    virtual void DoWork();
+
+private:
+    BatchRecorder* recorder;
+    Threading::Event wakeupEvent;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+BatchRecordThread::SetRecorder(BatchRecorder* r)
+{
+    s_assert(!this->IsRunning());
+    this->recorder = r;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+BatchRecordThread::Wakeup()
+{
+    this->wakeupEvent.Signal();
+}
+
+} // namespace Frame
+//------------------------------------------------------------------------------
+#endif
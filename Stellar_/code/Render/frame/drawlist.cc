@@ -0,0 +1,241 @@
+//------------------------------------------------------------------------------
+//  drawlist.cc
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "frame/drawlist.h"
+#include "coregraphics/shadervariation.h"
+#include "coregraphics/shaderserver.h"
+
+namespace Frame
+{
+using namespace CoreGraphics;
+
+//------------------------------------------------------------------------------
+/**
+*/
+DrawList::DrawList() :
+    isSorted(true)
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+DrawList::Clear()
+{
+    this->items.Clear();
+    this->itemVariations.Clear();
+    this->entries.Clear();
+    this->isSorted = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+unsigned int
+DrawList::GetId(IdMap& ids, const void* obj, unsigned int firstId, unsigned int maxId)
+{
+    const unsigned int* id = ids.Find(obj);
+    if (0 != id)
+    {
+        return *id;
+    }
+    unsigned int newId = firstId + ids.Size();
+    if (newId > maxId)
+    {
+        newId = maxId;
+    }
+    ids.Add(obj, newId);
+    return newId;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Items of the same shader and feature mask are usually added one after
+    another, so the last lookup is reused while they don't change.
+*/
+void
+DrawList::ResolveVariations()
+{
+    const SizeT num = this->items.Size();
+    this->itemVariations.resize(num);
+    ShaderInstance* lastShader = 0;
+    ShaderFeature::Mask lastFeatures = 0;
+    ShaderVariation* lastVariation = 0;
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        const Item& item = this->items[i];
+        if ((item.shader != lastShader) || (item.features != lastFeatures))
+        {
+            lastShader = item.shader.get();
+            lastFeatures = item.features;
+            lastVariation = lastShader->LookupVariation(lastFeatures);
+            if (0 == lastVariation)
+            {
+                s_error("DrawList: unknown shader variation '%s' in shader '%s'!\n",
+                    ShaderServer::Instance()->FeatureMaskToString(lastFeatures).c_str(),
+                    lastShader->GetOriginalShader()->GetResourceId().Value().c_str());
+            }
+        }
+        this->itemVariations[i] = lastVariation;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Builds the sort keys of all items and sorts them. The ids of
+    variations, materials and vertex buffers are handed out anew
+    for every sort.
+*/
+void
+DrawList::Sort(SortingMode::Code sortingMode)
+{
+    const SizeT num = this->items.Size();
+    this->entries.resize(num);
+    this->scratch.resize(num);
+    this->variationIds.Clear();
+    this->materialIds.Clear();
+    this->vertexBufferIds.Clear();
+    this->isSorted = true;
+    if (0 == num)
+    {
+        return;
+    }
+
+    // get the depth range for the quantization
+    const unsigned int maxDepth = (1 << NumDepthBits) - 1;
+    float depthScale = 0.0f;
+    float minDepth = this->items[0].depth;
+    if (SortingMode::None != sortingMode)
+    {
+        float maxItemDepth = minDepth;
+        IndexT i;
+        for (i = 1; i < num; i++)
+        {
+            float depth = this->items[i].depth;
+            if (depth < minDepth)       minDepth = depth;
+            if (depth > maxItemDepth)   maxItemDepth = depth;
+        }
+        if (maxItemDepth > minDepth)
+        {
+            depthScale = float(maxDepth) / (maxItemDepth - minDepth);
+        }
+    }
+
+    // build the keys
+    this->ResolveVariations();
+    const unsigned int maxVariationId = (1 << NumVariationBits) - 1;
+    const unsigned int maxMaterialId = (1 << NumMaterialBits) - 1;
+    const unsigned int maxVertexBufferId = (1 << NumVertexBufferBits) - 1;
+    const unsigned int stateBits = NumVariationBits + NumMaterialBits + NumVertexBufferBits;
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        const Item& item = this->items[i];
+
+        // the state, material id 0 means no material
+        SortKey state = GetId(this->variationIds, this->itemVariations[i], 0, maxVariationId);
+        state <<= NumMaterialBits;
+        if (item.material.isvalid())
+        {
+            state |= GetId(this->materialIds, item.material.get(), 1, maxMaterialId);
+        }
+        state <<= NumVertexBufferBits;
+        state |= GetId(this->vertexBufferIds, item.vertexBuffer.get(), 0, maxVertexBufferId);
+
+        // the quantized depth
+        SortKey depth = 0;
+        if (SortingMode::None != sortingMode)
+        {
+            float scaled = (item.depth - minDepth) * depthScale;
+            depth = (scaled < float(maxDepth)) ? SortKey(scaled) : SortKey(maxDepth);
+            if (SortingMode::BackToFront == sortingMode)
+            {
+                depth = maxDepth - depth;
+            }
+        }
+
+        SortKey key = SortKey(item.pass) << (NumDepthBits + stateBits);
+        if (SortingMode::BackToFront == sortingMode)
+        {
+            key |= (depth << stateBits) | state;
+        }
+        else
+        {
+            key |= (state << NumDepthBits) | depth;
+        }
+        this->entries[i].key = key;
+        this->entries[i].itemIndex = i;
+    }
+
+    this->RadixSort();
+}
+
+//------------------------------------------------------------------------------
+/**
+    LSD radix sort over the 8 bytes of the keys. The histograms of all
+    bytes are built in one go, bytes which are the same in all keys
+    (e.g. an unused pass or an unsorted depth) are skipped. The sort is
+    stable, so items with equal keys keep the order they were added in.
+*/
+void
+DrawList::RadixSort()
+{
+    const SizeT num = this->entries.Size();
+    const IndexT numDigits = sizeof(SortKey);
+
+    SizeT counts[numDigits][256];
+    Memory::Clear(counts, sizeof(counts));
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        SortKey key = this->entries[i].key;
+        IndexT digit;
+        for (digit = 0; digit < numDigits; digit++)
+        {
+            counts[digit][(unsigned int)(key >> (digit * 8)) & 0xff]++;
+        }
+    }
+
+    SortEntry* src = &this->entries[0];
+    SortEntry* dst = &this->scratch[0];
+    IndexT digit;
+    for (digit = 0; digit < numDigits; digit++)
+    {
+        const unsigned int shift = digit * 8;
+        SizeT* digitCounts = counts[digit];
+        if (num == digitCounts[(unsigned int)(src[0].key >> shift) & 0xff])
+        {
+            continue;
+        }
+
+        // turn the counts into start offsets
+        SizeT offset = 0;
+        IndexT value;
+        for (value = 0; value < 256; value++)
+        {
+            SizeT count = digitCounts[value];
+            digitCounts[value] = offset;
+            offset += count;
+        }
+
+        for (i = 0; i < num; i++)
+        {
+            dst[digitCounts[(unsigned int)(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+        SortEntry* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != &this->entries[0])
+    {
+        Memory::Copy(src, &this->entries[0], num * sizeof(SortEntry));
+    }
+}
+
+} // namespace Frame
@@ -0,0 +1,199 @@
+#pragma once
+#ifndef FRAME_DRAWLIST_H
+#define FRAME_DRAWLIST_H
+//------------------------------------------------------------------------------
+/**
+    @class Frame::DrawList
+
+    The draw items of a FrameBatch for one frame. Sort() packs the state
+    of every item into a 64 bit key and sorts the keys with a LSD radix
+    sort, so items which share a shader pass, variation, material and
+    vertex buffer are rendered one after another.
+
+    The key layout depends on the sorting mode, from the highest to the
+    lowest bits:
+
+    None, FrontToBack:  pass(4) variation(10) material(14) vertexbuffer(12) depth(24)
+    BackToFront:        pass(4) depth(24) variation(10) material(14) vertexbuffer(12)
+
+    So opaque batches are sorted by state and front-to-back within the
+    same state, transparent batches strictly back-to-front. The depth is
+    quantized over the depth range of the items in the list. Variations,
+    materials and vertex buffers get small ids in the order they first
+    appear in the list, if a list uses more of them than the key can
+    hold, the remaining ones share the last id, which only costs some
+    state changes.
+
+    Sort() also resolves the shader variation of every item, once for
+    each run of items with the same shader and feature mask, so the
+    variations don't have to be looked up again when the sorted items
+    are rendered, see GetSortedVariation().
+
+    (C) 2007 by Ctuo
+*/
+#include "core/types.h"
+#include "core/ptr.h"
+#include "utility/array.h"
+#include "utility/flathashmap.h"
+#include "coregraphics/shaderinstance.h"
+#include "coregraphics/shadervariableinstance.h"
+#include "coregraphics/shaderfeature.h"
+#include "coregraphics/vertexbuffer.h"
+#include "coregraphics/indexbuffer.h"
+#include "coregraphics/primitivegroup.h"
+#include "frame/sortingmode.h"
+
+//------------------------------------------------------------------------------
+namespace Frame
+{
+class DrawList
+{
+public:
+    /// a packed sort key
+    typedef unsigned long long SortKey;
+
+    /// a draw call with the state it needs
+    struct Item
+    {
+        /// constructor
+        Item() : features(0), pass(0), depth(0.0f) {}
+
+        Ptr<CoreGraphics::ShaderInstance> shader;               // the shader instance to render with
+        CoreGraphics::ShaderFeature::Mask features;             // selects the shader variation
+        IndexT pass;                                            // pass of the shader variation
+        Ptr<CoreGraphics::ShaderVariableInstance> material;     // optional material state, e.g. the diffuse texture
+        Ptr<CoreGraphics::VertexBuffer> vertexBuffer;
+        Ptr<CoreGraphics::IndexBuffer> indexBuffer;             // optional
+        CoreGraphics::PrimitiveGroup primitiveGroup;
+        float depth;                                            // view space depth
+    };
+
+    /// number of key bits per field
+    static const unsigned int NumPassBits = 4;
+    static const unsigned int NumVariationBits = 10;
+    static const unsigned int NumMaterialBits = 14;
+    static const unsigned int NumVertexBufferBits = 12;
+    static const unsigned int NumDepthBits = 24;
+
+    /// constructor
+    DrawList();
+
+    /// add a draw item
+    void Add(const Item& item);
+    /// remove all items, keeps the memory for the next frame
+    void Clear();
+    /// get number of items
+    SizeT Size() const;
+    /// return true if the list has no items
+    bool IsEmpty() const;
+    /// get an item in the order it has been added
+    const Item& GetItem(IndexT i) const;
+
+    /// build the sort keys and sort the items
+    void Sort(SortingMode::Code sortingMode);
+    /// get an item in sorted order, valid after Sort()
+    const Item& GetSortedItem(IndexT i) const;
+    /// get the sort key of an item in sorted order, valid after Sort()
+    SortKey GetSortedKey(IndexT i) const;
+    /// get the shader variation of an item in sorted order, valid after Sort()
+    CoreGraphics::ShaderVariation* GetSortedVariation(IndexT i) const;
+
+private:
+    /// a key and the index of its item
+    struct SortEntry
+    {
+        SortKey key;
+        IndexT itemIndex;
+    };
+    typedef Util::FlatHashMap<const void*, unsigned int> IdMap;
+
+    /// get the id of an object, ids are handed out in the order objects are seen
+    static unsigned int GetId(IdMap& ids, const void* obj, unsigned int firstId, unsigned int maxId);
+    /// look up the shader variations of all items
+    void ResolveVariations();
+    /// sort the entries by key
+    void RadixSort();
+
+    Util::Array<Item> items;
+    Util::Array<CoreGraphics::ShaderVariation*> itemVariations;    // by item index
+    Util::Array<SortEntry> entries;
+    Util::Array<SortEntry> scratch;
+    IdMap variationIds;
+    IdMap materialIds;
+    IdMap vertexBufferIds;
+    bool isSorted;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+DrawList::Add(const Item& item)
+{
+    s_assert(item.shader.isvalid());
+    s_assert(item.vertexBuffer.isvalid());
+    s_assert(item.pass < (1 << NumPassBits));
+    this->items.Append(item);
+    this->isSorted = false;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+DrawList::Size() const
+{
+    return this->items.Size();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+DrawList::IsEmpty() const
+{
+    return this->items.IsEmpty();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const DrawList::Item&
+DrawList::GetItem(IndexT i) const
+{
+    return this->items[i];
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const DrawList::Item&
+DrawList::GetSortedItem(IndexT i) const
+{
+    s_assert(this->isSorted);
+    return this->items[this->entries[i].itemIndex];
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline DrawList::SortKey
+DrawList::GetSortedKey(IndexT i) const
+{
+    s_assert(this->isSorted);
+    return this->entries[i].key;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline CoreGraphics::ShaderVariation*
+DrawList::GetSortedVariation(IndexT i) const
+{
+    s_assert(this->isSorted);
+    return this->itemVariations[this->entries[i].itemIndex];
+}
+
+} // namespace Frame
+//------------------------------------------------------------------------------
+#endif
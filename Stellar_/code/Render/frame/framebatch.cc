@@ -4,8 +4,8 @@
 //------------------------------------------------------------------------------
 #include "stdneb.h"
 #include "frame/framebatch.h"
-#include "coregraphics/renderdevice.h"
 #include "coregraphics/shaderserver.h"
+#include "debuging/profiler.h"
 //#include "models/visresolver.h"
 //#include "models/model.h"
 //#include "models/modelnodeinstance.h"
@@ -14,7 +14,7 @@
 
 namespace Frame
 {
-ImplementClass(Frame::FrameBatch, 'FBTH', Core::RefCounted);
+ImplementPooledClass(Frame::FrameBatch, 'FBTH', Core::RefCounted);
 
 //using namespace Graphics;
 using namespace CoreGraphics;
@@ -30,7 +30,8 @@ FrameBatch::FrameBatch() :
     //nodeFilter(ModelNodeType::InvalidModelNodeType),
     lightingMode(LightingMode::None),
     sortingMode(SortingMode::None),
-    shaderFeatures(0)
+    shaderFeatures(0),
+    isRecorded(false)
 {
     // empty
 }
@@ -57,109 +58,119 @@ FrameBatch::Discard()
         this->shader = 0;
     }
     this->shaderVariables.clear();
+    this->drawList.Clear();
+    this->commandList.Reset();
+    this->isRecorded = false;
 }
 
 //------------------------------------------------------------------------------
 /**
+    Records the commands of the batch into its command list. This only
+    reads the batch's own data, so different batches can be recorded on
+    different threads at the same time.
 */
 void
-FrameBatch::Render()
+FrameBatch::Record()
 {
-    RenderDevice* renderDevice = RenderDevice::Instance();
+    s_profile("FrameBatch::Record");
+    s_assert(!this->isRecorded);
+    this->commandList.Reset();
 
-    // apply shader variables
+    // apply shader variables, values which didn't change are filtered by the variables
     IndexT varIndex;
     for (varIndex = 0; varIndex < this->shaderVariables.size(); varIndex++)
     {
-        this->shaderVariables[varIndex]->Apply();
+        this->commandList.ApplyVariable(this->shaderVariables[varIndex]);
     }
 
-    // render the batch
-    renderDevice->BeginBatch(this->batchType, this->shader);
-    this->RenderBatch();
-    renderDevice->EndBatch();
+    // record the batch
+    this->commandList.BeginBatch(this->batchType, this->shader);
+    this->RecordDrawList();
+    this->commandList.EndBatch();
+    this->isRecorded = true;
 }
 
 //------------------------------------------------------------------------------
 /**
+    Replays the recorded commands. The draw list is cleared afterwards,
+    since its items keep the objects referenced by the commands alive.
 */
 void
-FrameBatch::RenderBatch()
+FrameBatch::Render()
 {
-    //ShaderServer* shaderServer = ShaderServer::Instance();
-    //VisResolver* visResolver = VisResolver::Instance();
-    //LightServer* lightServer = LightServer::Instance();
-
-    //// for each visible model...
-    //const Array<Ptr<Model>>& models = visResolver->GetVisibleModels(this->nodeFilter);
-    //IndexT modelIndex;
-    //for (modelIndex = 0; modelIndex < models.Size(); modelIndex++)
-    //{
-    //    // for each visible model node of the model...
-    //    const Array<Ptr<ModelNode>>& modelNodes = visResolver->GetVisibleModelNodes(this->nodeFilter, models[modelIndex]);
-    //    IndexT modelNodeIndex;
-    //    for (modelNodeIndex = 0; modelNodeIndex < modelNodes.Size(); modelNodeIndex++)
-    //    {
-    //        // apply render state which is shared by all instances
-    //        shaderServer->ResetFeatureBits();
-    //        shaderServer->SetFeatureBits(this->shaderFeatures);
-    //        const Ptr<ModelNode>& modelNode = modelNodes[modelNodeIndex];            
-    //        modelNode->ApplySharedState();
-
-    //        // if lighting mode is Off, we can render all node instances with the same shader
-    //        const Ptr<ShaderInstance>& shaderInst = shaderServer->GetActiveShaderInstance();
-    //        if (LightingMode::None == this->lightingMode)
-    //        {
-    //            shaderInst->SelectActiveVariation(shaderServer->GetFeatureBits());
-    //            SizeT numPasses = shaderInst->Begin();
-    //            s_assert(1 == numPasses);
-    //            shaderInst->BeginPass(0);
-    //        }
-
-    //        // render instances
-    //        const Array<Ptr<ModelNodeInstance>>& nodeInstances = visResolver->GetVisibleModelNodeInstances(this->nodeFilter, modelNode);
-    //        IndexT nodeInstIndex;
-    //        for (nodeInstIndex = 0; nodeInstIndex < nodeInstances.Size(); nodeInstIndex++)
-    //        {
-    //            const Ptr<ModelNodeInstance>& nodeInstance = nodeInstances[nodeInstIndex];
-
-    //            // if single-pass lighting is enabled, we need to setup the lighting 
-    //            // shader states
-    //            // FIXME: This may set a new shader variation for every node instance
-    //            // which is expensive! Would be better to sort node instances by number
-    //            // of active lights!!!
-    //            if (LightingMode::SinglePass == this->lightingMode)
-    //            {
-    //                // setup lighting render states
-    //                // NOTE: this may change the shader feature bit mask which may select
-    //                // a different shader variation per entity
-    //                const Ptr<ModelEntity>& modelEntity = nodeInstance->GetModelInstance()->GetModelEntity();
-    //                lightServer->ApplyModelEntityLights(modelEntity);
-    //                shaderInst->SelectActiveVariation(shaderServer->GetFeatureBits());
-    //                SizeT numPasses = shaderInst->Begin();
-    //                s_assert(1 == numPasses);
-    //                shaderInst->BeginPass(0);
-    //            }
-
-    //            // render the node instance
-    //            nodeInstance->ApplyState();
-    //            shaderInst->Commit();
-    //            nodeInstance->Render();
-
-    //            if (LightingMode::SinglePass == this->lightingMode)
-    //            {
-    //                shaderInst->EndPass();
-    //                shaderInst->End();
-    //            }
-    //        }
+    s_profile("FrameBatch::Render");
+    if (!this->isRecorded)
+    {
+        this->Record();
+    }
+    this->commandList.Execute();
+    this->isRecorded = false;
+    this->drawList.Clear();
+}
 
-    //        if (LightingMode::None == this->lightingMode)
-    //        {
-    //            shaderInst->EndPass();
-    //            shaderInst->End();
-    //        }                
-    //    }
-    //}
+//------------------------------------------------------------------------------
+/**
+    Sorts the draw items of the frame and records them. Since the items
+    are sorted by pass, variation, material and vertex buffer, those are
+    only switched when they differ from the previous item. The items must
+    be added again every frame.
+*/
+void
+FrameBatch::RecordDrawList()
+{
+    if (this->drawList.IsEmpty())
+    {
+        return;
+    }
+    this->drawList.Sort(this->sortingMode);
+
+    ShaderInstance* curShader = 0;
+    ShaderVariation* curVariation = 0;
+    IndexT curPass = InvalidIndex;
+    ShaderVariableInstance* curMaterial = 0;
+    VertexBuffer* curVertexBuffer = 0;
+    IndexBuffer* curIndexBuffer = 0;
+    IndexT itemIndex;
+    for (itemIndex = 0; itemIndex < this->drawList.Size(); itemIndex++)
+    {
+        const DrawList::Item& item = this->drawList.GetSortedItem(itemIndex);
+        ShaderVariation* variation = this->drawList.GetSortedVariation(itemIndex);
+
+        // switch shader variation and pass
+        if ((item.shader != curShader) || (variation != curVariation) || (item.pass != curPass))
+        {
+            if (0 != curShader)
+            {
+                this->commandList.EndShader(curShader);
+            }
+            curShader = item.shader;
+            curVariation = variation;
+            curPass = item.pass;
+            this->commandList.BeginShader(curShader, curVariation, curPass);
+            curMaterial = 0;
+        }
+
+        // apply material
+        if (item.material.isvalid() && (item.material != curMaterial))
+        {
+            curMaterial = item.material;
+            this->commandList.ApplyVariable(curMaterial);
+        }
+
+        // render the item
+        if (item.vertexBuffer != curVertexBuffer)
+        {
+            curVertexBuffer = item.vertexBuffer;
+            this->commandList.SetVertexBuffer(curVertexBuffer);
+        }
+        if (item.indexBuffer.isvalid() && (item.indexBuffer != curIndexBuffer))
+        {
+            curIndexBuffer = item.indexBuffer;
+            this->commandList.SetIndexBuffer(curIndexBuffer);
+        }
+        this->commandList.Draw(curShader, item.primitiveGroup);
+    }
+    this->commandList.EndShader(curShader);
 }
 
 } // namespace Frame
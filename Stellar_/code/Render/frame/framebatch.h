@@ -6,6 +6,11 @@
     @class Frame::FrameBatch
     
     A frame batch encapsulates the rendering of a batch of ModelNodeInstances.
+
+    The rendering commands of a batch are recorded into a CommandList by
+    Record(), which may run on any thread, and replayed on the render
+    device by Render(). If the batch hasn't been recorded before, Render()
+    records it first.
     
     (C) 2007 Radon Labs GmbH
 */
@@ -17,13 +22,15 @@
 //#include "models/modelnodetype.h"
 #include "frame/lightingmode.h"
 #include "frame/sortingmode.h"
+#include "frame/drawlist.h"
+#include "coregraphics/commandlist.h"
 
 //------------------------------------------------------------------------------
 namespace Frame
 {
 class FrameBatch : public Core::RefCounted
 {
-    DeclareClass(FrameBatch);
+    DeclarePooledClass(FrameBatch);
 public:
     /// constructor
     FrameBatch();
@@ -31,7 +38,9 @@ public:
     virtual ~FrameBatch();
     /// discard the frame batch
     void Discard();
-    /// render the batch
+    /// record the commands of the batch, may be called from any thread
+    void Record();
+    /// render the batch, must be called from the render thread
     void Render();
 
     /// set batch shader
@@ -66,9 +75,16 @@ public:
     /// get shader variable by index
     const Ptr<CoreGraphics::ShaderVariableInstance>& GetVariableByIndex(IndexT i) const;
 
+    /// add a draw item for the current frame, the batch's shader features are added to the item's
+    void AddDrawItem(const DrawList::Item& item);
+    /// get the draw items of the current frame
+    const DrawList& GetDrawList() const;
+    /// get the commands recorded for the current frame, kept until the next Record()
+    const CoreGraphics::CommandList& GetCommandList() const;
+
 private:
-    /// actual rendering method
-    void RenderBatch();
+    /// record the draw items
+    void RecordDrawList();
 
     Ptr<CoreGraphics::ShaderInstance> shader;
     CoreGraphics::BatchType::Code batchType;
@@ -77,6 +93,9 @@ private:
     SortingMode::Code sortingMode;
     CoreGraphics::ShaderFeature::Mask shaderFeatures;
     Util::Array<Ptr<CoreGraphics::ShaderVariableInstance>> shaderVariables;
+    DrawList drawList;
+    CoreGraphics::CommandList commandList;
+    bool isRecorded;
 };
 
 //------------------------------------------------------------------------------
@@ -196,6 +215,35 @@ FrameBatch::GetVariableByIndex(IndexT i) const
     return this->shaderVariables[i];
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+FrameBatch::AddDrawItem(const DrawList::Item& item)
+{
+    DrawList::Item batchItem(item);
+    batchItem.features |= this->shaderFeatures;
+    this->drawList.Add(batchItem);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const DrawList&
+FrameBatch::GetDrawList() const
+{
+    return this->drawList;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline const CoreGraphics::CommandList&
+FrameBatch::GetCommandList() const
+{
+    return this->commandList;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -5,6 +5,7 @@
 #include "stdneb.h"
 #include "frame/framepass.h"
 #include "coregraphics/renderdevice.h"
+#include "debuging/profiler.h"
 
 namespace Frame
 {
@@ -65,6 +66,7 @@ FramePass::Discard()
 void
 FramePass::Render()
 {
+    s_profile("FramePass::Render");
     s_assert(this->renderTarget.isvalid());
     RenderDevice* renderDevice = RenderDevice::Instance();
 
@@ -7,6 +7,7 @@
 #include "coregraphics/memoryvertexbufferloader.h"
 #include "coregraphics/indexbuffer.h"
 #include "coregraphics/renderdevice.h"
+#include "debuging/profiler.h"
 //#include "preshaders/preshaders.h"
 
 namespace Frame
@@ -139,6 +140,7 @@ FramePostEffect::Discard()
 void
 FramePostEffect::Render()
 {
+    s_profile("FramePostEffect::Render");
     s_assert(this->renderTarget.isvalid());
     RenderDevice* renderDevice = RenderDevice::Instance();
 
@@ -7,6 +7,7 @@
 #include "io/ioserver.h"
 #include "io/uri.h"
 #include "frame/frameshaderloader.h"
+#include "debuging/profiler.h"
 
 namespace Frame
 {
@@ -20,6 +21,7 @@ using namespace IO;
 /**
 */
 FrameServer::FrameServer() :
+    numRecordThreads(0),
     isOpen(false)
 {
     ConstructSingleton;
@@ -43,11 +45,13 @@ FrameServer::~FrameServer()
 bool
 FrameServer::Open()
 {
+    s_profile("FrameServer::Open");
     s_assert(!this->IsOpen());
     this->isOpen = true;
 
     // load frame shaders
     Array<String> files = IoServer::Instance()->ListFiles("frame:", "*.xml");
+    this->frameShaders.BeginBulkAdd();
     IndexT fileIndex;
     for (fileIndex = 0; fileIndex < files.Size(); fileIndex++)
     {
@@ -60,6 +64,11 @@ FrameServer::Open()
             this->frameShaders.Add(frameShader->GetName(), frameShader);
         }
     }
+    this->frameShaders.EndBulkAdd();
+
+    // start the batch record threads
+    this->batchRecorder = BatchRecorder::Create();
+    this->batchRecorder->Open(this->numRecordThreads);
     return true;
 }
 
@@ -71,6 +80,10 @@ FrameServer::Close()
 {
     s_assert(this->IsOpen());
 
+    // stop the batch record threads
+    this->batchRecorder->Close();
+    this->batchRecorder = 0;
+
     // discard frame shaders
     IndexT i;
     for (i = 0; i < this->frameShaders.Size(); i++)
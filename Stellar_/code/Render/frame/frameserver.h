@@ -13,6 +13,7 @@
 #include "core/singleton.h"
 #include "resources/resourceid.h"
 #include "frame/frameshader.h"
+#include "frame/batchrecorder.h"
 
 //------------------------------------------------------------------------------
 namespace Frame
@@ -26,6 +27,10 @@ public:
     FrameServer();
     /// destructor
     virtual ~FrameServer();
+    /// set number of batch record threads, call before Open()
+    void SetNumRecordThreads(SizeT num);
+    /// get number of batch record threads
+    SizeT GetNumRecordThreads() const;
     /// open the frame server (loads all frame shaders)
     bool Open();
     /// close the frame server
@@ -36,9 +41,13 @@ public:
     bool HasFrameShader(const Resources::ResourceId& name) const;
     /// get frame shader by name
     const Ptr<FrameShader>& GetFrameShaderByName(const Resources::ResourceId& name) const;
+    /// get the batch recorder
+    const Ptr<BatchRecorder>& GetBatchRecorder() const;
     
 private:
     Util::Dictionary<Resources::ResourceId, Ptr<FrameShader>> frameShaders;
+    Ptr<BatchRecorder> batchRecorder;
+    SizeT numRecordThreads;
     bool isOpen;
 };
 
@@ -51,6 +60,25 @@ FrameServer::IsOpen() const
     return this->isOpen;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+FrameServer::SetNumRecordThreads(SizeT num)
+{
+    s_assert(!this->IsOpen());
+    this->numRecordThreads = num;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+FrameServer::GetNumRecordThreads() const
+{
+    return this->numRecordThreads;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -69,6 +97,15 @@ FrameServer::GetFrameShaderByName(const Resources::ResourceId& resId) const
     return this->frameShaders[resId];
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Ptr<BatchRecorder>&
+FrameServer::GetBatchRecorder() const
+{
+    return this->batchRecorder;
+}
+
 } // namespace Frame
 //------------------------------------------------------------------------------
 #endif
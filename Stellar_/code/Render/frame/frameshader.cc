@@ -4,6 +4,8 @@
 //------------------------------------------------------------------------------
 #include "stdneb.h"
 #include "frame/frameshader.h"
+#include "frame/frameserver.h"
+#include "debuging/profiler.h"
 
 namespace Frame
 {
@@ -38,18 +40,10 @@ FrameShader::Discard()
 {
     IndexT i;
     this->mainRenderTarget = 0;
-    /*for (i = 0; i < this->renderTargets.Size(); i++)
+    for (i = 0; i < this->renderTargets.Size(); i++)
     {
         this->renderTargets.ValueAtIndex(i)->Discard();
-    }*/
-
-	std::map<Resources::ResourceId, Ptr<CoreGraphics::RenderTarget>>::iterator itr;
-	itr = this->renderTargets.GetMap().begin();
-	for (;itr != this->renderTargets.GetMap().end(); itr++)
-	{
-		itr->second->Discard();
-	}
-
+    }
     this->renderTargets.Clear();
     this->shaderVariables.Clear();
     for (i = 0; i < this->framePasses.Size(); i++)
@@ -57,6 +51,7 @@ FrameShader::Discard()
         this->framePasses[i]->Discard();
     }
     this->framePasses.Clear();
+    this->recordBatches.Clear();
     for (i = 0; i < this->postEffects.Size(); i++)
     {
         this->postEffects[i]->Discard();
@@ -71,9 +66,34 @@ FrameShader::Discard()
 void
 FrameShader::Render()
 {
-    // render passes
+    s_profile("FrameShader::Render");
+
+    // record the batches of all passes
+    this->recordBatches.Clear();
     IndexT i;
     for (i = 0; i < this->framePasses.Size(); i++)
+    {
+        const Ptr<FramePass>& framePass = this->framePasses[i];
+        IndexT batchIndex;
+        for (batchIndex = 0; batchIndex < framePass->GetNumBatches(); batchIndex++)
+        {
+            this->recordBatches.Append(framePass->GetBatchByIndex(batchIndex));
+        }
+    }
+    if (FrameServer::HasInstance() && FrameServer::Instance()->GetBatchRecorder().isvalid())
+    {
+        FrameServer::Instance()->GetBatchRecorder()->Record(this->recordBatches);
+    }
+    else
+    {
+        for (i = 0; i < this->recordBatches.Size(); i++)
+        {
+            this->recordBatches[i]->Record();
+        }
+    }
+
+    // render passes, replays the recorded batches
+    for (i = 0; i < this->framePasses.Size(); i++)
     {
         this->framePasses[i]->Render();
     }
@@ -6,7 +6,9 @@
     @class Frame::FrameShader
     
     A FrameShader controls the rendering of an entire frame, and is
-    configured by an XML file.
+    configured by an XML file. The batches of all passes are recorded
+    up front by the BatchRecorder of the FrameServer, then the passes
+    are rendered in order and replay the recorded batches.
     
     (C) 2007 Radon Labs GmbH
 */
@@ -86,6 +88,7 @@ private:
     Util::Dictionary<Resources::ResourceId, IndexT> framePassIndexMap;
     Util::Array<Ptr<FramePostEffect>> postEffects;
     Util::Dictionary<Resources::ResourceId, IndexT> postEffectIndexMap;
+    Util::Array<FrameBatch*> recordBatches;
 };
 
 //------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include "stdneb.h"
 #include "resources/resource.h"
 #include "resources/resourceloader.h"
+#include "debuging/profiler.h"
 //#include "resources/resourcesaver.h"
 
 namespace Resources
@@ -46,6 +47,7 @@ Resource::~Resource()
 Resource::State
 Resource::Load()
 {
+    s_profile("Resource::Load");
     s_assert(this->loader.isvalid());
     s_assert(!this->IsLoaded());
     if (this->IsPending())
@@ -3,7 +3,7 @@
 // (C) 2007 by ctuo
 //------------------------------------------------------------------------------
 #include "stdneb.h"
-#include "resources/resourceId.h"
+#include "resources/resourceid.h"
 
 //------------------------------------------------------------------------------
 namespace Resources
@@ -10,8 +10,8 @@
     (C) 2007 by ctuo
 */
 #include "core/refcounted.h"
-#include "Utility/string.h"
-#include "Utility/atom.h"
+#include "utility/string.h"
+#include "utility/atom.h"
 //#include "Utility/crc.h"
 
 //------------------------------------------------------------------------------
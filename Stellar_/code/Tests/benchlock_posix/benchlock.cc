@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+//  benchlock.cc
+//
+//  Contention benchmark for the Posix Threading primitives. A number of
+//  threads increment a shared counter inside a short critical section,
+//  which is compared against a plain and an adaptive pthread mutex.
+//  A second test measures Event round trips between two threads.
+//
+//  Build from the code directory with:
+//  g++ -O2 -D__cdecl= -IFoundation Tests/benchlock_posix/benchlock.cc
+//      Foundation/thread/posix/posixcriticalsection.cc -lpthread -o benchlock
+//
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "thread/criticalsection.h"
+#include "thread/event.h"
+#include <sys/time.h>
+
+namespace
+{
+const int NumIterations = 10000000;
+const int NumRoundTrips = 100000;
+const int MaxNumThreads = 8;
+const int WorkPerLock = 16;
+
+//------------------------------------------------------------------------------
+/**
+    Adapters which give the locks under test the same interface.
+*/
+struct CriticalSectionAdapter
+{
+    static const char* Name() { return "CriticalSection"; }
+    void Enter() { this->lock.Enter(); }
+    void Leave() { this->lock.Leave(); }
+    Threading::CriticalSection lock;
+};
+
+struct MutexAdapter
+{
+    MutexAdapter() { pthread_mutex_init(&this->lock, 0); }
+    ~MutexAdapter() { pthread_mutex_destroy(&this->lock); }
+    static const char* Name() { return "pthread mutex"; }
+    void Enter() { pthread_mutex_lock(&this->lock); }
+    void Leave() { pthread_mutex_unlock(&this->lock); }
+    pthread_mutex_t lock;
+};
+
+struct AdaptiveMutexAdapter
+{
+    AdaptiveMutexAdapter()
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        #ifdef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+        #endif
+        pthread_mutex_init(&this->lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+    ~AdaptiveMutexAdapter() { pthread_mutex_destroy(&this->lock); }
+    static const char* Name() { return "adaptive mutex"; }
+    void Enter() { pthread_mutex_lock(&this->lock); }
+    void Leave() { pthread_mutex_unlock(&this->lock); }
+    pthread_mutex_t lock;
+};
+
+template<class LOCK> struct LockArgs
+{
+    LOCK* lock;
+    int num;
+    unsigned int volatile* counter;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+double
+GetTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec * 0.000001;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Holds the lock for a few dependent updates of the counter, roughly
+    what a lookup in one of the shared tables costs.
+*/
+template<class LOCK> void*
+RunLocker(void* ptr)
+{
+    LockArgs<LOCK>* args = (LockArgs<LOCK>*) ptr;
+    int i;
+    for (i = 0; i < args->num; i++)
+    {
+        args->lock->Enter();
+        int j;
+        for (j = 0; j < WorkPerLock; j++)
+        {
+            *args->counter += 1;
+        }
+        args->lock->Leave();
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns millions of lock/unlock pairs per second, checks that no
+    update of the counter got lost.
+*/
+template<class LOCK> double
+RunLock(int numThreads, bool& valid)
+{
+    LOCK lock;
+    unsigned int volatile counter = 0;
+    pthread_t threads[MaxNumThreads];
+    LockArgs<LOCK> args[MaxNumThreads];
+
+    double start = GetTime();
+    int i;
+    for (i = 0; i < numThreads; i++)
+    {
+        args[i].lock = &lock;
+        args[i].num = NumIterations / numThreads;
+        args[i].counter = &counter;
+        pthread_create(&threads[i], 0, RunLocker<LOCK>, &args[i]);
+    }
+    for (i = 0; i < numThreads; i++)
+    {
+        pthread_join(threads[i], 0);
+    }
+    double time = GetTime() - start;
+
+    valid &= (counter == (unsigned int)(NumIterations / numThreads) * numThreads * WorkPerLock);
+    return (NumIterations / numThreads) * numThreads / time / 1000000.0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class LOCK> void
+RunAllLocks(bool& valid)
+{
+    printf("%-16s", LOCK::Name());
+    int numThreads;
+    for (numThreads = 1; numThreads <= MaxNumThreads; numThreads *= 2)
+    {
+        printf("%10.2f", RunLock<LOCK>(numThreads, valid));
+        fflush(stdout);
+    }
+    printf("  M lock/unlock per second\n");
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+struct PingPongArgs
+{
+    Threading::Event* ping;
+    Threading::Event* pong;
+};
+
+void*
+RunPong(void* ptr)
+{
+    PingPongArgs* args = (PingPongArgs*) ptr;
+    int i;
+    for (i = 0; i < NumRoundTrips; i++)
+    {
+        args->ping->Wait();
+        args->pong->Signal();
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns thousands of Event round trips between two threads per second.
+*/
+double
+RunPingPong()
+{
+    Threading::Event ping;
+    Threading::Event pong;
+    PingPongArgs args;
+    args.ping = &ping;
+    args.pong = &pong;
+
+    double start = GetTime();
+    pthread_t thread;
+    pthread_create(&thread, 0, RunPong, &args);
+    int i;
+    for (i = 0; i < NumRoundTrips; i++)
+    {
+        ping.Signal();
+        pong.Wait();
+    }
+    pthread_join(thread, 0);
+    return NumRoundTrips / (GetTime() - start) / 1000.0;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_barf(const char* exp, const char* file, int line)
+{
+    printf("*** assertion failed: %s, %s(%d)\n", exp, file, line);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_error(const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vprintf(msg, args);
+    va_end(args);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+main()
+{
+    bool valid = true;
+    printf("%-16s", "threads");
+    int numThreads;
+    for (numThreads = 1; numThreads <= MaxNumThreads; numThreads *= 2)
+    {
+        printf("%10d", numThreads);
+    }
+    printf("\n");
+    RunAllLocks<CriticalSectionAdapter>(valid);
+    RunAllLocks<MutexAdapter>(valid);
+    RunAllLocks<AdaptiveMutexAdapter>(valid);
+    printf("%-16s%10.2f  K round trips per second\n", "Event", RunPingPong());
+    printf(valid ? "no lost updates\n" : "*** lost updates!\n");
+    return valid ? 0 : 1;
+}
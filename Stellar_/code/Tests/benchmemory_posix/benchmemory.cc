@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+//  benchmemory.cc
+//
+//  Alloc/free microbenchmark comparing Memory::Alloc() on Posix platforms
+//  with the C runtime's malloc(). Every thread keeps a window of live
+//  blocks of random size and replaces a random one in each step, which
+//  is close to what the engine's containers and strings do. Linking
+//  posixmemory.cc also replaces the global new and delete operators.
+//
+//  Build from the code directory with:
+//  g++ -O2 -D__cdecl= -IFoundation Tests/benchmemory_posix/benchmemory.cc
+//      Foundation/memory/posix/posixallocator.cc
+//      Foundation/memory/posix/posixmemory.cc
+//      Foundation/memory/posix/posixheap.cc
+//      Foundation/memory/alloctracker.cc
+//      Foundation/thread/posix/posixcriticalsection.cc -lpthread -o benchmemory
+//
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "memory/memory.h"
+#include <sys/time.h>
+
+namespace
+{
+const int NumLiveBlocks = 1024;
+const int NumSteps = 4000000;
+const int MaxNumThreads = 8;
+
+/// allocation functions under test
+struct Allocator
+{
+    const char* name;
+    void* (*alloc)(size_t);
+    void (*free)(void*);
+};
+
+void* EngineAlloc(size_t size) { return Memory::Alloc(size); }
+void EngineFree(void* ptr) { Memory::Free(ptr); }
+
+const Allocator Allocators[] =
+{
+    { "malloc", malloc, free },
+    { "Memory::Alloc", EngineAlloc, EngineFree },
+};
+
+struct ThreadArgs
+{
+    const Allocator* allocator;
+    int numSteps;
+    unsigned int seed;
+    bool valid;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+double
+GetTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec * 0.000001;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Sizes follow roughly the distribution seen in practice, most blocks
+    are small and a few are large.
+*/
+inline size_t
+RandomSize(unsigned int& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    unsigned int r = seed >> 8;
+    if ((r & 15) == 0) return 256 + (r >> 4) % 8192;
+    return 8 + (r >> 4) % 248;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Every block is tagged at both ends, the tags are checked before the
+    block is freed to catch blocks which have been handed out twice.
+*/
+void*
+RunThread(void* ptr)
+{
+    ThreadArgs* args = (ThreadArgs*) ptr;
+    const Allocator* allocator = args->allocator;
+    unsigned int seed = args->seed;
+    unsigned char* blocks[NumLiveBlocks];
+    size_t sizes[NumLiveBlocks];
+    unsigned char tags[NumLiveBlocks];
+    for (int i = 0; i < NumLiveBlocks; ++i)
+    {
+        sizes[i] = RandomSize(seed);
+        blocks[i] = (unsigned char*) allocator->alloc(sizes[i]);
+        tags[i] = (unsigned char) i;
+        blocks[i][0] = blocks[i][sizes[i] - 1] = tags[i];
+    }
+    args->valid = true;
+    for (int step = 0; step < args->numSteps; ++step)
+    {
+        size_t size = RandomSize(seed);
+        int i = (seed >> 12) % NumLiveBlocks;
+        args->valid &= (blocks[i][0] == tags[i]) && (blocks[i][sizes[i] - 1] == tags[i]);
+        allocator->free(blocks[i]);
+        sizes[i] = size;
+        blocks[i] = (unsigned char*) allocator->alloc(size);
+        tags[i] = (unsigned char) step;
+        blocks[i][0] = blocks[i][size - 1] = tags[i];
+    }
+    for (int i = 0; i < NumLiveBlocks; ++i)
+    {
+        args->valid &= (blocks[i][0] == tags[i]) && (blocks[i][sizes[i] - 1] == tags[i]);
+        allocator->free(blocks[i]);
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Run the benchmark with a number of threads, returns millions of
+    alloc/free pairs per second.
+*/
+double
+Run(const Allocator* allocator, int numThreads, bool& valid)
+{
+    pthread_t threads[MaxNumThreads];
+    ThreadArgs args[MaxNumThreads];
+    double start = GetTime();
+    for (int i = 0; i < numThreads; ++i)
+    {
+        args[i].allocator = allocator;
+        args[i].numSteps = NumSteps / numThreads;
+        args[i].seed = 1234 + i;
+        pthread_create(&threads[i], 0, RunThread, &args[i]);
+    }
+    for (int i = 0; i < numThreads; ++i)
+    {
+        pthread_join(threads[i], 0);
+        valid &= args[i].valid;
+    }
+    return NumSteps / (GetTime() - start) / 1000000.0;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_barf(const char* exp, const char* file, int line)
+{
+    printf("*** assertion failed: %s, %s(%d)\n", exp, file, line);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_error(const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vprintf(msg, args);
+    va_end(args);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+main()
+{
+    bool valid = true;
+    printf("%-16s", "threads");
+    for (int numThreads = 1; numThreads <= MaxNumThreads; numThreads *= 2)
+    {
+        printf("%10d", numThreads);
+    }
+    printf("\n");
+    for (unsigned int i = 0; i < sizeof(Allocators) / sizeof(Allocators[0]); ++i)
+    {
+        printf("%-16s", Allocators[i].name);
+        for (int numThreads = 1; numThreads <= MaxNumThreads; numThreads *= 2)
+        {
+            printf("%10.2f", Run(&Allocators[i], numThreads, valid));
+            fflush(stdout);
+        }
+        printf("  M alloc/free per second\n");
+    }
+    #if STELLAR_MEMORY_STATS
+    valid &= (0 == Memory::GetAllocCount()) && (0 == Memory::GetAllocSize());
+    valid &= Posix::PosixAllocator::Validate();
+    #endif
+    printf(valid ? "all blocks valid\n" : "*** corrupted blocks!\n");
+    return valid ? 0 : 1;
+}
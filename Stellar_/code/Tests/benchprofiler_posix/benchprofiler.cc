@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+//  benchprofiler.cc
+//
+//  Measures the cost of one s_profile() marker, with the profiler disabled
+//  and enabled, against the same function without a marker. While enabled
+//  NextFrame() collects the records every FrameSize calls, so its cost is
+//  included. The cost of the clock read the marker makes twice is printed
+//  for reference.
+//
+//  Build from the code directory with:
+//  g++ -O2 -Wno-multichar -D__cdecl= -IFoundation
+//      Tests/benchprofiler_posix/benchprofiler.cc
+//      Foundation/debuging/profiler.cc Foundation/utility/string.cc
+//      Foundation/io/stream.cc
+//      Foundation/thread/thread.cc Foundation/thread/posix/posixthread.cc
+//      Foundation/thread/posix/posixcriticalsection.cc
+//      Foundation/core/rtti.cc Foundation/core/refcounted.cc
+//      Foundation/core/factory.cc Foundation/core/debug.cc
+//      Foundation/utility/system.cc Foundation/memory/objectpool.cc
+//      Foundation/memory/poolheap.cc Foundation/memory/alloctracker.cc
+//      Foundation/memory/posix/posixallocator.cc
+//      Foundation/memory/posix/posixmemory.cc
+//      Foundation/memory/posix/posixheap.cc -lpthread -o benchprofiler
+//
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "debuging/profiler.h"
+#include <sys/time.h>
+
+namespace
+{
+const int NumCalls = 20000000;
+const int FrameSize = 4096;
+
+int volatile Sink = 0;
+
+//------------------------------------------------------------------------------
+/**
+*/
+double
+GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+__attribute__((noinline)) void
+PlainCall()
+{
+    Sink++;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+__attribute__((noinline)) void
+ProfiledCall()
+{
+    s_profile("ProfiledCall");
+    Sink++;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns nanoseconds per call.
+*/
+template<void (*CALL)()> double
+RunCalls(bool nextFrame)
+{
+    double start = GetTime();
+    int i;
+    for (i = 0; i < NumCalls; i++)
+    {
+        CALL();
+        if (nextFrame && (0 == (i % FrameSize)))
+        {
+            Debug::Profiler::NextFrame();
+        }
+    }
+    return (GetTime() - start) * 1000000000.0 / NumCalls;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns nanoseconds per time stamp.
+*/
+double
+RunGetTicks()
+{
+    Debug::Profiler::Ticks sum = 0;
+    double start = GetTime();
+    int i;
+    for (i = 0; i < NumCalls; i++)
+    {
+        sum += Debug::Profiler::GetTicks();
+    }
+    double time = GetTime() - start;
+    Sink += (int) sum;
+    return time * 1000000000.0 / NumCalls;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+main()
+{
+    double plain = RunCalls<PlainCall>(false);
+    double disabled = RunCalls<ProfiledCall>(false);
+    Debug::Profiler::SetEnabled(true);
+    double enabled = RunCalls<ProfiledCall>(true);
+    Debug::Profiler::SetEnabled(false);
+    double ticks = RunGetTicks();
+
+    printf("no marker      %8.2f ns per call\n", plain);
+    printf("disabled       %8.2f ns per call (%+.2f)\n", disabled, disabled - plain);
+    printf("enabled        %8.2f ns per call (%+.2f)\n", enabled, enabled - plain);
+    printf("GetTicks()     %8.2f ns per time stamp\n", ticks);
+    printf("dropped records: %d\n", (int) Debug::Profiler::GetNumDroppedRecords());
+    return 0;
+}
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+//  benchqueue.cc
+//
+//  Contention benchmark for the inter-thread queues. A number of producer
+//  threads push prioritized requests into one queue, a single consumer
+//  thread waits for them and takes them out, which is how the IO and
+//  loader threads use their request queues. Compares SafePriorityQueue,
+//  BucketPriorityQueue and a plain MpmcQueue.
+//
+//  Build from the code directory with:
+//  g++ -O2 -D__cdecl= -IFoundation Tests/benchqueue_posix/benchqueue.cc
+//      Foundation/memory/posix/posixallocator.cc
+//      Foundation/thread/posix/posixcriticalsection.cc -lpthread -o benchqueue
+//
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "thread/safepriorityqueue.h"
+#include "thread/bucketpriorityqueue.h"
+#include "thread/mpmcqueue.h"
+#include <sys/time.h>
+
+namespace
+{
+const int NumRequests = 100000;
+const int NumLevels = 8;
+const int MaxNumProducers = 8;
+
+//------------------------------------------------------------------------------
+/**
+    Adapters which give the queues under test the same interface. Insert()
+    returns false if the request must be retried, Take() blocks until a
+    request has been taken.
+*/
+struct SafeQueueAdapter
+{
+    static const char* Name() { return "SafePriority"; }
+    bool Insert(int pri, int request) { this->queue.Insert(pri, request); return true; }
+    int Take()
+    {
+        while (this->queue.IsEmpty())
+        {
+            this->queue.Wait();
+        }
+        return this->queue.Dequeue();
+    }
+    Threading::SafePriorityQueue<int, int> queue;
+};
+
+struct BucketQueueAdapter
+{
+    BucketQueueAdapter() : queue(NumLevels, 4096) {}
+    static const char* Name() { return "BucketPriority"; }
+    bool Insert(int pri, int request) { return this->queue.Enqueue(pri, request); }
+    int Take()
+    {
+        int request;
+        while (!this->queue.Dequeue(request))
+        {
+            this->queue.Wait();
+        }
+        return request;
+    }
+    Threading::BucketPriorityQueue<int> queue;
+};
+
+struct MpmcQueueAdapter
+{
+    MpmcQueueAdapter() : queue(4096) {}
+    static const char* Name() { return "Mpmc (no prio)"; }
+    bool Insert(int, int request) { return this->queue.Enqueue(request); }
+    int Take()
+    {
+        int request;
+        while (!this->queue.Dequeue(request))
+        {
+            this->queue.Wait();
+        }
+        return request;
+    }
+    Threading::MpmcQueue<int> queue;
+};
+
+template<class QUEUE> struct ThreadArgs
+{
+    QUEUE* queue;
+    int first;
+    int num;
+    long long sum;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+double
+GetTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec * 0.000001;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class QUEUE> void*
+RunProducer(void* ptr)
+{
+    ThreadArgs<QUEUE>* args = (ThreadArgs<QUEUE>*) ptr;
+    int i;
+    for (i = args->first; i < args->first + args->num; i++)
+    {
+        while (!args->queue->Insert(i % NumLevels, i))
+        {
+            sched_yield();
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class QUEUE> void*
+RunConsumer(void* ptr)
+{
+    ThreadArgs<QUEUE>* args = (ThreadArgs<QUEUE>*) ptr;
+    args->sum = 0;
+    int i;
+    for (i = 0; i < args->num; i++)
+    {
+        args->sum += args->queue->Take();
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns millions of requests per second, checks that every request
+    arrived exactly once by comparing the sum of all requests.
+*/
+template<class QUEUE> double
+Run(int numProducers, bool& valid)
+{
+    QUEUE queue;
+    pthread_t producers[MaxNumProducers];
+    ThreadArgs<QUEUE> producerArgs[MaxNumProducers];
+    pthread_t consumer;
+    ThreadArgs<QUEUE> consumerArgs;
+    consumerArgs.queue = &queue;
+    consumerArgs.first = 0;
+    consumerArgs.num = NumRequests;
+
+    double start = GetTime();
+    pthread_create(&consumer, 0, RunConsumer<QUEUE>, &consumerArgs);
+    int numPerProducer = NumRequests / numProducers;
+    int i;
+    for (i = 0; i < numProducers; i++)
+    {
+        producerArgs[i].queue = &queue;
+        producerArgs[i].first = i * numPerProducer;
+        producerArgs[i].num = (i == numProducers - 1) ? NumRequests - i * numPerProducer : numPerProducer;
+        pthread_create(&producers[i], 0, RunProducer<QUEUE>, &producerArgs[i]);
+    }
+    for (i = 0; i < numProducers; i++)
+    {
+        pthread_join(producers[i], 0);
+    }
+    pthread_join(consumer, 0);
+    double time = GetTime() - start;
+
+    valid &= (consumerArgs.sum == (long long) NumRequests * (NumRequests - 1) / 2);
+    return NumRequests / time / 1000000.0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class QUEUE> void
+RunAll(bool& valid)
+{
+    printf("%-16s", QUEUE::Name());
+    int numProducers;
+    for (numProducers = 1; numProducers <= MaxNumProducers; numProducers *= 2)
+    {
+        printf("%10.2f", Run<QUEUE>(numProducers, valid));
+        fflush(stdout);
+    }
+    printf("  M requests per second\n");
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_barf(const char* exp, const char* file, int line)
+{
+    printf("*** assertion failed: %s, %s(%d)\n", exp, file, line);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+s_error(const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vprintf(msg, args);
+    va_end(args);
+    abort();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+main()
+{
+    bool valid = true;
+    printf("%-16s", "producers");
+    int numProducers;
+    for (numProducers = 1; numProducers <= MaxNumProducers; numProducers *= 2)
+    {
+        printf("%10d", numProducers);
+    }
+    printf("\n");
+    RunAll<SafeQueueAdapter>(valid);
+    RunAll<BucketQueueAdapter>(valid);
+    RunAll<MpmcQueueAdapter>(valid);
+    printf(valid ? "all requests received\n" : "*** lost or duplicated requests!\n");
+    return valid ? 0 : 1;
+}
@@ -1,6 +1,12 @@
 
 #include "../testbase_win32/testrunner.h"
 #include "testFactory.h"
+#include "testHeap.h"
+#include "testFlatHashMap.h"
+#include "testProfiler.h"
+#include "testMemoryReport.h"
+#include "testAtom.h"
+#include "testObjectPool.h"
 
 using namespace Test;
 
@@ -8,6 +14,12 @@ void main()
 {
     Ptr<TestRunner> testRunner = TestRunner::Create();
     testRunner->AttachTestCase(testFactory::Create());
+    testRunner->AttachTestCase(testHeap::Create());
+    testRunner->AttachTestCase(testFlatHashMap::Create());
+    testRunner->AttachTestCase(testProfiler::Create());
+    testRunner->AttachTestCase(testMemoryReport::Create());
+    testRunner->AttachTestCase(testAtom::Create());
+    testRunner->AttachTestCase(testObjectPool::Create());
 
     testRunner->Run();
     getchar();
@@ -0,0 +1,100 @@
+#include "stdneb.h"
+#include "testAtom.h"
+#include "utility/atom.h"
+#include "time/time.h"
+
+namespace Test
+{
+    namespace
+    {
+        const int NumNames = 64;
+        const int NumThreads = 4;
+        const int NumCollections = 200;
+
+        Util::String GetName(int i)
+        {
+            char buf[32];
+            sprintf(buf, "testAtom.%d", i % NumNames);
+            return buf;
+        }
+    }
+
+    ImplementClass(Test::testAtom, 'TAtm', Test::TestCase);
+    ImplementClass(Test::testAtomThread, 'TAtT', Threading::Thread);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    testAtomThread::testAtomThread() :
+        numLookups(0),
+        numFailures(0)
+    {
+        // empty
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Every name is looked up over and over, while the main thread keeps
+        collecting the atoms which are no longer referenced.
+    */
+    void testAtomThread::DoWork()
+    {
+        int i = 0;
+        while (!this->ThreadStopRequested())
+        {
+            Util::String name = GetName(i++);
+            Util::Atom<Util::String> atom(name);
+            Util::Atom<Util::String> copy(atom);
+            Util::Atom<Util::String> again(name);
+            if ((atom.Value() != name) || (copy != atom) || (again != atom))
+            {
+                this->numFailures++;
+            }
+            this->numLookups++;
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testAtom::Run()
+    {
+        typedef Util::Atom<Util::String> StringAtom;
+
+        // atoms of equal content share the entry
+        StringAtom held("testAtom.held");
+        StringAtom same(Util::String("testAtom.held"));
+        StringAtom other("testAtom.other");
+        Verify(held == same && held != other);
+        Verify(held == Util::String("testAtom.held"));
+        other.Clear();
+        StringAtom::PerformGarbageCollection();
+        SizeT tableSize = StringAtom::GetAtomTableSize();
+
+        // concurrent lookups, references and garbage collections
+        Ptr<testAtomThread> threads[NumThreads];
+        IndexT i;
+        for (i = 0; i < NumThreads; i++)
+        {
+            threads[i] = testAtomThread::Create();
+            threads[i]->SetName("testAtomThread");
+            threads[i]->Start();
+        }
+        for (i = 0; i < NumCollections; i++)
+        {
+            StringAtom::PerformGarbageCollection();
+            Timing::Sleep(0.001);
+        }
+        for (i = 0; i < NumThreads; i++)
+        {
+            threads[i]->Stop();
+            Verify(threads[i]->numLookups > 0);
+            Verify(0 == threads[i]->numFailures);
+        }
+
+        // only the atoms which are still referenced survive the collection
+        StringAtom::PerformGarbageCollection();
+        Verify(tableSize == StringAtom::GetAtomTableSize());
+        Verify(held == same && held.Value() == "testAtom.held");
+    }
+}
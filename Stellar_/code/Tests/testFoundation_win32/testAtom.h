@@ -0,0 +1,35 @@
+#ifndef TEST_TESTATOM_H
+#define TEST_TESTATOM_H
+
+#include "../testbase_win32/testcase.h"
+#include "thread/thread.h"
+
+namespace Test
+{
+class testAtom : public Test::TestCase
+{
+    DeclareClass(testAtom);
+
+public:
+    virtual void Run();
+};
+
+/// interns and copies atoms until it is stopped
+class testAtomThread : public Threading::Thread
+{
+    DeclareClass(testAtomThread);
+
+public:
+    /// constructor
+    testAtomThread();
+
+    int numLookups;
+    int numFailures;
+
+protected:
+    virtual void DoWork();
+};
+
+};
+
+#endif
@@ -5,6 +5,7 @@
 namespace Test
 {
     ImplementClass(Test::testFactory, 'TFac', Test::TestCase);
+    ImplementPooledClass(Test::testPooledObject, 'TPoO', Core::RefCounted);
 
     //------------------------------------------------------------------------------
     /*
@@ -18,5 +19,18 @@ namespace Test
         Verify(tFObj != 0 );
         Verify(tFObj1 != 0 );
         Verify(tFObj2 != 0 );
+
+        // pooled class: objects come from the class' pool, which is known to the factory
+        const Memory::ObjectPool& pool = testPooledObject::Pool;
+        int numLive = pool.GetNumLiveObjects();
+        Ptr<testPooledObject> pooledObj = testPooledObject::Create();
+        Ptr<testPooledObject> pooledObj1 = testPooledObject::Create();
+        Verify(pool.GetNumLiveObjects() == numLive + 2);
+        Verify(pool.GetPeakNumLiveObjects() >= numLive + 2);
+        pooledObj1 = 0;
+        Verify(pool.GetNumLiveObjects() == numLive + 1);
+        Verify(testPooledObject::RTTI.GetObjectPool() == &pool);
+        const Util::Array<const Core::Rtti*>& pooledClasses = Core::Factory::Instance()->GetPooledClasses();
+        Verify(pooledClasses.Find(&testPooledObject::RTTI) != pooledClasses.end());
     }
 };
\ No newline at end of file
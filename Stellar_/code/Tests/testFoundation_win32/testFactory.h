@@ -13,6 +13,11 @@ public:
     virtual void Run();
 };
 
+class testPooledObject : public Core::RefCounted
+{
+    DeclarePooledClass(testPooledObject);
+};
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "stdneb.h"
+#include "testFlatHashMap.h"
+#include "utility/flathashmap.h"
+#include "utility/flathashset.h"
+#include "utility/thashtable.h"
+
+namespace Test
+{
+    ImplementClass(Test::testFlatHashMap, 'TFHM', Test::TestCase);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testFlatHashMap::Run()
+    {
+        // add, find and erase enough keys to force several rehashes
+        Util::FlatHashMap<int, int> map;
+        Verify(map.IsEmpty());
+        int i;
+        for (i = 0; i < 1000; i++)
+        {
+            Verify(map.Add(i, i * 2));
+        }
+        Verify(!map.Add(10, 0));
+        Verify(1000 == map.Size());
+        Verify(0 != map.Find(999) && 1998 == *map.Find(999));
+        Verify(0 == map.Find(1000));
+        for (i = 0; i < 1000; i += 2)
+        {
+            Verify(map.Erase(i));
+        }
+        Verify(!map.Erase(0));
+        Verify(500 == map.Size());
+        Verify(!map.Contains(10) && map.Contains(11));
+
+        // iteration follows insertion order, also after erasing
+        int expected = 1;
+        Util::FlatHashMap<int, int>::ConstIterator iter;
+        for (iter = map.Begin(); iter != map.End(); ++iter)
+        {
+            Verify(expected == iter->first);
+            expected += 2;
+        }
+        map[2000] = 5;
+        Verify(5 == *map.Find(2000));
+        map.Clear();
+        Verify(map.IsEmpty() && map.Begin() == map.End());
+
+        // string keys can be found by C strings
+        Util::FlatHashMap<Util::String, int> strings;
+        strings.Add("Stellar", 1);
+        strings.Add("Engine", 2);
+        Verify(0 != strings.Find("Engine") && 2 == *strings.Find("Engine"));
+        Verify(0 == strings.Find("Nebula"));
+        Verify(strings.Erase("Stellar"));
+
+        // set
+        Util::FlatHashSet<unsigned int> set;
+        Verify(set.Add(7));
+        Verify(!set.Add(7));
+        Verify(set.Contains(7) && 7 == *set.Find(7));
+        Verify(set.Erase(7) && set.IsEmpty());
+
+        // the old hash table interface on top of the flat map
+        Util::THashTable<int, float> table(4);
+        for (i = 0; i < 100; i++)
+        {
+            Verify(table.Insert(i, 0.5f * i));
+        }
+        Verify(100 == table.GetQuantity());
+        Verify(table.Remove(50) && 0 == table.Find(50));
+        int key;
+        int count = 0;
+        for (float* value = table.GetFirst(&key); value; value = table.GetNext(&key))
+        {
+            Verify(*value == 0.5f * key);
+            count++;
+        }
+        Verify(99 == count);
+
+        // entries can be erased while iterating, also through the old interface
+        for (i = 0; i < 1000; i++)
+        {
+            map.Add(i, i);
+        }
+        count = 0;
+        for (iter = map.Begin(); iter != map.End(); ++iter)
+        {
+            Verify(count++ == iter->first);
+            Verify(map.Erase(iter->first));
+        }
+        Verify(1000 == count && map.IsEmpty() && map.Begin() == map.End());
+        Verify(map.Add(5, 5) && 1 == map.Size() && 5 == map.Begin()->first);
+
+        count = 0;
+        for (float* value = table.GetFirst(&key); value; value = table.GetNext(&key))
+        {
+            Verify(table.Remove(key));
+            count++;
+        }
+        Verify(99 == count && 0 == table.GetQuantity());
+    }
+}
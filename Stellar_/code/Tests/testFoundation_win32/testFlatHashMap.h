@@ -0,0 +1,18 @@
+#ifndef TEST_TESTFLATHASHMAP_H
+#define TEST_TESTFLATHASHMAP_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testFlatHashMap : public Test::TestCase
+{
+    DeclareClass(testFlatHashMap);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
\ No newline at end of file
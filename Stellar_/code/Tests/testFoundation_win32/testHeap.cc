@@ -0,0 +1,71 @@
+#include "stdneb.h"
+#include "testHeap.h"
+#include "memory/linearheap.h"
+#include "memory/poolheap.h"
+
+namespace Test
+{
+    namespace
+    {
+        struct Counted
+        {
+            static int NumObjects;
+            Counted() { NumObjects++; }
+            ~Counted() { NumObjects--; }
+        };
+        int Counted::NumObjects = 0;
+    }
+
+    ImplementClass(Test::testHeap, 'THea', Test::TestCase);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testHeap::Run()
+    {
+        // linear heap: blocks are aligned and memory is reused two frames later
+        Memory::LinearHeap linearHeap("Test.LinearHeap", 256, 2);
+        linearHeap.BeginFrame();
+        char* first = (char*)linearHeap.Alloc(10);
+        char* second = (char*)linearHeap.Alloc(100);
+        Verify(0 == ((size_t)first & 15));
+        Verify(0 == ((size_t)second & 15));
+        Verify(second >= first + 10);
+        Memory::Clear(second, 100);
+        Verify(second == linearHeap.Realloc(second, 120));
+        linearHeap.Free(second);
+        Verify(second == linearHeap.Alloc(1));
+        char* large = (char*)linearHeap.Alloc(1000);
+        Verify(0 != large);
+        linearHeap.BeginFrame();
+        Verify(first != linearHeap.Alloc(10));
+        linearHeap.BeginFrame();
+        Verify(first == linearHeap.Alloc(10));
+
+        // pool heap: blocks are distinct and recycled
+        Memory::PoolHeap poolHeap("Test.PoolHeap", 20, 4);
+        Verify(poolHeap.GetBlockSize() >= 20);
+        void* blocks[6];
+        int i;
+        for (i = 0; i < 6; i++)
+        {
+            blocks[i] = poolHeap.Alloc(20);
+        }
+        Verify(blocks[0] != blocks[5]);
+        poolHeap.Free(blocks[3]);
+        Verify(blocks[3] == poolHeap.Alloc(16));
+        poolHeap.Reset();
+
+        // objects created in a heap
+        Counted* counted = s_new_heap(poolHeap, Counted);
+        Verify(1 == Counted::NumObjects);
+        s_delete_heap(poolHeap, counted);
+        Verify(0 == Counted::NumObjects);
+
+        #if STELLAR_MEMORY_STATS
+        Verify(0 == poolHeap.GetAllocCount());
+        Verify(1 == linearHeap.GetAllocCount());
+        Verify(linearHeap.GetPeakSize() >= 1000);
+        #endif
+    }
+};
\ No newline at end of file
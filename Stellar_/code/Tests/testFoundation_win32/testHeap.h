@@ -0,0 +1,18 @@
+#ifndef TEST_TESTHEAP_H
+#define TEST_TESTHEAP_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testHeap : public Test::TestCase
+{
+    DeclareClass(testHeap);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "stdneb.h"
+#include "testMemoryReport.h"
+#include "memory/debug/memoryreport.h"
+#include "memory/heap.h"
+
+namespace Test
+{
+    namespace
+    {
+        const Debug::MemoryReport::SiteStats* FindSite(const Debug::MemoryReport& report, const char* tag)
+        {
+            const Util::Array<Debug::MemoryReport::SiteStats>& sites = report.GetSites();
+            IndexT i;
+            for (i = 0; i < sites.Size(); i++)
+            {
+                if ((sites[i].heapName == "testMemoryReport") && (sites[i].tag == tag))
+                {
+                    return &sites[i];
+                }
+            }
+            return 0;
+        }
+    }
+
+    ImplementClass(Test::testMemoryReport, 'TMRp', Test::TestCase);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testMemoryReport::Run()
+    {
+        using Memory::AllocTracker;
+        unsigned int sampleInterval = AllocTracker::GetSampleInterval();
+
+        // an interval of 1 samples every allocation, so the numbers are exact
+        AllocTracker::SetSampleInterval(1);
+        Memory::Heap heap("testMemoryReport");
+        void* blocks[8];
+        IndexT i;
+        {
+            s_alloc_tag("testMemoryReport.Tag");
+            Verify(0 == strcmp(AllocTracker::GetTag(), "testMemoryReport.Tag"));
+            for (i = 0; i < 8; i++)
+            {
+                blocks[i] = heap.Alloc(1000);
+            }
+        }
+        Verify(0 == AllocTracker::GetTag());
+
+        Debug::MemoryReport report;
+        report.TakeSnapshot();
+        const Debug::MemoryReport::SiteStats* site = FindSite(report, "testMemoryReport.Tag");
+        Verify(0 != site);
+        Verify(site->liveBytes > 7999.0 && site->liveBytes < 8001.0);
+        Verify(site->liveCount > 7.99 && site->liveCount < 8.01);
+
+        for (i = 0; i < 4; i++)
+        {
+            heap.Free(blocks[i]);
+        }
+        report.TakeSnapshot();
+        Verify(2 == report.GetNumSnapshots());
+        site = FindSite(report, "testMemoryReport.Tag");
+        Verify(0 != site);
+        Verify(site->liveBytes > 3999.0 && site->liveBytes < 4001.0);
+        Verify(site->totalBytes > 7999.0 && site->totalBytes < 8001.0);
+
+        for (i = 4; i < 8; i++)
+        {
+            heap.Free(blocks[i]);
+        }
+        report.TakeSnapshot();
+        site = FindSite(report, "testMemoryReport.Tag");
+        Verify(0 != site);
+        Verify(site->liveBytes < 1.0 && site->liveCount < 0.01);
+        Verify(0 == AllocTracker::GetNumDroppedSamples());
+
+        AllocTracker::SetSampleInterval(sampleInterval);
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_TESTMEMORYREPORT_H
+#define TEST_TESTMEMORYREPORT_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testMemoryReport : public Test::TestCase
+{
+    DeclareClass(testMemoryReport);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "stdneb.h"
+#include "testObjectPool.h"
+#include "memory/objectpool.h"
+#include "time/time.h"
+
+namespace Test
+{
+    namespace
+    {
+        const int NumThreads = 4;
+        const int NumHandedOut = 256;
+        const int WindowSize = 32;
+
+        struct Block
+        {
+            int owner;
+            int serial;
+        };
+
+        Memory::ObjectPool TestPool("testObjectPool", sizeof(Block), 8);
+        Block* HandedOut[NumHandedOut];
+    }
+
+    ImplementClass(Test::testObjectPool, 'TObP', Test::TestCase);
+    ImplementClass(Test::testObjectPoolThread, 'TOPT', Threading::Thread);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    testObjectPoolThread::testObjectPoolThread() :
+        index(0),
+        numAllocs(0),
+        numFailures(0)
+    {
+        // empty
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Frees its share of the blocks the main thread allocated, then keeps
+        replacing blocks in a window of its own. A block which is handed
+        out twice shows up as a block whose contents have been overwritten.
+    */
+    void testObjectPoolThread::DoWork()
+    {
+        int i;
+        for (i = this->index; i < NumHandedOut; i += NumThreads)
+        {
+            TestPool.Free(HandedOut[i]);
+        }
+
+        Block* window[WindowSize] = { 0 };
+        int serial = 0;
+        while (!this->ThreadStopRequested())
+        {
+            Block*& block = window[serial % WindowSize];
+            if (0 != block)
+            {
+                if ((block->owner != this->index) || (block->serial != serial - WindowSize))
+                {
+                    this->numFailures++;
+                }
+                TestPool.Free(block);
+            }
+            block = (Block*) TestPool.Alloc(sizeof(Block));
+            block->owner = this->index;
+            block->serial = serial++;
+            this->numAllocs++;
+        }
+        for (i = 0; i < WindowSize; i++)
+        {
+            TestPool.Free(window[i]);
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testObjectPool::Run()
+    {
+        // counters on a single thread
+        IndexT i;
+        for (i = 0; i < NumHandedOut; i++)
+        {
+            HandedOut[i] = (Block*) TestPool.Alloc(sizeof(Block));
+        }
+        Verify(NumHandedOut == TestPool.GetNumLiveObjects());
+        Verify(NumHandedOut == TestPool.GetNumAllocs());
+        Verify(NumHandedOut <= TestPool.GetPeakNumLiveObjects());
+
+        // blocks are freed by other threads than the one that allocated them
+        Ptr<testObjectPoolThread> threads[NumThreads];
+        for (i = 0; i < NumThreads; i++)
+        {
+            threads[i] = testObjectPoolThread::Create();
+            threads[i]->index = i;
+            threads[i]->SetName("testObjectPoolThread");
+            threads[i]->Start();
+        }
+        Timing::Sleep(0.2);
+        int numAllocs = NumHandedOut;
+        for (i = 0; i < NumThreads; i++)
+        {
+            threads[i]->Stop();
+            Verify(threads[i]->numAllocs > 0);
+            Verify(0 == threads[i]->numFailures);
+            numAllocs += threads[i]->numAllocs;
+        }
+        Verify(0 == TestPool.GetNumLiveObjects());
+        Verify(numAllocs == TestPool.GetNumAllocs());
+
+        // freeing after the pool has been destroyed does nothing,
+        // like it happens to pooled static objects at exit
+        static char poolMemory[sizeof(Memory::ObjectPool)];
+        Memory::ObjectPool* pool = new (poolMemory) Memory::ObjectPool("testObjectPool.destroyed", sizeof(Block));
+        void* ptr = pool->Alloc(sizeof(Block));
+        pool->~ObjectPool();
+        pool->Free(ptr);
+    }
+}
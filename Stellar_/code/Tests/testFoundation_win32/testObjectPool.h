@@ -0,0 +1,36 @@
+#ifndef TEST_TESTOBJECTPOOL_H
+#define TEST_TESTOBJECTPOOL_H
+
+#include "../testbase_win32/testcase.h"
+#include "thread/thread.h"
+
+namespace Test
+{
+class testObjectPool : public Test::TestCase
+{
+    DeclareClass(testObjectPool);
+
+public:
+    virtual void Run();
+};
+
+/// allocates and frees pooled blocks until it is stopped
+class testObjectPoolThread : public Threading::Thread
+{
+    DeclareClass(testObjectPoolThread);
+
+public:
+    /// constructor
+    testObjectPoolThread();
+
+    int index;
+    int numAllocs;
+    int numFailures;
+
+protected:
+    virtual void DoWork();
+};
+
+};
+
+#endif
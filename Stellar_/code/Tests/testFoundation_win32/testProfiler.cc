@@ -0,0 +1,81 @@
+#include "stdneb.h"
+#include "testProfiler.h"
+#include "debuging/profiler.h"
+
+namespace Test
+{
+    namespace
+    {
+        void Inner()
+        {
+            s_profile("testProfiler.Inner");
+        }
+
+        void Outer()
+        {
+            s_profile("testProfiler.Outer");
+            Inner();
+            Inner();
+        }
+
+        const Debug::Profiler::MarkerStats* FindStats(const char* name)
+        {
+            const Util::Array<Debug::Profiler::MarkerStats>& stats = Debug::Profiler::GetMarkerStats();
+            IndexT i;
+            for (i = 0; i < stats.Size(); i++)
+            {
+                if (0 == strcmp(stats[i].name, name))
+                {
+                    return &stats[i];
+                }
+            }
+            return 0;
+        }
+    }
+
+    ImplementClass(Test::testProfiler, 'TPrf', Test::TestCase);
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testProfiler::Run()
+    {
+        using Debug::Profiler;
+        Profiler::ResetStats();
+
+        // nothing is recorded while disabled
+        Outer();
+        Profiler::NextFrame();
+        Verify(0 == FindStats("testProfiler.Outer"));
+
+        // per frame stats and nesting depth
+        Profiler::SetEnabled(true);
+        Profiler::BeginCapture();
+        int frame;
+        for (frame = 0; frame < 3; frame++)
+        {
+            Outer();
+            Profiler::NextFrame();
+        }
+        Profiler::EndCapture();
+        Profiler::SetEnabled(false);
+
+        const Profiler::MarkerStats* outer = FindStats("testProfiler.Outer");
+        const Profiler::MarkerStats* inner = FindStats("testProfiler.Inner");
+        Verify(0 != outer && 0 != inner);
+        Verify(3 == outer->numFrames && 1 == outer->lastFrameCalls);
+        Verify(3 == inner->numFrames && 2 == inner->lastFrameCalls);
+        Verify(inner->depth == outer->depth + 1);
+        Verify(outer->minTime <= outer->GetAvgTime() && outer->GetAvgTime() <= outer->maxTime);
+
+        // every call becomes a complete event in the trace
+        Verify(9 == Profiler::GetNumCapturedRecords());
+        Util::String trace = Profiler::BuildChromeTrace();
+        Verify(0 == trace.find("{\"traceEvents\":["));
+        Verify(Util::String::npos != trace.find("\"name\":\"testProfiler.Inner\",\"ph\":\"X\""));
+        Verify(Util::String::npos != trace.find("\"thread_name\""));
+
+        Profiler::ResetStats();
+        Verify(0 == FindStats("testProfiler.Outer"));
+    }
+}
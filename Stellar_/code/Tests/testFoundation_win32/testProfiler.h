@@ -0,0 +1,18 @@
+#ifndef TEST_TESTPROFILER_H
+#define TEST_TESTPROFILER_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testProfiler : public Test::TestCase
+{
+    DeclareClass(testProfiler);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "../testbase_win32/testrunner.h"
+#include "testBatchRecorder.h"
+#include "testDrawList.h"
+#include "testFrameShader.h"
+#include "testShaderInstance.h"
+#include "testStateFilter.h"
+
+using namespace Test;
+
+void main()
+{
+    Ptr<TestRunner> testRunner = TestRunner::Create();
+    testRunner->AttachTestCase(testBatchRecorder::Create());
+    testRunner->AttachTestCase(testDrawList::Create());
+    testRunner->AttachTestCase(testFrameShader::Create());
+    testRunner->AttachTestCase(testShaderInstance::Create());
+    testRunner->AttachTestCase(testStateFilter::Create());
+
+    testRunner->Run();
+    getchar();
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "stdneb.h"
+#include "testBatchRecorder.h"
+#include "testHelpers.h"
+#include "coregraphics/displaydevice.h"
+#include "coregraphics/renderdevice.h"
+#include "coregraphics/rendertarget.h"
+#include "frame/framepass.h"
+#include "frame/batchrecorder.h"
+
+namespace Test
+{
+    ImplementClass(Test::testBatchRecorder, 'TBRc', Test::TestCase);
+
+    using namespace Util;
+    using namespace CoreGraphics;
+    using namespace Resources;
+    using namespace Frame;
+
+    namespace
+    {
+        const SizeT NumVertices = 12;
+        const SizeT NumVertexBuffers = 2;
+        const SizeT NumOpaqueBatches = 6;
+        const SizeT NumAlphaBatches = 2;
+        const SizeT NumBatches = NumOpaqueBatches + NumAlphaBatches;
+        const SizeT NumRecordThreads = 3;
+        const SizeT NumThreadedFrames = 20;
+
+        /// the counters of one frame
+        struct FrameCounters
+        {
+            RenderDevice::Stats stats;
+            SizeT numIssued[RenderDevice::NumStateTypes];
+            SizeT numFiltered[RenderDevice::NumStateTypes];
+            SizeT numCommands[NumBatches];
+            SizeT byteSize[NumBatches];
+        };
+
+        //------------------------------------------------------------------------------
+        /*
+            Adds the same draw items to the batches every frame. The batches
+            get different numbers of items, so the record threads finish
+            them at different times.
+        */
+        void AddDrawItems(const Array<Ptr<FrameBatch> >& batches, const Ptr<ShaderInstance>& itemShader, const Array<Ptr<VertexBuffer> >& vertexBuffers)
+        {
+            IndexT batchIndex;
+            for (batchIndex = 0; batchIndex < batches.Size(); batchIndex++)
+            {
+                const SizeT numItems = 10 + batchIndex * 7;
+                IndexT i;
+                for (i = 0; i < numItems; i++)
+                {
+                    DrawList::Item item;
+                    item.shader = itemShader;
+                    item.features = ((i + batchIndex) & 1) ? 2 : 1;
+                    item.vertexBuffer = vertexBuffers[(i / 3) % NumVertexBuffers];
+                    item.primitiveGroup.SetBaseVertex((i % (NumVertices / 3)) * 3);
+                    item.primitiveGroup.SetNumVertices(3);
+                    item.primitiveGroup.SetPrimitiveTopology(PrimitiveTopology::TriangleList);
+                    item.depth = float((i * 13) % 17);
+                    batches[batchIndex]->AddDrawItem(item);
+                }
+            }
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Renders one frame. With a recorder the batches are recorded up
+            front, like FrameShader::Render() does, otherwise each batch is
+            recorded when its pass renders it.
+        */
+        FrameCounters RenderFrame(const Array<Ptr<FramePass> >& passes, const Array<Ptr<FrameBatch> >& batches, const Ptr<BatchRecorder>& recorder)
+        {
+            RenderDevice* renderDevice = RenderDevice::Instance();
+            if (recorder.isvalid())
+            {
+                Array<FrameBatch*> recordBatches;
+                IndexT i;
+                for (i = 0; i < batches.Size(); i++)
+                {
+                    recordBatches.Append(batches[i].get());
+                }
+                recorder->Record(recordBatches);
+            }
+            renderDevice->BeginFrame();
+            IndexT passIndex;
+            for (passIndex = 0; passIndex < passes.Size(); passIndex++)
+            {
+                passes[passIndex]->Render();
+            }
+            renderDevice->EndFrame();
+
+            FrameCounters counters;
+            counters.stats = renderDevice->GetLastFrameStats();
+            IndexT type;
+            for (type = 0; type < RenderDevice::NumStateTypes; type++)
+            {
+                counters.numIssued[type] = renderDevice->GetNumIssuedStateChanges(RenderDevice::StateType(type));
+                counters.numFiltered[type] = renderDevice->GetNumFilteredStateChanges(RenderDevice::StateType(type));
+            }
+            IndexT batchIndex;
+            for (batchIndex = 0; batchIndex < NumBatches; batchIndex++)
+            {
+                const CommandList& commandList = batches[batchIndex]->GetCommandList();
+                counters.numCommands[batchIndex] = commandList.GetNumCommands();
+                counters.byteSize[batchIndex] = commandList.GetByteSize();
+            }
+            return counters;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        bool IsEqual(const FrameCounters& a, const FrameCounters& b)
+        {
+            if ((a.stats.numFrames != b.stats.numFrames) ||
+                (a.stats.numPasses != b.stats.numPasses) ||
+                (a.stats.numBatches != b.stats.numBatches) ||
+                (a.stats.numDraws != b.stats.numDraws) ||
+                (a.stats.numPrimitives != b.stats.numPrimitives))
+            {
+                return false;
+            }
+            IndexT type;
+            for (type = 0; type < RenderDevice::NumStateTypes; type++)
+            {
+                if ((a.numIssued[type] != b.numIssued[type]) || (a.numFiltered[type] != b.numFiltered[type]))
+                {
+                    return false;
+                }
+            }
+            IndexT batchIndex;
+            for (batchIndex = 0; batchIndex < NumBatches; batchIndex++)
+            {
+                if ((a.numCommands[batchIndex] != b.numCommands[batchIndex]) || (a.byteSize[batchIndex] != b.byteSize[batchIndex]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Records the batches of a frame on several record threads, replays
+        them on the null render device and compares the counted commands
+        and the size of every batch's command list with the same frame
+        recorded on the render thread.
+    */
+    void testBatchRecorder::Run()
+    {
+        Ptr<DisplayDevice> displayDevice = DisplayDevice::Create();
+        Verify(displayDevice->Open());
+        Ptr<RenderDevice> renderDevice = RenderDevice::Create();
+        Verify(renderDevice->Open());
+
+        Ptr<Shader> batchShader = CreateShader(ResourceId("shd:testBatchRecorderBatch"));
+        Ptr<Shader> itemShader = CreateShader(ResourceId("shd:testBatchRecorderItem"));
+        itemShader->AddVariation(ShaderVariation::Name("Solid"), 1);
+        itemShader->AddVariation(ShaderVariation::Name("Alpha"), 2);
+        Ptr<ShaderInstance> itemShaderInst = itemShader->CreateShaderInstance();
+
+        Array<Ptr<VertexBuffer> > vertexBuffers;
+        IndexT i;
+        for (i = 0; i < NumVertexBuffers; i++)
+        {
+            vertexBuffers.Append(CreateVertexBuffer(NumVertices));
+            Verify(vertexBuffers[i]->IsLoaded());
+        }
+
+        Ptr<RenderTarget> renderTarget = RenderTarget::Create();
+        renderTarget->SetWidth(64);
+        renderTarget->SetHeight(64);
+        renderTarget->AddColorBuffer(PixelFormat::A8R8G8B8);
+        renderTarget->Setup();
+
+        // an opaque pass and an alpha pass
+        Array<Ptr<FramePass> > passes;
+        Array<Ptr<FrameBatch> > batches;
+        for (i = 0; i < 2; i++)
+        {
+            Ptr<FramePass> pass = FramePass::Create();
+            pass->SetName(ResourceId((0 == i) ? "Opaque" : "Alpha"));
+            pass->SetRenderTarget(renderTarget);
+            const SizeT numBatches = (0 == i) ? NumOpaqueBatches : NumAlphaBatches;
+            IndexT batchIndex;
+            for (batchIndex = 0; batchIndex < numBatches; batchIndex++)
+            {
+                Ptr<FrameBatch> batch = FrameBatch::Create();
+                batch->SetShader(batchShader->CreateShaderInstance());
+                batch->SetType((0 == i) ? BatchType::Solid : BatchType::Alpha);
+                batch->SetSortingMode((0 == i) ? SortingMode::FrontToBack : SortingMode::BackToFront);
+                pass->AddBatch(batch);
+                batches.Append(batch);
+            }
+            passes.Append(pass);
+        }
+
+        // the reference frame is recorded on the render thread, the first
+        // frame only brings the filtered state changes into a steady state
+        AddDrawItems(batches, itemShaderInst, vertexBuffers);
+        RenderFrame(passes, batches, 0);
+        AddDrawItems(batches, itemShaderInst, vertexBuffers);
+        FrameCounters reference = RenderFrame(passes, batches, 0);
+        Verify(2 == reference.stats.numPasses);
+        Verify(NumBatches == reference.stats.numBatches);
+        Verify(reference.stats.numDraws > 0);
+        Verify(reference.numCommands[NumBatches - 1] > 2);
+
+        // record the same frames on the record threads
+        Ptr<BatchRecorder> recorder = BatchRecorder::Create();
+        recorder->Open(NumRecordThreads);
+        Verify(recorder->IsOpen());
+        Verify(NumRecordThreads == recorder->GetNumThreads());
+        bool allEqual = true;
+        for (i = 0; i < NumThreadedFrames; i++)
+        {
+            AddDrawItems(batches, itemShaderInst, vertexBuffers);
+            allEqual &= IsEqual(reference, RenderFrame(passes, batches, recorder));
+        }
+        Verify(allEqual);
+
+        // an empty frame, nothing to record
+        FrameCounters empty = RenderFrame(passes, batches, recorder);
+        Verify(0 == empty.stats.numDraws);
+        Verify(NumBatches == empty.stats.numBatches);
+        Verify(2 == empty.numCommands[0]);
+
+        recorder->Close();
+        Verify(!recorder->IsOpen());
+
+        for (i = 0; i < passes.Size(); i++)
+        {
+            passes[i]->Discard();
+        }
+        renderTarget->Discard();
+        itemShaderInst->Discard();
+        itemShader->Unload();
+        batchShader->Unload();
+        for (i = 0; i < vertexBuffers.Size(); i++)
+        {
+            vertexBuffers[i]->Unload();
+        }
+        renderDevice->Close();
+        displayDevice->Close();
+    }
+};
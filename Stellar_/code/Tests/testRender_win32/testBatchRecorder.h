@@ -0,0 +1,18 @@
+#ifndef TEST_TESTBATCHRECORDER_H
+#define TEST_TESTBATCHRECORDER_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testBatchRecorder : public Test::TestCase
+{
+    DeclareClass(testBatchRecorder);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
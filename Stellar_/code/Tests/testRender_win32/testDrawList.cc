@@ -0,0 +1,222 @@
+#include "stdneb.h"
+#include "testDrawList.h"
+#include "coregraphics/shader.h"
+#include "coregraphics/streamshaderloader.h"
+#include "coregraphics/vertexbuffer.h"
+#include "coregraphics/shadervariableinstance.h"
+#include "frame/drawlist.h"
+#include <algorithm>
+
+namespace Test
+{
+    ImplementClass(Test::testDrawList, 'TDrL', Test::TestCase);
+
+    using namespace Util;
+    using namespace CoreGraphics;
+    using namespace Resources;
+    using namespace Frame;
+
+    namespace
+    {
+        const SizeT NumItems = 2000;
+        const SizeT NumVertexBuffers = 5;
+        const SizeT NumMaterials = 3;
+
+        /// a sort key and the index of its item
+        struct KeyedItem
+        {
+            DrawList::SortKey key;
+            IndexT itemIndex;
+        };
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        bool CompareKeys(const KeyedItem& a, const KeyedItem& b)
+        {
+            return a.key < b.key;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            A small LCG, so the items are the same on every run.
+        */
+        unsigned int NextRandom(unsigned int& seed)
+        {
+            seed = seed * 1664525 + 1013904223;
+            return seed >> 16;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        IndexT GetSortedItemIndex(const DrawList& list, IndexT i)
+        {
+            return IndexT(&list.GetSortedItem(i) - &list.GetItem(0));
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        bool IsSameState(const DrawList::Item& a, const DrawList::Item& b)
+        {
+            return (a.pass == b.pass) && (a.features == b.features) &&
+                   (a.material == b.material) && (a.vertexBuffer == b.vertexBuffer);
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Sorts the same draw items with every sorting mode and compares the
+        radix sort against std::stable_sort of the same keys. The depths
+        repeat, so there are many equal keys to check the stability.
+    */
+    void testDrawList::Run()
+    {
+        Ptr<Shader> shader = Shader::Create();
+        shader->SetResourceId(ResourceId("shd:testDrawList"));
+        shader->SetLoader(StreamShaderLoader::Create());
+        shader->SetAsyncEnabled(false);
+        shader->Load();
+        shader->SetLoader(0);
+        shader->AddVariation(ShaderVariation::Name("Solid"), 1);
+        shader->AddVariation(ShaderVariation::Name("Alpha"), 2);
+        shader->AddVariation(ShaderVariation::Name("Skinned"), 3);
+        Ptr<ShaderInstance> shaderInst = shader->CreateShaderInstance();
+
+        Array<Ptr<VertexBuffer> > vertexBuffers;
+        IndexT i;
+        for (i = 0; i < NumVertexBuffers; i++)
+        {
+            vertexBuffers.Append(VertexBuffer::Create());
+        }
+        Array<Ptr<ShaderVariableInstance> > materials;
+        for (i = 0; i < NumMaterials; i++)
+        {
+            materials.Append(ShaderVariableInstance::Create());
+        }
+
+        DrawList list;
+        unsigned int seed = 12345;
+        for (i = 0; i < NumItems; i++)
+        {
+            DrawList::Item item;
+            item.shader = shaderInst;
+            item.features = 1 + NextRandom(seed) % 3;
+            item.pass = NextRandom(seed) % 3;
+            unsigned int material = NextRandom(seed) % (NumMaterials + 1);
+            if (material < NumMaterials)
+            {
+                item.material = materials[material];
+            }
+            item.vertexBuffer = vertexBuffers[NextRandom(seed) % NumVertexBuffers];
+            item.depth = float(NextRandom(seed) % 64) * 0.5f - 4.0f;
+            list.Add(item);
+        }
+
+        const SortingMode::Code modes[] = { SortingMode::None, SortingMode::FrontToBack, SortingMode::BackToFront };
+        IndexT modeIndex;
+        for (modeIndex = 0; modeIndex < sizeof(modes) / sizeof(modes[0]); modeIndex++)
+        {
+            const SortingMode::Code mode = modes[modeIndex];
+            list.Sort(mode);
+            Verify(NumItems == list.Size());
+
+            // the sorted items are a permutation with ascending keys and the right variations
+            Array<KeyedItem> expected;
+            expected.resize(NumItems);
+            Array<bool> seen;
+            seen.resize(NumItems, false);
+            bool isPermutation = true;
+            bool keysAscending = true;
+            bool variationsMatch = true;
+            for (i = 0; i < NumItems; i++)
+            {
+                IndexT itemIndex = GetSortedItemIndex(list, i);
+                isPermutation &= (itemIndex >= 0) && (itemIndex < NumItems) && !seen[itemIndex];
+                if (!isPermutation)
+                {
+                    break;
+                }
+                seen[itemIndex] = true;
+                expected[itemIndex].key = list.GetSortedKey(i);
+                expected[itemIndex].itemIndex = itemIndex;
+                keysAscending &= (0 == i) || (list.GetSortedKey(i - 1) <= list.GetSortedKey(i));
+                const DrawList::Item& item = list.GetItem(itemIndex);
+                variationsMatch &= (list.GetSortedVariation(i) == shaderInst->LookupVariation(item.features));
+            }
+            Verify(isPermutation);
+            if (!isPermutation)
+            {
+                continue;
+            }
+            Verify(keysAscending);
+            Verify(variationsMatch);
+
+            // the radix sort gives the same order as a stable sort of the keys in adding order
+            std::stable_sort(expected.begin(), expected.end(), CompareKeys);
+            bool matchesStableSort = true;
+            for (i = 0; i < NumItems; i++)
+            {
+                matchesStableSort &= (expected[i].itemIndex == GetSortedItemIndex(list, i));
+            }
+            Verify(matchesStableSort);
+
+            // check the order the sorting mode promises, items which compare
+            // equal have to stay in the order they were added in
+            bool ordered = true;
+            for (i = 1; i < NumItems; i++)
+            {
+                const IndexT prevIndex = GetSortedItemIndex(list, i - 1);
+                const IndexT curIndex = GetSortedItemIndex(list, i);
+                const DrawList::Item& prev = list.GetItem(prevIndex);
+                const DrawList::Item& cur = list.GetItem(curIndex);
+                ordered &= (prev.pass <= cur.pass);
+                if (prev.pass != cur.pass)
+                {
+                    continue;
+                }
+                if (SortingMode::BackToFront == mode)
+                {
+                    ordered &= (prev.depth >= cur.depth);
+                    if ((prev.depth == cur.depth) && IsSameState(prev, cur))
+                    {
+                        ordered &= (prevIndex < curIndex);
+                    }
+                }
+                else if (IsSameState(prev, cur))
+                {
+                    if (SortingMode::FrontToBack == mode)
+                    {
+                        ordered &= (prev.depth <= cur.depth);
+                        if (prev.depth == cur.depth)
+                        {
+                            ordered &= (prevIndex < curIndex);
+                        }
+                    }
+                    else
+                    {
+                        ordered &= (prevIndex < curIndex);
+                    }
+                }
+            }
+            Verify(ordered);
+        }
+
+        // a single item and an empty list
+        list.Clear();
+        list.Sort(SortingMode::BackToFront);
+        Verify(list.IsEmpty());
+        DrawList::Item single;
+        single.shader = shaderInst;
+        single.features = 2;
+        single.vertexBuffer = vertexBuffers[0];
+        list.Add(single);
+        list.Sort(SortingMode::FrontToBack);
+        Verify(1 == list.Size() && 0 == GetSortedItemIndex(list, 0));
+
+        list.Clear();
+        shaderInst->Discard();
+        shader->Unload();
+    }
+};
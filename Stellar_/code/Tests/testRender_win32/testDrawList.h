@@ -0,0 +1,18 @@
+#ifndef TEST_TESTDRAWLIST_H
+#define TEST_TESTDRAWLIST_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testDrawList : public Test::TestCase
+{
+    DeclareClass(testDrawList);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
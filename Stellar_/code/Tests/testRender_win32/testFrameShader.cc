@@ -0,0 +1,140 @@
+#include "stdneb.h"
+#include "testFrameShader.h"
+#include "testHelpers.h"
+#include "coregraphics/displaydevice.h"
+#include "coregraphics/renderdevice.h"
+#include "coregraphics/rendertarget.h"
+#include "frame/frameshader.h"
+
+namespace Test
+{
+    ImplementClass(Test::testFrameShader, 'TFrS', Test::TestCase);
+
+    using namespace Util;
+    using namespace CoreGraphics;
+    using namespace Resources;
+    using namespace Frame;
+
+    namespace
+    {
+        const SizeT NumVertices = 12;
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        Ptr<FrameBatch> CreateBatch(const Ptr<Shader>& batchShader, BatchType::Code batchType, SortingMode::Code sortingMode)
+        {
+            Ptr<FrameBatch> batch = FrameBatch::Create();
+            batch->SetShader(batchShader->CreateShaderInstance());
+            batch->SetType(batchType);
+            batch->SetSortingMode(sortingMode);
+            return batch;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Adds numItems triangles to a batch, the items alternate between
+            two variations of the item shader.
+        */
+        void AddTriangles(const Ptr<FrameBatch>& batch, const Ptr<ShaderInstance>& itemShader, const Ptr<VertexBuffer>& vb, SizeT numItems)
+        {
+            IndexT i;
+            for (i = 0; i < numItems; i++)
+            {
+                DrawList::Item item;
+                item.shader = itemShader;
+                item.features = (i & 1) ? 2 : 1;
+                item.vertexBuffer = vb;
+                item.primitiveGroup.SetBaseVertex((i % (NumVertices / 3)) * 3);
+                item.primitiveGroup.SetNumVertices(3);
+                item.primitiveGroup.SetPrimitiveTopology(PrimitiveTopology::TriangleList);
+                item.depth = float(i);
+                batch->AddDrawItem(item);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Renders a frame shader with two passes and three batches on the
+        null render device and checks the counted commands.
+    */
+    void testFrameShader::Run()
+    {
+        Ptr<DisplayDevice> displayDevice = DisplayDevice::Create();
+        Verify(displayDevice->Open());
+        Ptr<RenderDevice> renderDevice = RenderDevice::Create();
+        Verify(renderDevice->Open());
+
+        // shaders, the batch shader has the default variation only
+        Ptr<Shader> batchShader = CreateShader(ResourceId("shd:testFrameShaderBatch"));
+        Ptr<Shader> itemShader = CreateShader(ResourceId("shd:testFrameShaderItem"));
+        itemShader->AddVariation(ShaderVariation::Name("Solid"), 1);
+        itemShader->AddVariation(ShaderVariation::Name("Alpha"), 2);
+        Ptr<ShaderInstance> itemShaderInst = itemShader->CreateShaderInstance();
+
+        // a vertex buffer with four triangles
+        Ptr<VertexBuffer> vb = CreateVertexBuffer(NumVertices);
+        Verify(vb->IsLoaded());
+
+        Ptr<RenderTarget> renderTarget = RenderTarget::Create();
+        renderTarget->SetWidth(64);
+        renderTarget->SetHeight(64);
+        renderTarget->AddColorBuffer(PixelFormat::A8R8G8B8);
+        renderTarget->Setup();
+
+        // an opaque pass with two batches and an alpha pass with one batch
+        Ptr<FramePass> opaquePass = FramePass::Create();
+        opaquePass->SetName(ResourceId("Opaque"));
+        opaquePass->SetRenderTarget(renderTarget);
+        Ptr<FrameBatch> solidBatch = CreateBatch(batchShader, BatchType::Solid, SortingMode::FrontToBack);
+        Ptr<FrameBatch> decalBatch = CreateBatch(batchShader, BatchType::Solid, SortingMode::FrontToBack);
+        opaquePass->AddBatch(solidBatch);
+        opaquePass->AddBatch(decalBatch);
+        Ptr<FramePass> alphaPass = FramePass::Create();
+        alphaPass->SetName(ResourceId("Alpha"));
+        alphaPass->SetRenderTarget(renderTarget);
+        Ptr<FrameBatch> alphaBatch = CreateBatch(batchShader, BatchType::Alpha, SortingMode::BackToFront);
+        alphaPass->AddBatch(alphaBatch);
+
+        Ptr<FrameShader> frameShader = FrameShader::Create();
+        frameShader->SetName(ResourceId("testFrameShader"));
+        frameShader->SetMainRenderTarget(renderTarget);
+        frameShader->AddFramePass(opaquePass);
+        frameShader->AddFramePass(alphaPass);
+
+        // the first frame draws 5 + 3 + 4 triangles
+        AddTriangles(solidBatch, itemShaderInst, vb, 5);
+        AddTriangles(decalBatch, itemShaderInst, vb, 3);
+        AddTriangles(alphaBatch, itemShaderInst, vb, 4);
+        Verify(renderDevice->BeginFrame());
+        frameShader->Render();
+        renderDevice->EndFrame();
+        const RenderDevice::Stats& firstStats = renderDevice->GetLastFrameStats();
+        Verify(1 == firstStats.numFrames);
+        Verify(2 == firstStats.numPasses);
+        Verify(3 == firstStats.numBatches);
+        Verify(12 == firstStats.numDraws);
+        Verify(12 == firstStats.numPrimitives);
+
+        // the draw items are only rendered in the frame they were added for
+        Verify(renderDevice->BeginFrame());
+        frameShader->Render();
+        renderDevice->EndFrame();
+        const RenderDevice::Stats& secondStats = renderDevice->GetLastFrameStats();
+        Verify(2 == secondStats.numPasses);
+        Verify(3 == secondStats.numBatches);
+        Verify(0 == secondStats.numDraws);
+        Verify(2 == renderDevice->GetStats().numFrames);
+        Verify(12 == renderDevice->GetStats().numDraws);
+
+        frameShader->Discard();
+        renderTarget->Discard();
+        itemShaderInst->Discard();
+        itemShader->Unload();
+        batchShader->Unload();
+        vb->Unload();
+        renderDevice->Close();
+        displayDevice->Close();
+    }
+};
@@ -0,0 +1,18 @@
+#ifndef TEST_TESTFRAMESHADER_H
+#define TEST_TESTFRAMESHADER_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testFrameShader : public Test::TestCase
+{
+    DeclareClass(testFrameShader);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
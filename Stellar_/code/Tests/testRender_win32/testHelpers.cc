@@ -0,0 +1,44 @@
+#include "stdneb.h"
+#include "testHelpers.h"
+#include "coregraphics/streamshaderloader.h"
+#include "coregraphics/memoryvertexbufferloader.h"
+
+namespace Test
+{
+    using namespace Util;
+    using namespace CoreGraphics;
+    using namespace Resources;
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    Ptr<Shader> CreateShader(const ResourceId& resId)
+    {
+        Ptr<Shader> shader = Shader::Create();
+        shader->SetResourceId(resId);
+        shader->SetLoader(StreamShaderLoader::Create());
+        shader->SetAsyncEnabled(false);
+        shader->Load();
+        shader->SetLoader(0);
+        return shader;
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    Ptr<VertexBuffer> CreateVertexBuffer(SizeT numVertices)
+    {
+        Array<VertexComponent> components;
+        components.Append(VertexComponent(VertexComponent::Position, 0, VertexComponent::Float3));
+        Array<float> vertices;
+        vertices.resize(numVertices * 3, 0.0f);
+        Ptr<MemoryVertexBufferLoader> vbLoader = MemoryVertexBufferLoader::Create();
+        vbLoader->Setup(components, numVertices, &vertices[0], numVertices * 3 * sizeof(float));
+        Ptr<VertexBuffer> vb = VertexBuffer::Create();
+        vb->SetLoader(vbLoader.upcast<ResourceLoader>());
+        vb->SetAsyncEnabled(false);
+        vb->Load();
+        vb->SetLoader(0);
+        return vb;
+    }
+};
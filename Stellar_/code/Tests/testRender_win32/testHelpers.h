@@ -0,0 +1,21 @@
+#ifndef TEST_TESTHELPERS_H
+#define TEST_TESTHELPERS_H
+//------------------------------------------------------------------------------
+/**
+    Resources shared by the render tests, created synchronously on the
+    null render device.
+*/
+#include "core/ptr.h"
+#include "resources/resourceid.h"
+#include "coregraphics/shader.h"
+#include "coregraphics/vertexbuffer.h"
+
+namespace Test
+{
+/// load a shader without any variations except the default one
+Ptr<CoreGraphics::Shader> CreateShader(const Resources::ResourceId& resId);
+/// create a vertex buffer with numVertices positions, all at the origin
+Ptr<CoreGraphics::VertexBuffer> CreateVertexBuffer(SizeT numVertices);
+};
+
+#endif
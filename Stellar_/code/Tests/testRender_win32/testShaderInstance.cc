@@ -0,0 +1,140 @@
+#include "stdneb.h"
+#include "testShaderInstance.h"
+#include "testHelpers.h"
+#include "coregraphics/shader.h"
+#include "coregraphics/shaderinstance.h"
+
+namespace Test
+{
+    ImplementClass(Test::testShaderInstance, 'TShI', Test::TestCase);
+
+    using namespace Util;
+    using namespace CoreGraphics;
+    using namespace Resources;
+
+    namespace
+    {
+        /// feature bits spread over all bytes of the mask, enough for the lookup table
+        const ShaderFeature::Mask TableBits[] = { 1 << 0, 1 << 3, 1 << 9, 1 << 15, 1 << 16, 1 << 23, 1 << 24, 1u << 31 };
+        /// one feature bit more than the lookup table covers
+        const ShaderFeature::Mask DictionaryBits[] = { 1 << 0, 1 << 2, 1 << 5, 1 << 8, 1 << 11, 1 << 14, 1 << 17, 1 << 20, 1 << 26, 1 << 29 };
+        /// feature bits which no variation uses
+        const ShaderFeature::Mask UnusedBits[] = { 0, 1 << 1, 1 << 30 };
+
+        //------------------------------------------------------------------------------
+        /*
+            Maps the bits of subset onto the given feature bits.
+        */
+        ShaderFeature::Mask SubsetToMask(unsigned int subset, const ShaderFeature::Mask* bits, SizeT numBits)
+        {
+            ShaderFeature::Mask mask = 0;
+            IndexT i;
+            for (i = 0; i < numBits; i++)
+            {
+                if (0 != (subset & (1 << i)))
+                {
+                    mask |= bits[i];
+                }
+            }
+            return mask;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Creates a shader with variations for some of the subsets of the
+            feature bits, always including the empty and the full subset.
+        */
+        Ptr<Shader> CreateVariationShader(const ResourceId& resId, const ShaderFeature::Mask* bits, SizeT numBits)
+        {
+            Ptr<Shader> shader = CreateShader(resId);
+            const unsigned int numSubsets = 1 << numBits;
+            unsigned int subset;
+            for (subset = 0; subset < numSubsets; subset++)
+            {
+                if ((0 == (subset * 37) % 5) || (numSubsets - 1 == subset))
+                {
+                    shader->AddVariation(ShaderVariation::Name("Variation"), SubsetToMask(subset, bits, numBits));
+                }
+            }
+            return shader;
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Compares LookupVariation() with the variation dictionary for
+            every subset of the feature bits, alone and together with bits
+            which no variation uses.
+        */
+        bool LookupMatchesDictionary(const Ptr<ShaderInstance>& shaderInst, const ShaderFeature::Mask* bits, SizeT numBits)
+        {
+            const unsigned int numSubsets = 1 << numBits;
+            unsigned int subset;
+            for (subset = 0; subset < numSubsets; subset++)
+            {
+                IndexT unusedIndex;
+                for (unusedIndex = 0; unusedIndex < sizeof(UnusedBits) / sizeof(UnusedBits[0]); unusedIndex++)
+                {
+                    ShaderFeature::Mask mask = SubsetToMask(subset, bits, numBits) | UnusedBits[unusedIndex];
+                    ShaderVariation* expected = 0;
+                    if (shaderInst->HasVariation(mask))
+                    {
+                        expected = shaderInst->GetVariationByFeatureMask(mask).get();
+                    }
+                    if (shaderInst->LookupVariation(mask) != expected)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+    */
+    void testShaderInstance::Run()
+    {
+        // eight feature bits in all four bytes of the mask go through the lookup table
+        const SizeT numTableBits = sizeof(TableBits) / sizeof(TableBits[0]);
+        Ptr<Shader> tableShader = CreateVariationShader(ResourceId("shd:testShaderInstanceTable"), TableBits, numTableBits);
+        Ptr<ShaderInstance> tableShaderInst = tableShader->CreateShaderInstance();
+        Verify(tableShaderInst->GetNumVariations() > 2);
+        Verify(0 != tableShaderInst->LookupVariation(0));
+        Verify(0 != tableShaderInst->LookupVariation(SubsetToMask((1 << numTableBits) - 1, TableBits, numTableBits)));
+        Verify(LookupMatchesDictionary(tableShaderInst, TableBits, numTableBits));
+
+        // more feature bits fall back to the dictionary
+        const SizeT numDictionaryBits = sizeof(DictionaryBits) / sizeof(DictionaryBits[0]);
+        Ptr<Shader> dictionaryShader = CreateVariationShader(ResourceId("shd:testShaderInstanceDictionary"), DictionaryBits, numDictionaryBits);
+        Ptr<ShaderInstance> dictionaryShaderInst = dictionaryShader->CreateShaderInstance();
+        Verify(LookupMatchesDictionary(dictionaryShaderInst, DictionaryBits, numDictionaryBits));
+
+        // a second instance shares the remap table of the shader
+        Ptr<ShaderInstance> secondTableShaderInst = tableShader->CreateShaderInstance();
+        Verify(LookupMatchesDictionary(secondTableShaderInst, TableBits, numTableBits));
+        Verify(LookupMatchesDictionary(tableShaderInst, TableBits, numTableBits));
+
+        // a shader without variations only has the default variation
+        Ptr<Shader> defaultShader = CreateShader(ResourceId("shd:testShaderInstanceDefault"));
+        Ptr<ShaderInstance> defaultShaderInst = defaultShader->CreateShaderInstance();
+        Verify(1 == defaultShaderInst->GetNumVariations());
+        Verify("Default" == defaultShaderInst->GetVariationByIndex(0)->GetName().Value());
+        Verify(defaultShaderInst->LookupVariation(0) == defaultShaderInst->GetVariationByIndex(0).get());
+        Verify(0 == defaultShaderInst->LookupVariation(1 << 4));
+
+        // a variation added later with a new feature bit is found by the existing instance
+        defaultShader->AddVariation(ShaderVariation::Name("Solid"), 1 << 4);
+        Verify(2 == defaultShaderInst->GetNumVariations());
+        Verify(defaultShaderInst->LookupVariation(1 << 4) == defaultShaderInst->GetVariationByFeatureMask(1 << 4).get());
+        Verify(defaultShaderInst->LookupVariation(0) == defaultShaderInst->GetVariationByFeatureMask(0).get());
+
+        tableShaderInst->Discard();
+        secondTableShaderInst->Discard();
+        dictionaryShaderInst->Discard();
+        defaultShaderInst->Discard();
+        tableShader->Unload();
+        dictionaryShader->Unload();
+        defaultShader->Unload();
+    }
+};
@@ -0,0 +1,18 @@
+#ifndef TEST_TESTSHADERINSTANCE_H
+#define TEST_TESTSHADERINSTANCE_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testShaderInstance : public Test::TestCase
+{
+    DeclareClass(testShaderInstance);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
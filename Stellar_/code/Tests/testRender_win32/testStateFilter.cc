@@ -0,0 +1,221 @@
+#include "stdneb.h"
+#include "testStateFilter.h"
+#include "testHelpers.h"
+#include "coregraphics/displaydevice.h"
+#include "coregraphics/renderdevice.h"
+#include "coregraphics/rendertarget.h"
+#include "coregraphics/base/shadervariablebase.h"
+#include "math/matrix44.h"
+
+namespace Test
+{
+    ImplementClass(Test::testStateFilter, 'TStF', Test::TestCase);
+
+    using namespace Util;
+    using namespace Math;
+    using namespace CoreGraphics;
+    using namespace Resources;
+
+    namespace
+    {
+        const SizeT NumMatrices = 8;
+        const SizeT NumVectors = 6;
+        const SizeT NumVertices = 3;
+
+        //------------------------------------------------------------------------------
+        /*
+            Gives the test access to the shadow copy of ShaderVariableBase.
+        */
+        class ShadowVariable : public Base::ShaderVariableBase
+        {
+            DeclareClass(ShadowVariable);
+        public:
+            /// setup the number of array elements
+            void Setup(SizeT numElements)
+            {
+                this->SetNumArrayElements(numElements);
+            }
+            /// turn the shadow copy on or off
+            void Shadow(bool b)
+            {
+                this->SetShadowed(b);
+            }
+            /// compare values with the shadow copy
+            bool Update(const void* values, SizeT elementSize, SizeT count, IndexT& first, SizeT& num)
+            {
+                return this->UpdateShadow(values, elementSize, count, first, num);
+            }
+        };
+        ImplementClass(ShadowVariable, 'TShV', Base::ShaderVariableBase);
+
+        //------------------------------------------------------------------------------
+        /*
+        */
+        matrix44 MakeMatrix(float x)
+        {
+            return matrix44(float4(x, 0.0f, 0.0f, 0.0f), float4(0.0f, 1.0f, 0.0f, 0.0f), float4(0.0f, 0.0f, 1.0f, 0.0f), float4(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Passes the values to the variable and checks the dirty range.
+        */
+        bool IsDirty(const Ptr<ShadowVariable>& var, const void* values, SizeT elementSize, SizeT count, IndexT expectedFirst, SizeT expectedNum)
+        {
+            IndexT first;
+            SizeT num;
+            bool issued = var->Update(values, elementSize, count, first, num);
+            return issued && (first == expectedFirst) && (num == expectedNum);
+        }
+
+        //------------------------------------------------------------------------------
+        /*
+            Passes the values to the variable and checks that they are filtered.
+        */
+        bool IsFiltered(const Ptr<ShadowVariable>& var, const void* values, SizeT elementSize, SizeT count)
+        {
+            IndexT first;
+            SizeT num;
+            return !var->Update(values, elementSize, count, first, num);
+        }
+    }
+
+    //------------------------------------------------------------------------------
+    /*
+        Checks the shadow copy of shader variables and the state change
+        counters of the render device on the null render device.
+    */
+    void testStateFilter::Run()
+    {
+        Ptr<DisplayDevice> displayDevice = DisplayDevice::Create();
+        Verify(displayDevice->Open());
+        Ptr<RenderDevice> renderDevice = RenderDevice::Create();
+        Verify(renderDevice->Open());
+        IndexT i;
+
+        // a single value, setting it again is filtered
+        Verify(renderDevice->BeginFrame());
+        Ptr<ShadowVariable> scalarVar = ShadowVariable::Create();
+        float value = 1.0f;
+        Verify(IsDirty(scalarVar, &value, sizeof(value), 1, 0, 1));
+        Verify(IsFiltered(scalarVar, &value, sizeof(value), 1));
+        value = 2.0f;
+        Verify(IsDirty(scalarVar, &value, sizeof(value), 1, 0, 1));
+        Verify(IsFiltered(scalarVar, &value, sizeof(value), 1));
+        renderDevice->EndFrame();
+        Verify(2 == renderDevice->GetNumIssuedStateChanges(RenderDevice::ConstantState));
+        Verify(2 == renderDevice->GetNumFilteredStateChanges(RenderDevice::ConstantState));
+
+        // the counters only hold the last frame
+        Verify(renderDevice->BeginFrame());
+        Verify(IsFiltered(scalarVar, &value, sizeof(value), 1));
+        renderDevice->EndFrame();
+        Verify(0 == renderDevice->GetNumIssuedStateChanges(RenderDevice::ConstantState));
+        Verify(1 == renderDevice->GetNumFilteredStateChanges(RenderDevice::ConstantState));
+
+        // only the range from the first to the last changed matrix is dirty
+        Verify(renderDevice->BeginFrame());
+        Ptr<ShadowVariable> matrixVar = ShadowVariable::Create();
+        matrixVar->Setup(NumMatrices);
+        matrix44 matrices[NumMatrices];
+        for (i = 0; i < NumMatrices; i++)
+        {
+            matrices[i] = MakeMatrix(float(i));
+        }
+        Verify(IsDirty(matrixVar, matrices, sizeof(matrix44), NumMatrices, 0, NumMatrices));
+        Verify(IsFiltered(matrixVar, matrices, sizeof(matrix44), NumMatrices));
+        matrices[3] = MakeMatrix(30.0f);
+        matrices[5] = MakeMatrix(50.0f);
+        Verify(IsDirty(matrixVar, matrices, sizeof(matrix44), NumMatrices, 3, 3));
+        matrices[NumMatrices - 1] = MakeMatrix(70.0f);
+        Verify(IsDirty(matrixVar, matrices, sizeof(matrix44), NumMatrices, NumMatrices - 1, 1));
+        matrices[0] = MakeMatrix(-1.0f);
+        Verify(IsDirty(matrixVar, matrices, sizeof(matrix44), NumMatrices, 0, 1));
+
+        // a shorter array which matches the start of the shadow copy is filtered
+        Verify(IsFiltered(matrixVar, matrices, sizeof(matrix44), 4));
+
+        // vector elements which have never been set are always dirty
+        Ptr<ShadowVariable> vectorVar = ShadowVariable::Create();
+        vectorVar->Setup(NumVectors);
+        float4 vectors[NumVectors];
+        for (i = 0; i < NumVectors; i++)
+        {
+            vectors[i] = float4(float(i), 0.0f, 0.0f, 1.0f);
+        }
+        Verify(IsDirty(vectorVar, vectors, sizeof(float4), 2, 0, 2));
+        Verify(IsDirty(vectorVar, vectors, sizeof(float4), NumVectors, 2, NumVectors - 2));
+        vectors[1] = float4(10.0f, 0.0f, 0.0f, 1.0f);
+        vectors[2] = float4(20.0f, 0.0f, 0.0f, 1.0f);
+        Verify(IsDirty(vectorVar, vectors, sizeof(float4), NumVectors, 1, 2));
+        Verify(IsFiltered(vectorVar, vectors, sizeof(float4), NumVectors));
+
+        // after invalidating the shadow copy the whole array is uploaded
+        vectorVar->InvalidateShadow();
+        Verify(IsDirty(vectorVar, vectors, sizeof(float4), NumVectors, 0, NumVectors));
+
+        // without a shadow copy every value is passed through
+        Ptr<ShadowVariable> sharedVar = ShadowVariable::Create();
+        sharedVar->Shadow(false);
+        Verify(!sharedVar->IsShadowed());
+        Verify(IsDirty(sharedVar, &value, sizeof(value), 1, 0, 1));
+        Verify(IsDirty(sharedVar, &value, sizeof(value), 1, 0, 1));
+        renderDevice->EndFrame();
+        Verify(10 == renderDevice->GetNumIssuedStateChanges(RenderDevice::ConstantState));
+        Verify(3 == renderDevice->GetNumFilteredStateChanges(RenderDevice::ConstantState));
+
+        // batch shaders and vertex buffers
+        Ptr<Shader> shaderA = CreateShader(ResourceId("shd:testStateFilterA"));
+        Ptr<Shader> shaderB = CreateShader(ResourceId("shd:testStateFilterB"));
+        Ptr<ShaderInstance> shaderInstA = shaderA->CreateShaderInstance();
+        Ptr<ShaderInstance> shaderInstB = shaderB->CreateShaderInstance();
+        Ptr<VertexBuffer> vb = CreateVertexBuffer(NumVertices);
+        Ptr<RenderTarget> renderTarget = RenderTarget::Create();
+        renderTarget->SetWidth(64);
+        renderTarget->SetHeight(64);
+        renderTarget->AddColorBuffer(PixelFormat::A8R8G8B8);
+        renderTarget->Setup();
+
+        // a batch with the same shader as the one before is filtered
+        Verify(renderDevice->BeginFrame());
+        renderDevice->BeginPass(renderTarget, 0);
+        ShaderInstance* batchShaders[] = { shaderInstA, shaderInstA, shaderInstB, shaderInstB, shaderInstB, shaderInstA };
+        for (i = 0; i < sizeof(batchShaders) / sizeof(batchShaders[0]); i++)
+        {
+            renderDevice->BeginBatch(BatchType::Solid, batchShaders[i]);
+            renderDevice->SetVertexBuffer(vb);
+            renderDevice->EndBatch();
+        }
+        renderDevice->EndPass();
+        renderDevice->EndFrame();
+        Verify(3 == renderDevice->GetNumIssuedStateChanges(RenderDevice::BatchShaderState));
+        Verify(3 == renderDevice->GetNumFilteredStateChanges(RenderDevice::BatchShaderState));
+        Verify(1 == renderDevice->GetNumIssuedStateChanges(RenderDevice::VertexBufferState));
+        Verify(5 == renderDevice->GetNumFilteredStateChanges(RenderDevice::VertexBufferState));
+        Verify(0 == renderDevice->GetNumIssuedStateChanges(RenderDevice::ConstantState));
+
+        // EndPass() ends the batch shader, the next pass begins it again
+        Verify(renderDevice->BeginFrame());
+        renderDevice->BeginPass(renderTarget, 0);
+        renderDevice->BeginBatch(BatchType::Solid, shaderInstA);
+        renderDevice->EndBatch();
+        renderDevice->EndPass();
+        renderDevice->BeginPass(renderTarget, 0);
+        renderDevice->BeginBatch(BatchType::Solid, shaderInstA);
+        renderDevice->EndBatch();
+        renderDevice->EndPass();
+        renderDevice->EndFrame();
+        Verify(2 == renderDevice->GetNumIssuedStateChanges(RenderDevice::BatchShaderState));
+        Verify(0 == renderDevice->GetNumFilteredStateChanges(RenderDevice::BatchShaderState));
+        Verify(0 == renderDevice->GetNumIssuedStateChanges(RenderDevice::VertexBufferState));
+
+        renderTarget->Discard();
+        shaderInstA->Discard();
+        shaderInstB->Discard();
+        shaderA->Unload();
+        shaderB->Unload();
+        vb->Unload();
+        renderDevice->Close();
+        displayDevice->Close();
+    }
+};
@@ -0,0 +1,18 @@
+#ifndef TEST_TESTSTATEFILTER_H
+#define TEST_TESTSTATEFILTER_H
+
+#include "../testbase_win32/testcase.h"
+
+namespace Test
+{
+class testStateFilter : public Test::TestCase
+{
+    DeclareClass(testStateFilter);
+
+public:
+    virtual void Run();
+};
+
+};
+
+#endif
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//  testthread.cc
+//
+//  Stress test for Threading::Thread and the Posix Threading primitives.
+//  Every round starts a set of Thread objects and stops them again:
+//
+//  - counter threads increment a shared counter inside a recursively
+//    entered CriticalSection and a second one with Interlocked, and check
+//    that GetMyThreadName() returns their own name
+//  - a thread parked on an Event is released by EmitWakeupSignal(), so
+//    Stop() must not hang
+//  - producer threads push numbered items through an MpmcQueue to the
+//    main thread, which checks that every item arrives exactly once
+//
+//  Prints the first failure and exits with 1. Add -fsanitize=address to
+//  the build line to run it under AddressSanitizer.
+//
+//  Build from the code directory with:
+//  g++ -O1 -g -Wno-multichar -D__cdecl= -IFoundation
+//      Tests/testthread_posix/testthread.cc
+//      Foundation/thread/thread.cc Foundation/thread/posix/posixthread.cc
+//      Foundation/thread/posix/posixcriticalsection.cc
+//      Foundation/core/rtti.cc Foundation/core/refcounted.cc
+//      Foundation/core/factory.cc Foundation/core/debug.cc
+//      Foundation/utility/system.cc Foundation/memory/objectpool.cc
+//      Foundation/memory/poolheap.cc Foundation/memory/alloctracker.cc
+//      Foundation/memory/posix/posixallocator.cc
+//      Foundation/memory/posix/posixmemory.cc
+//      Foundation/memory/posix/posixheap.cc -lpthread -o testthread
+//
+//  (C) 2007 by Ctuo
+//------------------------------------------------------------------------------
+#include "stdneb.h"
+#include "thread/thread.h"
+#include "thread/criticalsection.h"
+#include "thread/event.h"
+#include "thread/interlocked.h"
+#include "thread/mpmcqueue.h"
+
+namespace
+{
+const int NumRounds = 50;
+const int NumCounterThreads = 4;
+const int NumProducerThreads = 4;
+const int NumItemsPerProducer = 20000;
+const int MinNumIncrements = 1000;
+
+bool Failed = false;
+
+#define Verify(exp) if (!(exp)) { printf("*** check failed: %s, line %d\n", #exp, __LINE__); Failed = true; }
+
+//------------------------------------------------------------------------------
+/**
+    Increments both counters until it is stopped.
+*/
+class CounterThread : public Threading::Thread
+{
+    DeclareClass(CounterThread);
+public:
+    /// constructor
+    CounterThread() :
+        critSect(0),
+        lockedCounter(0),
+        atomicCounter(0),
+        numIncrements(0),
+        nameMatches(false)
+    {
+        // empty
+    }
+
+    Threading::CriticalSection* critSect;
+    int* lockedCounter;
+    int volatile* atomicCounter;
+    int volatile numIncrements;
+    bool nameMatches;
+
+protected:
+    /// count until stopped
+    virtual void DoWork()
+    {
+        this->nameMatches = (this->GetName() == Threading::Thread::GetMyThreadName());
+        while (!this->ThreadStopRequested())
+        {
+            // enter twice, the lock must be recursive like on Win32
+            this->critSect->Enter();
+            this->critSect->Enter();
+            (*this->lockedCounter)++;
+            this->critSect->Leave();
+            this->critSect->Leave();
+            Threading::Interlocked::Increment(*this->atomicCounter);
+            Threading::Interlocked::Increment(this->numIncrements);
+        }
+    }
+};
+ImplementClass(CounterThread, 'TCnT', Threading::Thread);
+
+//------------------------------------------------------------------------------
+/**
+    Sleeps on an event, only EmitWakeupSignal() lets it see the stop request.
+*/
+class WaitingThread : public Threading::Thread
+{
+    DeclareClass(WaitingThread);
+public:
+    /// constructor
+    WaitingThread() :
+        numWakeups(0)
+    {
+        // empty
+    }
+
+    int numWakeups;
+
+protected:
+    /// wake up the thread so it can stop
+    virtual void EmitWakeupSignal()
+    {
+        this->wakeupEvent.Signal();
+    }
+    /// wait until woken up
+    virtual void DoWork()
+    {
+        while (!this->ThreadStopRequested())
+        {
+            this->wakeupEvent.Wait();
+            this->numWakeups++;
+        }
+    }
+
+    Threading::Event wakeupEvent;
+};
+ImplementClass(WaitingThread, 'TWaT', Threading::Thread);
+
+//------------------------------------------------------------------------------
+/**
+    Pushes its share of numbered items into the queue and returns.
+*/
+class ProducerThread : public Threading::Thread
+{
+    DeclareClass(ProducerThread);
+public:
+    /// constructor
+    ProducerThread() :
+        queue(0),
+        first(0)
+    {
+        // empty
+    }
+
+    Threading::MpmcQueue<int>* queue;
+    int first;
+
+protected:
+    /// produce the items
+    virtual void DoWork()
+    {
+        int i;
+        for (i = 0; i < NumItemsPerProducer; i++)
+        {
+            while (!this->queue->Enqueue(this->first + i))
+            {
+                sched_yield();
+            }
+        }
+    }
+};
+ImplementClass(ProducerThread, 'TPrT', Threading::Thread);
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+RunCounterRound(int round)
+{
+    Threading::CriticalSection critSect;
+    int lockedCounter = 0;
+    int volatile atomicCounter = 0;
+    Ptr<CounterThread> threads[NumCounterThreads];
+    char name[32];
+    int i;
+    for (i = 0; i < NumCounterThreads; i++)
+    {
+        threads[i] = CounterThread::Create();
+        threads[i]->critSect = &critSect;
+        threads[i]->lockedCounter = &lockedCounter;
+        threads[i]->atomicCounter = &atomicCounter;
+        sprintf(name, "counter%d.%d", round, i);
+        threads[i]->SetName(name);
+        threads[i]->SetPriority((CounterThread::Priority) (i % 3));
+        threads[i]->SetStackSize(256 * 1024);
+        threads[i]->Start();
+        Verify(threads[i]->IsRunning());
+    }
+
+    // let every thread get some work done before stopping them
+    for (i = 0; i < NumCounterThreads; i++)
+    {
+        while (Threading::Interlocked::CompareExchange(threads[i]->numIncrements, 0, 0) < MinNumIncrements)
+        {
+            sched_yield();
+        }
+    }
+
+    int sum = 0;
+    for (i = 0; i < NumCounterThreads; i++)
+    {
+        threads[i]->Stop();
+        Verify(!threads[i]->IsRunning());
+        Verify(threads[i]->nameMatches);
+        sum += threads[i]->numIncrements;
+    }
+    Verify(lockedCounter == sum);
+    Verify(atomicCounter == sum);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+RunWaitingRound()
+{
+    Ptr<WaitingThread> thread = WaitingThread::Create();
+    thread->SetName("waiting");
+    thread->Start();
+    if (0 == (rand() % 2))
+    {
+        usleep(100);
+    }
+    thread->Stop();
+    Verify(!thread->IsRunning());
+    Verify(thread->numWakeups <= 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+RunProducerRound()
+{
+    Threading::MpmcQueue<int> queue(256);
+    Ptr<ProducerThread> threads[NumProducerThreads];
+    int i;
+    for (i = 0; i < NumProducerThreads; i++)
+    {
+        threads[i] = ProducerThread::Create();
+        threads[i]->queue = &queue;
+        threads[i]->first = i * NumItemsPerProducer;
+        threads[i]->SetName("producer");
+        threads[i]->Start();
+    }
+
+    const int numItems = NumProducerThreads * NumItemsPerProducer;
+    std::vector<char> received(numItems, 0);
+    int numReceived;
+    for (numReceived = 0; numReceived < numItems; numReceived++)
+    {
+        int item;
+        while (!queue.Dequeue(item))
+        {
+            queue.Wait();
+        }
+        Verify((item >= 0) && (item < numItems) && (0 == received[item]));
+        if ((item >= 0) && (item < numItems))
+        {
+            received[item] = 1;
+        }
+        if (Failed)
+        {
+            break;
+        }
+    }
+
+    for (i = 0; i < NumProducerThreads; i++)
+    {
+        threads[i]->Stop();
+    }
+    Verify(queue.IsEmpty());
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+*/
+int
+main()
+{
+    int round;
+    for (round = 0; (round < NumRounds) && !Failed; round++)
+    {
+        RunCounterRound(round);
+        RunWaitingRound();
+        RunProducerRound();
+    }
+    if (!Failed)
+    {
+        printf("%d rounds, all checks passed\n", NumRounds);
+    }
+    return Failed ? 1 : 0;
+}